@@ -7,14 +7,17 @@
 #include <QApplication>
 #include <QGroupBox>
 #include "embdetails-dialog.h"
+#include "object-save.h"
 #include "emb-pattern.h"
 #include "emb-reader-writer.h"
 
+#include <math.h>
+
 EmbDetailsDialog::EmbDetailsDialog(QGraphicsScene* theScene, QWidget* parent) : QDialog(parent)
 {
     setMinimumSize(750,550);
 
-    getInfo();
+    getInfo(theScene);
     mainWidget = createMainWidget();
 
     buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok);
@@ -35,19 +38,64 @@ EmbDetailsDialog::~EmbDetailsDialog()
     QApplication::restoreOverrideCursor();
 }
 
-void EmbDetailsDialog::getInfo()
+void EmbDetailsDialog::getInfo(QGraphicsScene* theScene)
 {
-    //TODO: generate a temporary pattern from the scene data.
-
-    //TODO: grab this information from the pattern
-    stitchesTotal = 5; //TODO: embStitchList_count(pattern->stitchList, TOTAL);
-    stitchesReal  = 4; //TODO: embStitchList_count(pattern->stitchList, NORMAL);
-    stitchesJump  = 3; //TODO: embStitchList_count(pattern->stitchList, JUMP);
-    stitchesTrim  = 2; //TODO: embStitchList_count(pattern->stitchList, TRIM);
-    colorTotal    = 1; //TODO: embThreadList_count(pattern->threadList, TOTAL);
-    colorChanges  = 0; //TODO: embThreadList_count(pattern->threadList, CHANGES);
+    stitchesTotal = 0;
+    stitchesReal  = 0;
+    stitchesJump  = 0;
+    stitchesTrim  = 0;
+    colorTotal    = 0;
+    colorChanges  = 0;
+    threadLength  = 0.0;
+    stitchLengthMax = 0.0;
+    stitchLengthBins.fill(0, NUM_STITCH_LENGTH_BINS);
+    boundingRect = QRectF();
+
+    //Generate a temporary pattern from the scene data
+    EmbPattern* pattern = embPattern_create();
+    if(!pattern) { qDebug("Could not allocate memory for embroidery pattern"); return; }
+    SaveObject saveObj(theScene);
+    saveObj.addItems(pattern);
+    embPattern_movePolylinesToStitchList(pattern); //TODO: handle all objects like this
+
+    //The totals are kept on the pattern as its stitches are added
+    EmbPatternStats stats = embPattern_stats(pattern);
+    stitchesTotal = stats.stitchCount;
+    stitchesReal  = stats.realCount;
+    stitchesJump  = stats.jumpCount;
+    stitchesTrim  = stats.trimCount;
+    colorTotal    = embThreadList_count(pattern->threadList);
+    colorChanges  = stats.colorChangeCount;
+    threadLength  = stats.threadLength;
+    if(stats.bounds.left <= stats.bounds.right)
+        boundingRect.setCoords(stats.bounds.left, stats.bounds.top, stats.bounds.right, stats.bounds.bottom);
+
+    //Only the stitch length histogram needs a walk over the stitches
+    QVector<double> stitchLengths;
+    for(int i = 1; i < stats.stitchCount && i < pattern->stitchArray.count; i++)
+    {
+        EmbStitch prev = embStitchArray_getAt(&pattern->stitchArray, i-1);
+        EmbStitch curr = embStitchArray_getAt(&pattern->stitchArray, i);
+        if(prev.flags == NORMAL && curr.flags == NORMAL)
+        {
+            double dx = curr.xx - prev.xx;
+            double dy = curr.yy - prev.yy;
+            double length = sqrt(dx*dx + dy*dy);
+            if(length > stitchLengthMax) stitchLengthMax = length;
+            stitchLengths.append(length);
+        }
+    }
+    if(stitchLengthMax > 0.0)
+    {
+        foreach(double length, stitchLengths)
+        {
+            int bin = int(floor(NUM_STITCH_LENGTH_BINS*length/stitchLengthMax));
+            if(bin >= NUM_STITCH_LENGTH_BINS) bin = NUM_STITCH_LENGTH_BINS-1;
+            stitchLengthBins[bin]++;
+        }
+    }
 
-    boundingRect.setRect(0, 0, 50, 100); //TODO: embPattern_calcBoundingBox(pattern);
+    embPattern_free(pattern);
 }
 
 QWidget* EmbDetailsDialog::createMainWidget()
@@ -63,6 +111,7 @@ QWidget* EmbDetailsDialog::createMainWidget()
     QLabel* labelStitchesTrim  = new QLabel(tr("Trim Stitches:"),  this);
     QLabel* labelColorTotal    = new QLabel(tr("Total Colors:"),   this);
     QLabel* labelColorChanges  = new QLabel(tr("Color Changes:"),  this);
+    QLabel* labelThreadLength  = new QLabel(tr("Thread Length:"),  this);
     QLabel* labelRectLeft      = new QLabel(tr("Left:"),           this);
     QLabel* labelRectTop       = new QLabel(tr("Top:"),            this);
     QLabel* labelRectRight     = new QLabel(tr("Right:"),          this);
@@ -76,6 +125,7 @@ QWidget* EmbDetailsDialog::createMainWidget()
     QLabel* fieldStitchesTrim  = new QLabel(QString::number(stitchesTrim),  this);
     QLabel* fieldColorTotal    = new QLabel(QString::number(colorTotal),    this);
     QLabel* fieldColorChanges  = new QLabel(QString::number(colorChanges),  this);
+    QLabel* fieldThreadLength  = new QLabel(QString::number(threadLength, 'f', 1) + " mm", this);
     QLabel* fieldRectLeft      = new QLabel(QString::number(boundingRect.left())   + " mm", this);
     QLabel* fieldRectTop       = new QLabel(QString::number(boundingRect.top())    + " mm", this);
     QLabel* fieldRectRight     = new QLabel(QString::number(boundingRect.right())  + " mm", this);
@@ -90,38 +140,40 @@ QWidget* EmbDetailsDialog::createMainWidget()
     gridLayoutMisc->addWidget(labelStitchesTrim,   3, 0, Qt::AlignLeft);
     gridLayoutMisc->addWidget(labelColorTotal,     4, 0, Qt::AlignLeft);
     gridLayoutMisc->addWidget(labelColorChanges,   5, 0, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(labelRectLeft,       6, 0, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(labelRectTop,        7, 0, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(labelRectRight,      8, 0, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(labelRectBottom,     9, 0, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(labelRectWidth,     10, 0, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(labelRectHeight,    11, 0, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(labelThreadLength,   6, 0, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(labelRectLeft,       7, 0, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(labelRectTop,        8, 0, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(labelRectRight,      9, 0, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(labelRectBottom,    10, 0, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(labelRectWidth,     11, 0, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(labelRectHeight,    12, 0, Qt::AlignLeft);
     gridLayoutMisc->addWidget(fieldStitchesTotal,  0, 1, Qt::AlignLeft);
     gridLayoutMisc->addWidget(fieldStitchesReal,   1, 1, Qt::AlignLeft);
     gridLayoutMisc->addWidget(fieldStitchesJump,   2, 1, Qt::AlignLeft);
     gridLayoutMisc->addWidget(fieldStitchesTrim,   3, 1, Qt::AlignLeft);
     gridLayoutMisc->addWidget(fieldColorTotal,     4, 1, Qt::AlignLeft);
     gridLayoutMisc->addWidget(fieldColorChanges,   5, 1, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(fieldRectLeft,       6, 1, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(fieldRectTop,        7, 1, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(fieldRectRight,      8, 1, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(fieldRectBottom,     9, 1, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(fieldRectWidth,     10, 1, Qt::AlignLeft);
-    gridLayoutMisc->addWidget(fieldRectHeight,    11, 1, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(fieldThreadLength,   6, 1, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(fieldRectLeft,       7, 1, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(fieldRectTop,        8, 1, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(fieldRectRight,      9, 1, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(fieldRectBottom,    10, 1, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(fieldRectWidth,     11, 1, Qt::AlignLeft);
+    gridLayoutMisc->addWidget(fieldRectHeight,    12, 1, Qt::AlignLeft);
     gridLayoutMisc->setColumnStretch(1,1);
     groupBoxMisc->setLayout(gridLayoutMisc);
 
     //TODO: Color Histogram
 
-    //Stitch Distribution
-    //QGroupBox* groupBoxDist = new QGroupBox(tr("Stitch Distribution"), widget);
+    //TODO: Thread Length By Color
 
-    //TODO: Stitch Distribution Histogram
+    //Stitch Distribution
+    QWidget* groupBoxDist = createHistogram();
 
     //Widget Layout
     QVBoxLayout *vboxLayoutMain = new QVBoxLayout(widget);
     vboxLayoutMain->addWidget(groupBoxMisc);
-    //vboxLayoutMain->addWidget(groupBoxDist);
+    vboxLayoutMain->addWidget(groupBoxDist);
     vboxLayoutMain->addStretch(1);
     widget->setLayout(vboxLayoutMain);
 
@@ -131,217 +183,23 @@ QWidget* EmbDetailsDialog::createMainWidget()
     return scrollArea;
 }
 
-//TODO: Move majority of this code into libembroidery
-/*
-void MainWindow::designDetails()
+QWidget* EmbDetailsDialog::createHistogram()
 {
-    QApplication::setOverrideCursor(Qt::ArrowCursor);
-    qDebug("designDetails()");
-    QString appName = QApplication::applicationName();
-    QString title = "Design Details";
-
-    EmbPattern* pattern = 0;
-
-    //TODO: This is temporary. Generate actual pattern data from the scene.
-    //======================================================
-    //embPattern_read(pattern, "/mydata/embroidery-designs/KDE.EXP"); //TODO: This convenience function is messed up.
-
-    EmbReaderWriter* reader = 0;
-    int readSuccessful;
-    QString tmpFileName = "/mydata/embroidery-designs/KDE.EXP";
-
-    pattern = embPattern_create();
-    if(!pattern) { printf("Could not allocate memory for embroidery pattern\n"); }
-
-    readSuccessful = 0;
-    reader = embReaderWriter_getByFileName(qPrintable(tmpFileName));
-    if(!reader)
-    {
-        readSuccessful = 0;
-        printf("Unsupported read file type\n");
-    }
-    else
-    {
-        readSuccessful = reader->reader(pattern, qPrintable(tmpFileName));
-        if(!readSuccessful) printf("Reading file was unsuccessful\n");
-    }
-    free(reader);
-    if(!readSuccessful)
-    {
-        embPattern_free(pattern);
-    }
-    //======================================================
-
-
-    EmbRect bounds = embPattern_calcBoundingBox(pattern);
-
-    int colors = 1;
-    int num_stitches = 0;
-    int real_stitches = 0;
-    int jump_stitches = 0;
-    int trim_stitches = 0;
-    int unknown_stitches = 0;
-    int num_colors = 0;
-    double minx = 0.0, maxx = 0.0, miny = 0.0, maxy = 0.0;
-    double min_stitchlength = 999.0;
-    double max_stitchlength = 0.0;
-    double total_stitchlength = 0.0;
-    int number_of_minlength_stitches = 0;
-    int number_of_maxlength_stitches = 0;
-
-    double xx = 0.0, yy = 0.0;
-    double dx = 0.0, dy = 0.0;
-    double length = 0.0;
-
-    num_colors = embThreadList_count(pattern->threadList);
-    num_stitches = embStitchList_count(pattern->stitchList);
-    if(num_stitches == 0)
-    {
-        QMessageBox::warning(this, tr("No Design Loaded"), tr("<b>A design needs to be loaded or created before details can be determined.</b>"));
-        return;
-    }
-    QVector<double> stitchLengths;
-
-    double totalColorLength = 0.0;
-    for(int i = 0; i < num_stitches; i++)
-    {
-        dx = embStitchList_getAt(pattern->stitchList, i).xx - xx;
-        dy = embStitchList_getAt(pattern->stitchList, i).yy - yy;
-        xx = embStitchList_getAt(pattern->stitchList, i).xx;
-        yy = embStitchList_getAt(pattern->stitchList, i).yy;
-        length=sqrt(dx * dx + dy * dy);
-        totalColorLength += length;
-        if(i > 0 && embStitchList_getAt(pattern->stitchList, i-1).flags != NORMAL)
-            length = 0.0; //can't count first normal stitch;
-        if(!(embStitchList_getAt(pattern->stitchList, i).flags & (JUMP | TRIM)))
-        {
-            real_stitches++;
-            if(length > max_stitchlength) { max_stitchlength = length; number_of_maxlength_stitches = 0; }
-            if(length == max_stitchlength) number_of_maxlength_stitches++;
-            if(length > 0 && length < min_stitchlength)
-            {
-                min_stitchlength = length;
-                number_of_minlength_stitches = 0;
-            }
-            if(length == min_stitchlength) number_of_minlength_stitches++;
-            total_stitchlength += length;
-            if(xx < minx) minx = xx;
-            if(xx > maxx) maxx = xx;
-            if(yy < miny) miny = yy;
-            if(yy > maxy) maxy = yy;
-        }
-        if(embStitchList_getAt(pattern->stitchList, i).flags & JUMP)
-        {
-            jump_stitches++;
-        }
-        if(embStitchList_getAt(pattern->stitchList, i).flags & TRIM)
-        {
-            trim_stitches++;
-        }
-        if(embStitchList_getAt(pattern->stitchList, i).flags & STOP)
-        {
-            stitchLengths.push_back(totalColorLength);
-            totalColorLength = 0;
-            colors++;
-        }
-        if(embStitchList_getAt(pattern->stitchList, i).flags & END)
-        {
-            stitchLengths.push_back(totalColorLength);
-        }
-    }
-
-    //second pass to fill bins now that we know max stitch length
-#define NUMBINS 10
-    int bin[NUMBINS+1];
-    for(int i = 0; i <= NUMBINS; i++)
-    {
-        bin[i]=0;
-    }
-
-    for(int i = 0; i < num_stitches; i++)
-    {
-        dx = embStitchList_getAt(pattern->stitchList, i).xx - xx;
-        dy = embStitchList_getAt(pattern->stitchList, i).yy - yy;
-        xx = embStitchList_getAt(pattern->stitchList, i).xx;
-        yy = embStitchList_getAt(pattern->stitchList, i).yy;
-        if(i > 0 && embStitchList_getAt(pattern->stitchList, i-1).flags == NORMAL && embStitchList_getAt(pattern->stitchList, i).flags == NORMAL)
-        {
-            length=sqrt(dx * dx + dy * dy);
-            bin[int(floor(NUMBINS*length/max_stitchlength))]++;
-        }
-    }
-
-    double binSize = max_stitchlength / NUMBINS;
-
-    QString str;
-    for(int i = 0; i < NUMBINS; i++)
-    {
-        str += QString::number(binSize * (i), 'f', 1) + " - " + QString::number(binSize * (i+1), 'f', 1) + " mm: " +  QString::number(bin[i]) + "\n\n";
-    }
-
-    QDialog dialog(this);
-
-    QGridLayout* grid = new QGridLayout(this);
-    grid->setSpacing(2);
+    QGroupBox* groupBoxDist = new QGroupBox(tr("Stitch Distribution"), this);
 
-    grid->addWidget(new QLabel(tr("Stitches:")),0,0,1,1);
-    grid->addWidget(new QLabel(QString::number(num_stitches)), 0, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("Colors:")),1,0,1,1);
-    grid->addWidget(new QLabel(QString::number(num_colors)), 1, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("Jumps:")),2,0,1,1);
-    grid->addWidget(new QLabel(QString::number(jump_stitches)), 2, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("Top:")),3,0,1,1);
-    grid->addWidget(new QLabel(QString::number(bounds.top) + " mm"), 3, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("Left:")),4,0,1,1);
-    grid->addWidget(new QLabel(QString::number(bounds.left) + " mm"), 4, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("Bottom:")),5,0,1,1);
-    grid->addWidget(new QLabel(QString::number(bounds.bottom) + " mm"), 5, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("Right:")),6,0,1,1);
-    grid->addWidget(new QLabel(QString::number(bounds.right) + " mm"), 6, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("Width:")),7,0,1,1);
-    grid->addWidget(new QLabel(QString::number((bounds.right - bounds.left)) + " mm"), 7, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("Height:")),8,0,1,1);
-    grid->addWidget(new QLabel(QString::number((bounds.bottom - bounds.top)) + " mm"), 8, 1, 1, 1);
-    grid->addWidget(new QLabel(tr("\nStitch Distribution: \n")),9,0,1,2);
-    grid->addWidget(new QLabel(str), 10, 0, 1, 1);
-    grid->addWidget(new QLabel(tr("\nThread Length By Color: \n")),11,0,1,2);
-    int currentRow = 12;
-*/
-/*
-    for(int i = 0; i < num_colors; i++)
+    QGridLayout* gridLayoutDist = new QGridLayout(groupBoxDist);
+    double binSize = stitchLengthMax / NUM_STITCH_LENGTH_BINS;
+    for(int i = 0; i < NUM_STITCH_LENGTH_BINS; i++)
     {
-        QFrame *frame = new QFrame();
-        frame->setGeometry(0,0,30,30);
-        QPalette palette = frame->palette();
-        EmbColor t = embThreadList_getAt(pattern->threadList, i).color;
-        palette.setColor(backgroundRole(), QColor( t.r, t.g, t.b ) );
-        frame->setPalette( palette );
-        frame->setAutoFillBackground(true);
-        grid->addWidget(frame, currentRow,0,1,1);
-        qDebug("size: %d i: %d", stitchLengths.size(), i);
-        grid->addWidget(new QLabel(QString::number(stitchLengths.at(i)) + " mm"), currentRow,1,1,1);
-        currentRow++;
+        QLabel* labelBin = new QLabel(QString::number(binSize*i, 'f', 1) + " - " + QString::number(binSize*(i+1), 'f', 1) + " mm:", this);
+        QLabel* fieldBin = new QLabel(QString::number(stitchLengthBins.at(i)), this);
+        gridLayoutDist->addWidget(labelBin, i, 0, Qt::AlignLeft);
+        gridLayoutDist->addWidget(fieldBin, i, 1, Qt::AlignLeft);
     }
-*/
-/*
-    QDialogButtonBox buttonbox(Qt::Horizontal, &dialog);
-    QPushButton button(&dialog);
-    button.setText("Ok");
-    buttonbox.addButton(&button, QDialogButtonBox::AcceptRole);
-    buttonbox.setCenterButtons(true);
-    connect(&buttonbox, SIGNAL(accepted()), &dialog, SLOT(accept()));
-
-    grid->addWidget(&buttonbox, currentRow, 0, 1, 2);
-
-    dialog.setWindowTitle(title);
-    dialog.setMinimumWidth(100);
-    dialog.setMinimumHeight(50);
-    dialog.setLayout(grid);
-    dialog.exec();
-    QApplication::restoreOverrideCursor();
+    gridLayoutDist->setColumnStretch(1,1);
+    groupBoxDist->setLayout(gridLayoutDist);
 
+    return groupBoxDist;
 }
-*/
-
 
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -2,6 +2,7 @@
 #define EMBDETAILS_DIALOG_H
 
 #include <QDialog>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
 class QDialogButtonBox;
@@ -19,7 +20,7 @@ public:
 private:
     QWidget*          mainWidget;
 
-    void              getInfo();
+    void              getInfo(QGraphicsScene* theScene);
     QWidget*          createMainWidget();
     QWidget*          createHistogram();
 
@@ -31,6 +32,12 @@ private:
     quint32 stitchesTrim;
     quint32 colorTotal;
     quint32 colorChanges;
+    double  threadLength;
+
+    //Stitch Distribution
+    enum { NUM_STITCH_LENGTH_BINS = 10 };
+    double       stitchLengthMax;
+    QVector<int> stitchLengthBins;
 
     QRectF boundingRect;
 };
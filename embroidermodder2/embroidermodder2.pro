@@ -74,6 +74,7 @@ mainwindow-commands.cpp \
 mainwindow-actions.cpp \
 mdiarea.cpp \
 mdiwindow.cpp \
+file-loader.cpp \
 view.cpp \
 cmdprompt.cpp \
 embdetails-dialog.cpp \
@@ -108,6 +109,7 @@ mainwindow.h \
 mainwindow-actions.h \
 mdiarea.h \
 mdiwindow.h \
+file-loader.h \
 view.h \
 cmdprompt.h \
 embdetails-dialog.h \
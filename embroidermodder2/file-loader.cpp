@@ -0,0 +1,258 @@
+#include "file-loader.h"
+#include "object-data.h"
+
+#include <QDebug>
+
+#include "emb-pattern.h"
+
+//NOTE: A batch is handed to the GUI once it holds this many objects or path elements,
+//NOTE: which keeps the work done on the GUI thread for each one short enough to stay responsive.
+#define FILE_LOADER_BATCH_OBJECTS  256
+#define FILE_LOADER_BATCH_ELEMENTS 16384
+
+FileLoader::FileLoader(const QString& theFileName, const EmbFormat* theFormat, QObject* parent) : QThread(parent)
+{
+    qDebug("FileLoader Constructor()");
+
+    qRegisterMetaType<QList<LoaderObject> >("QList<LoaderObject>");
+
+    fileName = theFileName;
+    format = theFormat;
+    batchElements = 0;
+    built = 0;
+    total = 0;
+}
+
+FileLoader::~FileLoader()
+{
+    qDebug("FileLoader Destructor()");
+}
+
+void FileLoader::cancel()
+{
+    canceled.fetchAndStoreOrdered(1);
+}
+
+bool FileLoader::isCanceled()
+{
+    return canceled.fetchAndAddOrdered(0) != 0;
+}
+
+void FileLoader::addObject(const LoaderObject& obj)
+{
+    batch.append(obj);
+    batchElements += obj.path.elementCount() + 1;
+    built++;
+    if(batch.count() >= FILE_LOADER_BATCH_OBJECTS || batchElements >= FILE_LOADER_BATCH_ELEMENTS)
+        flush();
+}
+
+void FileLoader::flush()
+{
+    if(!batch.isEmpty())
+    {
+        emit objectsLoaded(batch);
+        batch.clear();
+        batchElements = 0;
+    }
+    emit progressChanged(built, total);
+}
+
+void FileLoader::run()
+{
+    qDebug("FileLoader run()");
+
+    //NOTE: The reader cannot be interrupted, so a canceled load stops once it returns.
+    //NOTE: Until then the progress is unknown.
+    emit progressChanged(0, 0);
+
+    EmbPattern* p = embPattern_create();
+    if(!p) { emit loadFailed(tr("Could not allocate memory for embroidery pattern")); return; }
+
+    QByteArray localFileName = fileName.toLocal8Bit();
+    if(!format->readerWriter.reader(p, localFileName.constData()))
+    {
+        qDebug("Reading file was unsuccessful: %s\n", qPrintable(fileName));
+        embPattern_free(p);
+        emit loadFailed(tr("Reading file was unsuccessful: %1").arg(fileName));
+        return;
+    }
+    if(isCanceled()) { embPattern_free(p); return; }
+
+    embPattern_moveStitchListToPolylines(p); //TODO: Test more
+
+    total = 0;
+    for(EmbCircleObjectList* curCircleObj = p->circleObjList; curCircleObj; curCircleObj = curCircleObj->next) total++;
+    for(EmbEllipseObjectList* curEllipseObj = p->ellipseObjList; curEllipseObj; curEllipseObj = curEllipseObj->next) total++;
+    for(EmbLineObjectList* curLineObj = p->lineObjList; curLineObj; curLineObj = curLineObj->next) total++;
+    for(EmbPathObjectList* curPathObjList = p->pathObjList; curPathObjList; curPathObjList = curPathObjList->next) total++;
+    for(EmbPointObjectList* curPointObj = p->pointObjList; curPointObj; curPointObj = curPointObj->next) total++;
+    for(EmbPolygonObjectList* curPolygonObjList = p->polygonObjList; curPolygonObjList; curPolygonObjList = curPolygonObjList->next) total++;
+    for(EmbPolylineObjectList* curPolylineObjList = p->polylineObjList; curPolylineObjList; curPolylineObjList = curPolylineObjList->next) total++;
+    for(EmbRectObjectList* curRectObj = p->rectObjList; curRectObj; curRectObj = curRectObj->next) total++;
+    emit progressChanged(0, total);
+
+    //NOTE: Qt Y+ is down and libembroidery Y+ is up, so inverting the Y is needed throughout.
+    LoaderObject obj;
+
+    EmbCircleObjectList* curCircleObj = p->circleObjList;
+    while(curCircleObj && !isCanceled())
+    {
+        EmbCircle c = curCircleObj->circleObj.circle;
+        EmbColor thisColor = curCircleObj->circleObj.color;
+        obj.type = OBJ_TYPE_CIRCLE;
+        obj.color = qRgb(thisColor.r, thisColor.g, thisColor.b);
+        obj.x1 = embCircle_centerX(c); obj.y1 = -embCircle_centerY(c);
+        obj.x2 = embCircle_radius(c);  obj.y2 = 0;
+        obj.path = QPainterPath();
+        addObject(obj);
+        curCircleObj = curCircleObj->next;
+    }
+    EmbEllipseObjectList* curEllipseObj = p->ellipseObjList;
+    while(curEllipseObj && !isCanceled())
+    {
+        EmbEllipse e = curEllipseObj->ellipseObj.ellipse;
+        EmbColor thisColor = curEllipseObj->ellipseObj.color;
+        obj.type = OBJ_TYPE_ELLIPSE;
+        obj.color = qRgb(thisColor.r, thisColor.g, thisColor.b);
+        obj.x1 = embEllipse_centerX(e); obj.y1 = -embEllipse_centerY(e);
+        obj.x2 = embEllipse_width(e);   obj.y2 = embEllipse_height(e);
+        obj.path = QPainterPath();
+        addObject(obj);
+        curEllipseObj = curEllipseObj->next;
+    }
+    EmbLineObjectList* curLineObj = p->lineObjList;
+    while(curLineObj && !isCanceled())
+    {
+        EmbLine li = curLineObj->lineObj.line;
+        EmbColor thisColor = curLineObj->lineObj.color;
+        obj.type = OBJ_TYPE_LINE;
+        obj.color = qRgb(thisColor.r, thisColor.g, thisColor.b);
+        obj.x1 = embLine_x1(li); obj.y1 = -embLine_y1(li);
+        obj.x2 = embLine_x2(li); obj.y2 = -embLine_y2(li);
+        obj.path = QPainterPath();
+        addObject(obj);
+        curLineObj = curLineObj->next;
+    }
+    //TODO: This is unfinished. It needs more work
+    EmbPathObjectList* curPathObjList = p->pathObjList;
+    while(curPathObjList && !isCanceled())
+    {
+        QPainterPath pathPath;
+        EmbPointList* curPointList = curPathObjList->pathObj->pointList;
+        EmbColor thisColor = curPathObjList->pathObj->color;
+        if(curPointList)
+        {
+            EmbPoint pp = curPointList->point;
+            pathPath.moveTo(embPoint_x(pp), -embPoint_y(pp));
+            curPointList = curPointList->next;
+        }
+        while(curPointList)
+        {
+            EmbPoint pp = curPointList->point;
+            pathPath.lineTo(embPoint_x(pp), -embPoint_y(pp));
+            curPointList = curPointList->next;
+        }
+        obj.type = OBJ_TYPE_PATH;
+        obj.color = qRgb(thisColor.r, thisColor.g, thisColor.b);
+        obj.x1 = obj.y1 = obj.x2 = obj.y2 = 0;
+        obj.path = pathPath;
+        addObject(obj);
+        curPathObjList = curPathObjList->next;
+    }
+    EmbPointObjectList* curPointObj = p->pointObjList;
+    while(curPointObj && !isCanceled())
+    {
+        EmbPoint po = curPointObj->pointObj.point;
+        EmbColor thisColor = curPointObj->pointObj.color;
+        obj.type = OBJ_TYPE_POINT;
+        obj.color = qRgb(thisColor.r, thisColor.g, thisColor.b);
+        obj.x1 = embPoint_x(po); obj.y1 = -embPoint_y(po);
+        obj.x2 = obj.y2 = 0;
+        obj.path = QPainterPath();
+        addObject(obj);
+        curPointObj = curPointObj->next;
+    }
+    //NOTE: Polygons and polylines keep their points relative to the first one, which becomes their position.
+    EmbPolygonObjectList* curPolygonObjList = p->polygonObjList;
+    while(curPolygonObjList && !isCanceled())
+    {
+        QPainterPath polygonPath;
+        bool firstPoint = false;
+        qreal startX = 0, startY = 0;
+        qreal x = 0, y = 0;
+        EmbPointList* curPointList = curPolygonObjList->polygonObj->pointList;
+        EmbColor thisColor = curPolygonObjList->polygonObj->color;
+        while(curPointList)
+        {
+            EmbPoint pp = curPointList->point;
+            x = embPoint_x(pp);
+            y = -embPoint_y(pp);
+
+            if(firstPoint) { polygonPath.lineTo(x,y); }
+            else           { polygonPath.moveTo(x,y); firstPoint = true; startX = x; startY = y; }
+
+            curPointList = curPointList->next;
+        }
+        polygonPath.translate(-startX, -startY);
+        obj.type = OBJ_TYPE_POLYGON;
+        obj.color = qRgb(thisColor.r, thisColor.g, thisColor.b);
+        obj.x1 = startX; obj.y1 = startY;
+        obj.x2 = obj.y2 = 0;
+        obj.path = polygonPath;
+        addObject(obj);
+        curPolygonObjList = curPolygonObjList->next;
+    }
+    /* NOTE: Polylines should only contain NORMAL stitches. */
+    EmbPolylineObjectList* curPolylineObjList = p->polylineObjList;
+    while(curPolylineObjList && !isCanceled())
+    {
+        QPainterPath polylinePath;
+        bool firstPoint = false;
+        qreal startX = 0, startY = 0;
+        qreal x = 0, y = 0;
+        EmbPointList* curPointList = curPolylineObjList->polylineObj->pointList;
+        EmbColor thisColor = curPolylineObjList->polylineObj->color;
+        while(curPointList)
+        {
+            EmbPoint pp = curPointList->point;
+            x = embPoint_x(pp);
+            y = -embPoint_y(pp);
+
+            if(firstPoint) { polylinePath.lineTo(x,y); }
+            else           { polylinePath.moveTo(x,y); firstPoint = true; startX = x; startY = y; }
+
+            curPointList = curPointList->next;
+        }
+        polylinePath.translate(-startX, -startY);
+        obj.type = OBJ_TYPE_POLYLINE;
+        obj.color = qRgb(thisColor.r, thisColor.g, thisColor.b);
+        obj.x1 = startX; obj.y1 = startY;
+        obj.x2 = obj.y2 = 0;
+        obj.path = polylinePath;
+        addObject(obj);
+        curPolylineObjList = curPolylineObjList->next;
+    }
+    EmbRectObjectList* curRectObj = p->rectObjList;
+    while(curRectObj && !isCanceled())
+    {
+        EmbRect r = curRectObj->rectObj.rect;
+        EmbColor thisColor = curRectObj->rectObj.color;
+        obj.type = OBJ_TYPE_RECTANGLE;
+        obj.color = qRgb(thisColor.r, thisColor.g, thisColor.b);
+        obj.x1 = embRect_x(r);     obj.y1 = -embRect_y(r);
+        obj.x2 = embRect_width(r); obj.y2 = -embRect_height(r);
+        obj.path = QPainterPath();
+        addObject(obj);
+        curRectObj = curRectObj->next;
+    }
+
+    embPattern_free(p);
+
+    if(isCanceled())
+        return;
+    flush();
+    emit loadSucceeded();
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -0,0 +1,61 @@
+#ifndef FILE_LOADER_H
+#define FILE_LOADER_H
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QPainterPath>
+#include <QMetaType>
+#include <QList>
+#include <QRgb>
+
+#include "emb-format.h"
+
+//NOTE: A LoaderObject describes one object of the pattern using plain values only.
+//NOTE: The QGraphicsItems themselves are created on the GUI thread, since they are not safe to create elsewhere.
+struct LoaderObject
+{
+    int          type;  //See OBJ_TYPE_VALUES
+    QRgb         color;
+    qreal        x1, y1, x2, y2; //Position, radius, size or end point depending on the type, with Y already inverted
+    QPainterPath path;  //Paths, polygons and polylines only
+};
+
+Q_DECLARE_METATYPE(QList<LoaderObject>)
+
+class FileLoader : public QThread
+{
+    Q_OBJECT
+
+public:
+    FileLoader(const QString& fileName, const EmbFormat* format, QObject* parent = 0);
+    ~FileLoader();
+
+    void cancel();
+    bool isCanceled();
+
+signals:
+    void progressChanged(int value, int maximum);
+    void objectsLoaded(const QList<LoaderObject>& objList);
+    void loadFailed(const QString& error);
+    void loadSucceeded();
+
+protected:
+    void run();
+
+private:
+    QString          fileName;
+    const EmbFormat* format;
+    QAtomicInt       canceled;
+
+    QList<LoaderObject> batch;
+    int                 batchElements;
+    int                 built;
+    int                 total;
+
+    void addObject(const LoaderObject& obj);
+    void flush();
+};
+
+#endif
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
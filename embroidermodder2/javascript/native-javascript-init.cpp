@@ -234,6 +234,14 @@ void MainWindow::javaLoadCommand(const QString& cmdName)
 
     engine->evaluate(script);
 
+    foreach(QString functionName, funcList)
+    {
+        funcName = cmdName + "_" + functionName;
+        QScriptValue func = engine->globalObject().property(funcName);
+        if(func.isFunction())
+            commandFunctionHash.insert(funcName, func);
+    }
+
     QSettings settings(appDir + "/commands/" + cmdName + "/" + cmdName + ".ini", QSettings::IniFormat);
     QString menuName    = settings.value("Menu/Name",    "Lost & Found").toString();
     int     menuPos     = settings.value("Menu/Position",             0).toInt();
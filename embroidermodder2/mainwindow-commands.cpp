@@ -1025,46 +1025,66 @@ void MainWindow::runCommand()
     }
 }
 
+QScriptValue MainWindow::commandFunction(const QString& cmd, const QString& entry)
+{
+    QString funcName = cmd + "_" + entry;
+    QHash<QString, QScriptValue>::const_iterator it = commandFunctionHash.constFind(funcName);
+    if(it != commandFunctionHash.constEnd())
+        return it.value();
+
+    //Not found when the command was loaded, so look it up now and remember it, even if it does not exist
+    QScriptValue func = engine->globalObject().property(funcName);
+    if(!func.isFunction())
+        qDebug("commandFunction(%s) is not a function", qPrintable(funcName));
+    commandFunctionHash.insert(funcName, func);
+    return func;
+}
+
 void MainWindow::runCommandMain(const QString& cmd)
 {
     qDebug("runCommandMain(%s)", qPrintable(cmd));
-    QString fileName = "commands/" + cmd + "/" + cmd + ".js";
+    //A move still waiting belongs to the command before this one
+    View* gview = activeView();
+    if(gview) gview->dropRapidMove();
     //if(!getSettingsSelectionModePickFirst()) { nativeClearSelection(); } //TODO: Uncomment this line when post-selection is available
-    engine->evaluate(cmd + "_main()", fileName);
+    QScriptValue func = commandFunction(cmd, "main");
+    if(func.isFunction()) { func.call(); }
 }
 
 void MainWindow::runCommandClick(const QString& cmd, qreal x, qreal y)
 {
     qDebug("runCommandClick(%s, %.2f, %.2f)", qPrintable(cmd), x, y);
-    QString fileName = "commands/" + cmd + "/" + cmd + ".js";
-    engine->evaluate(cmd + "_click(" + QString().setNum(x) + "," + QString().setNum(-y) + ")", fileName);
+    QScriptValue func = commandFunction(cmd, "click");
+    if(func.isFunction()) { func.call(QScriptValue(), QScriptValueList() << QScriptValue(x) << QScriptValue(-y)); }
 }
 
 void MainWindow::runCommandMove(const QString& cmd, qreal x, qreal y)
 {
-    qDebug("runCommandMove(%s, %.2f, %.2f)", qPrintable(cmd), x, y);
-    QString fileName = "commands/" + cmd + "/" + cmd + ".js";
-    engine->evaluate(cmd + "_move(" + QString().setNum(x) + "," + QString().setNum(-y) + ")", fileName);
+    //NOTE: This runs for every mouse move, so it does not log.
+    QScriptValue func = commandFunction(cmd, "move");
+    if(func.isFunction()) { func.call(QScriptValue(), QScriptValueList() << QScriptValue(x) << QScriptValue(-y)); }
 }
 
 void MainWindow::runCommandContext(const QString& cmd, const QString& str)
 {
     qDebug("runCommandContext(%s, %s)", qPrintable(cmd), qPrintable(str));
-    QString fileName = "commands/" + cmd + "/" + cmd + ".js";
-    engine->evaluate(cmd + "_context('" + str.toUpper() + "')", fileName);
+    View* gview = activeView();
+    if(gview) gview->flushRapidMove();
+    QScriptValue func = commandFunction(cmd, "context");
+    if(func.isFunction()) { func.call(QScriptValue(), QScriptValueList() << QScriptValue(str.toUpper())); }
 }
 
 void MainWindow::runCommandPrompt(const QString& cmd, const QString& str)
 {
     qDebug("runCommandPrompt(%s, %s)", qPrintable(cmd), qPrintable(str));
-    QString fileName = "commands/" + cmd + "/" + cmd + ".js";
-    //NOTE: Replace any special characters that will cause a syntax error
-    QString safeStr = str;
-    safeStr.replace("\\", "\\\\");
-    safeStr.replace("\'", "\\\'");
-    if(prompt->isRapidFireEnabled()) { engine->evaluate(cmd + "_prompt('" + safeStr + "')", fileName); }
-    else                             { engine->evaluate(cmd + "_prompt('" + safeStr.toUpper() + "')", fileName); }
-
+    //The command sees where the mouse went before it sees what was typed
+    View* gview = activeView();
+    if(gview) gview->flushRapidMove();
+    //NOTE: The string is passed as an argument rather than pasted into a script, so no characters need escaping.
+    QScriptValue func = commandFunction(cmd, "prompt");
+    if(!func.isFunction()) { return; }
+    if(prompt->isRapidFireEnabled()) { func.call(QScriptValue(), QScriptValueList() << QScriptValue(str)); }
+    else                             { func.call(QScriptValue(), QScriptValueList() << QScriptValue(str.toUpper())); }
 }
 
 void MainWindow::nativeAlert(const QString& txt)
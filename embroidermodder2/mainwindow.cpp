@@ -39,11 +39,16 @@
 #include <QCloseEvent>
 #include <QMetaObject>
 #include <QLocale>
+#include <QPixmapCache>
 
 MainWindow::MainWindow() : QMainWindow(0)
 {
     readSettings();
 
+    //NOTE: The real render tiles of the objects are kept in the QPixmapCache. Make room for a screenful of them.
+    //NOTE: When the objects in view need more tiles than fit, they are shaded directly rather than cached.
+    if(QPixmapCache::cacheLimit() < 65536) { QPixmapCache::setCacheLimit(65536); }
+
     QString appDir = qApp->applicationDirPath();
     //Verify that files/directories needed are actually present.
     QFileInfo check(appDir + "/commands");
@@ -428,35 +433,18 @@ void MainWindow::openFilesSelected(const QStringList& filesToOpen)
             numOfDocs++;
             MdiWindow* mdiWin = new MdiWindow(docIndex, mainWin, mdiArea, Qt::SubWindow);
             connect(mdiWin, SIGNAL(sendCloseMdiWin(MdiWindow*)), this, SLOT(onCloseMdiWin(MdiWindow*)));
+            connect(mdiWin, SIGNAL(loadFinished(MdiWindow*)), this, SLOT(onLoadFinished(MdiWindow*)));
             connect(mdiArea, SIGNAL(subWindowActivated(QMdiSubWindow*)), this, SLOT(onWindowActivated(QMdiSubWindow*)));
 
             //Make sure the toolbars/etc... are shown before doing their zoomExtents
             if(doOnce) { updateMenuToolbarStatusbar(); doOnce = false; }
 
+            //NOTE: The file loads in the background from here on, and the window zooms to it once it is in.
+            //NOTE: It is added to the recent files by onLoadFinished(), so a file that fails to load is not.
             if(mdiWin->loadFile(filesToOpen.at(i)))
             {
-                statusbar->showMessage(tr("File(s) loaded"), 2000);
                 mdiWin->show();
                 mdiWin->showMaximized();
-                //Prevent duplicate entries in the recent files list
-                if(!settings_opensave_recent_list_of_files.contains(filesToOpen.at(i), Qt::CaseInsensitive))
-                {
-                    settings_opensave_recent_list_of_files.prepend(filesToOpen.at(i));
-                }
-                //Move the recent file to the top of the list
-                else
-                {
-                    settings_opensave_recent_list_of_files.removeAll(filesToOpen.at(i));
-                    settings_opensave_recent_list_of_files.prepend(filesToOpen.at(i));
-                }
-                settings_opensave_recent_directory = QFileInfo(filesToOpen.at(i)).absolutePath();
-
-                View* v = mdiWin->getView();
-                if(v)
-                {
-                    v->recalculateLimits();
-                    v->zoomExtents();
-                }
             }
             else
             {
@@ -557,6 +545,25 @@ void MainWindow::onCloseMdiWin(MdiWindow* theMdiWin)
     }
 }
 
+void MainWindow::onLoadFinished(MdiWindow* theMdiWin)
+{
+    qDebug("MainWindow::onLoadFinished()");
+    QString fileName = theMdiWin->getCurrentFile();
+
+    //Prevent duplicate entries in the recent files list
+    if(!settings_opensave_recent_list_of_files.contains(fileName, Qt::CaseInsensitive))
+    {
+        settings_opensave_recent_list_of_files.prepend(fileName);
+    }
+    //Move the recent file to the top of the list
+    else
+    {
+        settings_opensave_recent_list_of_files.removeAll(fileName);
+        settings_opensave_recent_list_of_files.prepend(fileName);
+    }
+    settings_opensave_recent_directory = QFileInfo(fileName).absolutePath();
+}
+
 void MainWindow::onWindowActivated(QMdiSubWindow* w)
 {
     qDebug("MainWindow::onWindowActivated()");
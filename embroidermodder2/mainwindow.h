@@ -296,6 +296,7 @@ public slots:
 
     void                            onCloseWindow();
     virtual void                    onCloseMdiWin(MdiWindow*);
+    void                            onLoadFinished(MdiWindow*);
 
     void                            recentMenuAboutToShow();
 
@@ -656,6 +657,11 @@ private:
     void                   javaInitNatives(QScriptEngine* engine);
     void                   javaLoadCommand(const QString& cmdName);
 
+    //NOTE: The entry points of the commands, such as circle_click, are looked up once and called directly,
+    //NOTE: rather than evaluating a new script for every call.
+    QHash<QString, QScriptValue> commandFunctionHash;
+    QScriptValue           commandFunction(const QString& cmd, const QString& entry);
+
 public:
     //Natives
     void nativeAlert                  (const QString& txt);
@@ -4,9 +4,14 @@
 #include "statusbar-button.h"
 #include "object-save.h"
 #include "object-data.h"
+#include "object-circle.h"
+#include "object-ellipse.h"
+#include "object-line.h"
 #include "object-path.h"
+#include "object-point.h"
 #include "object-polygon.h"
 #include "object-polyline.h"
+#include "object-rect.h"
 
 #include <QFileDialog>
 #include <QMessageBox>
@@ -20,12 +25,15 @@
 #include <QStatusBar>
 #include <QColor>
 #include <QUndoStack>
+#include <QHBoxLayout>
+#include <QProgressBar>
+#include <QToolButton>
 
 #include <QGraphicsScene>
 #include <QGraphicsView>
 #include <QGraphicsItem>
 
-#include "emb-reader-writer.h"
+#include "emb-format.h"
 
 MdiWindow::MdiWindow(const int theIndex, MainWindow* mw, QMdiArea* parent, Qt::WindowFlags wflags) : QMdiSubWindow(parent, wflags)
 {
@@ -36,6 +44,13 @@ MdiWindow::MdiWindow(const int theIndex, MainWindow* mw, QMdiArea* parent, Qt::W
 
     fileWasLoaded = false;
 
+    loader = 0;
+    loadProgress = 0;
+    loadProgressBar = 0;
+    loadCancelButton = 0;
+    loadZoomed = false;
+    loadIndexMethod = QGraphicsScene::BspTreeIndex;
+
     setAttribute(Qt::WA_DeleteOnClose);
 
     QString aName;
@@ -81,10 +96,17 @@ MdiWindow::MdiWindow(const int theIndex, MainWindow* mw, QMdiArea* parent, Qt::W
 MdiWindow::~MdiWindow()
 {
     qDebug("MdiWindow Destructor()");
+    stopLoading();
 }
 
 bool MdiWindow::saveFile(const QString &fileName)
 {
+    if(loader)
+    {
+        QMessageBox::warning(this, tr("Error saving file"), tr("Cannot save %1 while it is still loading.").arg(getShortCurrentFile()));
+        return false;
+    }
+
     SaveObject saveObj(gscene, this);
     return saveObj.save(fileName);
 }
@@ -93,8 +115,6 @@ bool MdiWindow::loadFile(const QString &fileName)
 {
     qDebug("MdiWindow loadFile()");
 
-    QRgb tmpColor = getCurrentColor();
-
     QFile file(fileName);
     if(!file.open(QFile::ReadOnly | QFile::Text))
     {
@@ -104,233 +124,165 @@ bool MdiWindow::loadFile(const QString &fileName)
                              .arg(file.errorString()));
         return false;
     }
-
-    QApplication::setOverrideCursor(Qt::WaitCursor);
+    file.close();
 
     QString ext = fileExtension(fileName);
     qDebug("ext: %s", qPrintable(ext));
 
-    //Read
-    EmbPattern* p = embPattern_create();
-    if(!p) { printf("Could not allocate memory for embroidery pattern\n"); exit(1); }
-    int readSuccessful = 0;
-    QString readError;
-    EmbReaderWriter* reader = embReaderWriter_getByFileName(qPrintable(fileName));
-    if(!reader)
+    const EmbFormat* format = embFormat_fromFile(qPrintable(fileName));
+    if(!format || !format->readerWriter.reader)
     {
-        readSuccessful = 0;
-        readError = "Unsupported read file type: " + fileName;
         qDebug("Unsupported read file type: %s\n", qPrintable(fileName));
+        QMessageBox::warning(this, tr("Error reading pattern"), tr("Unsupported read file type: %1").arg(fileName));
+        return false;
     }
-    else
+
+    setCurrentFile(fileName);
+
+    //Clear the undo stack so it is not possible to undo past this point.
+    gview->getUndoStack()->clear();
+
+    //NOTE: The pattern is read and its geometry built by the loader on a thread of its own,
+    //NOTE: which hands the objects over in batches so they show up while the rest is still loading.
+    //NOTE: The scene is not indexed until the last batch is in, since rebuilding the index for every batch adds up.
+    loadIndexMethod = gscene->itemIndexMethod();
+    gscene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    loadZoomed = false;
+
+    loadProgress = new QWidget(mainWin->statusbar);
+    QHBoxLayout* loadProgressLayout = new QHBoxLayout(loadProgress);
+    loadProgressLayout->setContentsMargins(0, 0, 0, 0);
+    loadProgressBar = new QProgressBar(loadProgress);
+    loadProgressBar->setFormat(getShortCurrentFile() + " %p%");
+    loadProgressBar->setRange(0, 0);
+    loadProgressBar->setMaximumWidth(200);
+    loadCancelButton = new QToolButton(loadProgress);
+    loadCancelButton->setText(tr("Cancel"));
+    loadCancelButton->setToolTip(tr("Stop loading %1").arg(getShortCurrentFile()));
+    loadCancelButton->setAutoRaise(true);
+    loadProgressLayout->addWidget(loadProgressBar);
+    loadProgressLayout->addWidget(loadCancelButton);
+    mainWin->statusbar->addPermanentWidget(loadProgress);
+    connect(loadCancelButton, SIGNAL(clicked()), this, SLOT(cancelLoad()));
+
+    loader = new FileLoader(fileName, format, this);
+    connect(loader, SIGNAL(progressChanged(int,int)), this, SLOT(loadProgressChanged(int,int)));
+    connect(loader, SIGNAL(objectsLoaded(const QList<LoaderObject>&)), this, SLOT(loadObjects(const QList<LoaderObject>&)));
+    connect(loader, SIGNAL(loadFailed(const QString&)), this, SLOT(loadFailed(const QString&)));
+    connect(loader, SIGNAL(loadSucceeded()), this, SLOT(loadSucceeded()));
+    loader->start(QThread::LowPriority);
+
+    mainWin->statusbar->showMessage(tr("Loading %1...").arg(getShortCurrentFile()));
+    return true;
+}
+
+void MdiWindow::loadProgressChanged(int value, int maximum)
+{
+    if(!loader) return; //Canceled while this was queued
+
+    loadProgressBar->setRange(0, maximum);
+    loadProgressBar->setValue(value);
+}
+
+void MdiWindow::loadObjects(const QList<LoaderObject>& objList)
+{
+    if(!loader) return; //Canceled while this was queued
+
+    //NOTE: The objects are built here and added to the scene all at once rather than through the natives,
+    //NOTE: since each native pushes its own undo command and updates the scene.
+    QList<BaseObject*> sceneList;
+    foreach(const LoaderObject& lo, objList)
     {
-        readSuccessful = reader->reader(p, qPrintable(fileName));
-        if(!readSuccessful)
+        BaseObject* obj = 0;
+        switch(lo.type)
         {
-            readError = "Reading file was unsuccessful: " + fileName;
-            qDebug("Reading file was unsuccessful: %s\n", qPrintable(fileName));
+            case OBJ_TYPE_CIRCLE:    obj = new CircleObject(lo.x1, lo.y1, lo.x2, lo.color); break; //TODO: fill
+            case OBJ_TYPE_ELLIPSE:   obj = new EllipseObject(lo.x1, lo.y1, lo.x2, lo.y2, lo.color); break; //TODO: rotation and fill
+            case OBJ_TYPE_LINE:      obj = new LineObject(lo.x1, lo.y1, lo.x2, lo.y2, lo.color); break; //TODO: rotation
+            case OBJ_TYPE_PATH:      obj = new PathObject(0, 0, lo.path, lo.color); break;
+            case OBJ_TYPE_POINT:     obj = new PointObject(lo.x1, lo.y1, lo.color); break;
+            case OBJ_TYPE_POLYGON:   obj = new PolygonObject(lo.x1, lo.y1, lo.path, lo.color); break;
+            case OBJ_TYPE_POLYLINE:  obj = new PolylineObject(lo.x1, lo.y1, lo.path, lo.color); break;
+            case OBJ_TYPE_RECTANGLE: obj = new RectObject(lo.x1, lo.y1, lo.x2, lo.y2, lo.color); break; //TODO: rotation and fill
+            default: break;
         }
+        if(!obj)
+            continue;
+        obj->setObjectRubberMode(OBJ_RUBBER_OFF);
+        sceneList.append(obj);
     }
-    free(reader);
-    if(!readSuccessful)
+    gview->addObjects(sceneList);
+
+    //Bring the design into view as soon as there is something of it to see
+    if(!loadZoomed && !sceneList.isEmpty())
     {
-        QMessageBox::warning(this, tr("Error reading pattern"), tr(qPrintable(readError)));
+        gview->recalculateLimits();
+        gview->zoomExtents();
+        loadZoomed = true;
     }
+}
 
-    if(readSuccessful)
-    {
-        embPattern_moveStitchListToPolylines(p); //TODO: Test more
-        int stitchCount = embStitchList_count(p->stitchList);
-        QPainterPath path;
+void MdiWindow::loadFailed(const QString& error)
+{
+    if(!loader) return; //Canceled while this was queued
 
-        if(p->circleObjList)
-        {
-            EmbCircleObjectList* curCircleObj = p->circleObjList;
-            while(curCircleObj)
-            {
-                EmbCircle c = curCircleObj->circleObj.circle;
-                EmbColor thisColor = curCircleObj->circleObj.color;
-                setCurrentColor(qRgb(thisColor.r, thisColor.g, thisColor.b));
-                //NOTE: With natives, the Y+ is up and libembroidery Y+ is up, so inverting the Y is NOT needed.
-                mainWin->nativeAddCircle(embCircle_centerX(c), embCircle_centerY(c), embCircle_radius(c), false, OBJ_RUBBER_OFF); //TODO: fill
-                curCircleObj = curCircleObj->next;
-            }
-        }
-        if(p->ellipseObjList)
-        {
-            EmbEllipseObjectList* curEllipseObj = p->ellipseObjList;
-            while(curEllipseObj)
-            {
-                EmbEllipse e = curEllipseObj->ellipseObj.ellipse;
-                EmbColor thisColor = curEllipseObj->ellipseObj.color;
-                setCurrentColor(qRgb(thisColor.r, thisColor.g, thisColor.b));
-                //NOTE: With natives, the Y+ is up and libembroidery Y+ is up, so inverting the Y is NOT needed.
-                mainWin->nativeAddEllipse(embEllipse_centerX(e), embEllipse_centerY(e), embEllipse_width(e), embEllipse_height(e), 0, false, OBJ_RUBBER_OFF); //TODO: rotation and fill
-                curEllipseObj = curEllipseObj->next;
-            }
-        }
-        if(p->lineObjList)
-        {
-            EmbLineObjectList* curLineObj = p->lineObjList;
-            while(curLineObj)
-            {
-                EmbLine li = curLineObj->lineObj.line;
-                EmbColor thisColor = curLineObj->lineObj.color;
-                setCurrentColor(qRgb(thisColor.r, thisColor.g, thisColor.b));
-                //NOTE: With natives, the Y+ is up and libembroidery Y+ is up, so inverting the Y is NOT needed.
-                mainWin->nativeAddLine(embLine_x1(li), embLine_y1(li), embLine_x2(li), embLine_y2(li), 0, OBJ_RUBBER_OFF); //TODO: rotation
-                curLineObj = curLineObj->next;
-            }
-        }
-        if(p->pathObjList)
-        {
-            //TODO: This is unfinished. It needs more work
-            EmbPathObjectList* curPathObjList = p->pathObjList;
-            while(curPathObjList)
-            {
-                QPainterPath pathPath;
-                EmbPointList* curPointList = curPathObjList->pathObj->pointList;
-                EmbColor thisColor = curPathObjList->pathObj->color;
-                if(curPointList)
-                {
-                    EmbPoint pp = curPointList->point;
-                    pathPath.moveTo(embPoint_x(pp), -embPoint_y(pp)); //NOTE: Qt Y+ is down and libembroidery Y+ is up, so inverting the Y is needed.
-                    curPointList = curPointList->next;
-                }
-                while(curPointList)
-                {
-                    EmbPoint pp = curPointList->point;
-                    pathPath.lineTo(embPoint_x(pp), -embPoint_y(pp)); //NOTE: Qt Y+ is down and libembroidery Y+ is up, so inverting the Y is needed.
-                    curPointList = curPointList->next;
-                }
-
-                QPen loadPen(qRgb(thisColor.r, thisColor.g, thisColor.b));
-                loadPen.setWidthF(0.35);
-                loadPen.setCapStyle(Qt::RoundCap);
-                loadPen.setJoinStyle(Qt::RoundJoin);
-
-                PathObject* obj = new PathObject(0,0, pathPath, loadPen.color().rgb());
-                obj->setObjectRubberMode(OBJ_RUBBER_OFF);
-                gscene->addItem(obj);
-
-                curPathObjList = curPathObjList->next;
-            }
-        }
-        if(p->pointObjList)
-        {
-            EmbPointObjectList* curPointObj = p->pointObjList;
-            while(curPointObj)
-            {
-                EmbPoint po = curPointObj->pointObj.point;
-                EmbColor thisColor = curPointObj->pointObj.color;
-                setCurrentColor(qRgb(thisColor.r, thisColor.g, thisColor.b));
-                //NOTE: With natives, the Y+ is up and libembroidery Y+ is up, so inverting the Y is NOT needed.
-                mainWin->nativeAddPoint(embPoint_x(po), embPoint_y(po));
-                curPointObj = curPointObj->next;
-            }
-        }
-        if(p->polygonObjList)
-        {
-            EmbPolygonObjectList* curPolygonObjList = p->polygonObjList;
-            while(curPolygonObjList)
-            {
-                QPainterPath polygonPath;
-                bool firstPoint = false;
-                qreal startX = 0, startY = 0;
-                qreal x = 0, y = 0;
-                EmbPointList* curPointList = curPolygonObjList->polygonObj->pointList;
-                EmbColor thisColor = curPolygonObjList->polygonObj->color;
-                setCurrentColor(qRgb(thisColor.r, thisColor.g, thisColor.b));
-                while(curPointList)
-                {
-                    EmbPoint pp = curPointList->point;
-                    x = embPoint_x(pp);
-                    y = -embPoint_y(pp); //NOTE: Qt Y+ is down and libembroidery Y+ is up, so inverting the Y is needed.
-
-                    if(firstPoint) { polygonPath.lineTo(x,y); }
-                    else           { polygonPath.moveTo(x,y); firstPoint = true; startX = x; startY = y; }
-
-                    curPointList = curPointList->next;
-                }
-
-                polygonPath.translate(-startX, -startY);
-                mainWin->nativeAddPolygon(startX, startY, polygonPath, OBJ_RUBBER_OFF);
-
-                curPolygonObjList = curPolygonObjList->next;
-            }
-        }
-        /* NOTE: Polylines should only contain NORMAL stitches. */
-        if(p->polylineObjList)
-        {
-            EmbPolylineObjectList* curPolylineObjList = p->polylineObjList;
-            while(curPolylineObjList)
-            {
-                QPainterPath polylinePath;
-                bool firstPoint = false;
-                qreal startX = 0, startY = 0;
-                qreal x = 0, y = 0;
-                EmbPointList* curPointList = curPolylineObjList->polylineObj->pointList;
-                EmbColor thisColor = curPolylineObjList->polylineObj->color;
-                setCurrentColor(qRgb(thisColor.r, thisColor.g, thisColor.b));
-                while(curPointList)
-                {
-                    EmbPoint pp = curPointList->point;
-                    x = embPoint_x(pp);
-                    y = -embPoint_y(pp); //NOTE: Qt Y+ is down and libembroidery Y+ is up, so inverting the Y is needed.
-
-                    if(firstPoint) { polylinePath.lineTo(x,y); }
-                    else           { polylinePath.moveTo(x,y); firstPoint = true; startX = x; startY = y; }
-
-                    curPointList = curPointList->next;
-                }
-
-                polylinePath.translate(-startX, -startY);
-                mainWin->nativeAddPolyline(startX, startY, polylinePath, OBJ_RUBBER_OFF);
-
-                curPolylineObjList = curPolylineObjList->next;
-            }
-        }
-        if(p->rectObjList)
-        {
-            EmbRectObjectList* curRectObj = p->rectObjList;
-            while(curRectObj)
-            {
-                EmbRect r = curRectObj->rectObj.rect;
-                EmbColor thisColor = curRectObj->rectObj.color;
-                setCurrentColor(qRgb(thisColor.r, thisColor.g, thisColor.b));
-                //NOTE: With natives, the Y+ is up and libembroidery Y+ is up, so inverting the Y is NOT needed.
-                mainWin->nativeAddRectangle(embRect_x(r), embRect_y(r), embRect_width(r), embRect_height(r), 0, false, OBJ_RUBBER_OFF); //TODO: rotation and fill
-                curRectObj = curRectObj->next;
-            }
-        }
+    stopLoading();
+    QMessageBox::warning(this, tr("Error reading pattern"), error);
+    close();
+}
 
-        setCurrentFile(fileName);
-        mainWin->statusbar->showMessage("File loaded.");
-        QString stitches;
-        stitches.setNum(stitchCount);
+void MdiWindow::loadSucceeded()
+{
+    if(!loader) return; //Canceled while this was queued
 
-        if(mainWin->getSettingsGridLoadFromFile())
-        {
-            //TODO: Josh, provide me a hoop size and/or grid spacing from the pattern.
-        }
+    stopLoading();
+    mainWin->statusbar->showMessage(tr("File loaded."), 2000);
 
-        QApplication::restoreOverrideCursor();
-    }
-    else
+    if(mainWin->getSettingsGridLoadFromFile())
     {
-        QApplication::restoreOverrideCursor();
-        QMessageBox::warning(this, tr("Error reading pattern"), tr("Cannot read pattern"));
+        //TODO: Josh, provide me a hoop size and/or grid spacing from the pattern.
     }
-    embPattern_free(p);
-
-    //Clear the undo stack so it is not possible to undo past this point.
-    gview->getUndoStack()->clear();
 
-    setCurrentColor(tmpColor);
+    gview->recalculateLimits();
+    gview->zoomExtents();
 
     fileWasLoaded = true;
     mainWin->setUndoCleanIcon(fileWasLoaded);
-    return fileWasLoaded;
+    emit loadFinished(this);
+}
+
+void MdiWindow::cancelLoad()
+{
+    if(!loader) return;
+
+    qDebug("MdiWindow cancelLoad()");
+    stopLoading();
+    //NOTE: A partly loaded design is closed rather than kept, so it cannot be saved over the file by mistake.
+    mainWin->statusbar->showMessage(tr("Loading %1 canceled.").arg(getShortCurrentFile()), 2000);
+    close();
+}
+
+void MdiWindow::stopLoading()
+{
+    if(!loader) return;
+
+    //NOTE: The reader cannot be interrupted, so rather than waiting for it the loader is left to finish
+    //NOTE: on its own and delete itself. Nothing it still sends reaches this window.
+    loader->cancel();
+    disconnect(loader, 0, this, 0);
+    loader->setParent(0);
+    connect(loader, SIGNAL(finished()), loader, SLOT(deleteLater()));
+    if(loader->isFinished())
+        loader->deleteLater();
+    loader = 0;
+
+    mainWin->statusbar->removeWidget(loadProgress);
+    loadProgress->deleteLater();
+    loadProgress = 0;
+    loadProgressBar = 0;
+    loadCancelButton = 0;
+
+    gscene->setItemIndexMethod(loadIndexMethod);
 }
 
 void MdiWindow::print()
@@ -409,6 +361,7 @@ QString MdiWindow::fileExtension(const QString& fileName)
 void MdiWindow::closeEvent(QCloseEvent* /*e*/)
 {
     qDebug("MdiWindow closeEvent()");
+    stopLoading();
     emit sendCloseMdiWin(this);
 }
 
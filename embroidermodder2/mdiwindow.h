@@ -6,6 +6,7 @@
 #include <QMdiSubWindow>
 #include <QScrollBar>
 #include <QGridLayout>
+#include <QGraphicsScene>
 
 #if QT_VERSION >= 0x050000
 //Qt5
@@ -17,6 +18,7 @@
 
 
 #include "mainwindow.h"
+#include "file-loader.h"
 
 class MainWindow;
 class View;
@@ -25,6 +27,8 @@ QT_BEGIN_NAMESPACE
 class QMdiArea;
 class QGraphicsScene;
 class QGraphicsView;
+class QProgressBar;
+class QToolButton;
 QT_END_NAMESPACE
 
 class MdiWindow: public QMdiSubWindow
@@ -53,6 +57,7 @@ public:
     bool                       saveFile(const QString &fileName);
 signals:
     void                       sendCloseMdiWin(MdiWindow*);
+    void                       loadFinished(MdiWindow*);
 
 public slots:
     void                       closeEvent(QCloseEvent* e);
@@ -82,6 +87,14 @@ public slots:
     void promptInputPrevious();
     void promptInputNext();
 
+    void                       cancelLoad();
+
+private slots:
+    void                       loadProgressChanged(int value, int maximum);
+    void                       loadObjects(const QList<LoaderObject>& objList);
+    void                       loadFailed(const QString& error);
+    void                       loadSucceeded();
+
 protected:
 
 private:
@@ -92,6 +105,14 @@ private:
 
     bool                       fileWasLoaded;
 
+    FileLoader*                loader;
+    QWidget*                   loadProgress;
+    QProgressBar*              loadProgressBar;
+    QToolButton*               loadCancelButton;
+    bool                       loadZoomed;
+    QGraphicsScene::ItemIndexMethod loadIndexMethod;
+    void                       stopLoading();
+
     QString promptHistory;
     QList<QString> promptInputList;
     int promptInputNum;
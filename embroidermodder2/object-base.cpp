@@ -5,6 +5,22 @@
 #include <QMessageBox>
 #include <QDateTime>
 #include <QPainter>
+#include <QPixmapCache>
+#include <QStyleOptionGraphicsItem>
+#include <QVector>
+
+//NOTE: The level of detail is handled in zoom bands. Band b covers the zooms of up to 2^b pixels per unit,
+//NOTE: so the geometry and real render tiles cached for a band stay valid while zooming within it.
+#define LOD_BAND_MIN -16
+#define LOD_BAND_MAX  16
+#define LOD_TOLERANCE_PIXELS 0.5  //Points nearer than this to the last point kept are collapsed into it
+#define LOD_FULL_DETAIL 0.005     //Tolerances below this many units draw the full path
+#define LOD_MIN_ELEMENTS 64       //Paths with fewer elements than this are not worth simplifying
+#define LOD_MAX_BANDS 4           //Zoom bands cached per object
+#define REAL_RENDER_TILE 256      //Width and height of a real render tile in pixels
+
+//Every object gets a new key whenever its geometry changes, so its tiles from before are never found again
+static quint64 nextRenderKey = 1;
 
 BaseObject::BaseObject(QGraphicsItem* parent) : QGraphicsPathItem(parent)
 {
@@ -16,6 +32,7 @@ BaseObject::BaseObject(QGraphicsItem* parent) : QGraphicsPathItem(parent)
     lwtPen.setJoinStyle(Qt::RoundJoin);
 
     objID = QDateTime::currentMSecsSinceEpoch();
+    objRenderKey = nextRenderKey++;
 }
 
 BaseObject::~BaseObject()
@@ -110,7 +127,217 @@ void BaseObject::drawRubberLine(const QLineF& rubLine, QPainter* painter, const
     }
 }
 
+void BaseObject::invalidateRenderCache()
+{
+    objRenderKey = nextRenderKey++;
+    objLodPaths.clear();
+    objLodTiles.clear();
+}
+
+int BaseObject::lodBand(QPainter* painter) const
+{
+    qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if(lod <= 0)
+        return LOD_BAND_MAX;
+    return qBound(LOD_BAND_MIN, qCeil(qLn(lod)/qLn(2.0)), LOD_BAND_MAX);
+}
+
+QPainterPath BaseObject::lodPath(QPainter* painter, const QPainterPath& renderPath)
+{
+    int band = lodBand(painter);
+    qreal tolerance = LOD_TOLERANCE_PIXELS/qPow(2.0, band);
+    int count = renderPath.elementCount();
+    if(tolerance < LOD_FULL_DETAIL || count < LOD_MIN_ELEMENTS)
+        return renderPath;
+    if(objLodPaths.contains(band))
+        return objLodPaths.value(band);
+
+    //Only straight segments, such as stitches, are simplified
+    for(int i = 0; i < count; ++i)
+    {
+        if(renderPath.elementAt(i).isCurveTo())
+            return renderPath;
+    }
+
+    //Stitches shorter than the tolerance collapse into the point before them.
+    //The last point of every subpath is kept so nothing ends short.
+    QPainterPath simplePath;
+    QPointF kept;
+    QPointF pending;
+    bool hasPending = false;
+    for(int i = 0; i < count; ++i)
+    {
+        QPainterPath::Element elem = renderPath.elementAt(i);
+        QPointF point(elem.x, elem.y);
+        if(elem.isMoveTo())
+        {
+            if(hasPending) { simplePath.lineTo(pending); hasPending = false; }
+            simplePath.moveTo(point);
+            kept = point;
+        }
+        else if(qAbs(point.x() - kept.x()) < tolerance && qAbs(point.y() - kept.y()) < tolerance)
+        {
+            pending = point;
+            hasPending = true;
+        }
+        else
+        {
+            simplePath.lineTo(point);
+            kept = point;
+            hasPending = false;
+        }
+    }
+    if(hasPending) { simplePath.lineTo(pending); }
+
+    if(objLodPaths.count() >= LOD_MAX_BANDS) { objLodPaths.clear(); }
+    objLodPaths.insert(band, simplePath);
+    return simplePath;
+}
+
 void BaseObject::realRender(QPainter* painter, const QPainterPath& renderPath)
+{
+    int band = lodBand(painter);
+    qreal bandScale = qPow(2.0, band);
+    qreal threadWidth = objectLineWeight();
+
+    //Shading a thread narrower than a pixel shows nothing the plain path does not
+    if(threadWidth*bandScale < 1.0)
+        return;
+
+    //NOTE: The shading is rendered into tiles of REAL_RENDER_TILE pixels at the scale of the zoom band.
+    //NOTE: They are kept in the QPixmapCache, so panning and repainting only draws pixmaps,
+    //NOTE: and only the tiles in view that have not been rendered yet cost any stroking.
+    QPainterPath simplePath = lodPath(painter, renderPath);
+    qreal tileSize = REAL_RENDER_TILE/bandScale;
+    qreal margin = threadWidth/2;
+
+    QRectF visible = painter->worldTransform().inverted().mapRect(QRectF(painter->viewport()));
+    QRectF area = simplePath.boundingRect().adjusted(-margin, -margin, margin, margin).intersected(visible);
+    if(area.isEmpty())
+        return;
+    int firstX = qFloor(area.left()/tileSize);
+    int lastX  = qFloor(area.right()/tileSize);
+    int firstY = qFloor(area.top()/tileSize);
+    int lastY  = qFloor(area.bottom()/tileSize);
+
+    //Tiles of this band that have no part of the thread in them
+    if(!objLodTiles.contains(band) && objLodTiles.count() >= LOD_MAX_BANDS) { objLodTiles.clear(); }
+    QSet<qint64>& emptyTiles = objLodTiles[band];
+
+    //NOTE: Every object in view needs tiles of its own, and the grid tiles share the cache with them.
+    //NOTE: When they cannot all be kept, each repaint would evict tiles the next one needs again and pay for
+    //NOTE: filling pixmaps on top of the stroking, so the segments in view are shaded directly instead.
+    int tileCount = 0;
+    for(int ty = firstY; ty <= lastY; ++ty)
+    {
+        for(int tx = firstX; tx <= lastX; ++tx)
+        {
+            if(!emptyTiles.contains(((qint64)ty << 32) | (quint32)tx))
+                tileCount++;
+        }
+    }
+    int layers = 1;
+    if(scene()) { layers += scene()->items(visible, Qt::IntersectsItemBoundingRect).count(); }
+    qint64 tileKilobytes = REAL_RENDER_TILE*REAL_RENDER_TILE*4/1024;
+    if(tileCount*tileKilobytes*layers > QPixmapCache::cacheLimit())
+    {
+        QVector<int> segments;
+        int count = simplePath.elementCount();
+        for(int i = 0; i < count-1; ++i)
+        {
+            QPainterPath::Element elem = simplePath.elementAt(i);
+            QPainterPath::Element next = simplePath.elementAt(i+1);
+            if(next.isMoveTo()) continue;
+            QRectF segRect = QRectF(QPointF(elem.x, elem.y), QPointF(next.x, next.y)).normalized().adjusted(-margin, -margin, margin, margin);
+            if(segRect.intersects(visible))
+                segments.append(i);
+        }
+        realRenderSegments(painter, simplePath, segments, threadWidth);
+        return;
+    }
+
+    QString keyPrefix = QString("real:%1:%2:%3:%4:").arg(objRenderKey).arg(objectColorRGB()).arg(threadWidth).arg(band);
+    QHash<qint64, QPixmap> tiles;
+    QHash<qint64, QVector<int> > missing;
+    for(int ty = firstY; ty <= lastY; ++ty)
+    {
+        for(int tx = firstX; tx <= lastX; ++tx)
+        {
+            qint64 index = ((qint64)ty << 32) | (quint32)tx;
+            if(emptyTiles.contains(index))
+                continue;
+            QPixmap tile;
+            if(QPixmapCache::find(keyPrefix + QString("%1:%2").arg(tx).arg(ty), &tile))
+                tiles.insert(index, tile);
+            else
+                missing.insert(index, QVector<int>());
+        }
+    }
+
+    if(!missing.isEmpty())
+    {
+        //Sort the segments into the tiles they cross in one pass over the path
+        int count = simplePath.elementCount();
+        for(int i = 0; i < count-1; ++i)
+        {
+            QPainterPath::Element elem = simplePath.elementAt(i);
+            QPainterPath::Element next = simplePath.elementAt(i+1);
+            if(next.isMoveTo()) continue;
+
+            QRectF segRect = QRectF(QPointF(elem.x, elem.y), QPointF(next.x, next.y)).normalized().adjusted(-margin, -margin, margin, margin);
+            int segFirstX = qMax(firstX, qFloor(segRect.left()/tileSize));
+            int segLastX  = qMin(lastX,  qFloor(segRect.right()/tileSize));
+            int segFirstY = qMax(firstY, qFloor(segRect.top()/tileSize));
+            int segLastY  = qMin(lastY,  qFloor(segRect.bottom()/tileSize));
+            for(int ty = segFirstY; ty <= segLastY; ++ty)
+            {
+                for(int tx = segFirstX; tx <= segLastX; ++tx)
+                {
+                    QHash<qint64, QVector<int> >::iterator it = missing.find(((qint64)ty << 32) | (quint32)tx);
+                    if(it != missing.end())
+                        it.value().append(i);
+                }
+            }
+        }
+
+        QHash<qint64, QVector<int> >::const_iterator it;
+        for(it = missing.constBegin(); it != missing.constEnd(); ++it)
+        {
+            int tx = (qint32)(it.key() & 0xFFFFFFFF);
+            int ty = (qint32)(it.key() >> 32);
+            if(it.value().isEmpty())
+            {
+                emptyTiles.insert(it.key());
+                continue;
+            }
+
+            QPixmap tile(REAL_RENDER_TILE, REAL_RENDER_TILE);
+            tile.fill(Qt::transparent);
+            QPainter tilePainter(&tile);
+            tilePainter.setRenderHint(QPainter::Antialiasing);
+            tilePainter.scale(bandScale, bandScale);
+            tilePainter.translate(-tx*tileSize, -ty*tileSize);
+            realRenderSegments(&tilePainter, simplePath, it.value(), threadWidth);
+            tilePainter.end();
+
+            QPixmapCache::insert(keyPrefix + QString("%1:%2").arg(tx).arg(ty), tile);
+            tiles.insert(it.key(), tile);
+        }
+    }
+
+    painter->save();
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+    QHash<qint64, QPixmap>::const_iterator tileIt;
+    for(tileIt = tiles.constBegin(); tileIt != tiles.constEnd(); ++tileIt)
+    {
+        int tx = (qint32)(tileIt.key() & 0xFFFFFFFF);
+        int ty = (qint32)(tileIt.key() >> 32);
+        painter->drawPixmap(QRectF(tx*tileSize, ty*tileSize, tileSize, tileSize), tileIt.value(), QRectF(0, 0, REAL_RENDER_TILE, REAL_RENDER_TILE));
+    }
+    painter->restore();
+}
+
+void BaseObject::realRenderSegments(QPainter* painter, const QPainterPath& renderPath, const QVector<int>& segments, qreal width)
 {
     QColor color1 = objectColor();       //lighter color
     QColor color2  = color1.darker(150); //darker color
@@ -125,27 +352,20 @@ void BaseObject::realRender(QPainter* painter, const QPainterPath& renderPath)
         else          { color1 = color2.lighter(100 + threshold); }
     }
 
-    int count = renderPath.elementCount();
-    for(int i = 0; i < count-1; ++i)
+    QPainterPathStroker stroker;
+    stroker.setWidth(width);
+    stroker.setCapStyle(Qt::RoundCap);
+    stroker.setJoinStyle(Qt::RoundJoin);
+
+    foreach(int i, segments)
     {
         QPainterPath::Element elem = renderPath.elementAt(i);
         QPainterPath::Element next = renderPath.elementAt(i+1);
 
-        if(next.isMoveTo()) continue;
-
         QPainterPath elemPath;
         elemPath.moveTo(elem.x, elem.y);
         elemPath.lineTo(next.x, next.y);
-
-        QPen renderPen(QColor(0,0,0,0));
-        renderPen.setWidthF(0);
-        painter->setPen(renderPen);
-        QPainterPathStroker stroker;
-        stroker.setWidth(0.35);
-        stroker.setCapStyle(Qt::RoundCap);
-        stroker.setJoinStyle(Qt::RoundJoin);
         QPainterPath realPath = stroker.createStroke(elemPath);
-        painter->drawPath(realPath);
 
         QLinearGradient grad(elemPath.pointAtPercent(0.5), elemPath.pointAtPercent(0.0));
         grad.setColorAt(0, color1);
@@ -4,6 +4,8 @@
 #include "object-data.h"
 
 #include <QHash>
+#include <QSet>
+#include <QVector>
 #include <QPen>
 #include <QGraphicsPathItem>
 #include <QtCore/qmath.h>
@@ -29,17 +31,17 @@ public:
     QString      objectRubberText(const QString& key) const;
 
     QRectF rect() const { return path().boundingRect(); }
-    void setRect(const QRectF& r) { QPainterPath p; p.addRect(r); setPath(p); }
-    void setRect(qreal x, qreal y, qreal w, qreal h) { QPainterPath p; p.addRect(x,y,w,h); setPath(p); }
+    void setRect(const QRectF& r) { QPainterPath p; p.addRect(r); setPath(p); invalidateRenderCache(); }
+    void setRect(qreal x, qreal y, qreal w, qreal h) { QPainterPath p; p.addRect(x,y,w,h); setPath(p); invalidateRenderCache(); }
     QLineF line() const { return objLine; }
-    void setLine(const QLineF& li) { QPainterPath p; p.moveTo(li.p1()); p.lineTo(li.p2()); setPath(p); objLine = li; }
-    void setLine(qreal x1, qreal y1, qreal x2, qreal y2) { QPainterPath p; p.moveTo(x1,y1); p.lineTo(x2,y2); setPath(p); objLine.setLine(x1,y1,x2,y2); }
+    void setLine(const QLineF& li) { QPainterPath p; p.moveTo(li.p1()); p.lineTo(li.p2()); setPath(p); objLine = li; invalidateRenderCache(); }
+    void setLine(qreal x1, qreal y1, qreal x2, qreal y2) { QPainterPath p; p.moveTo(x1,y1); p.lineTo(x2,y2); setPath(p); objLine.setLine(x1,y1,x2,y2); invalidateRenderCache(); }
 
     void setObjectColor(const QColor& color);
     void setObjectColorRGB(QRgb rgb);
     void setObjectLineType(Qt::PenStyle lineType);
     void setObjectLineWeight(qreal lineWeight);
-    void setObjectPath(const QPainterPath& p) { setPath(p); }
+    void setObjectPath(const QPainterPath& p) { setPath(p); invalidateRenderCache(); }
     void setObjectRubberMode(int mode) { objRubberMode = mode; }
     void setObjectRubberPoint(const QString& key, const QPointF& point) { objRubberPoints.insert(key, point); }
     void setObjectRubberText(const QString& key, const QString& txt) { objRubberTexts.insert(key, txt); }
@@ -59,7 +61,11 @@ protected:
     inline qreal radians(qreal degree) const { return (degree*pi()/180.0); }
     inline qreal degrees(qreal radian) const { return (radian*180.0/pi()); }
     void realRender(QPainter* painter, const QPainterPath& renderPath);
+    QPainterPath lodPath(QPainter* painter, const QPainterPath& renderPath);
+    void invalidateRenderCache();
 private:
+    int lodBand(QPainter* painter) const;
+    void realRenderSegments(QPainter* painter, const QPainterPath& renderPath, const QVector<int>& segments, qreal width);
     QPen objPen;
     QPen lwtPen;
     QLineF objLine;
@@ -67,6 +73,11 @@ private:
     QHash<QString, QPointF> objRubberPoints;
     QHash<QString, QString> objRubberTexts;
     qint64 objID;
+
+    //Level of detail caches, keyed by zoom band. See lodBand().
+    quint64 objRenderKey;
+    QHash<int, QPainterPath> objLodPaths;
+    QHash<int, QSet<qint64> > objLodTiles;
 };
 
 #endif
@@ -67,7 +67,8 @@ void PolylineObject::paint(QPainter* painter, const QStyleOptionGraphicsItem* op
     if(objScene->property(ENABLE_LWT).toBool()) { paintPen = lineWeightPen(); }
     painter->setPen(paintPen);
 
-    painter->drawPath(normalPath);
+    //NOTE: Stitches smaller than a pixel at the current zoom are collapsed. Zoomed in, the full path is drawn.
+    painter->drawPath(lodPath(painter, normalPath));
 
     if(objScene->property(ENABLE_LWT).toBool() && objScene->property(ENABLE_REAL).toBool()) { realRender(painter, normalPath); }
 }
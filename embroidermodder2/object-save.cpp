@@ -63,37 +63,7 @@ bool SaveObject::save(const QString &fileName)
     if(!writer) { qDebug("Unsupported write file type: %s", qPrintable(fileName)); }
     else
     {
-        foreach(QGraphicsItem* item, gscene->items(Qt::AscendingOrder))
-        {
-            int objType = item->data(OBJ_TYPE).toInt();
-
-            if     (objType == OBJ_TYPE_ARC)          { addArc(pattern, item);          }
-            else if(objType == OBJ_TYPE_BLOCK)        { addBlock(pattern, item);        }
-            else if(objType == OBJ_TYPE_CIRCLE)       { addCircle(pattern, item);       }
-            else if(objType == OBJ_TYPE_DIMALIGNED)   { addDimAligned(pattern, item);   }
-            else if(objType == OBJ_TYPE_DIMANGULAR)   { addDimAngular(pattern, item);   }
-            else if(objType == OBJ_TYPE_DIMARCLENGTH) { addDimArcLength(pattern, item); }
-            else if(objType == OBJ_TYPE_DIMDIAMETER)  { addDimDiameter(pattern, item);  }
-            else if(objType == OBJ_TYPE_DIMLEADER)    { addDimLeader(pattern, item);    }
-            else if(objType == OBJ_TYPE_DIMLINEAR)    { addDimLinear(pattern, item);    }
-            else if(objType == OBJ_TYPE_DIMORDINATE)  { addDimOrdinate(pattern, item);  }
-            else if(objType == OBJ_TYPE_DIMRADIUS)    { addDimRadius(pattern, item);    }
-            else if(objType == OBJ_TYPE_ELLIPSE)      { addEllipse(pattern, item);      }
-            else if(objType == OBJ_TYPE_ELLIPSEARC)   { addEllipseArc(pattern, item);   }
-            else if(objType == OBJ_TYPE_GRID)         { addGrid(pattern, item);         }
-            else if(objType == OBJ_TYPE_HATCH)        { addHatch(pattern, item);        }
-            else if(objType == OBJ_TYPE_IMAGE)        { addImage(pattern, item);        }
-            else if(objType == OBJ_TYPE_INFINITELINE) { addInfiniteLine(pattern, item); }
-            else if(objType == OBJ_TYPE_LINE)         { addLine(pattern, item);         }
-            else if(objType == OBJ_TYPE_POINT)        { addPoint(pattern, item);        }
-            else if(objType == OBJ_TYPE_POLYGON)      { addPolygon(pattern, item);      }
-            else if(objType == OBJ_TYPE_POLYLINE)     { addPolyline(pattern, item);     }
-            else if(objType == OBJ_TYPE_RAY)          { addRay(pattern, item);          }
-            else if(objType == OBJ_TYPE_RECTANGLE)    { addRectangle(pattern, item);    }
-            else if(objType == OBJ_TYPE_SPLINE)       { addSpline(pattern, item);       }
-            else if(objType == OBJ_TYPE_TEXTMULTI)    { addTextMulti(pattern, item);    }
-            else if(objType == OBJ_TYPE_TEXTSINGLE)   { addTextSingle(pattern, item);   }
-        }
+        addItems(pattern);
 
         //TODO: handle EMBFORMAT_STCHANDOBJ also
         if(formatType == EMBFORMAT_STITCHONLY)
@@ -111,6 +81,41 @@ bool SaveObject::save(const QString &fileName)
     return writeSuccessful;
 }
 
+void SaveObject::addItems(EmbPattern* pattern)
+{
+    foreach(QGraphicsItem* item, gscene->items(Qt::AscendingOrder))
+    {
+        int objType = item->data(OBJ_TYPE).toInt();
+
+        if     (objType == OBJ_TYPE_ARC)          { addArc(pattern, item);          }
+        else if(objType == OBJ_TYPE_BLOCK)        { addBlock(pattern, item);        }
+        else if(objType == OBJ_TYPE_CIRCLE)       { addCircle(pattern, item);       }
+        else if(objType == OBJ_TYPE_DIMALIGNED)   { addDimAligned(pattern, item);   }
+        else if(objType == OBJ_TYPE_DIMANGULAR)   { addDimAngular(pattern, item);   }
+        else if(objType == OBJ_TYPE_DIMARCLENGTH) { addDimArcLength(pattern, item); }
+        else if(objType == OBJ_TYPE_DIMDIAMETER)  { addDimDiameter(pattern, item);  }
+        else if(objType == OBJ_TYPE_DIMLEADER)    { addDimLeader(pattern, item);    }
+        else if(objType == OBJ_TYPE_DIMLINEAR)    { addDimLinear(pattern, item);    }
+        else if(objType == OBJ_TYPE_DIMORDINATE)  { addDimOrdinate(pattern, item);  }
+        else if(objType == OBJ_TYPE_DIMRADIUS)    { addDimRadius(pattern, item);    }
+        else if(objType == OBJ_TYPE_ELLIPSE)      { addEllipse(pattern, item);      }
+        else if(objType == OBJ_TYPE_ELLIPSEARC)   { addEllipseArc(pattern, item);   }
+        else if(objType == OBJ_TYPE_GRID)         { addGrid(pattern, item);         }
+        else if(objType == OBJ_TYPE_HATCH)        { addHatch(pattern, item);        }
+        else if(objType == OBJ_TYPE_IMAGE)        { addImage(pattern, item);        }
+        else if(objType == OBJ_TYPE_INFINITELINE) { addInfiniteLine(pattern, item); }
+        else if(objType == OBJ_TYPE_LINE)         { addLine(pattern, item);         }
+        else if(objType == OBJ_TYPE_POINT)        { addPoint(pattern, item);        }
+        else if(objType == OBJ_TYPE_POLYGON)      { addPolygon(pattern, item);      }
+        else if(objType == OBJ_TYPE_POLYLINE)     { addPolyline(pattern, item);     }
+        else if(objType == OBJ_TYPE_RAY)          { addRay(pattern, item);          }
+        else if(objType == OBJ_TYPE_RECTANGLE)    { addRectangle(pattern, item);    }
+        else if(objType == OBJ_TYPE_SPLINE)       { addSpline(pattern, item);       }
+        else if(objType == OBJ_TYPE_TEXTMULTI)    { addTextMulti(pattern, item);    }
+        else if(objType == OBJ_TYPE_TEXTSINGLE)   { addTextSingle(pattern, item);   }
+    }
+}
+
 void SaveObject::addArc(EmbPattern* pattern, QGraphicsItem* item)
 {
 }
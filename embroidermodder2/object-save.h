@@ -20,6 +20,7 @@ public:
     ~SaveObject();
 
     bool save(const QString &fileName);
+    void addItems(EmbPattern* pattern);
 
     void addArc          (EmbPattern* pattern, QGraphicsItem* item);
     void addBlock        (EmbPattern* pattern, QGraphicsItem* item);
@@ -25,10 +25,20 @@
 #include <QGraphicsScene>
 #include <QGLWidget>
 
+//NOTE: The grid and origin are drawn from tiles of GRID_TILE pixels square that are rendered at the current zoom
+//NOTE: and kept in the QPixmapCache. Every new grid gets a new key, so the tiles of the grid before are never found again.
+#define GRID_TILE 256
+static quint64 nextGridKey = 1;
+
+//NOTE: Mouse moves are passed to a command with move rapid fire enabled at most once every RAPID_MOVE_INTERVAL ms,
+//NOTE: which is about once per frame. The call always gets the latest mouse position.
+#define RAPID_MOVE_INTERVAL 16
+
 View::View(MainWindow* mw, QGraphicsScene* theScene, QWidget* parent) : QGraphicsView(theScene, parent)
 {
     mainWin = mw;
     gscene = theScene;
+    gridKey = 0;
 
     setFrameShape(QFrame::NoFrame);
 
@@ -77,6 +87,9 @@ View::View(MainWindow* mw, QGraphicsScene* theScene, QWidget* parent) : QGraphic
 
     grippingActive = false;
     rapidMoveActive = false;
+    rapidMoveTimer = new QTimer(this);
+    rapidMoveTimer->setSingleShot(true);
+    connect(rapidMoveTimer, SIGNAL(timeout()), this, SLOT(runRapidMove()));
     previewMode = PREVIEW_MODE_NULL;
     previewData = 0;
     previewObjectItemGroup = 0;
@@ -145,6 +158,28 @@ void View::addObject(BaseObject* obj)
     hashDeletedObjects.remove(obj->objectID());
 }
 
+//NOTE: This bypasses the undo stack, so it is only meant for populating a scene, such as when a file is loaded.
+void View::addObjects(const QList<BaseObject*>& objList)
+{
+    if(objList.isEmpty())
+        return;
+
+    //Build the index once when the last item is in rather than updating it for every item
+    QGraphicsScene::ItemIndexMethod indexMethod = gscene->itemIndexMethod();
+    gscene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    bool updates = updatesEnabled();
+    setUpdatesEnabled(false);
+
+    foreach(BaseObject* obj, objList)
+    {
+        gscene->addItem(obj);
+    }
+
+    gscene->setItemIndexMethod(indexMethod);
+    setUpdatesEnabled(updates);
+    gscene->update();
+}
+
 void View::deleteObject(BaseObject* obj)
 {
     //NOTE: We really just remove the objects from the scene. deletion actually occurs in the destructor.
@@ -212,6 +247,32 @@ void View::enableMoveRapidFire()
 void View::disableMoveRapidFire()
 {
     rapidMoveActive = false;
+    rapidMoveTimer->stop();
+}
+
+void View::runRapidMove()
+{
+    rapidMoveClock.start();
+    //A move waiting for a command that has since ended is not given to the next one
+    if(rapidMoveActive && mainWin->isCommandActive() && mainWin->activeCommand() == rapidMoveCommand)
+    {
+        mainWin->runCommandMove(mainWin->activeCommand(), sceneMovePoint.x(), sceneMovePoint.y());
+    }
+}
+
+void View::flushRapidMove()
+{
+    //Let the command see where the mouse went before anything else happens
+    if(rapidMoveTimer->isActive())
+    {
+        rapidMoveTimer->stop();
+        runRapidMove();
+    }
+}
+
+void View::dropRapidMove()
+{
+    rapidMoveTimer->stop();
 }
 
 bool View::allowRubber()
@@ -337,11 +398,14 @@ void View::setRulerColor(QRgb color)
 
 void View::createGrid(const QString& gridType)
 {
+    gridKey = nextGridKey++;
+
     if     (gridType == "Rectangular") { createGridRect();  gscene->setProperty(ENABLE_GRID, true); }
     else if(gridType == "Circular")    { createGridPolar(); gscene->setProperty(ENABLE_GRID, true); }
     else if(gridType == "Isometric")   { createGridIso();   gscene->setProperty(ENABLE_GRID, true); }
     else                               { gridPath = QPainterPath(); gscene->setProperty(ENABLE_GRID, false); }
 
+    splitGrid();
     createOrigin();
 
     gscene->update();
@@ -380,15 +444,16 @@ void View::createGridRect()
 
     gridPath = QPainterPath();
     gridPath.addRect(gr);
+    //Each line spans the whole grid, so it is only added once
+    for(qreal gy = y1; gy < y2; gy += ySpacing)
+    {
+        gridPath.moveTo(x1,gy);
+        gridPath.lineTo(x2,gy);
+    }
     for(qreal gx = x1; gx < x2; gx += xSpacing)
     {
-        for(qreal gy = y1; gy < y2; gy += ySpacing)
-        {
-            gridPath.moveTo(x1,gy);
-            gridPath.lineTo(x2,gy);
-            gridPath.moveTo(gx,y1);
-            gridPath.lineTo(gx,y2);
-        }
+        gridPath.moveTo(gx,y1);
+        gridPath.lineTo(gx,y2);
     }
 
     //Center the Grid
@@ -453,18 +518,18 @@ void View::createGridIso()
     gridPath.lineTo(p3);
     gridPath.lineTo(p1);
 
+    //Each line spans the whole grid, so it is only added once
     for(qreal x = 0; x < isoW; x += xSpacing)
     {
-        for(qreal y = 0; y < isoH; y += ySpacing)
-        {
-            QPointF px = QLineF::fromPolar(x,  30).p2();
-            QPointF py = QLineF::fromPolar(y, 150).p2();
-
-            gridPath.moveTo(px);
-            gridPath.lineTo(px+p3);
-            gridPath.moveTo(py);
-            gridPath.lineTo(py+p2);
-        }
+        QPointF px = QLineF::fromPolar(x,  30).p2();
+        gridPath.moveTo(px);
+        gridPath.lineTo(px+p3);
+    }
+    for(qreal y = 0; y < isoH; y += ySpacing)
+    {
+        QPointF py = QLineF::fromPolar(y, 150).p2();
+        gridPath.moveTo(py);
+        gridPath.lineTo(py+p2);
     }
 
     //Center the Grid
@@ -589,14 +654,100 @@ void View::drawBackground(QPainter* painter, const QRectF& rect)
 
     if(gscene->property(ENABLE_GRID).toBool() && rect.intersects(gridPath.controlPointRect()))
     {
-        QPen gridPen(gridColor);
-        gridPen.setJoinStyle(Qt::MiterJoin);
-        gridPen.setCosmetic(true);
-        painter->setPen(gridPen);
-        painter->drawPath(gridPath);
-        painter->drawPath(originPath);
-        painter->fillPath(originPath, gridColor);
+        QTransform transform = painter->worldTransform();
+        qreal scaleX = transform.m11();
+        qreal scaleY = transform.m22();
+        //Rotated, sheared or mirrored views draw the grid directly
+        if(transform.type() > QTransform::TxScale || scaleX <= 0 || scaleY <= 0)
+        {
+            drawGrid(painter, rect);
+            return;
+        }
+
+        //Tiles are aligned to the scene origin, so the same ones are found again while panning at this zoom
+        qreal tileW = GRID_TILE/scaleX;
+        qreal tileH = GRID_TILE/scaleY;
+        QRectF area = rect.intersected(gridPath.controlPointRect().united(originPath.controlPointRect()));
+        int firstX = qFloor(area.left()/tileW);
+        int lastX  = qFloor(area.right()/tileW);
+        int firstY = qFloor(area.top()/tileH);
+        int lastY  = qFloor(area.bottom()/tileH);
+
+        QString keyPrefix = QString("grid:%1:%2:%3:%4:").arg(gridKey).arg(gridColor.rgba()).arg(scaleX, 0, 'g', 12).arg(scaleY, 0, 'g', 12);
+        painter->save();
+        for(int ty = firstY; ty <= lastY; ++ty)
+        {
+            for(int tx = firstX; tx <= lastX; ++tx)
+            {
+                QString key = keyPrefix + QString("%1:%2").arg(tx).arg(ty);
+                QPixmap tile;
+                if(!QPixmapCache::find(key, &tile))
+                {
+                    tile = QPixmap(GRID_TILE, GRID_TILE);
+                    tile.fill(Qt::transparent);
+                    QPainter tilePainter(&tile);
+                    tilePainter.setRenderHints(painter->renderHints());
+                    tilePainter.scale(scaleX, scaleY);
+                    tilePainter.translate(-tx*tileW, -ty*tileH);
+                    //Lines within a pixel of the tile still touch its edge pixels
+                    QRectF tileRect(tx*tileW, ty*tileH, tileW, tileH);
+                    drawGrid(&tilePainter, tileRect.adjusted(-1/scaleX, -1/scaleY, 1/scaleX, 1/scaleY));
+                    tilePainter.end();
+                    QPixmapCache::insert(key, tile);
+                }
+                painter->drawPixmap(QRectF(tx*tileW, ty*tileH, tileW, tileH), tile, QRectF(0, 0, GRID_TILE, GRID_TILE));
+            }
+        }
+        painter->restore();
+    }
+}
+
+void View::splitGrid()
+{
+    //Each subpath of the grid is kept on its own with its bounds, so drawing an area only strokes the lines and circles that reach it
+    gridParts.clear();
+    gridPartBounds.clear();
+    QPainterPath part;
+    for(int i = 0; i < gridPath.elementCount(); ++i)
+    {
+        const QPainterPath::Element& e = gridPath.elementAt(i);
+        if(e.isMoveTo())
+        {
+            if(part.elementCount() > 1) { gridParts.append(part); gridPartBounds.append(part.controlPointRect()); }
+            part = QPainterPath();
+            part.moveTo(e.x, e.y);
+        }
+        else if(e.isLineTo())
+        {
+            part.lineTo(e.x, e.y);
+        }
+        else if(e.isCurveTo() && i+2 < gridPath.elementCount())
+        {
+            const QPainterPath::Element& c2 = gridPath.elementAt(i+1);
+            const QPainterPath::Element& end = gridPath.elementAt(i+2);
+            part.cubicTo(e.x, e.y, c2.x, c2.y, end.x, end.y);
+            i += 2;
+        }
+    }
+    if(part.elementCount() > 1) { gridParts.append(part); gridPartBounds.append(part.controlPointRect()); }
+}
+
+void View::drawGrid(QPainter* painter, const QRectF& area)
+{
+    QPen gridPen(gridColor);
+    gridPen.setJoinStyle(Qt::MiterJoin);
+    gridPen.setCosmetic(true);
+    painter->setPen(gridPen);
+    for(int i = 0; i < gridParts.size(); ++i)
+    {
+        //Straight grid lines have bounds with no width or height, which QRectF::intersects() never matches
+        const QRectF& bounds = gridPartBounds.at(i);
+        if(bounds.right() >= area.left() && bounds.left() <= area.right() &&
+           bounds.bottom() >= area.top() && bounds.top() <= area.bottom())
+            painter->drawPath(gridParts.at(i));
     }
+    painter->drawPath(originPath);
+    painter->fillPath(originPath, gridColor);
 }
 
 void View::drawForeground(QPainter* painter, const QRectF& rect)
@@ -1275,6 +1426,7 @@ void View::mousePressEvent(QMouseEvent* event)
     {
         if(mainWin->isCommandActive())
         {
+            flushRapidMove();
             QPointF cmdPoint = mapToScene(event->pos());
             mainWin->runCommandClick(mainWin->activeCommand(), cmdPoint.x(), cmdPoint.y());
             return;
@@ -1524,9 +1676,12 @@ void View::mouseMoveEvent(QMouseEvent* event)
 
     if(mainWin->isCommandActive())
     {
-        if(rapidMoveActive)
+        //A move already waiting to run picks up this position
+        if(rapidMoveActive && !rapidMoveTimer->isActive())
         {
-            mainWin->runCommandMove(mainWin->activeCommand(), sceneMovePoint.x(), sceneMovePoint.y());
+            qint64 elapsed = rapidMoveClock.isValid() ? rapidMoveClock.elapsed() : RAPID_MOVE_INTERVAL;
+            rapidMoveCommand = mainWin->activeCommand();
+            rapidMoveTimer->start((int)qMax(qint64(0), RAPID_MOVE_INTERVAL - elapsed));
         }
     }
     if(previewActive)
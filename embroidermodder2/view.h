@@ -3,6 +3,7 @@
 
 #include <QGraphicsView>
 #include <QGraphicsScene>
+#include <QElapsedTimer>
 #include "mainwindow.h"
 
 class MainWindow;
@@ -12,6 +13,7 @@ class SelectBox;
 QT_BEGIN_NAMESPACE
 class QGraphicsScene;
 class QUndoStack;
+class QTimer;
 QT_END_NAMESPACE
 
 class View : public QGraphicsView
@@ -32,6 +34,7 @@ public:
 
     QUndoStack* getUndoStack() { return undoStack; }
     void addObject(BaseObject* obj);
+    void addObjects(const QList<BaseObject*>& objList);
     void deleteObject(BaseObject* obj);
     void vulcanizeObject(BaseObject* obj);
 
@@ -96,6 +99,8 @@ public slots:
 
     void enableMoveRapidFire();
     void disableMoveRapidFire();
+    void flushRapidMove();
+    void dropRapidMove();
 
     bool allowRubber();
     void addToRubberRoom(QGraphicsItem* item);
@@ -106,6 +111,9 @@ public slots:
     void setRubberPoint(const QString& key, const QPointF& point);
     void setRubberText(const QString& key, const QString& txt);
 
+private slots:
+    void runRapidMove();
+
 protected:
     void mouseDoubleClickEvent(QMouseEvent* event);
     void mousePressEvent(QMouseEvent* event);
@@ -124,6 +132,11 @@ private:
 
     QColor gridColor;
     QPainterPath gridPath;
+    QList<QPainterPath> gridParts;
+    QList<QRectF> gridPartBounds;
+    quint64 gridKey;
+    void splitGrid();
+    void drawGrid(QPainter* painter, const QRectF& area);
     void createGridRect();
     void createGridPolar();
     void createGridIso();
@@ -157,6 +170,9 @@ private:
 
     bool grippingActive;
     bool rapidMoveActive;
+    QTimer* rapidMoveTimer;
+    QElapsedTimer rapidMoveClock;
+    QString rapidMoveCommand;
     bool previewActive;
     bool pastingActive;
     bool movingActive;
@@ -87,6 +87,11 @@ type
     next: PEmbStitchList;
   end;
 
+  TEmbStitchArray = record
+    stitches: PEmbStitchList; {= packed nodes, stitches[i].next = @stitches[i + 1] }
+    count: Integer;
+    capacity: Integer;
+  end {EmbStitchArray};
 
   TEmbThread = record
     color: TEmbColor;
@@ -318,9 +323,21 @@ type
   end {EmbObjectList};
 {$ENDIF}
 
+  TEmbPatternStats = record
+    stitchCount: Integer;
+    realCount: Integer;
+    jumpCount: Integer;
+    trimCount: Integer;
+    colorChangeCount: Integer;
+    moveCount: Integer;
+    threadLength: Double;
+    bounds: TEmbRect;
+  end {EmbPatternStats};
+
   TEmbPattern = record
     settings: TEmbSettings;
     hoop: TEmbHoop;
+    stitchArray: TEmbStitchArray;
     stitchList: PEmbStitchList;
     threadList: PEmbThreadList;
     arcObjList: PEmbArcObjectList;
@@ -349,6 +366,14 @@ type
     currentColorIndex: Integer;
     lastX: Double;
     lastY: Double;
+    stitchCallback: Pointer;
+    stitchCallbackData: Pointer;
+    streamedMaxColorIndex: Integer;
+    arena: Pointer;
+    log: Pointer;
+    spatialIndex: Pointer;
+    stats: TEmbPatternStats;
+    statsCount: Integer;
   end {EmbPattern};
   PEmbPattern = ^TEmbPattern;
 
@@ -37,7 +37,6 @@
 #include "emb-thread.h"
 #include "emb-time.h"
 #include "emb-vector.h"
-#include "hashtable.h"
 #include "helpers-binary.h"
 #include "helpers-misc.h"
 #include "helpers-unused.h"
@@ -138,7 +137,6 @@
 %include "emb-thread.h"
 %include "emb-time.h"
 %include "emb-vector.h"
-%include "hashtable.h"
 %include "helpers-binary.h"
 %include "helpers-misc.h"
 %include "helpers-unused.h"
@@ -1,9 +1,20 @@
 #include "emb-reader-writer.h"
 #include "emb-logging.h"
 #include "emb-format.h"
+#include "emb-stream.h"
+#include "emb-worker.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <ctype.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <glob.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#endif
 
 void usage(void)
 {
@@ -31,6 +42,11 @@ void usage(void)
     printf("|_____________________________________________________________________________|\n");
     printf("|                                                                             |\n");
     printf("| Usage: libembroidery-convert fileToRead filesToWrite ...                    |\n");
+    printf("|        libembroidery-convert --batch input formats ... [-o dir] [-j jobs]   |\n");
+    printf("|                                                                             |\n");
+    printf("| Batch input is a directory, a quoted wildcard pattern or @manifest, a file  |\n");
+    printf("| listing one design per line. Every design is written once per format into   |\n");
+    printf("| its own directory or -o dir, using one worker per core unless -j is given.  |\n");
     printf("|_____________________________________________________________________________|\n");
     printf("                                                                               \n");
     printf(" _____________________________________________________________________________ \n");
@@ -48,7 +64,7 @@ void usage(void)
     printf("|        |       |       |                                                    |\n");
 
     formatList = embFormatList_create();
-    if(!formatList) { embLog_error("libembroidery-convert-main.c usage(), cannot allocate memory for formatList\n"); return; }
+    if(!formatList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "libembroidery-convert-main.c usage(), cannot allocate memory for formatList\n"); return; }
     curFormat = formatList;
     while(curFormat)
     {
@@ -76,7 +92,443 @@ void usage(void)
     printf("\n");
 }
 
-/* TODO: Add capability for converting multiple files of various types to a single format. Currently, we only convert a single file to multiple formats. */
+/* Returns true if every file named in \a argv can be converted without reading the whole design into memory first. */
+int canStream(int argc, const char* argv[])
+{
+    int i = 0;
+    if(!embStream_canRead(argv[1]))
+        return 0;
+    for(i = 2; i < argc; i++)
+    {
+        if(!embStream_canWrite(argv[i]))
+            return 0;
+    }
+    return 1;
+}
+
+typedef struct BatchItem_
+{
+    char* input;
+    char** outputs;
+    int stitches;
+    int failed;
+} BatchItem;
+
+typedef struct Batch_
+{
+    BatchItem* items;
+    int count;
+    int capacity;
+    const char** formats;
+    int formatCount;
+    const char* outputDir;
+    int done;
+    int failed;
+    double stitches;
+    EmbMutex* reportMutex;
+} Batch;
+
+double batchSeconds(void)
+{
+#ifdef _WIN32
+    return GetTickCount() / 1000.0;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+#endif
+}
+
+int batchIsDirectory(const char* path)
+{
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(path);
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+    struct stat info;
+    return !stat(path, &info) && S_ISDIR(info.st_mode);
+#endif
+}
+
+/* Adds \a fileName to \a batch if libembroidery can read it. Returns false if memory runs out. */
+int batchAdd(Batch* batch, const char* fileName)
+{
+    BatchItem* item = 0;
+
+    if(embFormat_readerStateFromName(fileName) == ' ' || batchIsDirectory(fileName))
+        return 1;
+    if(batch->count == batch->capacity)
+    {
+        int capacity = batch->capacity ? batch->capacity * 2 : 64;
+        BatchItem* items = (BatchItem*)realloc(batch->items, sizeof(BatchItem) * capacity);
+        if(!items) return 0;
+        batch->items = items;
+        batch->capacity = capacity;
+    }
+    item = &batch->items[batch->count];
+    item->input = (char*)malloc(strlen(fileName) + 1);
+    if(!item->input) return 0;
+    strcpy(item->input, fileName);
+    item->outputs = 0;
+    item->stitches = 0;
+    item->failed = 0;
+    batch->count++;
+    return 1;
+}
+
+/* Adds every readable file matching the wildcard \a pattern to \a batch. */
+int batchAddMatches(Batch* batch, const char* pattern)
+{
+#ifdef _WIN32
+    WIN32_FIND_DATAA found;
+    HANDLE search;
+    char path[MAX_PATH];
+    const char* slash = 0;
+    const char* backslash = 0;
+    int dirLength = 0, ok = 1;
+
+    slash = strrchr(pattern, '/');
+    backslash = strrchr(pattern, '\\');
+    if(backslash > slash) slash = backslash;
+    if(slash) dirLength = (int)(slash - pattern) + 1;
+
+    search = FindFirstFileA(pattern, &found);
+    if(search == INVALID_HANDLE_VALUE)
+        return 1;
+    do
+    {
+        if(dirLength + strlen(found.cFileName) >= MAX_PATH)
+            continue;
+        memcpy(path, pattern, dirLength);
+        strcpy(path + dirLength, found.cFileName);
+        ok = batchAdd(batch, path);
+    }
+    while(ok && FindNextFileA(search, &found));
+    FindClose(search);
+    return ok;
+#else
+    glob_t found;
+    size_t i;
+    int ok = 1;
+
+    if(glob(pattern, 0, 0, &found))
+        return 1;
+    for(i = 0; ok && i < found.gl_pathc; i++)
+        ok = batchAdd(batch, found.gl_pathv[i]);
+    globfree(&found);
+    return ok;
+#endif
+}
+
+/* Adds every readable file listed in the manifest \a fileName, one per line, to \a batch. */
+int batchAddManifest(Batch* batch, const char* fileName)
+{
+    FILE* manifest = 0;
+    char line[4096];
+    int ok = 1;
+
+    manifest = fopen(fileName, "r");
+    if(!manifest) { embLog_errorCode(EMB_LOG_ERROR_OPEN, "libembroidery-convert-main.c batchAddManifest(), cannot open %s for reading\n", fileName); return 0; }
+    while(ok && fgets(line, sizeof(line), manifest))
+    {
+        size_t length = strlen(line);
+        while(length > 0 && isspace((unsigned char)line[length - 1]))
+            line[--length] = '\0';
+        if(length > 0)
+            ok = batchAdd(batch, line);
+    }
+    fclose(manifest);
+    return ok;
+}
+
+/* Builds the output file name for \a input in \a format, in outputDir or next to the input.
+ * With \a keepExtension the input extension stays in the name, so Star.dst and Star.exp do not both become Star.pes. */
+char* batchOutputName(const Batch* batch, const char* input, const char* format, int keepExtension)
+{
+    const char* base = input;
+    const char* slash = strrchr(input, '/');
+    const char* backslash = strrchr(input, '\\');
+    const char* dot = 0;
+    char* name = 0;
+    size_t dirLength = 0, baseLength;
+
+    if(backslash > slash) slash = backslash;
+    if(slash) base = slash + 1;
+    dot = strrchr(base, '.');
+    baseLength = dot && !keepExtension ? (size_t)(dot - base) : strlen(base);
+    if(batch->outputDir)
+        dirLength = strlen(batch->outputDir) + 1;
+    else
+        dirLength = base - input;
+
+    name = (char*)malloc(dirLength + baseLength + 1 + strlen(format) + 1);
+    if(!name) return 0;
+    if(batch->outputDir)
+        sprintf(name, "%s/", batch->outputDir);
+    else
+        memcpy(name, input, dirLength);
+    memcpy(name + dirLength, base, baseLength);
+    if(dot && keepExtension)
+        name[dirLength + (dot - base)] = '_';
+    name[dirLength + baseLength] = '.';
+    strcpy(name + dirLength + baseLength + 1, format);
+    return name;
+}
+
+typedef struct BatchOutput_
+{
+    char** name;
+    int item;
+    int format;
+} BatchOutput;
+
+int batchCompareOutputs(const void* a, const void* b)
+{
+    return strcmp(*((const BatchOutput*)a)->name, *((const BatchOutput*)b)->name);
+}
+
+/* Gives outputs that more than one input would write to a name that keeps the input extension. Returns false if memory runs out. */
+int batchResolveCollisions(Batch* batch)
+{
+    BatchOutput* outputs = 0;
+    int i, j, k, total = batch->count * batch->formatCount, ok = 1;
+
+    outputs = (BatchOutput*)malloc(sizeof(BatchOutput) * (total ? total : 1));
+    if(!outputs) return 0;
+    for(i = 0; i < total; i++)
+    {
+        outputs[i].item = i / batch->formatCount;
+        outputs[i].format = i % batch->formatCount;
+        outputs[i].name = &batch->items[outputs[i].item].outputs[outputs[i].format];
+    }
+    qsort(outputs, total, sizeof(BatchOutput), batchCompareOutputs);
+    for(i = 0; ok && i < total; i = j)
+    {
+        for(j = i + 1; j < total && !strcmp(*outputs[i].name, *outputs[j].name); j++);
+        for(k = i; ok && j - i > 1 && k < j; k++)
+        {
+            free(*outputs[k].name);
+            *outputs[k].name = batchOutputName(batch, batch->items[outputs[k].item].input, batch->formats[outputs[k].format], 1);
+            ok = *outputs[k].name != 0;
+        }
+    }
+    free(outputs);
+    return ok;
+}
+
+/* Returns true if \a a and \a b name the same file on a case-insensitive file system. */
+int batchSameName(const char* a, const char* b)
+{
+    while(*a && tolower((unsigned char)*a) == tolower((unsigned char)*b))
+    {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+/* Prints the outcome of \a item along with the messages its conversion reported to \a log,
+ * so the output of workers running side by side does not interleave. */
+void batchReport(Batch* batch, BatchItem* item, const char* problem, const char* fileName, EmbLog* log)
+{
+    const EmbLogRecord* record = 0;
+    int i;
+
+    embMutex_lock(batch->reportMutex);
+    batch->done++;
+    if(problem)
+    {
+        batch->failed++;
+        printf("[%d/%d] FAILED %s: %s %s\n", batch->done, batch->count, item->input, problem, fileName);
+    }
+    else
+    {
+        batch->stitches += item->stitches;
+        printf("[%d/%d] OK     %s (%d stitches)\n", batch->done, batch->count, item->input, item->stitches);
+    }
+    for(i = 0; log && i < embLog_count(log); i++)
+    {
+        record = embLog_getAt(log, i);
+        printf("        %s%s", record->code != EMB_LOG_PRINT ? "ERROR: " : "", record->message);
+    }
+    fflush(stdout);
+    embMutex_unlock(batch->reportMutex);
+}
+
+/* Worker task: converts one input of the batch to every requested format.
+ * Writers may change the pattern they are given (END stitches, splitting, flipping), so the input is read
+ * once and each format is written from a copy of it, so every output matches a conversion on its own. */
+void batchConvert(void* userData, int index)
+{
+    Batch* batch = (Batch*)userData;
+    BatchItem* item = &batch->items[index];
+    EmbPattern* original = 0;
+    EmbPattern* p = 0;
+    EmbLog* log = 0;
+    const char* problem = 0;
+    const char* problemFile = "";
+    int i, read = 0;
+
+    /* NOTE: without a log, messages go straight to stdout, which still works, just interleaved */
+    log = embLog_create(16, 1);
+    original = embPattern_create();
+    if(!original)
+    {
+        problem = "cannot allocate memory for";
+        problemFile = item->input;
+    }
+    else
+    {
+        original->log = log;
+        embPattern_useArena(original);
+        read = embPattern_read(original, item->input);
+        if(!read)
+        {
+            problem = "cannot read";
+            problemFile = item->input;
+        }
+        else
+            item->stitches = embPattern_stitchCount(original);
+    }
+
+    for(i = 0; read && i < batch->formatCount; i++)
+    {
+        if(batchSameName(item->outputs[i], item->input))
+        {
+            problem = "refusing to overwrite";
+            problemFile = item->input;
+            continue;
+        }
+        p = embPattern_copy(original);
+        if(!p)
+        {
+            problem = "cannot allocate memory for";
+            problemFile = item->input;
+            break;
+        }
+        if(embFormat_typeFromName(item->input) == EMBFORMAT_OBJECTONLY &&
+           embFormat_typeFromName(item->outputs[i]) == EMBFORMAT_STITCHONLY)
+            embPattern_movePolylinesToStitchList(p);
+        if(!embPattern_write(p, item->outputs[i]))
+        {
+            problem = "cannot write";
+            problemFile = item->outputs[i];
+        }
+        embPattern_free(p);
+    }
+    if(original)
+        embPattern_free(original);
+
+    item->failed = problem != 0;
+    batchReport(batch, item, problem, problemFile, log);
+    embLog_free(log);
+}
+
+void batchFree(Batch* batch)
+{
+    int i, j;
+    for(i = 0; i < batch->count; i++)
+    {
+        for(j = 0; batch->items[i].outputs && j < batch->formatCount; j++)
+            free(batch->items[i].outputs[j]);
+        free(batch->items[i].outputs);
+        free(batch->items[i].input);
+    }
+    free(batch->items);
+    free(batch->formats);
+    embMutex_free(batch->reportMutex);
+}
+
+/* Converts every design named by the batch arguments \a argv (see usage()) and prints a summary.
+ * Returns the process exit code. */
+int batch(int argc, const char* argv[])
+{
+    Batch b;
+    const char* input = 0;
+    int i, j, jobs = 0, ok = 1;
+    double start, elapsed;
+
+    memset(&b, 0, sizeof(b));
+    b.formats = (const char**)malloc(sizeof(const char*) * (argc + 1));
+    b.reportMutex = embMutex_create();
+    if(!b.formats || !b.reportMutex) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "libembroidery-convert-main.c batch(), cannot allocate memory for batch\n"); batchFree(&b); return 1; }
+
+    for(i = 0; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "-o") && i + 1 < argc)
+            b.outputDir = argv[++i];
+        else if(!strcmp(argv[i], "-j") && i + 1 < argc)
+            jobs = atoi(argv[++i]);
+        else if(!input)
+            input = argv[i];
+        else
+        {
+            char probe[16];
+            const char* format = argv[i][0] == '.' ? argv[i] + 1 : argv[i];
+            if(strlen(format) == 0 || strlen(format) > 4 || strchr(format, '.'))
+                ok = 0;
+            else
+            {
+                sprintf(probe, "file.%s", format);
+                ok = embFormat_writerStateFromName(probe) != ' ';
+            }
+            if(!ok) { embLog_errorCode(EMB_LOG_ERROR_UNSUPPORTED, "libembroidery-convert-main.c batch(), unsupported write format: %s\n", argv[i]); batchFree(&b); return 1; }
+            b.formats[b.formatCount++] = format;
+        }
+    }
+    if(!input || !b.formatCount)
+    {
+        usage();
+        batchFree(&b);
+        return 1;
+    }
+
+    if(input[0] == '@')
+        ok = batchAddManifest(&b, input + 1);
+    else if(batchIsDirectory(input))
+    {
+        char* pattern = (char*)malloc(strlen(input) + 3);
+        ok = pattern != 0;
+        if(ok)
+        {
+            sprintf(pattern, "%s/*", input);
+            ok = batchAddMatches(&b, pattern);
+            free(pattern);
+        }
+    }
+    else
+        ok = batchAddMatches(&b, input);
+
+    for(i = 0; ok && i < b.count; i++)
+    {
+        BatchItem* item = &b.items[i];
+        item->outputs = (char**)calloc(b.formatCount, sizeof(char*));
+        ok = item->outputs != 0;
+        for(j = 0; ok && j < b.formatCount; j++)
+        {
+            item->outputs[j] = batchOutputName(&b, item->input, b.formats[j], 0);
+            ok = item->outputs[j] != 0;
+        }
+    }
+    if(ok)
+        ok = batchResolveCollisions(&b);
+    if(!ok) { embLog_error("libembroidery-convert-main.c batch(), cannot collect the files of %s\n", input); batchFree(&b); return 1; }
+    if(!b.count) { embLog_error("libembroidery-convert-main.c batch(), no readable files found in %s\n", input); batchFree(&b); return 1; }
+
+    if(jobs <= 0)
+        jobs = embWorker_count();
+    start = batchSeconds();
+    embWorker_run(b.count, jobs, batchConvert, &b);
+    elapsed = batchSeconds() - start;
+    if(elapsed <= 0.0)
+        elapsed = 0.001;
+
+    printf("\nConverted %d of %d files (%d failed) with %d workers in %.2f s: %.1f files/s, %.0f stitches/s\n",
+           b.count - b.failed, b.count, b.failed, jobs, elapsed, b.count / elapsed, b.stitches / elapsed);
+    ok = b.failed == 0;
+    batchFree(&b);
+    return ok ? 0 : 1;
+}
 
 /*! Developers incorporating libembroidery into another project should use the SHORT_WAY of using libembroidery. It uses
  *  convenience functions and is approximately 20 lines shorter than the long way.
@@ -94,6 +546,10 @@ int main(int argc, const char* argv[])
     EmbPattern* p = 0;
     int successful = 0, i = 0;
     int formatType;
+
+    if(argc > 1 && (!strcmp(argv[1], "--batch") || !strcmp(argv[1], "-b")))
+        return batch(argc - 2, argv + 2);
+
 #ifdef SHORT_WAY
     if(argc < 3)
     {
@@ -101,8 +557,21 @@ int main(int argc, const char* argv[])
         exit(0);
     }
 
+    /* Stitch-only conversions are streamed so the size of the design does not matter */
+    if(canStream(argc, argv))
+    {
+        successful = embStream_convert(argv[1], argv + 2, argc - 2);
+        if(!successful)
+        {
+            embLog_error("libembroidery-convert-main.c main(), converting file %s was unsuccessful\n", argv[1]);
+            exit(1);
+        }
+        return 0;
+    }
+
     p = embPattern_create();
-    if(!p) { embLog_error("libembroidery-convert-main.c main(), cannot allocate memory for p\n"); exit(1); }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "libembroidery-convert-main.c main(), cannot allocate memory for p\n"); exit(1); }
+    embPattern_useArena(p);
 
     successful = embPattern_read(p, argv[1]);
     if(!successful)
@@ -132,7 +601,7 @@ int main(int argc, const char* argv[])
     return 0;
 #else /* LONG_WAY */
 
-    EmbReaderWriter* reader = 0, *writer = 0;
+    const EmbFormat* reader = 0, *writer = 0;
 
     if(argc < 3)
     {
@@ -141,21 +610,20 @@ int main(int argc, const char* argv[])
     }
 
     p = embPattern_create();
-    if(!p) { embLog_error("libembroidery-convert-main.c main(), cannot allocate memory for p\n"); exit(1); }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "libembroidery-convert-main.c main(), cannot allocate memory for p\n"); exit(1); }
 
     successful = 0;
-    reader = embReaderWriter_getByFileName(argv[1]);
-    if(!reader)
+    reader = embFormat_fromFile(argv[1]);
+    if(!reader || !reader->readerWriter.reader)
     {
         successful = 0;
-        embLog_error("libembroidery-convert-main.c main(), unsupported read file type: %s\n", argv[1]);
+        embLog_errorCode(EMB_LOG_ERROR_UNSUPPORTED, "libembroidery-convert-main.c main(), unsupported read file type: %s\n", argv[1]);
     }
     else
     {
-        successful = reader->reader(p, argv[1]);
+        successful = reader->readerWriter.reader(p, argv[1]);
         if(!successful) embLog_error("libembroidery-convert-main.c main(), reading file was unsuccessful: %s\n", argv[1]);
     }
-    free(reader);
     if(!successful)
     {
         embPattern_free(p);
@@ -173,18 +641,17 @@ int main(int argc, const char* argv[])
     i = 2;
     for(i = 2; i < argc; i++)
     {
-        writer = embReaderWriter_getByFileName(argv[i]);
-        if(!writer)
+        writer = embFormat_fromName(argv[i]);
+        if(!writer || !writer->readerWriter.writer)
         {
-            embLog_error("libembroidery-convert-main.c main(), unsupported write file type: %s\n", argv[i]);
+            embLog_errorCode(EMB_LOG_ERROR_UNSUPPORTED, "libembroidery-convert-main.c main(), unsupported write file type: %s\n", argv[i]);
         }
         else
         {
-            successful = writer->writer(p, argv[i]);
+            successful = writer->readerWriter.writer(p, argv[i]);
             if(!successful)
                 embLog_error("libembroidery-convert-main.c main(), writing file %s was unsuccessful\n", argv[i]);
         }
-        free(writer);
     }
 
     embPattern_free(p);
@@ -1,14 +1,60 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#include <math.h>
+#include "compound-file.h"
+#include "compound-file-common.h"
+#include "emb-arena.h"
+#include "emb-compress.h"
+#include "emb-format.h"
 #include "emb-reader-writer.h"
 #include "emb-hash.h"
+#include "emb-logging.h"
+#include "emb-palette.h"
+#include "emb-pattern.h"
+#include "emb-record.h"
+#include "emb-spatial-index.h"
+#include "emb-stream.h"
+#include "emb-tokenizer.h"
+#include "emb-worker.h"
+#include "format-svg.h"
+#include "thread-color.h"
 
 #define RED_TERM_COLOR "\e[0;31m"
 #define GREEN_TERM_COLOR "\e[0;32m"
 #define YELLOW_TERM_COLOR "\e[1;33m"
 #define RESET_TERM_COLOR "\033[0m"
 
+/* Built with `qmake CONFIG+=benchmark_allocations`, the linker sends every call to malloc(), calloc() and realloc()
+ * in this program and libembroidery through these wrappers, so the format benchmark can count the allocations a reader
+ * or writer makes. The count is atomic, as the library allocates from worker threads too. */
+#ifdef BENCHMARK_COUNT_ALLOCATIONS
+extern void* __real_malloc(size_t size);
+extern void* __real_calloc(size_t count, size_t size);
+extern void* __real_realloc(void* pointer, size_t size);
+
+static unsigned long benchmarkAllocationCount = 0;
+
+void* __wrap_malloc(size_t size)
+{
+    __sync_fetch_and_add(&benchmarkAllocationCount, 1);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    __sync_fetch_and_add(&benchmarkAllocationCount, 1);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size)
+{
+    __sync_fetch_and_add(&benchmarkAllocationCount, 1);
+    return __real_realloc(pointer, size);
+}
+#endif
+
 void todo(void)
 {
     printf(YELLOW_TERM_COLOR "[TODO]\n" RESET_TERM_COLOR);
@@ -25,18 +71,6 @@ int fail(int code)
     return code;
 }
 
-void testRead(void)
-{
-    printf("Read Test...                      ");
-    todo(); /* TODO: finish testRead() */
-}
-
-void testWrite(void)
-{
-    printf("Write Test...                     ");
-    todo(); /* TODO: finish testWrite() */
-}
-
 void testHash(void)
 {
     printf("Hash Test...                      ");
@@ -72,6 +106,1863 @@ void testHash(void)
     pass();
 }
 
+/* Fills a map past several resizes and checks keys are compared by content and survive removals around them */
+void testHashResize(void)
+{
+    EmbHash* hash = 0;
+    EmbArena* arena = 0;
+    const char* interned = 0;
+    char key[32];
+    long i;
+
+    printf("Hash Resize Test...               ");
+    arena = embArena_create();
+    hash = embHash_createWithArena(arena);
+    if(!arena || !hash) { fail(1); return; }
+    for(i = 0; i < 5000; i++)
+    {
+        sprintf(key, "layer%ld", i);
+        if(embHash_insert(hash, key, (void*)(size_t)(i + 1))) { fail(2); return; }
+    }
+    /* every other key goes, which shifts the runs of the remaining ones */
+    for(i = 0; i < 5000; i += 2)
+    {
+        sprintf(key, "layer%ld", i);
+        embHash_remove(hash, key);
+    }
+    if(embHash_count(hash) != 2500) { fail(3); return; }
+    for(i = 0; i < 5000; i++)
+    {
+        sprintf(key, "layer%ld", i);
+        if(embHash_value(hash, key) != (i % 2 ? (void*)(size_t)(i + 1) : 0)) { fail(4); return; }
+    }
+
+    strcpy(key, "layer7");
+    interned = embHash_intern(hash, key);
+    if(!interned || interned == key || embHash_intern(hash, "layer7") != interned) { fail(5); return; }
+    if(embHash_value(hash, interned) != (void*)8) { fail(6); return; }
+    interned = embHash_intern(hash, "OMEGA");
+    if(!interned || embHash_value(hash, "OMEGA") || embHash_count(hash) != 2501) { fail(7); return; }
+    if(!embArena_owns(arena, interned)) { fail(8); return; }
+
+    embHash_rehash(hash, 100000);
+    if(embHash_value(hash, "layer4999") != (void*)5000) { fail(9); return; }
+    embHash_free(hash);
+    embArena_free(arena);
+    pass();
+}
+
+void testStitchArray(void)
+{
+    EmbPattern* p = 0;
+    EmbStitchList* node = 0;
+    EmbLog* log = 0;
+    EmbLog* previous = 0;
+    EmbStitch st;
+    int i, walked = 0;
+
+    printf("Stitch Array Test...              ");
+    p = embPattern_create();
+    if(!p) { fail(1); return; }
+
+    /* enough stitches to force the block to grow and move several times */
+    for(i = 0; i < 1000; i++)
+    {
+        embPattern_addStitchAbs(p, (double)i, (double)-i, NORMAL, 1);
+    }
+    if(embPattern_stitchCount(p) != 1001) { fail(2); return; } /* includes the HOME stitch */
+    if(embStitchArray_getAt(&p->stitchArray, 500).xx != 499.0) { fail(3); return; }
+    if(p->lastStitch->stitch.yy != -999.0) { fail(4); return; }
+
+    /* the EmbStitchList view must still walk every stitch */
+    node = p->stitchList;
+    while(node)
+    {
+        walked++;
+        node = node->next;
+    }
+    if(walked != 1001) { fail(5); return; }
+
+    embPattern_correctForMaxStitchLength(p, 0.5, 0.5);
+    if(embPattern_stitchCount(p) != 2001) { fail(6); return; } /* 999 of the 1mm stitches gain a split stitch, plus END */
+    if(!(p->lastStitch->stitch.flags & END)) { fail(7); return; }
+
+    /* reads past the end are reported instead of touching memory outside the block */
+    log = embLog_create(4, 0);
+    if(!log) { fail(8); return; }
+    previous = embLog_attach(log);
+    st = embStitchArray_getAt(&p->stitchArray, embPattern_stitchCount(p));
+    embLog_attach(previous);
+    if(st.flags != 0 || st.xx != 0.0 || embLog_errorCount(log) != 1) { fail(9); return; }
+    embLog_free(log);
+    embPattern_free(p);
+
+    /* each run of jumps becomes one jump, including a run that ends the pattern */
+    p = embPattern_create();
+    if(!p) { fail(10); return; }
+    for(i = 1; i <= 7; i++)
+    {
+        embPattern_addStitchAbs(p, (double)i, 0.0, (i == 1 || i == 4) ? NORMAL : JUMP, 1);
+    }
+    embPattern_combineJumpStitches(p);
+    if(embPattern_stitchCount(p) != 5) { fail(11); return; } /* HOME, 1, jump to 4, 4, jump to 7 */
+    if(embStitchArray_getAt(&p->stitchArray, 2).xx != 4.0) { fail(12); return; }
+    if(!(p->lastStitch->stitch.flags & JUMP) || p->lastStitch->stitch.xx != 7.0) { fail(13); return; }
+
+    embPattern_free(p);
+    pass();
+}
+
+typedef struct StreamCheck_
+{
+    int count;
+    int inOrder;
+    double lastX;
+} StreamCheck;
+
+void streamCheckStitch(void* userData, EmbStitch st)
+{
+    StreamCheck* check = (StreamCheck*)userData;
+    if(check->count > 0 && !(st.flags & END) && st.xx <= check->lastX)
+        check->inOrder = 0;
+    check->lastX = st.xx;
+    check->count++;
+}
+
+void testStitchStream(void)
+{
+    EmbPattern* p = 0;
+    StreamCheck check;
+    int i, maxBuffered = 0;
+
+    printf("Stitch Stream Test...             ");
+    p = embPattern_create();
+    if(!p) { fail(1); return; }
+
+    check.count = 0;
+    check.inOrder = 1;
+    check.lastX = 0.0;
+    embPattern_setStitchCallback(p, streamCheckStitch, &check);
+    for(i = 0; i < 1000; i++)
+    {
+        embPattern_addStitchRel(p, 1.0, 0.0, NORMAL, 1);
+        maxBuffered = maxBuffered > embPattern_stitchCount(p) ? maxBuffered : embPattern_stitchCount(p);
+    }
+    embPattern_addStitchRel(p, 0.0, 0.0, END, 1);
+    if(maxBuffered >= 1000) { fail(2); return; } /* stitches must be handed off, not kept */
+    if(p->lastStitch->stitch.xx != 1000.0) { fail(3); return; } /* positions carry across the hand off */
+
+    embPattern_flushStitches(p);
+    if(check.count != 1002) { fail(4); return; } /* HOME, 1000 stitches and END */
+    if(!check.inOrder) { fail(5); return; }
+    if(embPattern_stitchCount(p) != 0) { fail(6); return; }
+
+    embPattern_free(p);
+    pass();
+}
+
+void workerTask(void* userData, int index)
+{
+    int* calls = (int*)userData;
+    calls[index]++;
+}
+
+/* Runs a set of inner tasks from inside a task, the way a transform runs inside a batch conversion */
+void workerNestedTask(void* userData, int index)
+{
+    int* calls = (int*)userData;
+    embWorker_run(10, 0, workerTask, calls + index * 10);
+}
+
+void testWorker(void)
+{
+    int calls[1000];
+    int i, round;
+
+    printf("Worker Test...                    ");
+    for(round = 0; round < 20; round++)
+    {
+        memset(calls, 0, sizeof(calls));
+        if(!embWorker_run(1000, 4, workerTask, calls)) { fail(1); return; }
+        for(i = 0; i < 1000; i++)
+        {
+            if(calls[i] != 1) { fail(2); return; } /* every task runs exactly once, however often the pool is reused */
+        }
+    }
+    if(embWorker_count() < 1) { fail(3); return; }
+
+    memset(calls, 0, sizeof(calls));
+    if(!embWorker_run(100, 4, workerNestedTask, calls)) { fail(4); return; }
+    for(i = 0; i < 1000; i++)
+    {
+        if(calls[i] != 1) { fail(5); return; }
+    }
+    pass();
+}
+
+void logCountRecord(void* userData, const EmbLogRecord* record)
+{
+    int* calls = (int*)userData;
+    if(record->message[0]) (*calls)++;
+}
+
+void testLog(void)
+{
+    EmbLog* log = 0;
+    EmbLog* previous = 0;
+    EmbPattern* p = 0;
+    const EmbLogRecord* record = 0;
+    EmbFile* embFile = 0;
+    FILE* file = 0;
+    int i, calls = 0;
+
+    printf("Log Test...                       ");
+    log = embLog_create(4, 0);
+    if(!log) { fail(1); return; }
+
+    previous = embLog_attach(log);
+    for(i = 0; i < 6; i++)
+        embLog_error("libembroidery-test-main.c testLog(), error %d\n", i);
+    embLog_print("libembroidery-test-main.c testLog(), done\n");
+    embLog_attach(previous);
+
+    /* the ring keeps the newest records, and messages are not formatted unless asked for */
+    if(embLog_count(log) != 4) { fail(2); return; }
+    if(embLog_errorCount(log) != 6) { fail(3); return; }
+    record = embLog_getAt(log, 3);
+    if(!record || record->code != EMB_LOG_PRINT || record->message[0]) { fail(4); return; }
+    if(embLog_getAt(log, 4)) { fail(5); return; }
+
+    /* a callback gets formatted messages, and the records name the file being read */
+    embLog_clear(log);
+    embLog_setCallback(log, logCountRecord, &calls);
+    p = embPattern_create();
+    if(!p) { fail(6); return; }
+    p->log = log;
+    if(embPattern_read(p, "missing.dst")) { fail(7); return; }
+    if(calls < 1 || calls != embLog_count(log)) { fail(8); return; }
+    record = embLog_getAt(log, 0);
+    if(!strstr(record->message, "missing.dst")) { fail(9); return; }
+    if(embLog_attach(0)) { fail(10); return; } /* embPattern_read() must restore the previous log */
+    if(record->code != EMB_LOG_ERROR_OPEN) { fail(11); return; }
+
+    /* records keep their own copy of the file name and format, which outlive the file */
+    embLog_clear(log);
+    file = fopen("log-test.DST", "wb");
+    if(!file) { fail(12); return; }
+    fputs("LA:log-test", file);
+    fclose(file);
+    previous = embLog_attach(log);
+    embFile = embFile_open("log-test.DST", "rb");
+    if(!embFile) { fail(13); return; }
+    embFile_seek(embFile, 3, SEEK_SET);
+    embLog_errorCode(EMB_LOG_ERROR_MEMORY, "libembroidery-test-main.c testLog(), nothing to allocate\n");
+    embLog_attach(previous);
+    embFile_close(embFile);
+    remove("log-test.DST");
+    embLog_attach(log);
+    embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "libembroidery-test-main.c testLog(), file argument is missing\n");
+    embLog_error("libembroidery-test-main.c testLog(), cannot open a file that argument is null\n"); /* the code never comes from the wording */
+    embLog_attach(previous);
+    record = embLog_getAt(log, 0);
+    if(record->code != EMB_LOG_ERROR_MEMORY || strcmp(record->format, ".dst") || strcmp(record->fileName, "log-test.DST") || record->offset != 3) { fail(14); return; }
+    record = embLog_getAt(log, 1);
+    if(record->code != EMB_LOG_ERROR_ARGUMENT || record->format[0] || record->fileName[0] || record->offset != -1) { fail(15); return; }
+    record = embLog_getAt(log, 2);
+    if(record->code != EMB_LOG_ERROR) { fail(16); return; }
+
+    embPattern_free(p);
+    embLog_free(log);
+    pass();
+}
+
+void testFormat(void)
+{
+    const EmbFormat* format = 0;
+    const unsigned char hus[] = { 0x5B, 0xAF, 0xC8, 0x00, 0x10, 0x00 };
+    EmbPattern* p = 0;
+    int i;
+
+    printf("Format Test...                    ");
+    if(embFormat_count() < 2) { fail(1); return; }
+    for(i = 1; i < embFormat_count(); i++)
+    {
+        if(strcmp(embFormat_getAt(i - 1)->extension, embFormat_getAt(i)->extension) >= 0) { fail(2); return; } /* must stay sorted for bsearch() */
+    }
+
+    format = embFormat_fromName("Design.PES");
+    if(!format || strcmp(format->extension, ".pes")) { fail(3); return; }
+    if(embFormat_fromName("design") || embFormat_fromName("design.toolong") || embFormat_fromName("design.abc")) { fail(4); return; }
+
+    format = embFormat_fromData((const unsigned char*)"#PES0001", 8);
+    if(!format || strcmp(format->extension, ".pes")) { fail(5); return; }
+    format = embFormat_fromData(hus, sizeof(hus));
+    if(!format || strcmp(format->extension, ".hus")) { fail(6); return; }
+    if(embFormat_fromData((const unsigned char*)"LA:", 3)) { fail(7); return; }
+    if(embFormat_fromData((const unsigned char*)"#PE", 3)) { fail(8); return; } /* too short to match */
+
+    /* a PES design saved with a DST name is still read as PES */
+    p = embPattern_create();
+    if(!p) { fail(9); return; }
+    embPattern_addThread(p, embThread_getRandom());
+    for(i = 0; i < 10; i++)
+        embPattern_addStitchRel(p, 1.0, 1.0, NORMAL, 1);
+    embPattern_addStitchRel(p, 0.0, 0.0, END, 1);
+    if(!embPattern_write(p, "format-test.pes")) { fail(10); return; }
+    embPattern_free(p);
+    remove("format-test.dst");
+    if(rename("format-test.pes", "format-test.dst")) { fail(11); return; }
+
+    format = embFormat_fromFile("format-test.dst");
+    if(!format || strcmp(format->extension, ".pes")) { fail(12); return; }
+    p = embPattern_create();
+    if(!p) { fail(13); return; }
+    if(!embPattern_read(p, "format-test.dst") || embPattern_stitchCount(p) < 10) { fail(14); return; }
+    embPattern_free(p);
+    remove("format-test.dst");
+    pass();
+}
+
+/* Returns a new pattern of \a colors threads, each sewn as a row of 10 stitches ended by a color change */
+EmbPattern* formatTestPattern(int colors)
+{
+    EmbPattern* p = 0;
+    int i, j;
+
+    p = embPattern_create();
+    if(!p) return 0;
+    for(i = 0; i < colors; i++)
+    {
+        EmbThread thread;
+        thread.color = embColor_make((unsigned char)(i * 40), (unsigned char)(255 - i * 40), (unsigned char)(i * 20));
+        thread.description = "";
+        thread.catalogNumber = "";
+        embPattern_addThread(p, thread);
+        for(j = 0; j < 10; j++)
+            embPattern_addStitchAbs(p, j * 2.0, i * 5.0, NORMAL, 1);
+        if(i + 1 < colors)
+            embPattern_addStitchRel(p, 0.0, 0.0, STOP, 1);
+    }
+    embPattern_addStitchRel(p, 0.0, 0.0, END, 1);
+    return p;
+}
+
+/* Returns the size of the file named \a fileName in bytes, or -1 if it cannot be opened */
+long fileSize(const char* fileName)
+{
+    long size = -1;
+    FILE* file = fopen(fileName, "rb");
+    if(!file) return -1;
+    if(!fseek(file, 0, SEEK_END))
+        size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+/* Writes formatTestPattern(\a colors) to \a fileName. Returns \c true if successful, otherwise returns \c false. */
+int formatTestWrite(const char* fileName, int colors)
+{
+    EmbPattern* p = formatTestPattern(colors);
+    int successful;
+
+    if(!p) return 0;
+    successful = embPattern_write(p, fileName);
+    embPattern_free(p);
+    return successful;
+}
+
+void testWrite(void)
+{
+    EmbLog* log = 0;
+    EmbLog* previous = 0;
+    char fileName[32];
+    int i;
+
+    printf("Write Test...                     ");
+    log = embLog_create(4, 0);
+    if(!log) { fail(1); return; }
+    previous = embLog_attach(log);
+    for(i = 0; i < embFormat_count(); i++)
+    {
+        const EmbFormat* format = embFormat_getAt(i);
+        if(format->writer != 'U')
+            continue;
+        sprintf(fileName, "format-test%s", format->extension);
+
+        /* every usable writer writes something */
+        if(!formatTestWrite(fileName, 2)) { embLog_attach(previous); fail(2); return; }
+        if(fileSize(fileName) <= 0) { embLog_attach(previous); fail(3); return; }
+        remove(fileName);
+    }
+    embLog_attach(previous);
+    embLog_free(log);
+    pass();
+}
+
+/* Returns the number of stitches embPattern_read() finds in \a fileName, or -1 if it cannot be read */
+int readStitchCount(const char* fileName)
+{
+    EmbPattern* p = embPattern_create();
+    int count = -1;
+
+    if(!p) return -1;
+    if(embPattern_read(p, fileName))
+        count = embPattern_stitchCount(p);
+    embPattern_free(p);
+    return count;
+}
+
+void testStreamConvert(void)
+{
+    EmbLog* log = 0;
+    EmbLog* previous = 0;
+    EmbPattern* p = 0;
+    const char* outputs[1];
+    int stitches;
+
+    printf("Stream Convert Test...            ");
+    log = embLog_create(4, 0);
+    if(!log) { fail(1); return; }
+    previous = embLog_attach(log);
+
+    /* a HUS file named as a DST file is read as HUS by both paths rather than misparsed by the streaming one */
+    remove("stream-test.dst");
+    if(!formatTestWrite("stream-test.hus", 2) || rename("stream-test.hus", "stream-test.dst")) { embLog_attach(previous); fail(2); return; }
+    if(readStitchCount("stream-test.dst") < 10) { embLog_attach(previous); fail(3); return; }
+    if(embStream_canRead("stream-test.dst")) { embLog_attach(previous); fail(4); return; }
+    outputs[0] = "stream-test.exp";
+    if(embStream_convert("stream-test.dst", outputs, 1) || fileSize("stream-test.exp") >= 0) { embLog_attach(previous); fail(5); return; }
+    remove("stream-test.dst");
+
+    /* a DST file named as an EXP file streams the same stitches the in-memory path writes */
+    if(!formatTestWrite("stream-test.dst", 2) || rename("stream-test.dst", "stream-test.exp")) { embLog_attach(previous); fail(6); return; }
+    if(!embStream_canRead("stream-test.exp")) { embLog_attach(previous); fail(7); return; }
+    outputs[0] = "stream-test-streamed.dst";
+    if(!embStream_convert("stream-test.exp", outputs, 1)) { embLog_attach(previous); fail(8); return; }
+    p = embPattern_create();
+    if(!p) { embLog_attach(previous); fail(9); return; }
+    if(!embPattern_read(p, "stream-test.exp") || !embPattern_write(p, "stream-test-memory.dst")) { embLog_attach(previous); fail(10); return; }
+    embPattern_free(p);
+    stitches = readStitchCount("stream-test-memory.dst");
+    if(stitches < 1 || readStitchCount("stream-test-streamed.dst") != stitches) { embLog_attach(previous); fail(11); return; }
+    remove("stream-test.exp");
+    remove("stream-test-streamed.dst");
+    remove("stream-test-memory.dst");
+
+    embLog_attach(previous);
+    embLog_free(log);
+    pass();
+}
+
+void testRead(void)
+{
+    EmbLog* log = 0;
+    EmbLog* previous = 0;
+    EmbPattern* p = 0;
+    char fileName[32];
+    int i;
+
+    printf("Read Test...                      ");
+    log = embLog_create(4, 0);
+    if(!log) { fail(1); return; }
+    previous = embLog_attach(log);
+    for(i = 0; i < embFormat_count(); i++)
+    {
+        const EmbFormat* format = embFormat_getAt(i);
+        if(format->reader != 'U' || format->writer != 'U' || format->type != EMBFORMAT_STITCHONLY)
+            continue;
+        sprintf(fileName, "format-test%s", format->extension);
+        if(!formatTestWrite(fileName, 2)) { embLog_attach(previous); fail(2); return; }
+
+        /* every usable reader reads back the stitches, or the threads of a color format, that were written */
+        p = embPattern_create();
+        if(!p) { embLog_attach(previous); fail(3); return; }
+        if(!embPattern_read(p, fileName)) { embLog_attach(previous); fail(4); return; }
+        if(embPattern_stitchCount(p) < 10 && embThreadList_count(p->threadList) < 2) { embLog_attach(previous); fail(5); return; }
+        embPattern_free(p);
+        remove(fileName);
+    }
+    embLog_attach(previous);
+    embLog_free(log);
+    pass();
+}
+
+void testMax(void)
+{
+    EmbPattern* p = 0;
+    FILE* file = 0;
+    int count, i;
+
+    printf("MAX Test...                       ");
+    p = formatTestPattern(1);
+    if(!p) { fail(1); return; }
+    count = embPattern_stitchCount(p);
+    if(!embPattern_write(p, "format-test.max")) { fail(2); return; }
+    embPattern_free(p);
+
+    /* the stitch count at 0xD5 is read back, not taken from the first stitch */
+    p = embPattern_create();
+    if(!p) { fail(3); return; }
+    if(!embPattern_read(p, "format-test.max")) { fail(4); return; }
+    if(embPattern_stitchCount(p) < count) { fail(5); return; }
+    embPattern_free(p);
+
+    /* a design without stitches */
+    file = fopen("format-test.max", "wb");
+    if(!file) { fail(6); return; }
+    for(i = 0; i < 0xD5 + 4; i++)
+        fputc(0, file);
+    fclose(file);
+    p = embPattern_create();
+    if(!p) { fail(7); return; }
+    if(!embPattern_read(p, "format-test.max")) { fail(8); return; }
+    if(embPattern_stitchCount(p) != 0) { fail(9); return; }
+    embPattern_free(p);
+    remove("format-test.max");
+    pass();
+}
+
+void testPcs(void)
+{
+    const char* fileNames[] = { "format-test.pcd", "format-test.pcq", "format-test.pcs" };
+    EmbPattern* written = 0;
+    EmbPattern* p = 0;
+    int count, i, j;
+
+    printf("PCD/PCQ/PCS Test...               ");
+    written = formatTestPattern(3);
+    if(!written) { fail(1); return; }
+    for(i = 0; i < 3; i++)
+    {
+        if(!embPattern_write(written, fileNames[i])) { fail(2); return; }
+        count = embPattern_stitchCount(written);
+
+        /* the 16 color slots are all read, so the stitches start where they were written */
+        p = embPattern_create();
+        if(!p) { fail(3); return; }
+        if(!embPattern_read(p, fileNames[i])) { fail(4); return; }
+        if(embThreadList_count(p->threadList) != 16) { fail(5); return; }
+        for(j = 0; j < 3; j++)
+        {
+            EmbColor expected = embThreadList_getAt(written->threadList, j).color;
+            EmbColor color = embThreadList_getAt(p->threadList, j).color;
+            if(color.r != expected.r || color.g != expected.g || color.b != expected.b) { fail(6); return; }
+        }
+        if(embPattern_stitchCount(p) < count) { fail(7); return; }
+        embPattern_free(p);
+        remove(fileNames[i]);
+    }
+    embPattern_free(written);
+    pass();
+}
+
+void testPlt(void)
+{
+    EmbPattern* p = 0;
+    FILE* file = 0;
+    int count;
+
+    printf("PLT Test...                       ");
+    p = formatTestPattern(2);
+    if(!p) { fail(1); return; }
+    count = embPattern_stitchCount(p);
+    if(!embPattern_write(p, "format-test.plt")) { fail(2); return; }
+    embPattern_free(p);
+
+    /* the commands are read one at a time, though no whitespace separates them */
+    p = embPattern_create();
+    if(!p) { fail(3); return; }
+    if(!embPattern_read(p, "format-test.plt")) { fail(4); return; }
+    if(embPattern_stitchCount(p) < count) { fail(5); return; }
+    embPattern_free(p);
+
+    /* a file without stitches is an empty design */
+    file = fopen("format-test.plt", "wb");
+    if(!file) { fail(6); return; }
+    fputs("IN;ND;", file);
+    fclose(file);
+    p = embPattern_create();
+    if(!p) { fail(7); return; }
+    if(!embPattern_read(p, "format-test.plt")) { fail(8); return; }
+    if(embPattern_stitchCount(p) != 0) { fail(9); return; }
+    embPattern_free(p);
+    remove("format-test.plt");
+    pass();
+}
+
+void testBro(void)
+{
+    EmbPattern* p = 0;
+    FILE* file = 0;
+    int i;
+
+    printf("BRO Test...                       ");
+    /* stitches run to the end of the file, without an end code */
+    file = fopen("format-test.bro", "wb");
+    if(!file) { fail(1); return; }
+    for(i = 0; i < 0x100; i++)
+        fputc(0, file);
+    for(i = 0; i < 5; i++)
+    {
+        fputc(10, file);
+        fputc(0, file);
+    }
+    fclose(file);
+
+    p = embPattern_create();
+    if(!p) { fail(2); return; }
+    if(!embPattern_read(p, "format-test.bro")) { fail(3); return; }
+    if(embPattern_stitchCount(p) < 5) { fail(4); return; }
+    embPattern_free(p);
+    remove("format-test.bro");
+    pass();
+}
+
+/* Writes an STX design that claims \a stitchCount stitches but holds \a stitches,
+ * or else one thread with a negative number of descriptors if \a brokenThread is set */
+int stxTestFile(const char* fileName, int brokenThread, long stitchCount, int stitches)
+{
+    FILE* file = 0;
+    int i;
+
+    file = fopen(fileName, "wb");
+    if(!file) return 0;
+    fputs("STX0001", file);
+    for(i = 0; i < 1 + 4 * 6; i++)
+        fputc(0, file);
+    for(i = 0; i < 4; i++)
+        fputc((int)((stitchCount >> (i * 8)) & 0xFF), file);
+    for(i = 0; i < 4 + 2 * 4; i++)
+        fputc(0, file);
+    fputc(brokenThread ? 1 : 0, file);
+    fputc(0, file);
+    if(brokenThread)
+    {
+        for(i = 0; i < 21; i++)
+            fputc(i < 19 ? 0 : 0xFF, file);
+    }
+    else
+    {
+        for(i = 0; i < 47; i++)
+            fputc(0, file);
+        for(i = 0; i < stitches; i++)
+        {
+            fputc(10, file);
+            fputc(10, file);
+        }
+    }
+    fclose(file);
+    return 1;
+}
+
+void testStx(void)
+{
+    EmbPattern* p = 0;
+    EmbLog* log = 0;
+
+    printf("STX Test...                       ");
+    /* the stitches end with the file, whatever the header claims */
+    if(!stxTestFile("format-test.stx", 0, 1000000, 3)) { fail(1); return; }
+    p = embPattern_create();
+    if(!p) { fail(2); return; }
+    if(!embPattern_read(p, "format-test.stx")) { fail(3); return; }
+    if(embPattern_stitchCount(p) < 3 || embPattern_stitchCount(p) > 10) { fail(4); return; }
+    embPattern_free(p);
+
+    /* a design without stitches */
+    if(!stxTestFile("format-test.stx", 0, 0, 0)) { fail(5); return; }
+    p = embPattern_create();
+    if(!p) { fail(6); return; }
+    if(!embPattern_read(p, "format-test.stx")) { fail(7); return; }
+    if(embPattern_stitchCount(p) != 0) { fail(8); return; }
+    embPattern_free(p);
+
+    /* a thread that cannot be read fails the read */
+    if(!stxTestFile("format-test.stx", 1, 10, 0)) { fail(9); return; }
+    log = embLog_create(4, 0);
+    p = embPattern_create();
+    if(!log || !p) { fail(10); return; }
+    p->log = log;
+    if(embPattern_read(p, "format-test.stx") || !embLog_errorCount(log)) { fail(11); return; }
+    embPattern_free(p);
+    embLog_free(log);
+    remove("format-test.stx");
+    pass();
+}
+
+void testDxf(void)
+{
+    EmbPattern* p = 0;
+    EmbLog* log = 0;
+    FILE* file = 0;
+    int calls = 0;
+
+    printf("DXF Test...                       ");
+    file = fopen("format-test.dxf", "wb");
+    if(!file) { fail(1); return; }
+    fputs("0\nSECTION\n2\nENTITIES\n0\nENDSEC\n0\nEOF\n", file);
+    fclose(file);
+
+    /* the sections read are reported through the log, not printed */
+    log = embLog_create(4, 0);
+    p = embPattern_create();
+    if(!log || !p) { fail(2); return; }
+    embLog_setCallback(log, logCountRecord, &calls);
+    p->log = log;
+    if(!embPattern_read(p, "format-test.dxf")) { fail(3); return; }
+    if(calls != 2 || embLog_errorCount(log)) { fail(4); return; }
+    embPattern_free(p);
+    embLog_free(log);
+    remove("format-test.dxf");
+    pass();
+}
+
+void spatialCount(void* userData, int kind, int index)
+{
+    int* counts = (int*)userData;
+    (void)index;
+    counts[kind == EMB_SPATIAL_STITCH ? 0 : 1]++;
+}
+
+void testSpatialIndex(void)
+{
+    EmbPattern* p = 0;
+    EmbSpatialIndex* index = 0;
+    EmbRect rect;
+    unsigned long seed = 1;
+    int i, j, found, kind, counts[2] = { 0, 0 };
+    double distance;
+
+    printf("Spatial Index Test...             ");
+    p = embPattern_create();
+    if(!p) { fail(1); return; }
+    for(i = 1; i <= 100; i++)
+        for(j = 1; j <= 100; j++)
+            embPattern_addStitchAbs(p, (double)i, (double)j, NORMAL, 1);
+    embPattern_addLineObjectAbs(p, 0.0, 50.5, 200.0, 50.5);
+
+    index = embPattern_spatialIndex(p);
+    if(!index || index != embPattern_spatialIndex(p)) { fail(2); return; }
+    rect.left = 10.5; rect.right = 20.5; rect.top = 10.5; rect.bottom = 20.5;
+    found = embSpatialIndex_queryRect(index, rect, EMB_SPATIAL_ALL, spatialCount, counts);
+    if(found != 100 || counts[0] != 100 || counts[1] != 0) { fail(3); return; }
+    rect.top = 50.0; rect.bottom = 51.0;
+    if(embSpatialIndex_queryRect(index, rect, EMB_SPATIAL_LINE, 0, 0) != 1) { fail(4); return; }
+
+    /* nearest must agree with a linear scan, inside and outside the design */
+    for(i = 0; i < 200; i++)
+    {
+        double x, y, best = 1.0e30;
+        seed = seed * 1103515245UL + 12345UL;
+        x = (double)((seed >> 8) % 14000) / 100.0 - 20.0;
+        seed = seed * 1103515245UL + 12345UL;
+        y = (double)((seed >> 8) % 14000) / 100.0 - 20.0;
+        for(j = 0; j < embPattern_stitchCount(p); j++)
+        {
+            EmbStitch st = embStitchArray_getAt(&(p->stitchArray), j);
+            double d = (st.xx - x) * (st.xx - x) + (st.yy - y) * (st.yy - y);
+            if(d < best) best = d;
+        }
+        j = embSpatialIndex_nearest(index, x, y, EMB_SPATIAL_STITCH, &kind, &distance);
+        if(j < 0 || kind != EMB_SPATIAL_STITCH || fabs(distance * distance - best) > 1.0e-9) { fail(5); return; }
+    }
+
+    /* appended stitches are found without rebuilding by hand */
+    embPattern_addStitchAbs(p, 500.0, 500.0, JUMP, 1);
+    if(embSpatialIndex_nearestStitch(index, 499.0, 499.0) != embPattern_stitchCount(p) - 1) { fail(6); return; }
+
+    /* transforms drop the index, and the next one sees the moved stitches */
+    embPattern_scale(p, 2.0);
+    if(p->spatialIndex) { fail(7); return; }
+    index = embPattern_spatialIndex(p);
+    rect.left = 21.0; rect.right = 41.0; rect.top = 21.0; rect.bottom = 41.0;
+    if(embSpatialIndex_queryRect(index, rect, EMB_SPATIAL_STITCH, 0, 0) != 100) { fail(8); return; }
+
+    embPattern_free(p);
+    pass();
+}
+
+void testPatternStats(void)
+{
+    EmbPattern* p = 0;
+    EmbPatternStats stats;
+    EmbStitchList* stitches = 0;
+    EmbRect bounds;
+    StreamCheck check;
+    int i, count, real = 0, moves = 0;
+    double length = 0.0;
+
+    printf("Pattern Stats Test...             ");
+    p = embPattern_create();
+    if(!p) { fail(1); return; }
+    for(i = 0; i < 500; i++)
+    {
+        int flags = NORMAL;
+        if(i % 50 == 0) flags = STOP;
+        else if(i % 7 == 0) flags = JUMP;
+        else if(i % 11 == 0) flags = TRIM;
+        embPattern_addStitchAbs(p, (double)(i % 23), (double)(i % 17) - 5.0, flags, 1);
+    }
+
+    /* the cached stats must match a walk over the stitches */
+    stitches = p->stitchArray.stitches;
+    count = embPattern_stitchCount(p);
+    for(i = 0; i < count; i++)
+    {
+        EmbStitch st = stitches[i].stitch;
+        if(st.flags & (JUMP | TRIM | STOP)) moves++;
+        if(!(st.flags & (JUMP | TRIM)))
+        {
+            real++;
+            if(i > 0)
+                length += sqrt((st.xx - stitches[i - 1].stitch.xx) * (st.xx - stitches[i - 1].stitch.xx) +
+                               (st.yy - stitches[i - 1].stitch.yy) * (st.yy - stitches[i - 1].stitch.yy));
+        }
+    }
+    stats = embPattern_stats(p);
+    if(stats.stitchCount != count || stats.realCount != real || stats.moveCount != moves) { fail(2); return; }
+    if(stats.colorChangeCount != 9 || stats.jumpCount != 1 + 70) { fail(3); return; } /* the HOME stitch is a JUMP */
+    if(fabs(stats.threadLength - length) > 1e-9) { fail(4); return; }
+    bounds = embPattern_calcBoundingBox(p);
+    if(bounds.left != 0.0 || bounds.right != 22.0 || bounds.top != -5.0 || bounds.bottom != 11.0) { fail(5); return; }
+
+    /* transforms drop the cached stats */
+    embPattern_scale(p, 2.0);
+    stats = embPattern_stats(p);
+    if(stats.bounds.right != 44.0 || fabs(stats.threadLength - 2.0 * length) > 1e-9) { fail(6); return; }
+    embPattern_free(p);
+
+    /* stitches handed to a stitch callback still count */
+    p = embPattern_create();
+    if(!p) { fail(7); return; }
+    check.count = 0;
+    check.inOrder = 1;
+    check.lastX = 0.0;
+    embPattern_setStitchCallback(p, streamCheckStitch, &check);
+    for(i = 0; i < 1000; i++)
+    {
+        embPattern_addStitchRel(p, 1.0, 0.0, NORMAL, 1);
+    }
+    stats = embPattern_stats(p);
+    if(stats.stitchCount != 1001 || stats.bounds.right != 1000.0 || fabs(stats.threadLength - 1000.0) > 1e-9) { fail(8); return; }
+    embPattern_flushStitches(p);
+    if(embPattern_stats(p).stitchCount != 1001) { fail(9); return; }
+
+    embPattern_free(p);
+    pass();
+}
+
+void testArena(void)
+{
+    EmbArena* arena = 0;
+    EmbPattern* p = 0;
+    EmbPointList* points = 0;
+    EmbPointList* last = 0;
+    double* values = 0;
+    int i;
+
+    printf("Arena Test...                     ");
+    arena = embArena_create();
+    if(!arena) { fail(1); return; }
+    for(i = 0; i < 100000; i++)
+    {
+        values = (double*)embArena_alloc(arena, (i % 3) + 1);
+        if(!values || ((size_t)values % sizeof(double)) != 0) { fail(2); return; }
+        *values = (double)i;
+    }
+    if(!embArena_owns(arena, values) || embArena_owns(arena, &i)) { fail(3); return; }
+    if(embArena_chunkCount(arena) > 8) { fail(4); return; } /* chunks grow, so there are few of them */
+    embArena_free(arena);
+
+    /* polylines made by the pattern come from its arena, ones made elsewhere from the heap */
+    p = embPattern_create();
+    if(!p || !embPattern_useArena(p)) { fail(5); return; }
+    embPattern_addThread(p, embThread_getRandom());
+    for(i = 0; i < 1000; i++)
+    {
+        embPattern_addStitchAbs(p, (double)i, 0.0, (i % 100 == 99) ? JUMP : NORMAL, 1);
+    }
+    embPattern_copyStitchListToPolylines(p);
+    if(embPolylineObjectList_count(p->polylineObjList) != 10) { fail(6); return; }
+    if(!embArena_owns(p->arena, p->polylineObjList->polylineObj->pointList)) { fail(7); return; }
+
+    points = last = embPointList_create(0.0, 0.0);
+    for(i = 1; i < 100; i++)
+    {
+        last = embPointList_add(last, embPoint_make((double)i, 1.0));
+    }
+    if(embArena_owns(p->arena, points)) { fail(8); return; }
+    embPattern_addPolylineObjectAbs(p, embPolylineObject_create(points, embColor_make(0, 0, 0), 1));
+    if(embPolylineObjectList_count(p->polylineObjList) != 11) { fail(9); return; }
+
+    /* the list can be freed without the arena attached: the heap polyline goes, the rest is left to the arena */
+    embPolylineObjectList_free(p->polylineObjList);
+    p->polylineObjList = p->lastPolylineObj = 0;
+    embPattern_free(p);
+    pass();
+}
+
+/* Fills \a data with small signed deltas, like the x and y streams of a HUS or VIP file */
+void compressFillData(unsigned char* data, int size)
+{
+    unsigned long seed = 12345;
+    int i;
+    for(i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        data[i] = (unsigned char)((int)((seed >> 16) % 41) - 20);
+    }
+}
+
+void testCompress(void)
+{
+    EmbCompress* first = 0;
+    EmbCompress* second = 0;
+    unsigned char* input = 0, *packed = 0, *repacked = 0, *unpacked = 0;
+    int size = 65536, packedSize, repackedSize;
+
+    printf("Compress Test...                  ");
+    input = (unsigned char*)malloc(size);
+    packed = (unsigned char*)malloc(size * 2);
+    repacked = (unsigned char*)malloc(size * 2);
+    unpacked = (unsigned char*)malloc(size);
+    first = embCompress_create();
+    second = embCompress_create();
+    if(!input || !packed || !repacked || !unpacked || !first || !second) { fail(1); return; }
+    compressFillData(input, size);
+
+    packedSize = husCompress(first, input, (unsigned long)size, packed, 10, 0);
+    if(packedSize <= 0 || packedSize >= size) { fail(2); return; }
+    husExpand(first, packed, unpacked, packedSize, 10);
+    if(memcmp(input, unpacked, size)) { fail(3); return; }
+
+    /* a reused context and a fresh one must both give the same bytes again */
+    repackedSize = husCompress(first, input, (unsigned long)size, repacked, 10, 0);
+    if(repackedSize != packedSize || memcmp(packed, repacked, packedSize)) { fail(4); return; }
+    repackedSize = husCompress(second, input, (unsigned long)size, repacked, 10, 0);
+    if(repackedSize != packedSize || memcmp(packed, repacked, packedSize)) { fail(5); return; }
+    memset(unpacked, 0, size);
+    husExpand(second, packed, unpacked, packedSize, 10);
+    if(memcmp(input, unpacked, size)) { fail(6); return; }
+
+    /* an input shorter than the window is read no further than its end */
+    packedSize = husCompress(first, input, 100, packed, 10, 0);
+    if(packedSize <= 0) { fail(7); return; }
+    memset(unpacked, 0, size);
+    husExpand(first, packed, unpacked, packedSize, 10);
+    if(memcmp(input, unpacked, 100)) { fail(8); return; }
+
+    embCompress_free(first);
+    embCompress_free(second);
+    free(input);
+    free(packed);
+    free(repacked);
+    free(unpacked);
+    pass();
+}
+
+static const char svgTestData[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+    "<!-- Created with Inkscape -->\n"
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:svg=\"http://www.w3.org/2000/svg\" width=\"100\" height=\"100\" version=\"1.1\">\n"
+    "<circle cx=\"10\" cy=\"20\" r=\"5\" stroke=\"#ff0000\" fill=\"none\"/>\n"
+    "<line x1=\"1\" y1=\"2\" x2=\"30\" y2=\"40\" stroke=\"#00ff00\"/>\n"
+    "<polyline points=\"0,0 10,10\n    20,0\" stroke=\"#0000ff\"/>\n"
+    "</svg>\n";
+
+/* svgTestData with null characters inside its comment */
+static const char svgNullCommentData[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+    "<!-- Created\0with \0Inkscape\0 -->\n"
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:svg=\"http://www.w3.org/2000/svg\" width=\"100\" height=\"100\" version=\"1.1\">\n"
+    "<circle cx=\"10\" cy=\"20\" r=\"5\" stroke=\"#ff0000\" fill=\"none\"/>\n"
+    "<line x1=\"1\" y1=\"2\" x2=\"30\" y2=\"40\" stroke=\"#00ff00\"/>\n"
+    "<polyline points=\"0,0 10,10\n    20,0\" stroke=\"#0000ff\"/>\n"
+    "</svg>\n";
+
+/* Returns true if \a p holds exactly the objects of svgTestData */
+int svgTestCheck(EmbPattern* p)
+{
+    return embCircleObjectList_count(p->circleObjList) == 1 &&
+           embLineObjectList_count(p->lineObjList) == 1 &&
+           embPolylineObjectList_count(p->polylineObjList) == 1 &&
+           embPointList_count(p->polylineObjList->polylineObj->pointList) == 3;
+}
+
+void svgReadTask(void* userData, int index)
+{
+    int* ok = (int*)userData;
+    EmbPattern* p = embPattern_create();
+    if(!p) return;
+    ok[index] = readSvgBuffer(p, svgTestData, (long)strlen(svgTestData)) && svgTestCheck(p);
+    embPattern_free(p);
+}
+
+void testSvgRead(void)
+{
+    EmbPattern* p = 0;
+    FILE* file = 0;
+    int ok[16];
+    int i;
+
+    printf("SVG Read Test...                  ");
+    file = fopen("svg-test.svg", "w");
+    if(!file) { fail(1); return; }
+    fputs(svgTestData, file);
+    fclose(file);
+
+    /* every element, property and attribute is classified by the keyword tables */
+    p = embPattern_create();
+    if(!p) { fail(2); return; }
+    if(!embPattern_read(p, "svg-test.svg")) { fail(3); return; }
+    if(!svgTestCheck(p)) { fail(4); return; }
+    embPattern_free(p);
+    remove("svg-test.svg");
+
+    /* the parser keeps no global state, so buffers can be read on several threads at once */
+    memset(ok, 0, sizeof(ok));
+    if(!embWorker_run(16, 4, svgReadTask, ok)) { fail(5); return; }
+    for(i = 0; i < 16; i++)
+    {
+        if(!ok[i]) { fail(6); return; }
+    }
+
+    /* words are split at null characters, which keyword comparisons never read past */
+    p = embPattern_create();
+    if(!p) { fail(7); return; }
+    if(!readSvgBuffer(p, svgNullCommentData, (long)sizeof(svgNullCommentData) - 1)) { fail(8); return; }
+    if(!svgTestCheck(p)) { fail(9); return; }
+    embPattern_free(p);
+    pass();
+}
+
+void testPalette(void)
+{
+    static EmbThread chart[40]; /* embPalette_chart() keeps charts for good */
+    EmbThread primaries[5];
+    EmbPalette* palette = 0;
+    EmbThreadList* list = 0;
+    EmbColor color;
+    unsigned long seed = 12345;
+    int indices[4];
+    int i;
+
+    printf("Palette Test...                   ");
+    for(i = 0; i < 40; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        chart[i].color = embColor_make((unsigned char)(seed >> 8), (unsigned char)(seed >> 16), (unsigned char)(seed >> 24));
+        chart[i].description = "";
+        chart[i].catalogNumber = "";
+    }
+    chart[30] = chart[5];
+
+    /* the RGB metric matches embThread_findNearestColorInArray(), ties included */
+    palette = embPalette_create(chart, 40, EMB_PALETTE_RGB);
+    if(!palette || embPalette_count(palette) != 40) { fail(1); return; }
+    for(i = 0; i < 4096; i++)
+    {
+        color = embColor_make((unsigned char)(i * 37), (unsigned char)(i * 11 + 3), (unsigned char)(i >> 4));
+        if(embPalette_nearest(palette, color) != embThread_findNearestColorInArray(color, chart, 40)) { fail(2); return; }
+    }
+    if(embPalette_nearest(palette, chart[5].color) != 30) { fail(3); return; }
+
+    list = embThreadList_create(chart[7]);
+    embThreadList_add(embThreadList_add(list, chart[12]), chart[5]);
+    if(embPalette_nearestList(palette, list, indices, 4) != 3) { fail(4); return; }
+    if(indices[0] != 7 || indices[1] != 12 || indices[2] != 30) { fail(5); return; }
+    embThreadList_free(list);
+    embPalette_free(palette);
+
+    /* the CIELAB metric picks perceptually close threads */
+    primaries[0].color = embColor_make(0, 0, 0);
+    primaries[1].color = embColor_make(255, 255, 255);
+    primaries[2].color = embColor_make(255, 0, 0);
+    primaries[3].color = embColor_make(0, 255, 0);
+    primaries[4].color = embColor_make(0, 0, 255);
+    palette = embPalette_create(primaries, 5, EMB_PALETTE_LAB);
+    if(!palette) { fail(6); return; }
+    if(embPalette_nearest(palette, embColor_make(40, 40, 40)) != 0) { fail(7); return; }
+    if(embPalette_nearest(palette, embColor_make(230, 240, 235)) != 1) { fail(8); return; }
+    if(embPalette_nearest(palette, embColor_make(200, 30, 40)) != 2) { fail(9); return; }
+    embPalette_free(palette);
+
+    palette = embPalette_create(0, 0, EMB_PALETTE_RGB);
+    if(!palette || embPalette_nearest(palette, color) != -1) { fail(10); return; }
+    embPalette_free(palette);
+
+    /* a fixed chart's palette is built once and matches like embThread_findNearestColorInArray() */
+    palette = embPalette_chart(chart, 40);
+    if(!palette || embPalette_chart(chart, 40) != palette) { fail(11); return; }
+    for(i = 0; i < 256; i++)
+    {
+        color = embColor_make((unsigned char)(i * 53), (unsigned char)(i * 7 + 9), (unsigned char)i);
+        if(embPalette_nearestInChart(chart, 40, color) != embThread_findNearestColorInArray(color, chart, 40)) { fail(12); return; }
+    }
+    pass();
+}
+
+void testThreadColor(void)
+{
+    ThreadBrand brands[2];
+    ThreadBrand brand = Arc_Polyester;
+    const ThreadColor* entry = 0;
+    int b, i;
+
+    printf("Thread Color Test...              ");
+    for(b = Arc_Polyester; b <= Z102_Isacord_Polyester; b++)
+    {
+        for(i = 1; i < threadColor_count((ThreadBrand)b); i++)
+        {
+            if(threadColor_getAt((ThreadBrand)b, i - 1)->color > threadColor_getAt((ThreadBrand)b, i)->color) { fail(1); return; }
+        }
+    }
+
+    if(threadColorNum(0xFFD25F00, Sulky_Rayon) != 1833) { fail(2); return; }
+    if(strcmp(threadColorName(0xFFD25F00, Sulky_Rayon), "Pumpkin Pie")) { fail(3); return; }
+    if(threadColorNum(0xFFD25F01, Sulky_Rayon) != -1 || strcmp(threadColorName(0xFFD25F01, Sulky_Rayon), "")) { fail(4); return; }
+    if(threadColorNum(0xFFD25F00, (ThreadBrand)-1) != -1 || threadColor_count((ThreadBrand)99) != 0) { fail(5); return; }
+
+    /* every catalog number of a color shared by several numbers is found */
+    if(threadColorNum(0xFFFFFFFF, Isacord_Polyester) != 10) { fail(6); return; }
+    entry = threadColor_findNumber(17, Isacord_Polyester);
+    if(!entry || entry->color != 0xFFFFFFFF) { fail(7); return; }
+    entry = threadColor_findNumber(1833, Sulky_Rayon);
+    if(!entry || entry->color != 0xFFD25F00 || strcmp(entry->name, "Pumpkin Pie")) { fail(8); return; }
+    if(threadColor_findNumber(-1, Sulky_Rayon) || threadColor_findNumber(1, Sulky_Rayon)) { fail(9); return; }
+
+    brands[0] = Isacord_Polyester;
+    brands[1] = Sulky_Rayon;
+    entry = threadColor_nearest(0xFFD25F01, brands, 2, &brand);
+    if(!entry || entry->number != 1833 || brand != Sulky_Rayon) { fail(10); return; }
+    entry = threadColor_nearest(0xFFFFFFFF, brands, 2, &brand);
+    if(!entry || entry->number != 10 || brand != Isacord_Polyester) { fail(11); return; }
+    brands[0] = Arc_Polyester;
+    if(threadColor_nearest(0xFF000000, brands, 1, 0)) { fail(12); return; }
+    pass();
+}
+
+/* Covers more than one chunk of stitches, so the transforms run in parallel */
+void testPatternTransforms(void)
+{
+    EmbPattern* p = 0;
+    EmbStitchList* stitches = 0;
+    int i, count, stitchCount = 100000;
+
+    printf("Pattern Transforms Test...        ");
+    p = embPattern_create();
+    if(!p) { fail(1); return; }
+    for(i = 0; i <= stitchCount; i++)
+    {
+        if(i == stitchCount / 2) embPattern_changeColor(p, 1);
+        embPattern_addStitchAbs(p, 3.0 * i, 0.0, (i % 1000 == 999) ? JUMP : NORMAL, 1);
+    }
+
+    /* every 3 mm stitch becomes three 1 mm stitches, and jumps are split at 1.5 mm into two */
+    embPattern_correctForMaxStitchLength(p, 1.0, 1.5);
+    count = embPattern_stitchCount(p);
+    if(count != 2 + 3 * stitchCount - stitchCount / 1000 + 1) { fail(2); return; }
+    stitches = p->stitchArray.stitches;
+    for(i = 1; i < count - 1; i++)
+    {
+        double step = stitches[i].stitch.xx - stitches[i - 1].stitch.xx;
+        if(step > ((stitches[i].stitch.flags & JUMP) ? 1.5 : 1.0) || step < 0.0) { fail(3); return; }
+        if(stitches[i].next != &stitches[i + 1]) { fail(4); return; }
+        if(stitches[i].stitch.color != (stitches[i].stitch.xx > 1.5 * stitchCount - 3.0 ? 1 : 0)) { fail(5); return; }
+    }
+    if(stitches[count - 1].stitch.flags != END || stitches[count - 1].stitch.xx != 3.0 * stitchCount) { fail(6); return; }
+
+    embPattern_flip(p, 1, 0);
+    embPattern_scale(p, 2.0);
+    stitches = p->stitchArray.stitches;
+    if(stitches[count - 1].stitch.xx != -6.0 * stitchCount || stitches[count - 1].stitch.yy != 0.0) { fail(7); return; }
+
+    /* only the jumps are longer than 2 mm now */
+    embPattern_hideStitchesOverLength(p, 2);
+    for(i = 1; i < count; i++)
+    {
+        if(!(stitches[i].stitch.flags & TRIM) != !(stitches[i].stitch.flags & JUMP)) { fail(8); return; }
+    }
+    embPattern_free(p);
+    pass();
+}
+
+void testPatternCopy(void)
+{
+    EmbPattern* p = 0;
+    EmbPattern* copy = 0;
+    EmbPointList* points = 0;
+    int i;
+
+    printf("Pattern Copy Test...              ");
+    p = embPattern_create();
+    if(!p || !embPattern_useArena(p)) { fail(1); return; }
+    embPattern_addThread(p, embThread_getRandom());
+    for(i = 0; i < 100; i++)
+    {
+        embPattern_addStitchAbs(p, (double)i, 1.0, NORMAL, 1);
+    }
+    points = embPointList_create(0.0, 0.0);
+    embPointList_add(points, embPoint_make(1.0, 2.0));
+    embPattern_addPolylineObjectAbs(p, embPolylineObject_create(points, embColor_make(1, 2, 3), 1));
+    embPattern_addCircleObjectAbs(p, 5.0, 5.0, 2.0);
+
+    copy = embPattern_copy(p);
+    if(!copy) { fail(2); return; }
+    if(embPattern_stitchCount(copy) != embPattern_stitchCount(p) || copy->lastStitch->stitch.xx != 99.0) { fail(3); return; }
+    if(embThreadList_count(copy->threadList) != 1) { fail(4); return; }
+    if(!copy->polylineObjList || copy->polylineObjList->polylineObj->pointList == points) { fail(5); return; } /* points are copied, not shared */
+    if(embPointList_count(copy->polylineObjList->polylineObj->pointList) != 2) { fail(6); return; }
+    if(copy->polylineObjList->polylineObj->color.b != 3) { fail(7); return; }
+    if(!copy->arena || !embArena_owns(copy->arena, copy->polylineObjList->polylineObj->pointList)) { fail(8); return; }
+    if(embCircleObjectList_count(copy->circleObjList) != 1) { fail(9); return; }
+
+    /* changing the copy, as writers do, leaves the original alone */
+    embPattern_scale(copy, 2.0);
+    embPattern_addStitchRel(copy, 0, 0, END, 1);
+    if(embPattern_stitchCount(p) != 101 || p->lastStitch->stitch.xx != 99.0) { fail(10); return; }
+
+    embPattern_free(copy);
+    embPattern_free(p);
+    pass();
+}
+
+void testRecords(void)
+{
+    EmbRecord records[4], decoded[4];
+    unsigned char bytes[16];
+    static const unsigned char expBytes[] = { 0x05, 0xFB, 0x80, 0x01, 0x7F, 0x80, 0x80, 0x02, 0x00, 0x01, 0x80, 0x10, 0x00, 0x00 };
+    static const unsigned char jefBytes[] = { 0x05, 0xFB, 0x80, 0x01, 0x7F, 0x80, 0x80, 0x04, 0x00, 0x01, 0x80, 0x10 };
+    int x, y, size, used;
+
+    printf("Records Test...                   ");
+
+    /* every move DST can encode survives a round trip */
+    for(x = -121; x <= 121; x++)
+    {
+        for(y = -121; y <= 121; y++)
+        {
+            records[0].dx = x;
+            records[0].dy = y;
+            records[0].flags = (x & 1) ? JUMP : (y & 1) ? STOP : NORMAL;
+            if(embRecord_encodeDst(records, 1, bytes) != 3) { fail(1); return; }
+            if(embRecord_decodeDst(bytes, 3, decoded, 4, &used) != 1 || used != 3) { fail(2); return; }
+            /* a DST color change is also a jump */
+            if(decoded[0].dx != x || decoded[0].dy != y || decoded[0].flags != (records[0].flags ? (records[0].flags | JUMP) : NORMAL)) { fail(3); return; }
+        }
+    }
+    records[0].dx = 1;
+    records[0].dy = 0;
+    records[0].flags = NORMAL;
+    records[1].dx = 0;
+    records[1].dy = 0;
+    records[1].flags = END;
+    embRecord_encodeDst(records, 2, bytes);
+    if(bytes[0] != 0x01 || bytes[1] != 0x00 || bytes[2] != 0x03 || bytes[5] != 0xF3) { fail(4); return; }
+    /* decoding stops after END and leaves a partial record alone */
+    if(embRecord_decodeDst(bytes, 6, decoded, 4, &used) != 2 || decoded[1].flags != END) { fail(5); return; }
+    if(embRecord_decodeDst(bytes, 5, decoded, 4, &used) != 1 || used != 3) { fail(6); return; }
+
+    records[0].dx = 5;
+    records[0].dy = -5;
+    records[0].flags = NORMAL;
+    records[1].dx = 127;
+    records[1].dy = -128;
+    records[1].flags = STOP;
+    records[2].dx = 0;
+    records[2].dy = 1;
+    records[2].flags = JUMP;
+    records[3].dx = 0;
+    records[3].dy = 0;
+    records[3].flags = END;
+    size = embRecord_encodeExp(records, 4, bytes);
+    if(size != (int)sizeof(expBytes) || memcmp(bytes, expBytes, sizeof(expBytes))) { fail(7); return; }
+    /* EXP readers take END for a stitch, so only the records before it are decoded */
+    if(embRecord_decodeExp(bytes, size - 4, decoded, 4, &used) != 3 || used != size - 4) { fail(8); return; }
+    if(decoded[1].dx != 127 || decoded[1].dy != -128 || decoded[1].flags != STOP || decoded[2].flags != NORMAL) { fail(9); return; }
+
+    size = embRecord_encodeJef(records, 4, bytes);
+    if(size != (int)sizeof(jefBytes) || memcmp(bytes, jefBytes, sizeof(jefBytes))) { fail(10); return; }
+    if(embRecord_decodeJef(bytes, size, decoded, 4, &used) != 4 || used != size) { fail(11); return; }
+    if(decoded[0].dx != 5 || decoded[0].dy != -5 || decoded[2].flags != TRIM || decoded[3].flags != END) { fail(12); return; }
+    pass();
+}
+
+static void compoundPutUInt16(unsigned char* bytes, unsigned int value)
+{
+    bytes[0] = (unsigned char)(value & 0xFF);
+    bytes[1] = (unsigned char)((value >> 8) & 0xFF);
+}
+
+static void compoundPutUInt32(unsigned char* bytes, unsigned int value)
+{
+    compoundPutUInt16(bytes, value & 0xFFFF);
+    compoundPutUInt16(bytes + 2, (value >> 16) & 0xFFFF);
+}
+
+static void compoundPutEntry(unsigned char* bytes, const char* name, int type, unsigned int start, unsigned int size)
+{
+    int i, length = (int)strlen(name);
+    for(i = 0; i < length; i++)
+        compoundPutUInt16(bytes + i * 2, (unsigned char)name[i]);
+    compoundPutUInt16(bytes + 64, (length + 1) * 2);
+    bytes[66] = (unsigned char)type;
+    compoundPutUInt32(bytes + 68, CompoundFileStreamId_NoStream);
+    compoundPutUInt32(bytes + 72, CompoundFileStreamId_NoStream);
+    compoundPutUInt32(bytes + 76, CompoundFileStreamId_NoStream);
+    compoundPutUInt32(bytes + 116, start);
+    compoundPutUInt32(bytes + 120, size);
+}
+
+/* Builds a version 3 compound file of 16 sectors: the FAT, the directory, a stream in sectors 2, 3 and 5
+ * and a stream in sectors 6 to 15. Returns the size of the file. */
+static long compoundFillData(unsigned char* bytes)
+{
+    unsigned char* sector = 0;
+    int i;
+
+    memset(bytes, 0, 17 * 512);
+    memcpy(bytes, "\xd0\xcf\x11\xe0\xa1\xb1\x1a\xe1", 8);
+    compoundPutUInt16(bytes + 24, 0x003E);
+    compoundPutUInt16(bytes + 26, 3);
+    compoundPutUInt16(bytes + 28, 0xFFFE);
+    compoundPutUInt16(bytes + 30, 9);
+    compoundPutUInt16(bytes + 32, 6);
+    compoundPutUInt32(bytes + 44, 1);
+    compoundPutUInt32(bytes + 48, 1);
+    compoundPutUInt32(bytes + 56, 4096);
+    compoundPutUInt32(bytes + 60, CompoundFileSector_EndOfChain);
+    compoundPutUInt32(bytes + 68, CompoundFileSector_EndOfChain);
+    for(i = 0; i < 109; i++)
+        compoundPutUInt32(bytes + 76 + i * 4, i ? CompoundFileSector_FreeSector : 0);
+
+    sector = bytes + 512;
+    for(i = 0; i < 128; i++)
+        compoundPutUInt32(sector + i * 4, CompoundFileSector_FreeSector);
+    compoundPutUInt32(sector, CompoundFileSector_FAT_Sector);
+    compoundPutUInt32(sector + 4, CompoundFileSector_EndOfChain);
+    compoundPutUInt32(sector + 8, 3);
+    compoundPutUInt32(sector + 12, 5);
+    compoundPutUInt32(sector + 20, CompoundFileSector_EndOfChain);
+    for(i = 6; i < 15; i++)
+        compoundPutUInt32(sector + i * 4, i + 1);
+    compoundPutUInt32(sector + 60, CompoundFileSector_EndOfChain);
+
+    sector = bytes + 2 * 512;
+    compoundPutEntry(sector, "Root Entry", ObjectTypeRootEntry, CompoundFileSector_EndOfChain, 0);
+    compoundPutEntry(sector + 128, "EdsIV Object", ObjectTypeStream, 2, 1300);
+    compoundPutEntry(sector + 256, "Contents", ObjectTypeStream, 6, 5000);
+    compoundPutEntry(sector + 384, "Storage", ObjectTypeStorage, 0, 0);
+
+    for(i = 3 * 512; i < 17 * 512; i++)
+        bytes[i] = (unsigned char)((i * 7) >> 3);
+    return 17 * 512;
+}
+
+/* Returns true if \a stream holds \a size bytes equal to those of \a sectors, read in that order from \a bytes */
+static int compoundCheckStream(EmbFile* stream, const unsigned char* bytes, const int* sectors, long size)
+{
+    unsigned char data[512];
+    long done = 0;
+    int i = 0;
+
+    if(!stream) return 0;
+    while(done < size)
+    {
+        long wanted = size - done < 512 ? size - done : 512;
+        if(embFile_read(data, 1, wanted, stream) != (size_t)wanted) return 0;
+        if(memcmp(data, bytes + (sectors[i++] + 1) * 512, wanted)) return 0;
+        done += wanted;
+    }
+    return embFile_getc(stream) == EOF;
+}
+
+void testCompoundFile(void)
+{
+    static const int fragmented[] = { 2, 3, 5 };
+    static const int contiguous[] = { 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    unsigned char* bytes = 0;
+    EmbFile* file = 0;
+    EmbFile* stream = 0;
+    bcf_file* bcfFile = 0;
+    EmbLog* log = 0;
+    EmbLog* previous = 0;
+    long size;
+    int buffered;
+
+    printf("Compound File Test...             ");
+    bytes = (unsigned char*)malloc(17 * 512);
+    log = embLog_create(4, 0);
+    if(!bytes || !log) { fail(1); return; }
+    size = compoundFillData(bytes);
+
+    /* once from memory, where one run of sectors is not copied, and once through stdio */
+    for(buffered = 1; buffered >= 0; buffered--)
+    {
+        if(buffered)
+        {
+            unsigned char* copy = (unsigned char*)malloc(size);
+            if(!copy) { fail(2); return; }
+            memcpy(copy, bytes, size);
+            file = embFile_openMemory(copy, size);
+        }
+        else
+        {
+            file = embFile_tmpfile();
+            if(file && (embFile_write(bytes, 1, size, file) != (size_t)size || embFile_seek(file, 0, SEEK_SET))) { fail(3); return; }
+        }
+        bcfFile = (bcf_file*)malloc(sizeof(bcf_file));
+        if(!file || !bcfFile || !bcfFile_read(file, bcfFile)) { fail(4); return; }
+
+        stream = bcfFile_openStream(bcfFile, file, "EdsIV Object");
+        if(!compoundCheckStream(stream, bytes, fragmented, 1300)) { fail(5); return; }
+        embFile_close(stream);
+
+        stream = bcfFile_openStream(bcfFile, file, "Contents");
+        if(!compoundCheckStream(stream, bytes, contiguous, 5000)) { fail(6); return; }
+        if(buffered && stream->buffer != file->buffer + 7 * 512) { fail(7); return; }
+        embFile_close(stream);
+
+        /* a missing stream is reported, not a crash */
+        previous = embLog_attach(log);
+        stream = bcfFile_openStream(bcfFile, file, "Missing");
+        embLog_attach(previous);
+        if(stream || embLog_errorCount(log) != 2 - buffered) { fail(8); return; }
+        bcf_file_free(bcfFile);
+        embFile_close(file);
+    }
+    embLog_free(log);
+    free(bytes);
+    pass();
+}
+
+void testTokenizer(void)
+{
+    static const char text[] = "\"#\",\"[a, b]\",\"1\"\r\n\n  0.1 \n-36.3515\n1e-5\n12345678901234567890.5\n\"open";
+    static const char* const numbers[] = { "0.1", "-36.3515", "1e-5", "12.345678", "-0.000125", "3.", "12345678901234567890.5", "1.5e300" };
+    char* longLine = 0;
+    char copy[8];
+    EmbFile* file = 0;
+    EmbTokenizer* tokenizer = 0;
+    EmbToken line, field;
+    long size = (long)strlen(text);
+    int buffered, i;
+
+    printf("Tokenizer Test...                 ");
+
+    /* once in place from memory and once a block at a time through stdio */
+    for(buffered = 1; buffered >= 0; buffered--)
+    {
+        if(buffered)
+        {
+            unsigned char* bytes = (unsigned char*)malloc(size);
+            if(!bytes) { fail(1); return; }
+            memcpy(bytes, text, size);
+            file = embFile_openMemory(bytes, size);
+        }
+        else
+        {
+            file = embFile_tmpfile();
+            if(file && (embFile_write(text, 1, size, file) != (size_t)size || embFile_seek(file, 0, SEEK_SET))) { fail(2); return; }
+        }
+        tokenizer = embTokenizer_create(file);
+        if(!tokenizer) { fail(3); return; }
+
+        /* quoted fields keep their commas and lose the line ending */
+        if(!embTokenizer_readLine(tokenizer, &line)) { fail(4); return; }
+        if(embToken_nextQuoted(&line, &field) != 1 || !embToken_equals(field, "#")) { fail(5); return; }
+        if(embToken_nextQuoted(&line, &field) != 1 || !embToken_equals(field, "[a, b]")) { fail(6); return; }
+        if(embToken_nextQuoted(&line, &field) != 1 || embToken_toInt(field) != 1) { fail(7); return; }
+        if(embToken_nextQuoted(&line, &field) != 0) { fail(8); return; }
+
+        if(!embTokenizer_readLine(tokenizer, &line) || line.length) { fail(9); return; }
+        if(!embTokenizer_readLine(tokenizer, &line) || !embToken_equals(embToken_trim(line), "0.1")) { fail(10); return; }
+        if(!embTokenizer_readLine(tokenizer, &line) || embToken_toDouble(line) != -36.3515) { fail(11); return; }
+        if(!embTokenizer_readLine(tokenizer, &line) || embToken_toDouble(line) != 1e-5) { fail(12); return; }
+        if(!embTokenizer_readLine(tokenizer, &line) || strcmp(embToken_copy(line, copy, sizeof(copy)), "1234567")) { fail(13); return; }
+
+        /* the last line has no line ending and its quote is not closed */
+        if(!embTokenizer_readLine(tokenizer, &line) || embToken_nextQuoted(&line, &field) != -1) { fail(14); return; }
+        if(embTokenizer_readLine(tokenizer, &line)) { fail(15); return; }
+        embTokenizer_free(tokenizer);
+        embFile_close(file);
+    }
+
+    /* numbers match strtod() whether they take the fast path or not */
+    for(i = 0; i < (int)(sizeof(numbers) / sizeof(numbers[0])); i++)
+    {
+        line.data = numbers[i];
+        line.length = (int)strlen(numbers[i]);
+        if(embToken_toDouble(line) != strtod(numbers[i], 0)) { fail(16); return; }
+    }
+
+    /* a line longer than a block grows it */
+    size = 200000;
+    longLine = (char*)malloc(size);
+    file = embFile_tmpfile();
+    if(!longLine || !file) { fail(17); return; }
+    memset(longLine, 'x', size);
+    longLine[size - 1] = '\n';
+    for(i = 0; i < 2; i++)
+    {
+        if(embFile_write(longLine, 1, size, file) != (size_t)size) { fail(18); return; }
+    }
+    embFile_seek(file, 0, SEEK_SET);
+    tokenizer = embTokenizer_create(file);
+    for(i = 0; i < 2; i++)
+    {
+        if(!embTokenizer_readLine(tokenizer, &line) || line.length != size - 1 || line.data[size - 2] != 'x') { fail(19); return; }
+    }
+    if(embTokenizer_readLine(tokenizer, &line)) { fail(20); return; }
+    embTokenizer_free(tokenizer);
+    embFile_close(file);
+    free(longLine);
+    pass();
+}
+
+/* Measures how fast one context compresses and expands 1 MB of stitch deltas */
+void benchmarkCompress(void)
+{
+    EmbCompress* c = 0;
+    unsigned char* input = 0, *packed = 0, *unpacked = 0;
+    int size = 1 << 20, packedSize = 0, runs = 8, i;
+    clock_t start;
+    double compressSeconds, expandSeconds;
+
+    printf("Compress Benchmark...             ");
+    input = (unsigned char*)malloc(size);
+    packed = (unsigned char*)malloc(size * 2);
+    unpacked = (unsigned char*)malloc(size);
+    c = embCompress_create();
+    if(!input || !packed || !unpacked || !c) { fail(1); return; }
+    compressFillData(input, size);
+
+    start = clock();
+    for(i = 0; i < runs; i++)
+        packedSize = husCompress(c, input, (unsigned long)size, packed, 10, 0);
+    compressSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for(i = 0; i < runs; i++)
+        husExpand(c, packed, unpacked, packedSize, 10);
+    expandSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    if(memcmp(input, unpacked, size)) { fail(2); return; }
+    if(compressSeconds <= 0.0) compressSeconds = 1.0 / CLOCKS_PER_SEC;
+    if(expandSeconds <= 0.0) expandSeconds = 1.0 / CLOCKS_PER_SEC;
+    printf("%.1f MB/s compress, %.1f MB/s expand, ratio %.2f\n",
+           runs * (size / 1048576.0) / compressSeconds,
+           runs * (size / 1048576.0) / expandSeconds,
+           (double)packedSize / size);
+
+    embCompress_free(c);
+    free(input);
+    free(packed);
+    free(unpacked);
+}
+
+/* Measures inserts and lookups of DXF style layer names in one map */
+void benchmarkHash(void)
+{
+    EmbHash* hash = 0;
+    char (*keys)[16] = 0;
+    long count = 200000, runs = 10, found = 0, i, run;
+    clock_t start;
+    double insertSeconds, lookupSeconds;
+
+    printf("Hash Benchmark...                 ");
+    keys = (char (*)[16])malloc(sizeof(keys[0]) * count * 2);
+    hash = embHash_create();
+    if(!keys || !hash) { fail(1); return; }
+    for(i = 0; i < count * 2; i++)
+        sprintf(keys[i], "LAYER_%ld", i);
+
+    start = clock();
+    for(run = 0; run < runs; run++)
+    {
+        embHash_clear(hash);
+        for(i = 0; i < count; i++)
+            embHash_insert(hash, keys[i], keys[i]);
+    }
+    insertSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    /* half of the lookups miss */
+    start = clock();
+    for(run = 0; run < runs; run++)
+    {
+        for(i = 0; i < count * 2; i++)
+            if(embHash_value(hash, keys[i])) found++;
+    }
+    lookupSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    if(found != count * runs) { fail(2); return; }
+    if(insertSeconds <= 0.0) insertSeconds = 1.0 / CLOCKS_PER_SEC;
+    if(lookupSeconds <= 0.0) lookupSeconds = 1.0 / CLOCKS_PER_SEC;
+    printf("%.1f M inserts/s, %.1f M lookups/s\n",
+           runs * (count / 1000000.0) / insertSeconds,
+           runs * (count * 2 / 1000000.0) / lookupSeconds);
+
+    embHash_free(hash);
+    free(keys);
+}
+
+/* Size and makeup of the synthetic pattern of the format benchmark, and where its results go */
+typedef struct BenchmarkSettings_
+{
+    long stitches;
+    int colors;
+    double jumpRatio;   /* share of the stitches that are jumps */
+    FILE* csv;          /* one line per measurement if not null */
+} BenchmarkSettings;
+
+/* Totals of one operation repeated over \a runs runs */
+typedef struct BenchmarkResult_
+{
+    int runs;
+    double seconds;
+    long bytes;             /* size of the file, per run */
+    long stitches;          /* per run */
+    long peakKilobytes;     /* -1 if unknown */
+    double allocations;     /* over all runs, -1 if unknown */
+} BenchmarkResult;
+
+/* Forgets the peak resident set size so far, where the system allows it */
+static void benchmarkResetPeak(void)
+{
+#ifdef __linux__
+    FILE* file = fopen("/proc/self/clear_refs", "w");
+    if(file)
+    {
+        fputs("5", file);
+        fclose(file);
+    }
+#endif
+}
+
+/* Returns the peak resident set size of the process in kilobytes, or -1 if it is unknown */
+static long benchmarkPeakKilobytes(void)
+{
+    long peak = -1;
+#ifdef __linux__
+    char line[128];
+    FILE* file = fopen("/proc/self/status", "r");
+    if(!file) return -1;
+    while(fgets(line, sizeof(line), file))
+    {
+        if(!strncmp(line, "VmHWM:", 6))
+            peak = atol(line + 6);
+    }
+    fclose(file);
+#endif
+    return peak;
+}
+
+static unsigned long benchmarkAllocations(void)
+{
+#ifdef BENCHMARK_COUNT_ALLOCATIONS
+    return __sync_fetch_and_add(&benchmarkAllocationCount, 0);
+#else
+    return 0;
+#endif
+}
+
+/* Returns a new pattern that fills a 100 mm square with rows of short zigzag stitches,
+ * changing color evenly \a colors - 1 times and jumping at random for \a jumpRatio of the stitches */
+static EmbPattern* benchmarkCreatePattern(const BenchmarkSettings* settings)
+{
+    EmbPattern* p = 0;
+    unsigned long seed = 1;
+    int color = 0;
+    long i;
+
+    p = embPattern_create();
+    if(!p) return 0;
+    for(i = 0; i < settings->colors; i++)
+    {
+        EmbThread thread;
+        thread.color = embColor_make((unsigned char)(i * 37), (unsigned char)(i * 71), (unsigned char)(i * 113));
+        thread.description = "Benchmark";
+        thread.catalogNumber = "";
+        embPattern_addThread(p, thread);
+    }
+    for(i = 0; i < settings->stitches; i++)
+    {
+        long column = i % 250, row = (i / 250) % 250;
+        int flags = NORMAL;
+        int next = (int)((double)i * settings->colors / settings->stitches);
+
+        seed = (seed * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+        if(next != color)
+        {
+            flags = STOP;
+            color = next;
+        }
+        else if(((seed >> 16) & 0x7FFF) < settings->jumpRatio * 32768.0)
+        {
+            flags = JUMP;
+        }
+        if(row % 2) column = 249 - column;
+        embPattern_addStitchAbs(p, column * 0.4, row * 0.4 + (i % 2), flags, 1);
+    }
+    embPattern_addStitchRel(p, 0.0, 0.0, END, 1);
+    return p;
+}
+
+/* Prints \a result and adds it to the CSV file of \a settings.
+ * The per stitch figures are left out when no stitches were read or written, as with the color formats. */
+static void benchmarkReport(const BenchmarkSettings* settings, const char* name, const char* operation, const BenchmarkResult* result)
+{
+    double seconds = result->seconds > 0.0 ? result->seconds : 1.0 / CLOCKS_PER_SEC;
+    double megabytesPerSecond = result->runs * (result->bytes / 1048576.0) / seconds;
+    double stitchesPerSecond = result->runs * (double)result->stitches / seconds;
+    double allocationsPerStitch = -1.0;
+
+    if(result->allocations >= 0.0 && result->stitches > 0)
+        allocationsPerStitch = result->allocations / result->runs / result->stitches;
+
+    if(result->stitches > 0)
+    {
+        printf("    %-24s %-5s %8.1f MB/s %8.2f M stitches/s %8ld KB peak %8.3f allocations/stitch\n",
+               name, operation, megabytesPerSecond, stitchesPerSecond / 1000000.0, result->peakKilobytes, allocationsPerStitch);
+    }
+    else
+    {
+        printf("    %-24s %-5s %8.1f MB/s %8s              %8ld KB peak\n",
+               name, operation, megabytesPerSecond, "-", result->peakKilobytes);
+    }
+    if(settings->csv)
+    {
+        fprintf(settings->csv, "%s,%s,%d,%ld,%ld,%.6f,%.3f,", name, operation, result->runs, result->bytes, result->stitches, result->seconds, megabytesPerSecond);
+        if(result->stitches > 0)
+            fprintf(settings->csv, "%.1f,%ld,%.3f\n", stitchesPerSecond, result->peakKilobytes, allocationsPerStitch);
+        else
+            fprintf(settings->csv, ",%ld,\n", result->peakKilobytes);
+    }
+}
+
+/* Reads \a fileName over and over for about a quarter of a second. Returns \c false if it cannot be read. */
+static int benchmarkRead(BenchmarkResult* result, const char* fileName)
+{
+    unsigned long allocations = 0;
+    clock_t start, total = 0;
+
+    result->runs = 0;
+    result->bytes = fileSize(fileName);
+    benchmarkResetPeak();
+    while(result->runs < 1000 && (result->runs < 3 || total < CLOCKS_PER_SEC / 4))
+    {
+        EmbPattern* p = 0;
+        unsigned long before = benchmarkAllocations();
+        int successful;
+
+        start = clock();
+        p = embPattern_create();
+        successful = p && embPattern_read(p, fileName);
+        result->stitches = p ? embPattern_stitchCount(p) : 0;
+        embPattern_free(p);
+        total += clock() - start;
+        allocations += benchmarkAllocations() - before;
+        if(!successful) return 0;
+        result->runs++;
+    }
+    result->seconds = (double)total / CLOCKS_PER_SEC;
+    result->peakKilobytes = benchmarkPeakKilobytes();
+    result->allocations = benchmarkAllocations() ? (double)allocations : -1.0;
+    return 1;
+}
+
+/* Writes a fresh synthetic pattern to \a fileName over and over for about a quarter of a second,
+ * as some writers change the pattern they write. Returns \c false if it cannot be written. */
+static int benchmarkWrite(BenchmarkResult* result, const BenchmarkSettings* settings, const char* fileName)
+{
+    unsigned long allocations = 0;
+    clock_t start, total = 0;
+
+    result->runs = 0;
+    benchmarkResetPeak();
+    while(result->runs < 1000 && (result->runs < 3 || total < CLOCKS_PER_SEC / 4))
+    {
+        EmbPattern* p = benchmarkCreatePattern(settings);
+        unsigned long before = benchmarkAllocations();
+        int successful;
+
+        if(!p) return 0;
+        result->stitches = embPattern_stitchCount(p);
+        start = clock();
+        successful = embPattern_write(p, fileName);
+        total += clock() - start;
+        allocations += benchmarkAllocations() - before;
+        embPattern_free(p);
+        if(!successful) return 0;
+        result->runs++;
+    }
+    result->seconds = (double)total / CLOCKS_PER_SEC;
+    result->bytes = fileSize(fileName);
+    result->peakKilobytes = benchmarkPeakKilobytes();
+    result->allocations = benchmarkAllocations() ? (double)allocations : -1.0;
+    return 1;
+}
+
+/* Round trips a synthetic pattern through every format that can be both written and read,
+ * then reads each of \a designs, which are the names of existing files */
+void benchmarkFormats(const BenchmarkSettings* settings, const char* designs[], int designCount)
+{
+    BenchmarkResult result, readResult;
+    EmbLog* log = 0;
+    EmbLog* previous = 0;
+    char fileName[32];
+    int i;
+
+    printf("Format Benchmark...               %ld stitches, %d colors, %.0f%% jumps\n",
+           settings->stitches, settings->colors, settings->jumpRatio * 100.0);
+    /* messages of the readers and writers are kept out of the terminal and the timings */
+    log = embLog_create(16, 0);
+    if(!log) { fail(1); return; }
+    previous = embLog_attach(log);
+    if(settings->csv)
+        fprintf(settings->csv, "name,operation,runs,bytes,stitches,seconds,megabytesPerSecond,stitchesPerSecond,peakKilobytes,allocationsPerStitch\n");
+
+    for(i = 0; i < embFormat_count(); i++)
+    {
+        const EmbFormat* format = embFormat_getAt(i);
+        if(format->reader != 'U' || format->writer != 'U' || format->type != EMBFORMAT_STITCHONLY)
+            continue;
+        sprintf(fileName, "benchmark%s", format->extension);
+
+        if(!benchmarkWrite(&result, settings, fileName))
+        {
+            printf("    %-24s write failed\n", format->extension);
+            remove(fileName);
+            continue;
+        }
+        if(!benchmarkRead(&readResult, fileName))
+        {
+            benchmarkReport(settings, format->extension, "write", &result);
+            printf("    %-24s read failed\n", format->extension);
+            remove(fileName);
+            continue;
+        }
+        /* a format that reads back no stitches, such as a color format, wrote none either */
+        if(readResult.stitches <= 0)
+            result.stitches = 0;
+        benchmarkReport(settings, format->extension, "write", &result);
+        benchmarkReport(settings, format->extension, "read", &readResult);
+        remove(fileName);
+    }
+
+    for(i = 0; i < designCount; i++)
+    {
+        const char* name = strrchr(designs[i], '/');
+        name = name ? name + 1 : designs[i];
+        if(benchmarkRead(&result, designs[i]))
+            benchmarkReport(settings, name, "read", &result);
+        else
+            printf("    %-24s read failed\n", name);
+    }
+    embLog_attach(previous);
+    embLog_free(log);
+}
+
 int main(int argc, const char* argv[])
 {
     /*TODO: Add tests here */
@@ -79,6 +1970,64 @@ int main(int argc, const char* argv[])
     testRead();
     testWrite();
     testHash();
+    testHashResize();
+    testStitchArray();
+    testStitchStream();
+    testStreamConvert();
+    testWorker();
+    testCompress();
+    testLog();
+    testFormat();
+    testMax();
+    testPcs();
+    testPlt();
+    testBro();
+    testStx();
+    testDxf();
+    testSpatialIndex();
+    testPatternStats();
+    testArena();
+    testSvgRead();
+    testPalette();
+    testThreadColor();
+    testPatternTransforms();
+    testPatternCopy();
+    testRecords();
+    testCompoundFile();
+    testTokenizer();
+
+    if(argc > 1 && !strcmp(argv[1], "--benchmark"))
+    {
+        BenchmarkSettings settings;
+        const char** designs = argv + 2;
+        int designCount = 0, i;
+
+        /* --benchmark [--stitches N] [--colors N] [--jumps RATIO] [--csv FILE] [DESIGN...] */
+        settings.stitches = 50000;
+        settings.colors = 8;
+        settings.jumpRatio = 0.05;
+        settings.csv = 0;
+        for(i = 2; i < argc; i++)
+        {
+            if(i + 1 < argc && !strcmp(argv[i], "--stitches")) settings.stitches = atol(argv[++i]);
+            else if(i + 1 < argc && !strcmp(argv[i], "--colors")) settings.colors = atoi(argv[++i]);
+            else if(i + 1 < argc && !strcmp(argv[i], "--jumps")) settings.jumpRatio = atof(argv[++i]);
+            else if(i + 1 < argc && !strcmp(argv[i], "--csv"))
+            {
+                settings.csv = fopen(argv[++i], "w");
+                if(!settings.csv) { printf("cannot open %s for writing\n", argv[i]); return 1; }
+            }
+            else designs[designCount++] = argv[i];
+        }
+        if(settings.stitches < 1) settings.stitches = 1;
+        if(settings.colors < 1) settings.colors = 1;
+
+        benchmarkCompress();
+        benchmarkHash();
+        benchmarkFormats(&settings, designs, designCount);
+        if(settings.csv)
+            fclose(settings.csv);
+    }
 
     return 0;
 }
@@ -16,5 +16,11 @@ $$PWD \
 
 SOURCES += libembroidery-test-main.c
 
+#Count allocations in the format benchmark with qmake CONFIG+=benchmark_allocations (GNU ld only)
+benchmark_allocations {
+    DEFINES += BENCHMARK_COUNT_ALLOCATIONS
+    QMAKE_LFLAGS += -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc
+}
+
 include( ../libembroidery/libembroidery.pri )
 
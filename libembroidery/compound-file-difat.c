@@ -14,7 +14,7 @@ bcf_file_difat* bcf_difat_create(EmbFile* file, unsigned int fatSectors, const u
     unsigned int sectorRef;
 
     difat = (bcf_file_difat*)malloc(sizeof(bcf_file_difat));
-    if(!difat) { embLog_error("compound-file-difat.c bcf_difat_create(), cannot allocate memory for difat\n"); } /* TODO: avoid crashing. null pointer will be accessed */
+    if(!difat) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "compound-file-difat.c bcf_difat_create(), cannot allocate memory for difat\n"); } /* TODO: avoid crashing. null pointer will be accessed */
 
     difat->sectorSize = sectorSize;
     if(fatSectors > NumberOfDifatEntriesInHeader)
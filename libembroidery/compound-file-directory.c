@@ -35,9 +35,11 @@ static void readCLSID(EmbFile* file, bcf_directory_entry* dir)
 bcf_directory* CompoundFileDirectory(const unsigned int maxNumberOfDirectoryEntries)
 {
     bcf_directory* dir = (bcf_directory*)malloc(sizeof(bcf_directory));
-    if(!dir) { embLog_error("compound-file-directory.c CompoundFileDirectory(), cannot allocate memory for dir\n"); } /* TODO: avoid crashing. null pointer will be accessed */
+    if(!dir) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "compound-file-directory.c CompoundFileDirectory(), cannot allocate memory for dir\n"); } /* TODO: avoid crashing. null pointer will be accessed */
     dir->maxNumberOfDirectoryEntries = maxNumberOfDirectoryEntries;
     dir->dirEntries = 0;
+    dir->nameTable = 0;
+    dir->nameMask = 0;
     return dir;
 }
 
@@ -55,7 +57,7 @@ EmbTime parseTime(EmbFile* file)
 bcf_directory_entry* CompoundFileDirectoryEntry(EmbFile* file)
 {
     bcf_directory_entry* dir = (bcf_directory_entry*)malloc(sizeof(bcf_directory_entry));
-    if(!dir) { embLog_error("compound-file-directory.c CompoundFileDirectoryEntry(), cannot allocate memory for dir\n"); } /* TODO: avoid crashing. null pointer will be accessed */
+    if(!dir) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "compound-file-directory.c CompoundFileDirectoryEntry(), cannot allocate memory for dir\n"); } /* TODO: avoid crashing. null pointer will be accessed */
     memset(dir->directoryEntryName, 0, 32);
     parseDirectoryEntryName(file, dir);
     dir->next = 0;
@@ -66,6 +68,9 @@ bcf_directory_entry* CompoundFileDirectoryEntry(EmbFile* file)
         (dir->objectType != ObjectTypeRootEntry))
     {
         embLog_error("compound-file-directory.c CompoundFileDirectoryEntry(), unexpected object type: %d\n", dir->objectType);
+        /* Skip the rest of the entry so the next one is read from its start */
+        embFile_seek(file, 61, SEEK_CUR);
+        free(dir);
         return 0;
     }
     dir->colorFlag = (unsigned char)binaryReadByte(file);
@@ -85,33 +90,113 @@ bcf_directory_entry* CompoundFileDirectoryEntry(EmbFile* file)
 void readNextSector(EmbFile* file, bcf_directory* dir)
 {
     unsigned int i;
+    bcf_directory_entry* last = dir->dirEntries;
+    while(last && last->next)
+    {
+        last = last->next;
+    }
     for(i = 0; i < dir->maxNumberOfDirectoryEntries; ++i)
     {
         bcf_directory_entry* dirEntry = CompoundFileDirectoryEntry(file);
-        bcf_directory_entry* pointer = dir->dirEntries;
-        if(!pointer)
+        if(!dirEntry)
+        {
+            continue;
+        }
+        if(!last)
         {
             dir->dirEntries = dirEntry;
         }
         else
         {
-            while(pointer)
-            {
-                if(!pointer->next)
-                {
-                    pointer->next = dirEntry;
-                    break;
-                }
-                pointer = pointer->next;
-            }
+            last->next = dirEntry;
+        }
+        last = dirEntry;
+    }
+}
+
+static unsigned int bcf_directory_hash(const char* name)
+{
+    unsigned int hash = 2166136261U;
+    while(*name)
+    {
+        hash = (hash ^ (unsigned char)*name++) * 16777619U;
+    }
+    return hash;
+}
+
+/*! Builds the name table of \a dir, so bcf_directory_find() does not walk the whole directory.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int bcf_directory_index(bcf_directory* dir)
+{
+    bcf_directory_entry* pointer = 0;
+    unsigned int tableSize = 4;
+    unsigned int count = 0;
+
+    if(!dir) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "compound-file-directory.c bcf_directory_index(), dir argument is null\n"); return 0; }
+
+    for(pointer = dir->dirEntries; pointer; pointer = pointer->next)
+    {
+        count++;
+    }
+    while(tableSize < count * 2)
+    {
+        tableSize *= 2;
+    }
+    free(dir->nameTable);
+    dir->nameTable = (bcf_directory_entry**)calloc(tableSize, sizeof(bcf_directory_entry*));
+    if(!dir->nameTable) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "compound-file-directory.c bcf_directory_index(), cannot allocate memory for nameTable\n"); return 0; }
+    dir->nameMask = tableSize - 1;
+
+    for(pointer = dir->dirEntries; pointer; pointer = pointer->next)
+    {
+        unsigned int slot = bcf_directory_hash(pointer->directoryEntryName) & dir->nameMask;
+        /* The first entry of a name is kept, as a walk of the directory would find it first */
+        while(dir->nameTable[slot] && strcmp(dir->nameTable[slot]->directoryEntryName, pointer->directoryEntryName) != 0)
+        {
+            slot = (slot + 1) & dir->nameMask;
         }
+        if(!dir->nameTable[slot])
+        {
+            dir->nameTable[slot] = pointer;
+        }
+    }
+    return 1;
+}
+
+/*! Returns the entry of \a dir with the given \a name, or null if there is none. */
+bcf_directory_entry* bcf_directory_find(bcf_directory* dir, const char* name)
+{
+    bcf_directory_entry* pointer = 0;
+    unsigned int slot;
+
+    if(!dir) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "compound-file-directory.c bcf_directory_find(), dir argument is null\n"); return 0; }
+    if(!name) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "compound-file-directory.c bcf_directory_find(), name argument is null\n"); return 0; }
+
+    if(!dir->nameTable)
+    {
+        for(pointer = dir->dirEntries; pointer; pointer = pointer->next)
+        {
+            if(strcmp(name, pointer->directoryEntryName) == 0)
+                return pointer;
+        }
+        return 0;
+    }
+    slot = bcf_directory_hash(name) & dir->nameMask;
+    while(dir->nameTable[slot])
+    {
+        if(strcmp(name, dir->nameTable[slot]->directoryEntryName) == 0)
+            return dir->nameTable[slot];
+        slot = (slot + 1) & dir->nameMask;
     }
+    return 0;
 }
 
 void bcf_directory_free(bcf_directory* dir)
 {
-    bcf_directory_entry* pointer = dir->dirEntries;
+    bcf_directory_entry* pointer = 0;
     bcf_directory_entry* entryToFree = 0;
+    if(!dir) return;
+    pointer = dir->dirEntries;
     while(pointer)
     {
         entryToFree = pointer;
@@ -121,6 +206,7 @@ void bcf_directory_free(bcf_directory* dir)
     }
     if(dir)
     {
+        free(dir->nameTable);
         free(dir);
         dir = 0;
     }
@@ -35,11 +35,17 @@ typedef struct _bcf_directory
     unsigned int         maxNumberOfDirectoryEntries;
     /* TODO: possibly add a directory tree in the future */
 
+    /* Open addressing table from entry names to entries, filled in by bcf_directory_index() */
+    bcf_directory_entry** nameTable;
+    unsigned int          nameMask;
+
 } bcf_directory;
 
 extern EMB_PRIVATE bcf_directory_entry* EMB_CALL CompoundFileDirectoryEntry(EmbFile* file);
 extern EMB_PRIVATE bcf_directory* EMB_CALL CompoundFileDirectory(const unsigned int maxNumberOfDirectoryEntries);
 extern EMB_PRIVATE void EMB_CALL readNextSector(EmbFile* file, bcf_directory* dir);
+extern EMB_PRIVATE int EMB_CALL bcf_directory_index(bcf_directory* dir);
+extern EMB_PRIVATE bcf_directory_entry* EMB_CALL bcf_directory_find(bcf_directory* dir, const char* name);
 extern EMB_PRIVATE void EMB_CALL bcf_directory_free(bcf_directory* dir);
 
 #ifdef __cplusplus
@@ -9,9 +9,11 @@ const unsigned int sizeOfFatEntry = sizeof(unsigned int);
 bcf_file_fat* bcfFileFat_create(const unsigned int sectorSize)
 {
     bcf_file_fat* fat = (bcf_file_fat*)malloc(sizeof(bcf_file_fat));
-    if(!fat) { embLog_error("compound-file-fat.c bcfFileFat_create(), cannot allocate memory for fat\n"); } /* TODO: avoid crashing. null pointer will be accessed */
+    if(!fat) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "compound-file-fat.c bcfFileFat_create(), cannot allocate memory for fat\n"); } /* TODO: avoid crashing. null pointer will be accessed */
     fat->numberOfEntriesInFatSector = sectorSize / sizeOfFatEntry;
     fat->fatEntryCount = 0;
+    fat->fatEntries = 0;
+    fat->runLengths = 0;
     return fat;
 }
 
@@ -20,6 +22,9 @@ void loadFatFromSector(bcf_file_fat* fat, EmbFile* file)
     unsigned int i;
     unsigned int currentNumberOfFatEntries = fat->fatEntryCount;
     unsigned int newSize = currentNumberOfFatEntries + fat->numberOfEntriesInFatSector;
+    unsigned int* newEntries = (unsigned int*)realloc(fat->fatEntries, sizeof(unsigned int) * newSize);
+    if(!newEntries) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "compound-file-fat.c loadFatFromSector(), cannot allocate memory for fatEntries\n"); return; }
+    fat->fatEntries = newEntries;
     for(i = currentNumberOfFatEntries; i < newSize; ++i)
     {
         unsigned int fatEntry = binaryReadUInt32(file);
@@ -28,8 +33,35 @@ void loadFatFromSector(bcf_file_fat* fat, EmbFile* file)
     fat->fatEntryCount = newSize;
 }
 
+/*! Fills in fat->runLengths from the loaded FAT entries, so a chain of adjacent sectors can be read in one go.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int bcfFileFat_indexRuns(bcf_file_fat* fat)
+{
+    unsigned int count = 0;
+    unsigned int i;
+
+    if(!fat) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "compound-file-fat.c bcfFileFat_indexRuns(), fat argument is null\n"); return 0; }
+    count = (unsigned int)fat->fatEntryCount;
+    free(fat->runLengths);
+    fat->runLengths = (unsigned int*)malloc(sizeof(unsigned int) * (count + 1));
+    if(!fat->runLengths) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "compound-file-fat.c bcfFileFat_indexRuns(), cannot allocate memory for runLengths\n"); return 0; }
+
+    fat->runLengths[count] = 0;
+    for(i = count; i-- > 0; )
+    {
+        if(fat->fatEntries[i] == i + 1)
+            fat->runLengths[i] = fat->runLengths[i + 1] + 1;
+        else
+            fat->runLengths[i] = 1;
+    }
+    return 1;
+}
+
 void bcf_file_fat_free(bcf_file_fat* fat)
 {
+    if(!fat) return;
+    free(fat->fatEntries);
+    free(fat->runLengths);
     free(fat);
     fat = 0;
 }
@@ -12,12 +12,14 @@ extern "C" {
 typedef struct _bcf_file_fat
 {
     int          fatEntryCount;
-    unsigned int fatEntries[255]; /* maybe make this dynamic */
+    unsigned int* fatEntries;
+    unsigned int* runLengths; /* runLengths[i] is how many sectors of the chain from sector i on are also adjacent in the file */
     unsigned int numberOfEntriesInFatSector;
 } bcf_file_fat;
 
 extern EMB_PRIVATE bcf_file_fat* EMB_CALL bcfFileFat_create(const unsigned int sectorSize);
 extern EMB_PRIVATE void EMB_CALL loadFatFromSector(bcf_file_fat* fat, EmbFile* file);
+extern EMB_PRIVATE int EMB_CALL bcfFileFat_indexRuns(bcf_file_fat* fat);
 extern EMB_PRIVATE void EMB_CALL bcf_file_fat_free(bcf_file_fat* fat);
 
 #ifdef __cplusplus
@@ -4,9 +4,7 @@
 #include "compound-file-fat.h"
 #include "compound-file-common.h"
 #include "emb-logging.h"
-#include <math.h>
 #include <stdio.h>
-#include <string.h>
 #include <stdlib.h>
 
 static unsigned int sizeOfDirectoryEntry = 128;
@@ -57,6 +55,9 @@ int bcfFile_read(EmbFile* file, bcf_file* bcfFile)
 {
     unsigned int i, numberOfDirectoryEntriesPerSector, directorySectorToReadFrom;
 
+    bcfFile->difat = 0;
+    bcfFile->fat = 0;
+    bcfFile->directory = 0;
     bcfFile->header = bcfFileHeader_read(file);
     if(!bcfFileHeader_isValid(bcfFile->header))
     {
@@ -81,55 +82,96 @@ int bcfFile_read(EmbFile* file, bcf_file* bcfFile)
     numberOfDirectoryEntriesPerSector = sectorSize(bcfFile) / sizeOfDirectoryEntry;
     bcfFile->directory = CompoundFileDirectory(numberOfDirectoryEntriesPerSector);
     directorySectorToReadFrom = bcfFile->header.firstDirectorySectorLocation;
-    while(directorySectorToReadFrom != CompoundFileSector_EndOfChain)
+    for(i = 0; directorySectorToReadFrom != CompoundFileSector_EndOfChain; ++i)
     {
+        if(directorySectorToReadFrom >= (unsigned int)bcfFile->fat->fatEntryCount || i >= (unsigned int)bcfFile->fat->fatEntryCount)
+        {
+            embLog_error("compound-file.c bcfFile_read(), broken directory sector chain at sector %u\n", directorySectorToReadFrom);
+            return 0;
+        }
         seekToSector(bcfFile, file, directorySectorToReadFrom);
         readNextSector(file, bcfFile->directory);
         directorySectorToReadFrom = bcfFile->fat->fatEntries[directorySectorToReadFrom];
     }
 
+    if(!bcfFileFat_indexRuns(bcfFile->fat) || !bcf_directory_index(bcfFile->directory))
+    {
+        return 0;
+    }
     return 1;
 }
 
-EmbFile* GetFile(bcf_file* bcfFile, EmbFile* file, char* fileToFind)
+/*! Returns a read-only EmbFile holding the stream named \a name of the compound file \a file, which \a bcfFile was read from.
+ *  If \a file is buffered and the stream lies in one run of adjacent sectors, the result is a view into the buffer of \a file
+ *  and must be closed before \a file is. Otherwise each run of adjacent sectors is copied into memory with a single read.
+ *  Returns null if there is no such stream or it cannot be read. */
+EmbFile* bcfFile_openStream(bcf_file* bcfFile, EmbFile* file, const char* name)
 {
-    int filesize, sectorSize, currentSector, sizeToWrite, currentSize, totalSectors, i;
-    char* input = 0;
-    EmbFile* fileOut = embFile_tmpfile();
-    bcf_directory_entry* pointer = bcfFile->directory->dirEntries;
-    while(pointer)
+    bcf_directory_entry* entry = 0;
+    bcf_file_fat* fat = 0;
+    unsigned char* buffer = 0;
+    unsigned int bytesPerSector, sector;
+    long size, done = 0;
+
+    if(!bcfFile) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "compound-file.c bcfFile_openStream(), bcfFile argument is null\n"); return 0; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "compound-file.c bcfFile_openStream(), file argument is null\n"); return 0; }
+    if(!name) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "compound-file.c bcfFile_openStream(), name argument is null\n"); return 0; }
+
+    entry = bcf_directory_find(bcfFile->directory, name);
+    if(!entry) { embLog_error("compound-file.c bcfFile_openStream(), there is no stream named %s\n", name); return 0; }
+
+    fat = bcfFile->fat;
+    bytesPerSector = sectorSize(bcfFile);
+    sector = entry->startingSectorLocation;
+    size = (long)entry->streamSize;
+
+    if(size > 0 && embFile_isBuffered(file) && sector < (unsigned int)fat->fatEntryCount &&
+       (unsigned long)fat->runLengths[sector] * bytesPerSector >= (unsigned long)size)
     {
-        if(strcmp(fileToFind, pointer->directoryEntryName) == 0)
-        break;
-        pointer = pointer->next;
+        return embFile_openView(file, (long)(sector + 1) * bytesPerSector, size);
     }
-    filesize = pointer->streamSize;
-    sectorSize = bcfFile->difat->sectorSize;
-    input = (char*)malloc(sectorSize);
-    if(!input) { embLog_error("compound-file.c GetFile(), cannot allocate memory for input\n"); } /* TODO: avoid crashing. null pointer will be accessed */
-    currentSize = 0;
-    currentSector = pointer->startingSectorLocation;
-    totalSectors = (int)ceil((float)filesize / sectorSize);
-    for(i = 0; i < totalSectors; i++)
+
+    /* NOTE: one extra byte so an empty stream still gets a valid buffer */
+    buffer = (unsigned char*)malloc(size + 1);
+    if(!buffer) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "compound-file.c bcfFile_openStream(), cannot allocate memory for buffer\n"); return 0; }
+    while(done < size)
     {
-        seekToSector(bcfFile, file, currentSector);
-        sizeToWrite = filesize - currentSize;
-        if(sectorSize < sizeToWrite)
+        unsigned int run;
+        long runSize;
+
+        if(sector >= (unsigned int)fat->fatEntryCount)
         {
-            sizeToWrite = sectorSize;
+            embLog_error("compound-file.c bcfFile_openStream(), broken sector chain in stream %s\n", name);
+            free(buffer);
+            return 0;
         }
-        embFile_read(input, 1, sizeToWrite, file);
-        embFile_write(input, 1, sizeToWrite, fileOut);
-        currentSize += sizeToWrite;
-        currentSector = bcfFile->fat->fatEntries[currentSector];
+        run = fat->runLengths[sector];
+        runSize = (long)run * bytesPerSector;
+        if(runSize > size - done)
+        {
+            runSize = size - done;
+        }
+        if(seekToSector(bcfFile, file, sector) != 0 || embFile_read(buffer + done, 1, runSize, file) != (size_t)runSize)
+        {
+            embLog_error("compound-file.c bcfFile_openStream(), cannot read stream %s\n", name);
+            free(buffer);
+            return 0;
+        }
+        done += runSize;
+        sector = fat->fatEntries[sector + run - 1];
     }
-    free(input);
-    input = 0;
-    return fileOut;
+    return embFile_openMemory(buffer, size);
+}
+
+/*! Same as bcfFile_openStream(). */
+EmbFile* GetFile(bcf_file* bcfFile, EmbFile* file, char* fileToFind)
+{
+    return bcfFile_openStream(bcfFile, file, fileToFind);
 }
 
 void bcf_file_free(bcf_file* bcfFile)
 {
+    if(!bcfFile) return;
     bcf_file_difat_free(bcfFile->difat);
     bcfFile->difat = 0;
     bcf_file_fat_free(bcfFile->fat);
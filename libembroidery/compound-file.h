@@ -22,6 +22,7 @@ typedef struct _bcf_file
 } bcf_file;
 
 extern EMB_PRIVATE int EMB_CALL bcfFile_read(EmbFile* file, bcf_file* bcfFile);
+extern EMB_PRIVATE EmbFile* EMB_CALL bcfFile_openStream(bcf_file* bcfFile, EmbFile* file, const char* name);
 extern EMB_PRIVATE EmbFile* EMB_CALL GetFile(bcf_file* bcfFile, EmbFile* file, char* fileToFind);
 extern EMB_PRIVATE void EMB_CALL bcf_file_free(bcf_file* bcfFile);
 
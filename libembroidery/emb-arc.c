@@ -29,12 +29,21 @@ EmbArcObject* embArcObject_create(double sx, double sy, double mx, double my, do
     return heapArcObj;
 }
 
+EmbArcObjectList* embArcObjectList_create(EmbArcObject data)
+{
+    EmbArcObjectList* heapArcObjList = (EmbArcObjectList*)malloc(sizeof(EmbArcObjectList));
+    if(!heapArcObjList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-arc.c embArcObjectList_create(), cannot allocate memory for heapArcObjList\n"); return 0; }
+    heapArcObjList->arcObj = data;
+    heapArcObjList->next = 0;
+    return heapArcObjList;
+}
+
 EmbArcObjectList* embArcObjectList_add(EmbArcObjectList* pointer, EmbArcObject data)
 {
-    if(!pointer) { embLog_error("emb-arc.c embArcObjectList_add(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-arc.c embArcObjectList_add(), pointer argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-arc.c embArcObjectList_add(), pointer->next should be null\n"); return 0; }
     pointer->next = (EmbArcObjectList*)malloc(sizeof(EmbArcObjectList));
-    if(!pointer->next) { embLog_error("emb-arc.c embArcObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-arc.c embArcObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->arcObj = data;
     pointer->next = 0;
@@ -39,6 +39,7 @@ typedef struct EmbArcObjectList_
     struct EmbArcObjectList_* next;
 } EmbArcObjectList;
 
+extern EMB_PUBLIC EmbArcObjectList* EMB_CALL embArcObjectList_create(EmbArcObject data);
 extern EMB_PUBLIC EmbArcObjectList* EMB_CALL embArcObjectList_add(EmbArcObjectList* pointer, EmbArcObject data);
 extern EMB_PUBLIC int EMB_CALL embArcObjectList_count(EmbArcObjectList* pointer);
 extern EMB_PUBLIC int EMB_CALL embArcObjectList_empty(EmbArcObjectList* pointer);
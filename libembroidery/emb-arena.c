@@ -0,0 +1,164 @@
+#include "emb-arena.h"
+#include "emb-logging.h"
+#include "emb-worker.h"
+#include <stdlib.h>
+
+/* Size of the first chunk of an arena. Each new chunk doubles it, up to EMB_ARENA_MAX_CHUNK,
+ * so a pattern with millions of vertices still has only a handful of chunks to free and search. */
+#define EMB_ARENA_MIN_CHUNK 65536
+#define EMB_ARENA_MAX_CHUNK (1 << 24)
+
+/* Every allocation is rounded up to and aligned on the size of this */
+typedef union EmbArenaAlign_
+{
+    double d;
+    long l;
+    void* p;
+} EmbArenaAlign;
+
+typedef struct EmbArenaChunk_
+{
+    struct EmbArenaChunk_* next;
+    size_t size;
+    size_t used;
+    EmbArenaAlign data[1]; /* size bytes, allocated along with the chunk */
+} EmbArenaChunk;
+
+/* Placed in front of every block from embArena_malloc(), naming the arena it came from, or null for the heap */
+typedef union EmbArenaHeader_
+{
+    EmbArena* arena;
+    EmbArenaAlign align;
+} EmbArenaHeader;
+
+struct EmbArena_
+{
+    EmbArenaChunk* chunks; /* the newest chunk, which allocations come from, is first */
+    int chunkCount;
+    size_t nextSize;
+};
+
+/* Each thread allocates from its own arena, so patterns read side by side do not share one */
+static EMB_THREAD_LOCAL EmbArena* embArena_currentArena = 0;
+
+/*! Returns a pointer to a new, empty EmbArena. The caller is responsible for freeing it with embArena_free(). */
+EmbArena* embArena_create(void)
+{
+    EmbArena* arena = (EmbArena*)malloc(sizeof(EmbArena));
+    if(!arena) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-arena.c embArena_create(), cannot allocate memory for arena\n"); return 0; }
+    arena->chunks = 0;
+    arena->chunkCount = 0;
+    arena->nextSize = EMB_ARENA_MIN_CHUNK;
+    return arena;
+}
+
+/*! Returns \a size bytes from \a arena, suitably aligned for any type. They stay valid until the arena is freed.
+ *  Returns null if a new chunk is needed and cannot be allocated. */
+void* embArena_alloc(EmbArena* arena, size_t size)
+{
+    EmbArenaChunk* chunk = 0;
+    void* pointer = 0;
+
+    if(!arena) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-arena.c embArena_alloc(), arena argument is null\n"); return 0; }
+    if(size == 0) size = 1;
+    size = (size + sizeof(EmbArenaAlign) - 1) / sizeof(EmbArenaAlign) * sizeof(EmbArenaAlign);
+
+    chunk = arena->chunks;
+    if(!chunk || chunk->size - chunk->used < size)
+    {
+        size_t chunkSize = arena->nextSize > size ? arena->nextSize : size;
+        chunk = (EmbArenaChunk*)malloc(offsetof(EmbArenaChunk, data) + chunkSize);
+        if(!chunk) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-arena.c embArena_alloc(), cannot allocate memory for chunk\n"); return 0; }
+        chunk->size = chunkSize;
+        chunk->used = 0;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        arena->chunkCount++;
+        if(arena->nextSize < EMB_ARENA_MAX_CHUNK)
+            arena->nextSize *= 2;
+    }
+    pointer = (char*)chunk->data + chunk->used;
+    chunk->used += size;
+    return pointer;
+}
+
+/*! Returns \c true if \a pointer was allocated from \a arena. A null \a arena owns nothing. */
+int embArena_owns(EmbArena* arena, const void* pointer)
+{
+    EmbArenaChunk* chunk = 0;
+
+    if(!arena || !pointer) return 0;
+    for(chunk = arena->chunks; chunk; chunk = chunk->next)
+    {
+        const char* start = (const char*)chunk->data;
+        if((const char*)pointer >= start && (const char*)pointer < start + chunk->used)
+            return 1;
+    }
+    return 0;
+}
+
+/*! Returns the number of chunks \a arena has allocated. */
+int embArena_chunkCount(EmbArena* arena)
+{
+    if(!arena) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-arena.c embArena_chunkCount(), arena argument is null\n"); return 0; }
+    return arena->chunkCount;
+}
+
+/*! Makes the lists and objects created on the calling thread come from \a arena, until another arena is attached.
+ *  A null \a arena goes back to the heap. Returns the arena that was attached before, so it can be restored. */
+EmbArena* embArena_attach(EmbArena* arena)
+{
+    EmbArena* previous = embArena_currentArena;
+    embArena_currentArena = arena;
+    return previous;
+}
+
+/*! Frees every chunk of \a arena and the arena itself, detaching it from the calling thread. */
+void embArena_free(EmbArena* arena)
+{
+    EmbArenaChunk* chunk = 0;
+
+    if(!arena) return;
+    if(embArena_currentArena == arena)
+        embArena_currentArena = 0;
+    chunk = arena->chunks;
+    while(chunk)
+    {
+        EmbArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+/* Returns the arena the block \a pointer from embArena_malloc() was allocated from, or null if it is on the heap */
+EmbArena* embArena_owner(const void* pointer)
+{
+    if(!pointer) return 0;
+    return ((const EmbArenaHeader*)pointer - 1)->arena;
+}
+
+/* malloc() replacement for the list and object constructors, which draws from the attached arena if there is one */
+void* embArena_malloc(size_t size)
+{
+    EmbArenaHeader* header = 0;
+
+    if(embArena_currentArena)
+        header = (EmbArenaHeader*)embArena_alloc(embArena_currentArena, sizeof(EmbArenaHeader) + size);
+    else
+        header = (EmbArenaHeader*)malloc(sizeof(EmbArenaHeader) + size);
+    if(!header) return 0;
+    header->arena = embArena_currentArena;
+    return header + 1;
+}
+
+/* free() replacement for the list and object destructors. Arena memory is left for embArena_free(),
+ * whichever arena the calling thread has attached. */
+void embArena_release(void* pointer)
+{
+    if(!pointer || embArena_owner(pointer))
+        return;
+    free((EmbArenaHeader*)pointer - 1);
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -0,0 +1,36 @@
+/*! @file emb-arena.h */
+#ifndef EMB_ARENA_H
+#define EMB_ARENA_H
+
+#include <stddef.h>
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Hands out memory from a list of large chunks and releases all of it at once in embArena_free().
+ * While an arena is attached to a thread, the point, flag, path, polygon and polyline lists and objects
+ * created on that thread are allocated from it. A list is built either wholly in one arena or wholly on the heap.
+ * Each of them remembers where it came from, so it can be freed on any thread, attached or not. */
+typedef struct EmbArena_ EmbArena;
+
+extern EMB_PUBLIC EmbArena* EMB_CALL embArena_create(void);
+extern EMB_PUBLIC void* EMB_CALL embArena_alloc(EmbArena* arena, size_t size);
+extern EMB_PUBLIC int EMB_CALL embArena_owns(EmbArena* arena, const void* pointer);
+extern EMB_PUBLIC int EMB_CALL embArena_chunkCount(EmbArena* arena);
+extern EMB_PUBLIC EmbArena* EMB_CALL embArena_attach(EmbArena* arena);
+extern EMB_PUBLIC void EMB_CALL embArena_free(EmbArena* arena);
+
+extern EMB_PRIVATE EmbArena* EMB_CALL embArena_owner(const void* pointer);
+extern EMB_PRIVATE void* EMB_CALL embArena_malloc(size_t size);
+extern EMB_PRIVATE void EMB_CALL embArena_release(void* pointer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_ARENA_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
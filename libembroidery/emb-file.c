@@ -1,35 +1,197 @@
 #include "emb-file.h"
+#include "emb-logging.h"
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
+#ifndef ARDUINO
+/* Wraps an open stdio stream (\a oFile) in an EmbFile. Closes (\a oFile) and returns null if memory cannot be allocated. */
+static EmbFile* embFile_wrap(FILE* oFile)
+{
+    EmbFile* eFile = (EmbFile*)malloc(sizeof(EmbFile));
+    if(!eFile)
+    {
+        fclose(oFile);
+        return 0;
+    }
+
+    eFile->file = oFile;
+    eFile->buffer = 0;
+    eFile->size = 0;
+    eFile->position = 0;
+    eFile->eof = 0;
+    eFile->ownsBuffer = 1;
+    return eFile;
+}
+#endif /* ARDUINO */
+
+/* Files larger than this are read through stdio rather than loaded whole, so streamed conversions stay flat in memory. */
+#define EMB_FILE_MAX_BUFFERED_SIZE (16L * 1024L * 1024L)
+
+/*! Opens the file with the given \a fileName using the stdio \a mode string.
+ *  Read-only binary opens ("rb") are served from memory, see embFile_openBuffered(). */
 EmbFile* embFile_open(const char* fileName, const char* mode)
 {
 #ifdef ARDUINO
     return inoFile_open(fileName, mode);
 #else
     EmbFile* eFile = 0;
-    FILE* oFile = fopen(fileName, mode);
+    FILE* oFile = 0;
+
+    if(!strcmp(mode, "rb"))
+    {
+        eFile = embFile_openBuffered(fileName);
+    }
+    else
+    {
+        oFile = fopen(fileName, mode);
+        if(oFile)
+            eFile = embFile_wrap(oFile);
+    }
+    if(eFile)
+        embLog_fileOpened(eFile, fileName);
+    return eFile;
+#endif
+}
+
+/*! Opens the file with the given \a fileName for binary reading and loads its whole content into memory.
+ *  All further reads are served from that buffer instead of going through stdio for each byte.
+ *  Files that are not seekable or larger than EMB_FILE_MAX_BUFFERED_SIZE are read through stdio instead.
+ *  Returns null if the file cannot be opened or read. */
+EmbFile* embFile_openBuffered(const char* fileName)
+{
+#ifdef ARDUINO
+    return inoFile_open(fileName, "rb");
+#else
+    EmbFile* eFile = 0;
+    FILE* oFile = 0;
+    long size = 0;
+
+    oFile = fopen(fileName, "rb");
     if(!oFile)
         return 0;
 
-    eFile = (EmbFile*)malloc(sizeof(EmbFile));
+    size = -1;
+    if(fseek(oFile, 0, SEEK_END) == 0)
+        size = ftell(oFile);
+    if(size < 0 || fseek(oFile, 0, SEEK_SET) != 0)
+    {
+        /* Not seekable, fall back to plain stdio reads */
+        return embFile_wrap(oFile);
+    }
+    if(size > EMB_FILE_MAX_BUFFERED_SIZE)
+    {
+        /* Too large to be worth holding in memory, fall back to plain stdio reads */
+        return embFile_wrap(oFile);
+    }
+
+    eFile = embFile_wrap(oFile);
     if(!eFile)
+        return 0;
+
+    /* NOTE: one extra byte so an empty file still gets a valid buffer */
+    eFile->buffer = (unsigned char*)malloc(size + 1);
+    if(!eFile->buffer)
+    {
+        /* Not enough memory to hold the file, fall back to plain stdio reads */
+        return eFile;
+    }
+    if(fread(eFile->buffer, 1, size, oFile) != (size_t)size)
     {
+        free(eFile->buffer);
         fclose(oFile);
+        free(eFile);
         return 0;
     }
+    fclose(oFile);
+    eFile->file = 0;
+    eFile->size = size;
+    return eFile;
+#endif
+}
 
-    eFile->file = oFile;
+/*! Returns a read-only EmbFile serving the \a size bytes of \a buffer, which must come from malloc().
+ *  The EmbFile takes ownership of \a buffer and frees it in embFile_close(), also when null is returned.
+ *  Returns null if memory cannot be allocated. */
+EmbFile* embFile_openMemory(unsigned char* buffer, long size)
+{
+#ifdef ARDUINO
+    free(buffer);
+    return 0; /* ARDUINO TODO: inoFile has no in-memory mode. */
+#else
+    EmbFile* eFile = 0;
+
+    if(!buffer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-file.c embFile_openMemory(), buffer argument is null\n"); return 0; }
+    if(size < 0) { embLog_error("emb-file.c embFile_openMemory(), size argument is negative\n"); free(buffer); return 0; }
+
+    eFile = (EmbFile*)malloc(sizeof(EmbFile));
+    if(!eFile)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-file.c embFile_openMemory(), cannot allocate memory for eFile\n");
+        free(buffer);
+        return 0;
+    }
+    eFile->file = 0;
+    eFile->buffer = buffer;
+    eFile->size = size;
+    eFile->position = 0;
+    eFile->eof = 0;
+    eFile->ownsBuffer = 1;
+    return eFile;
+#endif
+}
+
+/*! Returns a read-only EmbFile serving the \a size bytes of the buffered \a stream starting at \a offset, without copying them.
+ *  The view must be closed before \a stream is. Returns null if \a stream is not buffered, the range is out of bounds
+ *  or memory cannot be allocated. */
+EmbFile* embFile_openView(EmbFile* stream, long offset, long size)
+{
+#ifdef ARDUINO
+    return 0; /* ARDUINO TODO: inoFile has no in-memory mode. */
+#else
+    EmbFile* eFile = 0;
+
+    if(!stream) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-file.c embFile_openView(), stream argument is null\n"); return 0; }
+    if(!stream->buffer) { embLog_error("emb-file.c embFile_openView(), stream argument is not buffered\n"); return 0; }
+    if(offset < 0 || size < 0 || offset > stream->size || size > stream->size - offset)
+    {
+        embLog_error("emb-file.c embFile_openView(), range %ld+%ld is out of bounds\n", offset, size);
+        return 0;
+    }
+
+    eFile = (EmbFile*)malloc(sizeof(EmbFile));
+    if(!eFile) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-file.c embFile_openView(), cannot allocate memory for eFile\n"); return 0; }
+    eFile->file = 0;
+    eFile->buffer = stream->buffer + offset;
+    eFile->size = size;
+    eFile->position = 0;
+    eFile->eof = 0;
+    eFile->ownsBuffer = 0;
     return eFile;
 #endif
 }
 
+/*! Returns \c true if \a stream is served from an in-memory buffer, otherwise returns \c false. */
+int embFile_isBuffered(EmbFile* stream)
+{
+#ifdef ARDUINO
+    return 0;
+#else /* ARDUINO */
+    return stream->buffer != 0;
+#endif /* ARDUINO */
+}
+
 int embFile_close(EmbFile* stream)
 {
 #ifdef ARDUINO
     return inoFile_close(stream);
 #else /* ARDUINO */
-    int retVal = fclose(stream->file);
+    int retVal = 0;
+    embLog_fileClosed(stream);
+    if(stream->buffer && stream->ownsBuffer)
+        free(stream->buffer);
+    if(stream->file)
+        retVal = fclose(stream->file);
     free(stream);
     stream = 0;
     return retVal;
@@ -41,6 +203,8 @@ int embFile_eof(EmbFile* stream)
 #ifdef ARDUINO
     return inoFile_eof(stream);
 #else /* ARDUINO */
+    if(stream->buffer)
+        return stream->eof;
     return feof(stream->file);
 #endif /* ARDUINO */
 }
@@ -50,6 +214,15 @@ int embFile_getc(EmbFile* stream)
 #ifdef ARDUINO
     return inoFile_getc(stream);
 #else /* ARDUINO */
+    if(stream->buffer)
+    {
+        if(stream->position >= stream->size)
+        {
+            stream->eof = 1;
+            return EOF;
+        }
+        return stream->buffer[stream->position++];
+    }
     return fgetc(stream->file);
 #endif /* ARDUINO */
 }
@@ -59,6 +232,23 @@ size_t embFile_read(void* ptr, size_t size, size_t nmemb, EmbFile* stream)
 #ifdef ARDUINO
     return 0; /* ARDUINO TODO: SD File read() doesn't appear to return the same way as fread(). This will need work. */
 #else /* ARDUINO */
+    if(stream->buffer)
+    {
+        size_t wanted = size * nmemb;
+        size_t available = 0;
+        if(size == 0 || nmemb == 0)
+            return 0;
+        if(stream->position < stream->size)
+            available = (size_t)(stream->size - stream->position);
+        if(available < wanted)
+        {
+            wanted = available;
+            stream->eof = 1;
+        }
+        memcpy(ptr, stream->buffer + stream->position, wanted);
+        stream->position += (long)wanted;
+        return wanted / size;
+    }
     return fread(ptr, size, nmemb, stream->file);
 #endif /* ARDUINO */
 }
@@ -68,6 +258,8 @@ size_t embFile_write(const void* ptr, size_t size, size_t nmemb, EmbFile* stream
 #ifdef ARDUINO
     return 0; /* ARDUINO TODO: Implement inoFile_write. */
 #else /* ARDUINO */
+    if(stream->buffer)
+        return 0; /* Buffered files are read-only */
     return fwrite(ptr, size, nmemb, stream->file);
 #endif /* ARDUINO */
 }
@@ -77,6 +269,22 @@ int embFile_seek(EmbFile* stream, long offset, int origin)
 #ifdef ARDUINO
     return inoFile_seek(stream, offset, origin);
 #else /* ARDUINO */
+    if(stream->buffer)
+    {
+        long newPosition = offset;
+        if(origin == SEEK_CUR)
+            newPosition += stream->position;
+        else if(origin == SEEK_END)
+            newPosition += stream->size;
+        else if(origin != SEEK_SET)
+            return -1;
+        if(newPosition < 0)
+            return -1;
+        /* NOTE: Like fseek(), seeking past the end is allowed and subsequent reads hit EOF */
+        stream->position = newPosition;
+        stream->eof = 0;
+        return 0;
+    }
     return fseek(stream->file, offset, origin);
 #endif /* ARDUINO */
 }
@@ -86,6 +294,8 @@ long embFile_tell(EmbFile* stream)
 #ifdef ARDUINO
     return inoFile_tell(stream);
 #else /* ARDUINO */
+    if(stream->buffer)
+        return stream->position;
     return ftell(stream->file);
 #endif /* ARDUINO */
 }
@@ -95,20 +305,10 @@ EmbFile* embFile_tmpfile(void)
 #ifdef ARDUINO
     return inoFile_tmpfile();
 #else
-    EmbFile* eFile = 0;
     FILE* tFile = tmpfile();
     if(!tFile)
         return 0;
-
-    eFile = (EmbFile*)malloc(sizeof(EmbFile));
-    if(!eFile)
-    {
-        fclose(tFile);
-        return 0;
-    }
-
-    eFile->file = tFile;
-    return eFile;
+    return embFile_wrap(tFile);
 #endif
 }
 
@@ -117,6 +317,8 @@ int embFile_putc(int ch, EmbFile* stream)
 #ifdef ARDUINO
     return inoFile_putc(ch, stream);
 #else /* ARDUINO */
+    if(stream->buffer)
+        return EOF; /* Buffered files are read-only */
     return fputc(ch, stream->file);
 #endif /* ARDUINO */
 }
@@ -133,6 +335,8 @@ int embFile_printf(EmbFile* stream, const char* format, ...)
 #else /* ARDUINO */
     int retVal;
     va_list args;
+    if(stream->buffer)
+        return -1; /* Buffered files are read-only */
     va_start(args, format);
     retVal = vfprintf(stream->file, format, args);
     va_end(args);
@@ -15,10 +15,21 @@ extern "C" {
 typedef struct EmbFile_
 {
     FILE* file;
+
+    /* Buffered mode: the whole input is held in memory and read through a cursor. Unused (null) for stdio streams. */
+    unsigned char* buffer;
+    long size;
+    long position;
+    int eof;
+    int ownsBuffer; /* false for views into the buffer of another EmbFile, see embFile_openView() */
 } EmbFile;
 #endif /* ARDUINO */
 
 extern EMB_PUBLIC EmbFile* EMB_CALL embFile_open(const char* fileName, const char* mode);
+extern EMB_PUBLIC EmbFile* EMB_CALL embFile_openBuffered(const char* fileName);
+extern EMB_PUBLIC EmbFile* EMB_CALL embFile_openMemory(unsigned char* buffer, long size);
+extern EMB_PUBLIC EmbFile* EMB_CALL embFile_openView(EmbFile* stream, long offset, long size);
+extern EMB_PUBLIC int EMB_CALL embFile_isBuffered(EmbFile* stream);
 extern EMB_PUBLIC int EMB_CALL embFile_close(EmbFile* stream);
 extern EMB_PUBLIC int EMB_CALL embFile_eof(EmbFile* stream);
 extern EMB_PUBLIC int EMB_CALL embFile_getc(EmbFile* stream);
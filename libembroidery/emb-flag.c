@@ -1,4 +1,5 @@
 #include "emb-flag.h"
+#include "emb-arena.h"
 #include "emb-logging.h"
 #include <stdlib.h>
 
@@ -8,8 +9,8 @@
 
 EmbFlagList* embFlagList_create(EmbFlag data)
 {
-    EmbFlagList* heapFlagList = (EmbFlagList*)malloc(sizeof(EmbFlagList));
-    if(!heapFlagList) { embLog_error("emb-flag.c embFlagList_create(), cannot allocate memory for heapFlagList\n"); return 0; }
+    EmbFlagList* heapFlagList = (EmbFlagList*)embArena_malloc(sizeof(EmbFlagList));
+    if(!heapFlagList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-flag.c embFlagList_create(), cannot allocate memory for heapFlagList\n"); return 0; }
     heapFlagList->flag = data;
     heapFlagList->next = 0;
     return heapFlagList;
@@ -17,10 +18,10 @@ EmbFlagList* embFlagList_create(EmbFlag data)
 
 EmbFlagList* embFlagList_add(EmbFlagList* pointer, EmbFlag data)
 {
-    if(!pointer) { embLog_error("emb-flag.c embFlagList_add(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-flag.c embFlagList_add(), pointer argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-flag.c embFlagList_add(), pointer->next should be null\n"); return 0; }
-    pointer->next = (EmbFlagList*)malloc(sizeof(EmbFlagList));
-    if(!pointer->next) { embLog_error("emb-flag.c embFlagList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    pointer->next = (EmbFlagList*)embArena_malloc(sizeof(EmbFlagList));
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-flag.c embFlagList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->flag = data;
     pointer->next = 0;
@@ -50,10 +51,13 @@ void embFlagList_free(EmbFlagList* pointer)
 {
     EmbFlagList* tempPointer = pointer;
     EmbFlagList* nextPointer = 0;
+    /* NOTE: a list built in an arena is freed along with it */
+    if(embArena_owner(pointer))
+        return;
     while(tempPointer)
     {
         nextPointer = tempPointer->next;
-        free(tempPointer);
+        embArena_release(tempPointer);
         tempPointer = nextPointer;
     }
     pointer = 0;
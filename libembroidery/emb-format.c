@@ -1,101 +1,228 @@
 #include "emb-format.h"
 #include "emb-logging.h"
+#include "formats.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
+/**************************************************/
+/* EmbFormat                                      */
+/**************************************************/
+
+#ifdef ARDUINO /* ARDUINO TODO: This is temporary. Remove when complete. */
+#define EMBFORMAT_RW(r, w) { 0, 0 }
+#else /* ARDUINO TODO: This is temporary. Remove when complete. */
+#define EMBFORMAT_RW(r, w) { r, w }
+#endif /* ARDUINO TODO: This is temporary. Remove when complete. */
+
+/* Formats without a signature of their own. */
+#define EMBFORMAT_NOMAGIC { { 0, 0, 0 } }
+
+/* Every known format, sorted by extension so lookups can use bsearch().
+ * TODO: This list needs reviewed in case some stitch formats also can contain object data (EMBFORMAT_STCHANDOBJ).
+ * NOTE: Only signatures unique to one format belong here. DST, DSB and DSZ all start with "LA:" and
+ *       EMB files are generic OLE2 containers, so those formats are identified by their extension alone. */
+static const EmbFormat embFormats[] =
+{
+    { ".100", "Toyota Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(read100, write100), EMBFORMAT_NOMAGIC },
+    { ".10o", "Toyota Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(read10o, write10o), EMBFORMAT_NOMAGIC },
+    { ".art", "Bernina Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readArt, writeArt), EMBFORMAT_NOMAGIC },
+    { ".bmc", "Bitmap Cache Embroidery Format",     ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readBmc, writeBmc), EMBFORMAT_NOMAGIC },
+    { ".bro", "Bits & Volts Embroidery Format",     'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readBro, writeBro), EMBFORMAT_NOMAGIC },
+    { ".cnd", "Melco Embroidery Format",            ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readCnd, writeCnd), EMBFORMAT_NOMAGIC },
+    { ".col", "Embroidery Thread Color Format",     'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readCol, writeCol), EMBFORMAT_NOMAGIC },
+    { ".csd", "Singer Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readCsd, writeCsd), EMBFORMAT_NOMAGIC },
+    { ".csv", "Comma Separated Values Format",      'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readCsv, writeCsv), EMBFORMAT_NOMAGIC },
+    { ".dat", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readDat, writeDat), EMBFORMAT_NOMAGIC },
+    { ".dem", "Melco Embroidery Format",            ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readDem, writeDem), EMBFORMAT_NOMAGIC },
+    { ".dsb", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readDsb, writeDsb), EMBFORMAT_NOMAGIC },
+    { ".dst", "Tajima Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readDst, writeDst), EMBFORMAT_NOMAGIC },
+    { ".dsz", "ZSK USA Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readDsz, writeDsz), EMBFORMAT_NOMAGIC },
+    { ".dxf", "Drawing Exchange Format",            ' ', ' ', EMBFORMAT_OBJECTONLY, EMBFORMAT_RW(readDxf, writeDxf), EMBFORMAT_NOMAGIC },
+    { ".edr", "Embird Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readEdr, writeEdr), EMBFORMAT_NOMAGIC },
+    { ".emd", "Elna Embroidery Format",             'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readEmd, writeEmd), EMBFORMAT_NOMAGIC },
+    { ".exp", "Melco Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY, { readExp, writeExp }, EMBFORMAT_NOMAGIC },
+    { ".exy", "Eltac Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readExy, writeExy), EMBFORMAT_NOMAGIC },
+    { ".eys", "Sierra Expanded Embroidery Format",  ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readEys, writeEys), EMBFORMAT_NOMAGIC },
+    { ".fxy", "Fortron Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readFxy, writeFxy), EMBFORMAT_NOMAGIC },
+    { ".gc",  "Smoothie G-Code Format",             ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readGc, writeGc), EMBFORMAT_NOMAGIC },
+    { ".gnc", "Great Notions Embroidery Format",    ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readGnc, writeGnc), EMBFORMAT_NOMAGIC },
+    { ".gt",  "Gold Thread Embroidery Format",      'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readGt, writeGt), EMBFORMAT_NOMAGIC },
+    { ".hus", "Husqvarna Viking Embroidery Format", 'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readHus, writeHus), { { 0, 4, "\x5B\xAF\xC8\x00" }, { 0, 4, "\x5D\xFC\xC8\x00" } } },
+    { ".inb", "Inbro Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readInb, writeInb), EMBFORMAT_NOMAGIC },
+    { ".inf", "Embroidery Color Format",            'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readInf, writeInf), EMBFORMAT_NOMAGIC },
+    { ".jef", "Janome Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readJef, writeJef), EMBFORMAT_NOMAGIC },
+    { ".ksm", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readKsm, writeKsm), EMBFORMAT_NOMAGIC },
+    { ".max", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readMax, writeMax), EMBFORMAT_NOMAGIC },
+    { ".mit", "Mitsubishi Embroidery Format",       'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readMit, writeMit), EMBFORMAT_NOMAGIC },
+    { ".new", "Ameco Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readNew, writeNew), EMBFORMAT_NOMAGIC },
+    { ".ofm", "Melco Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readOfm, writeOfm), EMBFORMAT_NOMAGIC },
+    { ".pcd", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPcd, writePcd), EMBFORMAT_NOMAGIC },
+    { ".pcm", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPcm, writePcm), EMBFORMAT_NOMAGIC },
+    { ".pcq", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPcq, writePcq), EMBFORMAT_NOMAGIC },
+    { ".pcs", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPcs, writePcs), EMBFORMAT_NOMAGIC },
+    { ".pec", "Brother Embroidery Format",          'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPec, writePec), { { 0, 4, "#PEC" } } },
+    { ".pel", "Brother Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPel, writePel), EMBFORMAT_NOMAGIC },
+    { ".pem", "Brother Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPem, writePem), EMBFORMAT_NOMAGIC },
+    { ".pes", "Brother Embroidery Format",          'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPes, writePes), { { 0, 4, "#PES" } } },
+    { ".phb", "Brother Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPhb, writePhb), { { 0, 4, "#PHB" } } },
+    { ".phc", "Brother Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPhc, writePhc), { { 0, 4, "#PHC" } } },
+    { ".plt", "AutoCAD Plot Drawing Format",        'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readPlt, writePlt), EMBFORMAT_NOMAGIC },
+    { ".rgb", "RGB Embroidery Format",              'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readRgb, writeRgb), EMBFORMAT_NOMAGIC },
+    { ".sew", "Janome Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readSew, writeSew), EMBFORMAT_NOMAGIC },
+    { ".shv", "Husqvarna Viking Embroidery Format", 'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readShv, writeShv), { { 0, 15, "Embroidery disk" } } },
+    { ".sst", "Sunstar Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readSst, writeSst), EMBFORMAT_NOMAGIC },
+    { ".stx", "Data Stitch Embroidery Format",      'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readStx, writeStx), EMBFORMAT_NOMAGIC },
+    { ".svg", "Scalable Vector Graphics",           'U', 'U', EMBFORMAT_OBJECTONLY, EMBFORMAT_RW(readSvg, writeSvg), EMBFORMAT_NOMAGIC },
+    { ".t01", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readT01, writeT01), EMBFORMAT_NOMAGIC },
+    { ".t09", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readT09, writeT09), EMBFORMAT_NOMAGIC },
+    { ".tap", "Happy Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readTap, writeTap), EMBFORMAT_NOMAGIC },
+    { ".thr", "ThredWorks Embroidery Format",       'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readThr, writeThr), EMBFORMAT_NOMAGIC },
+    { ".txt", "Text File",                          ' ', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readTxt, writeTxt), EMBFORMAT_NOMAGIC },
+    { ".u00", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readU00, writeU00), EMBFORMAT_NOMAGIC },
+    { ".u01", "Barudan Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readU01, writeU01), EMBFORMAT_NOMAGIC },
+    { ".vip", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readVip, writeVip), { { 0, 4, "\x5D\xFC\x90\x01" } } },
+    { ".vp3", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readVp3, writeVp3), { { 0, 5, "%vsm%" } } },
+    { ".xxx", "Singer Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readXxx, writeXxx), EMBFORMAT_NOMAGIC },
+    { ".zsk", "ZSK USA Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY, EMBFORMAT_RW(readZsk, writeZsk), EMBFORMAT_NOMAGIC }
+};
+
+#define EMBFORMAT_COUNT ((int)(sizeof(embFormats) / sizeof(embFormats[0])))
+
+static int embFormat_compare(const void* key, const void* format)
+{
+    return strcmp((const char*)key, ((const EmbFormat*)format)->extension);
+}
+
+/*! Returns the number of formats in the format table. */
+int embFormat_count(void)
+{
+    return EMBFORMAT_COUNT;
+}
+
+/*! Returns the format at \a index in the format table, which is sorted by extension, or null if \a index is out of range. */
+const EmbFormat* embFormat_getAt(int index)
+{
+    if(index < 0 || index >= EMBFORMAT_COUNT) return 0;
+    return &embFormats[index];
+}
+
+/*! Returns the format matching the extension of \a fileName, ignoring case, or null if it is not a known format. */
+const EmbFormat* embFormat_fromName(const char* fileName)
+{
+    const char* dot = 0;
+    char ending[2 + EMBFORMAT_MAXEXT];
+    int i = 0;
+
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_fromName(), fileName argument is null\n"); return 0; }
+
+    dot = strrchr(fileName, '.');
+    if(!dot || strlen(dot) > 1 + EMBFORMAT_MAXEXT) return 0;
+    while(dot[i] != '\0')
+    {
+        ending[i] = (char)tolower(dot[i]);
+        ++i;
+    }
+    ending[i] = '\0';
+    return (const EmbFormat*)bsearch(ending, embFormats, EMBFORMAT_COUNT, sizeof(EmbFormat), embFormat_compare);
+}
+
+static int embFormat_matches(const EmbFormat* format, const unsigned char* data, int size)
+{
+    const EmbFormatMagic* magic = 0;
+    int i;
+
+    for(i = 0; i < EMBFORMAT_MAXMAGIC; i++)
+    {
+        magic = &format->magic[i];
+        if(magic->length > 0 && magic->offset + magic->length <= size &&
+           !memcmp(data + magic->offset, magic->bytes, magic->length))
+            return 1;
+    }
+    return 0;
+}
+
+/*! Returns the format whose signature matches the \a size bytes of \a data, which are the start of a file,
+ *  or null if no signature matches. EMBFORMAT_SNIFFSIZE bytes are enough for every signature. */
+const EmbFormat* embFormat_fromData(const unsigned char* data, int size)
+{
+    int i;
+
+    if(!data) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_fromData(), data argument is null\n"); return 0; }
+
+    for(i = 0; i < EMBFORMAT_COUNT; i++)
+    {
+        if(embFormat_matches(&embFormats[i], data, size))
+            return &embFormats[i];
+    }
+    return 0;
+}
+
+/*! Returns the format to read the file with the given \a fileName with.
+ *  The start of the file is checked against the known signatures first, so a file with the wrong extension
+ *  still gets the right format. If no signature matches, or the file cannot be opened, the extension decides.
+ *  Returns null if neither identifies a known format. */
+const EmbFormat* embFormat_fromFile(const char* fileName)
+{
+    const EmbFormat* byName = 0;
+    const EmbFormat* byData = 0;
+    unsigned char data[EMBFORMAT_SNIFFSIZE];
+    FILE* file = 0;
+    int size = 0;
+
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_fromFile(), fileName argument is null\n"); return 0; }
+
+    byName = embFormat_fromName(fileName);
+    /* NOTE: embFile_open() loads the whole file, only the leading bytes are needed here. */
+    file = fopen(fileName, "rb");
+    if(!file)
+        return byName;
+    size = (int)fread(data, 1, EMBFORMAT_SNIFFSIZE, file);
+    fclose(file);
+
+    if(byName && embFormat_matches(byName, data, size))
+        return byName;
+    byData = embFormat_fromData(data, size);
+    return byData ? byData : byName;
+}
+
 /**************************************************/
 /* EmbFormatList                                  */
 /**************************************************/
 
+/*! Returns a pointer to a new EmbFormatList holding a copy of the format table.
+ *  The caller is responsible for freeing it with embFormatList_free(). */
 EmbFormatList* embFormatList_create()
 {
     EmbFormatList* firstFormat = 0;
-
-    /* TODO: This list needs reviewed in case some stitch formats also can contain object data (EMBFORMAT_STCHANDOBJ). */
-
-    EmbFormatList* heapFormatList = (EmbFormatList*)malloc(sizeof(EmbFormatList));
-    if(!heapFormatList) { embLog_error("emb-format.c embFormatList_create(), cannot allocate memory for heapFormatList\n"); return 0; }
-    heapFormatList->extension = ".10o";
-    heapFormatList->description = "Toyota Embroidery Format";
-    heapFormatList->reader = 'U';
-    heapFormatList->writer = ' ';
-    heapFormatList->type = EMBFORMAT_STITCHONLY;
-    heapFormatList->next = 0;
-
-    firstFormat = heapFormatList;
-
-    heapFormatList = embFormatList_add(heapFormatList, ".100", "Toyota Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".art", "Bernina Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".bmc", "Bitmap Cache Embroidery Format",     ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".bro", "Bits & Volts Embroidery Format",     'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".cnd", "Melco Embroidery Format",            ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".col", "Embroidery Thread Color Format",     'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".csd", "Singer Embroidery Format",           'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".csv", "Comma Separated Values Format",      'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dat", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dem", "Melco Embroidery Format",            ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dsb", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dst", "Tajima Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dsz", "ZSK USA Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".dxf", "Drawing Exchange Format",            ' ', ' ', EMBFORMAT_OBJECTONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".edr", "Embird Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".emd", "Elna Embroidery Format",             'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".exp", "Melco Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".exy", "Eltac Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".eys", "Sierra Expanded Embroidery Format",  ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".fxy", "Fortron Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".gc",  "Smoothie G-Code Format",             ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".gnc", "Great Notions Embroidery Format",    ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".gt",  "Gold Thread Embroidery Format",      'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".hus", "Husqvarna Viking Embroidery Format", 'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".inb", "Inbro Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".inf", "Embroidery Color Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".jef", "Janome Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".ksm", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".max", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".mit", "Mitsubishi Embroidery Format",       'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".new", "Ameco Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".ofm", "Melco Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pcd", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pcm", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pcq", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pcs", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pec", "Brother Embroidery Format",          'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pel", "Brother Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pem", "Brother Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".pes", "Brother Embroidery Format",          'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".phb", "Brother Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".phc", "Brother Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".plt", "AutoCAD Plot Drawing Format",        'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".rgb", "RGB Embroidery Format",              'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".sew", "Janome Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".shv", "Husqvarna Viking Embroidery Format", 'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".sst", "Sunstar Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".stx", "Data Stitch Embroidery Format",      'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".svg", "Scalable Vector Graphics",           'U', 'U', EMBFORMAT_OBJECTONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".t01", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".t09", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".tap", "Happy Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".thr", "ThredWorks Embroidery Format",       'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".txt", "Text File",                          ' ', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".u00", "Barudan Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".u01", "Barudan Embroidery Format",          ' ', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".vip", "Pfaff Embroidery Format",            'U', ' ', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".vp3", "Pfaff Embroidery Format",            'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".xxx", "Singer Embroidery Format",           'U', 'U', EMBFORMAT_STITCHONLY);
-    heapFormatList = embFormatList_add(heapFormatList, ".zsk", "ZSK USA Embroidery Format",          'U', ' ', EMBFORMAT_STITCHONLY);
-
+    EmbFormatList* heapFormatList = 0;
+    int i;
+
+    firstFormat = (EmbFormatList*)malloc(sizeof(EmbFormatList));
+    if(!firstFormat) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-format.c embFormatList_create(), cannot allocate memory for heapFormatList\n"); return 0; }
+    firstFormat->extension = (char*)embFormats[0].extension;
+    firstFormat->description = (char*)embFormats[0].description;
+    firstFormat->reader = embFormats[0].reader;
+    firstFormat->writer = embFormats[0].writer;
+    firstFormat->type = embFormats[0].type;
+    firstFormat->next = 0;
+
+    heapFormatList = firstFormat;
+    for(i = 1; heapFormatList && i < EMBFORMAT_COUNT; i++)
+    {
+        heapFormatList = embFormatList_add(heapFormatList, (char*)embFormats[i].extension, (char*)embFormats[i].description,
+                                           embFormats[i].reader, embFormats[i].writer, embFormats[i].type);
+    }
     return firstFormat;
 }
 
 EmbFormatList* embFormatList_add(EmbFormatList* pointer, char* extension, char* description, char reader, char writer, int type)
 {
-    if(!pointer) { embLog_error("emb-format.c embFormatList_add(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormatList_add(), pointer argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-format.c embFormatList_add(), pointer->next should be null\n"); return 0; }
     pointer->next = (EmbFormatList*)malloc(sizeof(EmbFormatList));
-    if(!pointer->next) { embLog_error("emb-format.c embFormatList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-format.c embFormatList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->extension = extension;
     pointer->description = description;
@@ -141,243 +268,90 @@ void embFormatList_free(EmbFormatList* pointer)
 
 const char* embFormat_extension(EmbFormatList* pointer)
 {
-    if(!pointer) { embLog_error("emb-format.c embFormat_extension(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_extension(), pointer argument is null\n"); return 0; }
     return pointer->extension;
 }
 
 const char* embFormat_description(EmbFormatList* pointer)
 {
-    if(!pointer) { embLog_error("emb-format.c embFormat_description(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_description(), pointer argument is null\n"); return 0; }
     return pointer->description;
 }
 
 char embFormat_readerState(EmbFormatList* pointer)
 {
-    if(!pointer) { embLog_error("emb-format.c embFormat_readerState(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_readerState(), pointer argument is null\n"); return 0; }
     return pointer->reader;
 }
 
 char embFormat_writerState(EmbFormatList* pointer)
 {
-    if(!pointer) { embLog_error("emb-format.c embFormat_writerState(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_writerState(), pointer argument is null\n"); return 0; }
     return pointer->writer;
 }
 
 int embFormat_type(EmbFormatList* pointer)
 {
-    if(!pointer) { embLog_error("emb-format.c embFormat_type(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_type(), pointer argument is null\n"); return 0; }
     return pointer->type;
 }
 
 
+/*! Returns the extension of the format matching \a fileName, or null if it is not a known format. */
 const char* embFormat_extensionFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    const char* extension = 0;
-
-    if(!fileName) { embLog_error("emb-format.c embFormat_extensionFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
+    const EmbFormat* format = 0;
 
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            extension = curFormat->extension;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
-
-    embFormatList_free(formatList);
-    formatList = 0;
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_extensionFromName(), fileName argument is null\n"); return 0; }
 
-    return extension;
+    format = embFormat_fromName(fileName);
+    return format ? format->extension : 0;
 }
 
+/*! Returns the description of the format matching \a fileName, or null if it is not a known format. */
 const char* embFormat_descriptionFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    const char* description = 0;
-
-    if(!fileName) { embLog_error("emb-format.c embFormat_descriptionFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            description = curFormat->description;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
+    const EmbFormat* format = 0;
 
-    embFormatList_free(formatList);
-    formatList = 0;
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_descriptionFromName(), fileName argument is null\n"); return 0; }
 
-    return description;
+    format = embFormat_fromName(fileName);
+    return format ? format->description : 0;
 }
 
+/*! Returns the reader state of the format matching \a fileName, ' ' if it is not a known format. */
 char embFormat_readerStateFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    char readerState = ' ';
-
-    if(!fileName) { embLog_error("emb-format.c embFormat_readerStateFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            readerState = curFormat->reader;
-            break;
-        }
+    const EmbFormat* format = 0;
 
-        curFormat = curFormat->next;
-    }
-
-    embFormatList_free(formatList);
-    formatList = 0;
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_readerStateFromName(), fileName argument is null\n"); return 0; }
+    if(!strrchr(fileName, '.')) return 0;
 
-    return readerState;
+    format = embFormat_fromName(fileName);
+    return format ? format->reader : ' ';
 }
 
+/*! Returns the writer state of the format matching \a fileName, ' ' if it is not a known format. */
 char embFormat_writerStateFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    char writerState = ' ';
-
-    if(!fileName) { embLog_error("emb-format.c embFormat_writerStateFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            writerState = curFormat->writer;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
+    const EmbFormat* format = 0;
 
-    embFormatList_free(formatList);
-    formatList = 0;
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_writerStateFromName(), fileName argument is null\n"); return 0; }
+    if(!strrchr(fileName, '.')) return 0;
 
-    return writerState;
+    format = embFormat_fromName(fileName);
+    return format ? format->writer : ' ';
 }
 
+/*! Returns the type of the format matching \a fileName, EMBFORMAT_UNSUPPORTED if it is not a known format. */
 int embFormat_typeFromName(const char* fileName)
 {
-    int i = 0;
-    char ending[2 + EMBFORMAT_MAXEXT];
-    EmbFormatList* formatList = 0;
-    EmbFormatList* curFormat = 0;
-    int type = EMBFORMAT_UNSUPPORTED;
-
-    if(!fileName) { embLog_error("emb-format.c embFormat_typeFromName(), fileName argument is null\n"); return 0; }
-
-    formatList = embFormatList_create();
-
-    if(strlen(fileName) == 0) return 0;
-    if(strrchr(fileName, '.'))
-        strcpy(ending, strrchr(fileName, '.'));
-    else
-        return 0;
-
-    while(ending[i] != '\0')
-    {
-        ending[i] = (char)tolower(ending[i]);
-        ++i;
-    }
-
-    curFormat = formatList;
-    while(curFormat)
-    {
-        if(!strcmp(ending, curFormat->extension))
-        {
-            type = curFormat->type;
-            break;
-        }
-
-        curFormat = curFormat->next;
-    }
+    const EmbFormat* format = 0;
 
-    embFormatList_free(formatList);
-    formatList = 0;
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-format.c embFormat_typeFromName(), fileName argument is null\n"); return 0; }
 
-    return type;
+    format = embFormat_fromName(fileName);
+    return format ? format->type : EMBFORMAT_UNSUPPORTED;
 }
 
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -1,6 +1,8 @@
 #ifndef EMB_FORMAT_H
 #define EMB_FORMAT_H
 
+#include "emb-reader-writer.h"
+
 #include "api-start.h"
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +14,28 @@ extern "C" {
 #define EMBFORMAT_STCHANDOBJ  3 /* binary operation: 1+2=3 */
 
 #define EMBFORMAT_MAXEXT 3  /* maximum length of extension without dot */
+#define EMBFORMAT_MAXMAGIC 2 /* maximum number of signatures per format */
+#define EMBFORMAT_SNIFFSIZE 16 /* number of leading bytes every signature fits in */
+
+/* Bytes that identify a format wherever its file is stored. */
+typedef struct EmbFormatMagic_
+{
+    int offset;
+    int length;         /* 0 if unused */
+    const char* bytes;
+} EmbFormatMagic;
+
+/* One entry of the format table. */
+typedef struct EmbFormat_
+{
+    const char* extension;  /* lowercase, including the dot */
+    const char* description;
+    char reader;            /* 'U' if reading is usable, ' ' if it is not */
+    char writer;            /* 'U' if writing is usable, ' ' if it is not */
+    int type;
+    EmbReaderWriter readerWriter;
+    EmbFormatMagic magic[EMBFORMAT_MAXMAGIC];
+} EmbFormat;
 
 typedef struct EmbFormatList_
 {
@@ -35,6 +59,12 @@ extern EMB_PUBLIC char EMB_CALL embFormat_readerState(EmbFormatList* pointer);
 extern EMB_PUBLIC char EMB_CALL embFormat_writerState(EmbFormatList* pointer);
 extern EMB_PUBLIC int EMB_CALL embFormat_type(EmbFormatList* pointer);
 
+extern EMB_PUBLIC int EMB_CALL embFormat_count(void);
+extern EMB_PUBLIC const EmbFormat* EMB_CALL embFormat_getAt(int index);
+extern EMB_PUBLIC const EmbFormat* EMB_CALL embFormat_fromName(const char* fileName);
+extern EMB_PUBLIC const EmbFormat* EMB_CALL embFormat_fromData(const unsigned char* data, int size);
+extern EMB_PUBLIC const EmbFormat* EMB_CALL embFormat_fromFile(const char* fileName);
+
 extern EMB_PUBLIC const char* EMB_CALL embFormat_extensionFromName(const char* fileName);
 extern EMB_PUBLIC const char* EMB_CALL embFormat_descriptionFromName(const char* fileName);
 extern EMB_PUBLIC char EMB_CALL embFormat_readerStateFromName(const char* fileName);
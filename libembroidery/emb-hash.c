@@ -1,17 +1,304 @@
 #include "emb-hash.h"
+#include "emb-logging.h"
+#include <stdlib.h>
+#include <string.h>
 
-/* This file contains wrapper functions around Keith Pomakis' HashTable Library */
+/* Size of the table of a new map. It doubles whenever it would be more than 7/8 full. */
+#define EMB_HASH_MIN_SLOTS 16
 
-EmbHash* embHash_create(void) { return HashTableCreate(1); }
-void embHash_free(EmbHash* hash) { HashTableDestroy(hash); hash = 0; }
+typedef struct EmbHashSlot_
+{
+    const char* key;    /* the map's own copy, or null for an empty slot */
+    void* value;
+    unsigned long code; /* embHash_code() of key, so probes only compare strings whose codes match */
+} EmbHashSlot;
 
-int embHash_contains(const EmbHash* hash, const void* key) { return HashTableContainsKey(hash, key); }
-int embHash_insert(EmbHash* hash, const void* key, void* value) { return HashTablePut(hash, key, value); }
-void* embHash_value(const EmbHash* hash, const void* key) { return HashTableGet(hash, key); }
-void embHash_remove(EmbHash* hash, const void *key) { HashTableRemove(hash, key); }
-void embHash_clear(EmbHash* hash) { HashTableRemoveAll(hash); }
-int embHash_empty(const EmbHash* hash) { return HashTableIsEmpty(hash); }
-long embHash_count(const EmbHash* hash) { return HashTableSize(hash); }
-void embHash_rehash(EmbHash* hash, long numOfBuckets) { HashTableRehash(hash, numOfBuckets); }
+struct EmbHash_
+{
+    EmbHashSlot* slots;
+    long slotCount;     /* always a power of two */
+    long count;
+    EmbArena* arena;    /* keys are copied here. Created on the first insert if the map owns it. */
+    int ownsArena;
+};
+
+/* FNV-1a. It is called directly rather than through a pointer, so it is inlined into the lookups. */
+static unsigned long embHash_code(const char* key)
+{
+    unsigned long code = 2166136261UL;
+    while(*key)
+        code = ((code ^ (unsigned char)*key++) * 16777619UL) & 0xFFFFFFFFUL;
+    return code;
+}
+
+/* Returns how many slots the entry in \a slot sits past the one its code maps to */
+static long embHash_distance(const EmbHash* hash, long slot)
+{
+    long mask = hash->slotCount - 1;
+    return (slot - (long)(hash->slots[slot].code & (unsigned long)mask)) & mask;
+}
+
+/* Returns the slot holding \a key, whose code is \a code, or -1 if \a hash does not contain it */
+static long embHash_find(const EmbHash* hash, const char* key, unsigned long code)
+{
+    long mask = hash->slotCount - 1;
+    long slot = (long)(code & (unsigned long)mask);
+    long distance = 0;
+
+    while(hash->slots[slot].key)
+    {
+        /* Entries are kept ordered by distance, so one nearer its home than key would be means key is absent */
+        if(embHash_distance(hash, slot) < distance)
+            return -1;
+        if(hash->slots[slot].code == code && !strcmp(hash->slots[slot].key, key))
+            return slot;
+        slot = (slot + 1) & mask;
+        distance++;
+    }
+    return -1;
+}
+
+/* Stores an entry whose key is not in \a hash yet. There must be a free slot. */
+static void embHash_place(EmbHash* hash, const char* key, void* value, unsigned long code)
+{
+    EmbHashSlot entry, swap;
+    long mask = hash->slotCount - 1;
+    long slot = (long)(code & (unsigned long)mask);
+    long distance = 0;
+
+    entry.key = key;
+    entry.value = value;
+    entry.code = code;
+    while(hash->slots[slot].key)
+    {
+        long existing = embHash_distance(hash, slot);
+        if(existing < distance)
+        {
+            /* Robin Hood: the entry further from home takes the slot and the other one moves on */
+            swap = hash->slots[slot];
+            hash->slots[slot] = entry;
+            entry = swap;
+            distance = existing;
+        }
+        slot = (slot + 1) & mask;
+        distance++;
+    }
+    hash->slots[slot] = entry;
+    hash->count++;
+}
+
+/* Moves the entries of \a hash to a new table of \a slotCount slots. Returns \c false if it cannot be allocated. */
+static int embHash_resize(EmbHash* hash, long slotCount)
+{
+    EmbHashSlot* oldSlots = hash->slots;
+    long oldSlotCount = hash->slotCount;
+    long i;
+
+    hash->slots = (EmbHashSlot*)calloc(slotCount, sizeof(EmbHashSlot));
+    if(!hash->slots)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-hash.c embHash_resize(), cannot allocate memory for slots\n");
+        hash->slots = oldSlots;
+        return 0;
+    }
+    hash->slotCount = slotCount;
+    hash->count = 0;
+    for(i = 0; i < oldSlotCount; i++)
+    {
+        if(oldSlots[i].key)
+            embHash_place(hash, oldSlots[i].key, oldSlots[i].value, oldSlots[i].code);
+    }
+    free(oldSlots);
+    return 1;
+}
+
+/* Adds \a key with \a value, or replaces its value if it is already there.
+ * Returns the map's copy of \a key, or null if memory cannot be allocated. */
+static const char* embHash_put(EmbHash* hash, const char* key, void* value, int replace)
+{
+    unsigned long code = embHash_code(key);
+    long slot = embHash_find(hash, key, code);
+    size_t length;
+    char* copy = 0;
+
+    if(slot >= 0)
+    {
+        if(replace)
+            hash->slots[slot].value = value;
+        return hash->slots[slot].key;
+    }
+
+    if((hash->count + 1) * 8 > hash->slotCount * 7 && !embHash_resize(hash, hash->slotCount * 2))
+        return 0;
+    if(!hash->arena)
+    {
+        hash->arena = embArena_create();
+        if(!hash->arena)
+            return 0;
+    }
+    length = strlen(key) + 1;
+    copy = (char*)embArena_alloc(hash->arena, length);
+    if(!copy)
+        return 0;
+    memcpy(copy, key, length);
+    embHash_place(hash, copy, value, code);
+    return copy;
+}
+
+/*! Returns a pointer to a new, empty EmbHash that copies its keys into an arena of its own.
+ *  The caller is responsible for freeing it with embHash_free(). */
+EmbHash* embHash_create(void)
+{
+    EmbHash* hash = (EmbHash*)malloc(sizeof(EmbHash));
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-hash.c embHash_create(), cannot allocate memory for hash\n"); return 0; }
+    hash->slots = (EmbHashSlot*)calloc(EMB_HASH_MIN_SLOTS, sizeof(EmbHashSlot));
+    if(!hash->slots) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-hash.c embHash_create(), cannot allocate memory for slots\n"); free(hash); return 0; }
+    hash->slotCount = EMB_HASH_MIN_SLOTS;
+    hash->count = 0;
+    hash->arena = 0;
+    hash->ownsArena = 1;
+    return hash;
+}
+
+/*! Returns a pointer to a new, empty EmbHash that copies its keys into \a arena, which must outlive it.
+ *  Maps filled while reading one file can share an arena, and their keys are released with it.
+ *  The caller is responsible for freeing it with embHash_free(). */
+EmbHash* embHash_createWithArena(EmbArena* arena)
+{
+    EmbHash* hash = 0;
+
+    if(!arena) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_createWithArena(), arena argument is null\n"); return 0; }
+    hash = embHash_create();
+    if(!hash) return 0;
+    hash->arena = arena;
+    hash->ownsArena = 0;
+    return hash;
+}
+
+/*! Frees \a hash, its table and, unless it was created with embHash_createWithArena(), its keys. */
+void embHash_free(EmbHash* hash)
+{
+    if(!hash) return;
+    if(hash->ownsArena)
+        embArena_free(hash->arena);
+    free(hash->slots);
+    free(hash);
+}
+
+/*! Returns \c true if \a hash contains the string \a key, otherwise returns \c false. */
+int embHash_contains(const EmbHash* hash, const void* key)
+{
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_contains(), hash argument is null\n"); return 0; }
+    if(!key) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_contains(), key argument is null\n"); return 0; }
+    return embHash_find(hash, (const char*)key, embHash_code((const char*)key)) >= 0;
+}
+
+/*! Sets the value of the string \a key in \a hash to \a value, adding a copy of \a key if it is not there yet.
+ *  Returns 0 if successful, otherwise returns -1. */
+int embHash_insert(EmbHash* hash, const void* key, void* value)
+{
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_insert(), hash argument is null\n"); return -1; }
+    if(!key) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_insert(), key argument is null\n"); return -1; }
+    if(!embHash_put(hash, (const char*)key, value, 1))
+    {
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-hash.c embHash_insert(), cannot allocate memory for %s\n", (const char*)key);
+        return -1;
+    }
+    return 0;
+}
+
+/*! Returns the value of the string \a key in \a hash, or null if \a hash does not contain it. */
+void* embHash_value(const EmbHash* hash, const void* key)
+{
+    long slot;
+
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_value(), hash argument is null\n"); return 0; }
+    if(!key) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_value(), key argument is null\n"); return 0; }
+    slot = embHash_find(hash, (const char*)key, embHash_code((const char*)key));
+    if(slot < 0)
+        return 0;
+    return hash->slots[slot].value;
+}
+
+/*! Returns the copy of the string \a key kept by \a hash, adding it with a null value if it is not there yet.
+ *  Equal strings intern to the same pointer, which stays valid until \a hash is cleared or freed
+ *  (or its arena is, for an EmbHash created with embHash_createWithArena()). Returns null if memory cannot be allocated. */
+const char* embHash_intern(EmbHash* hash, const char* key)
+{
+    const char* copy = 0;
+
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_intern(), hash argument is null\n"); return 0; }
+    if(!key) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_intern(), key argument is null\n"); return 0; }
+    copy = embHash_put(hash, key, 0, 0);
+    if(!copy) embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-hash.c embHash_intern(), cannot allocate memory for %s\n", key);
+    return copy;
+}
+
+/*! Removes the string \a key from \a hash, if it is there. The memory of its copy is kept until the arena is freed. */
+void embHash_remove(EmbHash* hash, const void *key)
+{
+    long mask, slot, next;
+
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_remove(), hash argument is null\n"); return; }
+    if(!key) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_remove(), key argument is null\n"); return; }
+    slot = embHash_find(hash, (const char*)key, embHash_code((const char*)key));
+    if(slot < 0)
+        return;
+
+    /* Shift the following entries of the run back by one, which keeps them ordered without tombstones */
+    mask = hash->slotCount - 1;
+    next = (slot + 1) & mask;
+    while(hash->slots[next].key && embHash_distance(hash, next) > 0)
+    {
+        hash->slots[slot] = hash->slots[next];
+        slot = next;
+        next = (next + 1) & mask;
+    }
+    hash->slots[slot].key = 0;
+    hash->slots[slot].value = 0;
+    hash->count--;
+}
+
+/*! Removes every key from \a hash, keeping its table. A map with its own arena also frees the copies of the keys. */
+void embHash_clear(EmbHash* hash)
+{
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_clear(), hash argument is null\n"); return; }
+    memset(hash->slots, 0, sizeof(EmbHashSlot) * hash->slotCount);
+    hash->count = 0;
+    if(hash->ownsArena)
+    {
+        embArena_free(hash->arena);
+        hash->arena = 0;
+    }
+}
+
+/*! Returns \c true if \a hash contains no keys, otherwise returns \c false. */
+int embHash_empty(const EmbHash* hash)
+{
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_empty(), hash argument is null\n"); return 1; }
+    return hash->count == 0;
+}
+
+/*! Returns the number of keys in \a hash. */
+long embHash_count(const EmbHash* hash)
+{
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_count(), hash argument is null\n"); return 0; }
+    return hash->count;
+}
+
+/*! Resizes the table of \a hash to hold at least \a numOfBuckets keys without growing, for example before
+ *  a known number of inserts. The table never gets too small for the keys already in it. */
+void embHash_rehash(EmbHash* hash, long numOfBuckets)
+{
+    long slotCount = EMB_HASH_MIN_SLOTS;
+
+    if(!hash) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-hash.c embHash_rehash(), hash argument is null\n"); return; }
+    if(numOfBuckets < hash->count)
+        numOfBuckets = hash->count;
+    while(slotCount * 7 < numOfBuckets * 8)
+        slotCount *= 2;
+    if(slotCount != hash->slotCount)
+        embHash_resize(hash, slotCount);
+}
 
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -2,22 +2,26 @@
 #ifndef EMB_HASH_H
 #define EMB_HASH_H
 
-/* This file contains wrapper functions around Keith Pomakis' HashTable Library */
-#include "hashtable.h"
+#include "emb-arena.h"
 
 #include "api-start.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef HashTable EmbHash;
+/* A map from null terminated strings to pointers, kept in one flat open addressing table with Robin Hood probing.
+ * Keys are compared by content and copied into an arena when first inserted, so the caller's strings do not have
+ * to outlive the map. Values are neither copied nor freed. */
+typedef struct EmbHash_ EmbHash;
 
 extern EMB_PUBLIC EmbHash* EMB_CALL embHash_create(void);
+extern EMB_PUBLIC EmbHash* EMB_CALL embHash_createWithArena(EmbArena* arena);
 extern EMB_PUBLIC void EMB_CALL embHash_free(EmbHash* hash);
 
 extern EMB_PUBLIC int EMB_CALL embHash_contains(const EmbHash* hash, const void* key);
 extern EMB_PUBLIC int EMB_CALL embHash_insert(EmbHash* hash, const void* key, void* value);
 extern EMB_PUBLIC void* EMB_CALL embHash_value(const EmbHash* hash, const void* key);
+extern EMB_PUBLIC const char* EMB_CALL embHash_intern(EmbHash* hash, const char* key);
 extern EMB_PUBLIC void EMB_CALL embHash_remove(EmbHash* hash, const void *key);
 extern EMB_PUBLIC void EMB_CALL embHash_clear(EmbHash* hash);
 extern EMB_PUBLIC int EMB_CALL embHash_empty(const EmbHash* hash);
@@ -46,7 +46,7 @@ EmbLineObject embLineObject_make(double x1, double y1, double x2, double y2)
 EmbLineObject* embLineObject_create(double x1, double y1, double x2, double y2)
 {
     EmbLineObject* heapLineObj = (EmbLineObject*)malloc(sizeof(EmbLineObject));
-    if(!heapLineObj) { embLog_error("emb-line.c embLineObject_create(), cannot allocate memory for heapLineObj\n"); return 0; }
+    if(!heapLineObj) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-line.c embLineObject_create(), cannot allocate memory for heapLineObj\n"); return 0; }
     heapLineObj->line.x1 = x1;
     heapLineObj->line.y1 = y1;
     heapLineObj->line.x2 = x2;
@@ -61,7 +61,7 @@ EmbLineObject* embLineObject_create(double x1, double y1, double x2, double y2)
 EmbLineObjectList* embLineObjectList_create(EmbLineObject data)
 {
     EmbLineObjectList* heapLineObjList = (EmbLineObjectList*)malloc(sizeof(EmbLineObjectList));
-    if(!heapLineObjList) { embLog_error("emb-line.c embLineObjectList_create(), cannot allocate memory for heapLineObjList\n"); return 0; }
+    if(!heapLineObjList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-line.c embLineObjectList_create(), cannot allocate memory for heapLineObjList\n"); return 0; }
     heapLineObjList->lineObj = data;
     heapLineObjList->next = 0;
     return heapLineObjList;
@@ -69,10 +69,10 @@ EmbLineObjectList* embLineObjectList_create(EmbLineObject data)
 
 EmbLineObjectList* embLineObjectList_add(EmbLineObjectList* pointer, EmbLineObject data)
 {
-    if(!pointer) { embLog_error("emb-line.c embLineObjectList_add(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-line.c embLineObjectList_add(), pointer argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-line.c embLineObjectList_add(), pointer->next should be null\n"); return 0; }
     pointer->next = (EmbLineObjectList*)malloc(sizeof(EmbLineObjectList));
-    if(!pointer->next) { embLog_error("emb-line.c embLineObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-line.c embLineObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->lineObj = data;
     pointer->next = 0;
@@ -117,7 +117,7 @@ void embLineObjectList_free(EmbLineObjectList* pointer)
 void embLine_normalVector(EmbVector vector1, EmbVector vector2, EmbVector* result, int clockwise)
 {
     double temp;
-    if(!result) { embLog_error("emb-line.c embLine_normalVector(), result argument is null\n"); return; }
+    if(!result) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-line.c embLine_normalVector(), result argument is null\n"); return; }
     result->X = vector2.X - vector1.X;
     result->Y = vector2.Y - vector1.Y;
     embVector_normalize(*result, result);
@@ -149,7 +149,7 @@ void embLine_intersectionPoint(EmbVector v1, EmbVector v2, EmbVector v3, EmbVect
 
     double det = A1 * B2 - A2 * B1;
 
-    if(!result) { embLog_error("emb-line.c embLine_intersectionPoint(), result argument is null\n"); return; }
+    if(!result) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-line.c embLine_intersectionPoint(), result argument is null\n"); return; }
     /*TODO: The code below needs revised since division by zero can still occur */
     if(det < 1e-10 && det > -1e-10)
     {
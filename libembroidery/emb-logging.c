@@ -1,13 +1,78 @@
+/* vsnprintf() is C99 and POSIX, so ask for its declaration even when building as strict C89 */
+#if !defined(_XOPEN_SOURCE) && !defined(_WIN32)
+#define _XOPEN_SOURCE 500
+#endif
+
 #include "emb-logging.h"
+#include "emb-worker.h"
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#if defined(_MSC_VER)
+#define vsnprintf _vsnprintf
+#endif
+
+struct EmbLog_
+{
+    EmbLogRecord* records; /* ring of capacity records, the oldest one at first */
+    int capacity;
+    int first;
+    int count;
+    int errorCount; /* every error added since the last embLog_clear(), including ones no longer held */
+    int formatMessages;
+
+    EmbLogCallback callback;
+    void* callbackData;
+
+    EmbFile* file; /* most recently opened file, for the offsets, forgotten when the log is detached */
+    char fileName[EMB_LOG_TEXT_SIZE];
+    char format[EMB_LOG_FORMAT_SIZE];
+};
+
+/* Each thread reports to its own log, so conversions running side by side do not mix their messages */
+static EMB_THREAD_LOCAL EmbLog* embLog_current = 0;
+
+static void embLog_record(EmbLog* log, int code, const char* format, va_list args)
+{
+    EmbLogRecord* record = 0;
+
+    if(log->count < log->capacity)
+    {
+        record = &log->records[(log->first + log->count) % log->capacity];
+        log->count++;
+    }
+    else
+    {
+        /* Full, overwrite the oldest record */
+        record = &log->records[log->first];
+        log->first = (log->first + 1) % log->capacity;
+    }
+    if(code != EMB_LOG_PRINT)
+        log->errorCount++;
+
+    record->code = code;
+    record->source = format;
+    record->offset = log->file ? embFile_tell(log->file) : -1;
+    strcpy(record->format, log->format);
+    strcpy(record->fileName, log->fileName);
+    record->message[0] = '\0';
+    /* NOTE: formatting is the expensive part, so it is skipped unless someone will read the text */
+    if(log->formatMessages || log->callback)
+    {
+        vsnprintf(record->message, EMB_LOG_TEXT_SIZE, format, args);
+        record->message[EMB_LOG_TEXT_SIZE - 1] = '\0';
+    }
+    if(log->callback)
+        log->callback(log->callbackData, record);
+}
 
 /* printf() abstraction. Uses Serial.print() on ARDUINO */
 void embLog_print(const char* format, ...)
 {
-    /* TODO: log debug message in struct for later use */
-
 #ifdef ARDUINO /* ARDUINO */
     char buff[256];
     va_list args;
@@ -18,19 +83,54 @@ void embLog_print(const char* format, ...)
 #else /* ARDUINO */
     va_list args;
     va_start(args, format);
-    vprintf(format, args);
+    if(embLog_current)
+        embLog_record(embLog_current, EMB_LOG_PRINT, format, args);
+    else
+        vprintf(format, args);
     va_end(args);
 #endif /* ARDUINO */
 }
 
-/* serious errors */
+#ifndef ARDUINO
+static void embLog_reportError(int code, const char* format, va_list args)
+{
+    if(embLog_current)
+    {
+        embLog_record(embLog_current, code, format, args);
+    }
+    else
+    {
+        printf("ERROR: ");
+        vprintf(format, args);
+    }
+}
+#endif /* ARDUINO */
+
+/* serious errors, recorded as EMB_LOG_ERROR */
 void embLog_error(const char* format, ...)
 {
-    /* TODO: log debug message in struct for later use */
+#ifdef ARDUINO /* ARDUINO */
+    char buff[256];
+    va_list args;
+    va_start(args, format);
+    vsprintf(buff, format, args);
+    va_end(args);
+    inoLog_serial(strcat("ERROR: ", buff));
+#else /* ARDUINO */
+    va_list args;
+    va_start(args, format);
+    embLog_reportError(EMB_LOG_ERROR, format, args);
+    va_end(args);
+#endif /* ARDUINO */
+}
 
+/* serious errors of a known kind, recorded with \a code, one of the EMB_LOG_ERROR codes */
+void embLog_errorCode(int code, const char* format, ...)
+{
 #ifdef ARDUINO /* ARDUINO */
     char buff[256];
     va_list args;
+    (void)code;
     va_start(args, format);
     vsprintf(buff, format, args);
     va_end(args);
@@ -38,10 +138,130 @@ void embLog_error(const char* format, ...)
 #else /* ARDUINO */
     va_list args;
     va_start(args, format);
-    printf("ERROR: ");
-    vprintf(format, args);
+    embLog_reportError(code == EMB_LOG_PRINT ? EMB_LOG_ERROR : code, format, args);
     va_end(args);
 #endif /* ARDUINO */
 }
 
+/*! Returns a pointer to a new EmbLog that keeps the last \a capacity records reported to it.
+ *  Messages are only formatted into the records if \a formatMessages is \c true or a callback is set.
+ *  The caller is responsible for freeing it with embLog_free(). */
+EmbLog* embLog_create(int capacity, int formatMessages)
+{
+    EmbLog* log = 0;
+
+    if(capacity < 1) capacity = 1;
+    log = (EmbLog*)malloc(sizeof(EmbLog));
+    if(!log) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-logging.c embLog_create(), cannot allocate memory for log\n"); return 0; }
+    log->records = (EmbLogRecord*)malloc(sizeof(EmbLogRecord) * capacity);
+    if(!log->records)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-logging.c embLog_create(), cannot allocate memory for records\n");
+        free(log);
+        return 0;
+    }
+    log->capacity = capacity;
+    log->first = 0;
+    log->count = 0;
+    log->errorCount = 0;
+    log->formatMessages = formatMessages;
+    log->callback = 0;
+    log->callbackData = 0;
+    log->file = 0;
+    log->fileName[0] = '\0';
+    log->format[0] = '\0';
+    return log;
+}
+
+/*! Sets the \a callback that \a log calls with \a userData for every new record. A null \a callback removes it. */
+void embLog_setCallback(EmbLog* log, EmbLogCallback callback, void* userData)
+{
+    if(!log) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-logging.c embLog_setCallback(), log argument is null\n"); return; }
+    log->callback = callback;
+    log->callbackData = userData;
+}
+
+/*! Sends everything the calling thread reports to \a log instead of stdout, until another log is attached.
+ *  A null \a log goes back to stdout. Returns the log that was attached before, so it can be restored. */
+EmbLog* embLog_attach(EmbLog* log)
+{
+    EmbLog* previous = embLog_current;
+    /* NOTE: a file can be closed while the log is detached, so the detached log must not refer to it anymore */
+    if(previous && previous != log)
+    {
+        previous->file = 0;
+        previous->fileName[0] = '\0';
+        previous->format[0] = '\0';
+    }
+    embLog_current = log;
+    return previous;
+}
+
+/*! Returns the number of records \a log holds. */
+int embLog_count(EmbLog* log)
+{
+    if(!log) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-logging.c embLog_count(), log argument is null\n"); return 0; }
+    return log->count;
+}
+
+/*! Returns the number of errors reported to \a log since it was created or cleared, including any no longer held. */
+int embLog_errorCount(EmbLog* log)
+{
+    if(!log) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-logging.c embLog_errorCount(), log argument is null\n"); return 0; }
+    return log->errorCount;
+}
+
+/*! Returns the record at \a index in \a log, 0 being the oldest one still held, or null if \a index is out of range. */
+const EmbLogRecord* embLog_getAt(EmbLog* log, int index)
+{
+    if(!log) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-logging.c embLog_getAt(), log argument is null\n"); return 0; }
+    if(index < 0 || index >= log->count) return 0;
+    return &log->records[(log->first + index) % log->capacity];
+}
+
+/*! Removes every record from \a log. */
+void embLog_clear(EmbLog* log)
+{
+    if(!log) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-logging.c embLog_clear(), log argument is null\n"); return; }
+    log->first = 0;
+    log->count = 0;
+    log->errorCount = 0;
+}
+
+/*! Frees \a log, detaching it from the calling thread. It must not be attached to any other thread. */
+void embLog_free(EmbLog* log)
+{
+    if(!log) return;
+    if(embLog_current == log)
+        embLog_current = 0;
+    free(log->records);
+    free(log);
+}
+
+/* Called by embFile_open() so records can name the file and offset they refer to */
+void embLog_fileOpened(EmbFile* file, const char* fileName)
+{
+    EmbLog* log = embLog_current;
+    const char* extension = 0;
+    int i = 0;
+
+    if(!log) return;
+    log->file = file;
+    strncpy(log->fileName, fileName, EMB_LOG_TEXT_SIZE - 1);
+    log->fileName[EMB_LOG_TEXT_SIZE - 1] = '\0';
+    extension = strrchr(fileName, '.');
+    for(i = 0; extension && extension[i] && i < EMB_LOG_FORMAT_SIZE - 1; i++)
+        log->format[i] = (char)tolower((unsigned char)extension[i]);
+    log->format[i] = '\0';
+}
+
+void embLog_fileClosed(EmbFile* file)
+{
+    EmbLog* log = embLog_current;
+    if(!log || log->file != file) return;
+    log->file = 0;
+    log->fileName[0] = '\0';
+    log->format[0] = '\0';
+}
+
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -2,6 +2,8 @@
 #ifndef EMB_LOGGING_H
 #define EMB_LOGGING_H
 
+#include "emb-file.h"
+
 #include "api-start.h"
 #ifdef __cplusplus
 extern "C" {
@@ -11,8 +13,50 @@ extern "C" {
 #include "utility/ino-logging.h"
 #endif
 
+/* Record codes. Every code other than EMB_LOG_PRINT is an error.
+ * embLog_error() records EMB_LOG_ERROR, embLog_errorCode() records the code it is given. */
+#define EMB_LOG_PRINT             0
+#define EMB_LOG_ERROR             1 /* any error not covered below */
+#define EMB_LOG_ERROR_ARGUMENT    2 /* a required argument is null */
+#define EMB_LOG_ERROR_MEMORY      3 /* memory cannot be allocated */
+#define EMB_LOG_ERROR_OPEN        4 /* a file cannot be opened */
+#define EMB_LOG_ERROR_UNSUPPORTED 5 /* the file format cannot be read or written */
+#define EMB_LOG_ERROR_EMPTY       6 /* the pattern has nothing to write */
+
+#define EMB_LOG_TEXT_SIZE 256
+#define EMB_LOG_FORMAT_SIZE 8
+
+/* One embLog_print(), embLog_error() or embLog_errorCode() call, as kept by an EmbLog. */
+typedef struct EmbLogRecord_
+{
+    int code;           /* EMB_LOG_PRINT or one of the EMB_LOG_ERROR codes */
+    const char* source; /* the printf format string that was reported, which starts with the source file and function */
+    long offset;        /* position in the file being read or written, -1 if there is none */
+    char format[EMB_LOG_FORMAT_SIZE]; /* lowercase extension of the file being read or written, such as ".dst", empty if there is none */
+    char fileName[EMB_LOG_TEXT_SIZE]; /* file being read or written, empty if there is none */
+    char message[EMB_LOG_TEXT_SIZE];  /* the formatted message, empty unless the EmbLog formats messages */
+} EmbLogRecord;
+
+/* Called for every record as it is added to an EmbLog. */
+typedef void (*EmbLogCallback)(void* userData, const EmbLogRecord* record);
+
+typedef struct EmbLog_ EmbLog;
+
 extern EMB_PUBLIC void EMB_CALL embLog_print(const char* format, ...);
 extern EMB_PUBLIC void EMB_CALL embLog_error(const char* format, ...);
+extern EMB_PUBLIC void EMB_CALL embLog_errorCode(int code, const char* format, ...);
+
+extern EMB_PUBLIC EmbLog* EMB_CALL embLog_create(int capacity, int formatMessages);
+extern EMB_PUBLIC void EMB_CALL embLog_setCallback(EmbLog* log, EmbLogCallback callback, void* userData);
+extern EMB_PUBLIC EmbLog* EMB_CALL embLog_attach(EmbLog* log);
+extern EMB_PUBLIC int EMB_CALL embLog_count(EmbLog* log);
+extern EMB_PUBLIC int EMB_CALL embLog_errorCount(EmbLog* log);
+extern EMB_PUBLIC const EmbLogRecord* EMB_CALL embLog_getAt(EmbLog* log, int index);
+extern EMB_PUBLIC void EMB_CALL embLog_clear(EmbLog* log);
+extern EMB_PUBLIC void EMB_CALL embLog_free(EmbLog* log);
+
+extern EMB_PRIVATE void EMB_CALL embLog_fileOpened(EmbFile* file, const char* fileName);
+extern EMB_PRIVATE void EMB_CALL embLog_fileClosed(EmbFile* file);
 
 #ifdef __cplusplus
 }
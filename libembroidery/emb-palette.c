@@ -0,0 +1,304 @@
+#include "emb-palette.h"
+#include "emb-logging.h"
+#include "emb-worker.h"
+#include <math.h>
+#include <stdlib.h>
+
+struct EmbPalette_
+{
+    int count;
+    int metric;
+
+    /* EMB_PALETTE_RGB */
+    int* red;
+    int* green;
+    int* blue;
+
+    /* EMB_PALETTE_LAB */
+    double* lightness;
+    double* labA;
+    double* labB;
+
+    /* Open addressing table from packed RGB values to the index of the last thread with that color, or -1 */
+    long* exactColors;
+    int* exactIndices;
+    int exactMask;
+};
+
+/* Most fixed thread charts embPalette_chart() keeps palettes for */
+#define EMB_PALETTE_MAX_CHARTS 16
+
+typedef struct EmbPaletteChart_
+{
+    const EmbThread* threads;
+    int count;
+    EmbPalette* palette;
+} EmbPaletteChart;
+
+static EmbPaletteChart embPalette_charts[EMB_PALETTE_MAX_CHARTS];
+static int embPalette_chartCount = 0;
+
+static long embPalette_pack(EmbColor color)
+{
+    return ((long)color.r << 16) | ((long)color.g << 8) | (long)color.b;
+}
+
+static int embPalette_slot(long packed, int mask)
+{
+    return (int)((unsigned long)(packed * 2654435761UL) >> 8) & mask;
+}
+
+static double embPalette_linear(unsigned char component)
+{
+    double value = component / 255.0;
+    if(value <= 0.04045)
+        return value / 12.92;
+    return pow((value + 0.055) / 1.055, 2.4);
+}
+
+static double embPalette_labF(double t)
+{
+    if(t > 216.0 / 24389.0)
+        return pow(t, 1.0 / 3.0);
+    return (24389.0 / 27.0 * t + 16.0) / 116.0;
+}
+
+/* Converts \a color from sRGB to CIELAB under the D65 white point */
+static void embPalette_toLab(EmbColor color, double* lightness, double* a, double* b)
+{
+    double red = embPalette_linear(color.r);
+    double green = embPalette_linear(color.g);
+    double blue = embPalette_linear(color.b);
+    double fx = embPalette_labF((0.4124564 * red + 0.3575761 * green + 0.1804375 * blue) / 0.95047);
+    double fy = embPalette_labF( 0.2126729 * red + 0.7151522 * green + 0.0721750 * blue);
+    double fz = embPalette_labF((0.0193339 * red + 0.1191920 * green + 0.9503041 * blue) / 1.08883);
+
+    *lightness = 116.0 * fy - 16.0;
+    *a = 500.0 * (fx - fy);
+    *b = 200.0 * (fy - fz);
+}
+
+/*! Returns a pointer to a new EmbPalette holding the \a count threads of \a threads, compared with \a metric
+ *  (EMB_PALETTE_RGB or EMB_PALETTE_LAB). Only the colors are kept, so \a threads may be freed afterwards.
+ *  The caller is responsible for freeing it with embPalette_free(). */
+EmbPalette* embPalette_create(const EmbThread* threads, int count, int metric)
+{
+    EmbPalette* palette = 0;
+    int tableSize = 4;
+    int i;
+
+    if(!threads && count > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-palette.c embPalette_create(), threads argument is null\n"); return 0; }
+    if(count < 0) { embLog_error("emb-palette.c embPalette_create(), count argument is negative\n"); return 0; }
+    if(metric != EMB_PALETTE_RGB && metric != EMB_PALETTE_LAB) { embLog_error("emb-palette.c embPalette_create(), unknown metric %d\n", metric); return 0; }
+
+    palette = (EmbPalette*)calloc(1, sizeof(EmbPalette));
+    if(!palette) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-palette.c embPalette_create(), cannot allocate memory for palette\n"); return 0; }
+    palette->count = count;
+    palette->metric = metric;
+
+    while(tableSize < count * 2)
+        tableSize *= 2;
+    palette->exactMask = tableSize - 1;
+    palette->exactColors = (long*)malloc(sizeof(long) * tableSize);
+    palette->exactIndices = (int*)malloc(sizeof(int) * tableSize);
+    if(metric == EMB_PALETTE_RGB)
+    {
+        palette->red = (int*)malloc(sizeof(int) * (count + 1));
+        palette->green = (int*)malloc(sizeof(int) * (count + 1));
+        palette->blue = (int*)malloc(sizeof(int) * (count + 1));
+    }
+    else
+    {
+        palette->lightness = (double*)malloc(sizeof(double) * (count + 1));
+        palette->labA = (double*)malloc(sizeof(double) * (count + 1));
+        palette->labB = (double*)malloc(sizeof(double) * (count + 1));
+    }
+    if(!palette->exactColors || !palette->exactIndices ||
+       (metric == EMB_PALETTE_RGB && (!palette->red || !palette->green || !palette->blue)) ||
+       (metric == EMB_PALETTE_LAB && (!palette->lightness || !palette->labA || !palette->labB)))
+    {
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-palette.c embPalette_create(), cannot allocate memory for palette tables\n");
+        embPalette_free(palette);
+        return 0;
+    }
+
+    for(i = 0; i < tableSize; i++)
+        palette->exactColors[i] = -1;
+
+    for(i = 0; i < count; i++)
+    {
+        EmbColor color = threads[i].color;
+        long packed = embPalette_pack(color);
+        int slot = embPalette_slot(packed, palette->exactMask);
+
+        if(metric == EMB_PALETTE_RGB)
+        {
+            palette->red[i] = color.r;
+            palette->green[i] = color.g;
+            palette->blue[i] = color.b;
+        }
+        else
+        {
+            embPalette_toLab(color, &palette->lightness[i], &palette->labA[i], &palette->labB[i]);
+        }
+
+        /* A later thread of the same color replaces an earlier one, as ties go to the last thread */
+        while(palette->exactColors[slot] != -1 && palette->exactColors[slot] != packed)
+            slot = (slot + 1) & palette->exactMask;
+        palette->exactColors[slot] = packed;
+        palette->exactIndices[slot] = i;
+    }
+    return palette;
+}
+
+/*! Returns the number of threads in \a palette. */
+int embPalette_count(EmbPalette* palette)
+{
+    if(!palette) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-palette.c embPalette_count(), palette argument is null\n"); return 0; }
+    return palette->count;
+}
+
+/*! Returns the index of the thread in \a palette closest to \a color, or -1 if \a palette is empty.
+ *  When several threads are equally close, the last of them is returned, as in embThread_findNearestColorInArray(). */
+int embPalette_nearest(EmbPalette* palette, EmbColor color)
+{
+    long packed = 0;
+    int slot = 0;
+    int closestIndex = -1;
+    int i;
+
+    if(!palette) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-palette.c embPalette_nearest(), palette argument is null\n"); return -1; }
+
+    packed = embPalette_pack(color);
+    slot = embPalette_slot(packed, palette->exactMask);
+    while(palette->exactColors[slot] != -1)
+    {
+        if(palette->exactColors[slot] == packed)
+            return palette->exactIndices[slot];
+        slot = (slot + 1) & palette->exactMask;
+    }
+
+    if(palette->metric == EMB_PALETTE_RGB)
+    {
+        /* Squared distances order the threads the same as distances, and are exact in integers */
+        const int* red = palette->red;
+        const int* green = palette->green;
+        const int* blue = palette->blue;
+        int r = color.r, g = color.g, b = color.b;
+        long closest = 3L * 255 * 255 + 1;
+
+        for(i = 0; i < palette->count; i++)
+        {
+            int dr = r - red[i];
+            int dg = g - green[i];
+            int db = b - blue[i];
+            long distance = (long)dr * dr + (long)dg * dg + (long)db * db;
+            if(distance <= closest)
+            {
+                closest = distance;
+                closestIndex = i;
+            }
+        }
+    }
+    else
+    {
+        const double* lightness = palette->lightness;
+        const double* labA = palette->labA;
+        const double* labB = palette->labB;
+        double l, a, b;
+        double closest = 0.0;
+
+        embPalette_toLab(color, &l, &a, &b);
+        for(i = 0; i < palette->count; i++)
+        {
+            double dl = l - lightness[i];
+            double da = a - labA[i];
+            double db = b - labB[i];
+            double distance = dl * dl + da * da + db * db;
+            if(closestIndex < 0 || distance <= closest)
+            {
+                closest = distance;
+                closestIndex = i;
+            }
+        }
+    }
+    return closestIndex;
+}
+
+/*! Matches each thread of \a threads against \a palette, writing the index of the closest thread to \a indices
+ *  in list order. At most \a maxCount indices are written. Returns the number of indices written. */
+int embPalette_nearestList(EmbPalette* palette, EmbThreadList* threads, int* indices, int maxCount)
+{
+    int count = 0;
+
+    if(!palette) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-palette.c embPalette_nearestList(), palette argument is null\n"); return 0; }
+    if(!indices && maxCount > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-palette.c embPalette_nearestList(), indices argument is null\n"); return 0; }
+
+    while(threads && count < maxCount)
+    {
+        indices[count++] = embPalette_nearest(palette, threads->thread.color);
+        threads = threads->next;
+    }
+    return count;
+}
+
+/*! Frees \a palette and its tables. */
+void embPalette_free(EmbPalette* palette)
+{
+    if(!palette) return;
+    free(palette->red);
+    free(palette->green);
+    free(palette->blue);
+    free(palette->lightness);
+    free(palette->labA);
+    free(palette->labB);
+    free(palette->exactColors);
+    free(palette->exactIndices);
+    free(palette);
+}
+
+/*! Returns the EMB_PALETTE_RGB palette of the fixed thread chart of \a count \a threads, such as the thread table of
+ *  a file format. It is built the first time the chart is asked for and shared from then on, by every thread.
+ *  The library owns it, so it must not be freed. Returns null if it cannot be built. */
+EmbPalette* embPalette_chart(const EmbThread* threads, int count)
+{
+    EmbPalette* palette = 0;
+    EmbMutex* mutex = embMutex_global();
+    int i;
+
+    if(!threads) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-palette.c embPalette_chart(), threads argument is null\n"); return 0; }
+    embMutex_lock(mutex);
+    for(i = 0; i < embPalette_chartCount; i++)
+    {
+        if(embPalette_charts[i].threads == threads && embPalette_charts[i].count == count)
+        {
+            palette = embPalette_charts[i].palette;
+            break;
+        }
+    }
+    if(!palette && embPalette_chartCount < EMB_PALETTE_MAX_CHARTS)
+    {
+        palette = embPalette_create(threads, count, EMB_PALETTE_RGB);
+        if(palette)
+        {
+            embPalette_charts[embPalette_chartCount].threads = threads;
+            embPalette_charts[embPalette_chartCount].count = count;
+            embPalette_charts[embPalette_chartCount].palette = palette;
+            embPalette_chartCount++;
+        }
+    }
+    embMutex_unlock(mutex);
+    return palette;
+}
+
+/*! Returns the index of the thread of the fixed thread chart of \a count \a threads that is closest to \a color.
+ *  The result is that of embThread_findNearestColorInArray(), found through the shared palette of embPalette_chart(). */
+int embPalette_nearestInChart(const EmbThread* threads, int count, EmbColor color)
+{
+    EmbPalette* palette = embPalette_chart(threads, count);
+    if(!palette)
+        return embThread_findNearestColorInArray(color, (EmbThread*)threads, count);
+    return embPalette_nearest(palette, color);
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -0,0 +1,37 @@
+/*! @file emb-palette.h */
+#ifndef EMB_PALETTE_H
+#define EMB_PALETTE_H
+
+#include "emb-color.h"
+#include "emb-thread.h"
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Metrics an EmbPalette can match colors with */
+#define EMB_PALETTE_RGB 0 /* Euclidean distance of the RGB components, as embThread_findNearestColor() */
+#define EMB_PALETTE_LAB 1 /* CIE76 delta E, the Euclidean distance in CIELAB, which follows perceived differences more closely */
+
+/* A thread chart prepared for repeated nearest color lookups. The components are kept in one array each
+ * so the distance loop runs over contiguous memory, and colors in the chart are found with a single hash probe. */
+typedef struct EmbPalette_ EmbPalette;
+
+extern EMB_PUBLIC EmbPalette* EMB_CALL embPalette_create(const EmbThread* threads, int count, int metric);
+extern EMB_PUBLIC int EMB_CALL embPalette_count(EmbPalette* palette);
+extern EMB_PUBLIC int EMB_CALL embPalette_nearest(EmbPalette* palette, EmbColor color);
+extern EMB_PUBLIC int EMB_CALL embPalette_nearestList(EmbPalette* palette, EmbThreadList* threads, int* indices, int maxCount);
+extern EMB_PUBLIC void EMB_CALL embPalette_free(EmbPalette* palette);
+
+extern EMB_PUBLIC EmbPalette* EMB_CALL embPalette_chart(const EmbThread* threads, int count);
+extern EMB_PUBLIC int EMB_CALL embPalette_nearestInChart(const EmbThread* threads, int count, EmbColor color);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_PALETTE_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
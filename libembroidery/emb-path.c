@@ -1,4 +1,5 @@
 #include "emb-path.h"
+#include "emb-arena.h"
 #include "emb-logging.h"
 #include <stdlib.h>
 
@@ -9,10 +10,10 @@
 EmbPathObject* embPathObject_create(EmbPointList* pointList, EmbFlagList* flagList, EmbColor color, int lineType)
 {
     EmbPathObject* heapPathObj = 0;
-    if(!pointList) { embLog_error("emb-path.c embPathObject_create(), pointList argument is null\n"); return 0; }
-    if(!flagList) { embLog_error("emb-path.c embPathObject_create(), flagList argument is null\n"); return 0; }
-    heapPathObj = (EmbPathObject*)malloc(sizeof(EmbPathObject));
-    if(!heapPathObj) { embLog_error("emb-path.c embPathObject_create(), cannot allocate memory for heapPathObj\n"); return 0; }
+    if(!pointList) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-path.c embPathObject_create(), pointList argument is null\n"); return 0; }
+    if(!flagList) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-path.c embPathObject_create(), flagList argument is null\n"); return 0; }
+    heapPathObj = (EmbPathObject*)embArena_malloc(sizeof(EmbPathObject));
+    if(!heapPathObj) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-path.c embPathObject_create(), cannot allocate memory for heapPathObj\n"); return 0; }
     heapPathObj->pointList = pointList;
     heapPathObj->flagList = flagList;
     /* TODO: layer */
@@ -27,7 +28,7 @@ void embPathObject_free(EmbPathObject* pointer)
     pointer->pointList = 0;
     embFlagList_free(pointer->flagList);
     pointer->flagList = 0;
-    free(pointer);
+    embArena_release(pointer);
     pointer = 0;
 }
 
@@ -38,9 +39,9 @@ void embPathObject_free(EmbPathObject* pointer)
 EmbPathObjectList* embPathObjectList_create(EmbPathObject* data)
 {
     EmbPathObjectList* heapPathObjList = 0;
-    if(!data) { embLog_error("emb-path.c embPathObjectList_create(), data argument is null\n"); return 0; }
-    heapPathObjList = (EmbPathObjectList*)malloc(sizeof(EmbPathObjectList));
-    if(!heapPathObjList) { embLog_error("emb-path.c embPathObjectList_create(), cannot allocate memory for heapPathObjList\n"); return 0; }
+    if(!data) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-path.c embPathObjectList_create(), data argument is null\n"); return 0; }
+    heapPathObjList = (EmbPathObjectList*)embArena_malloc(sizeof(EmbPathObjectList));
+    if(!heapPathObjList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-path.c embPathObjectList_create(), cannot allocate memory for heapPathObjList\n"); return 0; }
     heapPathObjList->pathObj = data;
     heapPathObjList->next = 0;
     return heapPathObjList;
@@ -48,11 +49,11 @@ EmbPathObjectList* embPathObjectList_create(EmbPathObject* data)
 
 EmbPathObjectList* embPathObjectList_add(EmbPathObjectList* pointer, EmbPathObject* data)
 {
-    if(!pointer) { embLog_error("emb-path.c embPathObjectList_add(), pointer argument is null\n"); return 0; }
-    if(!data) { embLog_error("emb-path.c embPathObjectList_add(), data argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-path.c embPathObjectList_add(), pointer argument is null\n"); return 0; }
+    if(!data) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-path.c embPathObjectList_add(), data argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-path.c embPathObjectList_add(), pointer->next should be null\n"); return 0; }
-    pointer->next = (EmbPathObjectList*)malloc(sizeof(EmbPathObjectList));
-    if(!pointer->next) { embLog_error("emb-path.c embPathObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    pointer->next = (EmbPathObjectList*)embArena_malloc(sizeof(EmbPathObjectList));
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-path.c embPathObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->pathObj = data;
     pointer->next = 0;
@@ -87,7 +88,7 @@ void embPathObjectList_free(EmbPathObjectList* pointer)
         nextPointer = tempPointer->next;
         embPathObject_free(tempPointer->pathObj);
         tempPointer->pathObj = 0;
-        free(tempPointer);
+        embArena_release(tempPointer);
         tempPointer = nextPointer;
     }
     pointer = 0;
@@ -1,7 +1,10 @@
 #include "emb-pattern.h"
+#include "emb-format.h"
 #include "emb-reader-writer.h"
 #include "emb-settings.h"
+#include "emb-spatial-index.h"
 #include "emb-logging.h"
+#include "emb-worker.h"
 #include "helpers-misc.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,15 +16,261 @@
 #include "utility/ino-event.h"
 #endif
 
+/* Points the stitchList/lastStitch iterators of pattern (\a p) back into its stitchArray. Must be called after the array changes. */
+static void embPattern_syncStitchList(EmbPattern* p)
+{
+    p->stitchList = embStitchArray_first(&(p->stitchArray));
+    p->lastStitch = embStitchArray_last(&(p->stitchArray));
+}
+
+/* Empties the stats of pattern (\a p), so the next embPattern_countStitches() call counts every stitch again. */
+static void embPattern_resetStats(EmbPattern* p)
+{
+    p->stats.stitchCount = 0;
+    p->stats.realCount = 0;
+    p->stats.jumpCount = 0;
+    p->stats.trimCount = 0;
+    p->stats.colorChangeCount = 0;
+    p->stats.moveCount = 0;
+    p->stats.threadLength = 0.0;
+    p->stats.bounds.left = 99999.0;
+    p->stats.bounds.top = 99999.0;
+    p->stats.bounds.right = -99999.0;
+    p->stats.bounds.bottom = -99999.0;
+    p->statsCount = 0;
+}
+
+/* Adds the stitches of pattern (\a p) that its stats do not cover yet. Stitches are only ever appended
+ * between transforms, so keeping the stats up to date costs O(1) per stitch. */
+static void embPattern_countStitches(EmbPattern* p)
+{
+    EmbPatternStats* stats = &(p->stats);
+    EmbStitchList* stitches = p->stitchArray.stitches;
+    int i, count = embStitchArray_count(&(p->stitchArray));
+
+    /* NOTE: stitches were removed without embPattern_invalidate(), so start over */
+    if(count < p->statsCount)
+        embPattern_resetStats(p);
+    for(i = p->statsCount; i < count; i++)
+    {
+        EmbStitch st = stitches[i].stitch;
+        stats->stitchCount++;
+        if(st.flags & JUMP) stats->jumpCount++;
+        if(st.flags & TRIM) stats->trimCount++;
+        if(st.flags & STOP) stats->colorChangeCount++;
+        if(st.flags & (JUMP | TRIM | STOP)) stats->moveCount++;
+        if(!(st.flags & (JUMP | TRIM)))
+        {
+            stats->realCount++;
+            if(i > 0)
+            {
+                double dx = st.xx - stitches[i - 1].stitch.xx;
+                double dy = st.yy - stitches[i - 1].stitch.yy;
+                stats->threadLength += sqrt(dx * dx + dy * dy);
+            }
+        }
+        if(!(st.flags & TRIM))
+        {
+            stats->bounds.left = (double)min(stats->bounds.left, st.xx);
+            stats->bounds.top = (double)min(stats->bounds.top, st.yy);
+            stats->bounds.right = (double)max(stats->bounds.right, st.xx);
+            stats->bounds.bottom = (double)max(stats->bounds.bottom, st.yy);
+        }
+    }
+    p->statsCount = count;
+}
+
+/* Number of stitches a pattern with a stitch callback buffers before handing them off. */
+#define EMB_STITCH_STREAM_WINDOW 256
+
+/* Hands the buffered stitches of pattern (\a p) to its stitch callback, keeping the last (\a keep) of them so readers can still inspect lastStitch. */
+static void embPattern_deliverStitches(EmbPattern* p, int keep)
+{
+    EmbStitchList* stitches = p->stitchArray.stitches;
+    int i, count = embStitchArray_count(&(p->stitchArray));
+
+    if(!p->stitchCallback || count <= keep)
+        return;
+    /* NOTE: the stats outlive the stitches, so streamed patterns still report totals for the whole design */
+    embPattern_countStitches(p);
+    for(i = 0; i < count - keep; i++)
+    {
+        p->streamedMaxColorIndex = max(p->streamedMaxColorIndex, stitches[i].stitch.color);
+        p->stitchCallback(p->stitchCallbackData, stitches[i].stitch);
+    }
+    for(i = 0; i < keep; i++)
+    {
+        stitches[i].stitch = stitches[count - keep + i].stitch;
+    }
+    embStitchArray_truncate(&(p->stitchArray), keep);
+    embPattern_syncStitchList(p);
+    p->statsCount = keep;
+    embPattern_freeSpatialIndex(p);
+}
+
+/* Number of stitches each task of a stitch transform covers. Transforms of patterns with no more stitches than this run on the calling thread,
+ * as do transforms called from an embWorker task, such as a writer in a batch conversion. */
+#define EMB_PATTERN_CHUNK 65536
+
+/* Shared by the tasks of one stitch transform. Task (index) covers the stitches from index * EMB_PATTERN_CHUNK up to the next chunk. */
+typedef struct EmbPatternKernel_
+{
+    EmbStitchList* stitches;
+    int count;
+    double scale;           /* embPattern_scale() */
+    int horz;               /* embPattern_flip() */
+    int vert;
+    double length;          /* embPattern_hideStitchesOverLength() */
+    double maxStitchLength; /* embPattern_correctForMaxStitchLength() */
+    double maxJumpLength;
+    int* offsets;           /* number of output stitches of each chunk, then where each chunk starts in output */
+    EmbStitchList* output;
+} EmbPatternKernel;
+
+/* Returns the number of chunks the stitches of (\a kernel) are split into. */
+static int embPattern_chunkCount(const EmbPatternKernel* kernel)
+{
+    return (kernel->count + EMB_PATTERN_CHUNK - 1) / EMB_PATTERN_CHUNK;
+}
+
+/* Stores the range of stitches task (\a index) of (\a kernel) covers in (\a start) and (\a end). */
+static void embPattern_chunkRange(const EmbPatternKernel* kernel, int index, int* start, int* end)
+{
+    *start = index * EMB_PATTERN_CHUNK;
+    *end = min(*start + EMB_PATTERN_CHUNK, kernel->count);
+}
+
+static void embPattern_scaleTask(void* userData, int index)
+{
+    EmbPatternKernel* kernel = (EmbPatternKernel*)userData;
+    EmbStitchList* stitches = kernel->stitches;
+    double scale = kernel->scale;
+    int i, start, end;
+
+    embPattern_chunkRange(kernel, index, &start, &end);
+    for(i = start; i < end; i++)
+    {
+        stitches[i].stitch.xx *= scale;
+        stitches[i].stitch.yy *= scale;
+    }
+}
+
+static void embPattern_flipTask(void* userData, int index)
+{
+    EmbPatternKernel* kernel = (EmbPatternKernel*)userData;
+    EmbStitchList* stitches = kernel->stitches;
+    int i, start, end;
+
+    embPattern_chunkRange(kernel, index, &start, &end);
+    for(i = start; i < end; i++)
+    {
+        if(kernel->horz) { stitches[i].stitch.xx = -stitches[i].stitch.xx; }
+        if(kernel->vert) { stitches[i].stitch.yy = -stitches[i].stitch.yy; }
+    }
+}
+
+/* NOTE: only the flags change, so the stitch before a chunk can be read while another task works on it */
+static void embPattern_hideTask(void* userData, int index)
+{
+    EmbPatternKernel* kernel = (EmbPatternKernel*)userData;
+    EmbStitchList* stitches = kernel->stitches;
+    double prevX = 0;
+    double prevY = 0;
+    int i, start, end;
+
+    embPattern_chunkRange(kernel, index, &start, &end);
+    if(start > 0)
+    {
+        prevX = stitches[start - 1].stitch.xx;
+        prevY = stitches[start - 1].stitch.yy;
+    }
+    for(i = start; i < end; i++)
+    {
+        EmbStitch* st = &(stitches[i].stitch);
+        if((fabs(st->xx - prevX) > kernel->length) || (fabs(st->yy - prevY) > kernel->length))
+        {
+            st->flags |= TRIM;
+            st->flags &= ~NORMAL;
+        }
+        prevX = st->xx;
+        prevY = st->yy;
+    }
+}
+
+/* Returns the number of pieces embPattern_correctForMaxStitchLength() splits the stitch at (\a index) of (\a kernel) into,
+ * which is 1 if it is left as it is, and stores the offset from one piece to the next in (\a addX) and (\a addY). */
+static int embPattern_splitCount(const EmbPatternKernel* kernel, int index, double* addX, double* addY)
+{
+    EmbStitch current = kernel->stitches[index].stitch;
+    double dx = current.xx - kernel->stitches[index - 1].stitch.xx;
+    double dy = current.yy - kernel->stitches[index - 1].stitch.yy;
+    double maxXY, maxLen;
+    int splits;
+
+    if((fabs(dx) <= kernel->maxStitchLength) && (fabs(dy) <= kernel->maxStitchLength))
+        return 1;
+
+    maxXY = max(fabs(dx), fabs(dy));
+    if(current.flags & (JUMP | TRIM)) maxLen = kernel->maxJumpLength;
+    else maxLen = kernel->maxStitchLength;
+
+    splits = (int)ceil((double)maxXY / maxLen);
+    if(splits <= 1)
+        return 1;
+    *addX = (double)dx / splits;
+    *addY = (double)dy / splits;
+    return splits;
+}
+
+static void embPattern_countSplitsTask(void* userData, int index)
+{
+    EmbPatternKernel* kernel = (EmbPatternKernel*)userData;
+    double addX, addY;
+    int i, start, end, total = 0;
+
+    embPattern_chunkRange(kernel, index, &start, &end);
+    for(i = start; i < end; i++)
+    {
+        total += (i == 0) ? 1 : embPattern_splitCount(kernel, i, &addX, &addY);
+    }
+    kernel->offsets[index] = total;
+}
+
+static void embPattern_scatterSplitsTask(void* userData, int index)
+{
+    EmbPatternKernel* kernel = (EmbPatternKernel*)userData;
+    EmbStitchList* output = kernel->output + kernel->offsets[index];
+    double addX, addY;
+    int i, j, splits, start, end;
+
+    embPattern_chunkRange(kernel, index, &start, &end);
+    for(i = start; i < end; i++)
+    {
+        EmbStitch current = kernel->stitches[i].stitch;
+        splits = (i == 0) ? 1 : embPattern_splitCount(kernel, i, &addX, &addY);
+        for(j = 1; j < splits; j++)
+        {
+            EmbStitch s;
+            s.xx = kernel->stitches[i - 1].stitch.xx + addX * j;
+            s.yy = kernel->stitches[i - 1].stitch.yy + addY * j;
+            s.flags = current.flags;
+            s.color = current.color;
+            (output++)->stitch = s;
+        }
+        (output++)->stitch = current;
+    }
+}
+
 /*! Returns a pointer to an EmbPattern. It is created on the heap. The caller is responsible for freeing the allocated memory with embPattern_free(). */
 EmbPattern* embPattern_create(void)
 {
     EmbPattern* p = 0;
     p = (EmbPattern*)malloc(sizeof(EmbPattern));
-    if(!p) { embLog_error("emb-pattern.c embPattern_create(), unable to allocate memory for p\n"); return 0; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-pattern.c embPattern_create(), unable to allocate memory for p\n"); return 0; }
 
     p->settings = embSettings_init();
     p->currentColorIndex = 0;
+    embStitchArray_init(&(p->stitchArray));
     p->stitchList = 0;
     p->threadList = 0;
 
@@ -55,33 +304,166 @@ EmbPattern* embPattern_create(void)
     p->lastX = 0.0;
     p->lastY = 0.0;
 
+    p->stitchCallback = 0;
+    p->stitchCallbackData = 0;
+    p->streamedMaxColorIndex = 0;
+    p->arena = 0;
+    p->log = 0;
+    p->spatialIndex = 0;
+    embPattern_resetStats(p);
+
     return p;
 }
 
-void embPattern_hideStitchesOverLength(EmbPattern* p, int length)
+/* Returns a copy of the point list (\a pointer), or null if it is empty or memory runs out. */
+static EmbPointList* embPattern_copyPointList(EmbPointList* pointer)
 {
-    double prevX = 0;
-    double prevY = 0;
-    EmbStitchList* pointer = 0;
+    EmbPointList* first = 0;
+    EmbPointList* last = 0;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_hideStitchesOverLength(), p argument is null\n"); return; }
-    pointer = p->stitchList;
-    while(pointer)
+    if(!pointer) return 0;
+    first = last = embPointList_create(pointer->point.xx, pointer->point.yy);
+    for(pointer = pointer->next; last && pointer; pointer = pointer->next)
     {
-        if((fabs(pointer->stitch.xx - prevX) > length) || (fabs(pointer->stitch.yy - prevY) > length))
-        {
-            pointer->stitch.flags |= TRIM;
-            pointer->stitch.flags &= ~NORMAL;
-        }
-        prevX = pointer->stitch.xx;
-        prevY = pointer->stitch.yy;
-        pointer = pointer->next;
+        last = embPointList_add(last, pointer->point);
+    }
+    if(!last) { embPointList_free(first); return 0; }
+    return first;
+}
+
+/* Returns a copy of the flag list (\a pointer), or null if it is empty or memory runs out. */
+static EmbFlagList* embPattern_copyFlagList(EmbFlagList* pointer)
+{
+    EmbFlagList* first = 0;
+    EmbFlagList* last = 0;
+
+    if(!pointer) return 0;
+    first = last = embFlagList_create(pointer->flag);
+    for(pointer = pointer->next; last && pointer; pointer = pointer->next)
+    {
+        last = embFlagList_add(last, pointer->flag);
+    }
+    if(!last) { embFlagList_free(first); return 0; }
+    return first;
+}
+
+/*! Returns a pointer to a new EmbPattern holding a copy of the settings, hoop, stitches, threads and objects of
+ *  pattern (\a p), so it can be changed, by a writer for example, while (\a p) stays as it is. The copy gets an arena
+ *  of its own if (\a p) has one and reports to the same log. Stitch callbacks and splines are not copied.
+ *  The caller is responsible for freeing it with embPattern_free(). Returns null if memory runs out. */
+EmbPattern* embPattern_copy(EmbPattern* p)
+{
+    EmbPattern* copy = 0;
+    EmbArena* previousArena = 0;
+    EmbThreadList* thread = 0;
+    EmbArcObjectList* arc = 0;
+    EmbCircleObjectList* circle = 0;
+    EmbEllipseObjectList* ellipse = 0;
+    EmbLineObjectList* line = 0;
+    EmbPathObjectList* path = 0;
+    EmbPointObjectList* point = 0;
+    EmbPolygonObjectList* polygon = 0;
+    EmbPolylineObjectList* polyline = 0;
+    EmbRectObjectList* rect = 0;
+    int i, count;
+
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_copy(), p argument is null\n"); return 0; }
+    copy = embPattern_create();
+    if(!copy) return 0;
+    copy->settings = p->settings;
+    copy->hoop = p->hoop;
+    copy->currentColorIndex = p->currentColorIndex;
+    copy->lastX = p->lastX;
+    copy->lastY = p->lastY;
+    copy->log = p->log;
+    if(p->arena && !embPattern_useArena(copy)) { embPattern_free(copy); return 0; }
+
+    count = embStitchArray_count(&(p->stitchArray));
+    if(!embStitchArray_resize(&(copy->stitchArray), count)) { embPattern_free(copy); return 0; }
+    for(i = 0; i < count; i++)
+    {
+        copy->stitchArray.stitches[i].stitch = p->stitchArray.stitches[i].stitch;
+    }
+    embPattern_syncStitchList(copy);
+
+    for(thread = p->threadList; thread; thread = thread->next)
+    {
+        embPattern_addThread(copy, thread->thread);
+    }
+
+    previousArena = embArena_attach(copy->arena);
+    for(arc = p->arcObjList; arc; arc = arc->next)
+    {
+        if(!copy->arcObjList) copy->arcObjList = copy->lastArcObj = embArcObjectList_create(arc->arcObj);
+        else copy->lastArcObj = embArcObjectList_add(copy->lastArcObj, arc->arcObj);
+    }
+    for(circle = p->circleObjList; circle; circle = circle->next)
+    {
+        if(!copy->circleObjList) copy->circleObjList = copy->lastCircleObj = embCircleObjectList_create(circle->circleObj);
+        else copy->lastCircleObj = embCircleObjectList_add(copy->lastCircleObj, circle->circleObj);
+    }
+    for(ellipse = p->ellipseObjList; ellipse; ellipse = ellipse->next)
+    {
+        if(!copy->ellipseObjList) copy->ellipseObjList = copy->lastEllipseObj = embEllipseObjectList_create(ellipse->ellipseObj);
+        else copy->lastEllipseObj = embEllipseObjectList_add(copy->lastEllipseObj, ellipse->ellipseObj);
     }
+    for(line = p->lineObjList; line; line = line->next)
+    {
+        if(!copy->lineObjList) copy->lineObjList = copy->lastLineObj = embLineObjectList_create(line->lineObj);
+        else copy->lastLineObj = embLineObjectList_add(copy->lastLineObj, line->lineObj);
+    }
+    for(point = p->pointObjList; point; point = point->next)
+    {
+        if(!copy->pointObjList) copy->pointObjList = copy->lastPointObj = embPointObjectList_create(point->pointObj);
+        else copy->lastPointObj = embPointObjectList_add(copy->lastPointObj, point->pointObj);
+    }
+    for(rect = p->rectObjList; rect; rect = rect->next)
+    {
+        if(!copy->rectObjList) copy->rectObjList = copy->lastRectObj = embRectObjectList_create(rect->rectObj);
+        else copy->lastRectObj = embRectObjectList_add(copy->lastRectObj, rect->rectObj);
+    }
+    for(path = p->pathObjList; path; path = path->next)
+    {
+        EmbPathObject* obj = path->pathObj;
+        embPattern_addPathObjectAbs(copy, embPathObject_create(embPattern_copyPointList(obj->pointList), embPattern_copyFlagList(obj->flagList), obj->color, obj->lineType));
+    }
+    for(polygon = p->polygonObjList; polygon; polygon = polygon->next)
+    {
+        EmbPolygonObject* obj = polygon->polygonObj;
+        embPattern_addPolygonObjectAbs(copy, embPolygonObject_create(embPattern_copyPointList(obj->pointList), obj->color, obj->lineType));
+    }
+    for(polyline = p->polylineObjList; polyline; polyline = polyline->next)
+    {
+        EmbPolylineObject* obj = polyline->polylineObj;
+        embPattern_addPolylineObjectAbs(copy, embPolylineObject_create(embPattern_copyPointList(obj->pointList), obj->color, obj->lineType));
+    }
+    embArena_attach(previousArena);
+    return copy;
+}
+
+/*! Returns the number of stitches in pattern (\a p), including the HOME stitch. */
+int embPattern_stitchCount(EmbPattern* p)
+{
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_stitchCount(), p argument is null\n"); return 0; }
+    return embStitchArray_count(&(p->stitchArray));
+}
+
+/*! Trims each stitch of pattern (\a p) that moves further than (\a length) along either axis. Large patterns are processed in parallel. */
+void embPattern_hideStitchesOverLength(EmbPattern* p, int length)
+{
+    EmbPatternKernel kernel;
+
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_hideStitchesOverLength(), p argument is null\n"); return; }
+    embPattern_invalidate(p);
+    kernel.stitches = p->stitchArray.stitches;
+    kernel.count = p->stitchArray.count;
+    kernel.length = length;
+    embWorker_run(embPattern_chunkCount(&kernel), 0, embPattern_hideTask, &kernel);
 }
 
 int embPattern_addThread(EmbPattern* p, EmbThread thread)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_addThread(), p argument is null\n"); return 0; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addThread(), p argument is null\n"); return 0; }
     if(embThreadList_empty(p->threadList))
     {
         p->threadList = p->lastThread = embThreadList_create(thread);
@@ -97,14 +479,16 @@ void embPattern_fixColorCount(EmbPattern* p)
 {
     /* fix color count to be max of color index. */
     int maxColorIndex = 0;
-    EmbStitchList* list = 0;
-
-    if(!p) { embLog_error("emb-pattern.c embPattern_fixColorCount(), p argument is null\n"); return; }
-    list = p->stitchList;
-    while(list)
+    EmbStitchList* stitches = 0;
+    int i, count;
+
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_fixColorCount(), p argument is null\n"); return; }
+    maxColorIndex = p->streamedMaxColorIndex;
+    stitches = p->stitchArray.stitches;
+    count = p->stitchArray.count;
+    for(i = 0; i < count; i++)
     {
-        maxColorIndex = max(maxColorIndex, list->stitch.color);
-        list = list->next;
+        maxColorIndex = max(maxColorIndex, stitches[i].stitch.color);
     }
 #ifndef ARDUINO
     /* ARDUINO TODO: The while loop below never ends because memory cannot be allocated in the addThread
@@ -126,10 +510,12 @@ void embPattern_fixColorCount(EmbPattern* p)
 /*! Copies all of the EmbStitchList data to EmbPolylineObjectList data for pattern (\a p). */
 void embPattern_copyStitchListToPolylines(EmbPattern* p)
 {
+    EmbArena* previousArena = 0;
     EmbStitchList* stList = 0;
     int breakAtFlags;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_copyStitchListToPolylines(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_copyStitchListToPolylines(), p argument is null\n"); return; }
+    previousArena = embArena_attach(p->arena);
 
 #ifdef EMB_DEBUG_JUMP
     breakAtFlags = (STOP | TRIM);
@@ -167,8 +553,13 @@ void embPattern_copyStitchListToPolylines(EmbPattern* p)
         /* NOTE: Ensure empty polylines are not created. This is critical. */
         if(pointList)
         {
-            EmbPolylineObject* currentPolyline = (EmbPolylineObject*)malloc(sizeof(EmbPolylineObject));
-            if(!currentPolyline) { embLog_error("emb-pattern.c embPattern_copyStitchListToPolylines(), cannot allocate memory for currentPolyline\n"); return; }
+            EmbPolylineObject* currentPolyline = (EmbPolylineObject*)embArena_malloc(sizeof(EmbPolylineObject));
+            if(!currentPolyline)
+            {
+                embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-pattern.c embPattern_copyStitchListToPolylines(), cannot allocate memory for currentPolyline\n");
+                embArena_attach(previousArena);
+                return;
+            }
             currentPolyline->pointList = pointList;
             currentPolyline->color = color;
             currentPolyline->lineType = 1; /* TODO: Determine what the correct value should be */
@@ -187,6 +578,7 @@ void embPattern_copyStitchListToPolylines(EmbPattern* p)
             stList = stList->next;
         }
     }
+    embArena_attach(previousArena);
 }
 
 /*! Copies all of the EmbPolylineObjectList data to EmbStitchList data for pattern (\a p). */
@@ -196,7 +588,7 @@ void embPattern_copyPolylinesToStitchList(EmbPattern* p)
     int firstObject = 1;
     /*int currentColor = polyList->polylineObj->color TODO: polyline color */
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_copyPolylinesToStitchList(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_copyPolylinesToStitchList(), p argument is null\n"); return; }
     polyList = p->polylineObjList;
     while(polyList)
     {
@@ -235,12 +627,12 @@ void embPattern_copyPolylinesToStitchList(EmbPattern* p)
 /*! Moves all of the EmbStitchList data to EmbPolylineObjectList data for pattern (\a p). */
 void embPattern_moveStitchListToPolylines(EmbPattern* p)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_moveStitchListToPolylines(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_moveStitchListToPolylines(), p argument is null\n"); return; }
     embPattern_copyStitchListToPolylines(p);
     /* Free the stitchList and threadList since their data has now been transferred to polylines */
-    embStitchList_free(p->stitchList);
-    p->stitchList = 0;
-    p->lastStitch = 0;
+    embStitchArray_free(&(p->stitchArray));
+    embPattern_syncStitchList(p);
+    embPattern_invalidate(p);
     embThreadList_free(p->threadList);
     p->threadList = 0;
     p->lastThread = 0;
@@ -249,11 +641,16 @@ void embPattern_moveStitchListToPolylines(EmbPattern* p)
 /*! Moves all of the EmbPolylineObjectList data to EmbStitchList data for pattern (\a p). */
 void embPattern_movePolylinesToStitchList(EmbPattern* p)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_movePolylinesToStitchList(), p argument is null\n"); return; }
+    EmbArena* previousArena = 0;
+
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_movePolylinesToStitchList(), p argument is null\n"); return; }
     embPattern_copyPolylinesToStitchList(p);
+    previousArena = embArena_attach(p->arena);
     embPolylineObjectList_free(p->polylineObjList);
+    embArena_attach(previousArena);
     p->polylineObjList = 0;
     p->lastPolylineObj = 0;
+    embPattern_invalidate(p);
 }
 
 /*! Adds a stitch to the pattern (\a p) at the absolute position (\a x,\a y). Positive y is up. Units are in millimeters. */
@@ -261,11 +658,11 @@ void embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int i
 {
     EmbStitch s;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_addStitchAbs(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addStitchAbs(), p argument is null\n"); return; }
 
     if(flags & END)
     {
-        if(embStitchList_empty(p->stitchList))
+        if(embStitchArray_count(&(p->stitchArray)) == 0)
             return;
         /* Prevent unnecessary multiple END stitches */
         if(p->lastStitch->stitch.flags & END)
@@ -281,14 +678,14 @@ void embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int i
 
     if(flags & STOP)
     {
-        if(embStitchList_empty(p->stitchList))
+        if(embStitchArray_count(&(p->stitchArray)) == 0)
             return;
         if(isAutoColorIndex)
             p->currentColorIndex++;
     }
 
     /* NOTE: If the stitchList is empty, we will create it before adding stitches to it. The first coordinate will be the HOME position. */
-    if(embStitchList_empty(p->stitchList))
+    if(embStitchArray_count(&(p->stitchArray)) == 0)
     {
         /* NOTE: Always HOME the machine before starting any stitching */
         EmbPoint home = embSettings_home(&(p->settings));
@@ -297,7 +694,13 @@ void embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int i
         h.yy = home.yy;
         h.flags = JUMP;
         h.color = p->currentColorIndex;
-        p->stitchList = p->lastStitch = embStitchList_create(h);
+        embStitchArray_append(&(p->stitchArray), h);
+        embPattern_syncStitchList(p);
+    }
+
+    if(p->stitchCallback && embStitchArray_count(&(p->stitchArray)) >= EMB_STITCH_STREAM_WINDOW)
+    {
+        embPattern_deliverStitches(p, 1);
     }
 
     s.xx = x;
@@ -307,7 +710,9 @@ void embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int i
 #ifdef ARDUINO
     inoEvent_addStitchAbs(p, s.xx, s.yy, s.flags, s.color);
 #else /* ARDUINO */
-    p->lastStitch = embStitchList_add(p->lastStitch, s);
+    embStitchArray_append(&(p->stitchArray), s);
+    embPattern_syncStitchList(p);
+    embPattern_countStitches(p);
 #endif /* ARDUINO */
     p->lastX = s.xx;
     p->lastY = s.yy;
@@ -318,15 +723,15 @@ void embPattern_addStitchRel(EmbPattern* p, double dx, double dy, int flags, int
 {
     double x,y;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_addStitchRel(), p argument is null\n"); return; }
-    if(!embStitchList_empty(p->stitchList))
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addStitchRel(), p argument is null\n"); return; }
+    if(embStitchArray_count(&(p->stitchArray)) > 0)
     {
         x = p->lastX + dx;
         y = p->lastY + dy;
     }
     else
     {
-        /* NOTE: The stitchList is empty, so add it to the HOME position. The embStitchList_create function will ensure the first coordinate is at the HOME position. */
+        /* NOTE: The stitchList is empty, so add it to the HOME position. The embPattern_addStitchAbs function will ensure the first coordinate is at the HOME position. */
         EmbPoint home = embSettings_home(&(p->settings));
         x = home.xx + dx;
         y = home.yy + dy;
@@ -336,68 +741,107 @@ void embPattern_addStitchRel(EmbPattern* p, double dx, double dy, int flags, int
 
 void embPattern_changeColor(EmbPattern* p, int index)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_changeColor(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_changeColor(), p argument is null\n"); return; }
     p->currentColorIndex = index;
 }
 
+/*! Streams the stitches of pattern (\a p) to \a callback as they are added, passing \a userData along with each stitch.
+ *  Only a small window of recent stitches stays in the pattern, so memory use does not grow with the design.
+ *  Call embPattern_flushStitches() once the reader is done to hand off the rest. Passing a null \a callback stops streaming. */
+void embPattern_setStitchCallback(EmbPattern* p, EmbStitchCallback callback, void* userData)
+{
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_setStitchCallback(), p argument is null\n"); return; }
+    p->stitchCallback = callback;
+    p->stitchCallbackData = userData;
+}
+
+/*! Hands every stitch still buffered in pattern (\a p) to its stitch callback and empties the stitch list. */
+void embPattern_flushStitches(EmbPattern* p)
+{
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_flushStitches(), p argument is null\n"); return; }
+    embPattern_deliverStitches(p, 0);
+}
+
 /*! Reads a file with the given \a fileName and loads the data into \a pattern.
+ *  The format is chosen by embFormat_fromFile(), so a file with the wrong extension is still read correctly.
+ *  Errors are reported to the EmbLog of \a pattern, if it has one, and objects are allocated from its arena, if it has one.
  *  Returns \c true if successful, otherwise returns \c false. */
 int embPattern_read(EmbPattern* pattern, const char* fileName) /* TODO: Write test case using this convenience function. */
 {
-    EmbReaderWriter* reader = 0;
+    const EmbFormat* format = 0;
+    EmbLog* previousLog = 0;
+    EmbArena* previousArena = 0;
     int result = 0;
 
-    if(!pattern) { embLog_error("emb-pattern.c embPattern_read(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("emb-pattern.c embPattern_read(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_read(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_read(), fileName argument is null\n"); return 0; }
 
-    reader = embReaderWriter_getByFileName(fileName);
-    if(!reader) { embLog_error("emb-pattern.c embPattern_read(), unsupported read file type: %s\n", fileName); return 0; }
-    result = reader->reader(pattern, fileName);
-    free(reader);
-    reader = 0;
+    if(pattern->log)
+        previousLog = embLog_attach(pattern->log);
+    previousArena = embArena_attach(pattern->arena);
+    format = embFormat_fromFile(fileName);
+    if(!format || !format->readerWriter.reader)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_UNSUPPORTED, "emb-pattern.c embPattern_read(), unsupported read file type: %s\n", fileName);
+    }
+    else
+    {
+        result = format->readerWriter.reader(pattern, fileName);
+    }
+    embArena_attach(previousArena);
+    if(pattern->log)
+        embLog_attach(previousLog);
     return result;
 }
 
 /*! Writes the data from \a pattern to a file with the given \a fileName.
+ *  Errors are reported to the EmbLog of \a pattern, if it has one.
  *  Returns \c true if successful, otherwise returns \c false. */
 int embPattern_write(EmbPattern* pattern, const char* fileName) /* TODO: Write test case using this convenience function. */
 {
-    EmbReaderWriter* writer = 0;
+    const EmbFormat* format = 0;
+    EmbLog* previousLog = 0;
     int result = 0;
 
-    if(!pattern) { embLog_error("emb-pattern.c embPattern_write(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("emb-pattern.c embPattern_write(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_write(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_write(), fileName argument is null\n"); return 0; }
 
-    writer = embReaderWriter_getByFileName(fileName);
-    if(!writer) { embLog_error("emb-pattern.c embPattern_write(), unsupported write file type: %s\n", fileName); return 0; }
-    result = writer->writer(pattern, fileName);
-    free(writer);
-    writer = 0;
+    if(pattern->log)
+        previousLog = embLog_attach(pattern->log);
+    format = embFormat_fromName(fileName);
+    if(!format || !format->readerWriter.writer)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_UNSUPPORTED, "emb-pattern.c embPattern_write(), unsupported write file type: %s\n", fileName);
+    }
+    else
+    {
+        result = format->readerWriter.writer(pattern, fileName);
+    }
+    if(pattern->log)
+        embLog_attach(previousLog);
     return result;
 }
 
 /* Very simple scaling of the x and y axis for every point.
-* Doesn't insert or delete stitches to preserve density. */
+* Doesn't insert or delete stitches to preserve density.
+* Large patterns are processed in parallel. */
 void embPattern_scale(EmbPattern* p, double scale)
 {
-    EmbStitchList* pointer = 0;
-
-    if(!p) { embLog_error("emb-pattern.c embPattern_scale(), p argument is null\n"); return; }
-    pointer = p->stitchList;
-    while(pointer)
-    {
-        pointer->stitch.xx *= scale;
-        pointer->stitch.yy *= scale;
-        pointer = pointer->next;
-    }
+    EmbPatternKernel kernel;
+
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_scale(), p argument is null\n"); return; }
+    embPattern_invalidate(p);
+    kernel.stitches = p->stitchArray.stitches;
+    kernel.count = p->stitchArray.count;
+    kernel.scale = scale;
+    embWorker_run(embPattern_chunkCount(&kernel), 0, embPattern_scaleTask, &kernel);
 }
 
 /*! Returns an EmbRect that encapsulates all stitches and objects in the pattern (\a p). */
 EmbRect embPattern_calcBoundingBox(EmbPattern* p)
 {
-    EmbStitchList* pointer = 0;
+    EmbPatternStats stats;
     EmbRect boundingRect;
-    EmbStitch pt;
     EmbArcObjectList* aObjList = 0;
     EmbArc arc;
     EmbCircleObjectList* cObjList = 0;
@@ -424,12 +868,13 @@ EmbRect embPattern_calcBoundingBox(EmbPattern* p)
     boundingRect.top = 0;
     boundingRect.bottom = 0;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_calcBoundingBox(), p argument is null\n"); return boundingRect; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_calcBoundingBox(), p argument is null\n"); return boundingRect; }
 
     /* Calculate the bounding rectangle.  It's needed for smart repainting. */
     /* TODO: Come back and optimize this mess so that after going thru all objects
             and stitches, if the rectangle isn't reasonable, then return a default rect */
-    if(embStitchList_empty(p->stitchList) &&
+    stats = embPattern_stats(p);
+    if(stats.stitchCount == 0 &&
     embArcObjectList_empty(p->arcObjList) &&
     embCircleObjectList_empty(p->circleObjList) &&
     embEllipseObjectList_empty(p->ellipseObjList) &&
@@ -446,26 +891,8 @@ EmbRect embPattern_calcBoundingBox(EmbPattern* p)
         boundingRect.right = 1.0;
         return boundingRect;
     }
-    boundingRect.left = 99999.0;
-    boundingRect.top =  99999.0;
-    boundingRect.right = -99999.0;
-    boundingRect.bottom = -99999.0;
-
-    pointer = p->stitchList;
-    while(pointer)
-    {
-        /* If the point lies outside of the accumulated bounding
-        * rectangle, then inflate the bounding rect to include it. */
-        pt = pointer->stitch;
-        if(!(pt.flags & TRIM))
-        {
-            boundingRect.left = (double)min(boundingRect.left, pt.xx);
-            boundingRect.top = (double)min(boundingRect.top, pt.yy);
-            boundingRect.right = (double)max(boundingRect.right, pt.xx);
-            boundingRect.bottom = (double)max(boundingRect.bottom, pt.yy);
-        }
-        pointer = pointer->next;
-    }
+    /* NOTE: the stitch extents are kept up to date as stitches are added, so only the objects are walked here */
+    boundingRect = stats.bounds;
 
     aObjList = p->arcObjList;
     while(aObjList)
@@ -567,14 +994,14 @@ EmbRect embPattern_calcBoundingBox(EmbPattern* p)
 /*! Flips the entire pattern (\a p) horizontally about the y-axis. */
 void embPattern_flipHorizontal(EmbPattern* p)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_flipHorizontal(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_flipHorizontal(), p argument is null\n"); return; }
     embPattern_flip(p, 1, 0);
 }
 
 /*! Flips the entire pattern (\a p) vertically about the x-axis. */
 void embPattern_flipVertical(EmbPattern* p)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_flipVertical(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_flipVertical(), p argument is null\n"); return; }
     embPattern_flip(p, 0, 1);
 }
 
@@ -582,7 +1009,7 @@ void embPattern_flipVertical(EmbPattern* p)
  *  Flips the entire pattern (\a p) vertically about the y-axis if (\a vert) is true. */
 void embPattern_flip(EmbPattern* p, int horz, int vert)
 {
-    EmbStitchList* stList = 0;
+    EmbPatternKernel kernel;
     EmbArcObjectList* aObjList = 0;
     EmbCircleObjectList* cObjList = 0;
     EmbEllipseObjectList* eObjList = 0;
@@ -597,15 +1024,14 @@ void embPattern_flip(EmbPattern* p, int horz, int vert)
     EmbRectObjectList* rObjList = 0;
     EmbSplineObjectList* sObjList = 0;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_flip(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_flip(), p argument is null\n"); return; }
+    embPattern_invalidate(p);
 
-    stList = p->stitchList;
-    while(stList)
-    {
-        if(horz) { stList->stitch.xx = -stList->stitch.xx; }
-        if(vert) { stList->stitch.yy = -stList->stitch.yy; }
-        stList = stList->next;
-    }
+    kernel.stitches = p->stitchArray.stitches;
+    kernel.count = p->stitchArray.count;
+    kernel.horz = horz;
+    kernel.vert = vert;
+    embWorker_run(embPattern_chunkCount(&kernel), 0, embPattern_flipTask, &kernel);
 
     aObjList = p->arcObjList;
     while(aObjList)
@@ -717,104 +1143,103 @@ void embPattern_flip(EmbPattern* p, int horz, int vert)
     }
 }
 
+/*! Collapses each run of JUMP stitches in pattern (\a p) into a single JUMP to the stitch that follows the run. */
 void embPattern_combineJumpStitches(EmbPattern* p)
 {
-    EmbStitchList* pointer = 0;
+    EmbStitchList* stitches = 0;
+    int i, count;
+    int kept = 0;
     int jumpCount = 0;
-    EmbStitchList* jumpListStart = 0;
+    double jumpX = 0.0, jumpY = 0.0;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_combineJumpStitches(), p argument is null\n"); return; }
-    pointer = p->stitchList;
-    while(pointer)
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_combineJumpStitches(), p argument is null\n"); return; }
+    embPattern_invalidate(p);
+    stitches = p->stitchArray.stitches;
+    count = p->stitchArray.count;
+    for(i = 0; i < count; i++)
     {
-        if(pointer->stitch.flags & JUMP)
+        EmbStitch st = stitches[i].stitch;
+        if(st.flags & JUMP)
         {
             if(jumpCount == 0)
             {
-                jumpListStart = pointer;
+                stitches[kept++].stitch = st;
             }
+            jumpX = st.xx;
+            jumpY = st.yy;
             jumpCount++;
         }
         else
         {
             if(jumpCount > 0)
             {
-                EmbStitchList* removePointer = jumpListStart->next;
-                jumpListStart->stitch.xx = pointer->stitch.xx;
-                jumpListStart->stitch.yy = pointer->stitch.yy;
-                jumpListStart->next = pointer;
-
-                for(; jumpCount > 0; jumpCount--)
-                {
-                    EmbStitchList* tempPointer = removePointer->next;
-                    free(removePointer);
-                    removePointer = tempPointer;
-                }
+                /* The first jump of the run moves straight to this stitch */
+                stitches[kept - 1].stitch.xx = st.xx;
+                stitches[kept - 1].stitch.yy = st.yy;
                 jumpCount = 0;
             }
+            stitches[kept++].stitch = st;
         }
-        pointer = pointer->next;
     }
+    if(jumpCount > 1)
+    {
+        /* A run of jumps at the very end has no stitch after it, so it moves to where the last jump went */
+        stitches[kept - 1].stitch.xx = jumpX;
+        stitches[kept - 1].stitch.yy = jumpY;
+    }
+    embStitchArray_truncate(&(p->stitchArray), kept);
+    embPattern_syncStitchList(p);
 }
 
 /*TODO: The params determine the max XY movement rather than the length. They need renamed or clarified further. */
+/*! Splits each stitch of pattern (\a p) that moves further than (\a maxStitchLength) along either axis into evenly spaced
+ *  stitches no longer than (\a maxStitchLength), or (\a maxJumpLength) for JUMP and TRIM stitches, then ends the pattern with END.
+ *  Large patterns are processed in parallel: each chunk of stitches counts its output, a prefix sum over the counts places
+ *  the chunks in the corrected stitches, and each chunk then writes its own stitches there. */
 void embPattern_correctForMaxStitchLength(EmbPattern* p, double maxStitchLength, double maxJumpLength)
 {
-    int j = 0, splits;
-    double maxXY, maxLen, addX, addY;
+    int i, count, chunkCount, total;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_correctForMaxStitchLength(), p argument is null\n"); return; }
-    if(embStitchList_count(p->stitchList) > 1)
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_correctForMaxStitchLength(), p argument is null\n"); return; }
+    embPattern_invalidate(p);
+    count = embStitchArray_count(&(p->stitchArray));
+    if(count > 1)
     {
-        EmbStitchList* pointer = 0;
-        EmbStitchList* prev = 0;
-        prev = p->stitchList;
-        pointer = prev->next;
-
-        while(pointer)
+        EmbPatternKernel kernel;
+        EmbStitchArray corrected;
+
+        kernel.stitches = p->stitchArray.stitches;
+        kernel.count = count;
+        kernel.maxStitchLength = maxStitchLength;
+        kernel.maxJumpLength = maxJumpLength;
+        chunkCount = embPattern_chunkCount(&kernel);
+        kernel.offsets = (int*)malloc(sizeof(int) * chunkCount);
+        if(!kernel.offsets) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-pattern.c embPattern_correctForMaxStitchLength(), cannot allocate memory for offsets\n"); return; }
+        embWorker_run(chunkCount, 0, embPattern_countSplitsTask, &kernel);
+
+        total = 0;
+        for(i = 0; i < chunkCount; i++)
         {
-            double xx = prev->stitch.xx;
-            double yy = prev->stitch.yy;
-            double dx = pointer->stitch.xx - xx;
-            double dy = pointer->stitch.yy - yy;
-            if((fabs(dx) > maxStitchLength) || (fabs(dy) > maxStitchLength))
-            {
-                maxXY = max(fabs(dx), fabs(dy));
-                if(pointer->stitch.flags & (JUMP | TRIM)) maxLen = maxJumpLength;
-                else maxLen = maxStitchLength;
-
-                splits = (int)ceil((double)maxXY / maxLen);
+            int chunkTotal = kernel.offsets[i];
+            kernel.offsets[i] = total;
+            total += chunkTotal;
+        }
 
-                if(splits > 1)
-                {
-                    int flagsToUse = pointer->stitch.flags;
-                    int colorToUse = pointer->stitch.color;
-                    addX = (double)dx / splits;
-                    addY = (double)dy / splits;
-
-                    for(j = 1; j < splits; j++)
-                    {
-                        EmbStitchList* item = 0;
-                        EmbStitch s;
-                        s.xx = xx + addX * j;
-                        s.yy = yy + addY * j;
-                        s.flags = flagsToUse;
-                        s.color = colorToUse;
-                        item = (EmbStitchList*)malloc(sizeof(EmbStitchList));
-                        if(!item) { embLog_error("emb-pattern.c embPattern_correctForMaxStitchLength(), cannot allocate memory for item\n"); return; }
-                        item->stitch = s;
-                        item->next = pointer;
-                        prev->next = item;
-                        prev = item;
-                    }
-                }
-            }
-            prev = pointer;
-            if(pointer)
-            {
-                pointer = pointer->next;
-            }
+        /* NOTE: The split stitches are written to a new array so the existing stitches never have to be shifted */
+        embStitchArray_init(&corrected);
+        if(!embStitchArray_resize(&corrected, total))
+        {
+            embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-pattern.c embPattern_correctForMaxStitchLength(), cannot allocate memory for corrected\n");
+            free(kernel.offsets);
+            return;
         }
+        kernel.output = corrected.stitches;
+        embWorker_run(chunkCount, 0, embPattern_scatterSplitsTask, &kernel);
+        free(kernel.offsets);
+
+        embStitchArray_free(&(p->stitchArray));
+        p->stitchArray = corrected;
+        embPattern_syncStitchList(p);
     }
     if(p->lastStitch && p->lastStitch->stitch.flags != END)
     {
@@ -829,7 +1254,8 @@ void embPattern_center(EmbPattern* p)
     EmbRect boundingRect;
     EmbStitchList* pointer = 0;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_center(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_center(), p argument is null\n"); return; }
+    embPattern_invalidate(p);
     boundingRect = embPattern_calcBoundingBox(p);
 
     moveLeft = (int)(boundingRect.left - (embRect_width(boundingRect) / 2.0));
@@ -857,11 +1283,11 @@ void embPattern_loadExternalColorFile(EmbPattern* p, const char* fileName)
     const char* dotPos = strrchr(fileName, '.');
     char* extractName = 0;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_loadExternalColorFile(), p argument is null\n"); return; }
-    if(!fileName) { embLog_error("emb-pattern.c embPattern_loadExternalColorFile(), fileName argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_loadExternalColorFile(), p argument is null\n"); return; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_loadExternalColorFile(), fileName argument is null\n"); return; }
 
     extractName = (char*)malloc(dotPos - fileName + 5);
-    if(!extractName) { embLog_error("emb-pattern.c embPattern_loadExternalColorFile(), cannot allocate memory for extractName\n"); return; }
+    if(!extractName) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-pattern.c embPattern_loadExternalColorFile(), cannot allocate memory for extractName\n"); return; }
     extractName = (char*)memcpy(extractName, fileName, dotPos - fileName);
     extractName[dotPos - fileName] = '\0';
     strcat(extractName,".edr");
@@ -915,11 +1341,68 @@ void embPattern_loadExternalColorFile(EmbPattern* p, const char* fileName)
     extractName = 0;
 }
 
+/*! Returns the spatial index of pattern (\a p), building it on first use. Stitches and objects appended later are
+ *  picked up by its next query. Functions of pattern (\a p) that move or remove stitches or objects free it, and so must
+ *  any other code that does, with embPattern_invalidate(). Returns null if it cannot be allocated. */
+EmbSpatialIndex* embPattern_spatialIndex(EmbPattern* p)
+{
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_spatialIndex(), p argument is null\n"); return 0; }
+    if(!p->spatialIndex)
+        p->spatialIndex = embSpatialIndex_create(p);
+    return p->spatialIndex;
+}
+
+/*! Frees the spatial index of pattern (\a p), if it has one. The next embPattern_spatialIndex() call builds a new one. */
+void embPattern_freeSpatialIndex(EmbPattern* p)
+{
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_freeSpatialIndex(), p argument is null\n"); return; }
+    embSpatialIndex_free(p->spatialIndex);
+    p->spatialIndex = 0;
+}
+
+/*! Returns the stitch counts, thread length and stitch extents of pattern (\a p). They are kept up to date as
+ *  stitches are added, so this does not walk the stitches unless they were changed since the last call. */
+EmbPatternStats embPattern_stats(EmbPattern* p)
+{
+    if(!p)
+    {
+        EmbPatternStats empty;
+        memset(&empty, 0, sizeof(EmbPatternStats));
+        embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_stats(), p argument is null\n");
+        return empty;
+    }
+    embPattern_countStitches(p);
+    return p->stats;
+}
+
+/*! Drops everything pattern (\a p) caches about its stitches and objects, its stats and its spatial index.
+ *  Functions of pattern (\a p) that move, remove or change stitches or objects call it, and so must any other code that does. */
+void embPattern_invalidate(EmbPattern* p)
+{
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_invalidate(), p argument is null\n"); return; }
+    embPattern_freeSpatialIndex(p);
+    embPattern_resetStats(p);
+}
+
+/*! Gives pattern (\a p) an arena that the point lists, paths, polygons and polylines added to it are allocated from
+ *  while it is read or built by its own functions. They are then released all at once by embPattern_free(),
+ *  instead of one node at a time. Objects created elsewhere can still be added and are freed as before.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int embPattern_useArena(EmbPattern* p)
+{
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_useArena(), p argument is null\n"); return 0; }
+    if(!p->arena)
+        p->arena = embArena_create();
+    return p->arena != 0;
+}
+
 /*! Frees all memory allocated in the pattern (\a p). */
 void embPattern_free(EmbPattern* p)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_free(), p argument is null\n"); return; }
-    embStitchList_free(p->stitchList);              p->stitchList = 0;      p->lastStitch = 0;
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_free(), p argument is null\n"); return; }
+    embPattern_freeSpatialIndex(p);
+    /* NOTE: lists from the arena are left to it, so the lists below only walk their objects, not every point */
+    embStitchArray_free(&(p->stitchArray));         p->stitchList = 0;      p->lastStitch = 0;
     embThreadList_free(p->threadList);              p->threadList = 0;      p->lastThread = 0;
 
     embArcObjectList_free(p->arcObjList);           p->arcObjList = 0;      p->lastArcObj = 0;
@@ -932,6 +1415,7 @@ void embPattern_free(EmbPattern* p)
     embPolylineObjectList_free(p->polylineObjList); p->polylineObjList = 0; p->lastPolylineObj = 0;
     embRectObjectList_free(p->rectObjList);         p->rectObjList = 0;     p->lastRectObj = 0;
  /* embSplineObjectList_free(p->splineObjList);     p->splineObjList = 0;   p->lastSplineObj = 0; TODO: finish this */
+    embArena_free(p->arena);                        p->arena = 0;
 
     free(p);
     p = 0;
@@ -942,7 +1426,7 @@ void embPattern_addCircleObjectAbs(EmbPattern* p, double cx, double cy, double r
 {
     EmbCircleObject circleObj = embCircleObject_make(cx, cy, r);
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_addCircleObjectAbs(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addCircleObjectAbs(), p argument is null\n"); return; }
     if(embCircleObjectList_empty(p->circleObjList))
     {
         p->circleObjList = p->lastCircleObj = embCircleObjectList_create(circleObj);
@@ -958,7 +1442,7 @@ void embPattern_addEllipseObjectAbs(EmbPattern* p, double cx, double cy, double
 {
     EmbEllipseObject ellipseObj = embEllipseObject_make(cx, cy, rx, ry);
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_addEllipseObjectAbs(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addEllipseObjectAbs(), p argument is null\n"); return; }
     if(embEllipseObjectList_empty(p->ellipseObjList))
     {
         p->ellipseObjList = p->lastEllipseObj = embEllipseObjectList_create(ellipseObj);
@@ -974,7 +1458,7 @@ void embPattern_addLineObjectAbs(EmbPattern* p, double x1, double y1, double x2,
 {
     EmbLineObject lineObj = embLineObject_make(x1, y1, x2, y2);
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_addLineObjectAbs(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addLineObjectAbs(), p argument is null\n"); return; }
     if(embLineObjectList_empty(p->lineObjList))
     {
         p->lineObjList = p->lastLineObj = embLineObjectList_create(lineObj);
@@ -987,10 +1471,13 @@ void embPattern_addLineObjectAbs(EmbPattern* p, double x1, double y1, double x2,
 
 void embPattern_addPathObjectAbs(EmbPattern* p, EmbPathObject* obj)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_addPathObjectAbs(), p argument is null\n"); return; }
-    if(!obj) { embLog_error("emb-pattern.c embPattern_addPathObjectAbs(), obj argument is null\n"); return; }
+    EmbArena* previousArena = 0;
+
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addPathObjectAbs(), p argument is null\n"); return; }
+    if(!obj) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addPathObjectAbs(), obj argument is null\n"); return; }
     if(embPointList_empty(obj->pointList)) { embLog_error("emb-pattern.c embPattern_addPathObjectAbs(), obj->pointList is empty\n"); return; }
 
+    previousArena = embArena_attach(p->arena);
     if(embPathObjectList_empty(p->pathObjList))
     {
         p->pathObjList = p->lastPathObj = embPathObjectList_create(obj);
@@ -999,14 +1486,17 @@ void embPattern_addPathObjectAbs(EmbPattern* p, EmbPathObject* obj)
     {
         p->lastPathObj = embPathObjectList_add(p->lastPathObj, obj);
     }
+    embArena_attach(previousArena);
 }
 
 /*! Adds a point object to pattern (\a p) at the absolute position (\a x,\a y). Positive y is up. Units are in millimeters. */
 void embPattern_addPointObjectAbs(EmbPattern* p, double x, double y)
 {
     EmbPointObject pointObj = embPointObject_make(x, y);
+    EmbArena* previousArena = 0;
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_addPointObjectAbs(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addPointObjectAbs(), p argument is null\n"); return; }
+    previousArena = embArena_attach(p->arena);
     if(embPointObjectList_empty(p->pointObjList))
     {
         p->pointObjList = p->lastPointObj = embPointObjectList_create(pointObj);
@@ -1015,14 +1505,18 @@ void embPattern_addPointObjectAbs(EmbPattern* p, double x, double y)
     {
         p->lastPointObj = embPointObjectList_add(p->lastPointObj, pointObj);
     }
+    embArena_attach(previousArena);
 }
 
 void embPattern_addPolygonObjectAbs(EmbPattern* p, EmbPolygonObject* obj)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_addPolygonObjectAbs(), p argument is null\n"); return; }
-    if(!obj) { embLog_error("emb-pattern.c embPattern_addPolygonObjectAbs(), obj argument is null\n"); return; }
+    EmbArena* previousArena = 0;
+
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addPolygonObjectAbs(), p argument is null\n"); return; }
+    if(!obj) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addPolygonObjectAbs(), obj argument is null\n"); return; }
     if(embPointList_empty(obj->pointList)) { embLog_error("emb-pattern.c embPattern_addPolygonObjectAbs(), obj->pointList is empty\n"); return; }
 
+    previousArena = embArena_attach(p->arena);
     if(embPolygonObjectList_empty(p->polygonObjList))
     {
         p->polygonObjList = p->lastPolygonObj = embPolygonObjectList_create(obj);
@@ -1031,14 +1525,18 @@ void embPattern_addPolygonObjectAbs(EmbPattern* p, EmbPolygonObject* obj)
     {
         p->lastPolygonObj = embPolygonObjectList_add(p->lastPolygonObj, obj);
     }
+    embArena_attach(previousArena);
 }
 
 void embPattern_addPolylineObjectAbs(EmbPattern* p, EmbPolylineObject* obj)
 {
-    if(!p) { embLog_error("emb-pattern.c embPattern_addPolylineObjectAbs(), p argument is null\n"); return; }
-    if(!obj) { embLog_error("emb-pattern.c embPattern_addPolylineObjectAbs(), obj argument is null\n"); return; }
+    EmbArena* previousArena = 0;
+
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addPolylineObjectAbs(), p argument is null\n"); return; }
+    if(!obj) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addPolylineObjectAbs(), obj argument is null\n"); return; }
     if(embPointList_empty(obj->pointList)) { embLog_error("emb-pattern.c embPattern_addPolylineObjectAbs(), obj->pointList is empty\n"); return; }
 
+    previousArena = embArena_attach(p->arena);
     if(embPolylineObjectList_empty(p->polylineObjList))
     {
         p->polylineObjList = p->lastPolylineObj = embPolylineObjectList_create(obj);
@@ -1047,6 +1545,7 @@ void embPattern_addPolylineObjectAbs(EmbPattern* p, EmbPolylineObject* obj)
     {
         p->lastPolylineObj = embPolylineObjectList_add(p->lastPolylineObj, obj);
     }
+    embArena_attach(previousArena);
 }
 
 /*! Adds a rectangle object to pattern (\a p) at the absolute position (\a x,\a y) with a width of (\a w) and a height of (\a h). Positive y is up. Units are in millimeters. */
@@ -1054,7 +1553,7 @@ void embPattern_addRectObjectAbs(EmbPattern* p, double x, double y, double w, do
 {
     EmbRectObject rectObj = embRectObject_make(x, y, w, h);
 
-    if(!p) { embLog_error("emb-pattern.c embPattern_addRectObjectAbs(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-pattern.c embPattern_addRectObjectAbs(), p argument is null\n"); return; }
     if(embRectObjectList_empty(p->rectObjList))
     {
         p->rectObjList = p->lastRectObj = embRectObjectList_create(rectObj);
@@ -3,9 +3,11 @@
 #define EMB_PATTERN_H
 
 #include "emb-arc.h"
+#include "emb-arena.h"
 #include "emb-circle.h"
 #include "emb-ellipse.h"
 #include "emb-hoop.h"
+#include "emb-logging.h"
 #include "emb-line.h"
 #include "emb-path.h"
 #include "emb-point.h"
@@ -22,10 +24,29 @@
 extern "C" {
 #endif
 
+struct EmbSpatialIndex_; /* see emb-spatial-index.h */
+
+/* Totals over the stitches of a pattern, kept up to date as stitches are added, see embPattern_stats() */
+typedef struct EmbPatternStats_
+{
+    int stitchCount;      /* every stitch, including the HOME stitch and those already handed to a stitch callback */
+    int realCount;        /* stitches with neither JUMP nor TRIM */
+    int jumpCount;        /* stitches with JUMP */
+    int trimCount;        /* stitches with TRIM */
+    int colorChangeCount; /* stitches with STOP */
+    int moveCount;        /* stitches with any of JUMP, TRIM or STOP, each counted once */
+    double threadLength;  /* sum of the distances from each real stitch to the stitch before it, in millimeters */
+    EmbRect bounds;       /* extents of the stitches without TRIM, left is greater than right while there are none */
+} EmbPatternStats;
+
+/* Receives stitches one at a time, see embPattern_setStitchCallback() */
+typedef void (*EmbStitchCallback)(void* userData, EmbStitch stitch);
+
 typedef struct EmbPattern_
 {
     EmbSettings settings;
     EmbHoop hoop;
+    EmbStitchArray stitchArray; /* owns the stitches, stitchList and lastStitch point into it */
     EmbStitchList* stitchList;
     EmbThreadList* threadList;
 
@@ -57,15 +78,30 @@ typedef struct EmbPattern_
     int currentColorIndex;
     double lastX;
     double lastY;
+
+    EmbStitchCallback stitchCallback; /* when set, stitches are handed off as they are added instead of accumulating */
+    void* stitchCallbackData;
+    int streamedMaxColorIndex; /* highest color index among the stitches already handed off */
+
+    EmbArena* arena; /* set by embPattern_useArena(), owned */
+    EmbLog* log; /* when set, embPattern_read() and embPattern_write() report to it instead of stdout, not owned */
+    struct EmbSpatialIndex_* spatialIndex; /* built by embPattern_spatialIndex() on first use, owned */
+    EmbPatternStats stats; /* covers the first statsCount stitches of stitchArray, see embPattern_stats() */
+    int statsCount;
 } EmbPattern;
 
 extern EMB_PUBLIC EmbPattern* EMB_CALL embPattern_create(void);
+extern EMB_PUBLIC EmbPattern* EMB_CALL embPattern_copy(EmbPattern* p);
+extern EMB_PUBLIC int EMB_CALL embPattern_stitchCount(EmbPattern* p);
 extern EMB_PUBLIC void EMB_CALL embPattern_hideStitchesOverLength(EmbPattern* p, int length);
 extern EMB_PUBLIC void EMB_CALL embPattern_fixColorCount(EmbPattern* p);
 extern EMB_PUBLIC int EMB_CALL embPattern_addThread(EmbPattern* p, EmbThread thread);
 extern EMB_PUBLIC void EMB_CALL embPattern_addStitchAbs(EmbPattern* p, double x, double y, int flags, int isAutoColorIndex);
 extern EMB_PUBLIC void EMB_CALL embPattern_addStitchRel(EmbPattern* p, double dx, double dy, int flags, int isAutoColorIndex);
 extern EMB_PUBLIC void EMB_CALL embPattern_changeColor(EmbPattern* p, int index);
+extern EMB_PUBLIC void EMB_CALL embPattern_setStitchCallback(EmbPattern* p, EmbStitchCallback callback, void* userData);
+extern EMB_PUBLIC void EMB_CALL embPattern_flushStitches(EmbPattern* p);
+extern EMB_PUBLIC int EMB_CALL embPattern_useArena(EmbPattern* p);
 extern EMB_PUBLIC void EMB_CALL embPattern_free(EmbPattern* p);
 extern EMB_PUBLIC void EMB_CALL embPattern_scale(EmbPattern* p, double scale);
 extern EMB_PUBLIC EmbRect EMB_CALL embPattern_calcBoundingBox(EmbPattern* p);
@@ -76,6 +112,10 @@ extern EMB_PUBLIC void EMB_CALL embPattern_combineJumpStitches(EmbPattern* p);
 extern EMB_PUBLIC void EMB_CALL embPattern_correctForMaxStitchLength(EmbPattern* p, double maxStitchLength, double maxJumpLength);
 extern EMB_PUBLIC void EMB_CALL embPattern_center(EmbPattern* p);
 extern EMB_PUBLIC void EMB_CALL embPattern_loadExternalColorFile(EmbPattern* p, const char* fileName);
+extern EMB_PUBLIC struct EmbSpatialIndex_* EMB_CALL embPattern_spatialIndex(EmbPattern* p);
+extern EMB_PUBLIC void EMB_CALL embPattern_freeSpatialIndex(EmbPattern* p);
+extern EMB_PUBLIC EmbPatternStats EMB_CALL embPattern_stats(EmbPattern* p);
+extern EMB_PUBLIC void EMB_CALL embPattern_invalidate(EmbPattern* p);
 
 extern EMB_PUBLIC void EMB_CALL embPattern_addCircleObjectAbs(EmbPattern* p, double cx, double cy, double r);
 extern EMB_PUBLIC void EMB_CALL embPattern_addEllipseObjectAbs(EmbPattern* p, double cx, double cy, double rx, double ry); /* TODO: ellipse rotation */
@@ -1,4 +1,5 @@
 #include "emb-point.h"
+#include "emb-arena.h"
 #include "emb-logging.h"
 #include <stdlib.h>
 
@@ -31,8 +32,8 @@ EmbPoint embPoint_make(double x, double y)
 
 EmbPointList* embPointList_create(double x, double y)
 {
-    EmbPointList* heapPointList = (EmbPointList*)malloc(sizeof(EmbPointList));
-    if(!heapPointList) { embLog_error("emb-point.c embPointList_create(), cannot allocate memory for heapPointList\n"); return 0; }
+    EmbPointList* heapPointList = (EmbPointList*)embArena_malloc(sizeof(EmbPointList));
+    if(!heapPointList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-point.c embPointList_create(), cannot allocate memory for heapPointList\n"); return 0; }
     heapPointList->point.xx = x;
     heapPointList->point.yy = y;
     heapPointList->next = 0;
@@ -41,10 +42,10 @@ EmbPointList* embPointList_create(double x, double y)
 
 EmbPointList* embPointList_add(EmbPointList* pointer, EmbPoint data)
 {
-    if(!pointer) { embLog_error("emb-point.c embPointList_add(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-point.c embPointList_add(), pointer argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-point.c embPointList_add(), pointer->next should be null\n"); return 0; }
-    pointer->next = (EmbPointList*)malloc(sizeof(EmbPointList));
-    if(!pointer->next) { embLog_error("emb-point.c embPointList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    pointer->next = (EmbPointList*)embArena_malloc(sizeof(EmbPointList));
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-point.c embPointList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->point = data;
     pointer->next = 0;
@@ -74,10 +75,13 @@ void embPointList_free(EmbPointList* pointer)
 {
     EmbPointList* tempPointer = pointer;
     EmbPointList* nextPointer = 0;
+    /* NOTE: a list built in an arena is freed along with it */
+    if(embArena_owner(pointer))
+        return;
     while(tempPointer)
     {
         nextPointer = tempPointer->next;
-        free(tempPointer);
+        embArena_release(tempPointer);
         tempPointer = nextPointer;
     }
     pointer = 0;
@@ -99,8 +103,8 @@ EmbPointObject embPointObject_make(double x, double y)
 /* Returns a pointer to an EmbPointObject. It is created on the heap. The caller is responsible for freeing the allocated memory. */
 EmbPointObject* embPointObject_create(double x, double y)
 {
-    EmbPointObject* heapPointObj = (EmbPointObject*)malloc(sizeof(EmbPointObject));
-    if(!heapPointObj) { embLog_error("emb-point.c embPointObject_create(), cannot allocate memory for heapPointObj\n"); return 0; }
+    EmbPointObject* heapPointObj = (EmbPointObject*)embArena_malloc(sizeof(EmbPointObject));
+    if(!heapPointObj) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-point.c embPointObject_create(), cannot allocate memory for heapPointObj\n"); return 0; }
     heapPointObj->point.xx = x;
     heapPointObj->point.yy = y;
     return heapPointObj;
@@ -112,8 +116,8 @@ EmbPointObject* embPointObject_create(double x, double y)
 
 EmbPointObjectList* embPointObjectList_create(EmbPointObject data)
 {
-    EmbPointObjectList* heapPointObjList = (EmbPointObjectList*)malloc(sizeof(EmbPointObjectList));
-    if(!heapPointObjList) { embLog_error("emb-point.c embPointObjectList_create(), cannot allocate memory for heapPointObjList\n"); return 0; }
+    EmbPointObjectList* heapPointObjList = (EmbPointObjectList*)embArena_malloc(sizeof(EmbPointObjectList));
+    if(!heapPointObjList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-point.c embPointObjectList_create(), cannot allocate memory for heapPointObjList\n"); return 0; }
     heapPointObjList->pointObj = data;
     heapPointObjList->next = 0;
     return heapPointObjList;
@@ -121,10 +125,10 @@ EmbPointObjectList* embPointObjectList_create(EmbPointObject data)
 
 EmbPointObjectList* embPointObjectList_add(EmbPointObjectList* pointer, EmbPointObject data)
 {
-    if(!pointer) { embLog_error("emb-point.c embPointObjectList_add(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-point.c embPointObjectList_add(), pointer argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-point.c embPointObjectList_add(), pointer->next should be null\n"); return 0; }
-    pointer->next = (EmbPointObjectList*)malloc(sizeof(EmbPointObjectList));
-    if(!pointer->next) { embLog_error("emb-point.c embPointObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    pointer->next = (EmbPointObjectList*)embArena_malloc(sizeof(EmbPointObjectList));
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-point.c embPointObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->pointObj = data;
     pointer->next = 0;
@@ -154,10 +158,13 @@ void embPointObjectList_free(EmbPointObjectList* pointer)
 {
     EmbPointObjectList* tempPointer = pointer;
     EmbPointObjectList* nextPointer = 0;
+    /* NOTE: a list built in an arena is freed along with it */
+    if(embArena_owner(pointer))
+        return;
     while(tempPointer)
     {
         nextPointer = tempPointer->next;
-        free(tempPointer);
+        embArena_release(tempPointer);
         tempPointer = nextPointer;
     }
     pointer = 0;
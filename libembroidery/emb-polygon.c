@@ -1,4 +1,5 @@
 #include "emb-polygon.h"
+#include "emb-arena.h"
 #include "emb-logging.h"
 #include <stdlib.h>
 
@@ -9,9 +10,9 @@
 EmbPolygonObject* embPolygonObject_create(EmbPointList* pointList, EmbColor color, int lineType)
 {
     EmbPolygonObject* heapPolygonObj = 0;
-    if(!pointList) { embLog_error("emb-polygon.c embPolygonObject_create(), pointList argument is null\n"); return 0; }
-    heapPolygonObj = (EmbPolygonObject*)malloc(sizeof(EmbPolygonObject));
-    if(!heapPolygonObj) { embLog_error("emb-polygon.c embPolygonObject_create(), cannot allocate memory for heapPolygonObj\n"); return 0; }
+    if(!pointList) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-polygon.c embPolygonObject_create(), pointList argument is null\n"); return 0; }
+    heapPolygonObj = (EmbPolygonObject*)embArena_malloc(sizeof(EmbPolygonObject));
+    if(!heapPolygonObj) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-polygon.c embPolygonObject_create(), cannot allocate memory for heapPolygonObj\n"); return 0; }
     heapPolygonObj->pointList = pointList;
     /* TODO: layer */
     heapPolygonObj->color = color;
@@ -23,7 +24,7 @@ void embPolygonObject_free(EmbPolygonObject* pointer)
 {
     embPointList_free(pointer->pointList);
     pointer->pointList = 0;
-    free(pointer);
+    embArena_release(pointer);
     pointer = 0;
 }
 
@@ -34,9 +35,9 @@ void embPolygonObject_free(EmbPolygonObject* pointer)
 EmbPolygonObjectList* embPolygonObjectList_create(EmbPolygonObject* data)
 {
     EmbPolygonObjectList* heapPolygonObjList = 0;
-    if(!data) { embLog_error("emb-polygon.c embPolygonObjectList_create(), data argument is null\n"); return 0; }
-    heapPolygonObjList = (EmbPolygonObjectList*)malloc(sizeof(EmbPolygonObjectList));
-    if(!heapPolygonObjList) { embLog_error("emb-polygon.c embPolygonObjectList_create(), cannot allocate memory for heapPolygonObjList\n"); return 0; }
+    if(!data) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-polygon.c embPolygonObjectList_create(), data argument is null\n"); return 0; }
+    heapPolygonObjList = (EmbPolygonObjectList*)embArena_malloc(sizeof(EmbPolygonObjectList));
+    if(!heapPolygonObjList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-polygon.c embPolygonObjectList_create(), cannot allocate memory for heapPolygonObjList\n"); return 0; }
     heapPolygonObjList->polygonObj = data;
     heapPolygonObjList->next = 0;
     return heapPolygonObjList;
@@ -44,11 +45,11 @@ EmbPolygonObjectList* embPolygonObjectList_create(EmbPolygonObject* data)
 
 EmbPolygonObjectList* embPolygonObjectList_add(EmbPolygonObjectList* pointer, EmbPolygonObject* data)
 {
-    if(!pointer) { embLog_error("emb-polygon.c embPolygonObjectList_add(), pointer argument is null\n"); return 0; }
-    if(!data) { embLog_error("emb-polygon.c embPolygonObjectList_add(), data argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-polygon.c embPolygonObjectList_add(), pointer argument is null\n"); return 0; }
+    if(!data) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-polygon.c embPolygonObjectList_add(), data argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-polygon.c embPolygonObjectList_add(), pointer->next should be null\n"); return 0; }
-    pointer->next = (EmbPolygonObjectList*)malloc(sizeof(EmbPolygonObjectList));
-    if(!pointer->next) { embLog_error("emb-polygon.c embPolygonObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    pointer->next = (EmbPolygonObjectList*)embArena_malloc(sizeof(EmbPolygonObjectList));
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-polygon.c embPolygonObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->polygonObj = data;
     pointer->next = 0;
@@ -83,7 +84,7 @@ void embPolygonObjectList_free(EmbPolygonObjectList* pointer)
         nextPointer = tempPointer->next;
         embPolygonObject_free(tempPointer->polygonObj);
         tempPointer->polygonObj = 0;
-        free(tempPointer);
+        embArena_release(tempPointer);
         tempPointer = nextPointer;
     }
     pointer = 0;
@@ -1,4 +1,5 @@
 #include "emb-polyline.h"
+#include "emb-arena.h"
 #include "emb-logging.h"
 #include <stdlib.h>
 
@@ -9,9 +10,9 @@
 EmbPolylineObject* embPolylineObject_create(EmbPointList* pointList, EmbColor color, int lineType)
 {
     EmbPolylineObject* heapPolylineObj = 0;
-    if(!pointList) { embLog_error("emb-polyline.c embPolylineObject_create(), pointList argument is null\n"); return 0; }
-    heapPolylineObj = (EmbPolylineObject*)malloc(sizeof(EmbPolylineObject));
-    if(!heapPolylineObj) { embLog_error("emb-polyline.c embPolylineObject_create(), cannot allocate memory for heapPolylineObj\n"); return 0; }
+    if(!pointList) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-polyline.c embPolylineObject_create(), pointList argument is null\n"); return 0; }
+    heapPolylineObj = (EmbPolylineObject*)embArena_malloc(sizeof(EmbPolylineObject));
+    if(!heapPolylineObj) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-polyline.c embPolylineObject_create(), cannot allocate memory for heapPolylineObj\n"); return 0; }
     heapPolylineObj->pointList = pointList;
     /* TODO: layer */
     heapPolylineObj->color = color;
@@ -23,7 +24,7 @@ void embPolylineObject_free(EmbPolylineObject* pointer)
 {
     embPointList_free(pointer->pointList);
     pointer->pointList = 0;
-    free(pointer);
+    embArena_release(pointer);
     pointer = 0;
 }
 
@@ -34,9 +35,9 @@ void embPolylineObject_free(EmbPolylineObject* pointer)
 EmbPolylineObjectList* embPolylineObjectList_create(EmbPolylineObject* data)
 {
     EmbPolylineObjectList* heapPolylineObjList = 0;
-    if(!data) { embLog_error("emb-polyline.c embPolylineObjectList_create(), data argument is null\n"); return 0; }
-    heapPolylineObjList = (EmbPolylineObjectList*)malloc(sizeof(EmbPolylineObjectList));
-    if(!heapPolylineObjList) { embLog_error("emb-polyline.c embPolylineObjectList_create(), cannot allocate memory for heapPolylineObjList\n"); return 0; }
+    if(!data) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-polyline.c embPolylineObjectList_create(), data argument is null\n"); return 0; }
+    heapPolylineObjList = (EmbPolylineObjectList*)embArena_malloc(sizeof(EmbPolylineObjectList));
+    if(!heapPolylineObjList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-polyline.c embPolylineObjectList_create(), cannot allocate memory for heapPolylineObjList\n"); return 0; }
     heapPolylineObjList->polylineObj = data;
     heapPolylineObjList->next = 0;
     return heapPolylineObjList;
@@ -44,11 +45,11 @@ EmbPolylineObjectList* embPolylineObjectList_create(EmbPolylineObject* data)
 
 EmbPolylineObjectList* embPolylineObjectList_add(EmbPolylineObjectList* pointer, EmbPolylineObject* data)
 {
-    if(!pointer) { embLog_error("emb-polyline.c embPolylineObjectList_add(), pointer argument is null\n"); return 0; }
-    if(!data) { embLog_error("emb-polyline.c embPolylineObjectList_add(), data argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-polyline.c embPolylineObjectList_add(), pointer argument is null\n"); return 0; }
+    if(!data) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-polyline.c embPolylineObjectList_add(), data argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-polyline.c embPolylineObjectList_add(), pointer->next should be null\n"); return 0; }
-    pointer->next = (EmbPolylineObjectList*)malloc(sizeof(EmbPolylineObjectList));
-    if(!pointer->next) { embLog_error("emb-polyline.c embPolylineObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    pointer->next = (EmbPolylineObjectList*)embArena_malloc(sizeof(EmbPolylineObjectList));
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-polyline.c embPolylineObjectList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->polylineObj = data;
     pointer->next = 0;
@@ -83,7 +84,7 @@ void embPolylineObjectList_free(EmbPolylineObjectList* pointer)
         nextPointer = tempPointer->next;
         embPolylineObject_free(tempPointer->polylineObj);
         tempPointer->polylineObj = 0;
-        free(tempPointer);
+        embArena_release(tempPointer);
         tempPointer = nextPointer;
     }
     pointer = 0;
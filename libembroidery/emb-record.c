@@ -0,0 +1,383 @@
+#include "emb-record.h"
+#include "emb-logging.h"
+#include "helpers-misc.h"
+#include <string.h>
+
+/* DST moves each axis in balanced ternary: every power of three from 1 to 81 is added, subtracted or left out,
+ * and each choice has its own bit in the three bytes of a record. These are the bits of each move from -121 to 121,
+ * packed as b0 | b1 << 8 | b2 << 16, so a record is encoded with two lookups instead of a branch per power. */
+static const unsigned long dstEncodeX[243] =
+{
+    0x080A0A, 0x080A08, 0x080A09, 0x08080A, 0x080808, 0x080809, 0x08090A, 0x080908, 0x080909, 0x080A02, 0x080A00, 0x080A01,
+    0x080802, 0x080800, 0x080801, 0x080902, 0x080900, 0x080901, 0x080A06, 0x080A04, 0x080A05, 0x080806, 0x080804, 0x080805,
+    0x080906, 0x080904, 0x080905, 0x08020A, 0x080208, 0x080209, 0x08000A, 0x080008, 0x080009, 0x08010A, 0x080108, 0x080109,
+    0x080202, 0x080200, 0x080201, 0x080002, 0x080000, 0x080001, 0x080102, 0x080100, 0x080101, 0x080206, 0x080204, 0x080205,
+    0x080006, 0x080004, 0x080005, 0x080106, 0x080104, 0x080105, 0x08060A, 0x080608, 0x080609, 0x08040A, 0x080408, 0x080409,
+    0x08050A, 0x080508, 0x080509, 0x080602, 0x080600, 0x080601, 0x080402, 0x080400, 0x080401, 0x080502, 0x080500, 0x080501,
+    0x080606, 0x080604, 0x080605, 0x080406, 0x080404, 0x080405, 0x080506, 0x080504, 0x080505, 0x000A0A, 0x000A08, 0x000A09,
+    0x00080A, 0x000808, 0x000809, 0x00090A, 0x000908, 0x000909, 0x000A02, 0x000A00, 0x000A01, 0x000802, 0x000800, 0x000801,
+    0x000902, 0x000900, 0x000901, 0x000A06, 0x000A04, 0x000A05, 0x000806, 0x000804, 0x000805, 0x000906, 0x000904, 0x000905,
+    0x00020A, 0x000208, 0x000209, 0x00000A, 0x000008, 0x000009, 0x00010A, 0x000108, 0x000109, 0x000202, 0x000200, 0x000201,
+    0x000002, 0x000000, 0x000001, 0x000102, 0x000100, 0x000101, 0x000206, 0x000204, 0x000205, 0x000006, 0x000004, 0x000005,
+    0x000106, 0x000104, 0x000105, 0x00060A, 0x000608, 0x000609, 0x00040A, 0x000408, 0x000409, 0x00050A, 0x000508, 0x000509,
+    0x000602, 0x000600, 0x000601, 0x000402, 0x000400, 0x000401, 0x000502, 0x000500, 0x000501, 0x000606, 0x000604, 0x000605,
+    0x000406, 0x000404, 0x000405, 0x000506, 0x000504, 0x000505, 0x040A0A, 0x040A08, 0x040A09, 0x04080A, 0x040808, 0x040809,
+    0x04090A, 0x040908, 0x040909, 0x040A02, 0x040A00, 0x040A01, 0x040802, 0x040800, 0x040801, 0x040902, 0x040900, 0x040901,
+    0x040A06, 0x040A04, 0x040A05, 0x040806, 0x040804, 0x040805, 0x040906, 0x040904, 0x040905, 0x04020A, 0x040208, 0x040209,
+    0x04000A, 0x040008, 0x040009, 0x04010A, 0x040108, 0x040109, 0x040202, 0x040200, 0x040201, 0x040002, 0x040000, 0x040001,
+    0x040102, 0x040100, 0x040101, 0x040206, 0x040204, 0x040205, 0x040006, 0x040004, 0x040005, 0x040106, 0x040104, 0x040105,
+    0x04060A, 0x040608, 0x040609, 0x04040A, 0x040408, 0x040409, 0x04050A, 0x040508, 0x040509, 0x040602, 0x040600, 0x040601,
+    0x040402, 0x040400, 0x040401, 0x040502, 0x040500, 0x040501, 0x040606, 0x040604, 0x040605, 0x040406, 0x040404, 0x040405,
+    0x040506, 0x040504, 0x040505
+};
+
+static const unsigned long dstEncodeY[243] =
+{
+    0x105050, 0x105010, 0x105090, 0x101050, 0x101010, 0x101090, 0x109050, 0x109010, 0x109090, 0x105040, 0x105000, 0x105080,
+    0x101040, 0x101000, 0x101080, 0x109040, 0x109000, 0x109080, 0x105060, 0x105020, 0x1050A0, 0x101060, 0x101020, 0x1010A0,
+    0x109060, 0x109020, 0x1090A0, 0x104050, 0x104010, 0x104090, 0x100050, 0x100010, 0x100090, 0x108050, 0x108010, 0x108090,
+    0x104040, 0x104000, 0x104080, 0x100040, 0x100000, 0x100080, 0x108040, 0x108000, 0x108080, 0x104060, 0x104020, 0x1040A0,
+    0x100060, 0x100020, 0x1000A0, 0x108060, 0x108020, 0x1080A0, 0x106050, 0x106010, 0x106090, 0x102050, 0x102010, 0x102090,
+    0x10A050, 0x10A010, 0x10A090, 0x106040, 0x106000, 0x106080, 0x102040, 0x102000, 0x102080, 0x10A040, 0x10A000, 0x10A080,
+    0x106060, 0x106020, 0x1060A0, 0x102060, 0x102020, 0x1020A0, 0x10A060, 0x10A020, 0x10A0A0, 0x005050, 0x005010, 0x005090,
+    0x001050, 0x001010, 0x001090, 0x009050, 0x009010, 0x009090, 0x005040, 0x005000, 0x005080, 0x001040, 0x001000, 0x001080,
+    0x009040, 0x009000, 0x009080, 0x005060, 0x005020, 0x0050A0, 0x001060, 0x001020, 0x0010A0, 0x009060, 0x009020, 0x0090A0,
+    0x004050, 0x004010, 0x004090, 0x000050, 0x000010, 0x000090, 0x008050, 0x008010, 0x008090, 0x004040, 0x004000, 0x004080,
+    0x000040, 0x000000, 0x000080, 0x008040, 0x008000, 0x008080, 0x004060, 0x004020, 0x0040A0, 0x000060, 0x000020, 0x0000A0,
+    0x008060, 0x008020, 0x0080A0, 0x006050, 0x006010, 0x006090, 0x002050, 0x002010, 0x002090, 0x00A050, 0x00A010, 0x00A090,
+    0x006040, 0x006000, 0x006080, 0x002040, 0x002000, 0x002080, 0x00A040, 0x00A000, 0x00A080, 0x006060, 0x006020, 0x0060A0,
+    0x002060, 0x002020, 0x0020A0, 0x00A060, 0x00A020, 0x00A0A0, 0x205050, 0x205010, 0x205090, 0x201050, 0x201010, 0x201090,
+    0x209050, 0x209010, 0x209090, 0x205040, 0x205000, 0x205080, 0x201040, 0x201000, 0x201080, 0x209040, 0x209000, 0x209080,
+    0x205060, 0x205020, 0x2050A0, 0x201060, 0x201020, 0x2010A0, 0x209060, 0x209020, 0x2090A0, 0x204050, 0x204010, 0x204090,
+    0x200050, 0x200010, 0x200090, 0x208050, 0x208010, 0x208090, 0x204040, 0x204000, 0x204080, 0x200040, 0x200000, 0x200080,
+    0x208040, 0x208000, 0x208080, 0x204060, 0x204020, 0x2040A0, 0x200060, 0x200020, 0x2000A0, 0x208060, 0x208020, 0x2080A0,
+    0x206050, 0x206010, 0x206090, 0x202050, 0x202010, 0x202090, 0x20A050, 0x20A010, 0x20A090, 0x206040, 0x206000, 0x206080,
+    0x202040, 0x202000, 0x202080, 0x20A040, 0x20A000, 0x20A080, 0x206060, 0x206020, 0x2060A0, 0x202060, 0x202020, 0x2020A0,
+    0x20A060, 0x20A020, 0x20A0A0
+};
+
+/* What the X bits of a nibble add up to, b0 & 0x0F is in units of 1, b1 & 0x0F of 3 and b2 & 0x0C of 9 */
+static const signed char dstDecodeX[16] = { 0, 1, -1, 0, 9, 10, 8, 9, -9, -8, -10, -9, 0, 1, -1, 0 };
+
+/* What the Y bits of a high nibble add up to, in the same units as dstDecodeX */
+static const signed char dstDecodeY[16] = { 0, -9, 9, 0, -1, -10, 8, -1, 1, -8, 10, 1, 0, -9, 9, 0 };
+
+/* Encodes a move outside of the tables the way the tables would, reporting the part that cannot be encoded. */
+static unsigned long embRecord_encodeDstMove(int x, int y)
+{
+    unsigned long b0 = 0, b1 = 0, b2 = 0;
+
+    /* cannot encode values > +121 or < -121. */
+    if(x > 121 || x < -121) embLog_error("emb-record.c embRecord_encodeDst(), x is not in valid range [-121,121] , x = %d\n", x);
+    if(y > 121 || y < -121) embLog_error("emb-record.c embRecord_encodeDst(), y is not in valid range [-121,121] , y = %d\n", y);
+
+    if(x >= +41) { b2 |= 0x04; x -= 81; }
+    if(x <= -41) { b2 |= 0x08; x += 81; }
+    if(x >= +14) { b1 |= 0x04; x -= 27; }
+    if(x <= -14) { b1 |= 0x08; x += 27; }
+    if(x >=  +5) { b0 |= 0x04; x -= 9; }
+    if(x <=  -5) { b0 |= 0x08; x += 9; }
+    if(x >=  +2) { b1 |= 0x01; x -= 3; }
+    if(x <=  -2) { b1 |= 0x02; x += 3; }
+    if(x >=  +1) { b0 |= 0x01; x -= 1; }
+    if(x <=  -1) { b0 |= 0x02; x += 1; }
+    if(x !=   0) { embLog_error("emb-record.c embRecord_encodeDst(), x should be zero yet x = %d\n", x); }
+    if(y >= +41) { b2 |= 0x20; y -= 81; }
+    if(y <= -41) { b2 |= 0x10; y += 81; }
+    if(y >= +14) { b1 |= 0x20; y -= 27; }
+    if(y <= -14) { b1 |= 0x10; y += 27; }
+    if(y >=  +5) { b0 |= 0x20; y -= 9; }
+    if(y <=  -5) { b0 |= 0x10; y += 9; }
+    if(y >=  +2) { b1 |= 0x80; y -= 3; }
+    if(y <=  -2) { b1 |= 0x40; y += 3; }
+    if(y >=  +1) { b0 |= 0x80; y -= 1; }
+    if(y <=  -1) { b0 |= 0x40; y += 1; }
+    if(y !=   0) { embLog_error("emb-record.c embRecord_encodeDst(), y should be zero yet y = %d\n", y); }
+
+    return b0 | (b1 << 8) | (b2 << 16);
+}
+
+/* Returns the two's complement value of byte \a b. */
+static int embRecord_signedByte(unsigned char b)
+{
+    return (b >= 0x80) ? (int)b - 256 : (int)b;
+}
+
+/*! Encodes the \a count records of \a records as 3 byte DST records, written to \a output.
+ *  Moves from -121 to 121 on each axis are looked up, others fall back to the step by step encoding and are reported.
+ *  Returns the number of bytes written, which is 3 * \a count. */
+int embRecord_encodeDst(const EmbRecord* records, int count, unsigned char* output)
+{
+    int i;
+
+    if(!records && count > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_encodeDst(), records argument is null\n"); return 0; }
+    if(!output && count > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_encodeDst(), output argument is null\n"); return 0; }
+
+    for(i = 0; i < count; i++)
+    {
+        int x = records[i].dx, y = records[i].dy, flags = records[i].flags;
+        unsigned long bits;
+        unsigned char b2;
+
+        if(x >= -121 && x <= 121 && y >= -121 && y <= 121)
+            bits = dstEncodeX[x + 121] | dstEncodeY[y + 121];
+        else
+            bits = embRecord_encodeDstMove(x, y);
+
+        b2 = (unsigned char)((bits >> 16) | 0x03);
+        if(flags & END)
+        {
+            b2 = 0xF3;
+            bits = 0;
+        }
+        if(flags & (JUMP | TRIM)) b2 |= 0x83;
+        if(flags & STOP) b2 |= 0xC3;
+
+        output[0] = (unsigned char)(bits & 0xFF);
+        output[1] = (unsigned char)((bits >> 8) & 0xFF);
+        output[2] = b2;
+        output += 3;
+    }
+    return 3 * count;
+}
+
+/*! Decodes up to \a maxCount 3 byte DST records from the \a size bytes at \a data into \a records, stopping after an END record.
+ *  The number of bytes decoded is stored in \a used, a record cut short at the end of \a data is left for the next call.
+ *  Returns the number of records decoded. */
+int embRecord_decodeDst(const unsigned char* data, int size, EmbRecord* records, int maxCount, int* used)
+{
+    int count = 0, position = 0;
+
+    if(!used) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeDst(), used argument is null\n"); return 0; }
+    *used = 0;
+    if(!data && size > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeDst(), data argument is null\n"); return 0; }
+    if(!records && maxCount > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeDst(), records argument is null\n"); return 0; }
+
+    while(count < maxCount && position + 3 <= size)
+    {
+        unsigned char b0 = data[position], b1 = data[position + 1], b2 = data[position + 2];
+        EmbRecord* record = &records[count++];
+
+        position += 3;
+        record->dx = dstDecodeX[b0 & 0x0F] + 3 * dstDecodeX[b1 & 0x0F] + 9 * dstDecodeX[b2 & 0x0C];
+        record->dy = dstDecodeY[b0 >> 4] + 3 * dstDecodeY[b1 >> 4] + 9 * dstDecodeY[(b2 & 0x30) >> 4];
+        if(b2 == 0xF3)
+        {
+            record->flags = END;
+            break;
+        }
+        record->flags = NORMAL;
+        if(b2 & 0x80) record->flags |= JUMP;
+        if(b2 & 0x40) record->flags |= STOP;
+    }
+    *used = position;
+    return count;
+}
+
+/*! Encodes the \a count records of \a records as EXP records, written to \a output, which must have room for 4 * \a count bytes.
+ *  A stitch is 2 bytes and a STOP, TRIM, JUMP or END is a 4 byte record starting with 0x80. The same records are used by SEW.
+ *  Returns the number of bytes written. */
+int embRecord_encodeExp(const EmbRecord* records, int count, unsigned char* output)
+{
+    unsigned char* start = output;
+    int i;
+
+    if(!records && count > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_encodeExp(), records argument is null\n"); return 0; }
+    if(!output && count > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_encodeExp(), output argument is null\n"); return 0; }
+
+    for(i = 0; i < count; i++)
+    {
+        int flags = records[i].flags;
+        unsigned char dx = (unsigned char)records[i].dx, dy = (unsigned char)records[i].dy;
+
+        /* TODO: How to encode JUMP stitches? JUMP must be handled. Also check this for the KSM format since it appears to be similar */
+        if(flags == STOP || flags == END || flags == TRIM || flags == JUMP)
+        {
+            *output++ = 0x80;
+            *output++ = (flags == STOP) ? 1 : (flags == END) ? 0x10 : 2;
+            *output++ = (flags == END) ? 0 : dx;
+            *output++ = (flags == END) ? 0 : dy;
+        }
+        else
+        {
+            *output++ = dx;
+            *output++ = dy;
+        }
+    }
+    return (int)(output - start);
+}
+
+/*! Decodes up to \a maxCount EXP records from the \a size bytes at \a data into \a records, as embRecord_decodeDst().
+ *  Returns the number of records decoded. */
+int embRecord_decodeExp(const unsigned char* data, int size, EmbRecord* records, int maxCount, int* used)
+{
+    int count = 0, position = 0;
+
+    if(!used) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeExp(), used argument is null\n"); return 0; }
+    *used = 0;
+    if(!data && size > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeExp(), data argument is null\n"); return 0; }
+    if(!records && maxCount > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeExp(), records argument is null\n"); return 0; }
+
+    while(count < maxCount && position + 2 <= size)
+    {
+        unsigned char b0 = data[position], b1 = data[position + 1];
+        int flags = NORMAL, length = 2;
+
+        if(b0 == 0x80 && ((b1 & 1) || b1 == 2 || b1 == 4 || b1 == 6 || b1 == 0x80))
+        {
+            length = 4;
+            if(position + 4 > size)
+                break;
+            if(b1 & 1) flags = STOP;
+            else if(b1 == 4 || b1 == 6) flags = TRIM;
+            else if(b1 == 0x80) flags = TRIM; /* Seems to be followed by 0x07 0x00, maybe used as extension functions */
+            if(b1 == 0x80)
+            {
+                b0 = 0;
+                b1 = 0;
+            }
+            else
+            {
+                b0 = data[position + 2];
+                b1 = data[position + 3];
+            }
+        }
+        records[count].dx = embRecord_signedByte(b0);
+        records[count].dy = embRecord_signedByte(b1);
+        records[count].flags = flags;
+        count++;
+        position += length;
+    }
+    *used = position;
+    return count;
+}
+
+/*! Encodes the \a count records of \a records as JEF records, written to \a output, which must have room for 4 * \a count bytes.
+ *  These differ from EXP records in that a JUMP has its own code and END is 2 bytes. Returns the number of bytes written. */
+int embRecord_encodeJef(const EmbRecord* records, int count, unsigned char* output)
+{
+    unsigned char* start = output;
+    int i;
+
+    if(!records && count > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_encodeJef(), records argument is null\n"); return 0; }
+    if(!output && count > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_encodeJef(), output argument is null\n"); return 0; }
+
+    for(i = 0; i < count; i++)
+    {
+        int flags = records[i].flags;
+        unsigned char dx = (unsigned char)records[i].dx, dy = (unsigned char)records[i].dy;
+
+        if(flags == END)
+        {
+            *output++ = 0x80;
+            *output++ = 0x10;
+        }
+        else if(flags == STOP || flags == TRIM || flags == JUMP)
+        {
+            *output++ = 0x80;
+            *output++ = (flags == STOP) ? 1 : (flags == TRIM) ? 2 : 4;
+            *output++ = dx;
+            *output++ = dy;
+        }
+        else
+        {
+            *output++ = dx;
+            *output++ = dy;
+        }
+    }
+    return (int)(output - start);
+}
+
+/*! Decodes up to \a maxCount JEF records from the \a size bytes at \a data into \a records, as embRecord_decodeDst().
+ *  Returns the number of records decoded. */
+int embRecord_decodeJef(const unsigned char* data, int size, EmbRecord* records, int maxCount, int* used)
+{
+    int count = 0, position = 0;
+
+    if(!used) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeJef(), used argument is null\n"); return 0; }
+    *used = 0;
+    if(!data && size > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeJef(), data argument is null\n"); return 0; }
+    if(!records && maxCount > 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_decodeJef(), records argument is null\n"); return 0; }
+
+    while(count < maxCount && position + 2 <= size)
+    {
+        unsigned char b0 = data[position], b1 = data[position + 1];
+        int flags = NORMAL, length = 2;
+
+        if(b0 == 0x80 && b1 == 0x10)
+        {
+            records[count].dx = 0;
+            records[count].dy = 0;
+            records[count].flags = END;
+            count++;
+            position += 2;
+            break;
+        }
+        if(b0 == 0x80 && ((b1 & 1) || b1 == 2 || b1 == 4 || b1 == 6))
+        {
+            length = 4;
+            if(position + 4 > size)
+                break;
+            flags = (b1 & 1) ? STOP : TRIM;
+            b0 = data[position + 2];
+            b1 = data[position + 3];
+        }
+        records[count].dx = embRecord_signedByte(b0);
+        records[count].dy = embRecord_signedByte(b1);
+        records[count].flags = flags;
+        count++;
+        position += length;
+    }
+    *used = position;
+    return count;
+}
+
+/*! Reads the records of \a file with \a decode, a block at a time, and adds them to \a pattern as relative stitches,
+ *  stopping at an END record or at the end of \a file. When \a byteLimit is not negative, no record is started at or
+ *  after \a byteLimit bytes. The END stitch is left for the caller to add. Returns the number of stitches added. */
+int embRecord_readStitches(EmbPattern* pattern, EmbFile* file, EmbRecordDecoder decode, long byteLimit)
+{
+    unsigned char buffer[EMB_RECORD_BLOCK * 4];
+    EmbRecord records[EMB_RECORD_BLOCK];
+    int buffered = 0, added = 0, count, used, maxCount, i;
+    long consumed = 0;
+    size_t bytesRead;
+
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_readStitches(), pattern argument is null\n"); return 0; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_readStitches(), file argument is null\n"); return 0; }
+    if(!decode) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-record.c embRecord_readStitches(), decode argument is null\n"); return 0; }
+
+    for(;;)
+    {
+        bytesRead = embFile_read(buffer + buffered, 1, sizeof(buffer) - buffered, file);
+        buffered += (int)bytesRead;
+
+        maxCount = EMB_RECORD_BLOCK;
+        if(byteLimit >= 0)
+        {
+            /* NOTE: records are at most 4 bytes long, so each of these starts before byteLimit */
+            long left = byteLimit - consumed;
+            if(left <= 0)
+                break;
+            if((left + 3) / 4 < maxCount)
+                maxCount = (int)((left + 3) / 4);
+        }
+
+        count = decode(buffer, buffered, records, maxCount, &used);
+        for(i = 0; i < count; i++)
+        {
+            if(records[i].flags == END)
+                return added;
+            embPattern_addStitchRel(pattern, records[i].dx / 10.0, records[i].dy / 10.0, records[i].flags, 1);
+            added++;
+        }
+        if(count == 0 && bytesRead == 0)
+            break;
+        consumed += used;
+        buffered -= used;
+        memmove(buffer, buffer + used, (size_t)buffered);
+    }
+    return added;
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
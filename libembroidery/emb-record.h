@@ -0,0 +1,47 @@
+/*! @file emb-record.h */
+#ifndef EMB_RECORD_H
+#define EMB_RECORD_H
+
+#include "emb-file.h"
+#include "emb-pattern.h"
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of records the readers and writers of fixed-record formats convert at a time.
+ * Their buffers are on the stack, so boards with little memory use smaller blocks. */
+#ifdef ARDUINO
+#define EMB_RECORD_BLOCK 16
+#else
+#define EMB_RECORD_BLOCK 256
+#endif
+
+/* One stitch of a fixed-record format: a move relative to the stitch before it, in the 0.1 mm units of the file */
+typedef struct EmbRecord_
+{
+    int dx;
+    int dy;
+    int flags;
+} EmbRecord;
+
+/* Decodes records from the \a size bytes at \a data, see embRecord_decodeDst() */
+typedef int (*EmbRecordDecoder)(const unsigned char* data, int size, EmbRecord* records, int maxCount, int* used);
+
+extern EMB_PUBLIC int EMB_CALL embRecord_encodeDst(const EmbRecord* records, int count, unsigned char* output);
+extern EMB_PUBLIC int EMB_CALL embRecord_decodeDst(const unsigned char* data, int size, EmbRecord* records, int maxCount, int* used);
+extern EMB_PUBLIC int EMB_CALL embRecord_encodeExp(const EmbRecord* records, int count, unsigned char* output);
+extern EMB_PUBLIC int EMB_CALL embRecord_decodeExp(const unsigned char* data, int size, EmbRecord* records, int maxCount, int* used);
+extern EMB_PUBLIC int EMB_CALL embRecord_encodeJef(const EmbRecord* records, int count, unsigned char* output);
+extern EMB_PUBLIC int EMB_CALL embRecord_decodeJef(const unsigned char* data, int size, EmbRecord* records, int maxCount, int* used);
+extern EMB_PUBLIC int EMB_CALL embRecord_readStitches(EmbPattern* pattern, EmbFile* file, EmbRecordDecoder decode, long byteLimit);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_RECORD_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -12,9 +12,9 @@ void embSatinOutline_generateSatinOutline(EmbVector lines[], int numberOfPoints,
     double halfThickness = thickness / 2.0;
     int intermediateOutlineCount = 2 * numberOfPoints - 2;
     outline.side1 = (EmbVector*)malloc(sizeof(EmbVector) * intermediateOutlineCount);
-    if(!outline.side1) { embLog_error("emb-satin-line.c embSatinOutline_generateSatinOutline(), cannot allocate memory for outline->side1\n"); return; }
+    if(!outline.side1) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-satin-line.c embSatinOutline_generateSatinOutline(), cannot allocate memory for outline->side1\n"); return; }
     outline.side2 = (EmbVector*)malloc(sizeof(EmbVector) * intermediateOutlineCount);
-    if(!outline.side2) { embLog_error("emb-satin-line.c embSatinOutline_generateSatinOutline(), cannot allocate memory for outline->side2\n"); return; }
+    if(!outline.side2) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-satin-line.c embSatinOutline_generateSatinOutline(), cannot allocate memory for outline->side2\n"); return; }
 
     for(i = 1; i < numberOfPoints; i++)
     {
@@ -33,11 +33,11 @@ void embSatinOutline_generateSatinOutline(EmbVector lines[], int numberOfPoints,
         embVector_add(temp, lines[i], &outline.side2[j + 1]);
     }
 
-    if(!result) { embLog_error("emb-satin-line.c embSatinOutline_generateSatinOutline(), result argument is null\n"); return; }
+    if(!result) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-satin-line.c embSatinOutline_generateSatinOutline(), result argument is null\n"); return; }
     result->side1 = (EmbVector*)malloc(sizeof(EmbVector) * numberOfPoints);
-    if(!result->side1) { embLog_error("emb-satin-line.c embSatinOutline_generateSatinOutline(), cannot allocate memory for result->side1\n"); return; }
+    if(!result->side1) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-satin-line.c embSatinOutline_generateSatinOutline(), cannot allocate memory for result->side1\n"); return; }
     result->side2 = (EmbVector*)malloc(sizeof(EmbVector) * numberOfPoints);
-    if(!result->side2) { embLog_error("emb-satin-line.c embSatinOutline_generateSatinOutline(), cannot allocate memory for result->side2\n"); return; }
+    if(!result->side2) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-satin-line.c embSatinOutline_generateSatinOutline(), cannot allocate memory for result->side2\n"); return; }
 
     result->side1[0] = outline.side1[0];
     result->side2[0] = outline.side2[0];
@@ -64,7 +64,7 @@ EmbVectorList* embSatinOutline_renderStitches(EmbSatinOutline* result, double de
     EmbVectorList* currentStitch = 0;
     EmbVector temp;
 
-    if(!result) { embLog_error("emb-satin-line.c embSatinOutline_renderStitches(), result argument is null\n"); return 0; }
+    if(!result) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-satin-line.c embSatinOutline_renderStitches(), result argument is null\n"); return 0; }
 
     if(result->length > 0)
     {
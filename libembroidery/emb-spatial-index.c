@@ -0,0 +1,481 @@
+#include "emb-spatial-index.h"
+#include "emb-logging.h"
+#include "geom-arc.h"
+#include "helpers-misc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define EMB_SPATIAL_MINGRID 256         /* fewer new items than this are scanned rather than gridded */
+#define EMB_SPATIAL_MAXCELLS (1 << 22)
+#define EMB_SPATIAL_MAXSPAN 64          /* items covering more cells than this are scanned rather than gridded */
+
+typedef struct EmbSpatialItem_
+{
+    int kind;
+    int index;
+    EmbRect bounds; /* top is the smaller y */
+} EmbSpatialItem;
+
+struct EmbSpatialIndex_
+{
+    EmbPattern* pattern;
+
+    EmbSpatialItem* items; /* everything added so far, in the order it was added */
+    unsigned int* marks;   /* the query that last reported each item, so items in several cells are reported once */
+    unsigned int mark;
+    int count;
+    int capacity;
+
+    /* The first gridCount items are in the grid, apart from the looseItems that cover too many cells.
+     * Cell c holds cellItems[cellStart[c]] up to but not including cellItems[cellStart[c + 1]]. */
+    int gridCount;
+    double left;
+    double top;
+    double cellSize;
+    int columns;
+    int rows;
+    int* cellStart;
+    int* cellItems;
+    int* looseItems;
+    int looseCount;
+
+    /* How much of the pattern has been added */
+    int stitchCount;
+    int arcCount;
+    int circleCount;
+    int lineCount;
+    int polylineCount;
+    EmbArcObjectList* lastArc;
+    EmbCircleObjectList* lastCircle;
+    EmbLineObjectList* lastLine;
+    EmbPolylineObjectList* lastPolyline;
+};
+
+/*! Returns a pointer to a new, empty EmbSpatialIndex over \a pattern. Nothing is indexed until the first query.
+ *  The index must be freed with embSpatialIndex_free() if the pattern changes in any way other than by appending.
+ *  Most callers should use embPattern_spatialIndex() instead, which does this for them. */
+EmbSpatialIndex* embSpatialIndex_create(EmbPattern* pattern)
+{
+    EmbSpatialIndex* index = 0;
+
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-spatial-index.c embSpatialIndex_create(), pattern argument is null\n"); return 0; }
+
+    index = (EmbSpatialIndex*)malloc(sizeof(EmbSpatialIndex));
+    if(!index) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-spatial-index.c embSpatialIndex_create(), cannot allocate memory for index\n"); return 0; }
+    memset(index, 0, sizeof(EmbSpatialIndex));
+    index->pattern = pattern;
+    return index;
+}
+
+static void embSpatialIndex_freeGrid(EmbSpatialIndex* index)
+{
+    free(index->cellStart);
+    free(index->cellItems);
+    free(index->looseItems);
+    index->cellStart = 0;
+    index->cellItems = 0;
+    index->looseItems = 0;
+    index->looseCount = 0;
+    index->gridCount = 0;
+}
+
+/* Forgets every item, so the whole pattern is added again */
+static void embSpatialIndex_reset(EmbSpatialIndex* index)
+{
+    embSpatialIndex_freeGrid(index);
+    index->count = 0;
+    index->stitchCount = 0;
+    index->arcCount = 0;
+    index->circleCount = 0;
+    index->lineCount = 0;
+    index->polylineCount = 0;
+    index->lastArc = 0;
+    index->lastCircle = 0;
+    index->lastLine = 0;
+    index->lastPolyline = 0;
+}
+
+static int embSpatialIndex_add(EmbSpatialIndex* index, int kind, int itemIndex, double x1, double y1, double x2, double y2)
+{
+    EmbSpatialItem* item = 0;
+
+    if(index->count == index->capacity)
+    {
+        int capacity = index->capacity ? index->capacity * 2 : 1024;
+        EmbSpatialItem* items = 0;
+        unsigned int* marks = 0;
+
+        items = (EmbSpatialItem*)realloc(index->items, sizeof(EmbSpatialItem) * capacity);
+        if(!items) return 0;
+        index->items = items;
+        marks = (unsigned int*)realloc(index->marks, sizeof(unsigned int) * capacity);
+        if(!marks) return 0;
+        index->marks = marks;
+        index->capacity = capacity;
+    }
+    item = &index->items[index->count];
+    item->kind = kind;
+    item->index = itemIndex;
+    item->bounds.left = x1 < x2 ? x1 : x2;
+    item->bounds.right = x1 < x2 ? x2 : x1;
+    item->bounds.top = y1 < y2 ? y1 : y2;
+    item->bounds.bottom = y1 < y2 ? y2 : y1;
+    index->marks[index->count] = 0;
+    index->count++;
+    return 1;
+}
+
+static int embSpatialIndex_addArc(EmbSpatialIndex* index, int itemIndex, EmbArc arc)
+{
+    double cx, cy, r;
+
+    getArcCenter(arc.startX, arc.startY, arc.midX, arc.midY, arc.endX, arc.endY, &cx, &cy);
+    r = sqrt((arc.startX - cx) * (arc.startX - cx) + (arc.startY - cy) * (arc.startY - cy));
+    if(r < 1.0e30) /* NOTE: also false for the NaN of a degenerate arc */
+        return embSpatialIndex_add(index, EMB_SPATIAL_ARC, itemIndex, cx - r, cy - r, cx + r, cy + r);
+
+    /* Three points in a line */
+    return embSpatialIndex_add(index, EMB_SPATIAL_ARC, itemIndex,
+                               min(arc.startX, min(arc.midX, arc.endX)), min(arc.startY, min(arc.midY, arc.endY)),
+                               max(arc.startX, max(arc.midX, arc.endX)), max(arc.startY, max(arc.midY, arc.endY)));
+}
+
+static int embSpatialIndex_addPolyline(EmbSpatialIndex* index, int itemIndex, EmbPolylineObject* polyline)
+{
+    EmbPointList* point = polyline ? polyline->pointList : 0;
+    double left, top, right, bottom;
+
+    if(!point) return 1; /* nothing to find */
+    left = right = point->point.xx;
+    top = bottom = point->point.yy;
+    for(point = point->next; point; point = point->next)
+    {
+        left = min(left, point->point.xx);
+        right = max(right, point->point.xx);
+        top = min(top, point->point.yy);
+        bottom = max(bottom, point->point.yy);
+    }
+    return embSpatialIndex_add(index, EMB_SPATIAL_POLYLINE, itemIndex, left, top, right, bottom);
+}
+
+/* Column and row range of the cells that \a rect touches, clamped to the grid */
+static void embSpatialIndex_cellRange(EmbSpatialIndex* index, EmbRect rect, int* c0, int* r0, int* c1, int* r1)
+{
+    double x0 = floor((rect.left - index->left) / index->cellSize);
+    double y0 = floor((rect.top - index->top) / index->cellSize);
+    double x1 = floor((rect.right - index->left) / index->cellSize);
+    double y1 = floor((rect.bottom - index->top) / index->cellSize);
+
+    *c0 = x0 < 0.0 ? 0 : (x0 >= index->columns ? index->columns - 1 : (int)x0);
+    *r0 = y0 < 0.0 ? 0 : (y0 >= index->rows ? index->rows - 1 : (int)y0);
+    *c1 = x1 < 0.0 ? 0 : (x1 >= index->columns ? index->columns - 1 : (int)x1);
+    *r1 = y1 < 0.0 ? 0 : (y1 >= index->rows ? index->rows - 1 : (int)y1);
+}
+
+/* Puts every item added so far into a new grid with about one item per cell */
+static int embSpatialIndex_build(EmbSpatialIndex* index)
+{
+    EmbRect bounds;
+    double width, height, target;
+    int i, c, r, c0, r0, c1, r1, cells, total = 0;
+
+    embSpatialIndex_freeGrid(index);
+    if(index->count == 0) return 1;
+
+    bounds = index->items[0].bounds;
+    for(i = 1; i < index->count; i++)
+    {
+        EmbRect b = index->items[i].bounds;
+        bounds.left = min(bounds.left, b.left);
+        bounds.top = min(bounds.top, b.top);
+        bounds.right = max(bounds.right, b.right);
+        bounds.bottom = max(bounds.bottom, b.bottom);
+    }
+    width = bounds.right - bounds.left;
+    height = bounds.bottom - bounds.top;
+    target = (double)min(index->count, EMB_SPATIAL_MAXCELLS);
+    if(width > 0.0 && height > 0.0)
+        index->cellSize = sqrt(width * height / target);
+    else
+        index->cellSize = max(width, height) / target;
+    if(!(index->cellSize > 0.0))
+        index->cellSize = 1.0;
+    while((floor(width / index->cellSize) + 1.0) * (floor(height / index->cellSize) + 1.0) > EMB_SPATIAL_MAXCELLS)
+        index->cellSize *= 2.0;
+    index->left = bounds.left;
+    index->top = bounds.top;
+    index->columns = (int)floor(width / index->cellSize) + 1;
+    index->rows = (int)floor(height / index->cellSize) + 1;
+    cells = index->columns * index->rows;
+
+    index->cellStart = (int*)calloc(cells + 1, sizeof(int));
+    index->looseItems = (int*)malloc(sizeof(int) * index->count);
+    if(!index->cellStart || !index->looseItems) { embSpatialIndex_freeGrid(index); return 0; }
+
+    /* Count the items of each cell */
+    for(i = 0; i < index->count; i++)
+    {
+        embSpatialIndex_cellRange(index, index->items[i].bounds, &c0, &r0, &c1, &r1);
+        if((c1 - c0 + 1) * (r1 - r0 + 1) > EMB_SPATIAL_MAXSPAN)
+        {
+            index->looseItems[index->looseCount++] = i;
+            continue;
+        }
+        for(r = r0; r <= r1; r++)
+            for(c = c0; c <= c1; c++)
+                index->cellStart[r * index->columns + c + 1]++;
+    }
+    for(c = 0; c < cells; c++)
+    {
+        total += index->cellStart[c + 1];
+        index->cellStart[c + 1] = total;
+    }
+
+    /* Fill the cells, which leaves each cellStart pointing at the start of the next cell */
+    index->cellItems = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    if(!index->cellItems) { embSpatialIndex_freeGrid(index); return 0; }
+    for(i = 0; i < index->count; i++)
+    {
+        embSpatialIndex_cellRange(index, index->items[i].bounds, &c0, &r0, &c1, &r1);
+        if((c1 - c0 + 1) * (r1 - r0 + 1) > EMB_SPATIAL_MAXSPAN)
+            continue;
+        for(r = r0; r <= r1; r++)
+            for(c = c0; c <= c1; c++)
+                index->cellItems[index->cellStart[r * index->columns + c]++] = i;
+    }
+    for(c = cells; c > 0; c--)
+        index->cellStart[c] = index->cellStart[c - 1];
+    index->cellStart[0] = 0;
+
+    index->gridCount = index->count;
+    return 1;
+}
+
+/* Adds whatever was appended to the pattern since the last call, and regrids once enough of it is outside the grid */
+static int embSpatialIndex_update(EmbSpatialIndex* index)
+{
+    EmbPattern* p = index->pattern;
+    EmbArcObjectList* arc = 0;
+    EmbCircleObjectList* circle = 0;
+    EmbLineObjectList* line = 0;
+    EmbPolylineObjectList* polyline = 0;
+    int pending;
+
+    if(embStitchArray_count(&(p->stitchArray)) < index->stitchCount)
+        embSpatialIndex_reset(index); /* stitches were removed, nothing added before can be trusted */
+
+    for(; index->stitchCount < embStitchArray_count(&(p->stitchArray)); index->stitchCount++)
+    {
+        EmbStitch st = p->stitchArray.stitches[index->stitchCount].stitch;
+        if(!embSpatialIndex_add(index, EMB_SPATIAL_STITCH, index->stitchCount, st.xx, st.yy, st.xx, st.yy)) return 0;
+    }
+    for(arc = index->lastArc ? index->lastArc->next : p->arcObjList; arc; arc = arc->next)
+    {
+        if(!embSpatialIndex_addArc(index, index->arcCount, arc->arcObj.arc)) return 0;
+        index->lastArc = arc;
+        index->arcCount++;
+    }
+    for(circle = index->lastCircle ? index->lastCircle->next : p->circleObjList; circle; circle = circle->next)
+    {
+        EmbCircle c = circle->circleObj.circle;
+        if(!embSpatialIndex_add(index, EMB_SPATIAL_CIRCLE, index->circleCount,
+                                c.centerX - c.radius, c.centerY - c.radius, c.centerX + c.radius, c.centerY + c.radius)) return 0;
+        index->lastCircle = circle;
+        index->circleCount++;
+    }
+    for(line = index->lastLine ? index->lastLine->next : p->lineObjList; line; line = line->next)
+    {
+        EmbLine l = line->lineObj.line;
+        if(!embSpatialIndex_add(index, EMB_SPATIAL_LINE, index->lineCount, l.x1, l.y1, l.x2, l.y2)) return 0;
+        index->lastLine = line;
+        index->lineCount++;
+    }
+    for(polyline = index->lastPolyline ? index->lastPolyline->next : p->polylineObjList; polyline; polyline = polyline->next)
+    {
+        if(!embSpatialIndex_addPolyline(index, index->polylineCount, polyline->polylineObj)) return 0;
+        index->lastPolyline = polyline;
+        index->polylineCount++;
+    }
+
+    /* NOTE: regridding only when the ungridded items reach an eighth of the grid keeps appends amortized O(1) */
+    pending = index->count - index->gridCount;
+    if(pending >= EMB_SPATIAL_MINGRID && pending >= index->gridCount / 8)
+        return embSpatialIndex_build(index);
+    return 1;
+}
+
+/* Starts a new query, returns the mark for the items it reports */
+static unsigned int embSpatialIndex_nextMark(EmbSpatialIndex* index)
+{
+    if(++index->mark == 0)
+    {
+        memset(index->marks, 0, sizeof(unsigned int) * index->capacity);
+        index->mark = 1;
+    }
+    return index->mark;
+}
+
+static int embSpatialIndex_intersects(EmbRect a, EmbRect b)
+{
+    return !(a.right < b.left || a.left > b.right || a.bottom < b.top || a.top > b.bottom);
+}
+
+/*! Calls \a callback with \a userData for every item of \a index whose kind is in \a kinds and whose bounds
+ *  touch \a rect. Each item is reported once, in no particular order. The pattern must not be changed by \a callback.
+ *  Returns the number of items found, which is all that is done if \a callback is null. */
+int embSpatialIndex_queryRect(EmbSpatialIndex* index, EmbRect rect, int kinds, EmbSpatialCallback callback, void* userData)
+{
+    EmbRect query;
+    unsigned int mark;
+    int i, c, r, c0, r0, c1, r1, found = 0;
+
+    if(!index) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-spatial-index.c embSpatialIndex_queryRect(), index argument is null\n"); return 0; }
+    if(!embSpatialIndex_update(index)) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-spatial-index.c embSpatialIndex_queryRect(), cannot allocate memory for index\n"); return 0; }
+
+    query.left = min(rect.left, rect.right);
+    query.right = max(rect.left, rect.right);
+    query.top = min(rect.top, rect.bottom);
+    query.bottom = max(rect.top, rect.bottom);
+    mark = embSpatialIndex_nextMark(index);
+
+    if(index->gridCount > 0)
+    {
+        embSpatialIndex_cellRange(index, query, &c0, &r0, &c1, &r1);
+        for(r = r0; r <= r1; r++)
+        {
+            for(c = c0; c <= c1; c++)
+            {
+                int cell = r * index->columns + c;
+                for(i = index->cellStart[cell]; i < index->cellStart[cell + 1]; i++)
+                {
+                    int item = index->cellItems[i];
+                    if(index->marks[item] == mark || !(index->items[item].kind & kinds))
+                        continue;
+                    index->marks[item] = mark;
+                    if(!embSpatialIndex_intersects(index->items[item].bounds, query))
+                        continue;
+                    found++;
+                    if(callback) callback(userData, index->items[item].kind, index->items[item].index);
+                }
+            }
+        }
+        for(i = 0; i < index->looseCount; i++)
+        {
+            EmbSpatialItem* item = &index->items[index->looseItems[i]];
+            if(!(item->kind & kinds) || !embSpatialIndex_intersects(item->bounds, query))
+                continue;
+            found++;
+            if(callback) callback(userData, item->kind, item->index);
+        }
+    }
+    for(i = index->gridCount; i < index->count; i++)
+    {
+        EmbSpatialItem* item = &index->items[i];
+        if(!(item->kind & kinds) || !embSpatialIndex_intersects(item->bounds, query))
+            continue;
+        found++;
+        if(callback) callback(userData, item->kind, item->index);
+    }
+    return found;
+}
+
+/* Squared distance from (\a x,\a y) to \a bounds, 0 inside them */
+static double embSpatialIndex_distance2(EmbRect bounds, double x, double y)
+{
+    double dx = x < bounds.left ? bounds.left - x : (x > bounds.right ? x - bounds.right : 0.0);
+    double dy = y < bounds.top ? bounds.top - y : (y > bounds.bottom ? y - bounds.bottom : 0.0);
+    return dx * dx + dy * dy;
+}
+
+static void embSpatialIndex_consider(EmbSpatialIndex* index, int item, double x, double y, int kinds, int* best, double* bestDistance2)
+{
+    double d2;
+
+    if(!(index->items[item].kind & kinds))
+        return;
+    d2 = embSpatialIndex_distance2(index->items[item].bounds, x, y);
+    if(*best < 0 || d2 < *bestDistance2)
+    {
+        *best = item;
+        *bestDistance2 = d2;
+    }
+}
+
+/*! Returns the index of the item of \a index closest to (\a x,\a y) among the kinds in \a kinds, or -1 if there is none.
+ *  Objects are measured by their bounding box. If they are not null, \a kind receives the kind of the item
+ *  and \a distance the distance to it. Ties go to whichever item is found first. */
+int embSpatialIndex_nearest(EmbSpatialIndex* index, double x, double y, int kinds, int* kind, double* distance)
+{
+    int i, c, r, ring, rings, cx, cy, best = -1;
+    double qx, qy, bestDistance2 = 0.0;
+    unsigned int mark;
+
+    if(!index) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-spatial-index.c embSpatialIndex_nearest(), index argument is null\n"); return -1; }
+    if(!embSpatialIndex_update(index)) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-spatial-index.c embSpatialIndex_nearest(), cannot allocate memory for index\n"); return -1; }
+
+    for(i = 0; i < index->looseCount; i++)
+        embSpatialIndex_consider(index, index->looseItems[i], x, y, kinds, &best, &bestDistance2);
+    for(i = index->gridCount; i < index->count; i++)
+        embSpatialIndex_consider(index, i, x, y, kinds, &best, &bestDistance2);
+
+    if(index->gridCount > 0)
+    {
+        /* Search rings of cells around the one nearest the point. Nothing in ring n can be closer than n - 1 cells */
+        mark = embSpatialIndex_nextMark(index);
+        qx = floor((x - index->left) / index->cellSize);
+        qy = floor((y - index->top) / index->cellSize);
+        cx = qx < 0.0 ? 0 : (qx >= index->columns ? index->columns - 1 : (int)qx);
+        cy = qy < 0.0 ? 0 : (qy >= index->rows ? index->rows - 1 : (int)qy);
+        rings = max(max(cx, index->columns - 1 - cx), max(cy, index->rows - 1 - cy));
+        for(ring = 0; ring <= rings; ring++)
+        {
+            double reach = (ring - 1) * index->cellSize;
+            if(best >= 0 && ring > 0 && bestDistance2 <= reach * reach)
+                break;
+            for(r = cy - ring; r <= cy + ring; r++)
+            {
+                if(r < 0 || r >= index->rows)
+                    continue;
+                for(c = cx - ring; c <= cx + ring; c += (r == cy - ring || r == cy + ring) ? 1 : 2 * ring)
+                {
+                    int cell = r * index->columns + c;
+                    if(c >= 0 && c < index->columns)
+                    {
+                        for(i = index->cellStart[cell]; i < index->cellStart[cell + 1]; i++)
+                        {
+                            int item = index->cellItems[i];
+                            if(index->marks[item] == mark)
+                                continue;
+                            index->marks[item] = mark;
+                            embSpatialIndex_consider(index, item, x, y, kinds, &best, &bestDistance2);
+                        }
+                    }
+                    if(ring == 0) break;
+                }
+            }
+        }
+    }
+
+    if(best < 0) return -1;
+    if(kind) *kind = index->items[best].kind;
+    if(distance) *distance = sqrt(bestDistance2);
+    return index->items[best].index;
+}
+
+/*! Returns the index of the stitch of \a index closest to (\a x,\a y), or -1 if the pattern has no stitches. */
+int embSpatialIndex_nearestStitch(EmbSpatialIndex* index, double x, double y)
+{
+    return embSpatialIndex_nearest(index, x, y, EMB_SPATIAL_STITCH, 0, 0);
+}
+
+void embSpatialIndex_free(EmbSpatialIndex* index)
+{
+    if(!index) return;
+    embSpatialIndex_freeGrid(index);
+    free(index->items);
+    free(index->marks);
+    free(index);
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
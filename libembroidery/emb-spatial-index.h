@@ -0,0 +1,42 @@
+/*! @file emb-spatial-index.h */
+#ifndef EMB_SPATIAL_INDEX_H
+#define EMB_SPATIAL_INDEX_H
+
+#include "emb-pattern.h"
+#include "emb-rect.h"
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Kinds of items in an EmbSpatialIndex, combined with | to select several of them in a query */
+#define EMB_SPATIAL_STITCH   1
+#define EMB_SPATIAL_ARC      2
+#define EMB_SPATIAL_CIRCLE   4
+#define EMB_SPATIAL_LINE     8
+#define EMB_SPATIAL_POLYLINE 16
+#define EMB_SPATIAL_ALL      31
+
+/* Called for each item found by embSpatialIndex_queryRect(). \a index is the position of the item
+ * in the stitch array or in the object list of its \a kind. */
+typedef void (*EmbSpatialCallback)(void* userData, int kind, int index);
+
+/* Uniform grid over the stitches and the arc, circle, line and polyline objects of one EmbPattern.
+ * It is built on first use, and items appended to the pattern afterwards are picked up by the next query. */
+typedef struct EmbSpatialIndex_ EmbSpatialIndex;
+
+extern EMB_PUBLIC EmbSpatialIndex* EMB_CALL embSpatialIndex_create(EmbPattern* pattern);
+extern EMB_PUBLIC int EMB_CALL embSpatialIndex_queryRect(EmbSpatialIndex* index, EmbRect rect, int kinds, EmbSpatialCallback callback, void* userData);
+extern EMB_PUBLIC int EMB_CALL embSpatialIndex_nearest(EmbSpatialIndex* index, double x, double y, int kinds, int* kind, double* distance);
+extern EMB_PUBLIC int EMB_CALL embSpatialIndex_nearestStitch(EmbSpatialIndex* index, double x, double y);
+extern EMB_PUBLIC void EMB_CALL embSpatialIndex_free(EmbSpatialIndex* index);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_SPATIAL_INDEX_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
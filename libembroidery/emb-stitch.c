@@ -6,7 +6,7 @@
 EmbStitchList* embStitchList_create(EmbStitch data)
 {
     EmbStitchList* heapStitchList = (EmbStitchList*)malloc(sizeof(EmbStitchList));
-    if(!heapStitchList) { embLog_error("emb-stitch.c embStitchList_create(), cannot allocate memory for heapStitchList\n"); return 0; }
+    if(!heapStitchList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-stitch.c embStitchList_create(), cannot allocate memory for heapStitchList\n"); return 0; }
     heapStitchList->stitch = data;
     heapStitchList->next = 0;
     return heapStitchList;
@@ -14,10 +14,10 @@ EmbStitchList* embStitchList_create(EmbStitch data)
 
 EmbStitchList* embStitchList_add(EmbStitchList* pointer, EmbStitch data)
 {
-    if(!pointer) { embLog_error("emb-stitch.c embStitchList_add(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stitch.c embStitchList_add(), pointer argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-stitch.c embStitchList_add(), pointer->next should be null\n"); return 0; }
     pointer->next = (EmbStitchList*)malloc(sizeof(EmbStitchList));
-    if(!pointer->next) { embLog_error("emb-stitch.c embStitchList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-stitch.c embStitchList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->stitch = data;
     pointer->next = 0;
@@ -26,12 +26,13 @@ EmbStitchList* embStitchList_add(EmbStitchList* pointer, EmbStitch data)
 
 EmbStitch embStitchList_getAt(EmbStitchList* pointer, int num)
 {
-    /* TODO: pointer safety */
+    EmbStitch empty = { 0, 0.0, 0.0, 0 };
     int i;
-    for(i = 0; i < num; i++)
+    for(i = 0; pointer && i < num; i++)
     {
         pointer = pointer->next;
     }
+    if(!pointer || num < 0) { embLog_error("emb-stitch.c embStitchList_getAt(), num %d is out of range\n", num); return empty; }
     return pointer->stitch;
 }
 
@@ -68,4 +69,152 @@ void embStitchList_free(EmbStitchList* pointer)
     pointer = 0;
 }
 
+/* Number of stitches reserved the first time an empty EmbStitchArray grows. */
+#define EMB_STITCHARRAY_INITIAL_CAPACITY 256
+
+/* Re-chains the next pointers of the nodes starting at index (\a from). Needed after the block moves. */
+static void embStitchArray_relink(EmbStitchArray* array, int from)
+{
+    int i;
+    for(i = from; i < array->count - 1; i++)
+    {
+        array->stitches[i].next = &(array->stitches[i + 1]);
+    }
+    if(array->count > 0)
+    {
+        array->stitches[array->count - 1].next = 0;
+    }
+}
+
+/*! Initializes (\a array) to an empty state. No memory is allocated until the first stitch is added. */
+void embStitchArray_init(EmbStitchArray* array)
+{
+    if(!array) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stitch.c embStitchArray_init(), array argument is null\n"); return; }
+    array->stitches = 0;
+    array->count = 0;
+    array->capacity = 0;
+}
+
+/*! Ensures (\a array) can hold at least (\a capacity) stitches without reallocating.
+ *  Returns \c true if successful, otherwise returns \c false and leaves the array unchanged. */
+int embStitchArray_reserve(EmbStitchArray* array, int capacity)
+{
+    EmbStitchList* grown = 0;
+
+    if(!array) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stitch.c embStitchArray_reserve(), array argument is null\n"); return 0; }
+    if(capacity <= array->capacity)
+        return 1;
+
+    grown = (EmbStitchList*)realloc(array->stitches, sizeof(EmbStitchList) * capacity);
+    if(!grown) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-stitch.c embStitchArray_reserve(), cannot allocate memory for %d stitches\n", capacity); return 0; }
+    array->stitches = grown;
+    array->capacity = capacity;
+    embStitchArray_relink(array, 0);
+    return 1;
+}
+
+/*! Appends (\a data) to the end of (\a array), doubling the capacity when it is full.
+ *  Returns a pointer to the new node, or null if memory could not be allocated.
+ *  The returned pointer is only valid until the next call that grows the array. */
+EmbStitchList* embStitchArray_append(EmbStitchArray* array, EmbStitch data)
+{
+    EmbStitchList* node = 0;
+
+    if(!array) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stitch.c embStitchArray_append(), array argument is null\n"); return 0; }
+    if(array->count == array->capacity)
+    {
+        int newCapacity = EMB_STITCHARRAY_INITIAL_CAPACITY;
+        if(array->capacity > 0)
+            newCapacity = array->capacity * 2;
+        if(!embStitchArray_reserve(array, newCapacity))
+            return 0;
+    }
+
+    node = &(array->stitches[array->count]);
+    node->stitch = data;
+    node->next = 0;
+    if(array->count > 0)
+    {
+        array->stitches[array->count - 1].next = node;
+    }
+    array->count++;
+    return node;
+}
+
+/*! Shrinks (\a array) to its first (\a count) stitches. The capacity is kept for reuse. */
+void embStitchArray_truncate(EmbStitchArray* array, int count)
+{
+    if(!array) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stitch.c embStitchArray_truncate(), array argument is null\n"); return; }
+    if(count < 0 || count > array->count) { embLog_error("emb-stitch.c embStitchArray_truncate(), count %d is out of range\n", count); return; }
+    array->count = count;
+    if(count > 0)
+    {
+        array->stitches[count - 1].next = 0;
+    }
+}
+
+/*! Sets the number of stitches in (\a array) to (\a count), growing it if needed. Stitches past the old count
+ *  are linked but otherwise left for the caller to fill in, so a block of stitches can be written in any order.
+ *  Returns \c true if successful, otherwise returns \c false and leaves the array unchanged. */
+int embStitchArray_resize(EmbStitchArray* array, int count)
+{
+    int oldCount = 0;
+
+    if(!array) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stitch.c embStitchArray_resize(), array argument is null\n"); return 0; }
+    if(count < 0) { embLog_error("emb-stitch.c embStitchArray_resize(), count %d is out of range\n", count); return 0; }
+    if(count <= array->count)
+    {
+        embStitchArray_truncate(array, count);
+        return 1;
+    }
+    if(!embStitchArray_reserve(array, count))
+        return 0;
+    oldCount = array->count;
+    array->count = count;
+    embStitchArray_relink(array, oldCount > 0 ? oldCount - 1 : 0);
+    return 1;
+}
+
+/*! Returns the number of stitches in (\a array). */
+int embStitchArray_count(const EmbStitchArray* array)
+{
+    if(!array)
+        return 0;
+    return array->count;
+}
+
+/*! Returns the stitch at (\a index) in (\a array), or a zeroed stitch if (\a index) is out of range. */
+EmbStitch embStitchArray_getAt(const EmbStitchArray* array, int index)
+{
+    EmbStitch empty = { 0, 0.0, 0.0, 0 };
+    if(!array) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stitch.c embStitchArray_getAt(), array argument is null\n"); return empty; }
+    if(index < 0 || index >= array->count) { embLog_error("emb-stitch.c embStitchArray_getAt(), index %d is out of range\n", index); return empty; }
+    return array->stitches[index].stitch;
+}
+
+/*! Returns the first node of (\a array) for use as an EmbStitchList iterator, or null if it is empty. */
+EmbStitchList* embStitchArray_first(EmbStitchArray* array)
+{
+    if(!array || array->count == 0)
+        return 0;
+    return array->stitches;
+}
+
+/*! Returns the last node of (\a array), or null if it is empty. */
+EmbStitchList* embStitchArray_last(EmbStitchArray* array)
+{
+    if(!array || array->count == 0)
+        return 0;
+    return &(array->stitches[array->count - 1]);
+}
+
+/*! Frees the memory held by (\a array) and leaves it empty. */
+void embStitchArray_free(EmbStitchArray* array)
+{
+    if(!array)
+        return;
+    free(array->stitches);
+    embStitchArray_init(array);
+}
+
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
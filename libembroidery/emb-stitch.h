@@ -36,6 +36,27 @@ extern EMB_PUBLIC int EMB_CALL embStitchList_empty(EmbStitchList* pointer);
 extern EMB_PUBLIC void EMB_CALL embStitchList_free(EmbStitchList* pointer);
 extern EMB_PUBLIC EmbStitch EMB_CALL embStitchList_getAt(EmbStitchList* pointer, int num);
 
+/* Contiguous, growable stitch storage. The nodes are packed into one block and
+ * stitches[i].next always points at stitches[i + 1], so code that walks an
+ * EmbStitchList keeps working while count and indexed access are O(1). */
+typedef struct EmbStitchArray_
+{
+    EmbStitchList* stitches;
+    int count;
+    int capacity;
+} EmbStitchArray;
+
+extern EMB_PUBLIC void EMB_CALL embStitchArray_init(EmbStitchArray* array);
+extern EMB_PUBLIC int EMB_CALL embStitchArray_reserve(EmbStitchArray* array, int capacity);
+extern EMB_PUBLIC EmbStitchList* EMB_CALL embStitchArray_append(EmbStitchArray* array, EmbStitch data);
+extern EMB_PUBLIC void EMB_CALL embStitchArray_truncate(EmbStitchArray* array, int count);
+extern EMB_PUBLIC int EMB_CALL embStitchArray_resize(EmbStitchArray* array, int count);
+extern EMB_PUBLIC int EMB_CALL embStitchArray_count(const EmbStitchArray* array);
+extern EMB_PUBLIC EmbStitch EMB_CALL embStitchArray_getAt(const EmbStitchArray* array, int index);
+extern EMB_PUBLIC EmbStitchList* EMB_CALL embStitchArray_first(EmbStitchArray* array);
+extern EMB_PUBLIC EmbStitchList* EMB_CALL embStitchArray_last(EmbStitchArray* array);
+extern EMB_PUBLIC void EMB_CALL embStitchArray_free(EmbStitchArray* array);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,300 @@
+#include "emb-stream.h"
+#include "emb-format.h"
+#include "emb-logging.h"
+#include "helpers-misc.h"
+#include "format-dst.h"
+#include "format-exp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+
+typedef struct EmbStreamFormat_
+{
+    const char* extension;
+    int (*begin)(EmbStreamWriter* writer);
+} EmbStreamFormat;
+
+/* Formats whose writers can encode stitches one at a time. Formats that need
+ * the whole design before the first stitch (color tables sized by the thread
+ * count, flipped or recentred stitches) are not listed. */
+static const EmbStreamFormat embStreamWriterFormats[] =
+{
+    { ".dst", dstStreamBegin },
+    { ".exp", expStreamBegin }
+};
+
+/* Formats whose readers add each stitch once and never revisit the stitch
+ * list, so they can run with only a small window of stitches in memory. */
+static const char* const embStreamReaderFormats[] =
+{
+    ".dst",
+    ".exp",
+    ".jef"
+};
+
+/* Copies the lowercase extension of \a fileName into \a ending. Returns \c false if there is none. */
+static int embStream_extension(const char* fileName, char* ending)
+{
+    const char* dot = 0;
+    int i = 0;
+
+    dot = strrchr(fileName, '.');
+    if(!dot || strlen(dot) > 4) return 0;
+    while(dot[i] != '\0')
+    {
+        ending[i] = (char)tolower(dot[i]);
+        ++i;
+    }
+    ending[i] = '\0';
+    return 1;
+}
+
+static const EmbStreamFormat* embStream_writerFormat(const char* fileName)
+{
+    char ending[5];
+    int i;
+
+    if(!embStream_extension(fileName, ending)) return 0;
+    for(i = 0; i < (int)(sizeof(embStreamWriterFormats) / sizeof(embStreamWriterFormats[0])); i++)
+    {
+        if(!strcmp(ending, embStreamWriterFormats[i].extension))
+            return &embStreamWriterFormats[i];
+    }
+    return 0;
+}
+
+/* Returns the format to stream the file with the given \a fileName from, or null if it cannot be streamed.
+ * The format is chosen by embFormat_fromFile() as in embPattern_read(), so both read a file with the wrong extension the same way. */
+static const EmbFormat* embStream_readerFormat(const char* fileName)
+{
+    const EmbFormat* format = 0;
+    int i;
+
+    format = embFormat_fromFile(fileName);
+    if(!format || !format->readerWriter.reader) return 0;
+    for(i = 0; i < (int)(sizeof(embStreamReaderFormats) / sizeof(embStreamReaderFormats[0])); i++)
+    {
+        if(!strcmp(format->extension, embStreamReaderFormats[i]))
+            return format;
+    }
+    return 0;
+}
+
+/*! Returns \c true if the file with the given \a fileName can be read without holding all of its stitches in memory.
+ *  Like embPattern_read(), this goes by the contents of the file before its extension. */
+int embStream_canRead(const char* fileName)
+{
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stream.c embStream_canRead(), fileName argument is null\n"); return 0; }
+    return embStream_readerFormat(fileName) != 0;
+}
+
+/*! Returns \c true if the file with the given \a fileName can be written one stitch at a time. */
+int embStream_canWrite(const char* fileName)
+{
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stream.c embStream_canWrite(), fileName argument is null\n"); return 0; }
+    return embStream_writerFormat(fileName) != 0;
+}
+
+/*! Opens the file with the given \a fileName and writes its placeholder header.
+ *  Returns a pointer to an EmbStreamWriter, or null if the format cannot be streamed or the file cannot be opened.
+ *  The writer is freed by embStreamWriter_finish(). */
+EmbStreamWriter* embStreamWriter_create(const char* fileName)
+{
+    const EmbStreamFormat* format = 0;
+    EmbStreamWriter* writer = 0;
+
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stream.c embStreamWriter_create(), fileName argument is null\n"); return 0; }
+
+    format = embStream_writerFormat(fileName);
+    if(!format) { embLog_errorCode(EMB_LOG_ERROR_UNSUPPORTED, "emb-stream.c embStreamWriter_create(), unsupported write file type: %s\n", fileName); return 0; }
+
+    writer = (EmbStreamWriter*)malloc(sizeof(EmbStreamWriter));
+    if(!writer) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-stream.c embStreamWriter_create(), cannot allocate memory for writer\n"); return 0; }
+
+    writer->file = embFile_open(fileName, "wb");
+    if(!writer->file)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "emb-stream.c embStreamWriter_create(), cannot open %s for writing\n", fileName);
+        free(writer);
+        return 0;
+    }
+    writer->encode = 0;
+    writer->end = 0;
+    writer->maxStitchLength = 0.0;
+    writer->maxJumpLength = 0.0;
+    writer->previous.xx = 0.0;
+    writer->previous.yy = 0.0;
+    writer->previous.flags = NORMAL;
+    writer->previous.color = 0;
+    writer->stitchCount = 0;
+    writer->bounds.left = 99999.0;
+    writer->bounds.top = 99999.0;
+    writer->bounds.right = -99999.0;
+    writer->bounds.bottom = -99999.0;
+
+    if(!format->begin(writer))
+    {
+        embLog_error("emb-stream.c embStreamWriter_create(), cannot begin writing %s\n", fileName);
+        embFile_close(writer->file);
+        free(writer);
+        return 0;
+    }
+    return writer;
+}
+
+/* Accounts for stitch (\a st) in the totals of \a writer and encodes it. */
+static void embStreamWriter_emit(EmbStreamWriter* writer, EmbStitch st)
+{
+    if(!(st.flags & TRIM))
+    {
+        writer->bounds.left = (double)min(writer->bounds.left, st.xx);
+        writer->bounds.top = (double)min(writer->bounds.top, st.yy);
+        writer->bounds.right = (double)max(writer->bounds.right, st.xx);
+        writer->bounds.bottom = (double)max(writer->bounds.bottom, st.yy);
+    }
+    writer->encode(writer, st);
+    writer->previous = st;
+    writer->stitchCount++;
+}
+
+/*! Encodes stitch (\a st) with \a writer. Stitches longer than the format allows are split
+ *  the same way embPattern_correctForMaxStitchLength() splits them. */
+void embStreamWriter_stitch(EmbStreamWriter* writer, EmbStitch st)
+{
+    int j, splits;
+    double dx, dy, maxXY, maxLen;
+
+    if(!writer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stream.c embStreamWriter_stitch(), writer argument is null\n"); return; }
+
+    if(writer->stitchCount > 0 && writer->maxStitchLength > 0.0)
+    {
+        dx = st.xx - writer->previous.xx;
+        dy = st.yy - writer->previous.yy;
+        if((fabs(dx) > writer->maxStitchLength) || (fabs(dy) > writer->maxStitchLength))
+        {
+            double xx = writer->previous.xx;
+            double yy = writer->previous.yy;
+            maxXY = max(fabs(dx), fabs(dy));
+            if(st.flags & (JUMP | TRIM)) maxLen = writer->maxJumpLength;
+            else maxLen = writer->maxStitchLength;
+
+            splits = (int)ceil((double)maxXY / maxLen);
+            for(j = 1; j < splits; j++)
+            {
+                EmbStitch s;
+                s.xx = xx + (dx / splits) * j;
+                s.yy = yy + (dy / splits) * j;
+                s.flags = st.flags;
+                s.color = st.color;
+                embStreamWriter_emit(writer, s);
+            }
+        }
+    }
+    embStreamWriter_emit(writer, st);
+}
+
+/*! Finishes the file written by \a writer, patching its header with the totals and the threads of \a pattern, then frees the writer.
+ *  A null \a pattern abandons the file instead. Returns \c true if successful, otherwise returns \c false. */
+int embStreamWriter_finish(EmbStreamWriter* writer, EmbPattern* pattern)
+{
+    int result = 0;
+
+    if(!writer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stream.c embStreamWriter_finish(), writer argument is null\n"); return 0; }
+
+    if(pattern)
+    {
+        if(writer->stitchCount == 0)
+            embLog_errorCode(EMB_LOG_ERROR_EMPTY, "emb-stream.c embStreamWriter_finish(), pattern contains no stitches\n");
+        else
+            result = writer->end(writer, pattern);
+    }
+    embFile_close(writer->file);
+    free(writer);
+    return result;
+}
+
+typedef struct EmbStreamTargets_
+{
+    EmbStreamWriter** writers;
+    int count;
+} EmbStreamTargets;
+
+static void embStream_dispatch(void* userData, EmbStitch st)
+{
+    EmbStreamTargets* targets = (EmbStreamTargets*)userData;
+    int i;
+
+    for(i = 0; i < targets->count; i++)
+    {
+        if(targets->writers[i])
+            embStreamWriter_stitch(targets->writers[i], st);
+    }
+}
+
+/*! Converts the file with the given \a fileToRead into each of the \a count files in \a filesToWrite
+ *  without holding the design in memory. Every file must satisfy embStream_canRead() or embStream_canWrite().
+ *  Returns \c true if the file was read and every file was written, otherwise returns \c false. */
+int embStream_convert(const char* fileToRead, const char** filesToWrite, int count)
+{
+    const EmbFormat* format = 0;
+    EmbPattern* pattern = 0;
+    EmbStreamTargets targets;
+    int i, successful, result = 1;
+
+    if(!fileToRead) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-stream.c embStream_convert(), fileToRead argument is null\n"); return 0; }
+    if(!filesToWrite || count <= 0) { embLog_error("emb-stream.c embStream_convert(), filesToWrite argument is empty\n"); return 0; }
+
+    format = embStream_readerFormat(fileToRead);
+    if(!format) { embLog_error("emb-stream.c embStream_convert(), cannot stream from %s\n", fileToRead); return 0; }
+
+    pattern = embPattern_create();
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-stream.c embStream_convert(), cannot allocate memory for pattern\n"); return 0; }
+
+    targets.count = count;
+    targets.writers = (EmbStreamWriter**)malloc(sizeof(EmbStreamWriter*) * count);
+    if(!targets.writers)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-stream.c embStream_convert(), cannot allocate memory for writers\n");
+        embPattern_free(pattern);
+        return 0;
+    }
+    for(i = 0; i < count; i++)
+    {
+        targets.writers[i] = embStreamWriter_create(filesToWrite[i]);
+        if(!targets.writers[i])
+            result = 0;
+    }
+
+    embPattern_setStitchCallback(pattern, embStream_dispatch, &targets);
+    successful = format->readerWriter.reader(pattern, fileToRead);
+    if(successful)
+    {
+        embPattern_flushStitches(pattern);
+    }
+    else
+    {
+        embLog_error("emb-stream.c embStream_convert(), reading file %s was unsuccessful\n", fileToRead);
+        result = 0;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        if(!targets.writers[i])
+            continue;
+        if(!embStreamWriter_finish(targets.writers[i], successful ? pattern : 0))
+        {
+            /* Do not leave a file behind with an unpatched header */
+            remove(filesToWrite[i]);
+            if(successful)
+                embLog_error("emb-stream.c embStream_convert(), writing file %s was unsuccessful\n", filesToWrite[i]);
+            result = 0;
+        }
+    }
+    free(targets.writers);
+    embPattern_free(pattern);
+    return result;
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
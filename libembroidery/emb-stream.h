@@ -0,0 +1,47 @@
+/*! @file emb-stream.h */
+#ifndef EMB_STREAM_H
+#define EMB_STREAM_H
+
+#include "emb-file.h"
+#include "emb-pattern.h"
+#include "emb-rect.h"
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Writes a stitch-only format while the stitches are still being read.
+ * Stitches are split and encoded as they arrive, and the totals a header
+ * needs (stitch count, extents, colors) are accumulated here so the format
+ * can seek back and patch them in when the stream ends. */
+typedef struct EmbStreamWriter_
+{
+    EmbFile* file;
+    void (*encode)(struct EmbStreamWriter_* writer, EmbStitch st);
+    int (*end)(struct EmbStreamWriter_* writer, EmbPattern* pattern);
+
+    double maxStitchLength; /* stitches longer than this are split, 0 disables splitting */
+    double maxJumpLength;
+
+    EmbStitch previous; /* last stitch handed to encode, starts at the origin */
+    int stitchCount;
+    EmbRect bounds; /* extents of all non-TRIM stitches */
+} EmbStreamWriter;
+
+extern EMB_PUBLIC int EMB_CALL embStream_canRead(const char* fileName);
+extern EMB_PUBLIC int EMB_CALL embStream_canWrite(const char* fileName);
+extern EMB_PUBLIC int EMB_CALL embStream_convert(const char* fileToRead, const char** filesToWrite, int count);
+
+extern EMB_PUBLIC EmbStreamWriter* EMB_CALL embStreamWriter_create(const char* fileName);
+extern EMB_PUBLIC void EMB_CALL embStreamWriter_stitch(EmbStreamWriter* writer, EmbStitch st);
+extern EMB_PUBLIC int EMB_CALL embStreamWriter_finish(EmbStreamWriter* writer, EmbPattern* pattern);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_STREAM_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
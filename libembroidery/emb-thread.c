@@ -3,9 +3,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+/*! Returns the index of the thread in \a colors closest to \a color, or -1 if \a colors is empty.
+ *  To match many colors against the same threads, see embPalette_nearest(). */
 int embThread_findNearestColor(EmbColor color, EmbThreadList* colors)
 {
-    double currentClosestValue = 9999999;
+    long currentClosestValue = 3L * 255 * 255 + 1;
     int closestIndex = -1;
     int red = color.r;
     int green = color.g;
@@ -16,17 +18,18 @@ int embThread_findNearestColor(EmbColor color, EmbThreadList* colors)
     while(currentThreadItem != NULL)
     {
         int deltaRed;
-        int deltaBlue;
         int deltaGreen;
-        double dist;
+        int deltaBlue;
+        long dist;
         EmbColor c;
         c = currentThreadItem->thread.color;
 
         deltaRed = red - c.r;
-        deltaBlue = green - c.g;
-        deltaGreen = blue - c.b;
+        deltaGreen = green - c.g;
+        deltaBlue = blue - c.b;
 
-        dist = sqrt((double)(deltaRed * deltaRed) + (deltaBlue * deltaBlue) + (deltaGreen * deltaGreen));
+        /* Squared distances order the colors the same as distances, without a sqrt() per candidate */
+        dist = (long)deltaRed * deltaRed + (long)deltaGreen * deltaGreen + (long)deltaBlue * deltaBlue;
         if(dist <= currentClosestValue)
         {
             currentClosestValue = dist;
@@ -38,9 +41,11 @@ int embThread_findNearestColor(EmbColor color, EmbThreadList* colors)
     return closestIndex;
 }
 
+/*! Returns the index of the thread among the \a count threads of \a colorArray closest to \a color, or -1 if \a count is zero.
+ *  To match many colors against the same threads, see embPalette_nearest(). */
 int embThread_findNearestColorInArray(EmbColor color, EmbThread* colorArray, int count)
 {
-    double currentClosestValue = 9999999;
+    long currentClosestValue = 3L * 255 * 255 + 1;
     int closestIndex = -1;
     int red = color.r;
     int green = color.g;
@@ -49,17 +54,18 @@ int embThread_findNearestColorInArray(EmbColor color, EmbThread* colorArray, int
     for(i = 0; i < count; i++)
     {
         int deltaRed;
-        int deltaBlue;
         int deltaGreen;
-        double dist;
+        int deltaBlue;
+        long dist;
         EmbColor c;
         c = colorArray[i].color;
 
         deltaRed = red - c.r;
-        deltaBlue = green - c.g;
-        deltaGreen = blue - c.b;
+        deltaGreen = green - c.g;
+        deltaBlue = blue - c.b;
 
-        dist = sqrt((double)(deltaRed * deltaRed) + (deltaBlue * deltaBlue) + (deltaGreen * deltaGreen));
+        /* Squared distances order the colors the same as distances, without a sqrt() per candidate */
+        dist = (long)deltaRed * deltaRed + (long)deltaGreen * deltaGreen + (long)deltaBlue * deltaBlue;
         if(dist <= currentClosestValue)
         {
             currentClosestValue = dist;
@@ -83,7 +89,7 @@ EmbThread embThread_getRandom(void)
 EmbThreadList* embThreadList_create(EmbThread data)
 {
     EmbThreadList* heapThreadList = (EmbThreadList*)malloc(sizeof(EmbThreadList));
-    if(!heapThreadList) { embLog_error("emb-thread.c embThreadList_create(), cannot allocate memory for heapThreadList\n"); return 0; }
+    if(!heapThreadList) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-thread.c embThreadList_create(), cannot allocate memory for heapThreadList\n"); return 0; }
     heapThreadList->thread = data;
     heapThreadList->next = 0;
     return heapThreadList;
@@ -91,10 +97,10 @@ EmbThreadList* embThreadList_create(EmbThread data)
 
 EmbThreadList* embThreadList_add(EmbThreadList* pointer, EmbThread data)
 {
-    if(!pointer) { embLog_error("emb-thread.c embThreadList_add(), pointer argument is null\n"); return 0; }
+    if(!pointer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-thread.c embThreadList_add(), pointer argument is null\n"); return 0; }
     if(pointer->next) { embLog_error("emb-thread.c embThreadList_add(), pointer->next should be null\n"); return 0; }
     pointer->next = (EmbThreadList*)malloc(sizeof(EmbThreadList));
-    if(!pointer->next) { embLog_error("emb-thread.c embThreadList_add(), cannot allocate memory for pointer->next\n"); return 0; }
+    if(!pointer->next) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-thread.c embThreadList_add(), cannot allocate memory for pointer->next\n"); return 0; }
     pointer = pointer->next;
     pointer->thread = data;
     pointer->next = 0;
@@ -0,0 +1,339 @@
+#include "emb-tokenizer.h"
+#include "emb-logging.h"
+#include <locale.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Size of the blocks read from files that are not buffered. It doubles for a line that does not fit. */
+#define EMB_TOKENIZER_BLOCK 65536
+
+struct EmbTokenizer_
+{
+    EmbFile* file;
+    char* block;      /* what has been read of a file that is not buffered, or null for a buffered one */
+    long capacity;
+    const char* data; /* the block, or the buffer of a buffered file */
+    long start;       /* the next line starts at data + start */
+    long end;         /* data + end is the end of the characters read so far */
+    int eof;          /* nothing more can be read into data */
+};
+
+/*! Returns a pointer to a new EmbTokenizer reading the lines of \a file from its current position on.
+ *  A buffered \a file is consumed at once, so it must not be read otherwise while the tokenizer is in use.
+ *  The caller is responsible for freeing it with embTokenizer_free(). */
+EmbTokenizer* embTokenizer_create(EmbFile* file)
+{
+    EmbTokenizer* tokenizer = 0;
+
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-tokenizer.c embTokenizer_create(), file argument is null\n"); return 0; }
+
+    tokenizer = (EmbTokenizer*)malloc(sizeof(EmbTokenizer));
+    if(!tokenizer) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-tokenizer.c embTokenizer_create(), cannot allocate memory for tokenizer\n"); return 0; }
+    tokenizer->file = file;
+    tokenizer->block = 0;
+    tokenizer->capacity = 0;
+    tokenizer->data = 0;
+    tokenizer->start = 0;
+    tokenizer->end = 0;
+    tokenizer->eof = 0;
+
+#ifndef ARDUINO
+    if(embFile_isBuffered(file))
+    {
+        /* The whole file is in memory already, so lines are views into its buffer */
+        tokenizer->data = (const char*)file->buffer;
+        tokenizer->start = file->position < file->size ? file->position : file->size;
+        tokenizer->end = file->size;
+        tokenizer->eof = 1;
+        file->position = file->size;
+        return tokenizer;
+    }
+#endif /* ARDUINO */
+
+    tokenizer->block = (char*)malloc(EMB_TOKENIZER_BLOCK);
+    if(!tokenizer->block)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-tokenizer.c embTokenizer_create(), cannot allocate memory for block\n");
+        free(tokenizer);
+        return 0;
+    }
+    tokenizer->capacity = EMB_TOKENIZER_BLOCK;
+    tokenizer->data = tokenizer->block;
+    return tokenizer;
+}
+
+/* Moves the unread characters to the front of the block and reads more after them.
+ * Returns \c false once nothing more can be read. */
+static int embTokenizer_fill(EmbTokenizer* tokenizer)
+{
+    size_t count;
+
+    if(tokenizer->start > 0)
+    {
+        memmove(tokenizer->block, tokenizer->block + tokenizer->start, tokenizer->end - tokenizer->start);
+        tokenizer->end -= tokenizer->start;
+        tokenizer->start = 0;
+    }
+    if(tokenizer->end == tokenizer->capacity)
+    {
+        char* block = (char*)realloc(tokenizer->block, tokenizer->capacity * 2);
+        if(!block)
+        {
+            embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-tokenizer.c embTokenizer_fill(), cannot allocate memory for block\n");
+            tokenizer->eof = 1;
+            return 0;
+        }
+        tokenizer->block = block;
+        tokenizer->data = block;
+        tokenizer->capacity *= 2;
+    }
+    count = embFile_read(tokenizer->block + tokenizer->end, 1, tokenizer->capacity - tokenizer->end, tokenizer->file);
+    if(!count)
+        tokenizer->eof = 1;
+    tokenizer->end += (long)count;
+    return count > 0;
+}
+
+/*! Sets \a line to the next line of the file of \a tokenizer, without its line ending ("\n" or "\r\n").
+ *  The last line does not need a line ending. \a line stays valid until the next call.
+ *  Returns \c true if a line was read, or \c false at the end of the file. */
+int embTokenizer_readLine(EmbTokenizer* tokenizer, EmbToken* line)
+{
+    const char* newline = 0;
+    long scanned = 0;
+    long length;
+
+    if(!tokenizer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-tokenizer.c embTokenizer_readLine(), tokenizer argument is null\n"); return 0; }
+    if(!line) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-tokenizer.c embTokenizer_readLine(), line argument is null\n"); return 0; }
+
+    while(1)
+    {
+        long unread = tokenizer->end - tokenizer->start;
+        newline = (const char*)memchr(tokenizer->data + tokenizer->start + scanned, '\n', unread - scanned);
+        if(newline)
+        {
+            length = (long)(newline - (tokenizer->data + tokenizer->start));
+            break;
+        }
+        scanned = unread;
+        if(tokenizer->eof || !embTokenizer_fill(tokenizer))
+        {
+            if(tokenizer->start == tokenizer->end)
+                return 0;
+            length = tokenizer->end - tokenizer->start;
+            break;
+        }
+    }
+
+    line->data = tokenizer->data + tokenizer->start;
+    tokenizer->start += newline ? length + 1 : length;
+    if(length > 0 && line->data[length - 1] == '\r')
+        length--;
+    line->length = (int)length;
+    return 1;
+}
+
+/*! Frees \a tokenizer. Its file is left open. */
+void embTokenizer_free(EmbTokenizer* tokenizer)
+{
+    if(!tokenizer) return;
+    free(tokenizer->block);
+    free(tokenizer);
+}
+
+static int embToken_isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+/*! Returns \a token without its leading and trailing whitespace. */
+EmbToken embToken_trim(EmbToken token)
+{
+    while(token.length > 0 && embToken_isSpace(token.data[0]))
+    {
+        token.data++;
+        token.length--;
+    }
+    while(token.length > 0 && embToken_isSpace(token.data[token.length - 1]))
+        token.length--;
+    return token;
+}
+
+/*! Returns \c true if \a token holds exactly the characters of the null terminated \a string. */
+int embToken_equals(EmbToken token, const char* string)
+{
+    int i;
+    for(i = 0; i < token.length; i++)
+    {
+        if(string[i] != token.data[i] || !string[i])
+            return 0;
+    }
+    return string[token.length] == '\0';
+}
+
+/*! Splits the next field off \a line, which has fields in double quotes separated by commas, and sets \a field
+ *  to its text without the quotes. Characters outside the quotes are skipped, and commas inside them are kept.
+ *  Returns 1 if a field was found, 0 if \a line has no more fields and -1 if its last quote is not closed. */
+int embToken_nextQuoted(EmbToken* line, EmbToken* field)
+{
+    const char* end = 0;
+    const char* open = 0;
+    const char* close = 0;
+    const char* comma = 0;
+
+    if(!line) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-tokenizer.c embToken_nextQuoted(), line argument is null\n"); return -1; }
+    if(!field) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-tokenizer.c embToken_nextQuoted(), field argument is null\n"); return -1; }
+
+    end = line->data + line->length;
+    open = (const char*)memchr(line->data, '"', line->length);
+    if(!open)
+        return 0;
+    close = (const char*)memchr(open + 1, '"', end - open - 1);
+    if(!close)
+        return -1;
+    field->data = open + 1;
+    field->length = (int)(close - open - 1);
+
+    /* Whatever follows up to the next comma belongs to no field */
+    comma = (const char*)memchr(close + 1, ',', end - close - 1);
+    line->data = comma ? comma + 1 : end;
+    line->length = (int)(end - line->data);
+    return 1;
+}
+
+/*! Copies \a token into \a destination, which holds \a size characters, cutting it short if needed.
+ *  Returns \a destination, which is always null terminated. */
+char* embToken_copy(EmbToken token, char* destination, int size)
+{
+    int length = token.length;
+
+    if(!destination || size <= 0) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-tokenizer.c embToken_copy(), destination argument is null or empty\n"); return destination; }
+    if(length > size - 1)
+        length = size - 1;
+    memcpy(destination, token.data, length);
+    destination[length] = '\0';
+    return destination;
+}
+
+/*! Returns the integer at the start of \a token, as atoi() does. */
+int embToken_toInt(EmbToken token)
+{
+    const char* p = token.data;
+    const char* end = token.data + token.length;
+    long value = 0;
+    int negative = 0;
+
+    while(p < end && embToken_isSpace(*p))
+        p++;
+    if(p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    while(p < end && *p >= '0' && *p <= '9')
+        value = value * 10 + (*p++ - '0');
+    return (int)(negative ? -value : value);
+}
+
+/* Powers of ten that doubles hold exactly */
+static const double embToken_powersOfTen[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Converts \a token with strtod(), which understands every form of number but follows the locale */
+static double embToken_toDoubleSlow(EmbToken token)
+{
+    char local[64];
+    char* copy = local;
+    const char* point = localeconv()->decimal_point;
+    double value;
+    int i;
+
+    if(token.length >= (int)sizeof(local))
+    {
+        copy = (char*)malloc(token.length + 1);
+        if(!copy) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-tokenizer.c embToken_toDoubleSlow(), cannot allocate memory for copy\n"); return 0.0; }
+    }
+    memcpy(copy, token.data, token.length);
+    copy[token.length] = '\0';
+    for(i = 0; i < token.length; i++)
+    {
+        if(copy[i] == '.' && point && point[0])
+            copy[i] = point[0];
+    }
+    value = strtod(copy, 0);
+    if(copy != local)
+        free(copy);
+    return value;
+}
+
+/*! Returns the number at the start of \a token, as atof() does in the "C" locale whatever the current locale is.
+ *  Numbers of up to 15 significant digits and a decimal exponent of at most 22 are converted exactly without strtod(). */
+double embToken_toDouble(EmbToken token)
+{
+    const char* p = token.data;
+    const char* end = token.data + token.length;
+    double mantissa = 0.0;
+    int digits = 0, significant = 0, exponent = 0;
+    int negative = 0;
+
+    while(p < end && embToken_isSpace(*p))
+        p++;
+    if(p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    if(p < end && *p == '0' && p + 1 < end && (p[1] == 'x' || p[1] == 'X'))
+        return embToken_toDoubleSlow(token); /* hexadecimal */
+
+    for(; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+    {
+        if(significant || *p != '0')
+        {
+            mantissa = mantissa * 10.0 + (*p - '0');
+            significant++;
+        }
+    }
+    if(p < end && *p == '.')
+    {
+        for(p++; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+        {
+            if(significant || *p != '0')
+            {
+                mantissa = mantissa * 10.0 + (*p - '0');
+                significant++;
+            }
+            exponent--;
+        }
+    }
+    if(!digits)
+    {
+        if(p < end && (*p == 'i' || *p == 'I' || *p == 'n' || *p == 'N'))
+            return embToken_toDoubleSlow(token); /* infinity or nan */
+        return 0.0;
+    }
+    if(p + 1 < end && (*p == 'e' || *p == 'E'))
+    {
+        const char* q = p + 1;
+        int exponentNegative = 0, value = 0;
+        if(*q == '-' || *q == '+')
+            exponentNegative = *q++ == '-';
+        if(q < end && *q >= '0' && *q <= '9')
+        {
+            for(; q < end && *q >= '0' && *q <= '9'; q++)
+            {
+                if(value < 10000)
+                    value = value * 10 + (*q - '0');
+            }
+            exponent += exponentNegative ? -value : value;
+        }
+    }
+
+    if(significant > 15 || exponent > 22 || exponent < -22)
+        return embToken_toDoubleSlow(token);
+    /* Both operands are exact, so the one rounding of the multiplication or division gives the nearest double */
+    if(exponent < 0)
+        mantissa /= embToken_powersOfTen[-exponent];
+    else
+        mantissa *= embToken_powersOfTen[exponent];
+    return negative ? -mantissa : mantissa;
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -0,0 +1,41 @@
+/*! @file emb-tokenizer.h */
+#ifndef EMB_TOKENIZER_H
+#define EMB_TOKENIZER_H
+
+#include "emb-file.h"
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A run of characters inside a buffer that belongs to someone else. It is not null terminated. */
+typedef struct EmbToken_
+{
+    const char* data;
+    int length;
+} EmbToken;
+
+/* Splits a text file into lines. Buffered files are scanned in place, other files a large block at a time,
+ * and each line is handed out as an EmbToken that stays valid until the next line is read. */
+typedef struct EmbTokenizer_ EmbTokenizer;
+
+extern EMB_PUBLIC EmbTokenizer* EMB_CALL embTokenizer_create(EmbFile* file);
+extern EMB_PUBLIC int EMB_CALL embTokenizer_readLine(EmbTokenizer* tokenizer, EmbToken* line);
+extern EMB_PUBLIC void EMB_CALL embTokenizer_free(EmbTokenizer* tokenizer);
+
+extern EMB_PUBLIC EmbToken EMB_CALL embToken_trim(EmbToken token);
+extern EMB_PUBLIC int EMB_CALL embToken_equals(EmbToken token, const char* string);
+extern EMB_PUBLIC int EMB_CALL embToken_nextQuoted(EmbToken* line, EmbToken* field);
+extern EMB_PUBLIC char* EMB_CALL embToken_copy(EmbToken token, char* destination, int size);
+extern EMB_PUBLIC int EMB_CALL embToken_toInt(EmbToken token);
+extern EMB_PUBLIC double EMB_CALL embToken_toDouble(EmbToken token);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_TOKENIZER_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
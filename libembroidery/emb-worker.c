@@ -0,0 +1,359 @@
+#include "emb-worker.h"
+#include "emb-logging.h"
+#include <stdlib.h>
+
+#if defined(EMB_NO_THREADS)
+/* Tasks run one after another on the calling thread */
+#elif defined(_WIN32)
+/* NOTE: condition variables need Windows Vista or later */
+#if !defined(_WIN32_WINNT)
+#define _WIN32_WINNT 0x0600
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/* The pool never holds more threads than this, however many workers are asked for */
+#define EMB_WORKER_MAX_THREADS 64
+
+struct EmbMutex_
+{
+#if defined(EMB_NO_THREADS)
+    int unused;
+#elif defined(_WIN32)
+    CRITICAL_SECTION section;
+#else
+    pthread_mutex_t mutex;
+#endif
+};
+
+/* Shared by the caller and the pool threads working on one embWorker_run() call. Tasks are handed out one index at a time so slow tasks do not hold up the others. */
+typedef struct EmbWorkerQueue_
+{
+    EmbWorkerTask task;
+    void* userData;
+    int taskCount;
+    int nextTask;
+    EmbMutex* mutex;
+
+    /* NOTE: the fields below are guarded by embMutex_global() */
+    int helpersWanted; /* pool threads that may still join, the queue is listed while this is above 0 */
+    int helpersRunning; /* pool threads draining the queue, the caller waits for them to leave */
+    struct EmbWorkerQueue_* next;
+} EmbWorkerQueue;
+
+/*! Returns the number of processors available to run workers on. Always at least 1. */
+int embWorker_count(void)
+{
+    int count = 1;
+#if defined(EMB_NO_THREADS)
+    count = 1;
+#elif defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    count = (int)info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return count > 0 ? count : 1;
+}
+
+/* Set on threads running tasks alongside others. embWorker_run() calls made from them run on the calling thread,
+ * so a transform inside a batch conversion does not start a second set of workers. */
+static EMB_THREAD_LOCAL int embWorker_inTask = 0;
+
+static void embWorker_drain(EmbWorkerQueue* queue)
+{
+    int index;
+    for(;;)
+    {
+        embMutex_lock(queue->mutex);
+        index = queue->nextTask;
+        if(index < queue->taskCount)
+            queue->nextTask++;
+        embMutex_unlock(queue->mutex);
+
+        if(index >= queue->taskCount)
+            return;
+        queue->task(queue->userData, index);
+    }
+}
+
+#if !defined(EMB_NO_THREADS)
+/* NOTE: The pool is started by the first embWorker_run() call that wants more than one worker and grows up to the
+ * most workers any call has asked for. Its threads wait for queues to help with and last until the process ends.
+ * Everything below is guarded by embMutex_global(). */
+static EmbWorkerQueue* embWorker_queues = 0; /* queues still wanting helpers, oldest first */
+static int embWorker_threads = 0;
+#if defined(_WIN32)
+static CONDITION_VARIABLE embWorker_posted;   /* a queue was listed */
+static CONDITION_VARIABLE embWorker_finished; /* a pool thread left a queue */
+#else
+static pthread_cond_t embWorker_posted = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t embWorker_finished = PTHREAD_COND_INITIALIZER;
+#endif
+
+static void embWorker_wait(int finished)
+{
+#if defined(_WIN32)
+    SleepConditionVariableCS(finished ? &embWorker_finished : &embWorker_posted, &embMutex_global()->section, INFINITE);
+#else
+    pthread_cond_wait(finished ? &embWorker_finished : &embWorker_posted, &embMutex_global()->mutex);
+#endif
+}
+
+static void embWorker_wakeAll(int finished)
+{
+#if defined(_WIN32)
+    WakeAllConditionVariable(finished ? &embWorker_finished : &embWorker_posted);
+#else
+    pthread_cond_broadcast(finished ? &embWorker_finished : &embWorker_posted);
+#endif
+}
+
+static void embWorker_unlist(EmbWorkerQueue* queue)
+{
+    EmbWorkerQueue** link = &embWorker_queues;
+    while(*link && *link != queue)
+        link = &(*link)->next;
+    if(*link)
+        *link = queue->next;
+    queue->next = 0;
+    queue->helpersWanted = 0;
+}
+
+static void embWorker_list(EmbWorkerQueue* queue)
+{
+    EmbWorkerQueue** link = &embWorker_queues;
+    while(*link)
+        link = &(*link)->next;
+    *link = queue;
+}
+
+static void embWorker_pool(void)
+{
+    EmbWorkerQueue* queue = 0;
+
+    embWorker_inTask = 1;
+    embMutex_lock(embMutex_global());
+    for(;;)
+    {
+        while(!embWorker_queues)
+            embWorker_wait(0);
+        queue = embWorker_queues;
+        queue->helpersRunning++;
+        if(--queue->helpersWanted <= 0)
+            embWorker_unlist(queue);
+        embMutex_unlock(embMutex_global());
+
+        embWorker_drain(queue);
+
+        embMutex_lock(embMutex_global());
+        if(--queue->helpersRunning == 0)
+            embWorker_wakeAll(1);
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI embWorker_main(LPVOID unused)
+{
+    (void)unused;
+    embWorker_pool();
+    return 0;
+}
+#else
+static void* embWorker_main(void* unused)
+{
+    (void)unused;
+    embWorker_pool();
+    return 0;
+}
+#endif
+
+/* Starts pool threads until there are \a count of them, or as many as can be started. Called with embMutex_global() locked. */
+static void embWorker_grow(int count)
+{
+#if defined(_WIN32)
+    HANDLE thread;
+    if(!embWorker_threads)
+    {
+        InitializeConditionVariable(&embWorker_posted);
+        InitializeConditionVariable(&embWorker_finished);
+    }
+#else
+    pthread_t thread;
+    pthread_attr_t attributes;
+#endif
+
+    if(count > EMB_WORKER_MAX_THREADS)
+        count = EMB_WORKER_MAX_THREADS;
+#if !defined(_WIN32)
+    if(embWorker_threads >= count || pthread_attr_init(&attributes))
+        return;
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+#endif
+    /* NOTE: if threads cannot be started, the calling thread simply does more of the work */
+    while(embWorker_threads < count)
+    {
+#if defined(_WIN32)
+        thread = CreateThread(0, 0, embWorker_main, 0, 0, 0);
+        if(!thread) break;
+        CloseHandle(thread);
+#else
+        if(pthread_create(&thread, &attributes, embWorker_main, 0)) break;
+#endif
+        embWorker_threads++;
+    }
+#if !defined(_WIN32)
+    pthread_attr_destroy(&attributes);
+#endif
+}
+#endif /* EMB_NO_THREADS */
+
+/*! Calls \a task with \a userData for every index from 0 to \a taskCount - 1, spread over \a workerCount threads
+ *  (including the calling thread). A \a workerCount of 0 or less uses embWorker_count(). Returns when every task has finished.
+ *  The other threads come from a pool shared by every caller, which is started on first use and never holds more than
+ *  EMB_WORKER_MAX_THREADS threads. Calls made from inside a task run every task on the calling thread.
+ *  Tasks may run in any order and at the same time, so they must only share data through \a userData under their own locking.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int embWorker_run(int taskCount, int workerCount, EmbWorkerTask task, void* userData)
+{
+    EmbWorkerQueue queue;
+    int i;
+
+    if(!task) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-worker.c embWorker_run(), task argument is null\n"); return 0; }
+    if(taskCount <= 0) return 1;
+
+    if(workerCount <= 0)
+        workerCount = embWorker_count();
+    if(workerCount > taskCount)
+        workerCount = taskCount;
+#if defined(EMB_NO_THREADS)
+    workerCount = 1;
+#endif
+    if(workerCount <= 1 || embWorker_inTask)
+    {
+        for(i = 0; i < taskCount; i++)
+            task(userData, i);
+        return 1;
+    }
+
+    queue.task = task;
+    queue.userData = userData;
+    queue.taskCount = taskCount;
+    queue.nextTask = 0;
+    queue.mutex = embMutex_create();
+    if(!queue.mutex) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-worker.c embWorker_run(), cannot allocate memory for mutex\n"); return 0; }
+    queue.helpersWanted = workerCount - 1;
+    queue.helpersRunning = 0;
+    queue.next = 0;
+
+#if !defined(EMB_NO_THREADS)
+    embMutex_lock(embMutex_global());
+    embWorker_grow(workerCount - 1);
+    embWorker_list(&queue);
+    embWorker_wakeAll(0);
+    embMutex_unlock(embMutex_global());
+#endif /* EMB_NO_THREADS */
+
+    embWorker_inTask = 1;
+    embWorker_drain(&queue);
+    embWorker_inTask = 0;
+
+#if !defined(EMB_NO_THREADS)
+    /* Every task has been handed out, so no more helpers are needed, but the ones still running must finish */
+    embMutex_lock(embMutex_global());
+    embWorker_unlist(&queue);
+    while(queue.helpersRunning > 0)
+        embWorker_wait(1);
+    embMutex_unlock(embMutex_global());
+#endif /* EMB_NO_THREADS */
+
+    embMutex_free(queue.mutex);
+    return 1;
+}
+
+/*! Returns a pointer to a new, unlocked EmbMutex. The caller is responsible for freeing it with embMutex_free(). */
+EmbMutex* embMutex_create(void)
+{
+    EmbMutex* mutex = (EmbMutex*)malloc(sizeof(EmbMutex));
+    if(!mutex) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "emb-worker.c embMutex_create(), cannot allocate memory for mutex\n"); return 0; }
+#if defined(EMB_NO_THREADS)
+    mutex->unused = 0;
+#elif defined(_WIN32)
+    InitializeCriticalSection(&mutex->section);
+#else
+    if(pthread_mutex_init(&mutex->mutex, 0))
+    {
+        embLog_error("emb-worker.c embMutex_create(), cannot initialize mutex\n");
+        free(mutex);
+        return 0;
+    }
+#endif
+    return mutex;
+}
+
+void embMutex_lock(EmbMutex* mutex)
+{
+    if(!mutex) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-worker.c embMutex_lock(), mutex argument is null\n"); return; }
+#if defined(EMB_NO_THREADS)
+#elif defined(_WIN32)
+    EnterCriticalSection(&mutex->section);
+#else
+    pthread_mutex_lock(&mutex->mutex);
+#endif
+}
+
+void embMutex_unlock(EmbMutex* mutex)
+{
+    if(!mutex) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "emb-worker.c embMutex_unlock(), mutex argument is null\n"); return; }
+#if defined(EMB_NO_THREADS)
+#elif defined(_WIN32)
+    LeaveCriticalSection(&mutex->section);
+#else
+    pthread_mutex_unlock(&mutex->mutex);
+#endif
+}
+
+/* The mutex returned by embMutex_global() */
+#if defined(EMB_NO_THREADS)
+static EmbMutex embMutex_globalMutex = { 0 };
+#elif defined(_WIN32)
+static EmbMutex embMutex_globalMutex;
+static volatile LONG embMutex_globalState = 0; /* 0 before, 1 during and 2 after its initialization */
+#else
+static EmbMutex embMutex_globalMutex = { PTHREAD_MUTEX_INITIALIZER };
+#endif
+
+/* Returns a mutex shared by the whole library, for state that is built on first use and kept until the process ends.
+ * It is ready without being created and must not be freed. */
+EmbMutex* embMutex_global(void)
+{
+#if defined(_WIN32) && !defined(EMB_NO_THREADS)
+    /* NOTE: a CRITICAL_SECTION cannot be initialized statically, so the first caller does it */
+    if(InterlockedCompareExchange(&embMutex_globalState, 1, 0) == 0)
+    {
+        InitializeCriticalSection(&embMutex_globalMutex.section);
+        InterlockedExchange(&embMutex_globalState, 2);
+    }
+    while(embMutex_globalState != 2)
+        Sleep(0);
+#endif
+    return &embMutex_globalMutex;
+}
+
+void embMutex_free(EmbMutex* mutex)
+{
+    if(!mutex) return;
+#if defined(EMB_NO_THREADS)
+#elif defined(_WIN32)
+    DeleteCriticalSection(&mutex->section);
+#else
+    pthread_mutex_destroy(&mutex->mutex);
+#endif
+    free(mutex);
+}
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -0,0 +1,46 @@
+/*! @file emb-worker.h */
+#ifndef EMB_WORKER_H
+#define EMB_WORKER_H
+
+/* Builds without threads run every task on the calling thread.
+ * NOTE: windows.h cannot be compiled in strict ANSI mode (MSVC /Za), so those builds run tasks serially too */
+#if defined(ARDUINO) || (defined(_MSC_VER) && defined(__STDC__))
+#define EMB_NO_THREADS
+#endif
+
+/* Declares a variable with one copy per thread */
+#if defined(EMB_NO_THREADS)
+#define EMB_THREAD_LOCAL
+#elif defined(_MSC_VER)
+#define EMB_THREAD_LOCAL __declspec(thread)
+#else
+#define EMB_THREAD_LOCAL __thread
+#endif
+
+#include "api-start.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Called once for each task index by embWorker_run(). */
+typedef void (*EmbWorkerTask)(void* userData, int index);
+
+typedef struct EmbMutex_ EmbMutex;
+
+extern EMB_PUBLIC int EMB_CALL embWorker_count(void);
+extern EMB_PUBLIC int EMB_CALL embWorker_run(int taskCount, int workerCount, EmbWorkerTask task, void* userData);
+
+extern EMB_PUBLIC EmbMutex* EMB_CALL embMutex_create(void);
+extern EMB_PUBLIC void EMB_CALL embMutex_lock(EmbMutex* mutex);
+extern EMB_PUBLIC void EMB_CALL embMutex_unlock(EmbMutex* mutex);
+extern EMB_PUBLIC void EMB_CALL embMutex_free(EmbMutex* mutex);
+extern EMB_PRIVATE EmbMutex* EMB_CALL embMutex_global(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#include "api-stop.h"
+
+#endif /* EMB_WORKER_H */
+
+/* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
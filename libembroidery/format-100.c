@@ -11,13 +11,13 @@ int read100(EmbPattern* pattern, const char* fileName)
     int stitchType;
     unsigned char b[4];
 
-    if(!pattern) { embLog_error("format-100.c read100(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-100.c read100(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-100.c read100(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-100.c read100(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-100.c read100(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-100.c read100(), cannot open %s for reading\n", fileName);
         return 0;
     }
     embPattern_loadExternalColorFile(pattern, fileName);
@@ -44,12 +44,12 @@ int read100(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int write100(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-100.c write100(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-100.c write100(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-100.c write100(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-100.c write100(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-100.c write100(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-100.c write100(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -8,13 +8,13 @@ int read10o(EmbPattern* pattern, const char* fileName)
 {
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-10o.c read10o(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-10o.c read10o(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-10o.c read10o(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-10o.c read10o(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName,"rb");
     if(!file)
     {
-        embLog_error("format-10o.c read10o(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-10o.c read10o(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -63,12 +63,12 @@ int read10o(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int write10o(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-10o.c write10o(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-10o.c write10o(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-10o.c write10o(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-10o.c write10o(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-10o.c write10o(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-10o.c write10o(), pattern contains no stitches\n");
         return 0;
     }
 
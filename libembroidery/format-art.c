@@ -5,8 +5,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readArt(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-art.c readArt(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-art.c readArt(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-art.c readArt(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-art.c readArt(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish readArt */
 }
 
@@ -14,12 +14,12 @@ int readArt(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeArt(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-art.c writeArt(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-art.c writeArt(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-art.c writeArt(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-art.c writeArt(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-art.c writeArt(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-art.c writeArt(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -5,8 +5,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readBmc(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-bmc.c readBmc(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-bmc.c readBmc(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-bmc.c readBmc(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-bmc.c readBmc(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish readBmc */
 }
 
@@ -14,12 +14,12 @@ int readBmc(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeBmc(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-bmc.c writeBmc(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-bmc.c writeBmc(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-bmc.c writeBmc(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-bmc.c writeBmc(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-bmc.c writeBmc(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-bmc.c writeBmc(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -13,13 +13,13 @@ int readBro(EmbPattern* pattern, const char* fileName)
     int stitchType;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-bro.c readBro(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-bro.c readBro(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-bro.c readBro(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-bro.c readBro(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-bro.c readBro(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-bro.c readBro(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -42,6 +42,8 @@ int readBro(EmbPattern* pattern, const char* fileName)
         stitchType = NORMAL;
         b1 = binaryReadByte(file);
         b2 = binaryReadByte(file);
+        if(embFile_eof(file))
+            break; /* no end code */
         if(b1 == -128)
         {
             unsigned char bCode = binaryReadByte(file);
@@ -76,12 +78,12 @@ int readBro(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeBro(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-bro.c writeBro(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-bro.c writeBro(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-bro.c writeBro(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-bro.c writeBro(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-bro.c writeBro(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-bro.c writeBro(), pattern contains no stitches\n");
         return 0;
     }
 
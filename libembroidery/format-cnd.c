@@ -5,8 +5,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readCnd(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-cnd.c readCnd(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-cnd.c readCnd(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-cnd.c readCnd(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-cnd.c readCnd(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish readCnd */
 }
 
@@ -14,12 +14,12 @@ int readCnd(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeCnd(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-cnd.c writeCnd(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-cnd.c writeCnd(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-cnd.c writeCnd(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-cnd.c writeCnd(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-cnd.c writeCnd(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-cnd.c writeCnd(), pattern contains no stitches\n");
         return 0;
     }
 
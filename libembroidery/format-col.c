@@ -11,8 +11,8 @@ int readCol(EmbPattern* pattern, const char* fileName)
     int numberOfColors, i;
     FILE* file = 0;
 
-    if(!pattern) { embLog_error("format-col.c readCol(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-col.c readCol(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-col.c readCol(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-col.c readCol(), fileName argument is null\n"); return 0; }
 
     file = fopen(fileName, "r");
     if(!file)
@@ -66,13 +66,13 @@ int writeCol(EmbPattern* pattern, const char* fileName)
     int i, colorCount;
     EmbThreadList *colors;
 
-    if(!pattern) { embLog_error("format-col.c writeCol(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-col.c writeCol(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-col.c writeCol(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-col.c writeCol(), fileName argument is null\n"); return 0; }
 
     file = fopen(fileName, "w");
     if(!file)
     {
-        embLog_error("format-col.c writeCol(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-col.c writeCol(), cannot open %s for writing\n", fileName);
         return 0;
     }
     colorCount = embThreadList_count(pattern->threadList);
@@ -8,10 +8,14 @@
 #define CsdSubMaskSize  479
 #define CsdXorMaskSize  501
 
-static char _subMask[CsdSubMaskSize];
-static char _xorMask[CsdXorMaskSize];
+/* Decryption masks of one file, kept per read so several files can be read at once. */
+typedef struct CsdMasks_
+{
+    char subMask[CsdSubMaskSize];
+    char xorMask[CsdXorMaskSize];
+} CsdMasks;
 
-static void BuildDecryptionTable(int seed)
+static void BuildDecryptionTable(CsdMasks* masks, int seed)
 {
     int i;
     const int mul1 = 0x41C64E6D;
@@ -21,17 +25,17 @@ static void BuildDecryptionTable(int seed)
     {
         seed *= mul1;
         seed += add1;
-        _subMask[i] = (char) ((seed >> 16) & 0xFF);
+        masks->subMask[i] = (char) ((seed >> 16) & 0xFF);
     }
     for(i = 0; i < CsdXorMaskSize; i++)
     {
         seed *= mul1;
         seed += add1;
-        _xorMask[i] = (char) ((seed >> 16) & 0xFF);
+        masks->xorMask[i] = (char) ((seed >> 16) & 0xFF);
     }
 }
 
-static unsigned char DecodeCsdByte(long fileOffset, unsigned char val, int type)
+static unsigned char DecodeCsdByte(const CsdMasks* masks, long fileOffset, unsigned char val, int type)
 {
     static const unsigned char _decryptArray[] =
     {
@@ -90,7 +94,7 @@ static unsigned char DecodeCsdByte(long fileOffset, unsigned char val, int type)
     {
         newOffset = (int) fileOffset;
     }
-    return ((unsigned char) ((unsigned char) (val ^ _xorMask[newOffset%CsdXorMaskSize]) - _subMask[newOffset%CsdSubMaskSize]));
+    return ((unsigned char) ((unsigned char) (val ^ masks->xorMask[newOffset%CsdXorMaskSize]) - masks->subMask[newOffset%CsdSubMaskSize]));
 }
 
 /*! Reads a file with the given \a fileName and loads the data into \a pattern.
@@ -106,14 +110,15 @@ int readCsd(EmbPattern* pattern, const char* fileName)
     char endOfStream = 0;
     EmbFile* file = 0;
     unsigned char colorOrder[14];
+    CsdMasks masks;
 
-    if(!pattern) { embLog_error("format-csd.c readCsd(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-csd.c readCsd(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-csd.c readCsd(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-csd.c readCsd(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-csd.c readCsd(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-csd.c readCsd(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -125,36 +130,36 @@ int readCsd(EmbPattern* pattern, const char* fileName)
     }
     if(type == 0)
     {
-        BuildDecryptionTable(0xC);
+        BuildDecryptionTable(&masks, 0xC);
     }
     else
     {
-        BuildDecryptionTable(identifier[0]);
+        BuildDecryptionTable(&masks, identifier[0]);
     }
     embFile_seek(file, 8, SEEK_SET);
     for(i = 0; i < 16; i++)
     {
         EmbThread thread;
-        thread.color.r = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-        thread.color.g = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-        thread.color.b = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
+        thread.color.r = DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
+        thread.color.g = DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
+        thread.color.b = DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
         thread.catalogNumber = "";
         thread.description = "";
         embPattern_addThread(pattern, thread);
     }
-    unknown1 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-    unknown2 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
+    unknown1 = DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
+    unknown2 = DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
 
     for(i = 0; i < 14; i++)
     {
-        colorOrder[i] = (unsigned char) DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
+        colorOrder[i] = (unsigned char) DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
     }
     for(i = 0; !endOfStream; i++)
     {
         char negativeX, negativeY;
-        unsigned char b0 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-        unsigned char b1 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
-        unsigned char b2 = DecodeCsdByte(embFile_tell(file), binaryReadByte(file), type);
+        unsigned char b0 = DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
+        unsigned char b1 = DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
+        unsigned char b2 = DecodeCsdByte(&masks, embFile_tell(file), binaryReadByte(file), type);
 
         if(b0 == 0xF8 || b0 == 0x87 || b0 == 0x91)
         {
@@ -197,12 +202,12 @@ int readCsd(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeCsd(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-csd.c writeCsd(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-csd.c writeCsd(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-csd.c writeCsd(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-csd.c writeCsd(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-csd.c writeCsd(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-csd.c writeCsd(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -1,6 +1,7 @@
 #include "format-csv.h"
 #include "emb-file.h"
 #include "emb-logging.h"
+#include "emb-tokenizer.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -29,24 +30,19 @@ static char* csvStitchFlagToStr(int flags)
     }
 }
 
-static int csvStrToStitchFlag(const char* str)
+static int csvStrToStitchFlag(EmbToken str)
 {
-    if(!str)
-    {
-        embLog_error("format-csv.c csvStrToStitchFlag(), str argument is null\n");
-        return -1;
-    }
-    if(!strcmp(str, "STITCH"))
+    if(embToken_equals(str, "STITCH"))
         return NORMAL;
-    else if(!strcmp(str, "JUMP"))
+    else if(embToken_equals(str, "JUMP"))
         return JUMP;
-    else if(!strcmp(str, "TRIM"))
+    else if(embToken_equals(str, "TRIM"))
         return TRIM;
-    else if(!strcmp(str, "COLOR"))
+    else if(embToken_equals(str, "COLOR"))
         return STOP;
-    else if(!strcmp(str, "END"))
+    else if(embToken_equals(str, "END"))
         return END;
-    else if(!strcmp(str, "UNKNOWN"))
+    else if(embToken_equals(str, "UNKNOWN"))
         return -1;
     return -1;
 }
@@ -56,174 +52,127 @@ static int csvStrToStitchFlag(const char* str)
 int readCsv(EmbPattern* pattern, const char* fileName)
 {
     EmbFile* file = 0;
+    EmbTokenizer* tokenizer = 0;
+    EmbToken line, cell;
     int numColorChanges = 0;
-    int size = 1024;
-    int pos = 0;
-    int c = 0;
     int cellNum = 0;
-    int process = 0;
+    int found = 0;
     int csvMode = CSV_MODE_NULL;
-    int expect = CSV_EXPECT_QUOTE1;
     int flags = 0;
+    int result = 1;
     double xx = 0.0;
     double yy = 0.0;
     unsigned char r = 0, g = 0, b = 0;
-    char* buff = 0;
-
-    if(!pattern) { embLog_error("format-csv.c readCsv(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-csv.c readCsv(), fileName argument is null\n"); return 0; }
 
-    buff = (char*)malloc(size);
-    if(!buff) { embLog_error("format-csv.c readCsv(), unable to allocate memory for buff\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-csv.c readCsv(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-csv.c readCsv(), fileName argument is null\n"); return 0; }
 
-    file = embFile_open(fileName,"r");
+    file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-csv.c readCsv(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-csv.c readCsv(), cannot open %s for reading\n", fileName);
+        return 0;
+    }
+    tokenizer = embTokenizer_create(file);
+    if(!tokenizer)
+    {
+        embFile_close(file);
         return 0;
     }
-    else
+
+    while(result && embTokenizer_readLine(tokenizer, &line))
     {
-        pos = 0;
-        do
+        /* Each line is a record of quoted cells. Lines without any are blank. */
+        csvMode = CSV_MODE_NULL;
+        cellNum = 0;
+        while(result && (found = embToken_nextQuoted(&line, &cell)) > 0)
         {
-            c = embFile_getc(file);
-            switch(c)
+            cellNum++;
+            if(csvMode == CSV_MODE_NULL)
             {
-                case '"':
-                    if(expect == CSV_EXPECT_QUOTE1)
-                    {
-                        expect = CSV_EXPECT_QUOTE2;
-                    }
-                    else if(expect == CSV_EXPECT_QUOTE2)
-                        expect = CSV_EXPECT_COMMA;
-                    break;
-                case ',':
-                    if(expect == CSV_EXPECT_COMMA)
-                    {
-                        process = 1;
-                    }
-                    break;
-                case '\n':
-                    if(expect == CSV_EXPECT_COMMA)
-                    {
-                        process = 1;
-                    }
-                    else if(expect == CSV_EXPECT_QUOTE1)
-                    {
-                        /* Do Nothing. We encountered a blank line. */
-                    }
-                    else
-                    {
-                        embLog_error("format-csv.c readCsv(), premature newline\n");
-                        return 0;
-                    }
-                    break;
+                if     (embToken_equals(cell, "#")) { csvMode = CSV_MODE_COMMENT; }
+                else if(embToken_equals(cell, ">")) { csvMode = CSV_MODE_VARIABLE; }
+                else if(embToken_equals(cell, "$")) { csvMode = CSV_MODE_THREAD; }
+                else if(embToken_equals(cell, "*")) { csvMode = CSV_MODE_STITCH; }
+                else { /* TODO: error */ result = 0; }
             }
-            if(pos >= size - 1)
+            else if(csvMode == CSV_MODE_COMMENT)
             {
-                size *= 2;
-                buff = (char*)realloc(buff,size);
-                if(!buff) { embLog_error("format-csv.c readCsv(), cannot re-allocate memory for buff\n"); return 0; }
+                /* Do Nothing */
             }
-
-            if(process)
+            else if(csvMode == CSV_MODE_VARIABLE)
             {
-                buff[pos] = 0;
-                pos = 0;
-                process = 0;
-                cellNum++;
-                expect = CSV_EXPECT_QUOTE1;
-                if(csvMode == CSV_MODE_NULL)
+                /* Do Nothing */
+            }
+            else if(csvMode == CSV_MODE_THREAD)
+            {
+                if(cellNum == 2)
                 {
-                    if     (!strcmp(buff, "#")) { csvMode = CSV_MODE_COMMENT; }
-                    else if(!strcmp(buff, ">")) { csvMode = CSV_MODE_VARIABLE; }
-                    else if(!strcmp(buff, "$")) { csvMode = CSV_MODE_THREAD; }
-                    else if(!strcmp(buff, "*")) { csvMode = CSV_MODE_STITCH; }
-                    else { /* TODO: error */ return 0; }
+                    /* Do Nothing. Ignore Thread Number */
                 }
-                else if(csvMode == CSV_MODE_COMMENT)
+                else if(cellNum == 3)
+                    r = (unsigned char)embToken_toInt(cell);
+                else if(cellNum == 4)
+                    g = (unsigned char)embToken_toInt(cell);
+                else if(cellNum == 5)
+                    b = (unsigned char)embToken_toInt(cell);
+                else if(cellNum == 6)
                 {
-                    /* Do Nothing */
+                    /* TODO: Thread Description */
                 }
-                else if(csvMode == CSV_MODE_VARIABLE)
+                else if(cellNum == 7)
                 {
-                    /* Do Nothing */
+                    /* TODO: Thread Catalog Number */
+                    EmbThread t;
+                    t.color.r = r;
+                    t.color.g = g;
+                    t.color.b = b;
+                    t.description = "TODO:DESCRIPTION";
+                    t.catalogNumber = "TODO:CATALOG_NUMBER";
+                    embPattern_addThread(pattern, t);
+                    csvMode = CSV_MODE_NULL;
+                    cellNum = 0;
                 }
-                else if(csvMode == CSV_MODE_THREAD)
+                else
                 {
-                    if(cellNum == 2)
-                    {
-                        /* Do Nothing. Ignore Thread Number */
-                    }
-                    else if(cellNum == 3)
-                        r = (unsigned char)atoi(buff);
-                    else if(cellNum == 4)
-                        g = (unsigned char)atoi(buff);
-                    else if(cellNum == 5)
-                        b = (unsigned char)atoi(buff);
-                    else if(cellNum == 6)
-                    {
-                        /* TODO: Thread Description */
-                    }
-                    else if(cellNum == 7)
-                    {
-                        /* TODO: Thread Catalog Number */
-                        EmbThread t;
-                        t.color.r = r;
-                        t.color.g = g;
-                        t.color.b = b;
-                        t.description = "TODO:DESCRIPTION";
-                        t.catalogNumber = "TODO:CATALOG_NUMBER";
-                        embPattern_addThread(pattern, t);
-                        csvMode = CSV_MODE_NULL;
-                        cellNum = 0;
-                    }
-                    else
-                    {
-                        /* TODO: error */
-                        return 0;
-                    }
+                    /* TODO: error */
+                    result = 0;
                 }
-                else if(csvMode == CSV_MODE_STITCH)
+            }
+            else if(csvMode == CSV_MODE_STITCH)
+            {
+                if(cellNum == 2)
                 {
-                    if(cellNum == 2)
-                    {
-                        flags = csvStrToStitchFlag(buff);
-                        if(flags == STOP)
-                            numColorChanges++;
-                    }
-                    else if(cellNum == 3)
-                        xx = atof(buff);
-                    else if(cellNum == 4)
-                    {
-                        yy = atof(buff);
-                        embPattern_addStitchAbs(pattern, xx, yy, flags, 1);
-                        csvMode = CSV_MODE_NULL;
-                        cellNum = 0;
-                    }
-                    else
-                    {
-                        /* TODO: error */
-                        return 0;
-                    }
+                    flags = csvStrToStitchFlag(cell);
+                    if(flags == STOP)
+                        numColorChanges++;
                 }
-
-                if(c == '\n')
+                else if(cellNum == 3)
+                    xx = embToken_toDouble(cell);
+                else if(cellNum == 4)
                 {
+                    yy = embToken_toDouble(cell);
+                    embPattern_addStitchAbs(pattern, xx, yy, flags, 1);
                     csvMode = CSV_MODE_NULL;
                     cellNum = 0;
                 }
-            }
-            else
-            {
-                if(expect == CSV_EXPECT_QUOTE2 && c != '"')
-                    buff[pos++] = (char)c;
+                else
+                {
+                    /* TODO: error */
+                    result = 0;
+                }
             }
         }
-        while(c != EOF);
-        embFile_close(file);
+        if(found < 0)
+        {
+            embLog_error("format-csv.c readCsv(), premature newline\n");
+            result = 0;
+        }
     }
+    embTokenizer_free(tokenizer);
+    embFile_close(file);
+    if(!result)
+        return 0;
 
     /* if not enough colors defined, fill in random colors */
     while(embThreadList_count(pattern->threadList) < numColorChanges)
@@ -231,9 +180,6 @@ int readCsv(EmbPattern* pattern, const char* fileName)
         embPattern_addThread(pattern, embThread_getRandom());
     }
 
-    free(buff);
-    buff = 0;
-
     return 1;
 }
 
@@ -249,11 +195,11 @@ int writeCsv(EmbPattern* pattern, const char* fileName)
     int stitchCount = 0;
     int threadCount = 0;
 
-    if(!pattern) { embLog_error("format-csv.c writeCsv(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-csv.c writeCsv(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-csv.c writeCsv(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-csv.c writeCsv(), fileName argument is null\n"); return 0; }
 
     sList = pattern->stitchList;
-    stitchCount = embStitchList_count(sList);
+    stitchCount = embPattern_stitchCount(pattern);
 
     tList = pattern->threadList;
     threadCount = embThreadList_count(tList);
@@ -262,7 +208,7 @@ int writeCsv(EmbPattern* pattern, const char* fileName)
 
     if(!stitchCount)
     {
-        embLog_error("format-csv.c writeCsv(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-csv.c writeCsv(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -276,7 +222,7 @@ int writeCsv(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "w");
     if(!file)
     {
-        embLog_error("format-csv.c writeCsv(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-csv.c writeCsv(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
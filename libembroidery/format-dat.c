@@ -10,13 +10,13 @@ int readDat(EmbPattern* pattern, const char* fileName)
     int fileLength, stitchesRemaining;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-dat.c readDat(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dat.c readDat(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dat.c readDat(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dat.c readDat(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-dat.c readDat(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-dat.c readDat(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -69,12 +69,12 @@ int readDat(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeDat(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-dat.c writeDat(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dat.c writeDat(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dat.c writeDat(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dat.c writeDat(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-dat.c writeDat(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-dat.c writeDat(), pattern contains no stitches\n");
         return 0;
     }
 
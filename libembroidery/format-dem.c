@@ -5,8 +5,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readDem(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-dem.c readDem(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dem.c readDem(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dem.c readDem(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dem.c readDem(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish readDem */
 }
 
@@ -14,12 +14,12 @@ int readDem(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeDem(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-dem.c writeDem(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dem.c writeDem(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dem.c writeDem(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dem.c writeDem(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-dem.c writeDem(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-dem.c writeDem(), pattern contains no stitches\n");
         return 0;
     }
 
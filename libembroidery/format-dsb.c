@@ -11,13 +11,13 @@ int readDsb(EmbPattern* pattern, const char* fileName)
 {
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-dsb.c readDsb(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dsb.c readDsb(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dsb.c readDsb(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dsb.c readDsb(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName,"rb");
     if(!file)
     {
-        embLog_error("format-dsb.c readDsb(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-dsb.c readDsb(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -66,12 +66,12 @@ int readDsb(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeDsb(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-dsb.c writeDsb(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dsb.c writeDsb(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dsb.c writeDsb(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dsb.c writeDsb(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-dsb.c writeDsb(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-dsb.c writeDsb(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -6,39 +6,17 @@
 #include "format-dst.h"
 #include "emb-file.h"
 #include "emb-logging.h"
+#include "emb-record.h"
 #include "helpers-binary.h"
 #include "helpers-misc.h"
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
 
-static int decode_record_flags(unsigned char b2)
-{
-    int returnCode = 0;
-    if(b2 == 0xF3)
-    {
-        return END;
-    }
-    if(b2 & 0x80)
-    {
-        returnCode |= JUMP;
-    }
-    if(b2 & 0x40)
-    {
-        returnCode |= STOP;
-    }
-    return returnCode;
-}
-
-static unsigned char setbit(int pos)
-{
-    return (unsigned char)(1 << pos);
-}
-
 /* TODO: review this then remove since emb-pattern.c has a similar function */
 /* void combineJumpStitches(EmbPattern* p, int jumpsPerTrim)
 {
-    if(!p) { embLog_error("format-dst.c combineJumpStitches(), p argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dst.c combineJumpStitches(), p argument is null\n"); return; }
     EmbStitchList* pointer = p->stitchList;
     int jumpCount = 0;
     EmbStitchList* jumpListStart = 0;
@@ -86,71 +64,6 @@ static unsigned char setbit(int pos)
 }
 */
 
-static void encode_record(EmbFile* file, int x, int y, int flags)
-{
-    char b0, b1, b2;
-    b0 = b1 = b2 = 0;
-
-    /* cannot encode values > +121 or < -121. */
-    if(x > 121 || x < -121) embLog_error("format-dst.c encode_record(), x is not in valid range [-121,121] , x = %d\n", x);
-    if(y > 121 || y < -121) embLog_error("format-dst.c encode_record(), y is not in valid range [-121,121] , y = %d\n", y);
-
-    if(x >= +41) { b2 += setbit(2); x -= 81; }
-    if(x <= -41) { b2 += setbit(3); x += 81; }
-    if(x >= +14) { b1 += setbit(2); x -= 27; }
-    if(x <= -14) { b1 += setbit(3); x += 27; }
-    if(x >=  +5) { b0 += setbit(2); x -= 9; }
-    if(x <=  -5) { b0 += setbit(3); x += 9; }
-    if(x >=  +2) { b1 += setbit(0); x -= 3; }
-    if(x <=  -2) { b1 += setbit(1); x += 3; }
-    if(x >=  +1) { b0 += setbit(0); x -= 1; }
-    if(x <=  -1) { b0 += setbit(1); x += 1; }
-    if(x !=   0) { embLog_error("format-dst.c encode_record(), x should be zero yet x = %d\n", x); }
-    if(y >= +41) { b2 += setbit(5); y -= 81; }
-    if(y <= -41) { b2 += setbit(4); y += 81; }
-    if(y >= +14) { b1 += setbit(5); y -= 27; }
-    if(y <= -14) { b1 += setbit(4); y += 27; }
-    if(y >=  +5) { b0 += setbit(5); y -= 9; }
-    if(y <=  -5) { b0 += setbit(4); y += 9; }
-    if(y >=  +2) { b1 += setbit(7); y -= 3; }
-    if(y <=  -2) { b1 += setbit(6); y += 3; }
-    if(y >=  +1) { b0 += setbit(7); y -= 1; }
-    if(y <=  -1) { b0 += setbit(6); y += 1; }
-    if(y !=   0) { embLog_error("format-dst.c encode_record(), y should be zero yet y = %d\n", y); }
-
-    b2 |= (char) 3;
-
-    if(flags & END)
-    {
-        b2 = (char) -13;
-        b0 = b1 = (char) 0;
-    }
-
-    /* if(flags & TRIM)
-    {
-        int v = 5;
-        int dx = (int)(x/v), dy = (int)(y/v);
-        for(i = 1; i < v; i++)
-        {
-            encode_record(file, dx, dy, JUMP);
-        }
-        encode_record(file, x - (dx * (v - 1)), y - (dy * (v - 1)), JUMP);
-        return;
-    } */
-    if(flags & (JUMP | TRIM))
-    {
-        b2 = (char) (b2 | 0x83);
-    }
-    if(flags & STOP)
-    {
-        b2 = (char) (b2 | 0xC3);
-    }
-
-    binaryWriteByte(file, (unsigned char)b0);
-    binaryWriteByte(file, (unsigned char)b1);
-    binaryWriteByte(file, (unsigned char)b2);
-}
-
 /*convert 2 characters into 1 int for case statement */
 /*#define cci(s) (s[0]*256+s[1]) */
 #define cci(c1,c2) (c1*256+c2)
@@ -227,11 +140,9 @@ int readDst(EmbPattern* pattern, const char* fileName)
     char var[3];   /* temporary storage variable name */
     char val[512]; /* temporary storage variable value */
     int valpos;
-    unsigned char b[3];
     char header[512 + 1];
     EmbFile* file = 0;
     int i = 0;
-    int flags; /* for converting stitches from file encoding */
 
     /*
     * The header seems to contain information about the design.
@@ -284,13 +195,13 @@ int readDst(EmbPattern* pattern, const char* fileName)
     pattern->set_variable("file_name",filename);
     */
 
-    if(!pattern) { embLog_error("format-dst.c readDst(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dst.c readDst(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dst.c readDst(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dst.c readDst(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-dst.c readDst(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-dst.c readDst(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -330,57 +241,7 @@ int readDst(EmbPattern* pattern, const char* fileName)
         }
     }
 
-    while(embFile_read(b, 1, 3, file) == 3)
-    {
-        int x = 0;
-        int y = 0;
-        if(b[0] & 0x01)
-            x += 1;
-        if(b[0] & 0x02)
-            x -= 1;
-        if(b[0] & 0x04)
-            x += 9;
-        if(b[0] & 0x08)
-            x -= 9;
-        if(b[0] & 0x80)
-            y += 1;
-        if(b[0] & 0x40)
-            y -= 1;
-        if(b[0] & 0x20)
-            y += 9;
-        if(b[0] & 0x10)
-            y -= 9;
-        if(b[1] & 0x01)
-            x += 3;
-        if(b[1] & 0x02)
-            x -= 3;
-        if(b[1] & 0x04)
-            x += 27;
-        if(b[1] & 0x08)
-            x -= 27;
-        if(b[1] & 0x80)
-            y += 3;
-        if(b[1] & 0x40)
-            y -= 3;
-        if(b[1] & 0x20)
-            y += 27;
-        if(b[1] & 0x10)
-            y -= 27;
-        if(b[2] & 0x04)
-            x += 81;
-        if(b[2] & 0x08)
-            x -= 81;
-        if(b[2] & 0x20)
-            y += 81;
-        if(b[2] & 0x10)
-            y -= 81;
-        flags = decode_record_flags(b[2]);
-        if(flags == END)
-        {
-            break;
-        }
-        embPattern_addStitchRel(pattern, x / 10.0, y / 10.0, flags, 1);
-    }
+    embRecord_readStitches(pattern, file, embRecord_decodeDst, -1);
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
@@ -391,48 +252,13 @@ int readDst(EmbPattern* pattern, const char* fileName)
     return 1;
 }
 
-/*! Writes the data from \a pattern to a file with the given \a fileName.
- *  Returns \c true if successful, otherwise returns \c false. */
-int writeDst(EmbPattern* pattern, const char* fileName)
+/* Writes the 512 byte header for a design with \a st stitches, \a co colors and extents \a boundingRect. */
+static void dstWriteHeader(EmbFile* file, int st, int co, EmbRect boundingRect)
 {
-    EmbRect boundingRect;
-    EmbFile* file = 0;
-    int xx, yy, dx, dy, flags;
     int i;
-    int co = 1, st = 0;
     int ax, ay, mx, my;
     char* pd = 0;
-    EmbStitchList* pointer = 0;
-
-    if(!pattern) { embLog_error("format-dst.c writeDst(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dst.c writeDst(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
-    {
-        embLog_error("format-dst.c writeDst(), pattern contains no stitches\n");
-        return 0;
-    }
-
-    /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
-
-    file = embFile_open(fileName, "wb");
-    if(!file)
-    {
-        embLog_error("format-dst.c writeDst(), cannot open %s for writing\n", fileName);
-        return 0;
-    }
-
-    embPattern_correctForMaxStitchLength(pattern, 12.1, 12.1);
-
-    xx = yy = 0;
-    co = 1;
-    co = embThreadList_count(pattern->threadList);
-    st = 0;
-    st = embStitchList_count(pattern->stitchList);
-    flags = NORMAL;
-    boundingRect = embPattern_calcBoundingBox(pattern);
     /* TODO: review the code below
     if(pattern->get_variable("design_name") != NULL)
     {
@@ -481,20 +307,69 @@ int writeDst(EmbPattern* pattern, const char* fileName)
     {
         embFile_printf(file, " ");
     }
+}
+
+/*! Writes the data from \a pattern to a file with the given \a fileName.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int writeDst(EmbPattern* pattern, const char* fileName)
+{
+    EmbRect boundingRect;
+    EmbFile* file = 0;
+    int xx, yy, count;
+    int co = 1, st = 0;
+    EmbStitchList* pointer = 0;
+    EmbRecord records[EMB_RECORD_BLOCK];
+    unsigned char buffer[EMB_RECORD_BLOCK * 3];
+
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dst.c writeDst(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dst.c writeDst(), fileName argument is null\n"); return 0; }
+
+    if(!embPattern_stitchCount(pattern))
+    {
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-dst.c writeDst(), pattern contains no stitches\n");
+        return 0;
+    }
+
+    /* Check for an END stitch and add one if it is not present */
+    if(pattern->lastStitch->stitch.flags != END)
+        embPattern_addStitchRel(pattern, 0, 0, END, 1);
+
+    file = embFile_open(fileName, "wb");
+    if(!file)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-dst.c writeDst(), cannot open %s for writing\n", fileName);
+        return 0;
+    }
+
+    embPattern_correctForMaxStitchLength(pattern, 12.1, 12.1);
 
-    /* write stitches */
     xx = yy = 0;
+    co = 1;
+    co = embThreadList_count(pattern->threadList);
+    st = 0;
+    st = embPattern_stitchCount(pattern);
+    boundingRect = embPattern_calcBoundingBox(pattern);
+    dstWriteHeader(file, st, co, boundingRect);
+
+    /* write stitches, a block of records at a time */
+    xx = yy = 0;
+    count = 0;
     pointer = pattern->stitchList;
     while(pointer)
     {
         /* convert from mm to 0.1mm for file format */
-        dx = roundDouble(pointer->stitch.xx * 10.0) - xx;
-        dy = roundDouble(pointer->stitch.yy * 10.0) - yy;
+        records[count].dx = roundDouble(pointer->stitch.xx * 10.0) - xx;
+        records[count].dy = roundDouble(pointer->stitch.yy * 10.0) - yy;
+        records[count].flags = pointer->stitch.flags;
         xx = roundDouble(pointer->stitch.xx * 10.0);
         yy = roundDouble(pointer->stitch.yy * 10.0);
-        flags = pointer->stitch.flags;
-        encode_record(file, dx, dy, flags);
+        count++;
         pointer = pointer->next;
+        if(count == EMB_RECORD_BLOCK || !pointer)
+        {
+            embFile_write(buffer, 1, (size_t)embRecord_encodeDst(records, count, buffer), file);
+            count = 0;
+        }
     }
     binaryWriteByte(file, 0xA1); /* finish file with a terminator character */
     binaryWriteShort(file, 0);
@@ -502,4 +377,49 @@ int writeDst(EmbPattern* pattern, const char* fileName)
     return 1;
 }
 
+static void dstStreamEncode(EmbStreamWriter* writer, EmbStitch st)
+{
+    EmbRecord record;
+    unsigned char b[3];
+
+    /* convert from mm to 0.1mm for file format */
+    record.dx = roundDouble(st.xx * 10.0) - roundDouble(writer->previous.xx * 10.0);
+    record.dy = roundDouble(st.yy * 10.0) - roundDouble(writer->previous.yy * 10.0);
+    record.flags = st.flags;
+    embFile_write(b, 1, (size_t)embRecord_encodeDst(&record, 1, b), writer->file);
+}
+
+static int dstStreamEnd(EmbStreamWriter* writer, EmbPattern* pattern)
+{
+    binaryWriteByte(writer->file, 0xA1); /* finish file with a terminator character */
+    binaryWriteShort(writer->file, 0);
+
+    /* The stitch count, extents and colors are only known now, so patch them into the header */
+    if(embFile_seek(writer->file, 0, SEEK_SET))
+    {
+        embLog_error("format-dst.c dstStreamEnd(), cannot seek back to the header\n");
+        return 0;
+    }
+    dstWriteHeader(writer->file, writer->stitchCount, embThreadList_count(pattern->threadList), writer->bounds);
+    return 1;
+}
+
+/*! Starts streaming a DST file to \a writer by writing a placeholder header that dstStreamEnd() patches.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int dstStreamBegin(EmbStreamWriter* writer)
+{
+    EmbRect empty;
+
+    if(!writer) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dst.c dstStreamBegin(), writer argument is null\n"); return 0; }
+
+    writer->encode = dstStreamEncode;
+    writer->end = dstStreamEnd;
+    writer->maxStitchLength = 12.1;
+    writer->maxJumpLength = 12.1;
+
+    empty.left = empty.top = empty.right = empty.bottom = 0.0;
+    dstWriteHeader(writer->file, 0, 1, empty);
+    return 1;
+}
+
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
@@ -8,13 +8,13 @@ int readDsz(EmbPattern* pattern, const char* fileName)
 {
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-dsz.c readDsz(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dsz.c readDsz(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dsz.c readDsz(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dsz.c readDsz(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName,"rb");
     if(!file)
     {
-        embLog_error("format-dsz.c readDsz(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-dsz.c readDsz(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -62,12 +62,12 @@ int readDsz(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeDsz(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-dsz.c writeDsz(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dsz.c writeDsz(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dsz.c writeDsz(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dsz.c writeDsz(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-dsz.c writeDsz(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-dsz.c writeDsz(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -2,6 +2,7 @@
 #include "helpers-misc.h"
 #include "emb-hash.h"
 #include "emb-logging.h"
+#include "emb-tokenizer.h"
 
 #include "geom-arc.h"
 /*#include "geom-line.h" */
@@ -292,12 +293,16 @@ static const unsigned char _dxfColorTable[][3] = {
 {   0,   0,   0 }  /* '256' (BYLAYER) */
 };
 
-char* readLine(FILE* file)
+/* Returns the next line of \a tokenizer without surrounding whitespace, or an empty token at the end of the file */
+static EmbToken dxfReadLine(EmbTokenizer* tokenizer)
 {
-    char str[255];
-    /* TODO: replace all scanf code */
-    fscanf(file, "%s", str);
-    return lTrim(str, ' ');
+    EmbToken line;
+    if(!embTokenizer_readLine(tokenizer, &line))
+    {
+        line.data = "";
+        line.length = 0;
+    }
+    return embToken_trim(line);
 }
 
 /*! Reads a file with the given \a fileName and loads the data into \a pattern.
@@ -305,172 +310,173 @@ char* readLine(FILE* file)
 int readDxf(EmbPattern* pattern, const char* fileName)
 {
 
-    FILE* file = 0;
-    char* buff = "";
+    EmbFile* file = 0;
+    EmbTokenizer* tokenizer = 0;
+    EmbToken line;
+    EmbToken buff;
 
-    char* dxfVersion = "";
-    char* section = "";
-    char* tableName = "";
-    char* layerName = "";
-    char* entityType = "";
-    EmbHash* layerColorHash = 0; /* hash <layerName, EmbColor> */
+    EmbToken dxfVersion;
+    char section[32] = "";
+    char tableName[32] = "";   /* empty outside of a table */
+    char layerName[256] = "";  /* empty once its color is known */
+    char entityType[32] = "";  /* empty outside of an entity */
+    EmbHash* layerColorHash = 0; /* hash <layerName, row of _dxfColorTable> */
 
     int eof = 0; /* End Of File */
 
     double bulge = 0.0, firstX = 0.0, firstY = 0.0, x = 0.0, y, prevX = 0.0, prevY = 0.0;
     char firstStitch = 1;
     char bulgeFlag = 0;
-    int fileLength = 0;
     unsigned char colorNum = 0;
 
-    if(!pattern) { embLog_error("format-dxf.c readDxf(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dxf.c readDxf(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dxf.c readDxf(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dxf.c readDxf(), fileName argument is null\n"); return 0; }
 
     layerColorHash = embHash_create();
-    if(!layerColorHash) { embLog_error("format-dxf.c readDxf(), unable to allocate memory for layerColorHash\n"); return 0; }
+    if(!layerColorHash) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-dxf.c readDxf(), unable to allocate memory for layerColorHash\n"); return 0; }
 
-    file = fopen(fileName, "r");
+    file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-dxf.c readDxf(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-dxf.c readDxf(), cannot open %s for reading\n", fileName);
+        embHash_free(layerColorHash);
+        return 0;
+    }
+    tokenizer = embTokenizer_create(file);
+    if(!tokenizer)
+    {
+        embFile_close(file);
+        embHash_free(layerColorHash);
         return 0;
     }
 
-    fseek(file, 0L, SEEK_END);
-
-    fileLength = ftell(file);
-    fseek(file, 0L, SEEK_SET);
-
-    while(ftell(file) < fileLength)
+    while(embTokenizer_readLine(tokenizer, &line))
     {
-        buff = readLine(file);
-        /*printf("%s\n", buff);*/
-        if( (!strcmp(buff, "HEADER"))   ||
-            (!strcmp(buff, "CLASSES"))  ||
-            (!strcmp(buff, "TABLES"))   ||
-            (!strcmp(buff, "BLOCKS"))   ||
-            (!strcmp(buff, "ENTITIES")) ||
-            (!strcmp(buff, "OBJECTS"))  ||
-            (!strcmp(buff, "THUMBNAILIMAGE")))
+        buff = embToken_trim(line);
+        if( (embToken_equals(buff, "HEADER"))   ||
+            (embToken_equals(buff, "CLASSES"))  ||
+            (embToken_equals(buff, "TABLES"))   ||
+            (embToken_equals(buff, "BLOCKS"))   ||
+            (embToken_equals(buff, "ENTITIES")) ||
+            (embToken_equals(buff, "OBJECTS"))  ||
+            (embToken_equals(buff, "THUMBNAILIMAGE")))
         {
-            section = buff;
-            printf("SECTION:%s\n", buff);
+            embToken_copy(buff, section, sizeof(section));
+            embLog_print("SECTION:%s\n", section);
         }
-        if(!strcmp(buff, "ENDSEC"))
+        if(embToken_equals(buff, "ENDSEC"))
         {
-            section = "";
-            printf("ENDSEC:%s\n", buff);
+            section[0] = '\0';
+            embLog_print("ENDSEC:%.*s\n", buff.length, buff.data);
         }
-        if( (!strcmp(buff, "ARC"))        ||
-            (!strcmp(buff, "CIRCLE"))     ||
-            (!strcmp(buff, "ELLIPSE"))    ||
-            (!strcmp(buff, "LINE"))       ||
-            (!strcmp(buff, "LWPOLYLINE")) ||
-            (!strcmp(buff, "POINT")))
+        if( (embToken_equals(buff, "ARC"))        ||
+            (embToken_equals(buff, "CIRCLE"))     ||
+            (embToken_equals(buff, "ELLIPSE"))    ||
+            (embToken_equals(buff, "LINE"))       ||
+            (embToken_equals(buff, "LWPOLYLINE")) ||
+            (embToken_equals(buff, "POINT")))
         {
-            entityType = buff;
+            embToken_copy(buff, entityType, sizeof(entityType));
         }
-        if(!strcmp(buff, "EOF"))
+        if(embToken_equals(buff, "EOF"))
         {
             eof = 1;
         }
 
         if(!strcmp(section, "HEADER"))
         {
-            if(!strcmp(buff, "$ACADVER"))
+            if(embToken_equals(buff, "$ACADVER"))
             {
-                buff = readLine(file);
-                dxfVersion = readLine(file);
+                buff = dxfReadLine(tokenizer);
+                dxfVersion = dxfReadLine(tokenizer);
                 /* TODO: Allow these versions when POLYLINE is handled. */
-                if((!strcmp(dxfVersion, DXF_VERSION_R10))
-                || (!strcmp(dxfVersion, DXF_VERSION_R11))
-                || (!strcmp(dxfVersion, DXF_VERSION_R12))
-                || (!strcmp(dxfVersion, DXF_VERSION_R13)))
+                if((embToken_equals(dxfVersion, DXF_VERSION_R10))
+                || (embToken_equals(dxfVersion, DXF_VERSION_R11))
+                || (embToken_equals(dxfVersion, DXF_VERSION_R12))
+                || (embToken_equals(dxfVersion, DXF_VERSION_R13)))
+                {
+                    embTokenizer_free(tokenizer);
+                    embFile_close(file);
+                    embHash_free(layerColorHash);
                     return 0;
+                }
             }
         }
         else if(!strcmp(section,"TABLES"))
         {
-            if(!strcmp(buff,"ENDTAB"))
+            if(embToken_equals(buff, "ENDTAB"))
             {
-                tableName = NULL;
+                tableName[0] = '\0';
             }
 
-            if(tableName == NULL)
+            if(!tableName[0])
             {
-                if(!strcmp(buff,"2")) /* Table Name */
+                if(embToken_equals(buff, "2")) /* Table Name */
                 {
-                    tableName = readLine(file);
+                    embToken_copy(dxfReadLine(tokenizer), tableName, sizeof(tableName));
                 }
             }
             else if(!strcmp(tableName, "LAYER"))
             {
                 /* Common Group Codes for Tables */
-                if(!strcmp(buff,"5")) /* Handle */
+                if(embToken_equals(buff, "5")) /* Handle */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
-                else if(!strcmp(buff,"330")) /* Soft Pointer */
+                else if(embToken_equals(buff, "330")) /* Soft Pointer */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
-                else if(!strcmp(buff,"100")) /* Subclass Marker */
+                else if(embToken_equals(buff, "100")) /* Subclass Marker */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
-                else if(!strcmp(buff,"70")) /* Number of Entries in Table */
+                else if(embToken_equals(buff, "70")) /* Number of Entries in Table */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
                 /* The meaty stuff */
-                else if(!strcmp(buff,"2")) /* Layer Name */
+                else if(embToken_equals(buff, "2")) /* Layer Name */
                 {
-                    layerName = readLine(file);
+                    embToken_copy(dxfReadLine(tokenizer), layerName, sizeof(layerName));
                 }
-                else if(!strcmp(buff,"62")) /* Color Number */
+                else if(embToken_equals(buff, "62")) /* Color Number */
                 {
-                    buff = readLine(file);
-                    colorNum = atoi(buff);
-/*
-                    TODO: finish this
-                    unsigned char colorNum = atoi(buff);
-                    EmbColor* co = embColor_create(_dxfColorTable[colorNum][0], _dxfColorTable[colorNum][1], _dxfColorTable[colorNum][2]);
-                    if(!co) { / TODO: error allocating memory for EmbColor  return 0; }
-                    printf("inserting:%s,%d,%d,%d\n", layerName, co->r, co->g, co->b);
-                    if(embHash_insert(layerColorHash, emb_strdup(layerName), co))
+                    buff = dxfReadLine(tokenizer);
+                    colorNum = (unsigned char)embToken_toInt(buff);
+                    if(layerName[0] && embHash_insert(layerColorHash, layerName, (void*)_dxfColorTable[colorNum]))
                     {
-                         TODO: log error: failed inserting into layerColorHash
+                        embLog_error("format-dxf.c readDxf(), failed inserting %s into layerColorHash\n", layerName);
                     }
-*/
-                    layerName = NULL;
+                    layerName[0] = '\0';
                 }
             }
         }
         else if(!strcmp(section,"ENTITIES"))
         {
             /* Common Group Codes for Entities */
-            if(!strcmp(buff, "5")) /* Handle */
+            if(embToken_equals(buff, "5")) /* Handle */
             {
-                buff = readLine(file);
+                buff = dxfReadLine(tokenizer);
                 continue;
             }
-            else if(!strcmp(buff, "330")) /* Soft Pointer */
+            else if(embToken_equals(buff, "330")) /* Soft Pointer */
             {
-                buff = readLine(file);
+                buff = dxfReadLine(tokenizer);
                 continue;
             }
-            else if(!strcmp(buff, "100")) /* Subclass Marker */
+            else if(embToken_equals(buff, "100")) /* Subclass Marker */
             {
-                buff = readLine(file);
+                buff = dxfReadLine(tokenizer);
                 continue;
             }
-            else if(!strcmp(buff, "8")) /* Layer Name */
+            else if(embToken_equals(buff, "8")) /* Layer Name */
             {
-                buff = readLine(file);
+                buff = dxfReadLine(tokenizer);
                 /* embPattern_changeColor(pattern, colorIndexMap[buff]); TODO: port to C */
                 continue;
             }
@@ -480,48 +486,48 @@ int readDxf(EmbPattern* pattern, const char* fileName)
                 double* arcMidX = 0;
                 double* arcMidY = 0;
                 /* The not so important group codes */
-                if(!strcmp(buff, "90")) /* Vertices */
+                if(embToken_equals(buff, "90")) /* Vertices */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
-                else if(!strcmp(buff,"70")) /* Polyline Flag */
+                else if(embToken_equals(buff, "70")) /* Polyline Flag */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
                 /* TODO: Try to use the widths at some point */
-                else if(!strcmp(buff,"40")) /* Starting Width */
+                else if(embToken_equals(buff, "40")) /* Starting Width */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
-                else if(!strcmp(buff,"41")) /* Ending Width */
+                else if(embToken_equals(buff, "41")) /* Ending Width */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
-                else if(!strcmp(buff,"43")) /* Constant Width */
+                else if(embToken_equals(buff, "43")) /* Constant Width */
                 {
-                    buff = readLine(file);
+                    buff = dxfReadLine(tokenizer);
                     continue;
                 }
                 /* The meaty stuff */
-                else if(!strcmp(buff,"42")) /* Bulge */
+                else if(embToken_equals(buff, "42")) /* Bulge */
                 {
-                    buff = readLine(file);
-                    bulge = atof(buff);
+                    buff = dxfReadLine(tokenizer);
+                    bulge = embToken_toDouble(buff);
                     bulgeFlag = 1;
                 }
-                else if(!strcmp(buff,"10")) /* X */
+                else if(embToken_equals(buff, "10")) /* X */
                 {
-                    buff = readLine(file);
-                    x = atof(buff);
+                    buff = dxfReadLine(tokenizer);
+                    x = embToken_toDouble(buff);
                 }
-                else if(!strcmp(buff,"20")) /* Y */
+                else if(embToken_equals(buff, "20")) /* Y */
                 {
-                    buff = readLine(file);
-                    y = atof(buff);
+                    buff = dxfReadLine(tokenizer);
+                    y = embToken_toDouble(buff);
 
                     if(bulgeFlag)
                     {
@@ -529,6 +535,9 @@ int readDxf(EmbPattern* pattern, const char* fileName)
                         if(!getArcDataFromBulge(bulge, prevX, prevY, x, y, arcMidX, arcMidY, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0))
                         {
                             /*TODO: error */
+                            embTokenizer_free(tokenizer);
+                            embFile_close(file);
+                            embHash_free(layerColorHash);
                             return 0;
                         }
                         if(firstStitch)
@@ -551,9 +560,9 @@ int readDxf(EmbPattern* pattern, const char* fileName)
                         firstStitch = 0;
                     }
                 }
-                else if(!strcmp(buff,"0"))
+                else if(embToken_equals(buff, "0"))
                 {
-                    entityType = NULL;
+                    entityType[0] = '\0';
                     firstStitch = 1;
                     if(bulgeFlag)
                     {
@@ -561,6 +570,9 @@ int readDxf(EmbPattern* pattern, const char* fileName)
                         if(!getArcDataFromBulge(bulge, prevX, prevY, firstX, firstY, arcMidX, arcMidY, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0))
                         {
                             /*TODO: error */
+                            embTokenizer_free(tokenizer);
+                            embFile_close(file);
+                            embHash_free(layerColorHash);
                             return 0;
                         }
                         /* embPattern_addStitchAbs(pattern, prevX, prevY, ARC, 1); TODO: Add arcTo point to embPath pointList */
@@ -574,14 +586,9 @@ int readDxf(EmbPattern* pattern, const char* fileName)
         } /* end ENTITIES section */
     } /* end while loop */
 
-    fclose(file);
-
-    /*
-    EmbColor* testColor = 0;
-    testColor = embHash_value(layerColorHash, "OMEGA");
-    if(!testColor) printf("NULL POINTER!!!!!!!!!!!!!!\n");
-    else printf("LAYERCOLOR: %d,%d,%d\n", testColor->r, testColor->g, testColor->b);
-    */
+    embTokenizer_free(tokenizer);
+    embFile_close(file);
+    embHash_free(layerColorHash);
 
     if(!eof)
     {
@@ -595,8 +602,8 @@ int readDxf(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeDxf(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-dxf.c writeDxf(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-dxf.c writeDxf(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dxf.c writeDxf(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-dxf.c writeDxf(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish writeDxf */
 }
 
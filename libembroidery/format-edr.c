@@ -12,8 +12,8 @@ int readEdr(EmbPattern* pattern, const char* fileName)
     int i;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-edr.c readEdr(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-edr.c readEdr(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-edr.c readEdr(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-edr.c readEdr(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
@@ -51,13 +51,13 @@ int writeEdr(EmbPattern* pattern, const char* fileName)
     EmbThreadList* pointer = 0;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-edr.c writeEdr(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-edr.c writeEdr(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-edr.c writeEdr(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-edr.c writeEdr(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-edr.c writeEdr(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-edr.c writeEdr(), cannot open %s for writing\n", fileName);
         return 0;
     }
     pointer = pattern->threadList;
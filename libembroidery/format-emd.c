@@ -21,13 +21,13 @@ int readEmd(EmbPattern* pattern, const char* fileName)
     int i;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-emd.c readEmd(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-emd.c readEmd(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-emd.c readEmd(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-emd.c readEmd(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-emd.c readEmd(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-emd.c readEmd(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -86,12 +86,12 @@ int readEmd(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeEmd(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-emd.c writeEmd(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-emd.c writeEmd(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-emd.c writeEmd(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-emd.c writeEmd(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-emd.c writeEmd(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-emd.c writeEmd(), pattern contains no stitches\n");
         return 0;
     }
 
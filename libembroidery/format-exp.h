@@ -3,6 +3,7 @@
 #define FORMAT_EXP_H
 
 #include "emb-pattern.h"
+#include "emb-stream.h"
 
 #include "api-start.h"
 #ifdef __cplusplus
@@ -11,6 +12,7 @@ extern "C" {
 
 extern EMB_PRIVATE int EMB_CALL readExp(EmbPattern* pattern, const char* fileName);
 extern EMB_PRIVATE int EMB_CALL writeExp(EmbPattern* pattern, const char* fileName);
+extern EMB_PRIVATE int EMB_CALL expStreamBegin(EmbStreamWriter* writer);
 
 #ifdef __cplusplus
 }
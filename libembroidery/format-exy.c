@@ -23,13 +23,13 @@ int readExy(EmbPattern* pattern, const char* fileName)
     unsigned char b[3];
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-exy.c readExy(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-exy.c readExy(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-exy.c readExy(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-exy.c readExy(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-exy.c readExy(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-exy.c readExy(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -103,12 +103,12 @@ int readExy(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeExy(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-exy.c writeExy(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-exy.c writeExy(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-exy.c writeExy(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-exy.c writeExy(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-exy.c writeExy(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-exy.c writeExy(), pattern contains no stitches\n");
         return 0;
     }
 
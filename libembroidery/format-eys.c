@@ -5,8 +5,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readEys(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-eys.c readEys(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-eys.c readEys(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-eys.c readEys(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-eys.c readEys(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish readEys */
 }
 
@@ -14,12 +14,12 @@ int readEys(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeEys(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-eys.c writeEys(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-eys.c writeEys(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-eys.c writeEys(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-eys.c writeEys(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-eys.c writeEys(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-eys.c writeEys(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -6,8 +6,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readGc(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-gc.c readGc(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-gc.c readGc(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-gc.c readGc(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-gc.c readGc(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish readGc */
 }
 
@@ -15,12 +15,12 @@ int readGc(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeGc(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-gc.c writeGc(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-gc.c writeGc(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-gc.c writeGc(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-gc.c writeGc(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-gc.c writeGc(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-gc.c writeGc(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -9,13 +9,13 @@ int readGt(EmbPattern* pattern, const char* fileName)
 {
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-gt.c readGt(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-gt.c readGt(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-gt.c readGt(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-gt.c readGt(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-gt.c readGt(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-gt.c readGt(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -57,12 +57,12 @@ int readGt(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeGt(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-gt.c writeGt(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-gt.c writeGt(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-gt.c writeGt(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-gt.c writeGt(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-gt.c writeGt(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-gt.c writeGt(), pattern contains no stitches\n");
         return 0;
     }
 
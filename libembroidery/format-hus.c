@@ -2,6 +2,7 @@
 #include "emb-compress.h"
 #include "emb-file.h"
 #include "emb-logging.h"
+#include "emb-palette.h"
 #include "helpers-binary.h"
 #include "helpers-misc.h"
 #include <stdlib.h>
@@ -42,19 +43,19 @@ static int husDecodeStitchType(unsigned char b)
     }
 }
 
-static unsigned char* husDecompressData(unsigned char* input, int compressedInputLength, int decompressedContentLength)
+static unsigned char* husDecompressData(EmbCompress* compress, unsigned char* input, int compressedInputLength, int decompressedContentLength)
 {
     unsigned char* decompressedData = (unsigned char*)malloc(sizeof(unsigned char)*decompressedContentLength);
-    if(!decompressedData) { embLog_error("format-hus.c husDecompressData(), cannot allocate memory for decompressedData\n"); return 0; }
-    husExpand((unsigned char*) input, decompressedData, compressedInputLength, 10);
+    if(!decompressedData) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-hus.c husDecompressData(), cannot allocate memory for decompressedData\n"); return 0; }
+    husExpand(compress, (unsigned char*) input, decompressedData, compressedInputLength, 10);
     return decompressedData;
 }
 
-static unsigned char* husCompressData(unsigned char* input, int decompressedInputSize, int* compressedSize)
+static unsigned char* husCompressData(EmbCompress* compress, unsigned char* input, int decompressedInputSize, int* compressedSize)
 {
     unsigned char* compressedData = (unsigned char*)malloc(sizeof(unsigned char)*decompressedInputSize*2);
-    if(!compressedData) { embLog_error("format-hus.c husCompressData(), cannot allocate memory for compressedData\n"); return 0; }
-    *compressedSize = husCompress(input, (unsigned long) decompressedInputSize, compressedData, 10, 0);
+    if(!compressedData) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-hus.c husCompressData(), cannot allocate memory for compressedData\n"); return 0; }
+    *compressedSize = husCompress(compress, input, (unsigned long) decompressedInputSize, compressedData, 10, 0);
     return compressedData;
 }
 
@@ -103,17 +104,18 @@ int readHus(EmbPattern* pattern, const char* fileName)
 
     unsigned char* yData = 0;
     unsigned char* yDecompressed = 0;
-    unsigned char* stringVal = 0;
-    int unknown, i = 0;
+    unsigned char stringVal[8];
+    int unknown, i = 0, result = 0;
     EmbFile* file = 0;
+    EmbCompress* compress = 0;
 
-    if(!pattern) { embLog_error("format-hus.c readHus(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-hus.c readHus(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-hus.c readHus(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-hus.c readHus(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-hus.c readHus(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-hus.c readHus(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -134,8 +136,6 @@ int readHus(EmbPattern* pattern, const char* fileName)
     xOffset = binaryReadInt32(file);
     yOffset = binaryReadInt32(file);
 
-    stringVal = (unsigned char*)malloc(sizeof(unsigned char)*8);
-    if(!stringVal) { embLog_error("format-hus.c readHus(), cannot allocate memory for stringVal\n"); return 0; }
     binaryReadBytes(file, stringVal, 8); /* TODO: check return value */
 
     unknown = binaryReadInt16(file);
@@ -145,44 +145,53 @@ int readHus(EmbPattern* pattern, const char* fileName)
         embPattern_addThread(pattern, husThreads[pos]);
     }
 
+    compress = embCompress_create();
     attributeData = (unsigned char*)malloc(sizeof(unsigned char)*(xOffset - attributeOffset + 1));
-    if(!attributeData) { embLog_error("format-hus.c readHus(), cannot allocate memory for attributeData\n"); return 0; }
-    binaryReadBytes(file, attributeData, xOffset - attributeOffset); /* TODO: check return value */
-    attributeDataDecompressed = husDecompressData(attributeData, xOffset - attributeOffset, numberOfStitches + 1);
-
     xData = (unsigned char*)malloc(sizeof(unsigned char)*(yOffset - xOffset + 1));
-    if(!xData) { embLog_error("format-hus.c readHus(), cannot allocate memory for xData\n"); return 0; }
-    binaryReadBytes(file, xData, yOffset - xOffset); /* TODO: check return value */
-    xDecompressed = husDecompressData(xData, yOffset - xOffset, numberOfStitches);
-
     yData = (unsigned char*)malloc(sizeof(unsigned char)*(fileLength - yOffset + 1));
-    if(!yData) { embLog_error("format-hus.c readHus(), cannot allocate memory for yData\n"); return 0; }
-    binaryReadBytes(file, yData, fileLength - yOffset); /* TODO: check return value */
-    yDecompressed = husDecompressData(yData, fileLength - yOffset, numberOfStitches);
-
-    for(i = 0; i < numberOfStitches; i++)
+    if(!compress || !attributeData || !xData || !yData)
     {
-        embPattern_addStitchRel(pattern,
-                                husDecodeByte(xDecompressed[i]) / 10.0,
-                                husDecodeByte(yDecompressed[i]) / 10.0,
-                                husDecodeStitchType(attributeDataDecompressed[i]), 1);
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-hus.c readHus(), cannot allocate memory for the stitch data\n");
     }
+    else
+    {
+        binaryReadBytes(file, attributeData, xOffset - attributeOffset); /* TODO: check return value */
+        attributeDataDecompressed = husDecompressData(compress, attributeData, xOffset - attributeOffset, numberOfStitches + 1);
 
-    if(stringVal) { free(stringVal); stringVal = 0; }
-    if(xData) { free(xData); xData = 0; }
-    if(xDecompressed) { free(xDecompressed); xDecompressed = 0; }
-    if(yData) { free(yData); yData = 0; }
-    if(yDecompressed) { free(yDecompressed); yDecompressed = 0; }
-    if(attributeData) { free(attributeData); attributeData = 0; }
-    if(attributeDataDecompressed) { free(attributeDataDecompressed); attributeDataDecompressed = 0; }
+        binaryReadBytes(file, xData, yOffset - xOffset); /* TODO: check return value */
+        xDecompressed = husDecompressData(compress, xData, yOffset - xOffset, numberOfStitches);
 
-    embFile_close(file);
+        binaryReadBytes(file, yData, fileLength - yOffset); /* TODO: check return value */
+        yDecompressed = husDecompressData(compress, yData, fileLength - yOffset, numberOfStitches);
+    }
 
-    /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
-        embPattern_addStitchRel(pattern, 0, 0, END, 1);
+    if(attributeDataDecompressed && xDecompressed && yDecompressed)
+    {
+        for(i = 0; i < numberOfStitches; i++)
+        {
+            embPattern_addStitchRel(pattern,
+                                    husDecodeByte(xDecompressed[i]) / 10.0,
+                                    husDecodeByte(yDecompressed[i]) / 10.0,
+                                    husDecodeStitchType(attributeDataDecompressed[i]), 1);
+        }
+
+        /* Check for an END stitch and add one if it is not present */
+        if(pattern->lastStitch->stitch.flags != END)
+            embPattern_addStitchRel(pattern, 0, 0, END, 1);
+        result = 1;
+    }
+
+    /* NOTE: Every exit after the file is opened goes through here so nothing is leaked on failure. */
+    embCompress_free(compress);
+    free(xData);
+    free(xDecompressed);
+    free(yData);
+    free(yDecompressed);
+    free(attributeData);
+    free(attributeDataDecompressed);
+    embFile_close(file);
 
-    return 1;
+    return result;
 }
 
 /*! Writes the data from \a pattern to a file with the given \a fileName.
@@ -198,20 +207,22 @@ int writeHus(EmbPattern* pattern, const char* fileName)
     double previousY = 0;
     unsigned char* xValues = 0, *yValues = 0, *attributeValues = 0;
     EmbStitchList* pointer = 0;
+    EmbThreadList* threadPointer = 0;
     double xx = 0.0;
     double yy = 0.0;
     int flags = 0;
-    int i = 0;
+    int i = 0, result = 0;
     unsigned char* attributeCompressed = 0, *xCompressed = 0, *yCompressed = 0;
     EmbFile* file = 0;
+    EmbCompress* compress = 0;
 
-    if(!pattern) { embLog_error("format-hus.c writeHus(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-hus.c writeHus(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-hus.c writeHus(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-hus.c writeHus(), fileName argument is null\n"); return 0; }
 
-    stitchCount = embStitchList_count(pattern->stitchList);
+    stitchCount = embPattern_stitchCount(pattern);
     if(!stitchCount)
     {
-        embLog_error("format-hus.c writeHus(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-hus.c writeHus(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -225,7 +236,7 @@ int writeHus(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-hus.c writeHus(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-hus.c writeHus(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
@@ -246,55 +257,61 @@ int writeHus(EmbPattern* pattern, const char* fileName)
     binaryWriteUInt(file, 0x2A + 2 * minColors);
 
     xValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
-    if(!xValues) { embLog_error("format-hus.c writeHus(), cannot allocate memory for xValues\n"); return 0; }
     yValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
-    if(!yValues) { embLog_error("format-hus.c writeHus(), cannot allocate memory for yValues\n"); return 0; }
     attributeValues = (unsigned char*)malloc(sizeof(unsigned char)*(stitchCount));
-    if(!attributeValues) { embLog_error("format-hus.c writeHus(), cannot allocate memory for attributeValues\n"); return 0; }
-
-    pointer = pattern->stitchList;
-    while(pointer)
+    compress = embCompress_create();
+    if(!xValues || !yValues || !attributeValues || !compress)
     {
-        xx = pointer->stitch.xx;
-        yy = pointer->stitch.yy;
-        flags = pointer->stitch.flags;
-        xValues[i] = husEncodeByte((xx - previousX) * 10.0);
-        previousX = xx;
-        yValues[i] = husEncodeByte((yy - previousY) * 10.0);
-        previousY = yy;
-        attributeValues[i] = husEncodeStitchType(flags);
-        pointer = pointer->next;
-        i++;
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-hus.c writeHus(), cannot allocate memory for the stitch data\n");
     }
-    attributeCompressed = husCompressData(attributeValues, stitchCount, &attributeSize);
-    xCompressed = husCompressData(xValues, stitchCount, &xCompressedSize);
-    yCompressed = husCompressData(yValues, stitchCount, &yCompressedSize);
-    /* TODO: error if husCompressData returns zero? */
-
-    binaryWriteUInt(file, (unsigned int) (0x2A + 2 * patternColor + attributeSize));
-    binaryWriteUInt(file, (unsigned int) (0x2A + 2 * patternColor + attributeSize + xCompressedSize));
-    binaryWriteUInt(file, 0x00000000);
-    binaryWriteUInt(file, 0x00000000);
-    binaryWriteUShort(file, 0x0000);
-
-    for(i = 0; i < patternColor; i++)
+    else
     {
-        binaryWriteShort(file, (short)embThread_findNearestColorInArray(embThreadList_getAt(pattern->threadList, i).color, (EmbThread*)husThreads, husThreadCount));
+        pointer = pattern->stitchList;
+        while(pointer)
+        {
+            xx = pointer->stitch.xx;
+            yy = pointer->stitch.yy;
+            flags = pointer->stitch.flags;
+            xValues[i] = husEncodeByte((xx - previousX) * 10.0);
+            previousX = xx;
+            yValues[i] = husEncodeByte((yy - previousY) * 10.0);
+            previousY = yy;
+            attributeValues[i] = husEncodeStitchType(flags);
+            pointer = pointer->next;
+            i++;
+        }
+        attributeCompressed = husCompressData(compress, attributeValues, stitchCount, &attributeSize);
+        xCompressed = husCompressData(compress, xValues, stitchCount, &xCompressedSize);
+        yCompressed = husCompressData(compress, yValues, stitchCount, &yCompressedSize);
+        /* TODO: error if husCompressData returns zero? */
+
+        binaryWriteUInt(file, (unsigned int) (0x2A + 2 * patternColor + attributeSize));
+        binaryWriteUInt(file, (unsigned int) (0x2A + 2 * patternColor + attributeSize + xCompressedSize));
+        binaryWriteUInt(file, 0x00000000);
+        binaryWriteUInt(file, 0x00000000);
+        binaryWriteUShort(file, 0x0000);
+
+        for(threadPointer = pattern->threadList; threadPointer; threadPointer = threadPointer->next)
+        {
+            binaryWriteShort(file, (short)embPalette_nearestInChart(husThreads, husThreadCount, threadPointer->thread.color));
+        }
+
+        binaryWriteBytes(file, (char*) attributeCompressed, attributeSize);
+        binaryWriteBytes(file, (char*) xCompressed, xCompressedSize);
+        binaryWriteBytes(file, (char*) yCompressed, yCompressedSize);
+        result = 1;
     }
 
-    binaryWriteBytes(file, (char*) attributeCompressed, attributeSize);
-    binaryWriteBytes(file, (char*) xCompressed, xCompressedSize);
-    binaryWriteBytes(file, (char*) yCompressed, yCompressedSize);
-
-    free(xValues); xValues = 0;
-    free(xCompressed); xCompressed = 0;
-    free(yValues); yValues = 0;
-    free(yCompressed); yCompressed = 0;
-    free(attributeValues); attributeValues = 0;
-    free(attributeCompressed); attributeCompressed = 0;
+    if(compress) { embCompress_free(compress); compress = 0; }
+    if(xValues) { free(xValues); xValues = 0; }
+    if(xCompressed) { free(xCompressed); xCompressed = 0; }
+    if(yValues) { free(yValues); yValues = 0; }
+    if(yCompressed) { free(yCompressed); yCompressed = 0; }
+    if(attributeValues) { free(attributeValues); attributeValues = 0; }
+    if(attributeCompressed) { free(attributeCompressed); attributeCompressed = 0; }
 
     embFile_close(file);
-    return 1;
+    return result;
 }
 
 /* kate: bom off; indent-mode cstyle; indent-width 4; replace-trailing-space-save on; */
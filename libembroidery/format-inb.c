@@ -29,13 +29,13 @@ int readInb(EmbPattern* pattern, const char* fileName)
     int i;
     int fileLength;
 
-    if(!pattern) { embLog_error("format-inb.c readInb(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-inb.c readInb(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-inb.c readInb(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-inb.c readInb(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-inb.c readInb(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-inb.c readInb(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -94,12 +94,12 @@ int readInb(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeInb(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-inb.c writeInb(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-inb.c writeInb(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-inb.c writeInb(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-inb.c writeInb(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-inb.c writeInb(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-inb.c writeInb(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -13,8 +13,8 @@ int readInf(EmbPattern* pattern, const char* fileName)
     int i;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-inf.c readInf(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-inf.c readInf(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-inf.c readInf(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-inf.c readInf(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
@@ -61,13 +61,13 @@ int writeInf(EmbPattern* pattern, const char* fileName)
     int i = 1, bytesRemaining;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-inf.c writeInf(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-inf.c writeInf(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-inf.c writeInf(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-inf.c writeInf(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-inf.c writeInf(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-inf.c writeInf(), cannot open %s for writing\n", fileName);
         return 0;
     }
     binaryWriteUIntBE(file, 0x01);
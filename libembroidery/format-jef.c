@@ -1,6 +1,8 @@
 #include "format-jef.h"
 #include "emb-file.h"
 #include "emb-logging.h"
+#include "emb-palette.h"
+#include "emb-record.h"
 #include "emb-time.h"
 #include "helpers-binary.h"
 #include "helpers-misc.h"
@@ -22,16 +24,9 @@ static int jefGetHoopSize(int width, int height)
     return ((int) HOOP_110X110);
 }
 
-static char jefDecode(unsigned char inputByte)
-{
-    if(inputByte >= 0x80)
-        return (char) ((-~inputByte) - 1);
-    return ((char) inputByte);
-}
-
 static void jefSetHoopFromId(EmbPattern* pattern, int hoopCode)
 {
-    if(!pattern) { embLog_error("format-jef.c jefSetHoopFromId(), pattern argument is null\n"); return; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-jef.c jefSetHoopFromId(), pattern argument is null\n"); return; }
 
     switch(hoopCode)
     {
@@ -73,23 +68,17 @@ int readJef(EmbPattern* pattern, const char* fileName)
     int stitchOffset, formatFlags, numberOfColors, numberOfStitchBytes;
     int hoopSize, i;
     struct hoop_padding bounds, rectFrom110x110, rectFrom50x50, rectFrom200x140, rect_from_custom;
-    int stitchBytes;
     char date[8], time[8];
   
     EmbFile* file = 0;
- 
-    unsigned char b0 = 0, b1 = 0;
-    char dx = 0, dy = 0;
-    int flags = 0;
-
 
-    if(!pattern) { embLog_error("format-jef.c readJef(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-jef.c readJef(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-jef.c readJef(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-jef.c readJef(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-jef.c readJef(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-jef.c readJef(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -133,60 +122,7 @@ int readJef(EmbPattern* pattern, const char* fileName)
         embPattern_addThread(pattern, jefThreads[binaryReadInt32(file) % 79]);
     }
     embFile_seek(file, stitchOffset, SEEK_SET);
-	stitchBytes = 0;
-    while(stitchBytes < numberOfStitchBytes)
-    {
-        flags = NORMAL;
-        b0 = (unsigned char)embFile_getc(file);
-        if(embFile_eof(file))
-        {
-            break;
-        }
-        b1 = (unsigned char)embFile_getc(file);
-        if(embFile_eof(file))
-        {
-            break;
-        }
-		stitchBytes += 2;
-        if(b0 == 0x80)
-        {
-            if(b1 & 1)
-            {
-                b0 = (unsigned char)embFile_getc(file);
-                if(embFile_eof(file))
-                    break;
-                b1 = (unsigned char)embFile_getc(file);
-                if(embFile_eof(file))
-                    break;
-				stitchBytes += 2;
-                flags = STOP;
-            }
-            else if((b1 == 2) || (b1 == 4) || b1 == 6)
-            {
-                flags = TRIM;
-                b0 = (unsigned char)embFile_getc(file);
-                if (embFile_eof(file))
-                {
-                    break;
-                }
-                b1 = (unsigned char)embFile_getc(file);
-                if (embFile_eof(file))
-                {
-                    break;
-                }
-				stitchBytes += 2;
-            }
-            else if(b1 == 0x10)
-            {
-                embPattern_addStitchRel(pattern, 0.0, 0.0, END, 1);
-				stitchBytes += 1;
-                break;
-            }
-        }
-        dx = jefDecode(b0);
-        dy = jefDecode(b1);
-        embPattern_addStitchRel(pattern, dx / 10.0, dy / 10.0, flags, 1);
-    }
+    embRecord_readStitches(pattern, file, embRecord_decodeJef, numberOfStitchBytes > 0 ? numberOfStitchBytes : 0);
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
@@ -197,69 +133,28 @@ int readJef(EmbPattern* pattern, const char* fileName)
     return 1;
 }
 
-static void jefEncode(unsigned char* b, char dx, char dy, int flags)
-{
-    if(!b)
-    {
-        embLog_error("format-jef.c expEncode(), b argument is null\n");
-        return;
-    }
-    if(flags == STOP)
-    {
-        b[0] = 0x80;
-        b[1] = 1;
-        b[2] = dx;
-        b[3] = dy;
-    }
-    else if (flags == END)
-    {
-        b[0] = 0x80;
-        b[1] = 0x10;
-        b[2] = 0;
-        b[3] = 0;
-    }
-    else if(flags == TRIM)
-    {
-        b[0] = 0x80;
-        b[1] = 2;
-        b[2] = dx;
-        b[3] = dy;
-    }
-	else if (flags == JUMP)
-	{
-		b[0] = 0x80;
-		b[1] = 4;
-		b[2] = dx;
-		b[3] = dy;
-	}
-    else
-    {
-        b[0] = dx;
-        b[1] = dy;
-    }
-}
-
 /*! Writes the data from \a pattern to a file with the given \a fileName.
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeJef(EmbPattern* pattern, const char* fileName)
 {
-    int colorlistSize, designWidth, designHeight, i, jumpAndStopCount;
+    int colorlistSize, designWidth, designHeight, i;
+    EmbPatternStats stats;
     EmbRect boundingRect;
     EmbFile* file = 0;
     EmbTime time;
     EmbThreadList* threadPointer = 0;
     EmbStitchList* stitches = 0;
-    double dx = 0.0, dy = 0.0;
+    EmbRecord records[EMB_RECORD_BLOCK];
+    unsigned char buffer[EMB_RECORD_BLOCK * 4];
     double xx = 0.0, yy = 0.0;
-    int flags = 0;
-    unsigned char b[4];
+    int count = 0;
 
-    if(!pattern) { embLog_error("format-jef.c writeJef(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-jef.c writeJef(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-jef.c writeJef(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-jef.c writeJef(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-jef.c writeJef(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-jef.c writeJef(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -271,7 +166,7 @@ int writeJef(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-jef.c writeJef(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-jef.c writeJef(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
@@ -290,17 +185,8 @@ int writeJef(EmbPattern* pattern, const char* fileName)
     binaryWriteByte(file, 0x00);
     binaryWriteInt(file, embThreadList_count(pattern->threadList));
 
-	stitches = pattern->stitchList;
-	jumpAndStopCount = 0;
-	while (stitches)
-	{
-		flags = stitches->stitch.flags;
-		if ((flags & (STOP | TRIM | JUMP)) > 0) {
-			jumpAndStopCount++;
-		}
-		stitches = stitches->next;
-	}
-	binaryWriteInt(file, embStitchList_count(pattern->stitchList) + jumpAndStopCount);
+    stats = embPattern_stats(pattern);
+    binaryWriteInt(file, stats.stitchCount + stats.moveCount);
 
     boundingRect = embPattern_calcBoundingBox(pattern);
 
@@ -364,34 +250,29 @@ int writeJef(EmbPattern* pattern, const char* fileName)
 
     while(threadPointer)
     {
-        binaryWriteInt(file, embThread_findNearestColorInArray(threadPointer->thread.color, (EmbThread*)jefThreads, 79));
+        binaryWriteInt(file, embPalette_nearestInChart(jefThreads, 79, threadPointer->thread.color));
         threadPointer = threadPointer->next;
     }
     for(i = 0; i < colorlistSize; i++)
     {
         binaryWriteInt(file, 0x0D);
     }
+    /* write stitches up to the first END, a block of records at a time */
     stitches = pattern->stitchList;
     while(stitches)
     {
-        dx = stitches->stitch.xx * 10.0 - xx;
-        dy = stitches->stitch.yy * 10.0 - yy;
+        records[count].dx = roundDouble(stitches->stitch.xx * 10.0 - xx);
+        records[count].dy = roundDouble(stitches->stitch.yy * 10.0 - yy);
+        records[count].flags = stitches->stitch.flags;
         xx = stitches->stitch.xx * 10.0;
         yy = stitches->stitch.yy * 10.0;
-        flags = stitches->stitch.flags;
-        jefEncode(b, (char)roundDouble(dx), (char)roundDouble(dy), flags);
-        if((b[0] == 0x80) && ((b[1] == 1) || (b[1] == 2) || (b[1] == 4)))
-        {
-            embFile_printf(file, "%c%c%c%c", b[0], b[1], b[2], b[3]);
-        }
-        else
+        count++;
+        stitches = (stitches->stitch.flags & END) ? 0 : stitches->next;
+        if(count == EMB_RECORD_BLOCK || !stitches)
         {
-            embFile_printf(file, "%c%c", b[0], b[1]);
+            embFile_write(buffer, 1, (size_t)embRecord_encodeJef(records, count, buffer), file);
+            count = 0;
         }
-		if (flags & END) {
-			break;
-		}
-        stitches = stitches->next;
     }
     embFile_close(file);
     return 1;
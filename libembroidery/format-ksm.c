@@ -7,7 +7,7 @@ static void ksmEncode(unsigned char* b, char dx, char dy, int flags)
 {
     if(!b)
     {
-        embLog_error("format-ksm.c ksmEncode(), b argument is null\n");
+        embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ksm.c ksmEncode(), b argument is null\n");
         return;
     }
     /* TODO: How to encode JUMP stitches? JUMP must be handled. Also check this for the EXP format since it appears to be similar */
@@ -40,13 +40,13 @@ int readKsm(EmbPattern* pattern, const char* fileName)
     char b[3];
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-ksm.c readKsm(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-ksm.c readKsm(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ksm.c readKsm(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ksm.c readKsm(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-ksm.c readKsm(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-ksm.c readKsm(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -91,12 +91,12 @@ int writeKsm(EmbPattern* pattern, const char* fileName)
     int i = 0;
     unsigned char b[4];
 
-    if(!pattern) { embLog_error("format-ksm.c writeKsm(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-ksm.c writeKsm(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ksm.c writeKsm(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ksm.c writeKsm(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-ksm.c writeKsm(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-ksm.c writeKsm(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -107,7 +107,7 @@ int writeKsm(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-ksm.c writeKsm(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-ksm.c writeKsm(), cannot open %s for writing\n", fileName);
         return 0;
     }
     for(i = 0; i < 0x80; i++)
@@ -19,7 +19,7 @@ static double maxDecode(unsigned char a1, unsigned char a2, unsigned char a3)
 
 static void maxEncode(EmbFile* file, int x, int y)
 {
-    if(!file) { embLog_error("format-max.c maxEncode(), file argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-max.c maxEncode(), file argument is null\n"); return; }
 
     binaryWriteByte(file, (unsigned char)0);
     binaryWriteByte(file, (unsigned char)(x & 0xFF));
@@ -43,13 +43,13 @@ int readMax(EmbPattern* pattern, const char* fileName)
     int stitchCount;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-max.c readMax(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-max.c readMax(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-max.c readMax(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-max.c readMax(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-max.c readMax(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-max.c readMax(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -70,7 +70,7 @@ int readMax(EmbPattern* pattern, const char* fileName)
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
+    if(!pattern->lastStitch || pattern->lastStitch->stitch.flags != END)
         embPattern_addStitchRel(pattern, 0, 0, END, 1);
 
     embPattern_flipVertical(pattern);
@@ -100,12 +100,12 @@ int writeMax(EmbPattern* pattern, const char* fileName)
         0x01,0x38,0x09,0x31,0x33,0x30,0x2F,0x37,0x30,0x35,0x20,0x48,0xFA,0x00,0x00,0x00,
         0x00,0x00,0x00,0x00,0x00 };
 
-    if(!pattern) { embLog_error("format-max.c writeMax(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-max.c writeMax(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-max.c writeMax(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-max.c writeMax(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-max.c writeMax(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-max.c writeMax(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -116,11 +116,12 @@ int writeMax(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-max.c writeMax(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-max.c writeMax(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
     binaryWriteBytes(file, header, 0xD5);
+    binaryWriteUInt(file, (unsigned int)embPattern_stitchCount(pattern)); /* readMax() expects the count at 0xD5 */
     pointer = pattern->stitchList;
     while(pointer)
     {
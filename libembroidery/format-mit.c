@@ -19,13 +19,13 @@ int readMit(EmbPattern* pattern, const char* fileName)
     unsigned char data[2];
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-mit.c readMit(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-mit.c readMit(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-mit.c readMit(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-mit.c readMit(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-mit.c readMit(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-mit.c readMit(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -63,12 +63,12 @@ int writeMit(EmbPattern* pattern, const char* fileName)
 	double xx = 0, yy = 0, dx = 0, dy = 0;
 	int flags = 0;
 
-    if(!pattern) { embLog_error("format-mit.c writeMit(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-mit.c writeMit(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-mit.c writeMit(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-mit.c writeMit(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-mit.c writeMit(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-mit.c writeMit(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -80,7 +80,7 @@ int writeMit(EmbPattern* pattern, const char* fileName)
 	file = embFile_open(fileName, "wb");
 	if (!file)
 	{
-		embLog_error("format-mit.c writeMit(), cannot open %s for writing\n", fileName);
+		embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-mit.c writeMit(), cannot open %s for writing\n", fileName);
 		return 0;
 	}
 	embPattern_correctForMaxStitchLength(pattern, 0x1F, 0x1F);
@@ -16,13 +16,13 @@ int readNew(EmbPattern* pattern, const char* fileName)
     unsigned char data[3];
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-new.c readNew(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-new.c readNew(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-new.c readNew(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-new.c readNew(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-new.c readNew(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-new.c readNew(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -79,12 +79,12 @@ int readNew(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeNew(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-new.c writeNew(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-new.c writeNew(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-new.c writeNew(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-new.c writeNew(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-new.c writeNew(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-new.c writeNew(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -13,12 +13,12 @@ static char* ofmReadLibrary(EmbFile* file)
     /* FF FE FF */
     unsigned char leadIn[3];
 
-    if(!file) { embLog_error("format-ofm.c ofmReadLibrary(), file argument is null\n"); return 0; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadLibrary(), file argument is null\n"); return 0; }
 
     binaryReadBytes(file, leadIn, 3); /* TODO: check return value */
     stringLength = binaryReadByte(file);
     libraryName = (char*)malloc(sizeof(char) * stringLength * 2);
-    if(!libraryName) { embLog_error("format-ofm.c ofmReadLibrary(), unable to allocate memory for libraryName\n"); return 0; }
+    if(!libraryName) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-ofm.c ofmReadLibrary(), unable to allocate memory for libraryName\n"); return 0; }
     binaryReadBytes(file, (unsigned char*)libraryName, stringLength * 2); /* TODO: check return value */
     return libraryName;
 }
@@ -28,13 +28,13 @@ static int ofmReadClass(EmbFile* file)
     int len;
     char* s = 0;
 
-    if(!file) { embLog_error("format-ofm.c ofmReadClass(), file argument is null\n"); return 0; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadClass(), file argument is null\n"); return 0; }
 
     binaryReadInt16(file);
     len = binaryReadInt16(file);
 
     s = (char*)malloc(sizeof(char) * len + 1);
-    if(!s) { embLog_error("format-ofm.c ofmReadClass(), unable to allocate memory for s\n"); return 0; }
+    if(!s) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-ofm.c ofmReadClass(), unable to allocate memory for s\n"); return 0; }
     binaryReadBytes(file, (unsigned char*)s, len); /* TODO: check return value */
     s[len] = '\0';
     if(strcmp(s, "CExpStitch") == 0)
@@ -54,7 +54,7 @@ static void ofmReadBlockHeader(EmbFile* file)
     short unknown2 = 0; /* TODO: determine what this represents */
     int unknown3 = 0;   /* TODO: determine what this represents */
 
-    if(!file) { embLog_error("format-ofm.c ofmReadBlockHeader(), file argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadBlockHeader(), file argument is null\n"); return; }
 
     unknown1 = binaryReadInt16(file);
     unknown2 = (short)binaryReadInt32(file);
@@ -65,7 +65,7 @@ static void ofmReadBlockHeader(EmbFile* file)
     binaryReadByte(file);
     len = binaryReadByte(file);
     s = (char*)malloc(2 * len);
-    if(!s) { embLog_error("format-ofm.c ofmReadBlockHeader(), unable to allocate memory for s\n"); return; }
+    if(!s) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-ofm.c ofmReadBlockHeader(), unable to allocate memory for s\n"); return; }
     binaryReadBytes(file, (unsigned char *)s, 2 * len); /* TODO: check return value */
     val1 = binaryReadInt32(file);   /*  0 */
     val2 = binaryReadInt32(file);   /*  0 */
@@ -82,8 +82,8 @@ static void ofmReadBlockHeader(EmbFile* file)
 
 static void ofmReadColorChange(EmbFile* file, EmbPattern* pattern)
 {
-    if(!file) { embLog_error("format-ofm.c ofmReadColorChange(), file argument is null\n"); return; }
-    if(!pattern) { embLog_error("format-ofm.c ofmReadColorChange(), pattern argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadColorChange(), file argument is null\n"); return; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadColorChange(), pattern argument is null\n"); return; }
 
     ofmReadBlockHeader(file);
     embPattern_addStitchRel(pattern, 0.0, 0.0, STOP, 1);
@@ -95,8 +95,8 @@ static void ofmReadThreads(EmbFile* file, EmbPattern* p)
     char* primaryLibraryName = 0;
     char* expandedString = 0;
 
-    if(!file) { embLog_error("format-ofm.c ofmReadThreads(), file argument is null\n"); return; }
-    if(!p) { embLog_error("format-ofm.c ofmReadThreads(), p argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadThreads(), file argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadThreads(), p argument is null\n"); return; }
 
     /* FF FE FF 00 */
     binaryReadInt32(file);
@@ -107,7 +107,7 @@ static void ofmReadThreads(EmbFile* file, EmbPattern* p)
     binaryReadInt16(file);
     stringLen = binaryReadInt16(file);
     expandedString = (char*)malloc(stringLen);
-    if(!expandedString) { embLog_error("format-ofm.c ofmReadThreads(), unable to allocate memory for expandedString\n"); return; }
+    if(!expandedString) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-ofm.c ofmReadThreads(), unable to allocate memory for expandedString\n"); return; }
     binaryReadBytes(file, (unsigned char*)expandedString, stringLen); /* TODO: check return value */
     for(i = 0; i < numberOfColors; i++)
     {
@@ -126,7 +126,7 @@ static void ofmReadThreads(EmbFile* file, EmbPattern* p)
         binaryReadInt16(file);
         colorNameLength = binaryReadByte(file);
         colorName = (char*)malloc(colorNameLength * 2);
-        if(!colorName) { embLog_error("format-ofm.c ofmReadThreads(), unable to allocate memory for colorName\n"); return; }
+        if(!colorName) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-ofm.c ofmReadThreads(), unable to allocate memory for colorName\n"); return; }
         binaryReadBytes(file, (unsigned char*)colorName, colorNameLength*2); /* TODO: check return value */
         binaryReadInt16(file);
      /* itoa(colorNumber, colorNumberText, 10); TODO: never use itoa, it's non-standard, use sprintf: http://stackoverflow.com/questions/5242524/converting-int-to-string-in-c */
@@ -159,8 +159,8 @@ static void ofmReadExpanded(EmbFile* file, EmbPattern* p)
 {
     int i, numberOfStitches = 0;
 
-    if(!file) { embLog_error("format-ofm.c ofmReadExpanded(), file argument is null\n"); return; }
-    if(!p) { embLog_error("format-ofm.c ofmReadExpanded(), p argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadExpanded(), file argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c ofmReadExpanded(), p argument is null\n"); return; }
 
     ofmReadBlockHeader(file);
     numberOfStitches = binaryReadInt32(file);
@@ -191,29 +191,40 @@ int readOfm(EmbPattern* pattern, const char* fileName)
     EmbFile* file = 0;
     bcf_file* bcfFile = 0;
 
-    if(!pattern) { embLog_error("format-ofm.c readOfm(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-ofm.c readOfm(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c readOfm(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c readOfm(), fileName argument is null\n"); return 0; }
 
     fileCompound = embFile_open(fileName, "rb");
     if(!fileCompound)
     {
-        embLog_error("format-ofm.c readOfm(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-ofm.c readOfm(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
     bcfFile = (bcf_file*)malloc(sizeof(bcf_file));
-    if(!bcfFile) { embLog_error("format-ofm.c readOfm(), unable to allocate memory for bcfFile\n"); return 0; }
-    bcfFile_read(fileCompound, bcfFile);
-    file = GetFile(bcfFile, fileCompound, "EdsIV Object");
+    if(!bcfFile) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-ofm.c readOfm(), unable to allocate memory for bcfFile\n"); return 0; }
+    if(!bcfFile_read(fileCompound, bcfFile))
+    {
+        embLog_error("format-ofm.c readOfm(), cannot read the compound file structure of %s\n", fileName);
+        bcf_file_free(bcfFile);
+        embFile_close(fileCompound);
+        return 0;
+    }
+    file = bcfFile_openStream(bcfFile, fileCompound, "EdsIV Object");
     bcf_file_free(bcfFile);
     bcfFile = 0;
+    if(!file)
+    {
+        embFile_close(fileCompound);
+        return 0;
+    }
     embFile_seek(file, 0x1C6, SEEK_SET);
     ofmReadThreads(file, pattern);
     embFile_seek(file, 0x110, SEEK_CUR);
     binaryReadInt32(file);
     classNameLength = binaryReadInt16(file);
     s = (char*)malloc(sizeof(char) * classNameLength);
-    if(!s) { embLog_error("format-ofm.c readOfm(), unable to allocate memory for s\n"); return 0; }
+    if(!s) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-ofm.c readOfm(), unable to allocate memory for s\n"); return 0; }
     binaryReadBytes(file, (unsigned char*)s, classNameLength); /* TODO: check return value */
     unknownCount = binaryReadInt16(file); /* TODO: determine what unknown count represents */
 
@@ -240,8 +251,9 @@ int readOfm(EmbPattern* pattern, const char* fileName)
         }
     }
 
-    embFile_close(fileCompound);
+    /* NOTE: file may be a view into the buffer of fileCompound, so it is closed first */
     embFile_close(file);
+    embFile_close(fileCompound);
 
     /* Check for an END stitch and add one if it is not present */
     if(pattern->lastStitch->stitch.flags != END)
@@ -256,12 +268,12 @@ int readOfm(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeOfm(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-ofm.c writeOfm(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-ofm.c writeOfm(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c writeOfm(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-ofm.c writeOfm(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-ofm.c writeOfm(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-ofm.c writeOfm(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -24,13 +24,13 @@ int readPcm(EmbPattern* pattern, const char* fileName)
     int flags = 0, st = 0;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-pcm.c readPcm(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pcm.c readPcm(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcm.c readPcm(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcm.c readPcm(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-pcm.c readPcm(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-pcm.c readPcm(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -80,12 +80,12 @@ int readPcm(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writePcm(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-pcm.c writePcm(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pcm.c writePcm(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcm.c writePcm(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcm.c writePcm(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-pcm.c writePcm(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-pcm.c writePcm(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -18,7 +18,7 @@ static void pcqEncode(EmbFile* file, int dx, int dy, int flags)
 {
     unsigned char flagsToWrite = 0;
 
-    if(!file) { embLog_error("format-pcq.c pcqEncode(), file argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcq.c pcqEncode(), file argument is null\n"); return; }
 
     binaryWriteByte(file, (unsigned char)0);
     binaryWriteByte(file, (unsigned char)(dx & 0xFF));
@@ -53,13 +53,13 @@ int readPcq(EmbPattern* pattern, const char* fileName)
     unsigned short colorCount;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-pcq.c readPcq(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pcq.c readPcq(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcq.c readPcq(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcq.c readPcq(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-pcq.c readPcq(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-pcq.c readPcq(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -129,12 +129,12 @@ int writePcq(EmbPattern* pattern, const char* fileName)
     unsigned char colorCount;
     double xx = 0.0, yy = 0.0;
 
-    if(!pattern) { embLog_error("format-pcq.c writePcq(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pcq.c writePcq(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcq.c writePcq(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pcq.c writePcq(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-pcq.c writePcq(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-pcq.c writePcq(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -145,14 +145,14 @@ int writePcq(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-pcq.c writePcq(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-pcq.c writePcq(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
     binaryWriteByte(file, (unsigned char)'2');
     binaryWriteByte(file, 3); /* TODO: select hoop size defaulting to Large PCS hoop */
     colorCount = (unsigned char)embThreadList_count(pattern->threadList);
-    binaryWriteUShort(file, (unsigned short)colorCount);
+    binaryWriteUShort(file, (unsigned short)(colorCount < 16 ? 16 : colorCount)); /* readPcq() reads this many color slots */
     threadPointer = pattern->threadList;
     i = 0;
     while(threadPointer)
@@ -171,7 +171,7 @@ int writePcq(EmbPattern* pattern, const char* fileName)
         binaryWriteUInt(file, 0); /* write remaining colors to reach 16 */
     }
 
-    binaryWriteUShort(file, (unsigned short)embStitchList_count(pattern->stitchList));
+    binaryWriteUShort(file, (unsigned short)embPattern_stitchCount(pattern));
     /* write stitches */
     xx = yy = 0;
     pointer = pattern->stitchList;
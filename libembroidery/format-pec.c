@@ -1,6 +1,7 @@
 #include "format-pec.h"
 #include "emb-file.h"
 #include "emb-logging.h"
+#include "emb-palette.h"
 #include "helpers-binary.h"
 #include "helpers-misc.h"
 #include <stdlib.h>
@@ -10,8 +11,8 @@ void readPecStitches(EmbPattern* pattern, EmbFile* file)
 {
     int stitchNumber = 0;
 
-    if(!pattern) { embLog_error("format-pec.c readPecStitches(), pattern argument is null\n"); return; }
-    if(!file) { embLog_error("format-pec.c readPecStitches(), file argument is null\n"); return; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c readPecStitches(), pattern argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c readPecStitches(), file argument is null\n"); return; }
 
     while(!embFile_eof(file))
     {
@@ -76,7 +77,7 @@ static void pecEncodeJump(EmbFile* file, int x, int types)
     int outputVal = abs(x) & 0x7FF;
     unsigned int orPart = 0x80;
 
-    if(!file) { embLog_error("format-pec.c pecEncodeJump(), file argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c pecEncodeJump(), file argument is null\n"); return; }
 
     if(types & TRIM)
     {
@@ -98,7 +99,7 @@ static void pecEncodeJump(EmbFile* file, int x, int types)
 
 static void pecEncodeStop(EmbFile* file, unsigned char val)
 {
-    if(!file) { embLog_error("format-pec.c pecEncodeStop(), file argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c pecEncodeStop(), file argument is null\n"); return; }
     binaryWriteByte(file, 0xFE);
     binaryWriteByte(file, 0xB0);
     binaryWriteByte(file, val);
@@ -113,13 +114,13 @@ int readPec(EmbPattern* pattern, const char* fileName)
     int i;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-pec.c readPec(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pec.c readPec(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c readPec(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c readPec(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-pec.c readPec(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-pec.c readPec(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -173,8 +174,8 @@ static void pecEncode(EmbFile* file, EmbPattern* p)
     unsigned char stopCode = 2;
     EmbStitchList* list = 0;
 
-    if(!file) { embLog_error("format-pec.c pecEncode(), file argument is null\n"); return; }
-    if(!p) { embLog_error("format-pec.c pecEncode(), p argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c pecEncode(), file argument is null\n"); return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c pecEncode(), p argument is null\n"); return; }
 
     list = p->stitchList;
     while(list)
@@ -227,7 +228,7 @@ static void writeImage(EmbFile* file, unsigned char image[][48])
 {
     int i, j;
 
-    if(!file) { embLog_error("format-pec.c writeImage(), file argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c writeImage(), file argument is null\n"); return; }
 
     for(i = 0; i < 38; i++)
     {
@@ -251,6 +252,7 @@ static void writeImage(EmbFile* file, unsigned char image[][48])
 void writePecStitches(EmbPattern* pattern, EmbFile* file, const char* fileName)
 {
     EmbStitchList* tempStitches = 0;
+    EmbThreadList* threadPointer = 0;
     EmbRect bounds;
     unsigned char image[38][48];
     int i, flen, currentThreadCount, graphicsOffsetLocation, graphicsOffsetValue, height, width;
@@ -260,9 +262,9 @@ void writePecStitches(EmbPattern* pattern, EmbFile* file, const char* fileName)
     const char* dotPos = strrchr(fileName, '.');
     const char* start = 0;
 
-    if(!pattern) { embLog_error("format-pec.c writePecStitches(), pattern argument is null\n"); return; }
-    if(!file) { embLog_error("format-pec.c writePecStitches(), file argument is null\n"); return; }
-    if(!fileName) { embLog_error("format-pec.c writePecStitches(), fileName argument is null\n"); return; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c writePecStitches(), pattern argument is null\n"); return; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c writePecStitches(), file argument is null\n"); return; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pec.c writePecStitches(), fileName argument is null\n"); return; }
 
     if(forwardSlashPos)
     {
@@ -305,9 +307,9 @@ void writePecStitches(EmbPattern* pattern, EmbFile* file, const char* fileName)
     currentThreadCount = embThreadList_count(pattern->threadList);
     binaryWriteByte(file, (unsigned char)(currentThreadCount-1));
 
-    for(i = 0; i < currentThreadCount; i++)
+    for(threadPointer = pattern->threadList; threadPointer; threadPointer = threadPointer->next)
     {
-        binaryWriteByte(file, (unsigned char)embThread_findNearestColorInArray(embThreadList_getAt(pattern->threadList, i).color, (EmbThread*)pecThreads, pecThreadCount));
+        binaryWriteByte(file, (unsigned char)embPalette_nearestInChart(pecThreads, pecThreadCount, threadPointer->thread.color));
     }
     for(i = 0; i < (int)(0x1CF - currentThreadCount); i++)
     {
@@ -393,9 +395,9 @@ int writePec(EmbPattern* pattern, const char* fileName)
 {
     EmbFile* file = 0;
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-pec.c writePec(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-pec.c writePec(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -406,7 +408,7 @@ int writePec(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-pec.c writePec(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-pec.c writePec(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
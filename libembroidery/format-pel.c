@@ -5,8 +5,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readPel(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-pel.c readPel(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pel.c readPel(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pel.c readPel(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pel.c readPel(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish readPel */
 }
 
@@ -14,12 +14,12 @@ int readPel(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writePel(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-pel.c writePel(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pel.c writePel(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pel.c writePel(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pel.c writePel(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-pel.c writePel(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-pel.c writePel(), pattern contains no stitches\n");
         return 0;
     }
 
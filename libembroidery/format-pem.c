@@ -5,8 +5,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readPem(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-pem.c readPem(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pem.c readPem(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pem.c readPem(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pem.c readPem(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish ReadPem */
 }
 
@@ -14,12 +14,12 @@ int readPem(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writePem(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-pem.c writePem(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pem.c writePem(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pem.c writePem(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pem.c writePem(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-pem.c writePem(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-pem.c writePem(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -2,6 +2,7 @@
 #include "format-pec.h"
 #include "emb-file.h"
 #include "emb-logging.h"
+#include "emb-palette.h"
 #include "helpers-binary.h"
 #include <stdlib.h>
 
@@ -12,13 +13,13 @@ int readPes(EmbPattern* pattern, const char* fileName)
     int pecstart, numColors, x;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-pes.c readPes(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pes.c readPes(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pes.c readPes(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pes.c readPes(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-pes.c readPes(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-pes.c readPes(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -46,6 +47,15 @@ int readPes(EmbPattern* pattern, const char* fileName)
     return 1;
 }
 
+/* Returns the pecThreads index matched to thread \a index of the pattern, clamped to the thread list as embThreadList_getAt() does */
+static int pesColorCode(const int* threadCodes, int threadCount, int index)
+{
+    if(threadCount < 1) return 0;
+    if(index >= threadCount) index = threadCount - 1;
+    if(index < 0) index = 0;
+    return threadCodes[index];
+}
+
 static void pesWriteSewSegSection(EmbPattern* pattern, EmbFile* file)
 {
     /* TODO: pointer safety */
@@ -62,15 +72,26 @@ static void pesWriteSewSegSection(EmbPattern* pattern, EmbFile* file)
     int colorInfoIndex = 0;
     int i;
     EmbRect bounds = embPattern_calcBoundingBox(pattern);
-    EmbColor color;
+    EmbPalette* palette = embPalette_chart(pecThreads, pecThreadCount);
+    int* threadCodes = 0;
+    int threadCount = embThreadList_count(pattern->threadList);
+
+    /* Match each thread once, rather than once for every block */
+    threadCodes = (int*)malloc(sizeof(int) * (threadCount + 1));
+    if(!palette || !threadCodes)
+    {
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-pes.c pesWriteSewSegSection(), cannot allocate memory for threadCodes\n");
+        free(threadCodes);
+        return;
+    }
+    embPalette_nearestList(palette, pattern->threadList, threadCodes, threadCount);
 
     mainPointer = pattern->stitchList;
     while(mainPointer)
     {
         pointer = mainPointer;
         flag = pointer->stitch.flags;
-        color = embThreadList_getAt(pattern->threadList, pointer->stitch.color).color;
-        newColorCode = embThread_findNearestColorInArray(color, (EmbThread*)pecThreads, pecThreadCount);
+        newColorCode = pesColorCode(threadCodes, threadCount, pointer->stitch.color);
         if(newColorCode != colorCode)
         {
             colorCount++;
@@ -100,8 +121,7 @@ static void pesWriteSewSegSection(EmbPattern* pattern, EmbFile* file)
     {
         pointer = mainPointer;
         flag = pointer->stitch.flags;
-        color = embThreadList_getAt(pattern->threadList, pointer->stitch.color).color;
-        newColorCode = embThread_findNearestColorInArray(color, (EmbThread*)pecThreads, pecThreadCount);
+        newColorCode = pesColorCode(threadCodes, threadCount, pointer->stitch.color);
         if(newColorCode != colorCode)
         {
             colorInfo[colorInfoIndex++] = (short)blockCount;
@@ -153,6 +173,8 @@ static void pesWriteSewSegSection(EmbPattern* pattern, EmbFile* file)
         free(colorInfo);
         colorInfo = 0;
     }
+    free(threadCodes);
+    threadCodes = 0;
 }
 
 static void pesWriteEmbOneSection(EmbPattern* pattern, EmbFile* file)
@@ -204,19 +226,19 @@ int writePes(EmbPattern* pattern, const char* fileName)
     int pecLocation;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-pes.c writePes(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-pes.c writePes(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pes.c writePes(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-pes.c writePes(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-pes.c writePes(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-pes.c writePes(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
-    if(!pattern->stitchList || embStitchList_count(pattern->stitchList) == 0) /* TODO: review this. seems like only embStitchList_count should be needed. */
+    if(embPattern_stitchCount(pattern) == 0)
     {
-        embLog_error("format-pes.c writePes(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-pes.c writePes(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -13,13 +13,13 @@ int readPhb(EmbPattern* pattern, const char* fileName)
     EmbFile* file = 0;
     int i;
 
-    if(!pattern) { embLog_error("format-phb.c readPhb(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-phb.c readPhb(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-phb.c readPhb(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-phb.c readPhb(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-phb.c readPhb(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-phb.c readPhb(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -75,12 +75,12 @@ int readPhb(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writePhb(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-phb.c writePhb(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-phb.c writePhb(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-phb.c writePhb(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-phb.c writePhb(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-phb.c writePhb(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-phb.c writePhb(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -14,13 +14,13 @@ int readPhc(EmbPattern* pattern, const char* fileName)
     EmbFile* file = 0;
     int i;
 
-    if(!pattern) { embLog_error("format-phc.c readPhc(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-phc.c readPhc(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-phc.c readPhc(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-phc.c readPhc(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-phc.c readPhc(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-phc.c readPhc(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -61,12 +61,12 @@ int readPhc(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writePhc(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-phc.c writePhc(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-phc.c writePhc(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-phc.c writePhc(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-phc.c writePhc(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-phc.c writePhc(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-phc.c writePhc(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -12,22 +12,27 @@ int readPlt(EmbPattern* pattern, const char* fileName)
     double x, y;
     double scalingFactor = 40;
     char input[512];
+    int count;
     FILE* file = 0;
 
-    if(!pattern) { embLog_error("format-plt.c readPlt(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-plt.c readPlt(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-plt.c readPlt(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-plt.c readPlt(), fileName argument is null\n"); return 0; }
 
     file = fopen(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-plt.c readPlt(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-plt.c readPlt(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
     embPattern_loadExternalColorFile(pattern, fileName);
     /* TODO: replace all scanf code */
-    while(fscanf(file, "%s", input) >= 0)
+    /* Commands end with a semicolon and need not be separated by whitespace, as writePlt() writes them */
+    while((count = fscanf(file, " %511[^;]", input)) != EOF)
     {
+        fgetc(file); /* the semicolon */
+        if(count != 1)
+            continue;
         if(startsWith("PD", input))
         {
             /* TODO: replace all scanf code */
@@ -50,7 +55,7 @@ int readPlt(EmbPattern* pattern, const char* fileName)
     fclose(file);
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
+    if(!pattern->lastStitch || pattern->lastStitch->stitch.flags != END)
         embPattern_addStitchRel(pattern, 0, 0, END, 1);
 
     return 1;
@@ -67,13 +72,13 @@ int writePlt(EmbPattern* pattern, const char* fileName)
     char firstStitchOfBlock = 1;
     FILE* file = 0;
 
-    if(!pattern) { embLog_error("format-plt.c writePlt(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-plt.c writePlt(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-plt.c writePlt(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-plt.c writePlt(), fileName argument is null\n"); return 0; }
 
     file = fopen(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-plt.c writePlt(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-plt.c writePlt(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
@@ -11,8 +11,8 @@ int readRgb(EmbPattern* pattern, const char* fileName)
     int i, numberOfColors;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-rgb.c readRgb(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-rgb.c readRgb(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-rgb.c readRgb(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-rgb.c readRgb(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
@@ -50,13 +50,13 @@ int writeRgb(EmbPattern* pattern, const char* fileName)
     EmbThreadList* colors = pattern->threadList;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-rgb.c writeRgb(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-rgb.c writeRgb(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-rgb.c writeRgb(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-rgb.c writeRgb(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-rgb.c writeRgb(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-rgb.c writeRgb(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
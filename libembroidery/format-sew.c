@@ -1,6 +1,7 @@
 #include "format-jef.h"
 #include "emb-file.h"
 #include "emb-logging.h"
+#include "emb-record.h"
 #include "emb-time.h"
 #include "helpers-binary.h"
 #include "helpers-misc.h"
@@ -25,13 +26,13 @@ int readSew(EmbPattern* pattern, const char* fileName)
     int numberOfColors;
     char thisStitchIsJump = 0;
 
-    if(!pattern) { embLog_error("format-sew.c readSew(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-sew.c readSew(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-sew.c readSew(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-sew.c readSew(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-sew.c readSew(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-sew.c readSew(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -88,7 +89,6 @@ int readSew(EmbPattern* pattern, const char* fileName)
 
         embPattern_addStitchRel(pattern, dx / 10.0, dy / 10.0, flags, 1);
     }
-    printf("current position: %ld\n", embFile_tell(file));
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
@@ -98,40 +98,6 @@ int readSew(EmbPattern* pattern, const char* fileName)
     return 1;
 }
 
-static void sewEncode(unsigned char* b, char dx, char dy, int flags)
-{
-    if(!b)
-    {
-        embLog_error("format-exp.c expEncode(), b argument is null\n");
-        return;
-    }
-    if(flags == STOP)
-    {
-        b[0] = 0x80;
-        b[1] = 1;
-        b[2] = dx;
-        b[3] = dy;
-    }
-	else if (flags == END)
-	{
-		b[0] = 0x80;
-		b[1] = 0x10;
-		b[2] = 0;
-		b[3] = 0;
-	}
-    else if(flags == TRIM || flags == JUMP)
-    {
-        b[0] = 0x80;
-        b[1] = 2;
-        b[2] = dx;
-        b[3] = dy;
-    }
-    else
-    {
-        b[0] = dx;
-        b[1] = dy;
-    }
-}
 /*! Writes the data from \a pattern to a file with the given \a fileName.
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeSew(EmbPattern* pattern, const char* fileName)
@@ -140,16 +106,16 @@ int writeSew(EmbPattern* pattern, const char* fileName)
     EmbFile* file = 0;
     EmbThreadList* threadPointer = 0;
     EmbStitchList* stitches = 0;
-    double dx = 0.0, dy = 0.0;
+    EmbRecord records[EMB_RECORD_BLOCK];
+    unsigned char buffer[EMB_RECORD_BLOCK * 4];
     double xx = 0.0, yy = 0.0;
-    int flags = 0;
-    unsigned char b[4];
-    if(!pattern) { embLog_error("format-sew.c writeSew(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-sew.c writeSew(), fileName argument is null\n"); return 0; }
+    int count = 0;
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-sew.c writeSew(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-sew.c writeSew(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-sew.c writeSew(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-sew.c writeSew(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -161,7 +127,7 @@ int writeSew(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-sew.c writeJef(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-sew.c writeJef(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
@@ -183,25 +149,22 @@ int writeSew(EmbPattern* pattern, const char* fileName)
     {
         embFile_printf(file, " ");
     }
+    /* SEW stitches are EXP records, written a block at a time */
     stitches = pattern->stitchList;
     while(stitches)
     {
-        dx = stitches->stitch.xx * 10.0 - xx;
-        dy = stitches->stitch.yy * 10.0 - yy;
+        records[count].dx = roundDouble(stitches->stitch.xx * 10.0 - xx);
+        records[count].dy = roundDouble(stitches->stitch.yy * 10.0 - yy);
+        records[count].flags = stitches->stitch.flags;
         xx = stitches->stitch.xx * 10.0;
         yy = stitches->stitch.yy * 10.0;
-        flags = stitches->stitch.flags;
-        sewEncode(b, (char)roundDouble(dx), (char)roundDouble(dy), flags);
-        if((b[0] == 0x80) && ((b[1] == 1) || (b[1] == 2) || (b[1] == 4) || (b[1] == 0x10)))
-        {
-            embFile_printf(file, "%c%c%c%c", b[0], b[1], b[2], b[3]);
-        }
-        else
+        count++;
+        stitches = stitches->next;
+        if(count == EMB_RECORD_BLOCK || !stitches)
         {
-            binaryWriteByte(file, b[0]);
-            binaryWriteByte(file, b[1]);
+            embFile_write(buffer, 1, (size_t)embRecord_encodeExp(records, count, buffer), file);
+            count = 0;
         }
-        stitches = stitches->next;
     }
     embFile_close(file);
     return 1;
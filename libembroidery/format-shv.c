@@ -44,13 +44,13 @@ int readShv(EmbPattern* pattern, const char* fileName)
     int currColorIndex = 0;
     unsigned short sx, sy;
 
-    if(!pattern) { embLog_error("format-shv.c readShv(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-shv.c readShv(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-shv.c readShv(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-shv.c readShv(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-shv.c readShv(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-shv.c readShv(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -161,12 +161,12 @@ int readShv(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeShv(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-shv.c writeShv(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-shv.c writeShv(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-shv.c writeShv(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-shv.c writeShv(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-shv.c writeShv(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-shv.c writeShv(), pattern contains no stitches\n");
         return 0;
     }
 
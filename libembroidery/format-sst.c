@@ -10,13 +10,13 @@ int readSst(EmbPattern* pattern, const char* fileName)
     int fileLength;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-sst.c readSst(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-sst.c readSst(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-sst.c readSst(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-sst.c readSst(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-sst.c readSst(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-sst.c readSst(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -62,12 +62,12 @@ int readSst(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeSst(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-sst.c writeSst(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-sst.c writeSst(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-sst.c writeSst(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-sst.c writeSst(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-sst.c writeSst(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-sst.c writeSst(), pattern contains no stitches\n");
         return 0;
     }
 
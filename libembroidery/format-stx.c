@@ -36,17 +36,17 @@ static int stxReadThread(StxThread* thread, EmbFile* file)
     EmbColor col;
     unsigned char whatIsthis; /* TODO: determine what this represents */
 
-    if(!thread) { embLog_error("format-stx.c stxReadThread(), thread argument is null\n"); return 0; }
-    if(!file) { embLog_error("format-stx.c stxReadThread(), file argument is null\n"); return 0; }
+    if(!thread) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-stx.c stxReadThread(), thread argument is null\n"); return 0; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-stx.c stxReadThread(), file argument is null\n"); return 0; }
 
     codeLength = binaryReadUInt8(file);
     codeBuff = (char*)malloc(codeLength);
-    if(!codeBuff) { embLog_error("format-stx.c stxReadThread(), unable to allocate memory for codeBuff\n"); return 0; }
+    if(!codeBuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-stx.c stxReadThread(), unable to allocate memory for codeBuff\n"); return 0; }
     binaryReadBytes(file, (unsigned char*)codeBuff, codeLength); /* TODO: check return value */
     thread->colorCode = codeBuff;
     colorNameLength = binaryReadUInt8(file);
     codeNameBuff = (char*)malloc(colorNameLength);
-    if(!codeNameBuff) { embLog_error("format-stx.c stxReadThread(), unable to allocate memory for codeNameBuff\n"); return 0; }
+    if(!codeNameBuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-stx.c stxReadThread(), unable to allocate memory for codeNameBuff\n"); return 0; }
     binaryReadBytes(file, (unsigned char*)codeNameBuff, colorNameLength); /* TODO: check return value */
     thread->colorName = codeNameBuff;
 
@@ -58,7 +58,7 @@ static int stxReadThread(StxThread* thread, EmbFile* file)
 
     sectionNameLength = binaryReadUInt8(file);
     sectionNameBuff = (char*)malloc(sectionNameLength);
-    if(!sectionNameBuff) { embLog_error("format-stx.c stxReadThread(), unable to allocate memory for sectionNameBuff\n"); return 0; }
+    if(!sectionNameBuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-stx.c stxReadThread(), unable to allocate memory for sectionNameBuff\n"); return 0; }
     binaryReadBytes(file, (unsigned char*)sectionNameBuff, sectionNameLength); /* TODO: check return value */
     thread->sectionName = sectionNameBuff;
 
@@ -66,9 +66,17 @@ static int stxReadThread(StxThread* thread, EmbFile* file)
     somethingSomething2 = binaryReadInt32(file);
     somethingElse = binaryReadInt32(file);
     numberOfOtherDescriptors = binaryReadInt16(file);
+    if(embFile_eof(file) || numberOfOtherDescriptors < 0)
+    {
+        embLog_error("format-stx.c stxReadThread(), thread is cut short\n");
+        free(codeBuff);
+        free(codeNameBuff);
+        free(sectionNameBuff);
+        return 0;
+    }
 
     thread->subDescriptors = (SubDescriptor*)malloc(sizeof(SubDescriptor) * numberOfOtherDescriptors);
-    if(!thread->subDescriptors) { embLog_error("format-stx.c stxReadThread(), unable to allocate memory for thread->subDescriptors\n"); return 0; }
+    if(!thread->subDescriptors) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-stx.c stxReadThread(), unable to allocate memory for thread->subDescriptors\n"); return 0; }
     for(j = 0; j < numberOfOtherDescriptors; j++)
     {
         SubDescriptor sd;
@@ -80,12 +88,12 @@ static int stxReadThread(StxThread* thread, EmbFile* file)
         sd.someInt = binaryReadInt32(file);
         subCodeLength = binaryReadUInt8(file);
         subCodeBuff = (char*)malloc(subCodeLength);
-        if(!subCodeBuff) { embLog_error("format-stx.c stxReadThread(), unable to allocate memory for subCodeBuff\n"); return 0; }
+        if(!subCodeBuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-stx.c stxReadThread(), unable to allocate memory for subCodeBuff\n"); return 0; }
         binaryReadBytes(file, (unsigned char*)subCodeBuff, subCodeLength); /* TODO: check return value */
         sd.colorCode = subCodeBuff;
         subColorNameLength = binaryReadUInt8(file);
         subColorNameBuff = (char*)malloc(subColorNameLength);
-        if(!subColorNameBuff) { embLog_error("format-stx.c stxReadThread(), unable to allocate memory for subColorNameBuff\n"); return 0; }
+        if(!subColorNameBuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-stx.c stxReadThread(), unable to allocate memory for subColorNameBuff\n"); return 0; }
         binaryReadBytes(file, (unsigned char*)subColorNameBuff, subColorNameLength); /* TODO: check return value */
         sd.colorName = subColorNameBuff;
         sd.someOtherInt = binaryReadInt32(file);
@@ -112,13 +120,13 @@ int readStx(EmbPattern* pattern, const char* fileName)
     int bottom,top;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-stx.c readStx(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-stx.c readStx(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-stx.c readStx(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-stx.c readStx(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-stx.c readStx(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-stx.c readStx(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -144,19 +152,26 @@ int readStx(EmbPattern* pattern, const char* fileName)
     top = binaryReadInt16(file);
 
     gif = (unsigned char*)malloc(imageLength);
-    if(!gif) { embLog_error("format-stx.c readStx(), unable to allocate memory for gif\n"); return 0; }
+    if(!gif) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-stx.c readStx(), unable to allocate memory for gif\n"); return 0; }
     binaryReadBytes(file, gif, imageLength); /* TODO: check return value */
     /*Stream s2 = new MemoryStream(gif); TODO: review */
     /*Image = new Bitmap(s2); TODO: review */
 
     threadCount = binaryReadInt16(file);
     stxThreads = (StxThread*)malloc(sizeof(StxThread) * threadCount);
-    if(!stxThreads) { embLog_error("format-stx.c readStx(), unable to allocate memory for stxThreads\n"); return 0; }
+    if(!stxThreads) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-stx.c readStx(), unable to allocate memory for stxThreads\n"); return 0; }
     for(i = 0; i < threadCount; i++)
     {
         EmbThread t;
         StxThread st;
-        stxReadThread(&st, file);
+        if(!stxReadThread(&st, file))
+        {
+            embLog_error("format-stx.c readStx(), cannot read thread %d\n", i);
+            free(stxThreads);
+            free(gif);
+            embFile_close(file);
+            return 0;
+        }
 
         t.color.r = st.stxColor.r;
         t.color.g = st.stxColor.g;
@@ -196,6 +211,8 @@ int readStx(EmbPattern* pattern, const char* fileName)
     {
         char b0 = binaryReadByte(file);
         char b1 = binaryReadByte(file);
+        if(embFile_eof(file))
+            break;
         if(b0 == -128)
         {
             switch(b1)
@@ -227,10 +244,12 @@ int readStx(EmbPattern* pattern, const char* fileName)
             i++;
         }
     }
+    free(stxThreads); /* the pattern's threads keep the names and codes */
+    free(gif);
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
-    if(pattern->lastStitch->stitch.flags != END)
+    if(!pattern->lastStitch || pattern->lastStitch->stitch.flags != END)
         embPattern_addStitchRel(pattern, 0, 0, END, 1);
 
     embPattern_flipVertical(pattern);
@@ -241,12 +260,12 @@ int readStx(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeStx(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-stx.c writeStx(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-stx.c writeStx(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-stx.c writeStx(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-stx.c writeStx(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-stx.c writeStx(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-stx.c writeStx(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -6,6 +6,33 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* A view of a token in the file being read, which is not null terminated */
+typedef struct SvgString_
+{
+    const char* data;
+    int length;
+} SvgString;
+
+/* Compares \a token with the null terminated \a name in strcmp() order. \a token may hold null characters. */
+static int svgString_compare(SvgString token, const char* name)
+{
+    int nameLength = (int)strlen(name);
+    int result = memcmp(token.data, name, token.length < nameLength ? token.length : nameLength);
+    if(result) return result;
+    if(token.length == nameLength) return 0;
+    return token.length < nameLength ? -1 : 1;
+}
+
+/* Returns a null terminated copy of \a token. The caller is responsible for freeing it. */
+static char* svgString_dup(SvgString token)
+{
+    char* copy = (char*)malloc(token.length + 1);
+    if(!copy) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c svgString_dup(), cannot allocate memory for copy\n"); return 0; }
+    if(token.length) memcpy(copy, token.data, token.length);
+    copy[token.length] = 0;
+    return copy;
+}
+
 EmbColor svgColorToEmbColor(char* colorString)
 {
     unsigned char r = 0;
@@ -121,35 +148,35 @@ EmbFlag svgPathCmdToEmbPathFlag(char cmd)
     return LINETO;
 }
 
-SvgAttribute svgAttribute_create(const char* name, const char* value)
+SvgAttribute svgAttribute_create(SvgString name, SvgString value)
 {
     SvgAttribute attribute;
     char* modValue = 0;
-    int last = 0;
     int i = 0;
 
-    modValue = emb_strdup(value);
-    last = strlen(modValue);
-    for(i = 0; i < last; i++)
+    modValue = svgString_dup(value);
+    for(i = 0; modValue && i < value.length; i++)
     {
         if(modValue[i] == '"') modValue[i] = ' ';
         if(modValue[i] == '\'') modValue[i] = ' ';
         if(modValue[i] == '/') modValue[i] = ' ';
         if(modValue[i] == ',') modValue[i] = ' ';
+        if(modValue[i] == '\t' || modValue[i] == '\r' || modValue[i] == '\n') modValue[i] = ' ';
     }
-    attribute.name = emb_strdup(name);
+    attribute.name = svgString_dup(name);
     attribute.value = modValue;
     return attribute;
 }
 
 void svgElement_addAttribute(SvgElement* element, SvgAttribute data)
 {
-    if(!element) { embLog_error("format-svg.c svgElement_addAttribute(), element argument is null\n"); return; }
+    if(!element) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c svgElement_addAttribute(), element argument is null\n"); return; }
+    if(!data.name || !data.value) { free(data.name); free(data.value); return; }
 
     if(!(element->attributeList))
     {
         element->attributeList = (SvgAttributeList*)malloc(sizeof(SvgAttributeList));
-        if(!(element->attributeList)) { embLog_error("format-svg.c svgElement_addAttribute(), cannot allocate memory for element->attributeList\n"); return; }
+        if(!(element->attributeList)) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c svgElement_addAttribute(), cannot allocate memory for element->attributeList\n"); return; }
         element->attributeList->attribute = data;
         element->attributeList->next = 0;
         element->lastAttribute = element->attributeList;
@@ -159,12 +186,16 @@ void svgElement_addAttribute(SvgElement* element, SvgAttribute data)
     {
         SvgAttributeList* pointerLast = element->lastAttribute;
         SvgAttributeList* list = (SvgAttributeList*)malloc(sizeof(SvgAttributeList));
-        if(!list) { embLog_error("format-svg.c svgElement_addAttribute(), cannot allocate memory for list\n"); return; }
+        if(!list) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c svgElement_addAttribute(), cannot allocate memory for list\n"); return; }
         list->attribute = data;
         list->next = 0;
         pointerLast->next = list;
         element->lastAttribute = list;
     }
+
+    /* The first of repeated attributes wins, as in the list */
+    if(element->attributeMap && !embHash_value(element->attributeMap, data.name))
+        embHash_insert(element->attributeMap, data.name, data.value);
 }
 
 void svgElement_free(SvgElement* element)
@@ -177,6 +208,9 @@ void svgElement_free(SvgElement* element)
 
     while(list)
     {
+        /* The map keeps the name for the next element, but not the value */
+        if(element->attributeMap)
+            embHash_insert(element->attributeMap, list->attribute.name, 0);
         free(list->attribute.name);
         list->attribute.name = 0;
         free(list->attribute.value);
@@ -194,27 +228,35 @@ void svgElement_free(SvgElement* element)
     element = 0;
 }
 
-SvgElement* svgElement_create(const char* name)
+SvgElement* svgElement_create(SvgString name)
 {
     SvgElement* element = 0;
 
     element = (SvgElement*)malloc(sizeof(SvgElement));
-    if(!element) { embLog_error("format-svg.c svgElement_create(), cannot allocate memory for element\n"); return 0; }
-    element->name = emb_strdup(name);
-    if(!element->name) { embLog_error("format-svg.c svgElement_create(), element->name is null\n"); return 0; }
+    if(!element) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c svgElement_create(), cannot allocate memory for element\n"); return 0; }
+    element->name = svgString_dup(name);
+    if(!element->name) { embLog_error("format-svg.c svgElement_create(), element->name is null\n"); free(element); return 0; }
     element->attributeList = 0;
     element->lastAttribute = 0;
+    element->attributeMap = 0;
     return element;
 }
 
 char* svgAttribute_getValue(SvgElement* element, const char* name)
 {
     SvgAttributeList* pointer = 0;
+    char* value = 0;
 
-    if(!element) { embLog_error("format-svg.c svgAttribute_getValue(), element argument is null\n"); return "none"; }
-    if(!name) { embLog_error("format-svg.c svgAttribute_getValue(), name argument is null\n"); return "none"; }
+    if(!element) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c svgAttribute_getValue(), element argument is null\n"); return "none"; }
+    if(!name) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c svgAttribute_getValue(), name argument is null\n"); return "none"; }
     if(!element->attributeList) { /* TODO: error */ return "none"; }
 
+    if(element->attributeMap)
+    {
+        value = (char*)embHash_value(element->attributeMap, name);
+        return value ? value : "none";
+    }
+
     pointer = element->attributeList;
     while(pointer)
     {
@@ -225,14 +267,14 @@ char* svgAttribute_getValue(SvgElement* element, const char* name)
     return "none";
 }
 
-void svgAddToPattern(EmbPattern* p)
+void svgAddToPattern(EmbPattern* p, SvgElement* element)
 {
     const char* buff = 0;
 
-    if(!p) { embLog_error("format-svg.c svgAddToPattern(), p argument is null\n"); return; }
-    if(!currentElement) { return; }
+    if(!p) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c svgAddToPattern(), p argument is null\n"); return; }
+    if(!element) { return; }
 
-    buff = currentElement->name;
+    buff = element->name;
     if(!buff) { return; }
 
     if     (!strcmp(buff, "?xml"))             {  }
@@ -245,19 +287,19 @@ void svgAddToPattern(EmbPattern* p)
     else if(!strcmp(buff, "audio"))            {  }
     else if(!strcmp(buff, "circle"))
     {
-        embPattern_addCircleObjectAbs(p, atof(svgAttribute_getValue(currentElement, "cx")),
-                                         atof(svgAttribute_getValue(currentElement, "cy")),
-                                         atof(svgAttribute_getValue(currentElement, "r")));
+        embPattern_addCircleObjectAbs(p, atof(svgAttribute_getValue(element, "cx")),
+                                         atof(svgAttribute_getValue(element, "cy")),
+                                         atof(svgAttribute_getValue(element, "r")));
     }
     else if(!strcmp(buff, "defs"))             {  }
     else if(!strcmp(buff, "desc"))             {  }
     else if(!strcmp(buff, "discard"))          {  }
     else if(!strcmp(buff, "ellipse"))
     {
-        embPattern_addEllipseObjectAbs(p, atof(svgAttribute_getValue(currentElement, "cx")),
-                                          atof(svgAttribute_getValue(currentElement, "cy")),
-                                          atof(svgAttribute_getValue(currentElement, "rx")),
-                                          atof(svgAttribute_getValue(currentElement, "ry")));
+        embPattern_addEllipseObjectAbs(p, atof(svgAttribute_getValue(element, "cx")),
+                                          atof(svgAttribute_getValue(element, "cy")),
+                                          atof(svgAttribute_getValue(element, "rx")),
+                                          atof(svgAttribute_getValue(element, "ry")));
     }
     else if(!strcmp(buff, "font"))             {  }
     else if(!strcmp(buff, "font-face"))        {  }
@@ -271,10 +313,10 @@ void svgAddToPattern(EmbPattern* p)
     else if(!strcmp(buff, "image"))            {  }
     else if(!strcmp(buff, "line"))
     {
-        char* x1 = svgAttribute_getValue(currentElement, "x1");
-        char* y1 = svgAttribute_getValue(currentElement, "y1");
-        char* x2 = svgAttribute_getValue(currentElement, "x2");
-        char* y2 = svgAttribute_getValue(currentElement, "y2");
+        char* x1 = svgAttribute_getValue(element, "x1");
+        char* y1 = svgAttribute_getValue(element, "y1");
+        char* x2 = svgAttribute_getValue(element, "x2");
+        char* y2 = svgAttribute_getValue(element, "y2");
 
         /* If the starting and ending points are the same, it is a point */
         if(!strcmp(x1, x2) && !strcmp(y1, y2))
@@ -291,8 +333,7 @@ void svgAddToPattern(EmbPattern* p)
     {
         /* TODO: finish */
 
-        char* pointStr = svgAttribute_getValue(currentElement, "d");
-        char* mystrok = svgAttribute_getValue(currentElement, "stroke");
+        char* pointStr = svgAttribute_getValue(element, "d");
 
         int last = strlen(pointStr);
         int size = 32;
@@ -323,9 +364,7 @@ void svgAddToPattern(EmbPattern* p)
 
         char* pathbuff = 0;
         pathbuff = (char*)malloc(size);
-        if(!pathbuff) { embLog_error("format-svg.c svgAddToPattern(), cannot allocate memory for pathbuff\n"); return; }
-
-        printf("stroke:%s\n", mystrok);
+        if(!pathbuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c svgAddToPattern(), cannot allocate memory for pathbuff\n"); return; }
 
         /* M44.219,26.365c0,10.306-8.354,18.659-18.652,18.659c-10.299,0-18.663-8.354-18.663-18.659c0-10.305,8.354-18.659,18.659-18.659C35.867,7.707,44.219,16.06,44.219,26.365z */
         for(i = 0; i < last; i++)
@@ -354,7 +393,6 @@ void svgAddToPattern(EmbPattern* p)
                     if(pos > 0) {         /* append float to array, if it not yet stored */
                         pathbuff[pos] = 0;
                         pos = 0;
-                        printf("    ,val:%s\n", pathbuff);
                         pathData[++trip] = atof(pathbuff);
                     }
                     break;
@@ -364,7 +402,6 @@ void svgAddToPattern(EmbPattern* p)
                     if(pos > 0) {         /* append float to array, if it not yet stored */
                         pathbuff[pos] = 0;
                         pos = 0;
-                        printf("    -val:%s\n", pathbuff);
                         pathData[++trip] = atof(pathbuff);
                     }
                     pathbuff[pos++] = (char)c;                  /* add a more char */
@@ -377,7 +414,6 @@ void svgAddToPattern(EmbPattern* p)
                     if(pos > 0) {         /* just make sure: append float to array, if it not yet stored */
                         pathbuff[pos] = 0;
                         pos = 0;
-                        printf("    >val:%s\n", pathbuff);
                         pathData[++trip] = atof(pathbuff);
                     }
 
@@ -439,16 +475,6 @@ void svgAddToPattern(EmbPattern* p)
                             pathbuff[1] = 0;
                             pos = 0;
 
-                            printf("*prior:%s (%f, %f,  %f, %f,     %f,%f,  %f) \n", pathbuff,
-                                   pathData[0],
-                                   pathData[1],
-                                   pathData[2],
-                                   pathData[3],
-                                   pathData[4],
-                                   pathData[5],
-                                   pathData[6]
-                                   );
-
                     }
 
                     /* assign new command */
@@ -457,7 +483,6 @@ void svgAddToPattern(EmbPattern* p)
                         pathbuff[0] = (char)c;                  /* set the command for compare */
                         pathbuff[1] = 0;
 
-                        printf("cmd:%s\n", pathbuff);
                         if     (!strcmp(pathbuff, "M")) { cmd = 'M'; reset = 2; numMoves++; }
                         else if(!strcmp(pathbuff, "m")) { cmd = 'm'; reset = 2; numMoves++; }
                         else if(!strcmp(pathbuff, "L")) { cmd = 'L'; reset = 2; }
@@ -498,7 +523,7 @@ void svgAddToPattern(EmbPattern* p)
                 /* increase pathbuff length - leave room for 0 */
                 size *= 2;
                 pathbuff = (char*)realloc(pathbuff, size);
-                if(!pathbuff) { embLog_error("format-svg.c svgAddToPattern(), cannot re-allocate memory for pathbuff\n"); return; }
+                if(!pathbuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c svgAddToPattern(), cannot re-allocate memory for pathbuff\n"); return; }
             }
         }
         free(pathbuff);
@@ -506,12 +531,12 @@ void svgAddToPattern(EmbPattern* p)
 
         /* TODO: subdivide numMoves > 1 */
 
-        embPattern_addPathObjectAbs(p, embPathObject_create(startOfPointList, startOfFlagList, svgColorToEmbColor(svgAttribute_getValue(currentElement, "stroke")), 1));
+        embPattern_addPathObjectAbs(p, embPathObject_create(startOfPointList, startOfFlagList, svgColorToEmbColor(svgAttribute_getValue(element, "stroke")), 1));
     }
     else if(!strcmp(buff, "polygon") ||
             !strcmp(buff, "polyline"))
     {
-        char* pointStr = svgAttribute_getValue(currentElement, "points");
+        char* pointStr = svgAttribute_getValue(element, "points");
         int last = strlen(pointStr);
         int size = 32;
         int i = 0;
@@ -526,7 +551,7 @@ void svgAddToPattern(EmbPattern* p)
 
         char* polybuff = 0;
         polybuff = (char*)malloc(size);
-        if(!polybuff) { embLog_error("format-svg.c svgAddToPattern(), cannot allocate memory for polybuff\n"); return; }
+        if(!polybuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c svgAddToPattern(), cannot allocate memory for polybuff\n"); return; }
 
         for(i = 0; i < last; i++)
         {
@@ -570,7 +595,7 @@ void svgAddToPattern(EmbPattern* p)
                 /* increase polybuff length - leave room for 0 */
                 size *= 2;
                 polybuff = (char*)realloc(polybuff, size);
-                if(!polybuff) { embLog_error("format-svg.c svgAddToPattern(), cannot re-allocate memory for polybuff\n"); return; }
+                if(!polybuff) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c svgAddToPattern(), cannot re-allocate memory for polybuff\n"); return; }
             }
         }
         free(polybuff);
@@ -578,12 +603,12 @@ void svgAddToPattern(EmbPattern* p)
 
         if(!strcmp(buff, "polygon"))
         {
-            EmbPolygonObject* polygonObj = embPolygonObject_create(startOfPointList, svgColorToEmbColor(svgAttribute_getValue(currentElement, "stroke")), 1); /* TODO: use lineType enum */
+            EmbPolygonObject* polygonObj = embPolygonObject_create(startOfPointList, svgColorToEmbColor(svgAttribute_getValue(element, "stroke")), 1); /* TODO: use lineType enum */
             embPattern_addPolygonObjectAbs(p, polygonObj);
         }
         else /* polyline */
         {
-            EmbPolylineObject* polylineObj = embPolylineObject_create(startOfPointList, svgColorToEmbColor(svgAttribute_getValue(currentElement, "stroke")), 1); /* TODO: use lineType enum */
+            EmbPolylineObject* polylineObj = embPolylineObject_create(startOfPointList, svgColorToEmbColor(svgAttribute_getValue(element, "stroke")), 1); /* TODO: use lineType enum */
             embPattern_addPolylineObjectAbs(p, polylineObj);
         }
     }
@@ -591,10 +616,10 @@ void svgAddToPattern(EmbPattern* p)
     else if(!strcmp(buff, "radialGradient"))   {  }
     else if(!strcmp(buff, "rect"))
     {
-        embPattern_addRectObjectAbs(p, atof(svgAttribute_getValue(currentElement, "x")),
-                                       atof(svgAttribute_getValue(currentElement, "y")),
-                                       atof(svgAttribute_getValue(currentElement, "width")),
-                                       atof(svgAttribute_getValue(currentElement, "height")));
+        embPattern_addRectObjectAbs(p, atof(svgAttribute_getValue(element, "x")),
+                                       atof(svgAttribute_getValue(element, "y")),
+                                       atof(svgAttribute_getValue(element, "width")),
+                                       atof(svgAttribute_getValue(element, "height")));
     }
     else if(!strcmp(buff, "script"))           {  }
     else if(!strcmp(buff, "set"))              {  }
@@ -609,2630 +634,800 @@ void svgAddToPattern(EmbPattern* p)
     else if(!strcmp(buff, "tspan"))            {  }
     else if(!strcmp(buff, "use"))              {  }
     else if(!strcmp(buff, "video"))            {  }
-
-    svgElement_free(currentElement);
-    currentElement = 0;
 }
 
 
-int svgIsElement(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "?xml"))                { type = SVG_NULL; } /* TODO: Fix the xml version ? messing with svg version */
-    else if(!strcmp(buff, "a"))                   { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "altGlyph"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "altGlyphDef"))         { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "altGlyphItem"))        { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "animate"))             { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "animateColor"))        { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "animateMotion"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "animateTransform"))    { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "animation"))           { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "audio"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "circle"))              { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "clipPath"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "color-profile"))       { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "cursor"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "defs"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "desc"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "discard"))             { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "ellipse"))             { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "feBlend"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feColorMatrix"))       { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feComponentTransfer")) { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feComposite"))         { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feConvolveMatrix"))    { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feDiffuseLighting"))   { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feDisplacementMap"))   { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feDistantLight"))      { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFlood"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFuncA"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFuncB"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFuncG"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feFuncR"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feGaussianBlur"))      { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feImage"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feMerge"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feMergeNode"))         { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feMorphology"))        { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feOffset"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "fePointLight"))        { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feSpecularLighting"))  { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feSpotLight"))         { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feTile"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "feTurbulence"))        { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "filter"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "font"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "font-face"))           { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "font-face-format"))    { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "font-face-name"))      { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "font-face-src"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "font-face-uri"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "foreignObject"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "g"))                   { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "glyph"))               { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "glyphRef"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "handler"))             { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "hkern"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "image"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "line"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "linearGradient"))      { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "listener"))            { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "marker"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "mask"))                { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "metadata"))            { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "missing-glyph"))       { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "mpath"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "path"))                { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "pattern"))             { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "polygon"))             { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "polyline"))            { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "prefetch"))            { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "radialGradient"))      { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "rect"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "script"))              { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "set"))                 { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "solidColor"))          { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "stop"))                { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "style"))               { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "svg"))                 { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "switch"))              { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "symbol"))              { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "tbreak"))              { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "text"))                { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "textArea"))            { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "textPath"))            { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "title"))               { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "tref"))                { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
-    else if(!strcmp(buff, "tspan"))               { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "use"))                 { type = SVG_ELEMENT; }
-    else if(!strcmp(buff, "video"))               { type = SVG_ELEMENT; }
- /* else if(!strcmp(buff, "view"))                { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
- /* else if(!strcmp(buff, "vkern"))               { type = SVG_ELEMENT; } TODO: SVG Full 1.1 Spec Element */
+/* Keyword tables of the tokenizer. Each one is sorted in strcmp() order so it can be searched with bsearch(),
+ * so keep them sorted when adding names. */
 
-    /* Attempt to identify the program that created the SVG file. This should be in a comment at that occurs before the svg element. */
-    else if(!strcmp(buff, "Embroidermodder"))     { type = SVG_NULL; svgCreator = SVG_CREATOR_EMBROIDERMODDER; }
-    else if(!strcmp(buff, "Illustrator"))         { type = SVG_NULL; svgCreator = SVG_CREATOR_ILLUSTRATOR; }
-    else if(!strcmp(buff, "Inkscape"))            { type = SVG_NULL; svgCreator = SVG_CREATOR_INKSCAPE; }
-
-    else                                          { type = SVG_NULL; }
-    return type;
-}
-
-int svgIsMediaProperty(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "audio-level"))           { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "buffered-rendering"))    { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "display"))               { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "image-rendering"))       { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "pointer-events"))        { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "shape-rendering"))       { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "text-rendering"))        { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "viewport-fill"))         { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "viewport-fill-opacity")) { type = SVG_MEDIA_PROPERTY; }
-    else if(!strcmp(buff, "visibility"))            { type = SVG_MEDIA_PROPERTY; }
-    return type;
-}
+static const char* const svgProperties[] =
+{
+    "audio-level", "buffered-rendering", "color", "color-rendering", "direction", "display", "display-align",
+    "fill", "fill-opacity", "fill-rule", "font-family", "font-size", "font-style", "font-variant",
+    "font-weight", "image-rendering", "line-increment", "opacity", "pointer-events", "shape-rendering",
+    "solid-color", "solid-opacity", "stop-color", "stop-opacity", "stroke", "stroke-dasharray",
+    "stroke-linecap", "stroke-linejoin", "stroke-miterlimit", "stroke-opacity", "stroke-width", "text-align",
+    "text-anchor", "text-rendering", "unicode-bidi", "vector-effect", "viewport-fill", "viewport-fill-opacity",
+    "visibility"
+};
+
+static const char* const svgMediaProperties[] =
+{
+    "audio-level", "buffered-rendering", "display", "image-rendering", "pointer-events", "shape-rendering",
+    "text-rendering", "viewport-fill", "viewport-fill-opacity", "visibility"
+};
 
-int svgIsProperty(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "audio-level"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "buffered-rendering"))    { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "color"))                 { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "color-rendering"))       { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "direction"))             { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "display"))               { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "display-align"))         { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "fill"))                  { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "fill-opacity"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "fill-rule"))             { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-family"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-size"))             { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-style"))            { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-variant"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "font-weight"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "image-rendering"))       { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "line-increment"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "opacity"))               { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "pointer-events"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "shape-rendering"))       { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "solid-color"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "solid-opacity"))         { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stop-color"))            { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stop-opacity"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke"))                { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-dasharray"))      { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-linecap"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-linejoin"))       { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-miterlimit"))     { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-opacity"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "stroke-width"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "text-align"))            { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "text-anchor"))           { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "text-rendering"))        { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "unicode-bidi"))          { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "vector-effect"))         { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "viewport-fill"))         { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "viewport-fill-opacity")) { type = SVG_PROPERTY; }
-    else if(!strcmp(buff, "visibility"))            { type = SVG_PROPERTY; }
-    return type;
-}
+static const char* const svgXmlAttributes[] =
+{
+    "/", "encoding", "standalone", "version"
+};
 
-int svgIsXmlAttribute(const char* buff)
+static const char* const svgLinkAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "focusHighlight", "focusable",
+    "id", "nav-down", "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right",
+    "nav-up", "nav-up-left", "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures",
+    "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage", "target", "transform",
+    "typeof", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title",
+    "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgAnimateAttributes[] =
+{
+    "/", "about", "accumulate", "additive", "attributeName", "attributeType", "begin", "by", "calcMode",
+    "class", "content", "datatype", "dur", "end", "fill", "from", "id", "keySplines", "keyTimes", "max", "min",
+    "property", "rel", "repeatCount", "repeatDur", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "restart", "rev", "role", "systemLanguage", "to", "typeof", "values",
+    "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title", "xlink:type",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgAnimateColorAttributes[] =
+{
+    "/", "about", "accumulate", "additive", "attributeName", "attributeType", "begin", "by", "calcMode",
+    "class", "content", "datatype", "dur", "end", "fill", "from", "id", "keySplines", "keyTimes", "max", "min",
+    "property", "rel", "repeatCount", "repeatDur", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "restart", "rev", "role", "systemLanguage", "to", "typeof", "values",
+    "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title", "xlink:type",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgAnimateMotionAttributes[] =
+{
+    "/", "about", "accumulate", "additive", "begin", "by", "calcMode", "class", "content", "datatype", "dur",
+    "end", "fill", "from", "id", "keyPoints", "keySplines", "keyTimes", "max", "min", "origin", "path",
+    "property", "rel", "repeatCount", "repeatDur", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "restart", "rev", "role", "rotate", "systemLanguage", "to", "typeof",
+    "values", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title",
+    "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgAnimateTransformAttributes[] =
+{
+    "/", "about", "accumulate", "additive", "attributeName", "attributeType", "begin", "by", "calcMode",
+    "class", "content", "datatype", "dur", "end", "fill", "from", "id", "keySplines", "keyTimes", "max", "min",
+    "property", "rel", "repeatCount", "repeatDur", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "restart", "rev", "role", "systemLanguage", "to", "type", "typeof", "values",
+    "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title", "xlink:type",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgAnimationAttributes[] =
+{
+    "/", "about", "begin", "class", "content", "datatype", "dur", "end", "externalResourcesRequired", "fill",
+    "focusHighlight", "focusable", "height", "id", "initialVisibility", "max", "min", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "preserveAspectRatio", "property", "rel", "repeatCount", "repeatDur", "requiredExtensions",
+    "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "restart", "rev", "role",
+    "syncBehavior", "syncMaster", "syncTolerance", "systemLanguage", "transform", "typeof", "width", "x",
+    "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title", "xlink:type",
+    "xml:base", "xml:id", "xml:lang", "xml:space", "y"
+};
+
+static const char* const svgAudioAttributes[] =
 {
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "encoding"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "standalone")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "version"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))          { type = SVG_ATTRIBUTE; }
+    "/", "about", "begin", "class", "content", "datatype", "dur", "end", "externalResourcesRequired", "fill",
+    "id", "max", "min", "property", "rel", "repeatCount", "repeatDur", "requiredExtensions", "requiredFeatures",
+    "requiredFonts", "requiredFormats", "resource", "restart", "rev", "role", "syncBehavior", "syncMaster",
+    "syncTolerance", "systemLanguage", "type", "typeof", "xlink:actuate", "xlink:arcrole", "xlink:href",
+    "xlink:role", "xlink:show", "xlink:title", "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgCircleAttributes[] =
+{
+    "/", "about", "class", "content", "cx", "cy", "datatype", "focusHighlight", "focusable", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "property", "r", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof", "xml:base", "xml:id",
+    "xml:lang", "xml:space"
+};
+
+static const char* const svgDefsAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "property", "rel", "resource", "rev", "role", "typeof",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsXmlAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgDescAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "property", "rel", "requiredExtensions",
+    "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage",
+    "typeof", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsLinkAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "target"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsLinkAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgDiscardAttributes[] =
+{
+    "/", "about", "begin", "class", "content", "datatype", "id", "property", "rel", "requiredExtensions",
+    "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage",
+    "typeof", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title",
+    "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsAnimateAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accumulate"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "additive"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeName"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeType"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "by"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "calcMode"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "from"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keySplines"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyTimes"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "values"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimateAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgEllipseAttributes[] =
+{
+    "/", "about", "class", "content", "cx", "cy", "datatype", "focusHighlight", "focusable", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "rx", "ry", "systemLanguage", "transform", "typeof",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgFontAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "horiz-adv-x", "horiz-origin-x",
+    "id", "property", "rel", "resource", "rev", "role", "typeof", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsAnimateColorAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accumulate"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "additive"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeName"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeType"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "by"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "calcMode"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "from"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keySplines"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyTimes"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "values"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimateColorAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgFontFaceAttributes[] =
+{
+    "/", "about", "accent-height", "alphabetic", "ascent", "bbox", "cap-height", "class", "content", "datatype",
+    "descent", "externalResourcesRequired", "font-family", "font-stretch", "font-style", "font-variant",
+    "font-weight", "hanging", "id", "ideographic", "mathematical", "overline-position", "overline-thickness",
+    "panose-1", "property", "rel", "resource", "rev", "role", "slope", "stemh", "stemv",
+    "strikethrough-position", "strikethrough-thickness", "typeof", "underline-position", "underline-thickness",
+    "unicode-range", "units-per-em", "widths", "x-height", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgFontFaceSrcAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "property", "rel", "resource", "rev", "role", "typeof",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsAnimateMotionAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accumulate"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "additive"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "by"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "calcMode"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "from"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyPoints"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keySplines"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyTimes"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "origin"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "path"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rotate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "values"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimateMotionAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgFontFaceUriAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "id", "property", "rel",
+    "resource", "rev", "role", "typeof", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role",
+    "xlink:show", "xlink:title", "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsAnimateTransformAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accumulate"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "additive"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeName"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeType"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "by"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "calcMode"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "from"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keySplines"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "keyTimes"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "values"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimateTransformAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgForeignObjectAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "focusHighlight", "focusable",
+    "height", "id", "nav-down", "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev",
+    "nav-right", "nav-up", "nav-up-left", "nav-up-right", "property", "rel", "requiredExtensions",
+    "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage",
+    "transform", "typeof", "width", "x", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role",
+    "xlink:show", "xlink:title", "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space", "y"
+};
+
+static const char* const svgGroupAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "focusHighlight", "focusable",
+    "id", "nav-down", "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right",
+    "nav-up", "nav-up-left", "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures",
+    "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgGlyphAttributes[] =
+{
+    "/", "about", "arabic-form", "class", "content", "d", "datatype", "glyph-name", "horiz-adv-x", "id", "lang",
+    "property", "rel", "resource", "rev", "role", "typeof", "unicode", "xml:base", "xml:id", "xml:lang",
+    "xml:space"
+};
 
-int svgIsAnimationAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "initialVisibility"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncBehavior"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncMaster"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncTolerance"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAnimationAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgHandlerAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "ev:event", "externalResourcesRequired", "id", "property",
+    "rel", "resource", "rev", "role", "type", "typeof", "xlink:actuate", "xlink:arcrole", "xlink:href",
+    "xlink:role", "xlink:show", "xlink:title", "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsAudioAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncBehavior"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncMaster"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncTolerance"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsAudioAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgHKernAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "g1", "g2", "id", "k", "property", "rel", "resource", "rev",
+    "role", "typeof", "u1", "u2", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsCircleAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cx"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cy"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "r"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsCircleAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgImageAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "focusHighlight", "focusable",
+    "height", "id", "nav-down", "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev",
+    "nav-right", "nav-up", "nav-up-left", "nav-up-right", "opacity", "preserveAspectRatio", "property", "rel",
+    "requiredExtensions", "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "rev", "role",
+    "systemLanguage", "transform", "type", "typeof", "width", "x", "xlink:actuate", "xlink:arcrole",
+    "xlink:href", "xlink:role", "xlink:show", "xlink:title", "xlink:type", "xml:base", "xml:id", "xml:lang",
+    "xml:space", "y"
+};
+
+static const char* const svgLineAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "focusHighlight", "focusable", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof", "x1", "x2",
+    "xml:base", "xml:id", "xml:lang", "xml:space", "y1", "y2"
+};
+
+static const char* const svgLinearGradientAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "gradientUnits", "id", "property", "rel", "resource", "rev",
+    "role", "typeof", "x1", "x2", "xml:base", "xml:id", "xml:lang", "xml:space", "y1", "y2"
+};
 
-int svgIsDefsAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsDefsAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgListenerAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "defaultAction", "event", "handler", "id", "observer",
+    "phase", "propagate", "property", "rel", "resource", "rev", "role", "target", "typeof", "xml:base",
+    "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsDescAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsDescAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgMetadataAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "property", "rel", "requiredExtensions",
+    "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage",
+    "typeof", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsDiscardAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsDiscardAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgMissingGlyphAttributes[] =
+{
+    "/", "about", "class", "content", "d", "datatype", "horiz-adv-x", "id", "property", "rel", "resource",
+    "rev", "role", "typeof", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsEllipseAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cx"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cy"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rx"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ry"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsEllipseAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgMPathAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "property", "rel", "resource", "rev", "role", "typeof",
+    "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title", "xlink:type",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsFontAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "horiz-adv-x"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "horiz-origin-x"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsFontAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgPathAttributes[] =
+{
+    "/", "about", "class", "content", "d", "datatype", "focusHighlight", "focusable", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "pathLength", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof", "xml:base", "xml:id",
+    "xml:lang", "xml:space"
+};
+
+static const char* const svgPolygonAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "focusHighlight", "focusable", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "points", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof", "xml:base", "xml:id",
+    "xml:lang", "xml:space"
+};
+
+static const char* const svgPolylineAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "focusHighlight", "focusable", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "points", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof", "xml:base", "xml:id",
+    "xml:lang", "xml:space"
+};
+
+static const char* const svgPrefetchAttributes[] =
+{
+    "/", "about", "bandwidth", "class", "content", "datatype", "id", "mediaCharacterEncoding",
+    "mediaContentEncodings", "mediaSize", "mediaTime", "property", "rel", "resource", "rev", "role", "typeof",
+    "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title", "xlink:type",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsFontFaceAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "accent-height"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "alphabetic"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ascent"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "bbox"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cap-height"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "descent"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-family"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-stretch"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-style"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-variant"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "font-weight"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "hanging"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ideographic"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mathematical"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "overline-position"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "overline-thickness"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "panose-1"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "slope"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "stemh"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "stemv"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "strikethrough-position"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "strikethrough-thickness"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "underline-position"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "underline-thickness"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "unicode-range"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "units-per-em"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "widths"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x-height"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsFontFaceAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgRadialGradientAttributes[] =
+{
+    "/", "about", "class", "content", "cx", "cy", "datatype", "gradientUnits", "id", "property", "r", "rel",
+    "resource", "rev", "role", "typeof", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsFontFaceSrcAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsFontFaceSrcAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgRectAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "focusHighlight", "focusable", "height", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "rx", "ry", "systemLanguage", "transform", "typeof", "width",
+    "x", "xml:base", "xml:id", "xml:lang", "xml:space", "y"
+};
+
+static const char* const svgScriptAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "id", "property", "rel",
+    "resource", "rev", "role", "type", "typeof", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role",
+    "xlink:show", "xlink:title", "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsFontFaceUriAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsFontFaceUriAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgSetAttributes[] =
+{
+    "/", "about", "attributeName", "attributeType", "begin", "class", "content", "datatype", "dur", "end",
+    "fill", "id", "max", "min", "property", "rel", "repeatCount", "repeatDur", "requiredExtensions",
+    "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage", "to",
+    "typeof", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title",
+    "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgSolidColorAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "property", "rel", "resource", "rev", "role", "typeof",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsForeignObjectAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsForeignObjectAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgStopAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "offset", "property", "rel", "resource", "rev", "role",
+    "typeof", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsGroupAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsGroupAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgSvgAttributes[] =
+{
+    "/", "about", "baseProfile", "class", "content", "contentScriptType", "datatype",
+    "externalResourcesRequired", "focusHighlight", "focusable", "height", "id", "nav-down", "nav-down-left",
+    "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left", "nav-up-right",
+    "playbackOrder", "preserveAspectRatio", "property", "rel", "resource", "rev", "role", "snapshotTime",
+    "syncBehaviorDefault", "syncToleranceDefault", "timelineBegin", "typeof", "version", "viewBox", "width",
+    "xml:base", "xml:id", "xml:lang", "xml:space", "zoomAndPan"
+};
+
+static const char* const svgSwitchAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "focusHighlight", "focusable",
+    "id", "nav-down", "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right",
+    "nav-up", "nav-up-left", "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures",
+    "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof",
+    "xml:base", "xml:id", "xml:lang", "xml:space"
+};
+
+static const char* const svgTBreakAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "property", "rel", "requiredExtensions",
+    "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage",
+    "typeof", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsGlyphAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "arabic-form")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "d"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "glyph-name"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "horiz-adv-x")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "lang"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "unicode"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))           { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsGlyphAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgTextAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "editable", "focusHighlight", "focusable", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "rotate", "systemLanguage", "transform", "typeof", "x",
+    "xml:base", "xml:id", "xml:lang", "xml:space", "y"
+};
+
+static const char* const svgTextAreaAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "editable", "focusHighlight", "focusable", "height", "id",
+    "nav-down", "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up",
+    "nav-up-left", "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof", "width", "x",
+    "xml:base", "xml:id", "xml:lang", "xml:space", "y"
+};
+
+static const char* const svgTitleAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "id", "property", "rel", "requiredExtensions",
+    "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage",
+    "typeof", "xml:base", "xml:id", "xml:lang", "xml:space"
+};
 
-int svgIsHandlerAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ev:event"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsHandlerAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+static const char* const svgTSpanAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "focusHighlight", "focusable", "id", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures", "requiredFonts",
+    "requiredFormats", "resource", "rev", "role", "systemLanguage", "typeof", "xml:base", "xml:id", "xml:lang",
+    "xml:space"
+};
+
+static const char* const svgUseAttributes[] =
+{
+    "/", "about", "class", "content", "datatype", "externalResourcesRequired", "focusHighlight", "focusable",
+    "id", "nav-down", "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right",
+    "nav-up", "nav-up-left", "nav-up-right", "property", "rel", "requiredExtensions", "requiredFeatures",
+    "requiredFonts", "requiredFormats", "resource", "rev", "role", "systemLanguage", "transform", "typeof", "x",
+    "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show", "xlink:title", "xlink:type",
+    "xml:base", "xml:id", "xml:lang", "xml:space", "y"
+};
+
+static const char* const svgVideoAttributes[] =
+{
+    "/", "about", "begin", "class", "content", "datatype", "dur", "end", "externalResourcesRequired", "fill",
+    "focusHighlight", "focusable", "height", "id", "initialVisibility", "max", "min", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "overlay", "preserveAspectRatio", "property", "rel", "repeatCount", "repeatDur",
+    "requiredExtensions", "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "restart", "rev",
+    "role", "syncBehavior", "syncMaster", "syncTolerance", "systemLanguage", "transform", "transformBehavior",
+    "type", "typeof", "width", "x", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role", "xlink:show",
+    "xlink:title", "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space", "y"
+};
+
+/* Namespaces Inkscape declares on the svg element */
+static const char* const svgInkscapeSvgAttributes[] =
+{
+    "xmlns", "xmlns:cc", "xmlns:dc", "xmlns:rdf", "xmlns:svg"
+};
 
-int svgIsHKernAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "g1"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "g2"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "k"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "u1"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "u2"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsHKernAttribute(), unknown: %s\n", buff); }
-    return type;
+static const char* const svgCatchAllAttributes[] =
+{
+    "/", "about", "accent-height", "accumulate", "additive", "alphabetic", "arabic-form", "ascent",
+    "attributeName", "attributeType", "audio-level", "bandwidth", "baseProfile", "bbox", "begin",
+    "buffered-rendering", "by", "calcMode", "cap-height", "class", "color", "color-rendering", "content",
+    "contentScriptType", "cx", "cy", "d", "datatype", "defaultAction", "descent", "direction", "display",
+    "display-align", "dur", "editable", "end", "ev:event", "event", "externalResourcesRequired", "fill",
+    "fill-opacity", "fill-rule", "focusHighlight", "focusable", "font-family", "font-size", "font-stretch",
+    "font-style", "font-variant", "font-weight", "from", "g1", "g2", "glyph-name", "gradientUnits", "handler",
+    "hanging", "height", "horiz-adv-x", "horiz-origin-x", "id", "ideographic", "image-rendering",
+    "initialVisibility", "k", "keyPoints", "keySplines", "keyTimes", "lang", "line-increment", "mathematical",
+    "max", "mediaCharacterEncoding", "mediaContentEncodings", "mediaSize", "mediaTime", "min", "nav-down",
+    "nav-down-left", "nav-down-right", "nav-left", "nav-next", "nav-prev", "nav-right", "nav-up", "nav-up-left",
+    "nav-up-right", "observer", "offset", "opacity", "origin", "overlay", "overline-position",
+    "overline-thickness", "panose-1", "path", "pathLength", "phase", "playbackOrder", "pointer-events",
+    "points", "preserveAspectRatio", "propagate", "property", "r", "rel", "repeatCount", "repeatDur",
+    "requiredExtensions", "requiredFeatures", "requiredFonts", "requiredFormats", "resource", "restart", "rev",
+    "role", "rotate", "rx", "ry", "shape-rendering", "slope", "snapshotTime", "solid-color", "solid-opacity",
+    "stemh", "stemv", "stop-color", "stop-opacity", "strikethrough-position", "strikethrough-thickness",
+    "stroke", "stroke-dasharray", "stroke-linecap", "stroke-linejoin", "stroke-miterlimit", "stroke-opacity",
+    "stroke-width", "syncBehavior", "syncBehaviorDefault", "syncMaster", "syncTolerance",
+    "syncToleranceDefault", "systemLanguage", "target", "text-align", "text-anchor", "text-rendering",
+    "timelineBegin", "to", "transform", "transformBehavior", "type", "typeof", "u1", "u2", "underline-position",
+    "underline-thickness", "unicode", "unicode-bidi", "unicode-range", "units-per-em", "values",
+    "vector-effect", "version", "viewBox", "viewport-fill", "viewport-fill-opacity", "visibility", "width",
+    "widths", "x", "x-height", "x1", "x2", "xlink:actuate", "xlink:arcrole", "xlink:href", "xlink:role",
+    "xlink:show", "xlink:title", "xlink:type", "xml:base", "xml:id", "xml:lang", "xml:space", "y", "y1", "y2",
+    "zoomAndPan"
+};
+
+typedef struct SvgElementKeywords_
+{
+    const char* name;
+    int properties;                /* SVG_PROPERTY, SVG_MEDIA_PROPERTY or SVG_NULL if the element takes none */
+    const char* const* attributes;
+    int attributeCount;
+} SvgElementKeywords;
+
+#define SVG_KEYWORDS(table) table, (int)(sizeof(table) / sizeof(table[0]))
+
+/* Elements of SVG Tiny 1.2. TODO: SVG Full 1.1 Spec Elements: altGlyph, altGlyphDef, altGlyphItem, clipPath,
+ * color-profile, cursor, the fe* filter primitives, filter, font-face-format, font-face-name, glyphRef, marker, mask,
+ * pattern, style, symbol, textPath, tref, view and vkern. */
+static const SvgElementKeywords svgElements[] =
+{
+    { "?xml",              SVG_NULL,           SVG_KEYWORDS(svgXmlAttributes) },
+    { "a",                 SVG_PROPERTY,       SVG_KEYWORDS(svgLinkAttributes) },
+    { "animate",           SVG_NULL,           SVG_KEYWORDS(svgAnimateAttributes) },
+    { "animateColor",      SVG_NULL,           SVG_KEYWORDS(svgAnimateColorAttributes) },
+    { "animateMotion",     SVG_NULL,           SVG_KEYWORDS(svgAnimateMotionAttributes) },
+    { "animateTransform",  SVG_NULL,           SVG_KEYWORDS(svgAnimateTransformAttributes) },
+    { "animation",         SVG_MEDIA_PROPERTY, SVG_KEYWORDS(svgAnimationAttributes) },
+    { "audio",             SVG_MEDIA_PROPERTY, SVG_KEYWORDS(svgAudioAttributes) },
+    { "circle",            SVG_PROPERTY,       SVG_KEYWORDS(svgCircleAttributes) },
+    { "defs",              SVG_PROPERTY,       SVG_KEYWORDS(svgDefsAttributes) },
+    { "desc",              SVG_MEDIA_PROPERTY, SVG_KEYWORDS(svgDescAttributes) },
+    { "discard",           SVG_NULL,           SVG_KEYWORDS(svgDiscardAttributes) },
+    { "ellipse",           SVG_PROPERTY,       SVG_KEYWORDS(svgEllipseAttributes) },
+    { "font",              SVG_NULL,           SVG_KEYWORDS(svgFontAttributes) },
+    { "font-face",         SVG_NULL,           SVG_KEYWORDS(svgFontFaceAttributes) },
+    { "font-face-src",     SVG_NULL,           SVG_KEYWORDS(svgFontFaceSrcAttributes) },
+    { "font-face-uri",     SVG_NULL,           SVG_KEYWORDS(svgFontFaceUriAttributes) },
+    { "foreignObject",     SVG_PROPERTY,       SVG_KEYWORDS(svgForeignObjectAttributes) },
+    { "g",                 SVG_PROPERTY,       SVG_KEYWORDS(svgGroupAttributes) },
+    { "glyph",             SVG_NULL,           SVG_KEYWORDS(svgGlyphAttributes) },
+    { "handler",           SVG_NULL,           SVG_KEYWORDS(svgHandlerAttributes) },
+    { "hkern",             SVG_NULL,           SVG_KEYWORDS(svgHKernAttributes) },
+    { "image",             SVG_MEDIA_PROPERTY, SVG_KEYWORDS(svgImageAttributes) },
+    { "line",              SVG_PROPERTY,       SVG_KEYWORDS(svgLineAttributes) },
+    { "linearGradient",    SVG_PROPERTY,       SVG_KEYWORDS(svgLinearGradientAttributes) },
+    { "listener",          SVG_NULL,           SVG_KEYWORDS(svgListenerAttributes) },
+    { "metadata",          SVG_MEDIA_PROPERTY, SVG_KEYWORDS(svgMetadataAttributes) },
+    { "missing-glyph",     SVG_NULL,           SVG_KEYWORDS(svgMissingGlyphAttributes) },
+    { "mpath",             SVG_NULL,           SVG_KEYWORDS(svgMPathAttributes) },
+    { "path",              SVG_PROPERTY,       SVG_KEYWORDS(svgPathAttributes) },
+    { "polygon",           SVG_PROPERTY,       SVG_KEYWORDS(svgPolygonAttributes) },
+    { "polyline",          SVG_PROPERTY,       SVG_KEYWORDS(svgPolylineAttributes) },
+    { "prefetch",          SVG_NULL,           SVG_KEYWORDS(svgPrefetchAttributes) },
+    { "radialGradient",    SVG_PROPERTY,       SVG_KEYWORDS(svgRadialGradientAttributes) },
+    { "rect",              SVG_PROPERTY,       SVG_KEYWORDS(svgRectAttributes) },
+    { "script",            SVG_NULL,           SVG_KEYWORDS(svgScriptAttributes) },
+    { "set",               SVG_NULL,           SVG_KEYWORDS(svgSetAttributes) },
+    { "solidColor",        SVG_PROPERTY,       SVG_KEYWORDS(svgSolidColorAttributes) },
+    { "stop",              SVG_PROPERTY,       SVG_KEYWORDS(svgStopAttributes) },
+    { "svg",               SVG_PROPERTY,       SVG_KEYWORDS(svgSvgAttributes) },
+    { "switch",            SVG_PROPERTY,       SVG_KEYWORDS(svgSwitchAttributes) },
+    { "tbreak",            SVG_NULL,           SVG_KEYWORDS(svgTBreakAttributes) },
+    { "text",              SVG_PROPERTY,       SVG_KEYWORDS(svgTextAttributes) },
+    { "textArea",          SVG_PROPERTY,       SVG_KEYWORDS(svgTextAreaAttributes) },
+    { "title",             SVG_MEDIA_PROPERTY, SVG_KEYWORDS(svgTitleAttributes) },
+    { "tspan",             SVG_PROPERTY,       SVG_KEYWORDS(svgTSpanAttributes) },
+    { "use",               SVG_PROPERTY,       SVG_KEYWORDS(svgUseAttributes) },
+    { "video",             SVG_MEDIA_PROPERTY, SVG_KEYWORDS(svgVideoAttributes) }
+};
+
+static int svgKeyword_compare(const void* key, const void* keyword)
+{
+    return svgString_compare(*(const SvgString*)key, *(const char* const*)keyword);
 }
 
-int svgIsImageAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "opacity"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsImageAttribute(), unknown: %s\n", buff); }
-    return type;
+static int svgElementKeywords_compare(const void* key, const void* element)
+{
+    return svgString_compare(*(const SvgString*)key, ((const SvgElementKeywords*)element)->name);
 }
 
-int svgIsLineAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x1"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x2"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y1"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y2"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsLineAttribute(), unknown: %s\n", buff); }
-    return type;
+static int svgKeyword_find(const char* const* table, int count, SvgString token)
+{
+    return bsearch(&token, table, count, sizeof(table[0]), svgKeyword_compare) != 0;
 }
 
-int svgIsLinearGradientAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "gradientUnits")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x1"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x2"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y1"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y2"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))             { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsLinearGradientAttribute(), unknown: %s\n", buff); }
-    return type;
+static const SvgElementKeywords* svgElementKeywords_find(SvgString name)
+{
+    return (const SvgElementKeywords*)bsearch(&name, svgElements, sizeof(svgElements) / sizeof(svgElements[0]),
+                                              sizeof(svgElements[0]), svgElementKeywords_compare);
 }
 
-int svgIsListenerAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "defaultAction")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "event"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "handler"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "observer"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "phase"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "propagate"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "target"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))             { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsListenerAttribute(), unknown: %s\n", buff); }
-    return type;
+/* Returns SVG_PROPERTY, SVG_MEDIA_PROPERTY or SVG_ATTRIBUTE if \a token is valid on \a element, otherwise SVG_NULL */
+static int svgAttributeType(const SvgElementKeywords* element, SvgString token, int creator)
+{
+    if(element->properties == SVG_PROPERTY &&
+       svgKeyword_find(svgProperties, sizeof(svgProperties) / sizeof(svgProperties[0]), token))
+        return SVG_PROPERTY;
+    if(element->properties == SVG_MEDIA_PROPERTY &&
+       svgKeyword_find(svgMediaProperties, sizeof(svgMediaProperties) / sizeof(svgMediaProperties[0]), token))
+        return SVG_MEDIA_PROPERTY;
+    if(svgKeyword_find(element->attributes, element->attributeCount, token))
+        return SVG_ATTRIBUTE;
+    if(creator == SVG_CREATOR_INKSCAPE && !strcmp(element->name, "svg") &&
+       svgKeyword_find(svgInkscapeSvgAttributes, sizeof(svgInkscapeSvgAttributes) / sizeof(svgInkscapeSvgAttributes[0]), token))
+        return SVG_ATTRIBUTE;
+
+    embLog_print("format-svg.c svgTokenType(), unknown %s attribute: %.*s\n", element->name, token.length, token.data);
+    return SVG_NULL;
 }
 
-int svgIsMetadataAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsMetadataAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+/*! Classifies \a token in one lookup. With a null \a elementName, returns SVG_ELEMENT if \a token names
+ *  a supported element. Otherwise returns SVG_PROPERTY, SVG_MEDIA_PROPERTY or SVG_ATTRIBUTE if \a token
+ *  is valid on the element \a elementName, and SVG_NULL if it is not. \a creator is the SVG_CREATOR of the file. */
+int svgTokenType(const char* elementName, const char* token, int creator)
+{
+    const SvgElementKeywords* element = 0;
+    SvgString key;
 
-int svgIsMissingGlyphAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "d"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "horiz-adv-x")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))           { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsMissingGlyphAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    if(!token) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c svgTokenType(), token argument is null\n"); return SVG_NULL; }
 
-int svgIsMPathAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))             { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsMPathAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    key.data = elementName ? elementName : token;
+    key.length = (int)strlen(key.data);
+    element = svgElementKeywords_find(key);
+    if(!elementName)
+    {
+        /* TODO: Fix the xml version ? messing with svg version */
+        if(!element || !strcmp(element->name, "?xml")) return SVG_NULL;
+        return SVG_ELEMENT;
+    }
+    if(!element) return SVG_NULL;
 
-int svgIsPathAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "d"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "pathLength"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsPathAttribute(), unknown: %s\n", buff); }
-    return type;
+    key.data = token;
+    key.length = (int)strlen(token);
+    return svgAttributeType(element, key, creator);
 }
 
-int svgIsPolygonAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "points"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsPolygonAttribute(), unknown: %s\n", buff); }
-    return type;
+int svgIsCatchAllAttribute(const char* buff)
+{
+    SvgString token;
+    token.data = buff;
+    token.length = (int)strlen(buff);
+    if(svgKeyword_find(svgCatchAllAttributes, sizeof(svgCatchAllAttributes) / sizeof(svgCatchAllAttributes[0]), token))
+        return SVG_CATCH_ALL;
+    return SVG_NULL;
 }
 
-int svgIsPolylineAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "points"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsPolylineAttribute(), unknown: %s\n", buff); }
-    return type;
+/* State of one SVG read. Every readSvgBuffer() call has its own, so several files can be read at the same time. */
+typedef struct SvgParser_
+{
+    EmbPattern* pattern;
+    const char* data; /* the whole file. Tokens are views into it. */
+    long size;
+    long position;
+    int creator;      /* SVG_CREATOR */
+    EmbHash* attributes; /* the attributeMap of every element. Its keys are the attribute names seen so far. */
+} SvgParser;
+
+static int svgIsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
 }
 
-int svgIsPrefetchAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "bandwidth"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mediaCharacterEncoding")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mediaContentEncodings"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mediaSize"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "mediaTime"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                      { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsPrefetchAttribute(), unknown: %s\n", buff); }
-    return type;
+static void svgParser_skipSpace(SvgParser* parser)
+{
+    while(parser->position < parser->size && svgIsSpace(parser->data[parser->position]))
+        parser->position++;
 }
 
-int svgIsRadialGradientAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cx"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "cy"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "gradientUnits")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "r"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))             { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsRadialGradientAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+/* Moves \a parser past the next occurrence of \a end, or to the end of the data if there is none.
+ * Returns the position at which \a end starts. */
+static long svgParser_skipPast(SvgParser* parser, const char* end)
+{
+    long length = (long)strlen(end);
+    const char* found = 0;
 
-int svgIsRectAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rx"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "ry"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsRectAttribute(), unknown: %s\n", buff); }
-    return type;
+    while(parser->position + length <= parser->size)
+    {
+        found = (const char*)memchr(parser->data + parser->position, end[0], parser->size - parser->position);
+        if(!found || found - parser->data + length > parser->size)
+            break;
+        if(!memcmp(found, end, length))
+        {
+            parser->position = (long)(found - parser->data) + length;
+            return parser->position - length;
+        }
+        parser->position = (long)(found - parser->data) + 1;
+    }
+    parser->position = parser->size;
+    return parser->size;
 }
 
-int svgIsScriptAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsScriptAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+/* Returns the token that starts at the position of \a parser and ends at whitespace or at one of the \a stops characters */
+static SvgString svgParser_token(SvgParser* parser, const char* stops)
+{
+    SvgString token;
+    char c;
 
-int svgIsSetAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeName"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "attributeType"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "to"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsSetAttribute(), unknown: %s\n", buff); }
-    return type;
+    token.data = parser->data + parser->position;
+    while(parser->position < parser->size)
+    {
+        c = parser->data[parser->position];
+        if(!c || svgIsSpace(c) || strchr(stops, c))
+            break;
+        parser->position++;
+    }
+    token.length = (int)(parser->data + parser->position - token.data);
+    return token;
 }
 
-int svgIsSolidColorAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsSolidColorAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+/* Reads a comment, which starts at the position of \a parser */
+static void svgParser_comment(SvgParser* parser)
+{
+    long end = 0;
+    const char* word = 0;
+    const char* last = 0;
 
-int svgIsStopAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "offset"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsStopAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    word = parser->data + parser->position;
+    end = svgParser_skipPast(parser, "-->");
+    last = parser->data + end;
 
-int svgIsSvgAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "baseProfile"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "contentScriptType"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "playbackOrder"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "snapshotTime"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncBehaviorDefault"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncToleranceDefault"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "timelineBegin"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "version"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "viewBox"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "zoomAndPan"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-    else if(svgCreator == SVG_CREATOR_INKSCAPE)
+    /* Attempt to identify the program that created the SVG file. This should be in a comment at that occurs before the svg element. */
+    while(word < last)
     {
-        if     (!strcmp(buff, "xmlns:dc"))              { type = SVG_ATTRIBUTE; }
-        else if(!strcmp(buff, "xmlns:cc"))              { type = SVG_ATTRIBUTE; }
-        else if(!strcmp(buff, "xmlns:rdf"))             { type = SVG_ATTRIBUTE; }
-        else if(!strcmp(buff, "xmlns:svg"))             { type = SVG_ATTRIBUTE; }
-        else if(!strcmp(buff, "xmlns"))                 { type = SVG_ATTRIBUTE; }
+        SvgString token;
+        while(word < last && (!*word || svgIsSpace(*word) || *word == '=')) word++;
+        token.data = word;
+        while(word < last && *word && !svgIsSpace(*word) && *word != '=') word++;
+        token.length = (int)(word - token.data);
+
+        if     (!svgString_compare(token, "Embroidermodder")) { parser->creator = SVG_CREATOR_EMBROIDERMODDER; }
+        else if(!svgString_compare(token, "Illustrator"))     { parser->creator = SVG_CREATOR_ILLUSTRATOR; }
+        else if(!svgString_compare(token, "Inkscape"))        { parser->creator = SVG_CREATOR_INKSCAPE; }
     }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsSvgAttribute(), unknown: %s\n", buff); }
-    return type;
 }
 
-int svgIsSwitchAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsSwitchAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+/* Reads a start tag, whose name is at the position of \a parser, and adds the element to the pattern */
+static void svgParser_element(SvgParser* parser)
+{
+    const SvgElementKeywords* keywords = 0;
+    SvgElement* element = 0;
+    SvgString name;
+    SvgString value;
 
-int svgIsTBreakAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTBreakAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    name = svgParser_token(parser, "/>");
+    keywords = svgElementKeywords_find(name);
+    if(keywords)
+        element = svgElement_create(name);
+    if(element)
+        element->attributeMap = parser->attributes;
 
-int svgIsTextAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "editable"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rotate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTextAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+    while(parser->position < parser->size)
+    {
+        char c;
 
-int svgIsTextAreaAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "editable"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTextAreaAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+        svgParser_skipSpace(parser);
+        if(parser->position >= parser->size)
+            break;
+        c = parser->data[parser->position];
+        if(c == '>') { parser->position++; break; }
 
-int svgIsTitleAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTitleAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+        name = svgParser_token(parser, "=/>");
+        if(!name.length) { parser->position++; continue; } /* the / of an empty element tag, or a stray character */
 
-int svgIsTSpanAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                  { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsTSpanAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+        value.data = 0;
+        value.length = 0;
+        svgParser_skipSpace(parser);
+        if(parser->position < parser->size && parser->data[parser->position] == '=')
+        {
+            parser->position++;
+            svgParser_skipSpace(parser);
+            c = parser->position < parser->size ? parser->data[parser->position] : 0;
+            if(c == '"' || c == '\'')
+            {
+                /* The quotes stay part of the value, svgAttribute_create() blanks them out */
+                const char* close = (const char*)memchr(parser->data + parser->position + 1, c, parser->size - parser->position - 1);
+                value.data = parser->data + parser->position;
+                parser->position = close ? (long)(close - parser->data) + 1 : parser->size;
+                value.length = (int)(parser->data + parser->position - value.data);
+            }
+            else
+            {
+                value = svgParser_token(parser, ">");
+            }
+        }
 
-int svgIsUseAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsUseAttribute(), unknown: %s\n", buff); }
-    return type;
-}
+        if(element && svgAttributeType(keywords, name, parser->creator))
+            svgElement_addAttribute(element, svgAttribute_create(name, value));
+    }
 
-int svgIsVideoAttribute(const char* buff)
-{
-    int type = SVG_NULL;
-    if     (!strcmp(buff, "about"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "begin"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "dur"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "end"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "fill"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "initialVisibility"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "max"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "min"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "overlay"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatCount"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "repeatDur"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "restart"))                   { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncBehavior"))              { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncMaster"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "syncTolerance"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "transformBehavior"))         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_ATTRIBUTE; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_ATTRIBUTE; }
-
-    if(type == SVG_NULL) { embLog_print("format-svg.c svgIsVideoAttribute(), unknown: %s\n", buff); }
-    return type;
+    if(element)
+    {
+        svgAddToPattern(parser->pattern, element);
+        svgElement_free(element);
+    }
 }
 
-
-int svgIsCatchAllAttribute(const char* buff)
+/*! Reads the \a size bytes of SVG at \a data and loads them into \a pattern. \a data does not have to be null terminated.
+ *  Returns \c true if successful, otherwise returns \c false. */
+int readSvgBuffer(EmbPattern* pattern, const char* data, long size)
 {
-    int type = SVG_NULL;
-    /* Catch All Properties */
-    if     (!strcmp(buff, "audio-level"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "buffered-rendering"))        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "color"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "color-rendering"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "direction"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "display"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "display-align"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "fill"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "fill-opacity"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "fill-rule"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-family"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-size"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-style"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-variant"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-weight"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "image-rendering"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "line-increment"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "opacity"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "pointer-events"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "shape-rendering"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "solid-color"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "solid-opacity"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stop-color"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stop-opacity"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-dasharray"))          { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-linecap"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-linejoin"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-miterlimit"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-opacity"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stroke-width"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "text-align"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "text-anchor"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "text-rendering"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "unicode-bidi"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "vector-effect"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "viewport-fill"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "viewport-fill-opacity"))     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "visibility"))                { type = SVG_CATCH_ALL; }
-    /* Catch All Attributes */
-    else if(!strcmp(buff, "about"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "accent-height"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "accumulate"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "additive"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "alphabetic"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "arabic-form"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "ascent"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "attributeName"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "attributeType"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "bandwidth"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "baseProfile"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "bbox"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "begin"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "by"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "calcMode"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "cap-height"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "class"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "content"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "contentScriptType"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "cx"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "cy"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "d"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "datatype"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "defaultAction"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "descent"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "dur"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "editable"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "end"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "ev:event"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "event"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "externalResourcesRequired")) { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "focusHighlight"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "focusable"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-family"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-stretch"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-style"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-variant"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "font-weight"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "from"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "g1"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "g2"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "glyph-name"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "gradientUnits"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "handler"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "hanging"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "height"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "horiz-adv-x"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "horiz-origin-x"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "id"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "ideographic"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "initialVisibility"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "k"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "keyPoints"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "keySplines"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "keyTimes"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "lang"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mathematical"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "max"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mediaCharacterEncoding"))    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mediaContentEncodings"))     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mediaSize"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "mediaTime"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "min"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-down"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-down-left"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-down-right"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-left"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-next"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-prev"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-right"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-up"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-up-left"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "nav-up-right"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "observer"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "offset"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "origin"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "overlay"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "overline-position"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "overline-thickness"))        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "panose-1"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "path"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "pathLength"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "phase"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "playbackOrder"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "points"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "preserveAspectRatio"))       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "propagate"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "property"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "r"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "rel"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "repeatCount"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "repeatDur"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "requiredExtensions"))        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "requiredFeatures"))          { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "requiredFonts"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "requiredFormats"))           { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "resource"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "restart"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "rev"))                       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "role"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "rotate"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "rx"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "ry"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "slope"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "snapshotTime"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stemh"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "stemv"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "strikethrough-position"))    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "strikethrough-thickness"))   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncBehavior"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncBehaviorDefault"))       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncMaster"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncTolerance"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "syncToleranceDefault"))      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "systemLanguage"))            { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "target"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "timelineBegin"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "to"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "transform"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "transformBehavior"))         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "type"))                      { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "typeof"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "u1"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "u2"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "underline-position"))        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "underline-thickness"))       { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "unicode"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "unicode-range"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "units-per-em"))              { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "values"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "version"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "viewBox"))                   { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "width"))                     { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "widths"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "x"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "x-height"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "x1"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "x2"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:actuate"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:arcrole"))             { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:href"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:role"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:show"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:title"))               { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xlink:type"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xml:base"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xml:id"))                    { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xml:lang"))                  { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "xml:space"))                 { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "y"))                         { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "y1"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "y2"))                        { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "zoomAndPan"))                { type = SVG_CATCH_ALL; }
-    else if(!strcmp(buff, "/"))                         { type = SVG_CATCH_ALL; }
-    return type;
-}
+    SvgParser parser;
+    const char* tag = 0;
 
-void svgProcess(int c, const char* buff)
-{
-    if(svgExpect == SVG_EXPECT_ELEMENT)
-    {
-        char advance = 0;
-        if(buff[0] == '/') { return; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c readSvgBuffer(), pattern argument is null\n"); return 0; }
+    if(!data && size) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c readSvgBuffer(), data argument is null\n"); return 0; }
 
-        advance = (char)svgIsElement(buff);
+    parser.pattern = pattern;
+    parser.data = data;
+    parser.size = size;
+    parser.position = 0;
+    parser.creator = SVG_CREATOR_NULL;
+    parser.attributes = embHash_create(); /* NOTE: without it, attributes are searched in their lists */
 
-        if(advance) { printf("ELEMENT:\n"); svgExpect = SVG_EXPECT_ATTRIBUTE; currentElement = svgElement_create(buff); }
-        else        { return; }
-    }
-    else if(svgExpect == SVG_EXPECT_ATTRIBUTE)
+    /* Pre-flip incase of multiple reads on the same pattern */
+    embPattern_flipVertical(pattern);
+
+    while(parser.position < parser.size)
     {
-        char advance = 0;
-        const char* name = 0;
-        if(!currentElement) { /* TODO: error */ return; }
-        name = currentElement->name;
+        tag = (const char*)memchr(parser.data + parser.position, '<', parser.size - parser.position);
+        if(!tag)
+            break;
+        parser.position = (long)(tag - parser.data) + 1;
 
-        if(!strcmp(name, "?xml"))
-        {
-            if(!advance) { advance = (char)svgIsXmlAttribute(buff); }
-        }
-        else if(!strcmp(name, "a"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsLinkAttribute(buff); }
-        }
-        else if(!strcmp(name, "animate"))
-        {
-            if(!advance) { advance = (char)svgIsAnimateAttribute(buff); }
-        }
-        else if(!strcmp(name, "animateColor"))
-        {
-            if(!advance) { advance = (char)svgIsAnimateColorAttribute(buff); }
-        }
-        else if(!strcmp(name, "animateMotion"))
-        {
-            if(!advance) { advance = (char)svgIsAnimateMotionAttribute(buff); }
-        }
-        else if(!strcmp(name, "animateTransform"))
-        {
-            if(!advance) { advance = (char)svgIsAnimateTransformAttribute(buff); }
-        }
-        else if(!strcmp(name, "animation"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsAnimationAttribute(buff); }
-        }
-        else if(!strcmp(name, "audio"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsAudioAttribute(buff); }
-        }
-        else if(!strcmp(name, "circle"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsCircleAttribute(buff); }
-        }
-        else if(!strcmp(name, "defs"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsDefsAttribute(buff); }
-        }
-        else if(!strcmp(name, "desc"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsDescAttribute(buff); }
-        }
-        else if(!strcmp(name, "discard"))
-        {
-            if(!advance) { advance = (char)svgIsDiscardAttribute(buff); }
-        }
-        else if(!strcmp(name, "ellipse"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsEllipseAttribute(buff); }
-        }
-        else if(!strcmp(name, "font"))
-        {
-            if(!advance) { advance = (char)svgIsFontAttribute(buff); }
-        }
-        else if(!strcmp(name, "font-face"))
-        {
-            if(!advance) { advance = (char)svgIsFontFaceAttribute(buff); }
-        }
-        else if(!strcmp(name, "font-face-src"))
-        {
-            if(!advance) { advance = (char)svgIsFontFaceSrcAttribute(buff); }
-        }
-        else if(!strcmp(name, "font-face-uri"))
-        {
-            if(!advance) { advance = (char)svgIsFontFaceUriAttribute(buff); }
-        }
-        else if(!strcmp(name, "foreignObject"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsForeignObjectAttribute(buff); }
-        }
-        else if(!strcmp(name, "g"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsGroupAttribute(buff); }
-        }
-        else if(!strcmp(name, "glyph"))
-        {
-            if(!advance) { advance = (char)svgIsGlyphAttribute(buff); }
-        }
-        else if(!strcmp(name, "handler"))
-        {
-            if(!advance) { advance = (char)svgIsHandlerAttribute(buff); }
-        }
-        else if(!strcmp(name, "hkern"))
-        {
-            if(!advance) { advance = (char)svgIsHKernAttribute(buff); }
-        }
-        else if(!strcmp(name, "image"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsImageAttribute(buff); }
-        }
-        else if(!strcmp(name, "line"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsLineAttribute(buff); }
-        }
-        else if(!strcmp(name, "linearGradient"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsLinearGradientAttribute(buff); }
-        }
-        else if(!strcmp(name, "listener"))
-        {
-            if(!advance) { advance = (char)svgIsListenerAttribute(buff); }
-        }
-        else if(!strcmp(name, "metadata"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsMetadataAttribute(buff); }
-        }
-        else if(!strcmp(name, "missing-glyph"))
-        {
-            if(!advance) { advance = (char)svgIsMissingGlyphAttribute(buff); }
-        }
-        else if(!strcmp(name, "mpath"))
-        {
-            if(!advance) { advance = (char)svgIsMPathAttribute(buff); }
-        }
-        else if(!strcmp(name, "path"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsPathAttribute(buff); }
-        }
-        else if(!strcmp(name, "polygon"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsPolygonAttribute(buff); }
-        }
-        else if(!strcmp(name, "polyline"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsPolylineAttribute(buff); }
-        }
-        else if(!strcmp(name, "prefetch"))
-        {
-            if(!advance) { advance = (char)svgIsPrefetchAttribute(buff); }
-        }
-        else if(!strcmp(name, "radialGradient"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsRadialGradientAttribute(buff); }
-        }
-        else if(!strcmp(name, "rect"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsRectAttribute(buff); }
-        }
-        else if(!strcmp(name, "script"))
-        {
-            if(!advance) { advance = (char)svgIsScriptAttribute(buff); }
-        }
-        else if(!strcmp(name, "set"))
-        {
-            if(!advance) { advance = (char)svgIsSetAttribute(buff); }
-        }
-        else if(!strcmp(name, "solidColor"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsSolidColorAttribute(buff); }
-        }
-        else if(!strcmp(name, "stop"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsStopAttribute(buff); }
-        }
-        else if(!strcmp(name, "svg"))
+        if(parser.size - parser.position >= 3 && !memcmp(tag + 1, "!--", 3))
         {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsSvgAttribute(buff); }
+            parser.position += 3;
+            svgParser_comment(&parser);
         }
-        else if(!strcmp(name, "switch"))
+        else if(parser.position < parser.size && (tag[1] == '!' || tag[1] == '?' || tag[1] == '/'))
         {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsSwitchAttribute(buff); }
+            svgParser_skipPast(&parser, ">"); /* declarations, processing instructions and end tags */
         }
-        else if(!strcmp(name, "tbreak"))
-        {
-            if(!advance) { advance = (char)svgIsTBreakAttribute(buff); }
-        }
-        else if(!strcmp(name, "text"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsTextAttribute(buff); }
-        }
-        else if(!strcmp(name, "textArea"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsTextAreaAttribute(buff); }
-        }
-        else if(!strcmp(name, "title"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsTitleAttribute(buff); }
-        }
-        else if(!strcmp(name, "tspan"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsTSpanAttribute(buff); }
-        }
-        else if(!strcmp(name, "use"))
-        {
-            if(!advance) { advance = (char)svgIsProperty(buff); }
-            if(!advance) { advance = (char)svgIsUseAttribute(buff); }
-        }
-        else if(!strcmp(name, "video"))
-        {
-            if(!advance) { advance = (char)svgIsMediaProperty(buff); }
-            if(!advance) { advance = (char)svgIsVideoAttribute(buff); }
-        }
-
-        if(advance)
+        else
         {
-            printf("ATTRIBUTE:\n");
-            svgExpect = SVG_EXPECT_VALUE;
-            free(currentAttribute);
-            currentAttribute = 0;
-            currentAttribute = emb_strdup(buff);
+            svgParser_element(&parser);
         }
     }
-    else if(svgExpect == SVG_EXPECT_VALUE)
-    {
-        int last = strlen(buff) - 1;
-        printf("VALUE:\n");
-
-        /* single-value */
-        if((buff[0] == '"' || buff[0] == '\'') && (buff[last] == '/' || buff[last] == '"' || buff[last] == '\'') && !svgMultiValue)
-        {
-            svgExpect = SVG_EXPECT_ATTRIBUTE;
-            svgElement_addAttribute(currentElement, svgAttribute_create(currentAttribute, buff));
-        }
-        else /* multi-value */
-        {
-            svgMultiValue = 1;
-            if(!currentValue)
-            {
-                currentValue = emb_strdup(buff);
-                if(!currentValue) { /*TODO: error */ return; }
-            }
-            else
-            {
-                char* tmp = 0;
-                tmp = emb_strdup(currentValue);
-                free(currentValue);
-                currentValue = 0;
-                currentValue = (char*)malloc(strlen(buff) + strlen(tmp) + 2);
-                if(!currentValue) { embLog_error("format-svg.c svgProcess(), cannot allocate memory for currentValue\n"); return; }
-                if(currentValue) memset(currentValue, 0, strlen(buff) + strlen(tmp) + 2);
-                strcat(currentValue, tmp);
-                strcat(currentValue, " ");
-                strcat(currentValue, buff);
-                free(tmp);
-                tmp = 0;
-            }
 
-            if(buff[last] == '/' || buff[last] == '"' || buff[last] == '\'')
-            {
-                svgMultiValue = 0;
-                svgExpect = SVG_EXPECT_ATTRIBUTE;
-                svgElement_addAttribute(currentElement, svgAttribute_create(currentAttribute, currentValue));
-                free(currentValue);
-                currentValue = 0;
-            }
-        }
-    }
+    /* Flip the pattern since SVG Y+ is down and libembroidery Y+ is up. */
+    embPattern_flipVertical(pattern);
 
-    if(svgExpect != SVG_EXPECT_NULL)
-        printf("%s\n", buff);
+    embHash_free(parser.attributes);
 
-    if(c == '>')
-        svgExpect = SVG_EXPECT_NULL;
+    return 1; /*TODO: finish readSvg */
 }
 
 /*! Reads a file with the given \a fileName and loads the data into \a pattern.
@@ -3240,147 +1435,51 @@ void svgProcess(int c, const char* buff)
 int readSvg(EmbPattern* pattern, const char* fileName)
 {
     EmbFile* file = 0;
-    int size = 1024;
-    int pos;
-    int c = 0;
-    EmbRectObjectList* rList = 0;
-    EmbCircleObjectList* cList = 0;
-    EmbEllipseObjectList* eList = 0;
-    EmbLineObjectList* liList = 0;
-    EmbPointObjectList* poList = 0;
-    EmbPolygonObjectList* pogList = 0;
-    EmbPolylineObjectList* polList = 0;
-    char* buff = 0;
-
-    if(!pattern) { embLog_error("format-svg.c readSvg(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-svg.c readSvg(), fileName argument is null\n"); return 0; }
-
-    buff = (char*)malloc(size);
-    if(!buff) { embLog_error("format-svg.c readSvg(), cannot allocate memory for buff\n"); return 0; }
+    char* data = 0;
+    long size = 0;
+    long capacity = 0;
+    size_t count = 0;
+    int result = 0;
 
-    svgCreator = SVG_CREATOR_NULL;
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c readSvg(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c readSvg(), fileName argument is null\n"); return 0; }
 
-    svgExpect = SVG_EXPECT_NULL;
-    svgMultiValue = 0;
-
-    currentElement = 0;
-    currentAttribute = 0;
-    currentValue = 0;
-
-    /* Pre-flip incase of multiple reads on the same pattern */
-    embPattern_flipVertical(pattern);
-
-    file = embFile_open(fileName, "r");
-    if(file)
-    {
-        pos = 0;
-        do
-        {
-            c = embFile_getc(file);
-            switch(c)
-            {
-                case '<':
-                    if(svgExpect == SVG_EXPECT_NULL)
-                    {
-                        svgAddToPattern(pattern);
-                        svgExpect = SVG_EXPECT_ELEMENT;
-                    }
-                case '>':
-                    if(pos == 0) /* abnormal case that may occur in svg element where '>' is all by itself */
-                    {
-                        /*TODO: log a warning about this absurdity! */
-                        svgExpect = SVG_EXPECT_ELEMENT;
-                        break;
-                    }
-                case ' ':
-                case '\t':
-                case '\r':
-                case '\n':
-                case '=':
-                    if(pos == 0)
-                        break;
-                    buff[pos] = 0;
-                    pos = 0;
-                    svgProcess(c, buff);
-                    break;
-                default:
-                    buff[pos++] = (char)c;
-                    break;
-            }
-            if(pos >= size - 1)
-            {
-                /* increase buff length - leave room for 0 */
-                size *= 2;
-                buff = (char*)realloc(buff, size);
-                if(!buff) { embLog_error("format-svg.c readSvg(), cannot re-allocate memory for buff\n"); return 0; }
-            }
-        }
-        while(c != EOF);
-        embFile_close(file);
-    }
-    free(buff);
-    buff = 0;
-    free(currentAttribute);
-    currentAttribute = 0;
-    free(currentValue);
-    currentValue = 0;
-
-    /*TODO: remove this summary after testing is complete */
-    printf("OBJECT SUMMARY:\n");
-    cList = pattern->circleObjList;
-    while(cList)
-    {
-        EmbCircle c = cList->circleObj.circle;
-        printf("circle %f %f %f\n", c.centerX, c.centerY, c.radius);
-        cList = cList->next;
-    }
-    eList = pattern->ellipseObjList;
-    while(eList)
-    {
-        EmbEllipse e = eList->ellipseObj.ellipse;
-        printf("ellipse %f %f %f %f\n", embEllipse_centerX(e), embEllipse_centerY(e), embEllipse_radiusX(e), embEllipse_radiusY(e));
-        eList = eList->next;
-    }
-    liList = pattern->lineObjList;
-    while(liList)
-    {
-        EmbLine li = liList->lineObj.line;
-        printf("line %f %f %f %f\n", embLine_x1(li), embLine_y1(li), embLine_x2(li), embLine_y2(li));
-        liList = liList->next;
-    }
-    poList = pattern->pointObjList;
-    while(poList)
-    {
-        EmbPoint po = poList->pointObj.point;
-        printf("point %f %f\n", embPoint_x(po), embPoint_y(po));
-        poList = poList->next;
-    }
-    pogList = pattern->polygonObjList;
-    while(pogList)
+    file = embFile_open(fileName, "rb");
+    if(!file)
     {
-        int vertices = embPointList_count(pogList->polygonObj->pointList);
-        printf("polygon %d\n", vertices);
-        pogList = pogList->next;
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-svg.c readSvg(), cannot open %s for reading\n", fileName);
+        return 0;
     }
-    polList = pattern->polylineObjList;
-    while(polList)
+
+#ifndef ARDUINO
+    if(embFile_isBuffered(file))
     {
-        int vertices = embPointList_count(polList->polylineObj->pointList);
-        printf("polyline %d\n", vertices);
-        polList = polList->next;
+        /* The file is already in memory, parse it in place */
+        result = readSvgBuffer(pattern, (const char*)file->buffer, file->size);
+        embFile_close(file);
+        return result;
     }
-    rList = pattern->rectObjList;
-    while(rList)
+#endif /* ARDUINO */
+
+    do
     {
-        EmbRect r = rList->rectObj.rect;
-        printf("rect %f %f %f %f\n", embRect_x(r), embRect_y(r), embRect_width(r), embRect_height(r));
-        rList = rList->next;
+        if(size == capacity)
+        {
+            char* grown = 0;
+            capacity = capacity ? capacity * 2 : 65536;
+            grown = (char*)realloc(data, capacity);
+            if(!grown) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-svg.c readSvg(), cannot allocate memory for data\n"); free(data); embFile_close(file); return 0; }
+            data = grown;
+        }
+        count = embFile_read(data + size, 1, capacity - size, file);
+        size += (long)count;
     }
+    while(count > 0);
+    embFile_close(file);
 
-    /* Flip the pattern since SVG Y+ is down and libembroidery Y+ is up. */
-    embPattern_flipVertical(pattern);
-
-    return 1; /*TODO: finish readSvg */
+    result = readSvgBuffer(pattern, data, size);
+    free(data);
+    return result;
 }
 
 /*! Writes the data from \a pattern to a file with the given \a fileName.
@@ -3409,13 +1508,13 @@ int writeSvg(EmbPattern* pattern, const char* fileName)
     char tmpX[32];
     char tmpY[32];
 
-    if(!pattern) { embLog_error("format-svg.c writeSvg(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-svg.c writeSvg(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c writeSvg(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-svg.c writeSvg(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "w");
     if(!file)
     {
-        embLog_error("format-svg.c writeSvg(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-svg.c writeSvg(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
@@ -2,6 +2,7 @@
 #ifndef FORMAT_SVG_H
 #define FORMAT_SVG_H
 
+#include "emb-hash.h"
 #include "emb-pattern.h"
 
 #include "api-start.h"
@@ -30,6 +31,7 @@ struct SvgElement_
     char* name;
     SvgAttributeList* attributeList;
     SvgAttributeList* lastAttribute;
+    EmbHash* attributeMap; /* attribute names to values, shared by the elements of one read. Null to search attributeList. */
 };
 
 typedef enum
@@ -40,14 +42,6 @@ typedef enum
     SVG_CREATOR_INKSCAPE
 } SVG_CREATOR;
 
-typedef enum
-{
-    SVG_EXPECT_NULL,
-    SVG_EXPECT_ELEMENT,
-    SVG_EXPECT_ATTRIBUTE,
-    SVG_EXPECT_VALUE
-} SVG_EXPECT;
-
 typedef enum
 {
     SVG_NULL,
@@ -59,16 +53,10 @@ typedef enum
 } SVG_TYPES;
 
 extern EMB_PRIVATE int EMB_CALL readSvg(EmbPattern* pattern, const char* fileName);
+extern EMB_PRIVATE int EMB_CALL readSvgBuffer(EmbPattern* pattern, const char* data, long size);
 extern EMB_PRIVATE int EMB_CALL writeSvg(EmbPattern* pattern, const char* fileName);
 
-int svgCreator;
-
-int svgExpect;
-int svgMultiValue;
-
-SvgElement* currentElement;
-char* currentAttribute;
-char* currentValue;
+extern EMB_PRIVATE int EMB_CALL svgTokenType(const char* elementName, const char* token, int creator);
 
 #ifdef __cplusplus
 }
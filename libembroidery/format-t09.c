@@ -9,13 +9,13 @@ int readT09(EmbPattern* pattern, const char* fileName)
     unsigned char b[3];
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-t09.c readT09(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-t09.c readT09(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-t09.c readT09(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-t09.c readT09(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-t09.c readT09(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-t09.c readT09(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -51,12 +51,12 @@ int readT09(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeT09(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-t09.c writeT09(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-t09.c writeT09(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-t09.c writeT09(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-t09.c writeT09(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-t09.c writeT09(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-t09.c writeT09(), pattern contains no stitches\n");
         return 0;
     }
 
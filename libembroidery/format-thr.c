@@ -53,13 +53,13 @@ int readThr(EmbPattern* pattern, const char* fileName)
     int i;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-thr.c readThr(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-thr.c readThr(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-thr.c readThr(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-thr.c readThr(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-thr.c readThr(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-thr.c readThr(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -150,13 +150,13 @@ int writeThr(EmbPattern* pattern, const char* fileName)
     EmbThreadList* colorpointer = 0;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-thr.c writeThr(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-thr.c writeThr(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-thr.c writeThr(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-thr.c writeThr(), fileName argument is null\n"); return 0; }
 
-    stitchCount = embStitchList_count(pattern->stitchList);
+    stitchCount = embPattern_stitchCount(pattern);
     if(!stitchCount)
     {
-        embLog_error("format-thr.c writeThr(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-thr.c writeThr(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -170,7 +170,7 @@ int writeThr(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-thr.c writeThr(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-thr.c writeThr(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
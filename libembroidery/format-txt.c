@@ -7,8 +7,8 @@
  *  Returns \c true if successful, otherwise returns \c false. */
 int readTxt(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-txt.c readTxt(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-txt.c readTxt(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-txt.c readTxt(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-txt.c readTxt(), fileName argument is null\n"); return 0; }
     return 0; /*TODO: finish readTxt */
 }
 
@@ -19,12 +19,12 @@ int writeTxt(EmbPattern* pattern, const char* fileName)
     EmbStitchList* pointer = 0;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-txt.c writeTxt(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-txt.c writeTxt(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-txt.c writeTxt(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-txt.c writeTxt(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-txt.c writeTxt(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-txt.c writeTxt(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -35,11 +35,11 @@ int writeTxt(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "w");
     if(!file)
     {
-        embLog_error("format-txt.c writeTxt(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-txt.c writeTxt(), cannot open %s for writing\n", fileName);
         return 0;
     }
     pointer = pattern->stitchList;
-    embFile_printf(file, "%u\n", (unsigned int) embStitchList_count(pointer));
+    embFile_printf(file, "%u\n", (unsigned int) embPattern_stitchCount(pattern));
 
     while(pointer)
     {
@@ -13,13 +13,13 @@ int readU00(EmbPattern* pattern, const char* fileName)
     char endOfStream = 0;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-u00.c readU00(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-u00.c readU00(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-u00.c readU00(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-u00.c readU00(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-u00.c readU00(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-u00.c readU00(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -32,6 +32,8 @@ int readU00(EmbPattern* pattern, const char* fileName)
         t.color.r = binaryReadUInt8(file);
         t.color.g = binaryReadUInt8(file);
         t.color.b = binaryReadUInt8(file);
+        t.catalogNumber = "";
+        t.description = "";
         embPattern_addThread(pattern, t);
     }
 
@@ -81,8 +83,8 @@ int readU00(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeU00(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-u00.c writeU00(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-u00.c writeU00(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-u00.c writeU00(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-u00.c writeU00(), fileName argument is null\n"); return 0; }
 
     /* Check for an END stitch and add one if it is not present */
     if(pattern->lastStitch->stitch.flags != END)
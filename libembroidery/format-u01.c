@@ -61,8 +61,8 @@ int readU01(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeU01(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-u01.c writeU01(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-u01.c writeU01(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-u01.c writeU01(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-u01.c writeU01(), fileName argument is null\n"); return 0; }
 
     /* Check for an END stitch and add one if it is not present */
     if(pattern->lastStitch->stitch.flags != END)
@@ -29,15 +29,15 @@ static int vipDecodeStitchType(unsigned char b)
     }
 }
 
-static unsigned char* vipDecompressData(unsigned char* input, int compressedInputLength, int decompressedContentLength)
+static unsigned char* vipDecompressData(EmbCompress* compress, unsigned char* input, int compressedInputLength, int decompressedContentLength)
 {
     unsigned char* decompressedData = (unsigned char*)malloc(decompressedContentLength);
     if(!decompressedData)
     {
-        embLog_error("format-vip.c vipDecompressData(), cannot allocate memory for decompressedData\n");
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-vip.c vipDecompressData(), cannot allocate memory for decompressedData\n");
         return 0;
     }
-    husExpand((unsigned char*)input, decompressedData, compressedInputLength, 10);
+    husExpand(compress, (unsigned char*)input, decompressedData, compressedInputLength, 10);
     return decompressedData;
 }
 
@@ -63,20 +63,21 @@ typedef struct VipHeader_
 int readVip(EmbPattern* pattern, const char* fileName)
 {
     int fileLength;
-    int i;
+    int i, result = 0;
     unsigned char prevByte = 0;
     unsigned char *attributeData = 0, *decodedColors = 0, *attributeDataDecompressed = 0;
     unsigned char *xData = 0, *xDecompressed = 0, *yData = 0, *yDecompressed = 0;
     VipHeader header;
     EmbFile* file = 0;
+    EmbCompress* compress = 0;
 
-    if(!pattern) { embLog_error("format-vip.c readVip(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-vip.c readVip(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vip.c readVip(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vip.c readVip(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-vip.c readVip(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-vip.c readVip(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -97,7 +98,7 @@ int readVip(EmbPattern* pattern, const char* fileName)
     header.yOffset = binaryReadInt32(file);
 
     /*stringVal = (unsigned char*)malloc(sizeof(unsigned char)*8); TODO: review this and uncomment or remove
-        if(!stringVal) { embLog_error("format-vip.c readVip(), cannot allocate memory for stringVal\n"); return 0; }
+        if(!stringVal) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-vip.c readVip(), cannot allocate memory for stringVal\n"); return 0; }
      */
 
     binaryReadBytes(file, header.stringVal, 8); /* TODO: check return value */
@@ -106,72 +107,88 @@ int readVip(EmbPattern* pattern, const char* fileName)
 
     header.colorLength = binaryReadInt32(file);
     decodedColors = (unsigned char*)malloc(header.numberOfColors*4);
-    if(!decodedColors) { embLog_error("format-vip.c readVip(), cannot allocate memory for decodedColors\n"); return 0; }
-    for(i = 0; i < header.numberOfColors*4; ++i)
+    compress = embCompress_create();
+    attributeData = (unsigned char*)malloc(header.xOffset - header.attributeOffset);
+    xData = (unsigned char*)malloc(header.yOffset - header.xOffset);
+    yData = (unsigned char*)malloc(fileLength - header.yOffset);
+    if(!decodedColors || !compress || !attributeData || !xData || !yData)
     {
-        unsigned char inputByte = binaryReadByte(file);
-        unsigned char tmpByte = (unsigned char) (inputByte ^ vipDecodingTable[i]);
-        decodedColors[i] = (unsigned char) (tmpByte ^ prevByte);
-        prevByte = inputByte;
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-vip.c readVip(), cannot allocate memory for the color and stitch data\n");
     }
-    for(i = 0; i < header.numberOfColors; i++)
+    else
     {
-        EmbThread thread;
-        int startIndex = i << 2;
-        thread.color.r = decodedColors[startIndex];
-        thread.color.g = decodedColors[startIndex + 1];
-        thread.color.b = decodedColors[startIndex + 2];
-        /* printf("%d\n", decodedColors[startIndex + 3]); */
-        embPattern_addThread(pattern, thread);
-    }
-    embFile_seek(file, header.attributeOffset, SEEK_SET);
-    attributeData = (unsigned char*)malloc(header.xOffset - header.attributeOffset);
-    if(!attributeData) { embLog_error("format-vip.c readVip(), cannot allocate memory for attributeData\n"); return 0; }
-    binaryReadBytes(file, attributeData, header.xOffset - header.attributeOffset); /* TODO: check return value */
-    attributeDataDecompressed = vipDecompressData(attributeData, header.xOffset - header.attributeOffset, header.numberOfStitches);
+        for(i = 0; i < header.numberOfColors*4; ++i)
+        {
+            unsigned char inputByte = binaryReadByte(file);
+            unsigned char tmpByte = (unsigned char) (inputByte ^ vipDecodingTable[i]);
+            decodedColors[i] = (unsigned char) (tmpByte ^ prevByte);
+            prevByte = inputByte;
+        }
+        for(i = 0; i < header.numberOfColors; i++)
+        {
+            EmbThread thread;
+            int startIndex = i << 2;
+            thread.color.r = decodedColors[startIndex];
+            thread.color.g = decodedColors[startIndex + 1];
+            thread.color.b = decodedColors[startIndex + 2];
+            thread.catalogNumber = "";
+            thread.description = "";
+            /* printf("%d\n", decodedColors[startIndex + 3]); */
+            embPattern_addThread(pattern, thread);
+        }
 
-    embFile_seek(file, header.xOffset, SEEK_SET);
-    xData = (unsigned char*)malloc(header.yOffset - header.xOffset);
-    if(!xData) { embLog_error("format-vip.c readVip(), cannot allocate memory for xData\n"); return 0; }
-    binaryReadBytes(file, xData, header.yOffset - header.xOffset); /* TODO: check return value */
-    xDecompressed = vipDecompressData(xData, header.yOffset - header.xOffset, header.numberOfStitches);
+        embFile_seek(file, header.attributeOffset, SEEK_SET);
+        binaryReadBytes(file, attributeData, header.xOffset - header.attributeOffset); /* TODO: check return value */
+        attributeDataDecompressed = vipDecompressData(compress, attributeData, header.xOffset - header.attributeOffset, header.numberOfStitches);
 
-    embFile_seek(file, header.yOffset, SEEK_SET);
-    yData = (unsigned char*)malloc(fileLength - header.yOffset);
-    if(!yData) { embLog_error("format-vip.c readVip(), cannot allocate memory for yData\n"); return 0; }
-    binaryReadBytes(file, yData, fileLength - header.yOffset); /* TODO: check return value */
-    yDecompressed = vipDecompressData(yData, fileLength - header.yOffset, header.numberOfStitches);
+        embFile_seek(file, header.xOffset, SEEK_SET);
+        binaryReadBytes(file, xData, header.yOffset - header.xOffset); /* TODO: check return value */
+        xDecompressed = vipDecompressData(compress, xData, header.yOffset - header.xOffset, header.numberOfStitches);
 
-    for(i = 0; i < header.numberOfStitches; i++)
+        embFile_seek(file, header.yOffset, SEEK_SET);
+        binaryReadBytes(file, yData, fileLength - header.yOffset); /* TODO: check return value */
+        yDecompressed = vipDecompressData(compress, yData, fileLength - header.yOffset, header.numberOfStitches);
+    }
+
+    if(attributeDataDecompressed && xDecompressed && yDecompressed)
     {
-        embPattern_addStitchRel(pattern,
-                                vipDecodeByte(xDecompressed[i]) / 10.0,
-                                vipDecodeByte(yDecompressed[i]) / 10.0,
-                                vipDecodeStitchType(attributeDataDecompressed[i]), 1);
+        for(i = 0; i < header.numberOfStitches; i++)
+        {
+            embPattern_addStitchRel(pattern,
+                                    vipDecodeByte(xDecompressed[i]) / 10.0,
+                                    vipDecodeByte(yDecompressed[i]) / 10.0,
+                                    vipDecodeStitchType(attributeDataDecompressed[i]), 1);
+        }
+
+        /* Check for an END stitch and add one if it is not present */
+        if(pattern->lastStitch->stitch.flags != END)
+            embPattern_addStitchRel(pattern, 0, 0, END, 1);
+        result = 1;
     }
-    embPattern_addStitchRel(pattern, 0, 0, END, 1);
 
+    /* NOTE: Every exit after the file is opened goes through here so nothing is leaked on failure. */
+    embCompress_free(compress);
+    free(decodedColors);
+    free(attributeData);
+    free(xData);
+    free(yData);
+    free(attributeDataDecompressed);
+    free(xDecompressed);
+    free(yDecompressed);
     embFile_close(file);
 
-    free(attributeData);             attributeData = 0;
-    free(xData);                     xData = 0;
-    free(yData);                     yData = 0;
-    free(attributeDataDecompressed); attributeDataDecompressed = 0;
-    free(xDecompressed);             xDecompressed = 0;
-    free(yDecompressed);             yDecompressed = 0;
-
-    return 1;
+    return result;
 }
 
-static unsigned char* vipCompressData(unsigned char* input, int decompressedInputSize, int* compressedSize)
+static unsigned char* vipCompressData(EmbCompress* compress, unsigned char* input, int decompressedInputSize, int* compressedSize)
 {
     unsigned char* compressedData = (unsigned char*)malloc(sizeof(unsigned char)*decompressedInputSize*2);
     if(!compressedData)
     {
-        embLog_error("format-vip.c vipCompressData(), cannot allocate memory for compressedData\n");
+        embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-vip.c vipCompressData(), cannot allocate memory for compressedData\n");
         return 0;
     }
-    *compressedSize = husCompress(input, (unsigned long) decompressedInputSize, compressedData, 10, 0);
+    *compressedSize = husCompress(compress, input, (unsigned long) decompressedInputSize, compressedData, 10, 0);
     return compressedData;
 }
 
@@ -219,14 +236,15 @@ int writeVip(EmbPattern* pattern, const char* fileName)
     unsigned char prevByte = 0;
     EmbThreadList* colorPointer = 0;
     EmbFile* file = 0;
+    EmbCompress* compress = 0;
 
-    if(!pattern) { embLog_error("format-vip.c writeVip(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-vip.c writeVip(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vip.c writeVip(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vip.c writeVip(), fileName argument is null\n"); return 0; }
 
-    stitchCount = embStitchList_count(pattern->stitchList);
+    stitchCount = embPattern_stitchCount(pattern);
     if(!stitchCount)
     {
-        embLog_error("format-vip.c writeVip(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-vip.c writeVip(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -240,7 +258,7 @@ int writeVip(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(file == 0)
     {
-        embLog_error("format-vip.c writeVip(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-vip.c writeVip(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
@@ -290,9 +308,13 @@ int writeVip(EmbPattern* pattern, const char* fileName)
             pointer = pointer->next;
             i++;
         }
-        attributeCompressed = vipCompressData(attributeValues, stitchCount, &attributeSize);
-        xCompressed = vipCompressData(xValues, stitchCount, &xCompressedSize);
-        yCompressed = vipCompressData(yValues, stitchCount, &yCompressedSize);
+        compress = embCompress_create();
+        if(!compress) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-vip.c writeVip(), cannot allocate memory for compress\n"); return 0; }
+        attributeCompressed = vipCompressData(compress, attributeValues, stitchCount, &attributeSize);
+        xCompressed = vipCompressData(compress, xValues, stitchCount, &xCompressedSize);
+        yCompressed = vipCompressData(compress, yValues, stitchCount, &yCompressedSize);
+        embCompress_free(compress);
+        compress = 0;
 
         binaryWriteUInt(file, (unsigned int) (0x38 + (minColors << 3) + attributeSize));
         binaryWriteUInt(file, (unsigned int) (0x38 + (minColors << 3) + attributeSize + xCompressedSize));
@@ -9,10 +9,10 @@ static unsigned char* vp3ReadString(EmbFile* file)
 {
     int stringLength = 0;
     unsigned char* charString = 0;
-    if(!file) { embLog_error("format-vp3.c vp3ReadString(), file argument is null\n"); return 0; }
+    if(!file) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vp3.c vp3ReadString(), file argument is null\n"); return 0; }
     stringLength = binaryReadInt16BE(file);
     charString = (unsigned char*)malloc(stringLength);
-    if(!charString) { embLog_error("format-vp3.c vp3ReadString(), cannot allocate memory for charString\n"); return 0; }
+    if(!charString) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "format-vp3.c vp3ReadString(), cannot allocate memory for charString\n"); return 0; }
     binaryReadBytes(file, charString, stringLength); /* TODO: check return value */
     return charString;
 }
@@ -71,7 +71,7 @@ static vp3Hoop vp3ReadHoopSection(EmbFile* file)
 
     if(!file) 
 	{ 
-		embLog_error("format-vp3.c vp3ReadHoopSection(), file argument is null\n");
+		embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vp3.c vp3ReadHoopSection(), file argument is null\n");
 		hoop.bottom = 0;
 		hoop.left = 0;
 		hoop.right = 0;
@@ -130,13 +130,13 @@ int readVp3(EmbPattern* pattern, const char* fileName)
     int i;
     EmbFile* file = 0;
 
-    if(!pattern) { embLog_error("format-vp3.c readVp3(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-vp3.c readVp3(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vp3.c readVp3(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vp3.c readVp3(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-vp3.c readVp3(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-vp3.c readVp3(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -205,12 +205,17 @@ int readVp3(EmbPattern* pattern, const char* fileName)
         t.color.r = binaryReadByte(file);
         t.color.g = binaryReadByte(file);
         t.color.b = binaryReadByte(file);
+        t.catalogNumber = "";
+        t.description = "";
         embPattern_addThread(pattern, t);
         embFile_seek(file, 6*tableSize - 1, SEEK_CUR);
 
         threadColorNumber = vp3ReadString(file);
         colorName = vp3ReadString(file);
         threadVendor = vp3ReadString(file);
+        free(threadColorNumber);
+        free(colorName);
+        free(threadVendor);
 
         offsetToNextColorX = binaryReadInt32BE(file);
         offsetToNextColorY = binaryReadInt32BE(file);
@@ -250,12 +255,21 @@ int readVp3(EmbPattern* pattern, const char* fileName)
             if(embFile_tell(file) == lastFilePosition)
             {
                 embLog_error("format-vp3.c could not read stitch block in entirety\n");
+                free(softwareVendorString);
+                free(fileCommentString);
+                free(anotherCommentString);
+                free(anotherSoftwareVendorString);
+                embFile_close(file);
                 return 0;
             }
         }
         if(i + 1 < numberOfColors)
             embPattern_addStitchRel(pattern, 0, 0, STOP, 1);
     }
+    free(softwareVendorString);
+    free(fileCommentString);
+    free(anotherCommentString);
+    free(anotherSoftwareVendorString);
     embFile_close(file);
 
     /* Check for an END stitch and add one if it is not present */
@@ -300,12 +314,12 @@ int writeVp3(EmbPattern* pattern, const char* fileName)
 	EmbColor color = embColor_make(0xFE, 0xFE, 0xFE);
     EmbStitchList *mainPointer = 0, *pointer = 0;
 
-    if(!pattern) { embLog_error("format-vp3.c writeVp3(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-vp3.c writeVp3(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vp3.c writeVp3(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-vp3.c writeVp3(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-vp3.c writeVp3(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-vp3.c writeVp3(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -314,7 +328,7 @@ int writeVp3(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-vp3.c writeVp3(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-vp3.c writeVp3(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
@@ -27,15 +27,15 @@ int readXxx(EmbPattern* pattern, const char* fileName)
     int i;
     char thisStitchJump = 0;
     EmbStitchList* lastStitch = 0;
-    EmbStitchList* secondLast = 0;
+    int stitchCount;
 
-    if(!pattern) { embLog_error("format-xxx.c readXxx(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-xxx.c readXxx(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-xxx.c readXxx(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-xxx.c readXxx(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-xxx.c readXxx(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-xxx.c readXxx(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -52,6 +52,8 @@ int readXxx(EmbPattern* pattern, const char* fileName)
         thread.color.r = binaryReadByte(file);
         thread.color.g = binaryReadByte(file);
         thread.color.b = binaryReadByte(file);
+        thread.catalogNumber = "";
+        thread.description = "";
         embPattern_addThread(pattern, thread);
     }
     embFile_seek(file, 0x100, SEEK_SET);
@@ -100,20 +102,15 @@ int readXxx(EmbPattern* pattern, const char* fileName)
         }
         embPattern_addStitchRel(pattern, dx / 10.0, dy / 10.0, flags, 1);
     }
-    lastStitch = pattern->stitchList;
-    secondLast = 0;
+    lastStitch = pattern->lastStitch;
+    stitchCount = embPattern_stitchCount(pattern);
     if(lastStitch)
     {
-        while(lastStitch->next)
+        if((!pattern->stitchList) && lastStitch->stitch.flags == STOP && stitchCount > 1)
         {
-            secondLast = lastStitch;
-            lastStitch = lastStitch->next;
-        }
-        if((!pattern->stitchList) && lastStitch->stitch.flags == STOP && secondLast)
-        {
-            free(lastStitch);
+            embStitchArray_truncate(&(pattern->stitchArray), stitchCount - 1);
+            pattern->lastStitch = embStitchArray_last(&(pattern->stitchArray));
             lastStitch = 0;
-            secondLast->next = NULL;
             embPattern_changeColor(pattern, pattern->currentColorIndex - 1);
         }
     }
@@ -196,12 +193,12 @@ int writeXxx(EmbPattern* pattern, const char* fileName)
     EmbThreadList* colors = 0;
     int curColor = 0;
 
-    if(!pattern) { embLog_error("format-xxx.c writeXxx(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-xxx.c writeXxx(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-xxx.c writeXxx(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-xxx.c writeXxx(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-xxx.c writeXxx(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-xxx.c writeXxx(), pattern contains no stitches\n");
         return 0;
     }
 
@@ -212,7 +209,7 @@ int writeXxx(EmbPattern* pattern, const char* fileName)
     file = embFile_open(fileName, "wb");
     if(!file)
     {
-        embLog_error("format-xxx.c writeXxx(), cannot open %s for writing\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-xxx.c writeXxx(), cannot open %s for writing\n", fileName);
         return 0;
     }
 
@@ -222,7 +219,7 @@ int writeXxx(EmbPattern* pattern, const char* fileName)
     {
         binaryWriteByte(file, 0x00);
     }
-    binaryWriteUInt(file, (unsigned int) embStitchList_count(pattern->stitchList));
+    binaryWriteUInt(file, (unsigned int) embPattern_stitchCount(pattern));
     for(i = 0; i < 0x0C; i++)
     {
         binaryWriteByte(file, 0x00);
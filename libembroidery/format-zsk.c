@@ -12,13 +12,13 @@ int readZsk(EmbPattern* pattern, const char* fileName)
     EmbFile* file = 0;
     int stitchType;
     unsigned char colorNumber;
-    if(!pattern) { embLog_error("format-zsk.c readZsk(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-zsk.c readZsk(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-zsk.c readZsk(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-zsk.c readZsk(), fileName argument is null\n"); return 0; }
 
     file = embFile_open(fileName, "rb");
     if(!file)
     {
-        embLog_error("format-zsk.c readZsk(), cannot open %s for reading\n", fileName);
+        embLog_errorCode(EMB_LOG_ERROR_OPEN, "format-zsk.c readZsk(), cannot open %s for reading\n", fileName);
         return 0;
     }
 
@@ -91,12 +91,12 @@ int readZsk(EmbPattern* pattern, const char* fileName)
  *  Returns \c true if successful, otherwise returns \c false. */
 int writeZsk(EmbPattern* pattern, const char* fileName)
 {
-    if(!pattern) { embLog_error("format-zsk.c writeZsk(), pattern argument is null\n"); return 0; }
-    if(!fileName) { embLog_error("format-zsk.c writeZsk(), fileName argument is null\n"); return 0; }
+    if(!pattern) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-zsk.c writeZsk(), pattern argument is null\n"); return 0; }
+    if(!fileName) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "format-zsk.c writeZsk(), fileName argument is null\n"); return 0; }
 
-    if(!embStitchList_count(pattern->stitchList))
+    if(!embPattern_stitchCount(pattern))
     {
-        embLog_error("format-zsk.c writeZsk(), pattern contains no stitches\n");
+        embLog_errorCode(EMB_LOG_ERROR_EMPTY, "format-zsk.c writeZsk(), pattern contains no stitches\n");
         return 0;
     }
 
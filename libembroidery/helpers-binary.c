@@ -1,7 +1,26 @@
 #include "helpers-binary.h"
 
+#ifndef ARDUINO
+/* Returns a pointer to the next (\a count) bytes of a buffered (\a file) and moves its cursor past them.
+ * Returns null when (\a file) is not buffered or fewer than (\a count) bytes are left. The callers then
+ * fall back to embFile_getc() so reads near the end of the file behave exactly as they do with stdio. */
+static const unsigned char* binaryCursor(EmbFile* file, long count)
+{
+    const unsigned char* bytes = 0;
+    if(!file->buffer || file->position < 0 || file->size - file->position < count)
+        return 0;
+    bytes = file->buffer + file->position;
+    file->position += count;
+    return bytes;
+}
+#else /* ARDUINO */
+#define binaryCursor(file, count) ((const unsigned char*)0)
+#endif /* ARDUINO */
+
 char binaryReadByte(EmbFile* file)
 {
+    const unsigned char* b = binaryCursor(file, 1);
+    if(b) return (char)b[0];
     return (char)embFile_getc(file);
 }
 
@@ -12,14 +31,20 @@ int binaryReadBytes(EmbFile* file, unsigned char* destination, int count)
 
 short binaryReadInt16(EmbFile* file)
 {
-    int x = embFile_getc(file);
+    int x;
+    const unsigned char* b = binaryCursor(file, 2);
+    if(b) return (short)(b[0] | b[1] << 8);
+    x = embFile_getc(file);
     x = x | embFile_getc(file) << 8;
     return (short)x;
 }
 
 int binaryReadInt32(EmbFile* file)
 {
-    int x = embFile_getc(file);
+    int x;
+    const unsigned char* b = binaryCursor(file, 4);
+    if(b) return (int)((unsigned int)b[0] | (unsigned int)b[1] << 8 | (unsigned int)b[2] << 16 | (unsigned int)b[3] << 24);
+    x = embFile_getc(file);
     x = x | embFile_getc(file) << 8;
     x = x | embFile_getc(file) << 16;
     x = x | embFile_getc(file) << 24;
@@ -28,27 +53,40 @@ int binaryReadInt32(EmbFile* file)
 
 unsigned char binaryReadUInt8(EmbFile* file)
 {
+    const unsigned char* b = binaryCursor(file, 1);
+    if(b) return b[0];
     return (unsigned char)embFile_getc(file);
 }
 
 unsigned short binaryReadUInt16(EmbFile* file)
 {
-    return (unsigned short)(embFile_getc(file) | embFile_getc(file) << 8);
+    int x;
+    const unsigned char* b = binaryCursor(file, 2);
+    if(b) return (unsigned short)(b[0] | b[1] << 8);
+    x = embFile_getc(file);
+    x = x | embFile_getc(file) << 8;
+    return (unsigned short)x;
 }
 
 unsigned int binaryReadUInt32(EmbFile* file)
 {
-    unsigned int x = embFile_getc(file);
-    x = x | embFile_getc(file) << 8;
-    x = x | embFile_getc(file) << 16;
-    x = x | embFile_getc(file) << 24;
+    unsigned int x;
+    const unsigned char* b = binaryCursor(file, 4);
+    if(b) return (unsigned int)b[0] | (unsigned int)b[1] << 8 | (unsigned int)b[2] << 16 | (unsigned int)b[3] << 24;
+    x = (unsigned int)embFile_getc(file);
+    x = x | (unsigned int)embFile_getc(file) << 8;
+    x = x | (unsigned int)embFile_getc(file) << 16;
+    x = x | (unsigned int)embFile_getc(file) << 24;
     return x;
 }
 
 /* Big endian version */
 short binaryReadInt16BE(EmbFile* file)
 {
-    short returnValue = (short)(embFile_getc(file) << 8);
+    short returnValue;
+    const unsigned char* b = binaryCursor(file, 2);
+    if(b) return (short)(b[0] << 8 | b[1]);
+    returnValue = (short)(embFile_getc(file) << 8);
     returnValue |= embFile_getc(file);
     return returnValue;
 }
@@ -56,7 +94,10 @@ short binaryReadInt16BE(EmbFile* file)
 /* Big endian version */
 unsigned short binaryReadUInt16BE(EmbFile* file)
 {
-    unsigned short returnValue = (unsigned short)(embFile_getc(file) << 8);
+    unsigned short returnValue;
+    const unsigned char* b = binaryCursor(file, 2);
+    if(b) return (unsigned short)(b[0] << 8 | b[1]);
+    returnValue = (unsigned short)(embFile_getc(file) << 8);
     returnValue |= embFile_getc(file);
     return returnValue;
 }
@@ -64,7 +105,10 @@ unsigned short binaryReadUInt16BE(EmbFile* file)
 /* Big endian version */
 int binaryReadInt32BE(EmbFile* file)
 {
-    int returnValue = embFile_getc(file) << 24;
+    int returnValue;
+    const unsigned char* b = binaryCursor(file, 4);
+    if(b) return (int)((unsigned int)b[0] << 24 | (unsigned int)b[1] << 16 | (unsigned int)b[2] << 8 | (unsigned int)b[3]);
+    returnValue = embFile_getc(file) << 24;
     returnValue |= embFile_getc(file) << 16;
     returnValue |= embFile_getc(file) << 8;
     returnValue |= embFile_getc(file);
@@ -74,7 +118,10 @@ int binaryReadInt32BE(EmbFile* file)
 /* Big endian version */
 unsigned int binaryReadUInt32BE(EmbFile* file)
 {
-    unsigned int returnValue = embFile_getc(file) << 24;
+    unsigned int returnValue;
+    const unsigned char* b = binaryCursor(file, 4);
+    if(b) return (unsigned int)b[0] << 24 | (unsigned int)b[1] << 16 | (unsigned int)b[2] << 8 | (unsigned int)b[3];
+    returnValue = embFile_getc(file) << 24;
     returnValue |= embFile_getc(file) << 16;
     returnValue |= embFile_getc(file) << 8;
     returnValue |= embFile_getc(file);
@@ -112,6 +159,12 @@ float binaryReadFloat(EmbFile* file)
         float f32;
         unsigned int u32;
     } float_int_u;
+    const unsigned char* b = binaryCursor(file, 4);
+    if(b)
+    {
+        float_int_u.u32 = (unsigned int)b[0] | (unsigned int)b[1] << 8 | (unsigned int)b[2] << 16 | (unsigned int)b[3] << 24;
+        return float_int_u.f32;
+    }
     float_int_u.u32 = embFile_getc(file);
     float_int_u.u32 |= embFile_getc(file) << 8;
     float_int_u.u32 |= embFile_getc(file) << 16;
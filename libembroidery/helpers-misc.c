@@ -19,8 +19,8 @@ char startsWith(const char* pre, const char* str)
     char result = 0;
     size_t lenpre;
     size_t lenstr;
-    if(!pre) { embLog_error("helpers-misc.c startsWith(), pre argument is null\n"); return 0; }
-    if(!str) { embLog_error("helpers-misc.c startsWith(), str argument is null\n"); return 0; }
+    if(!pre) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "helpers-misc.c startsWith(), pre argument is null\n"); return 0; }
+    if(!str) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "helpers-misc.c startsWith(), str argument is null\n"); return 0; }
     lenpre = strlen(pre);
     lenstr = strlen(str);
     if(lenstr < lenpre)
@@ -121,9 +121,9 @@ char* emb_optOut(double num, char* str)
 char* emb_strdup(const char* src)
 {
     char* dest = 0;
-    if(!src) { embLog_error("helpers-misc.c emb_strdup(), src argument is null\n"); return 0; }
+    if(!src) { embLog_errorCode(EMB_LOG_ERROR_ARGUMENT, "helpers-misc.c emb_strdup(), src argument is null\n"); return 0; }
     dest = (char*)malloc(strlen(src) + 1);
-    if(!dest) { embLog_error("helpers-misc.c emb_strdup(), cannot allocate memory\n"); }
+    if(!dest) { embLog_errorCode(EMB_LOG_ERROR_MEMORY, "helpers-misc.c emb_strdup(), cannot allocate memory\n"); }
     else { strcpy(dest, src); }
     return dest;
 }
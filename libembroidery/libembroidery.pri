@@ -13,6 +13,11 @@ QMAKE_CFLAGS += -fvisibility=hidden #Check exported symbols using: nm -C -D libe
 QMAKE_CFLAGS_WARN_ON += -Werror=implicit-function-declaration
 }
 
+#emb-worker.c runs tasks on POSIX threads
+unix {
+LIBS += -lpthread
+}
+
 #Uncomment line below to consider all warnings as errors
 #QMAKE_CFLAGS_WARN_ON += -Werror
 
@@ -28,6 +33,7 @@ SOURCES += \
 ../libembroidery/compound-file-fat.c \
 ../libembroidery/compound-file-header.c \
 ../libembroidery/emb-arc.c \
+../libembroidery/emb-arena.c \
 ../libembroidery/emb-circle.c \
 ../libembroidery/emb-compress.c \
 ../libembroidery/emb-color.c \
@@ -40,21 +46,26 @@ SOURCES += \
 ../libembroidery/emb-layer.c \
 ../libembroidery/emb-line.c \
 ../libembroidery/emb-logging.c \
+../libembroidery/emb-palette.c \
 ../libembroidery/emb-path.c \
 ../libembroidery/emb-pattern.c \
 ../libembroidery/emb-point.c \
 ../libembroidery/emb-polygon.c \
 ../libembroidery/emb-polyline.c \
 ../libembroidery/emb-reader-writer.c \
+../libembroidery/emb-record.c \
 ../libembroidery/emb-rect.c \
 ../libembroidery/emb-satin-line.c \
 ../libembroidery/emb-settings.c \
+../libembroidery/emb-spatial-index.c \
 ../libembroidery/emb-spline.c \
 ../libembroidery/emb-stitch.c \
+../libembroidery/emb-stream.c \
 ../libembroidery/emb-thread.c \
 ../libembroidery/emb-time.c \
+../libembroidery/emb-tokenizer.c \
 ../libembroidery/emb-vector.c \
-../libembroidery/hashtable.c \
+../libembroidery/emb-worker.c \
 ../libembroidery/helpers-binary.c \
 ../libembroidery/helpers-misc.c \
 ../libembroidery/thread-color.c \
@@ -130,6 +141,7 @@ HEADERS += \
 ../libembroidery/compound-file-fat.h \
 ../libembroidery/compound-file-header.h \
 ../libembroidery/emb-arc.h \
+../libembroidery/emb-arena.h \
 ../libembroidery/emb-circle.h \
 ../libembroidery/emb-compress.h \
 ../libembroidery/emb-color.h \
@@ -142,21 +154,26 @@ HEADERS += \
 ../libembroidery/emb-layer.h \
 ../libembroidery/emb-line.h \
 ../libembroidery/emb-logging.h \
+../libembroidery/emb-palette.h \
 ../libembroidery/emb-path.h \
 ../libembroidery/emb-pattern.h \
 ../libembroidery/emb-point.h \
 ../libembroidery/emb-polygon.h \
 ../libembroidery/emb-polyline.h \
 ../libembroidery/emb-reader-writer.h \
+../libembroidery/emb-record.h \
 ../libembroidery/emb-rect.h \
 ../libembroidery/emb-satin-line.h \
 ../libembroidery/emb-settings.h \
+../libembroidery/emb-spatial-index.h \
 ../libembroidery/emb-spline.h \
 ../libembroidery/emb-stitch.h \
+../libembroidery/emb-stream.h \
 ../libembroidery/emb-thread.h \
 ../libembroidery/emb-time.h \
+../libembroidery/emb-tokenizer.h \
 ../libembroidery/emb-vector.h \
-../libembroidery/hashtable.h \
+../libembroidery/emb-worker.h \
 ../libembroidery/helpers-binary.h \
 ../libembroidery/helpers-misc.h \
 ../libembroidery/helpers-unused.h \
@@ -3,5069 +3,3585 @@
 #ifdef ARDUINO /* ARDUINO TODO: remove this line when thread-color.c is arduino compatible. This is a temporary arduino build fix. */
 #else          /* ARDUINO TODO: remove this line when thread-color.c is arduino compatible. This is a temporary arduino build fix. */
 
-int getNum_Arc_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Arc_Polyester(unsigned int color) { return ""; } /*TODO: finish */
+/* Each chart is sorted by color. Colors the manufacturer lists under more than one catalog number appear once per number,
+ * and the first of them is the one color lookups return. The ByNumber arrays hold the positions of the entries that have
+ * a catalog number, sorted by that number. Keep both orders when adding colors. */
 
-int getNum_Arc_Rayon(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Arc_Rayon(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_CoatsAndClark_Rayon(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_CoatsAndClark_Rayon(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Exquisite_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Exquisite_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Fufu_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Fufu_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Fufu_Rayon(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Fufu_Rayon(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Hemingworth_Polyester(unsigned int color)
+static const ThreadColor threadColors_Hemingworth_Polyester[] =
 {
-    switch(color)
-    {
-        case 0xFFFFFFFF: return 1001;
-        case 0xFFDDE00F: return 1271;
-        case 0xFFC9DD03: return 1272;
-        case 0xFF60DD49: return 1273;
-        case 0xFFFFCC1E: return 1274;
-        case 0xFFFFED38: return 1275;
-        case 0xFFFFA952: return 1276;
-        case 0xFFFF9338: return 1277;
-        case 0xFFFF585F: return 1278;
-        case 0xFFF28CA3: return 1279;
-        case 0xFFFE8A9E: return 1280;
-        case 0xFFFC074F: return 1281;
-        case 0xFFCFC3C3: return 1067;
-        case 0xFFC9CAC8: return 1068;
-        case 0xFFB2B4B3: return 1069;
-        case 0xFFC6C6BC: return 1070;
-        case 0xFF616365: return 1244;
-        case 0xFF4D4F53: return 1245;
-        case 0xFF8E908F: return 1072;
-        case 0xFF747678: return 1077;
-        case 0xFF6C6F70: return 1073;
-        case 0xFF191D1F: return 1079;
-        case 0xFF1B242A: return 1087;
-        case 0xFF000000: return 1000;
-        case 0xFFD5D2CA: return 1118;
-        case 0xFFDAE3EA: return 1119;
-        case 0xFFA6BCC6: return 1076;
-        case 0xFF818A8F: return 1074;
-        case 0xFF595A5C: return 1078;
-        case 0xFFB9C9D0: return 1239;
-        case 0xFF7D9AAA: return 1240;
-        case 0xFF5E6A71: return 1085;
-        case 0xFF003C69: return 1241;
-        case 0xFF003946: return 1242;
-        case 0xFF004250: return 1081;
-        case 0xFF37424A: return 1086;
-        case 0xFF005B82: return 1192;
-        case 0xFF5E9CAE: return 1193;
-        case 0xFF6AADE4: return 1188;
-        case 0xFF4B92DB: return 1187;
-        case 0xFF8FCAE7: return 1186;
-        case 0xFFC2DEEA: return 1185;
-        case 0xFFA0CFEB: return 1256;
-        case 0xFF0098DB: return 1255;
-        case 0xFF3D7EDB: return 1202;
-        case 0xFF0039A6: return 1203;
-        case 0xFF00338D: return 1204;
-        case 0xFF0B2265: return 1205;
-        case 0xFF98C6EA: return 1189;
-        case 0xFFAACAE6: return 1190;
-        case 0xFF8EBAE5: return 1191;
-        case 0xFF0073CF: return 1198;
-        case 0xFF004165: return 1201;
-        case 0xFF004153: return 1200;
-        case 0xFF002244: return 1199;
-        case 0xFF002C5F: return 1265;
-        case 0xFF002857: return 1264;
-        case 0xFF003591: return 1263;
-        case 0xFF002C77: return 1261;
-        case 0xFF6F9AD3: return 1262;
-        case 0xFF65CFE9: return 1197;
-        case 0xFF0075B0: return 1195;
-        case 0xFF0066A1: return 1196;
-        case 0xFF006983: return 1194;
-        case 0xFF003D4C: return 1258;
-        case 0xFF0098C3: return 1259;
-        case 0xFF00B0CA: return 1260;
-        case 0xFF6FD4E4: return 1257;
-        case 0xFFBBE7E6: return 1178;
-        case 0xFFC1E2E5: return 1172;
-        case 0xFF8FDFE2: return 1173;
-        case 0xFF00AFD8: return 1174;
-        case 0xFF006778: return 1181;
-        case 0xFF007C92: return 1180;
-        case 0xFF009AA6: return 1176;
-        case 0xFF7CA295: return 1175;
-        case 0xFF63CECA: return 1177;
-        case 0xFF00877C: return 1179;
-        case 0xFF007B69: return 1182;
-        case 0xFF024E43: return 1183;
-        case 0xFF004953: return 1184;
-        case 0xFF156570: return 1082;
-        case 0xFF00505C: return 1113;
-        case 0xFF44697D: return 1084;
-        case 0xFF496C60: return 1114;
-        case 0xFF949D9E: return 1115;
-        case 0xFF91BAA3: return 1243;
-        case 0xFFB9CCC3: return 1100;
-        case 0xFFA6E6BC: return 1088;
-        case 0xFF00B588: return 1094;
-        case 0xFF00985F: return 1106;
-        case 0xFF009B74: return 1107;
-        case 0xFF007D57: return 1105;
-        case 0xFF006A4D: return 1104;
-        case 0xFF00685B: return 1254;
-        case 0xFF0D776E: return 1253;
-        case 0xFFC3E76F: return 1099;
-        case 0xFFCCDC00: return 1247;
-        case 0xFF69BE28: return 1097;
-        case 0xFF92D400: return 1091;
-        case 0xFF7AB800: return 1092;
-        case 0xFF3F9C35: return 1093;
-        case 0xFF00AF3F: return 1248;
-        case 0xFF007934: return 1095;
-        case 0xFF008542: return 1108;
-        case 0xFF00693C: return 1109;
-        case 0xFF1C453B: return 1250;
-        case 0xFF175E54: return 1249;
-        case 0xFFC8E59A: return 1096;
-        case 0xFF69923A: return 1251;
-        case 0xFF557630: return 1252;
-        case 0xFF739600: return 1089;
-        case 0xFF53682B: return 1090;
-        case 0xFF035642: return 1103;
-        case 0xFF284E36: return 1110;
-        case 0xFF004438: return 1111;
-        case 0xFF004D46: return 1112;
-        case 0xFF57584F: return 1121;
-        case 0xFF404A29: return 1123;
-        case 0xFF83847A: return 1120;
-        case 0xFF827C34: return 1058;
-        case 0xFFB19B00: return 1061;
-        case 0xFFB5A300: return 1059;
-        case 0xFFF8E498: return 1060;
-        case 0xFFD7D3C7: return 1229;
-        case 0xFFD5C833: return 1098;
-        case 0xFF6A7029: return 1101;
-        case 0xFF898F4B: return 1102;
-        case 0xFF65551C: return 1246;
-        case 0xFF4B452C: return 1117;
-        case 0xFF4B471A: return 1116;
-        case 0xFF718674: return 1083;
-        case 0xFF4F4C25: return 1125;
-        case 0xFF5D4F4B: return 1131;
-        case 0xFF452325: return 1126;
-        case 0xFF4E2E2D: return 1128;
-        case 0xFF6E3219: return 1130;
-        case 0xFF60351D: return 1134;
-        case 0xFF6C4D23: return 1140;
-        case 0xFF766A65: return 1237;
-        case 0xFF5B491F: return 1137;
-        case 0xFF6E5A2A: return 1135;
-        case 0xFFAB8422: return 1136;
-        case 0xFF856822: return 1122;
-        case 0xFF675C53: return 1236;
-        case 0xFF9A996E: return 1124;
-        case 0xFFC2B2B5: return 1149;
-        case 0xFFA5ACAF: return 1146;
-        case 0xFFAE7D5B: return 1145;
-        case 0xFFA76F3E: return 1133;
-        case 0xFFA25022: return 1064;
-        case 0xFF86431E: return 1238;
-        case 0xFFB2541A: return 1163;
-        case 0xFF833820: return 1164;
-        case 0xFF9A3B26: return 1144;
-        case 0xFF825C26: return 1142;
-        case 0xFFC59217: return 1063;
-        case 0xFFDDB99A: return 1062;
-        case 0xFFD2C295: return 1057;
-        case 0xFFC2C2A0: return 1056;
-        case 0xFFB3B38C: return 1055;
-        case 0xFFC7B37F: return 1054;
-        case 0xFFBD9271: return 1171;
-        case 0xFFB3995D: return 1138;
-        case 0xFFCEA98C: return 1235;
-        case 0xFFE39B6C: return 1139;
-        case 0xFFBA6F2E: return 1132;
-        case 0xFFBB650E: return 1141;
-        case 0xFFEBE8B1: return 1042;
-        case 0xFFEEEC83: return 1043;
-        case 0xFFF3EC7A: return 1045;
-        case 0xFFF5EC5A: return 1225;
-        case 0xFFFAE700: return 1226;
-        case 0xFFF2EE72: return 1044;
-        case 0xFFFCD900: return 1227;
-        case 0xFFFADC41: return 1046;
-        case 0xFFFED100: return 1047;
-        case 0xFFF3CF45: return 1048;
-        case 0xFFEFBD47: return 1050;
-        case 0xFFEAAB00: return 1051;
-        case 0xFFDCD6B2: return 1037;
-        case 0xFFC6BC89: return 1038;
-     /* case 0xFFF8E498: return 1039;    TODO: duplicate case value */
-        case 0xFFF8DE6E: return 1040;
-        case 0xFFFADA63: return 1049;
-        case 0xFFFFCB4F: return 1053;
-        case 0xFFFFA100: return 1232;
-        case 0xFFFFB612: return 1231;
-        case 0xFFFFB652: return 1230;
-        case 0xFFFFBC3D: return 1041;
-        case 0xFFCE8E00: return 1052;
-        case 0xFF9D5324: return 1143;
-        case 0xFFE98300: return 1024;
-        case 0xFFFF7000: return 1025;
-        case 0xFFE37222: return 1027;
-        case 0xFFFB4F14: return 1028;
-        case 0xFFDD4814: return 1029;
-        case 0xFFCD202C: return 1030;
-        case 0xFFC30014: return 1270;
-        case 0xFFA70232: return 1032;
-        case 0xFF882332: return 1031;
-        case 0xFFA51100: return 1002;
-        case 0xFF9E3039: return 1234;
-        case 0xFF783014: return 1233;
-        case 0xFFD55C19: return 1065;
-        case 0xFFAA272F: return 1066;
-        case 0xFF5F3327: return 1129;
-        case 0xFF5D3526: return 1127;
-        case 0xFF592C35: return 1160;
-        case 0xFF6A1A41: return 1159;
-        case 0xFF6E2714: return 1158;
-        case 0xFF662046: return 1157;
-        case 0xFF85003C: return 1156;
-        case 0xFF641F14: return 1155;
-        case 0xFFFF818D: return 1166;
-        case 0xFFFFA48A: return 1015;
-        case 0xFFFFB0B7: return 1011;
-        case 0xFFF3789B: return 1012;
-        case 0xFFDB4D69: return 1014;
-        case 0xFF91004B: return 1013;
-        case 0xFF82240C: return 1224;
-        case 0xFFF54359: return 1018;
-        case 0xFFF4587A: return 1017;
-        case 0xFFFF8B7C: return 1016;
-        case 0xFFFFC19C: return 1022;
-        case 0xFFFF8F70: return 1020;
-        case 0xFFFF6D42: return 1026;
-        case 0xFFFFA02F: return 1023;
-        case 0xFFECC182: return 1168;
-        case 0xFFFBCE92: return 1021;
-        case 0xFFFDC480: return 1228;
-        case 0xFFFFC2A2: return 1167;
-        case 0xFFEFC5CE: return 1169;
-        case 0xFFEFBE9C: return 1170;
-        case 0xFF774A39: return 1162;
-        case 0xFFB26F7E: return 1151;
-        case 0xFFD490A8: return 1165;
-        case 0xFFF6A3BB: return 1161;
-        case 0xFFFFB7AE: return 1019;
-        case 0xFFEFD6DB: return 1150;
-        case 0xFF920075: return 1036;
-        case 0xFFF375C6: return 1004;
-        case 0xFFF3BBCE: return 1003;
-        case 0xFFF1DBDF: return 1005;
-        case 0xFFF3C9D3: return 1006;
-        case 0xFFF4B2C1: return 1007;
-        case 0xFFF39EBC: return 1008;
-        case 0xFFF77AB4: return 1009;
-        case 0xFFD71F85: return 1010;
-        case 0xFF772059: return 1035;
-        case 0xFFC50084: return 1034;
-        case 0xFFA1006B: return 1033;
-        case 0xFFD1D4D3: return 1148;
-        case 0xFFCAD1E7: return 1147;
-        case 0xFF9DABE2: return 1207;
-        case 0xFF8884D5: return 1206;
-        case 0xFF1A2155: return 1209;
-        case 0xFF6459C4: return 1211;
-        case 0xFF212492: return 1208;
-        case 0xFF411244: return 1210;
-        case 0xFF3B0083: return 1223;
-        case 0xFF151C54: return 1267;
-        case 0xFF490E6F: return 1269;
-        case 0xFF57068C: return 1268;
-        case 0xFFDCC7DF: return 1217;
-        case 0xFFC2ACBE: return 1219;
-        case 0xFFDC9DDD: return 1218;
-        case 0xFFB382C7: return 1213;
-        case 0xFF9C5FB5: return 1214;
-        case 0xFF4B08A1: return 1266;
-        case 0xFFC1AFE5: return 1221;
-        case 0xFFC5B9E3: return 1222;
-        case 0xFF6E2C6B: return 1215;
-        case 0xFF7D0063: return 1216;
-        case 0xFF752864: return 1220;
-        case 0xFF55517B: return 1080;
-        case 0xFF5C7F92: return 1075;
-        case 0xFFAFADC3: return 1071;
-        case 0xFFD8AAB3: return 1152;
-        case 0xFF89687C: return 1153;
-        case 0xFF644459: return 1154;
-        case 0xFF4B306A: return 1212;
-    }
-
-    return -1;
-}
-const char* getName_Hemingworth_Polyester(unsigned int color)
+    { 0xFF000000, 1000, "Classic Black" },
+    { 0xFF002244, 1199, "Navy" },
+    { 0xFF002857, 1264, "Dark Blue " },
+    { 0xFF002C5F, 1265, "Sailor Blue" },
+    { 0xFF002C77, 1261, "True Blue" },
+    { 0xFF00338D, 1204, "Brilliant Blue" },
+    { 0xFF003591, 1263, "Berry Blue" },
+    { 0xFF003946, 1242, "Deep Slate Blue" },
+    { 0xFF0039A6, 1203, "Royal Blue" },
+    { 0xFF003C69, 1241, "Dark Slate Blue" },
+    { 0xFF003D4C, 1258, "Dark Turquoise" },
+    { 0xFF004153, 1200, "Salem Blue" },
+    { 0xFF004165, 1201, "Dark Blueberry" },
+    { 0xFF004250, 1081, "Pacific Waters" },
+    { 0xFF004438, 1111, "Mountain Meadow" },
+    { 0xFF004953, 1184, "Deep Teal" },
+    { 0xFF004D46, 1112, "Forest Green" },
+    { 0xFF00505C, 1113, "Dragonfly" },
+    { 0xFF005B82, 1192, "Smoky Blue" },
+    { 0xFF0066A1, 1196, "Dark Aquamarine" },
+    { 0xFF006778, 1181, "Blue Satin" },
+    { 0xFF00685B, 1254, "Dark Teal" },
+    { 0xFF00693C, 1109, "Christmas Green" },
+    { 0xFF006983, 1194, "Peacock Blue" },
+    { 0xFF006A4D, 1104, "Caribbean" },
+    { 0xFF0073CF, 1198, "China Blue" },
+    { 0xFF0075B0, 1195, "Medium Aquamarine" },
+    { 0xFF007934, 1095, "Grassy Green" },
+    { 0xFF007B69, 1182, "Peacock Green" },
+    { 0xFF007C92, 1180, "Teal Blue" },
+    { 0xFF007D57, 1105, "Dark Jade" },
+    { 0xFF008542, 1108, "Dark Kelly Green" },
+    { 0xFF00877C, 1179, "Navajo Turquoise" },
+    { 0xFF00985F, 1106, "Light Jade" },
+    { 0xFF0098C3, 1259, "Turquoise" },
+    { 0xFF0098DB, 1255, "Country Blue" },
+    { 0xFF009AA6, 1176, "Light Teal Blue" },
+    { 0xFF009B74, 1107, "Jade" },
+    { 0xFF00AF3F, 1248, "Meadow" },
+    { 0xFF00AFD8, 1174, "Blue Lagoon" },
+    { 0xFF00B0CA, 1260, "Caribbean Blue" },
+    { 0xFF00B588, 1094, "Cucumber Melon" },
+    { 0xFF024E43, 1183, "Forest Glen" },
+    { 0xFF035642, 1103, "Ivy" },
+    { 0xFF0B2265, 1205, "Deep Blue" },
+    { 0xFF0D776E, 1253, "Minty Teal" },
+    { 0xFF151C54, 1267, "Eggplant" },
+    { 0xFF156570, 1082, "Deep Sea" },
+    { 0xFF175E54, 1249, "Holly Leaf" },
+    { 0xFF191D1F, 1079, "Black Stallion" },
+    { 0xFF1A2155, 1209, "Grape" },
+    { 0xFF1B242A, 1087, "Charcoal" },
+    { 0xFF1C453B, 1250, "Winter Pine " },
+    { 0xFF212492, 1208, "Electric Purple" },
+    { 0xFF284E36, 1110, "Evergreen" },
+    { 0xFF37424A, 1086, "Dark Slate" },
+    { 0xFF3B0083, 1223, "Royal Purple" },
+    { 0xFF3D7EDB, 1202, "Azure" },
+    { 0xFF3F9C35, 1093, "Kelly Green" },
+    { 0xFF404A29, 1123, "Jungle Green" },
+    { 0xFF411244, 1210, "Indigo" },
+    { 0xFF44697D, 1084, "Blue Steel" },
+    { 0xFF452325, 1126, "Dark Chocolate" },
+    { 0xFF490E6F, 1269, "Dark Purple" },
+    { 0xFF496C60, 1114, "Dark Sage" },
+    { 0xFF4B08A1, 1266, "Soft Grape" },
+    { 0xFF4B306A, 1212, "Huckleberry" },
+    { 0xFF4B452C, 1117, "Coconut Shell" },
+    { 0xFF4B471A, 1116, "Parsley" },
+    { 0xFF4B92DB, 1187, "Bluebird" },
+    { 0xFF4D4F53, 1245, "Light Charcoal" },
+    { 0xFF4E2E2D, 1128, "Deep Walnut" },
+    { 0xFF4F4C25, 1125, "Mocha" },
+    { 0xFF53682B, 1090, "Kentucky Grass" },
+    { 0xFF55517B, 1080, "Deep Orchid" },
+    { 0xFF557630, 1252, "Bush Ivy " },
+    { 0xFF57068C, 1268, "Pure Purple" },
+    { 0xFF57584F, 1121, "Oregano" },
+    { 0xFF592C35, 1160, "Merlot" },
+    { 0xFF595A5C, 1078, "Bronzed Steel" },
+    { 0xFF5B491F, 1137, "Army Green" },
+    { 0xFF5C7F92, 1075, "Misty Blue Gray" },
+    { 0xFF5D3526, 1127, "Burnt Sienna" },
+    { 0xFF5D4F4B, 1131, "Warm Earth" },
+    { 0xFF5E6A71, 1085, "Shadow" },
+    { 0xFF5E9CAE, 1193, "Light Slate Blue" },
+    { 0xFF5F3327, 1129, "Cherrywood" },
+    { 0xFF60351D, 1134, "Light Chestnut" },
+    { 0xFF60DD49, 1273, "Brilliant Lime" },
+    { 0xFF616365, 1244, "Graphite" },
+    { 0xFF63CECA, 1177, "Mint Green" },
+    { 0xFF641F14, 1155, "Raspberry" },
+    { 0xFF644459, 1154, "Wild Plum" },
+    { 0xFF6459C4, 1211, "Moon Shadow" },
+    { 0xFF65551C, 1246, "Olive Green" },
+    { 0xFF65CFE9, 1197, "Iceberg Blue" },
+    { 0xFF662046, 1157, "Mulberry" },
+    { 0xFF675C53, 1236, "Weathered Wood" },
+    { 0xFF69923A, 1251, "Dusty Green" },
+    { 0xFF69BE28, 1097, "Electric Green" },
+    { 0xFF6A1A41, 1159, "Loganberry" },
+    { 0xFF6A7029, 1101, "Avocado" },
+    { 0xFF6AADE4, 1188, "Hyacinth" },
+    { 0xFF6C4D23, 1140, "Pecan Pie" },
+    { 0xFF6C6F70, 1073, "Pewter Gray" },
+    { 0xFF6E2714, 1158, "Cranberry" },
+    { 0xFF6E2C6B, 1215, "Peony" },
+    { 0xFF6E3219, 1130, "Teddybear Brown" },
+    { 0xFF6E5A2A, 1135, "Pharaoh Gold" },
+    { 0xFF6F9AD3, 1262, "Periwinkle" },
+    { 0xFF6FD4E4, 1257, "Summer Sky" },
+    { 0xFF718674, 1083, "Dried Sage" },
+    { 0xFF739600, 1089, "Leafy Green" },
+    { 0xFF747678, 1077, "Antique Silver" },
+    { 0xFF752864, 1220, "Grape Jelly" },
+    { 0xFF766A65, 1237, "Dark Alder" },
+    { 0xFF772059, 1035, "Mulled Wine" },
+    { 0xFF774A39, 1162, "Old Penny" },
+    { 0xFF783014, 1233, "Redwood" },
+    { 0xFF7AB800, 1092, "Key Lime" },
+    { 0xFF7CA295, 1175, "Wintergreen" },
+    { 0xFF7D0063, 1216, "Dark Fuschia" },
+    { 0xFF7D9AAA, 1240, "Granite" },
+    { 0xFF818A8F, 1074, "Sea Storm" },
+    { 0xFF82240C, 1224, "Raspberry Red" },
+    { 0xFF825C26, 1142, "Toasted Almond" },
+    { 0xFF827C34, 1058, "Light Avocado" },
+    { 0xFF833820, 1164, "Rust" },
+    { 0xFF83847A, 1120, "Thyme" },
+    { 0xFF85003C, 1156, "Magenta" },
+    { 0xFF856822, 1122, "Sahara" },
+    { 0xFF86431E, 1238, "Cinnamon" },
+    { 0xFF882332, 1031, "Rummy Raisin" },
+    { 0xFF8884D5, 1206, "Purple Iris" },
+    { 0xFF89687C, 1153, "Dark Mauve" },
+    { 0xFF898F4B, 1102, "Seaweed" },
+    { 0xFF8E908F, 1072, "Chrome" },
+    { 0xFF8EBAE5, 1191, "Sky Blue" },
+    { 0xFF8FCAE7, 1186, "Misty Blue" },
+    { 0xFF8FDFE2, 1173, "Frosty Blue" },
+    { 0xFF91004B, 1013, "Very Berry" },
+    { 0xFF91BAA3, 1243, "Antique Gray" },
+    { 0xFF920075, 1036, "Fuchsia" },
+    { 0xFF92D400, 1091, "Green Apple" },
+    { 0xFF949D9E, 1115, "Silver Green" },
+    { 0xFF98C6EA, 1189, "Winter Blue" },
+    { 0xFF9A3B26, 1144, "Indian Paintbrush" },
+    { 0xFF9A996E, 1124, "Soft Beige" },
+    { 0xFF9C5FB5, 1214, "Lavender" },
+    { 0xFF9D5324, 1143, "Auburn" },
+    { 0xFF9DABE2, 1207, "Tulip" },
+    { 0xFF9E3039, 1234, "Rusty Red" },
+    { 0xFFA0CFEB, 1256, "Pale Blue" },
+    { 0xFFA1006B, 1033, "Azalea" },
+    { 0xFFA25022, 1064, "Light Cinnamon" },
+    { 0xFFA51100, 1002, "Cardinal Red" },
+    { 0xFFA5ACAF, 1146, "Old Lace" },
+    { 0xFFA6BCC6, 1076, "Nautical Blue" },
+    { 0xFFA6E6BC, 1088, "Sea Foam" },
+    { 0xFFA70232, 1032, "Pomegranate" },
+    { 0xFFA76F3E, 1133, "Brown Sugar" },
+    { 0xFFAA272F, 1066, "Paprika" },
+    { 0xFFAACAE6, 1190, "Winter Sky" },
+    { 0xFFAB8422, 1136, "Autumn Haystack" },
+    { 0xFFAE7D5B, 1145, "Caramel Cappuccino" },
+    { 0xFFAFADC3, 1071, "Iron Ore" },
+    { 0xFFB19B00, 1061, "Split Pea" },
+    { 0xFFB2541A, 1163, "Apple Cider" },
+    { 0xFFB26F7E, 1151, "Dusty Rose" },
+    { 0xFFB2B4B3, 1069, "Storm Cloud" },
+    { 0xFFB382C7, 1213, "Heather" },
+    { 0xFFB3995D, 1138, "Butter Taffy" },
+    { 0xFFB3B38C, 1055, "Malt" },
+    { 0xFFB5A300, 1059, "Spring Leaf" },
+    { 0xFFB9C9D0, 1239, "Silvery Gray" },
+    { 0xFFB9CCC3, 1100, "Ocean Spray" },
+    { 0xFFBA6F2E, 1132, "New Penny" },
+    { 0xFFBB650E, 1141, "Pumpkin Spice" },
+    { 0xFFBBE7E6, 1178, "Crystal Lake" },
+    { 0xFFBD9271, 1171, "Champagne" },
+    { 0xFFC1AFE5, 1221, "Freesia" },
+    { 0xFFC1E2E5, 1172, "Icicle Blue" },
+    { 0xFFC2ACBE, 1219, "Dusty Mauve" },
+    { 0xFFC2B2B5, 1149, "Mercury" },
+    { 0xFFC2C2A0, 1056, "Ecru" },
+    { 0xFFC2DEEA, 1185, "Cornflower Blue" },
+    { 0xFFC30014, 1270, "Christmas Red" },
+    { 0xFFC3E76F, 1099, "Lemony Lime" },
+    { 0xFFC50084, 1034, "Primrose" },
+    { 0xFFC59217, 1063, "Pale Caramel" },
+    { 0xFFC5B9E3, 1222, "Lilac" },
+    { 0xFFC6BC89, 1038, "Macadamia" },
+    { 0xFFC6C6BC, 1070, "Platinum" },
+    { 0xFFC7B37F, 1054, "Antique Lace" },
+    { 0xFFC8E59A, 1096, "Pistachio Nut" },
+    { 0xFFC9CAC8, 1068, "Silver Lining" },
+    { 0xFFC9DD03, 1272, "Neon Green" },
+    { 0xFFCAD1E7, 1147, "Moonlight" },
+    { 0xFFCCDC00, 1247, "Kiwi Lime" },
+    { 0xFFCD202C, 1030, "Candy Apple" },
+    { 0xFFCE8E00, 1052, "Old Gold" },
+    { 0xFFCEA98C, 1235, "Cream Soda" },
+    { 0xFFCFC3C3, 1067, "Dove Gray" },
+    { 0xFFD1D4D3, 1148, "Snowflake" },
+    { 0xFFD2C295, 1057, "Sandy Shore" },
+    { 0xFFD490A8, 1165, "Winter Rose" },
+    { 0xFFD55C19, 1065, "Carrot" },
+    { 0xFFD5C833, 1098, "Cornsilk Green" },
+    { 0xFFD5D2CA, 1118, "Marshmallow" },
+    { 0xFFD71F85, 1010, "Passion Pink" },
+    { 0xFFD7D3C7, 1229, "Eggshell" },
+    { 0xFFD8AAB3, 1152, "Light Mauve" },
+    { 0xFFDAE3EA, 1119, "Ice Blue" },
+    { 0xFFDB4D69, 1014, "Carnation" },
+    { 0xFFDC9DDD, 1218, "Orchid" },
+    { 0xFFDCC7DF, 1217, "Pale Orchid" },
+    { 0xFFDCD6B2, 1037, "Cornsilk" },
+    { 0xFFDD4814, 1029, "Fall Harvest" },
+    { 0xFFDDB99A, 1062, "Honey Butter" },
+    { 0xFFDDE00F, 1271, "Lemon Ice" },
+    { 0xFFE37222, 1027, "Fiery Sunset" },
+    { 0xFFE39B6C, 1139, "Conch Shell" },
+    { 0xFFE98300, 1024, "Citrus Burst" },
+    { 0xFFEAAB00, 1051, "Goldenrod" },
+    { 0xFFEBE8B1, 1042, "Soft Sunlight" },
+    { 0xFFECC182, 1168, "Spun Silk" },
+    { 0xFFEEEC83, 1043, "Lemon Drop" },
+    { 0xFFEFBD47, 1050, "Ginger Root" },
+    { 0xFFEFBE9C, 1170, "Peach Pastel" },
+    { 0xFFEFC5CE, 1169, "Peaches 'n Cream" },
+    { 0xFFEFD6DB, 1150, "Soft Petal" },
+    { 0xFFF1DBDF, 1005, "Whisper Pink" },
+    { 0xFFF28CA3, 1279, "Shy Flamingo" },
+    { 0xFFF2EE72, 1044, "Canary Yellow" },
+    { 0xFFF375C6, 1004, "Pink Kiss" },
+    { 0xFFF3789B, 1012, "Bubblegum Pink" },
+    { 0xFFF39EBC, 1008, "Sweet Pea" },
+    { 0xFFF3BBCE, 1003, "Baby Pink" },
+    { 0xFFF3C9D3, 1006, "Gentle Blush" },
+    { 0xFFF3CF45, 1048, "Buttercup" },
+    { 0xFFF3EC7A, 1045, "Daffodil" },
+    { 0xFFF4587A, 1017, "Apricot Dream" },
+    { 0xFFF4B2C1, 1007, "English Rose" },
+    { 0xFFF54359, 1018, "Dark Salmon" },
+    { 0xFFF5EC5A, 1225, "Lemon Citrus" },
+    { 0xFFF6A3BB, 1161, "Valentine Pink" },
+    { 0xFFF77AB4, 1009, "Rosy Blush" },
+    { 0xFFF8DE6E, 1040, "Maize" },
+    { 0xFFF8E498, 1060, "Almond Cream" },
+    { 0xFFF8E498, 1039, "Yellow Plumeria" },
+    { 0xFFFADA63, 1049, "Dried Banana" },
+    { 0xFFFADC41, 1046, "Sun" },
+    { 0xFFFAE700, 1226, "Sunshine Yellow" },
+    { 0xFFFB4F14, 1028, "Hunter Orange" },
+    { 0xFFFBCE92, 1021, "Whipped Papaya" },
+    { 0xFFFC074F, 1281, "Neon Peach" },
+    { 0xFFFCD900, 1227, "Sunflower" },
+    { 0xFFFDC480, 1228, "Baby Peach" },
+    { 0xFFFE8A9E, 1280, "Neon Pink" },
+    { 0xFFFED100, 1047, "Dandelion" },
+    { 0xFFFF585F, 1278, "Rebel Peach" },
+    { 0xFFFF6D42, 1026, "Dark Mango" },
+    { 0xFFFF7000, 1025, "Orange Slice" },
+    { 0xFFFF818D, 1166, "Salmon" },
+    { 0xFFFF8B7C, 1016, "Coral Reef" },
+    { 0xFFFF8F70, 1020, "Tangerine" },
+    { 0xFFFF9338, 1277, "Neon Orange" },
+    { 0xFFFFA02F, 1023, "Marigold" },
+    { 0xFFFFA100, 1232, "Orange Meringue" },
+    { 0xFFFFA48A, 1015, "Georgia Peach" },
+    { 0xFFFFA952, 1276, "Tropical Orange" },
+    { 0xFFFFB0B7, 1011, "Rose Sunset" },
+    { 0xFFFFB612, 1231, "September Sunset" },
+    { 0xFFFFB652, 1230, "Orange Cream" },
+    { 0xFFFFB7AE, 1019, "Petal Peach" },
+    { 0xFFFFBC3D, 1041, "Cantaloupe" },
+    { 0xFFFFC19C, 1022, "Frosted Peach" },
+    { 0xFFFFC2A2, 1167, "Pink Pearl" },
+    { 0xFFFFCB4F, 1053, "Butternut" },
+    { 0xFFFFCC1E, 1274, "Mango" },
+    { 0xFFFFED38, 1275, "Neon Yellow" },
+    { 0xFFFFFFFF, 1001, "Pure White" }
+};
+
+static const short threadColorsByNumber_Hemingworth_Polyester[] =
 {
-    switch(color)
-    {
-        case 0xFFFFFFFF: return "Pure White";
-        case 0xFFDDE00F: return "Lemon Ice";
-        case 0xFFC9DD03: return "Neon Green";
-        case 0xFF60DD49: return "Brilliant Lime";
-        case 0xFFFFCC1E: return "Mango";
-        case 0xFFFFED38: return "Neon Yellow";
-        case 0xFFFFA952: return "Tropical Orange";
-        case 0xFFFF9338: return "Neon Orange";
-        case 0xFFFF585F: return "Rebel Peach";
-        case 0xFFF28CA3: return "Shy Flamingo";
-        case 0xFFFE8A9E: return "Neon Pink";
-        case 0xFFFC074F: return "Neon Peach";
-        case 0xFFCFC3C3: return "Dove Gray";
-        case 0xFFC9CAC8: return "Silver Lining";
-        case 0xFFB2B4B3: return "Storm Cloud";
-        case 0xFFC6C6BC: return "Platinum";
-        case 0xFF616365: return "Graphite";
-        case 0xFF4D4F53: return "Light Charcoal";
-        case 0xFF8E908F: return "Chrome";
-        case 0xFF747678: return "Antique Silver";
-        case 0xFF6C6F70: return "Pewter Gray";
-        case 0xFF191D1F: return "Black Stallion";
-        case 0xFF1B242A: return "Charcoal";
-        case 0xFF000000: return "Classic Black";
-        case 0xFFD5D2CA: return "Marshmallow";
-        case 0xFFDAE3EA: return "Ice Blue";
-        case 0xFFA6BCC6: return "Nautical Blue";
-        case 0xFF818A8F: return "Sea Storm";
-        case 0xFF595A5C: return "Bronzed Steel";
-        case 0xFFB9C9D0: return "Silvery Gray";
-        case 0xFF7D9AAA: return "Granite";
-        case 0xFF5E6A71: return "Shadow";
-        case 0xFF003C69: return "Dark Slate Blue";
-        case 0xFF003946: return "Deep Slate Blue";
-        case 0xFF004250: return "Pacific Waters";
-        case 0xFF37424A: return "Dark Slate";
-        case 0xFF005B82: return "Smoky Blue";
-        case 0xFF5E9CAE: return "Light Slate Blue";
-        case 0xFF6AADE4: return "Hyacinth";
-        case 0xFF4B92DB: return "Bluebird";
-        case 0xFF8FCAE7: return "Misty Blue";
-        case 0xFFC2DEEA: return "Cornflower Blue";
-        case 0xFFA0CFEB: return "Pale Blue";
-        case 0xFF0098DB: return "Country Blue";
-        case 0xFF3D7EDB: return "Azure";
-        case 0xFF0039A6: return "Royal Blue";
-        case 0xFF00338D: return "Brilliant Blue";
-        case 0xFF0B2265: return "Deep Blue";
-        case 0xFF98C6EA: return "Winter Blue";
-        case 0xFFAACAE6: return "Winter Sky";
-        case 0xFF8EBAE5: return "Sky Blue";
-        case 0xFF0073CF: return "China Blue";
-        case 0xFF004165: return "Dark Blueberry";
-        case 0xFF004153: return "Salem Blue";
-        case 0xFF002244: return "Navy";
-        case 0xFF002C5F: return "Sailor Blue";
-        case 0xFF002857: return "Dark Blue ";
-        case 0xFF003591: return "Berry Blue";
-        case 0xFF002C77: return "True Blue";
-        case 0xFF6F9AD3: return "Periwinkle";
-        case 0xFF65CFE9: return "Iceberg Blue";
-        case 0xFF0075B0: return "Medium Aquamarine";
-        case 0xFF0066A1: return "Dark Aquamarine";
-        case 0xFF006983: return "Peacock Blue";
-        case 0xFF003D4C: return "Dark Turquoise";
-        case 0xFF0098C3: return "Turquoise";
-        case 0xFF00B0CA: return "Caribbean Blue";
-        case 0xFF6FD4E4: return "Summer Sky";
-        case 0xFFBBE7E6: return "Crystal Lake";
-        case 0xFFC1E2E5: return "Icicle Blue";
-        case 0xFF8FDFE2: return "Frosty Blue";
-        case 0xFF00AFD8: return "Blue Lagoon";
-        case 0xFF006778: return "Blue Satin";
-        case 0xFF007C92: return "Teal Blue";
-        case 0xFF009AA6: return "Light Teal Blue";
-        case 0xFF7CA295: return "Wintergreen";
-        case 0xFF63CECA: return "Mint Green";
-        case 0xFF00877C: return "Navajo Turquoise";
-        case 0xFF007B69: return "Peacock Green";
-        case 0xFF024E43: return "Forest Glen";
-        case 0xFF004953: return "Deep Teal";
-        case 0xFF156570: return "Deep Sea";
-        case 0xFF00505C: return "Dragonfly";
-        case 0xFF44697D: return "Blue Steel";
-        case 0xFF496C60: return "Dark Sage";
-        case 0xFF949D9E: return "Silver Green";
-        case 0xFF91BAA3: return "Antique Gray";
-        case 0xFFB9CCC3: return "Ocean Spray";
-        case 0xFFA6E6BC: return "Sea Foam";
-        case 0xFF00B588: return "Cucumber Melon";
-        case 0xFF00985F: return "Light Jade";
-        case 0xFF009B74: return "Jade";
-        case 0xFF007D57: return "Dark Jade";
-        case 0xFF006A4D: return "Caribbean";
-        case 0xFF00685B: return "Dark Teal";
-        case 0xFF0D776E: return "Minty Teal";
-        case 0xFFC3E76F: return "Lemony Lime";
-        case 0xFFCCDC00: return "Kiwi Lime";
-        case 0xFF69BE28: return "Electric Green";
-        case 0xFF92D400: return "Green Apple";
-        case 0xFF7AB800: return "Key Lime";
-        case 0xFF3F9C35: return "Kelly Green";
-        case 0xFF00AF3F: return "Meadow";
-        case 0xFF007934: return "Grassy Green";
-        case 0xFF008542: return "Dark Kelly Green";
-        case 0xFF00693C: return "Christmas Green";
-        case 0xFF1C453B: return "Winter Pine ";
-        case 0xFF175E54: return "Holly Leaf";
-        case 0xFFC8E59A: return "Pistachio Nut";
-        case 0xFF69923A: return "Dusty Green";
-        case 0xFF557630: return "Bush Ivy ";
-        case 0xFF739600: return "Leafy Green";
-        case 0xFF53682B: return "Kentucky Grass";
-        case 0xFF035642: return "Ivy";
-        case 0xFF284E36: return "Evergreen";
-        case 0xFF004438: return "Mountain Meadow";
-        case 0xFF004D46: return "Forest Green";
-        case 0xFF57584F: return "Oregano";
-        case 0xFF404A29: return "Jungle Green";
-        case 0xFF83847A: return "Thyme";
-        case 0xFF827C34: return "Light Avocado";
-        case 0xFFB19B00: return "Split Pea";
-        case 0xFFB5A300: return "Spring Leaf";
-        case 0xFFF8E498: return "Almond Cream";
-        case 0xFFD7D3C7: return "Eggshell";
-        case 0xFFD5C833: return "Cornsilk Green";
-        case 0xFF6A7029: return "Avocado";
-        case 0xFF898F4B: return "Seaweed";
-        case 0xFF65551C: return "Olive Green";
-        case 0xFF4B452C: return "Coconut Shell";
-        case 0xFF4B471A: return "Parsley";
-        case 0xFF718674: return "Dried Sage";
-        case 0xFF4F4C25: return "Mocha";
-        case 0xFF5D4F4B: return "Warm Earth";
-        case 0xFF452325: return "Dark Chocolate";
-        case 0xFF4E2E2D: return "Deep Walnut";
-        case 0xFF6E3219: return "Teddybear Brown";
-        case 0xFF60351D: return "Light Chestnut";
-        case 0xFF6C4D23: return "Pecan Pie";
-        case 0xFF766A65: return "Dark Alder";
-        case 0xFF5B491F: return "Army Green";
-        case 0xFF6E5A2A: return "Pharaoh Gold";
-        case 0xFFAB8422: return "Autumn Haystack";
-        case 0xFF856822: return "Sahara";
-        case 0xFF675C53: return "Weathered Wood";
-        case 0xFF9A996E: return "Soft Beige";
-        case 0xFFC2B2B5: return "Mercury";
-        case 0xFFA5ACAF: return "Old Lace";
-        case 0xFFAE7D5B: return "Caramel Cappuccino";
-        case 0xFFA76F3E: return "Brown Sugar";
-        case 0xFFA25022: return "Light Cinnamon";
-        case 0xFF86431E: return "Cinnamon";
-        case 0xFFB2541A: return "Apple Cider";
-        case 0xFF833820: return "Rust";
-        case 0xFF9A3B26: return "Indian Paintbrush";
-        case 0xFF825C26: return "Toasted Almond";
-        case 0xFFC59217: return "Pale Caramel";
-        case 0xFFDDB99A: return "Honey Butter";
-        case 0xFFD2C295: return "Sandy Shore";
-        case 0xFFC2C2A0: return "Ecru";
-        case 0xFFB3B38C: return "Malt";
-        case 0xFFC7B37F: return "Antique Lace";
-        case 0xFFBD9271: return "Champagne";
-        case 0xFFB3995D: return "Butter Taffy";
-        case 0xFFCEA98C: return "Cream Soda";
-        case 0xFFE39B6C: return "Conch Shell";
-        case 0xFFBA6F2E: return "New Penny";
-        case 0xFFBB650E: return "Pumpkin Spice";
-        case 0xFFEBE8B1: return "Soft Sunlight";
-        case 0xFFEEEC83: return "Lemon Drop";
-        case 0xFFF3EC7A: return "Daffodil";
-        case 0xFFF5EC5A: return "Lemon Citrus";
-        case 0xFFFAE700: return "Sunshine Yellow";
-        case 0xFFF2EE72: return "Canary Yellow";
-        case 0xFFFCD900: return "Sunflower";
-        case 0xFFFADC41: return "Sun";
-        case 0xFFFED100: return "Dandelion";
-        case 0xFFF3CF45: return "Buttercup";
-        case 0xFFEFBD47: return "Ginger Root";
-        case 0xFFEAAB00: return "Goldenrod";
-        case 0xFFDCD6B2: return "Cornsilk";
-        case 0xFFC6BC89: return "Macadamia";
-     /* case 0xFFF8E498: return "Yellow Plumeria";    TODO: duplicate case value */
-        case 0xFFF8DE6E: return "Maize";
-        case 0xFFFADA63: return "Dried Banana";
-        case 0xFFFFCB4F: return "Butternut";
-        case 0xFFFFA100: return "Orange Meringue";
-        case 0xFFFFB612: return "September Sunset";
-        case 0xFFFFB652: return "Orange Cream";
-        case 0xFFFFBC3D: return "Cantaloupe";
-        case 0xFFCE8E00: return "Old Gold";
-        case 0xFF9D5324: return "Auburn";
-        case 0xFFE98300: return "Citrus Burst";
-        case 0xFFFF7000: return "Orange Slice";
-        case 0xFFE37222: return "Fiery Sunset";
-        case 0xFFFB4F14: return "Hunter Orange";
-        case 0xFFDD4814: return "Fall Harvest";
-        case 0xFFCD202C: return "Candy Apple";
-        case 0xFFC30014: return "Christmas Red";
-        case 0xFFA70232: return "Pomegranate";
-        case 0xFF882332: return "Rummy Raisin";
-        case 0xFFA51100: return "Cardinal Red";
-        case 0xFF9E3039: return "Rusty Red";
-        case 0xFF783014: return "Redwood";
-        case 0xFFD55C19: return "Carrot";
-        case 0xFFAA272F: return "Paprika";
-        case 0xFF5F3327: return "Cherrywood";
-        case 0xFF5D3526: return "Burnt Sienna";
-        case 0xFF592C35: return "Merlot";
-        case 0xFF6A1A41: return "Loganberry";
-        case 0xFF6E2714: return "Cranberry";
-        case 0xFF662046: return "Mulberry";
-        case 0xFF85003C: return "Magenta";
-        case 0xFF641F14: return "Raspberry";
-        case 0xFFFF818D: return "Salmon";
-        case 0xFFFFA48A: return "Georgia Peach";
-        case 0xFFFFB0B7: return "Rose Sunset";
-        case 0xFFF3789B: return "Bubblegum Pink";
-        case 0xFFDB4D69: return "Carnation";
-        case 0xFF91004B: return "Very Berry";
-        case 0xFF82240C: return "Raspberry Red";
-        case 0xFFF54359: return "Dark Salmon";
-        case 0xFFF4587A: return "Apricot Dream";
-        case 0xFFFF8B7C: return "Coral Reef";
-        case 0xFFFFC19C: return "Frosted Peach";
-        case 0xFFFF8F70: return "Tangerine";
-        case 0xFFFF6D42: return "Dark Mango";
-        case 0xFFFFA02F: return "Marigold";
-        case 0xFFECC182: return "Spun Silk";
-        case 0xFFFBCE92: return "Whipped Papaya";
-        case 0xFFFDC480: return "Baby Peach";
-        case 0xFFFFC2A2: return "Pink Pearl";
-        case 0xFFEFC5CE: return "Peaches 'n Cream";
-        case 0xFFEFBE9C: return "Peach Pastel";
-        case 0xFF774A39: return "Old Penny";
-        case 0xFFB26F7E: return "Dusty Rose";
-        case 0xFFD490A8: return "Winter Rose";
-        case 0xFFF6A3BB: return "Valentine Pink";
-        case 0xFFFFB7AE: return "Petal Peach";
-        case 0xFFEFD6DB: return "Soft Petal";
-        case 0xFF920075: return "Fuchsia";
-        case 0xFFF375C6: return "Pink Kiss";
-        case 0xFFF3BBCE: return "Baby Pink";
-        case 0xFFF1DBDF: return "Whisper Pink";
-        case 0xFFF3C9D3: return "Gentle Blush";
-        case 0xFFF4B2C1: return "English Rose";
-        case 0xFFF39EBC: return "Sweet Pea";
-        case 0xFFF77AB4: return "Rosy Blush";
-        case 0xFFD71F85: return "Passion Pink";
-        case 0xFF772059: return "Mulled Wine";
-        case 0xFFC50084: return "Primrose";
-        case 0xFFA1006B: return "Azalea";
-        case 0xFFD1D4D3: return "Snowflake";
-        case 0xFFCAD1E7: return "Moonlight";
-        case 0xFF9DABE2: return "Tulip";
-        case 0xFF8884D5: return "Purple Iris";
-        case 0xFF1A2155: return "Grape";
-        case 0xFF6459C4: return "Moon Shadow";
-        case 0xFF212492: return "Electric Purple";
-        case 0xFF411244: return "Indigo";
-        case 0xFF3B0083: return "Royal Purple";
-        case 0xFF151C54: return "Eggplant";
-        case 0xFF490E6F: return "Dark Purple";
-        case 0xFF57068C: return "Pure Purple";
-        case 0xFFDCC7DF: return "Pale Orchid";
-        case 0xFFC2ACBE: return "Dusty Mauve";
-        case 0xFFDC9DDD: return "Orchid";
-        case 0xFFB382C7: return "Heather";
-        case 0xFF9C5FB5: return "Lavender";
-        case 0xFF4B08A1: return "Soft Grape";
-        case 0xFFC1AFE5: return "Freesia";
-        case 0xFFC5B9E3: return "Lilac";
-        case 0xFF6E2C6B: return "Peony";
-        case 0xFF7D0063: return "Dark Fuschia";
-        case 0xFF752864: return "Grape Jelly";
-        case 0xFF55517B: return "Deep Orchid";
-        case 0xFF5C7F92: return "Misty Blue Gray";
-        case 0xFFAFADC3: return "Iron Ore";
-        case 0xFFD8AAB3: return "Light Mauve";
-        case 0xFF89687C: return "Dark Mauve";
-        case 0xFF644459: return "Wild Plum";
-        case 0xFF4B306A: return "Huckleberry";
-    }
-
-    return "";
-}
-
-int getNum_Isacord_Polyester(unsigned int color)
+    0, 281, 155, 237, 234, 231, 238, 242, 236, 246, 209, 271, 235, 140, 213, 269, 264, 241, 243, 274, 265, 254, 276,
+    267, 222, 262, 261, 220, 253, 217, 199, 132, 159, 153, 188, 116, 142, 216, 191, 249, 247, 275, 224, 226, 233, 240,
+    251, 259, 239, 250, 227, 223, 200, 278, 193, 172, 184, 204, 126, 173, 248, 166, 218, 189, 154, 206, 161, 202, 195,
+    169, 192, 165, 136, 104, 123, 81, 157, 113, 79, 49, 74, 13, 47, 111, 61, 84, 55, 51, 158, 112, 73, 143, 119, 58,
+    41, 27, 194, 99, 207, 187, 175, 101, 135, 43, 24, 30, 33, 37, 31, 22, 54, 14, 16, 17, 64, 144, 68, 67, 208, 212,
+    128, 77, 130, 59, 147, 72, 62, 82, 71, 86, 107, 83, 176, 160, 87, 108, 163, 80, 171, 221, 103, 177, 125, 149, 146,
+    164, 156, 197, 203, 183, 230, 168, 211, 134, 92, 91, 129, 96, 105, 100, 78, 245, 117, 167, 127, 205, 263, 277,
+    225, 229, 228, 179, 181, 139, 39, 120, 36, 90, 178, 32, 29, 20, 28, 42, 15, 185, 138, 69, 102, 145, 162, 137, 18,
+    85, 23, 26, 19, 95, 25, 1, 11, 12, 57, 8, 5, 44, 133, 150, 53, 50, 60, 93, 66, 170, 148, 106, 121, 215, 214, 182,
+    114, 180, 190, 56, 124, 244, 252, 256, 257, 210, 273, 272, 268, 118, 151, 201, 97, 115, 131, 174, 122, 9, 7, 141,
+    89, 70, 94, 198, 38, 48, 52, 98, 75, 45, 21, 35, 152, 110, 10, 34, 40, 4, 109, 6, 2, 3, 65, 46, 76, 63, 186, 219,
+    196, 88, 279, 280, 270, 266, 260, 232, 258, 255
+};
+
+static const ThreadColor threadColors_Isacord_Polyester[] =
 {
-    switch(color)
-    {
-        case 0xFFFFFFFF: return   10;
-     /* case 0xFFFFFFFF: return   15;    TODO: duplicate case value */
-     /* case 0xFFFFFFFF: return   17;    TODO: duplicate case value */
-        case 0xFF000000: return   20;
-        case 0xFFFFFDED: return  101;
-     /* case 0xFF7D7D7D: break;          NOTE: N/A COLOR */
-     /* case 0xFF515B61: break;          NOTE: N/A COLOR */
-        case 0xFF6D757B: return  108;
-     /* case 0xFFACACAC: break;          NOTE: N/A COLOR */
-        case 0xFF515B61: return  111;
-        case 0xFF5D5D5D: return  112;
-        case 0xFFCFCFCF: return  124;
-        case 0xFFA1A9B4: return  131;
-        case 0xFF192024: return  132;
-     /* case 0xFF6D757B: break;          NOTE: N/A COLOR */
-        case 0xFF9EA5AA: return  142;
-        case 0xFFCFD1D5: return  145;
-        case 0xFFC6BDB4: return  150;
-        case 0xFFD5C4B3: return  151;
-        case 0xFF7C8283: return  152;
-     /* case 0xFF898F94: break;          NOTE: N/A COLOR */
-        case 0xFFFEF5F0: return  180;
-        case 0xFFE9D7D9: return  182;
-        case 0xFFEBE3DD: return  184;
-        case 0xFFE0DA5F: return  221;
-        case 0xFFBFBA28: return  232;
-     /* case 0xFFECE9C1: break;          NOTE: N/A COLOR */
-        case 0xFFFAF6CC: return  250;
-     /* case 0xFFECE7A5: break;          NOTE: N/A COLOR */
-     /* case 0xFFECEADB: break;          NOTE: N/A COLOR */
-        case 0xFFF9F8E8: return  270;
-        case 0xFFFDF76C: return  310;
-        case 0xFFF5D300: return  311;
-        case 0xFF797E24: return  345;
-        case 0xFFB0AA76: return  352;
-        case 0xFF898F2B: return  442;
-        case 0xFF98996D: return  453;
-     /* case 0xFF6E772E: break;          NOTE: N/A COLOR */
-        case 0xFF6B7E6F: return  463;
-        case 0xFF3E4F34: return  465;
-        case 0xFFEDEF05: return  501;
-     /* case 0xFFFAF6CC: break;          NOTE: N/A COLOR */
-     /* case 0xFFF5D300: return  506;    TODO: duplicate case value */
-     /* case 0xFFFFFBD1: break;          NOTE: N/A COLOR */
-        case 0xFFFDE896: return  520;
-        case 0xFFD7CE8A: return  532;
-        case 0xFFB18B00: return  542;
-     /* case 0xFFAA8D00: break;          NOTE: N/A COLOR */
-        case 0xFFB28F11: return  546;
-     /* case 0xFFAC9436: break;          NOTE: N/A COLOR */
-        case 0xFFB69F56: return  552;
-     /* case 0xFFF4EE8C: break;          NOTE: N/A COLOR */
-     /* case 0xFFF1EB35: break;          NOTE: N/A COLOR */
-        case 0xFFF8D73E: return  600;
-     /* case 0xFFF8D73E: return  605;    TODO: duplicate case value */
-        case 0xFFF7DC00: return  608;
-     /* case 0xFFF7CB47: break;          NOTE: N/A COLOR */
-     /* case 0xFFF7E400: break;          NOTE: N/A COLOR */
-     /* case 0xFFFDE896: break;          NOTE: N/A COLOR */
-     /* case 0xFFEEDB00: break;          NOTE: N/A COLOR */
-        case 0xFFFEF09A: return  630;
-     /* case 0xFFFDE1AF: break;          NOTE: N/A COLOR */
-     /* case 0xFFFDE896: return  640;    TODO: duplicate case value */
-        case 0xFFF5D2A6: return  651;
-        case 0xFFFEF9EA: return  660;
-        case 0xFFFAF6E7: return  670;
-        case 0xFFBEBEA8: return  672;
-        case 0xFFF7C35F: return  700;
-        case 0xFFF5CA00: return  702;
-        case 0xFFDFA200: return  704;
-        case 0xFFFCF538: return  706;
-        case 0xFFFADC59: return  713;
-        case 0xFF8C7E6A: return  722;
-     /* case 0xFF827000: break;          NOTE: N/A COLOR */
-     /* case 0xFF636254: break;          NOTE: N/A COLOR */
-        case 0xFF594900: return  747;
-        case 0xFFD6BF94: return  761;
-        case 0xFF656452: return  776;
-        case 0xFFF1AF00: return  800;
-     /* case 0xFFF3C200: break;          NOTE: N/A COLOR */
-        case 0xFFF5BA5D: return  811;
-        case 0xFFE1A23E: return  821;
-        case 0xFFCCAB3F: return  822;
-     /* case 0xFFDFA200: return  824;    TODO: duplicate case value */
-     /* case 0xFFF3B044: break;          NOTE: N/A COLOR */
-        case 0xFFD0A44F: return  832;
-        case 0xFFCD944A: return  842;
-        case 0xFFE3BC61: return  851;
-        case 0xFF947C4A: return  853;
-        case 0xFFCBBFA2: return  861;
-        case 0xFFA5866A: return  862;
-     /* case 0xFF001F48: break;          NOTE: N/A COLOR */
-        case 0xFFEBE7DD: return  870;
-        case 0xFF9FA086: return  873;
-        case 0xFF9A897B: return  874;
-     /* case 0xFFEE9C00: break;          NOTE: N/A COLOR */
-        case 0xFFF3B259: return  904;
-        case 0xFFCA832C: return  922;
-        case 0xFFC07314: return  931;
-        case 0xFFAC6613: return  932;
-        case 0xFF744808: return  933;
-        case 0xFFBD9565: return  934;
-     /* case 0xFF806800: break;          NOTE: N/A COLOR */
-        case 0xFFC98300: return  940;
-        case 0xFFAF7D3E: return  941;
-        case 0xFF483928: return  945;
-     /* case 0xFFFEECD9: break;          NOTE: N/A COLOR */
-        case 0xFFFEFEED: return  970;
-     /* case 0xFFDD973A: break;          NOTE: N/A COLOR */
-        case 0xFF6A4129: return 1055;
-        case 0xFFFDE2C1: return 1060;
-        case 0xFFA68A68: return 1061;
-     /* case 0xFFD76814: break;          NOTE: N/A COLOR */
-     /* case 0xFFED873F: break;          NOTE: N/A COLOR */
-     /* case 0xFFEC870E: break;          NOTE: N/A COLOR */
-        case 0xFFED9206: return 1102;
-        case 0xFFEE9C00: return 1106;
-     /* case 0xFFC45331: break;          NOTE: N/A COLOR */
-        case 0xFFEE8751: return 1114;
-        case 0xFFA35214: return 1115;
-        case 0xFFF8C000: return 1120;
-        case 0xFFB7976B: return 1123;
-        case 0xFF9D5A21: return 1134;
-        case 0xFFF3D8A8: return 1140;
-        case 0xFFFACFAE: return 1141;
-        case 0xFF7A4427: return 1154;
-        case 0xFFDFC8AB: return 1172;
-        case 0xFFE89763: return 1211;
-        case 0xFFF1A236: return 1220;
-     /* case 0xFF3D2723: break;          NOTE: N/A COLOR */
-        case 0xFFE5571D: return 1300;
-        case 0xFFD9674C: return 1301;
-     /* case 0xFFE8643C: break;          NOTE: N/A COLOR */
-        case 0xFFE4501E: return 1304;
-        case 0xFFEA7134: return 1305;
-        case 0xFFE12A23: return 1306;
-        case 0xFFC14817: return 1311;
-        case 0xFFC45331: return 1312;
-     /* case 0xFFD7623E: break;          NOTE: N/A COLOR */
-     /* case 0xFFED7C56: break;          NOTE: N/A COLOR */
-     /* case 0xFF92291B: break;          NOTE: N/A COLOR */
-        case 0xFFD5815E: return 1332;
-        case 0xFFBB3D2E: return 1334;
-        case 0xFFBE2D1A: return 1335;
-        case 0xFF5F1B23: return 1342;
-        case 0xFF7A3441: return 1346;
-     /* case 0xFF84291D: break;          NOTE: N/A COLOR */
-        case 0xFFFBBF95: return 1351;
-        case 0xFFF4A773: return 1352;
-        case 0xFF693920: return 1355;
-     /* case 0xFFF9C6A1: break;          NOTE: N/A COLOR */
-        case 0xFFF9C598: return 1362;
-        case 0xFF432731: return 1366;
-        case 0xFF464537: return 1375;
-     /* case 0xFF4D2E18: break;          NOTE: N/A COLOR */
-     /* case 0xFFD64F42: break;          NOTE: N/A COLOR */
-        case 0xFFF4A782: return 1430;
-        case 0xFFE22D2A: return 1501;
-        case 0xFFA93121: return 1514;
-        case 0xFFEC7168: return 1521;
-        case 0xFFF6B08E: return 1532;
-        case 0xFFF9C5B9: return 1551;
-        case 0xFF806A61: return 1565;
-     /* case 0xFF464537: break;          NOTE: N/A COLOR */
-        case 0xFFE36C63: return 1600;
-     /* case 0xFFF9C7B9: break;          NOTE: N/A COLOR */
-        case 0xFFE44733: return 1701;
-        case 0xFFDF0032: return 1703;
-        case 0xFFE0003D: return 1704;
-     /* case 0xFFE44733: break;          NOTE: N/A COLOR */
-        case 0xFFCF0040: return 1725;
-     /* case 0xFFDB686B: break;          NOTE: N/A COLOR */
-        case 0xFFF1CDCE: return 1755;
-        case 0xFFE9C9BD: return 1760;
-        case 0xFFE8C0B8: return 1761;
-        case 0xFFE00046: return 1800;
-     /* case 0xFFE43449: break;          NOTE: N/A COLOR */
-        case 0xFFD6445D: return 1805;
-        case 0xFFF49E95: return 1840;
-     /* case 0xFFB76663: break;          NOTE: N/A COLOR */
-     /* case 0xFFE36C63: break;          NOTE: N/A COLOR */
-     /* case 0xFFF0887D: break;          NOTE: N/A COLOR */
-     /* case 0xFFFAC7C1: break;          NOTE: N/A COLOR */
-        case 0xFFFCDAD5: return 1860;
-     /* case 0xFFFDE3D3: break;          NOTE: N/A COLOR */
-        case 0xFF636254: return 1874;
-        case 0xFF394535: return 1876;
-        case 0xFFE10057: return 1900;
-        case 0xFFBD0041: return 1902;
-        case 0xFFC00343: return 1903;
-        case 0xFFA9023A: return 1904;
-     /* case 0xFF960018: break;          NOTE: N/A COLOR */
-        case 0xFFBE004F: return 1906;
-        case 0xFF910230: return 1911;
-        case 0xFF86023E: return 1912;
-        case 0xFF9A0C3B: return 1913;
-     /* case 0xFFA41F39: break;          NOTE: N/A COLOR */
-        case 0xFFA33050: return 1921;
-        case 0xFFF28DA6: return 1940;
-        case 0xFFCE427A: return 1950;
-     /* case 0xFFF2B9BE: break;          NOTE: N/A COLOR */
-        case 0xFF959595: return 1972;
-        case 0xFFA33145: return 2011;
-        case 0xFF9F454C: return 2022;
-        case 0xFFC7979B: return 2051;
-     /* case 0xFFD18D89: break;          NOTE: N/A COLOR */
-     /* case 0xFF970038: break;          NOTE: N/A COLOR */
-        case 0xFF9F003F: return 2101;
-        case 0xFF78093F: return 2113;
-        case 0xFF6D0627: return 2115;
-        case 0xFF432732: return 2123;
-        case 0xFFE6778B: return 2152;
-        case 0xFFDF8390: return 2153;
-        case 0xFFF9BFC0: return 2155;
-        case 0xFFFBD1D6: return 2160;
-     /* case 0xFFFDE3DB: break;          NOTE: N/A COLOR */
-        case 0xFFD8D5D0: return 2166;
-     /* case 0xFFFEEDE2: break;          NOTE: N/A COLOR */
-        case 0xFFF7DED6: return 2170;
-        case 0xFFF7DEDE: return 2171;
-     /* case 0xFFFCD9C4: break;          NOTE: N/A COLOR */
-        case 0xFFE8418C: return 2220;
-        case 0xFF8C0C4A: return 2222;
-        case 0xFF883A40: return 2224;
-        case 0xFFEE71A1: return 2230;
-        case 0xFFA95A68: return 2241;
-        case 0xFFFAC8D3: return 2250;
-        case 0xFFD3007E: return 2300;
-     /* case 0xFFBF006A: break;          NOTE: N/A COLOR */
-        case 0xFFD20067: return 2320;
-     /* case 0xFF780C38: break;          NOTE: N/A COLOR */
-        case 0xFF651533: return 2333;
-        case 0xFF3A212B: return 2336;
-     /* case 0xFFF2E0DC: break;          NOTE: N/A COLOR */
-        case 0xFFFDE5EC: return 2363;
-        case 0xFF970059: return 2500;
-     /* case 0xFF8B1771: break;          NOTE: N/A COLOR */
-        case 0xFFAA4381: return 2504;
-     /* case 0xFFB40073: break;          NOTE: N/A COLOR */
-        case 0xFF820052: return 2506;
-     /* case 0xFFD63C81: break;          NOTE: N/A COLOR */
-        case 0xFFE20078: return 2520;
-        case 0xFFBF006A: return 2521;
-     /* case 0xFFEE71A1: break;          NOTE: N/A COLOR */
-        case 0xFFF189AF: return 2550;
-     /* case 0xFFF7B4CA: break;          NOTE: N/A COLOR */
-        case 0xFFF7B4CA: return 2560;
-        case 0xFF494949: return 2576;
-     /* case 0xFF394248: break;          NOTE: N/A COLOR */
-        case 0xFF893480: return 2600;
-        case 0xFF6C0051: return 2611;
-     /* case 0xFFCD73A6: break;          NOTE: N/A COLOR */
-        case 0xFFD994B9: return 2640;
-     /* case 0xFFDDBDD5: break;          NOTE: N/A COLOR */
-        case 0xFFE6B7CF: return 2650;
-        case 0xFFECD2DE: return 2655;
-        case 0xFF606D8C: return 2674;
-     /* case 0xFF646A6E: break;          NOTE: N/A COLOR */
-        case 0xFF610051: return 2711;
-     /* case 0xFF704191: break;          NOTE: N/A COLOR */
-        case 0xFF490251: return 2715;
-        case 0xFF89347F: return 2720;
-     /* case 0xFF2F206F: break;          NOTE: N/A COLOR */
-        case 0xFFC690A1: return 2764;
-        case 0xFF6F067B: return 2810;
-     /* case 0xFFAD85B1: break;          NOTE: N/A COLOR */
-        case 0xFFA974AB: return 2830;
-        case 0xFF4C0F7B: return 2900;
-        case 0xFF664090: return 2905;
-        case 0xFF83589D: return 2910;
-        case 0xFF8C6DAA: return 2920;
-        case 0xFFC9B5D4: return 3040;
-        case 0xFFC790BA: return 3045;
-        case 0xFF707070: return 3062;
-        case 0xFF2A377E: return 3102;
-     /* case 0xFF3C1F81: break;          NOTE: N/A COLOR */
-        case 0xFF35247A: return 3110;
-        case 0xFF260751: return 3114;
-     /* case 0xFF28135B: break;          NOTE: N/A COLOR */
-     /* case 0xFF6E5DA3: break;          NOTE: N/A COLOR */
-        case 0xFF353A90: return 3210;
-        case 0xFF524A90: return 3211;
-     /* case 0xFF785FA3: break;          NOTE: N/A COLOR */
-     /* case 0xFF241757: break;          NOTE: N/A COLOR */
-        case 0xFF7D77AF: return 3241;
-        case 0xFF9083A3: return 3251;
-     /* case 0xFFB2AABD: break;          NOTE: N/A COLOR */
-     /* case 0xFF392D88: break;          NOTE: N/A COLOR */
-     /* case 0xFF5661A8: break;          NOTE: N/A COLOR */
-     /* case 0xFF323887: break;          NOTE: N/A COLOR */
-        case 0xFF14214E: return 3323;
-     /* case 0xFF3A2885: break;          NOTE: N/A COLOR */
-        case 0xFF7F8BC2: return 3331;
-        case 0xFF1B3C78: return 3333;
-        case 0xFF2E4B9B: return 3335;
-     /* case 0xFFB9BDD9: break;          NOTE: N/A COLOR */
-        case 0xFF11263C: return 3344;
-        case 0xFF202A65: return 3353;
-        case 0xFF171B4A: return 3355;
-     /* case 0xFF959ACA: break;          NOTE: N/A COLOR */
-     /* case 0xFF6A76B5: break;          NOTE: N/A COLOR */
-     /* case 0xFF11263C: break;          NOTE: N/A COLOR */
-        case 0xFF002232: return 3444;
-        case 0xFF2D4491: return 3522;
-        case 0xFF261257: return 3536;
-     /* case 0xFF53428A: break;          NOTE: N/A COLOR */
-        case 0xFF3A2885: return 3541;
-        case 0xFF233B7D: return 3543;
-        case 0xFF273C82: return 3544;
-        case 0xFF272651: return 3554;
-        case 0xFF28438C: return 3600;
-        case 0xFF243A7D: return 3611;
-        case 0xFF4055A1: return 3612;
-        case 0xFF1A4C8D: return 3622;
-     /* case 0xFF1E569F: break;          NOTE: N/A COLOR */
-        case 0xFF92B1DC: return 3640;
-        case 0xFF648DC7: return 3641;
-        case 0xFFD0DEEE: return 3650;
-        case 0xFFC8D6ED: return 3652;
-     /* case 0xFFEAF0F9: break;          NOTE: N/A COLOR */
-        case 0xFF00507F: return 3732;
-        case 0xFF12253C: return 3743;
-        case 0xFFB7D1E3: return 3750;
-     /* case 0xFFD0DEEE: break;          NOTE: N/A COLOR */
-        case 0xFFAFC9E5: return 3761;
-        case 0xFFCED2D1: return 3770;
-        case 0xFF3D6AA1: return 3810;
-        case 0xFF7BA2D3: return 3815;
-        case 0xFF91B9E2: return 3820;
-     /* case 0xFF00779E: break;          NOTE: N/A COLOR */
-        case 0xFFB4CEEB: return 3840;
-        case 0xFF507193: return 3842;
-     /* case 0xFFD5E3F4: break;          NOTE: N/A COLOR */
-     /* case 0xFF9AB8D3: break;          NOTE: N/A COLOR */
-        case 0xFF007EBA: return 3900;
-        case 0xFF0082C4: return 3901;
-        case 0xFF006CA5: return 3902;
-        case 0xFF4ABDF0: return 3910;
-        case 0xFF86AACA: return 3951;
-     /* case 0xFF485E8A: break;          NOTE: N/A COLOR */
-        case 0xFF697698: return 3953;
-     /* case 0xFFC5E1F3: break;          NOTE: N/A COLOR */
-        case 0xFFA6D8F6: return 3962;
-        case 0xFFE1E1E1: return 3971;
-        case 0xFF0093B9: return 4010;
-     /* case 0xFF006587: break;          NOTE: N/A COLOR */
-     /* case 0xFF87C7EA: break;          NOTE: N/A COLOR */
-        case 0xFF507793: return 4032;
-        case 0xFF265674: return 4033;
-     /* case 0xFF9ED4E6: break;          NOTE: N/A COLOR */
-        case 0xFFEAF0F9: return 4071;
-        case 0xFF838689: return 4073;
-     /* case 0xFF0096C1: break;          NOTE: N/A COLOR */
-        case 0xFF2DB0CF: return 4101;
-        case 0xFF0095C6: return 4103;
-     /* case 0xFF0081AA: break;          NOTE: N/A COLOR */
-        case 0xFF00A4D9: return 4111;
-        case 0xFF00A9C9: return 4113;
-        case 0xFF0082AD: return 4116;
-     /* case 0xFF5DBFD2: break;          NOTE: N/A COLOR */
-        case 0xFF00405D: return 4133;
-     /* case 0xFF192024: return 4174;    TODO: duplicate case value */
-     /* case 0xFF192024: break;          NOTE: N/A COLOR */
-        case 0xFF4FB4CB: return 4220;
-        case 0xFF8DCEE4: return 4230;
-     /* case 0xFF2DB0CF: break;          NOTE: N/A COLOR */
-     /* case 0xFF006587: break;          NOTE: N/A COLOR */
-        case 0xFF8DCDDB: return 4240;
-        case 0xFFD5EBF2: return 4250;
-     /* case 0xFF007389: break;          NOTE: N/A COLOR */
-        case 0xFF007B8D: return 4410;
-     /* case 0xFF00B2CA: break;          NOTE: N/A COLOR */
-        case 0xFF0091A5: return 4421;
-        case 0xFF007D8C: return 4423;
-        case 0xFF007986: return 4425;
-        case 0xFF5FBFD1: return 4430;
-     /* case 0xFF004250: break;          NOTE: N/A COLOR */
-     /* case 0xFF8DCEE4: break;          NOTE: N/A COLOR */
-        case 0xFF006981: return 4442;
-        case 0xFF007F92: return 4452;
-     /* case 0xFF008192: break;          NOTE: N/A COLOR */
-     /* case 0xFF007079: break;          NOTE: N/A COLOR */
-        case 0xFF002F38: return 4515;
-     /* case 0xFF00646A: break;          NOTE: N/A COLOR */
-        case 0xFF007389: return 4531;
-     /* case 0xFF007B8D: return 4610;    TODO: duplicate case value */
-        case 0xFF00A3A0: return 4620;
-        case 0xFF0B7F85: return 4625;
-        case 0xFF005B63: return 4643;
-        case 0xFF234544: return 4644;
-     /* case 0xFF8CCDD3: break;          NOTE: N/A COLOR */
-     /* case 0xFF006F73: break;          NOTE: N/A COLOR */
-     /* case 0xFF005B63: return 5005;    TODO: duplicate case value */
-        case 0xFF00A6AD: return 5010;
-     /* case 0xFF49BAC0: break;          NOTE: N/A COLOR */
-     /* case 0xFFCFDDE0: break;          NOTE: N/A COLOR */
-        case 0xFFB4DCD8: return 5050;
-        case 0xFF00876E: return 5100;
-        case 0xFF009084: return 5101;
-     /* case 0xFF00B1AE: break;          NOTE: N/A COLOR */
-        case 0xFF48BAB7: return 5115;
-        case 0xFF00AF8C: return 5210;
-        case 0xFF8CCCC2: return 5220;
-        case 0xFF47B9AE: return 5230;
-        case 0xFF197E6D: return 5233;
-     /* case 0xFF8CCCC2: break;          NOTE: N/A COLOR */
-     /* case 0xFF005B63: break;          NOTE: N/A COLOR */
-        case 0xFF006E42: return 5324;
-        case 0xFF004D3D: return 5326;
-     /* case 0xFF002F38: return 5335;    TODO: duplicate case value */
-        case 0xFF002D1F: return 5374;
-     /* case 0xFF002F38: break;          NOTE: N/A COLOR */
-        case 0xFF008663: return 5411;
-        case 0xFF006B4E: return 5415;
-     /* case 0xFF008663: return 5422;    TODO: duplicate case value */
-     /* case 0xFF006B56: break;          NOTE: N/A COLOR */
-     /* case 0xFF008879: break;          NOTE: N/A COLOR */
-     /* case 0xFFDBE9E5: break;          NOTE: N/A COLOR */
-     /* case 0xFF6AC093: break;          NOTE: N/A COLOR */
-        case 0xFF52BA84: return 5500;
-        case 0xFF14A363: return 5510;
-        case 0xFF007848: return 5513;
-     /* case 0xFF008663: return 5515;    TODO: duplicate case value */
-        case 0xFF52A04F: return 5531;
-     /* case 0xFF6EA293: break;          NOTE: N/A COLOR */
-        case 0xFF94ADA1: return 5552;
-        case 0xFF103828: return 5555;
-     /* case 0xFF63BE5F: break;          NOTE: N/A COLOR */
-        case 0xFF85C875: return 5610;
-     /* case 0xFF2CB431: break;          NOTE: N/A COLOR */
-        case 0xFF14B26D: return 5613;
-     /* case 0xFF40B780: break;          NOTE: N/A COLOR */
-        case 0xFF1A781E: return 5633;
-        case 0xFF157436: return 5643;
-        case 0xFFC9E3C5: return 5650;
-        case 0xFF6B9181: return 5664;
-     /* case 0xFF3A6D57: break;          NOTE: N/A COLOR */
-     /* case 0xFF103828: break;          NOTE: N/A COLOR */
-     /* case 0xFF02140C: break;          NOTE: N/A COLOR */
-        case 0xFFA5C278: return 5822;
-     /* case 0xFFB4D383: break;          NOTE: N/A COLOR */
-        case 0xFF70953F: return 5833;
-     /* case 0xFFA2D289: break;          NOTE: N/A COLOR */
-        case 0xFF273014: return 5866;
-        case 0xFF81C750: return 5912;
-        case 0xFF457021: return 5933;
-        case 0xFF506702: return 5934;
-        case 0xFFBBDB41: return 5940;
-        case 0xFF003518: return 5944;
-        case 0xFFE3EB00: return 6010;
-        case 0xFFBED782: return 6051;
-     /* case 0xFF2D3B01: break;          NOTE: N/A COLOR */
-     /* case 0xFFDCDDD1: break;          NOTE: N/A COLOR */
-        case 0xFF919600: return 6133;
-        case 0xFF484601: return 6156;
-    }
-
-    return -1;
-}
+    { 0xFF000000,   20, "" },
+    { 0xFF002232, 3444, "" },
+    { 0xFF002D1F, 5374, "" },
+    { 0xFF002F38, 4515, "" },
+    { 0xFF002F38, 5335, "" },
+    { 0xFF003518, 5944, "" },
+    { 0xFF00405D, 4133, "" },
+    { 0xFF004D3D, 5326, "" },
+    { 0xFF00507F, 3732, "" },
+    { 0xFF005B63, 4643, "" },
+    { 0xFF005B63, 5005, "" },
+    { 0xFF006981, 4442, "" },
+    { 0xFF006B4E, 5415, "" },
+    { 0xFF006CA5, 3902, "" },
+    { 0xFF006E42, 5324, "" },
+    { 0xFF007389, 4531, "" },
+    { 0xFF007848, 5513, "" },
+    { 0xFF007986, 4425, "" },
+    { 0xFF007B8D, 4410, "" },
+    { 0xFF007B8D, 4610, "" },
+    { 0xFF007D8C, 4423, "" },
+    { 0xFF007EBA, 3900, "" },
+    { 0xFF007F92, 4452, "" },
+    { 0xFF0082AD, 4116, "" },
+    { 0xFF0082C4, 3901, "" },
+    { 0xFF008663, 5411, "" },
+    { 0xFF008663, 5422, "" },
+    { 0xFF008663, 5515, "" },
+    { 0xFF00876E, 5100, "" },
+    { 0xFF009084, 5101, "" },
+    { 0xFF0091A5, 4421, "" },
+    { 0xFF0093B9, 4010, "" },
+    { 0xFF0095C6, 4103, "" },
+    { 0xFF00A3A0, 4620, "" },
+    { 0xFF00A4D9, 4111, "" },
+    { 0xFF00A6AD, 5010, "" },
+    { 0xFF00A9C9, 4113, "" },
+    { 0xFF00AF8C, 5210, "" },
+    { 0xFF0B7F85, 4625, "" },
+    { 0xFF103828, 5555, "" },
+    { 0xFF11263C, 3344, "" },
+    { 0xFF12253C, 3743, "" },
+    { 0xFF14214E, 3323, "" },
+    { 0xFF14A363, 5510, "" },
+    { 0xFF14B26D, 5613, "" },
+    { 0xFF157436, 5643, "" },
+    { 0xFF171B4A, 3355, "" },
+    { 0xFF192024,  132, "" },
+    { 0xFF192024, 4174, "" },
+    { 0xFF197E6D, 5233, "" },
+    { 0xFF1A4C8D, 3622, "" },
+    { 0xFF1A781E, 5633, "" },
+    { 0xFF1B3C78, 3333, "" },
+    { 0xFF202A65, 3353, "" },
+    { 0xFF233B7D, 3543, "" },
+    { 0xFF234544, 4644, "" },
+    { 0xFF243A7D, 3611, "" },
+    { 0xFF260751, 3114, "" },
+    { 0xFF261257, 3536, "" },
+    { 0xFF265674, 4033, "" },
+    { 0xFF272651, 3554, "" },
+    { 0xFF273014, 5866, "" },
+    { 0xFF273C82, 3544, "" },
+    { 0xFF28438C, 3600, "" },
+    { 0xFF2A377E, 3102, "" },
+    { 0xFF2D4491, 3522, "" },
+    { 0xFF2DB0CF, 4101, "" },
+    { 0xFF2E4B9B, 3335, "" },
+    { 0xFF35247A, 3110, "" },
+    { 0xFF353A90, 3210, "" },
+    { 0xFF394535, 1876, "" },
+    { 0xFF3A212B, 2336, "" },
+    { 0xFF3A2885, 3541, "" },
+    { 0xFF3D6AA1, 3810, "" },
+    { 0xFF3E4F34,  465, "" },
+    { 0xFF4055A1, 3612, "" },
+    { 0xFF432731, 1366, "" },
+    { 0xFF432732, 2123, "" },
+    { 0xFF457021, 5933, "" },
+    { 0xFF464537, 1375, "" },
+    { 0xFF47B9AE, 5230, "" },
+    { 0xFF483928,  945, "" },
+    { 0xFF484601, 6156, "" },
+    { 0xFF48BAB7, 5115, "" },
+    { 0xFF490251, 2715, "" },
+    { 0xFF494949, 2576, "" },
+    { 0xFF4ABDF0, 3910, "" },
+    { 0xFF4C0F7B, 2900, "" },
+    { 0xFF4FB4CB, 4220, "" },
+    { 0xFF506702, 5934, "" },
+    { 0xFF507193, 3842, "" },
+    { 0xFF507793, 4032, "" },
+    { 0xFF515B61,  111, "" },
+    { 0xFF524A90, 3211, "" },
+    { 0xFF52A04F, 5531, "" },
+    { 0xFF52BA84, 5500, "" },
+    { 0xFF594900,  747, "" },
+    { 0xFF5D5D5D,  112, "" },
+    { 0xFF5F1B23, 1342, "" },
+    { 0xFF5FBFD1, 4430, "" },
+    { 0xFF606D8C, 2674, "" },
+    { 0xFF610051, 2711, "" },
+    { 0xFF636254, 1874, "" },
+    { 0xFF648DC7, 3641, "" },
+    { 0xFF651533, 2333, "" },
+    { 0xFF656452,  776, "" },
+    { 0xFF664090, 2905, "" },
+    { 0xFF693920, 1355, "" },
+    { 0xFF697698, 3953, "" },
+    { 0xFF6A4129, 1055, "" },
+    { 0xFF6B7E6F,  463, "" },
+    { 0xFF6B9181, 5664, "" },
+    { 0xFF6C0051, 2611, "" },
+    { 0xFF6D0627, 2115, "" },
+    { 0xFF6D757B,  108, "" },
+    { 0xFF6F067B, 2810, "" },
+    { 0xFF707070, 3062, "" },
+    { 0xFF70953F, 5833, "" },
+    { 0xFF744808,  933, "" },
+    { 0xFF78093F, 2113, "" },
+    { 0xFF797E24,  345, "" },
+    { 0xFF7A3441, 1346, "" },
+    { 0xFF7A4427, 1154, "" },
+    { 0xFF7BA2D3, 3815, "" },
+    { 0xFF7C8283,  152, "" },
+    { 0xFF7D77AF, 3241, "" },
+    { 0xFF7F8BC2, 3331, "" },
+    { 0xFF806A61, 1565, "" },
+    { 0xFF81C750, 5912, "" },
+    { 0xFF820052, 2506, "" },
+    { 0xFF83589D, 2910, "" },
+    { 0xFF838689, 4073, "" },
+    { 0xFF85C875, 5610, "" },
+    { 0xFF86023E, 1912, "" },
+    { 0xFF86AACA, 3951, "" },
+    { 0xFF883A40, 2224, "" },
+    { 0xFF89347F, 2720, "" },
+    { 0xFF893480, 2600, "" },
+    { 0xFF898F2B,  442, "" },
+    { 0xFF8C0C4A, 2222, "" },
+    { 0xFF8C6DAA, 2920, "" },
+    { 0xFF8C7E6A,  722, "" },
+    { 0xFF8CCCC2, 5220, "" },
+    { 0xFF8DCDDB, 4240, "" },
+    { 0xFF8DCEE4, 4230, "" },
+    { 0xFF9083A3, 3251, "" },
+    { 0xFF910230, 1911, "" },
+    { 0xFF919600, 6133, "" },
+    { 0xFF91B9E2, 3820, "" },
+    { 0xFF92B1DC, 3640, "" },
+    { 0xFF947C4A,  853, "" },
+    { 0xFF94ADA1, 5552, "" },
+    { 0xFF959595, 1972, "" },
+    { 0xFF970059, 2500, "" },
+    { 0xFF98996D,  453, "" },
+    { 0xFF9A0C3B, 1913, "" },
+    { 0xFF9A897B,  874, "" },
+    { 0xFF9D5A21, 1134, "" },
+    { 0xFF9EA5AA,  142, "" },
+    { 0xFF9F003F, 2101, "" },
+    { 0xFF9F454C, 2022, "" },
+    { 0xFF9FA086,  873, "" },
+    { 0xFFA1A9B4,  131, "" },
+    { 0xFFA33050, 1921, "" },
+    { 0xFFA33145, 2011, "" },
+    { 0xFFA35214, 1115, "" },
+    { 0xFFA5866A,  862, "" },
+    { 0xFFA5C278, 5822, "" },
+    { 0xFFA68A68, 1061, "" },
+    { 0xFFA6D8F6, 3962, "" },
+    { 0xFFA9023A, 1904, "" },
+    { 0xFFA93121, 1514, "" },
+    { 0xFFA95A68, 2241, "" },
+    { 0xFFA974AB, 2830, "" },
+    { 0xFFAA4381, 2504, "" },
+    { 0xFFAC6613,  932, "" },
+    { 0xFFAF7D3E,  941, "" },
+    { 0xFFAFC9E5, 3761, "" },
+    { 0xFFB0AA76,  352, "" },
+    { 0xFFB18B00,  542, "" },
+    { 0xFFB28F11,  546, "" },
+    { 0xFFB4CEEB, 3840, "" },
+    { 0xFFB4DCD8, 5050, "" },
+    { 0xFFB69F56,  552, "" },
+    { 0xFFB7976B, 1123, "" },
+    { 0xFFB7D1E3, 3750, "" },
+    { 0xFFBB3D2E, 1334, "" },
+    { 0xFFBBDB41, 5940, "" },
+    { 0xFFBD0041, 1902, "" },
+    { 0xFFBD9565,  934, "" },
+    { 0xFFBE004F, 1906, "" },
+    { 0xFFBE2D1A, 1335, "" },
+    { 0xFFBEBEA8,  672, "" },
+    { 0xFFBED782, 6051, "" },
+    { 0xFFBF006A, 2521, "" },
+    { 0xFFBFBA28,  232, "" },
+    { 0xFFC00343, 1903, "" },
+    { 0xFFC07314,  931, "" },
+    { 0xFFC14817, 1311, "" },
+    { 0xFFC45331, 1312, "" },
+    { 0xFFC690A1, 2764, "" },
+    { 0xFFC6BDB4,  150, "" },
+    { 0xFFC790BA, 3045, "" },
+    { 0xFFC7979B, 2051, "" },
+    { 0xFFC8D6ED, 3652, "" },
+    { 0xFFC98300,  940, "" },
+    { 0xFFC9B5D4, 3040, "" },
+    { 0xFFC9E3C5, 5650, "" },
+    { 0xFFCA832C,  922, "" },
+    { 0xFFCBBFA2,  861, "" },
+    { 0xFFCCAB3F,  822, "" },
+    { 0xFFCD944A,  842, "" },
+    { 0xFFCE427A, 1950, "" },
+    { 0xFFCED2D1, 3770, "" },
+    { 0xFFCF0040, 1725, "" },
+    { 0xFFCFCFCF,  124, "" },
+    { 0xFFCFD1D5,  145, "" },
+    { 0xFFD0A44F,  832, "" },
+    { 0xFFD0DEEE, 3650, "" },
+    { 0xFFD20067, 2320, "" },
+    { 0xFFD3007E, 2300, "" },
+    { 0xFFD5815E, 1332, "" },
+    { 0xFFD5C4B3,  151, "" },
+    { 0xFFD5EBF2, 4250, "" },
+    { 0xFFD6445D, 1805, "" },
+    { 0xFFD6BF94,  761, "" },
+    { 0xFFD7CE8A,  532, "" },
+    { 0xFFD8D5D0, 2166, "" },
+    { 0xFFD9674C, 1301, "" },
+    { 0xFFD994B9, 2640, "" },
+    { 0xFFDF0032, 1703, "" },
+    { 0xFFDF8390, 2153, "" },
+    { 0xFFDFA200,  704, "" },
+    { 0xFFDFA200,  824, "" },
+    { 0xFFDFC8AB, 1172, "" },
+    { 0xFFE0003D, 1704, "" },
+    { 0xFFE00046, 1800, "" },
+    { 0xFFE0DA5F,  221, "" },
+    { 0xFFE10057, 1900, "" },
+    { 0xFFE12A23, 1306, "" },
+    { 0xFFE1A23E,  821, "" },
+    { 0xFFE1E1E1, 3971, "" },
+    { 0xFFE20078, 2520, "" },
+    { 0xFFE22D2A, 1501, "" },
+    { 0xFFE36C63, 1600, "" },
+    { 0xFFE3BC61,  851, "" },
+    { 0xFFE3EB00, 6010, "" },
+    { 0xFFE44733, 1701, "" },
+    { 0xFFE4501E, 1304, "" },
+    { 0xFFE5571D, 1300, "" },
+    { 0xFFE6778B, 2152, "" },
+    { 0xFFE6B7CF, 2650, "" },
+    { 0xFFE8418C, 2220, "" },
+    { 0xFFE89763, 1211, "" },
+    { 0xFFE8C0B8, 1761, "" },
+    { 0xFFE9C9BD, 1760, "" },
+    { 0xFFE9D7D9,  182, "" },
+    { 0xFFEA7134, 1305, "" },
+    { 0xFFEAF0F9, 4071, "" },
+    { 0xFFEBE3DD,  184, "" },
+    { 0xFFEBE7DD,  870, "" },
+    { 0xFFEC7168, 1521, "" },
+    { 0xFFECD2DE, 2655, "" },
+    { 0xFFED9206, 1102, "" },
+    { 0xFFEDEF05,  501, "" },
+    { 0xFFEE71A1, 2230, "" },
+    { 0xFFEE8751, 1114, "" },
+    { 0xFFEE9C00, 1106, "" },
+    { 0xFFF189AF, 2550, "" },
+    { 0xFFF1A236, 1220, "" },
+    { 0xFFF1AF00,  800, "" },
+    { 0xFFF1CDCE, 1755, "" },
+    { 0xFFF28DA6, 1940, "" },
+    { 0xFFF3B259,  904, "" },
+    { 0xFFF3D8A8, 1140, "" },
+    { 0xFFF49E95, 1840, "" },
+    { 0xFFF4A773, 1352, "" },
+    { 0xFFF4A782, 1430, "" },
+    { 0xFFF5BA5D,  811, "" },
+    { 0xFFF5CA00,  702, "" },
+    { 0xFFF5D2A6,  651, "" },
+    { 0xFFF5D300,  311, "" },
+    { 0xFFF5D300,  506, "" },
+    { 0xFFF6B08E, 1532, "" },
+    { 0xFFF7B4CA, 2560, "" },
+    { 0xFFF7C35F,  700, "" },
+    { 0xFFF7DC00,  608, "" },
+    { 0xFFF7DED6, 2170, "" },
+    { 0xFFF7DEDE, 2171, "" },
+    { 0xFFF8C000, 1120, "" },
+    { 0xFFF8D73E,  600, "" },
+    { 0xFFF8D73E,  605, "" },
+    { 0xFFF9BFC0, 2155, "" },
+    { 0xFFF9C598, 1362, "" },
+    { 0xFFF9C5B9, 1551, "" },
+    { 0xFFF9F8E8,  270, "" },
+    { 0xFFFAC8D3, 2250, "" },
+    { 0xFFFACFAE, 1141, "" },
+    { 0xFFFADC59,  713, "" },
+    { 0xFFFAF6CC,  250, "" },
+    { 0xFFFAF6E7,  670, "" },
+    { 0xFFFBBF95, 1351, "" },
+    { 0xFFFBD1D6, 2160, "" },
+    { 0xFFFCDAD5, 1860, "" },
+    { 0xFFFCF538,  706, "" },
+    { 0xFFFDE2C1, 1060, "" },
+    { 0xFFFDE5EC, 2363, "" },
+    { 0xFFFDE896,  520, "" },
+    { 0xFFFDE896,  640, "" },
+    { 0xFFFDF76C,  310, "" },
+    { 0xFFFEF09A,  630, "" },
+    { 0xFFFEF5F0,  180, "" },
+    { 0xFFFEF9EA,  660, "" },
+    { 0xFFFEFEED,  970, "" },
+    { 0xFFFFFDED,  101, "" },
+    { 0xFFFFFFFF,   10, "" },
+    { 0xFFFFFFFF,   15, "" },
+    { 0xFFFFFFFF,   17, "" }
+};
+
+static const short threadColorsByNumber_Isacord_Polyester[] =
+{
+    315, 316, 317, 0, 314, 114, 92, 97, 215, 162, 47, 158, 216, 201, 222, 124, 311, 256, 259, 237, 195, 299, 295, 309,
+    281, 120, 178, 138, 154, 110, 74, 264, 282, 307, 226, 179, 180, 183, 290, 291, 286, 310, 308, 280, 312, 300, 192,
+    285, 279, 232, 304, 298, 141, 96, 225, 105, 270, 278, 240, 210, 233, 217, 211, 245, 150, 209, 166, 260, 161, 156,
+    273, 208, 197, 175, 118, 189, 205, 176, 81, 313, 109, 305, 168, 263, 267, 266, 165, 289, 184, 157, 274, 297, 122,
+    234, 253, 269, 249, 228, 248, 257, 239, 198, 199, 221, 186, 191, 98, 121, 301, 276, 107, 293, 76, 79, 277, 243,
+    171, 261, 283, 294, 127, 244, 247, 230, 235, 214, 271, 255, 254, 236, 224, 275, 303, 102, 70, 238, 188, 196, 170,
+    190, 146, 133, 155, 163, 272, 212, 152, 164, 160, 203, 159, 119, 113, 77, 250, 231, 292, 302, 227, 287, 288, 252,
+    139, 135, 265, 172, 296, 220, 219, 104, 71, 306, 153, 174, 129, 242, 194, 268, 284, 85, 137, 112, 229, 251, 262,
+    100, 101, 84, 136, 200, 115, 173, 87, 106, 130, 140, 206, 202, 116, 64, 68, 57, 69, 93, 125, 145, 42, 126, 52, 67,
+    40, 53, 46, 1, 65, 58, 72, 54, 62, 60, 63, 56, 75, 50, 149, 103, 218, 204, 8, 41, 185, 177, 213, 73, 123, 148,
+    181, 90, 21, 24, 13, 86, 134, 108, 169, 241, 31, 91, 59, 258, 131, 66, 32, 34, 36, 23, 6, 48, 88, 144, 143, 223,
+    18, 30, 20, 17, 99, 11, 22, 3, 15, 19, 33, 38, 9, 55, 10, 35, 182, 28, 29, 83, 37, 142, 80, 49, 14, 7, 4, 2, 25,
+    12, 26, 95, 43, 16, 27, 94, 151, 39, 132, 44, 51, 45, 207, 111, 167, 117, 61, 128, 78, 89, 187, 5, 246, 193, 147,
+    82
+};
+
+static const ThreadColor threadColors_Isafil_Rayon[] =
+{
+    { 0xFF000000,   20, "" },
+    { 0xFF001F48,  866, "" },
+    { 0xFF002232, 3444, "" },
+    { 0xFF002D1F, 5374, "" },
+    { 0xFF002F38, 4515, "" },
+    { 0xFF002F38, 5335, "" },
+    { 0xFF002F38, 5375, "" },
+    { 0xFF003518, 5944, "" },
+    { 0xFF00405D, 4133, "" },
+    { 0xFF004250, 4432, "" },
+    { 0xFF004D3D, 5326, "" },
+    { 0xFF00507F, 3732, "" },
+    { 0xFF005B63, 4643, "" },
+    { 0xFF005B63, 5005, "" },
+    { 0xFF005B63, 5255, "" },
+    { 0xFF00646A, 4516, "" },
+    { 0xFF006587, 4022, "" },
+    { 0xFF006587, 4232, "" },
+    { 0xFF006981, 4442, "" },
+    { 0xFF006B4E, 5415, "" },
+    { 0xFF006B56, 5425, "" },
+    { 0xFF006CA5, 3902, "" },
+    { 0xFF006E42, 5324, "" },
+    { 0xFF006F73, 5000, "" },
+    { 0xFF007079, 4513, "" },
+    { 0xFF007389, 4400, "" },
+    { 0xFF007389, 4531, "" },
+    { 0xFF00779E, 3822, "" },
+    { 0xFF007848, 5513, "" },
+    { 0xFF007986, 4425, "" },
+    { 0xFF007B8D, 4410, "" },
+    { 0xFF007B8D, 4610, "" },
+    { 0xFF007D8C, 4423, "" },
+    { 0xFF007EBA, 3900, "" },
+    { 0xFF007F92, 4452, "" },
+    { 0xFF008192, 4500, "" },
+    { 0xFF0081AA, 4105, "" },
+    { 0xFF0082C4, 3901, "" },
+    { 0xFF008663, 5411, "" },
+    { 0xFF008663, 5422, "" },
+    { 0xFF008663, 5515, "" },
+    { 0xFF00876E, 5100, "" },
+    { 0xFF008879, 5431, "" },
+    { 0xFF009084, 5101, "" },
+    { 0xFF0091A5, 4421, "" },
+    { 0xFF0093B9, 4010, "" },
+    { 0xFF0095C6, 4103, "" },
+    { 0xFF0096C1, 4100, "" },
+    { 0xFF00A3A0, 4620, "" },
+    { 0xFF00A4D9, 4111, "" },
+    { 0xFF00A6AD, 5010, "" },
+    { 0xFF00A9C9, 4113, "" },
+    { 0xFF00AF8C, 5210, "" },
+    { 0xFF00B1AE, 5111, "" },
+    { 0xFF00B2CA, 4420, "" },
+    { 0xFF02140C, 5776, "" },
+    { 0xFF0B7F85, 4625, "" },
+    { 0xFF103828, 5555, "" },
+    { 0xFF103828, 5766, "" },
+    { 0xFF11263C, 3344, "" },
+    { 0xFF11263C, 3443, "" },
+    { 0xFF12253C, 3743, "" },
+    { 0xFF14214E, 3323, "" },
+    { 0xFF14A363, 5510, "" },
+    { 0xFF14B26D, 5613, "" },
+    { 0xFF157436, 5643, "" },
+    { 0xFF171B4A, 3355, "" },
+    { 0xFF192024, 4174, "" },
+    { 0xFF192024, 4175, "" },
+    { 0xFF197E6D, 5233, "" },
+    { 0xFF1A4C8D, 3622, "" },
+    { 0xFF1A781E, 5633, "" },
+    { 0xFF1B3C78, 3333, "" },
+    { 0xFF1E569F, 3631, "" },
+    { 0xFF202A65, 3353, "" },
+    { 0xFF233B7D, 3543, "" },
+    { 0xFF234544, 4644, "" },
+    { 0xFF241757, 3222, "" },
+    { 0xFF243A7D, 3611, "" },
+    { 0xFF260751, 3114, "" },
+    { 0xFF261257, 3536, "" },
+    { 0xFF265674, 4033, "" },
+    { 0xFF272651, 3554, "" },
+    { 0xFF273014, 5866, "" },
+    { 0xFF273C82, 3544, "" },
+    { 0xFF28135B, 3133, "" },
+    { 0xFF28438C, 3600, "" },
+    { 0xFF2A377E, 3102, "" },
+    { 0xFF2CB431, 5611, "" },
+    { 0xFF2D3B01, 6065, "" },
+    { 0xFF2D4491, 3522, "" },
+    { 0xFF2DB0CF, 4101, "" },
+    { 0xFF2DB0CF, 4231, "" },
+    { 0xFF2F206F, 2743, "" },
+    { 0xFF323887, 3322, "" },
+    { 0xFF35247A, 3110, "" },
+    { 0xFF353A90, 3210, "" },
+    { 0xFF392D88, 3301, "" },
+    { 0xFF394248, 2578, "" },
+    { 0xFF394535, 1876, "" },
+    { 0xFF3A212B, 2336, "" },
+    { 0xFF3A2885, 3330, "" },
+    { 0xFF3A2885, 3541, "" },
+    { 0xFF3A6D57, 5765, "" },
+    { 0xFF3C1F81, 3103, "" },
+    { 0xFF3D2723, 1276, "" },
+    { 0xFF3D6AA1, 3810, "" },
+    { 0xFF3E4F34,  465, "" },
+    { 0xFF4055A1, 3612, "" },
+    { 0xFF40B780, 5620, "" },
+    { 0xFF432731, 1366, "" },
+    { 0xFF432732, 2123, "" },
+    { 0xFF457021, 5933, "" },
+    { 0xFF464537, 1375, "" },
+    { 0xFF464537, 1573, "" },
+    { 0xFF47B9AE, 5230, "" },
+    { 0xFF483928,  945, "" },
+    { 0xFF484601, 6156, "" },
+    { 0xFF485E8A, 3952, "" },
+    { 0xFF48BAB7, 5115, "" },
+    { 0xFF490251, 2715, "" },
+    { 0xFF494949, 2576, "" },
+    { 0xFF49BAC0, 5020, "" },
+    { 0xFF4ABDF0, 3910, "" },
+    { 0xFF4C0F7B, 2900, "" },
+    { 0xFF4D2E18, 1376, "" },
+    { 0xFF4FB4CB, 4220, "" },
+    { 0xFF506702, 5934, "" },
+    { 0xFF507193, 3842, "" },
+    { 0xFF507793, 4032, "" },
+    { 0xFF515B61,  107, "" },
+    { 0xFF515B61,  111, "" },
+    { 0xFF524A90, 3211, "" },
+    { 0xFF52A04F, 5531, "" },
+    { 0xFF52BA84, 5500, "" },
+    { 0xFF53428A, 3540, "" },
+    { 0xFF5661A8, 3321, "" },
+    { 0xFF594900,  747, "" },
+    { 0xFF5D5D5D,  112, "" },
+    { 0xFF5DBFD2, 4121, "" },
+    { 0xFF5F1B23, 1342, "" },
+    { 0xFF5FBFD1, 4430, "" },
+    { 0xFF606D8C, 2674, "" },
+    { 0xFF610051, 2711, "" },
+    { 0xFF636254,  732, "" },
+    { 0xFF636254, 1874, "" },
+    { 0xFF63BE5F, 5600, "" },
+    { 0xFF646A6E, 2675, "" },
+    { 0xFF648DC7, 3641, "" },
+    { 0xFF651533, 2333, "" },
+    { 0xFF656452,  776, "" },
+    { 0xFF664090, 2905, "" },
+    { 0xFF693920, 1355, "" },
+    { 0xFF697698, 3953, "" },
+    { 0xFF6A4129, 1055, "" },
+    { 0xFF6A76B5, 3430, "" },
+    { 0xFF6AC093, 5470, "" },
+    { 0xFF6B7E6F,  463, "" },
+    { 0xFF6B9181, 5664, "" },
+    { 0xFF6C0051, 2611, "" },
+    { 0xFF6D757B,  108, "" },
+    { 0xFF6D757B,  141, "" },
+    { 0xFF6E5DA3, 3200, "" },
+    { 0xFF6E772E,  454, "" },
+    { 0xFF6EA293, 5542, "" },
+    { 0xFF6F067B, 2810, "" },
+    { 0xFF704191, 2712, "" },
+    { 0xFF707070, 3062, "" },
+    { 0xFF70953F, 5833, "" },
+    { 0xFF744808,  933, "" },
+    { 0xFF78093F, 2113, "" },
+    { 0xFF780C38, 2332, "" },
+    { 0xFF785FA3, 3213, "" },
+    { 0xFF797E24,  345, "" },
+    { 0xFF7A3441, 1346, "" },
+    { 0xFF7C8283,  152, "" },
+    { 0xFF7D77AF, 3241, "" },
+    { 0xFF7D7D7D,  104, "" },
+    { 0xFF7F8BC2, 3331, "" },
+    { 0xFF806800,  936, "" },
+    { 0xFF806A61, 1565, "" },
+    { 0xFF81C750, 5912, "" },
+    { 0xFF820052, 2506, "" },
+    { 0xFF827000,  726, "" },
+    { 0xFF83589D, 2910, "" },
+    { 0xFF84291D, 1348, "" },
+    { 0xFF85C875, 5610, "" },
+    { 0xFF86023E, 1912, "" },
+    { 0xFF86AACA, 3951, "" },
+    { 0xFF87C7EA, 4030, "" },
+    { 0xFF883A40, 2224, "" },
+    { 0xFF893480, 2600, "" },
+    { 0xFF898F2B,  442, "" },
+    { 0xFF898F94,  156, "" },
+    { 0xFF8B1771, 2502, "" },
+    { 0xFF8C0C4A, 2222, "" },
+    { 0xFF8C6DAA, 2920, "" },
+    { 0xFF8C7E6A,  722, "" },
+    { 0xFF8CCCC2, 5220, "" },
+    { 0xFF8CCCC2, 5240, "" },
+    { 0xFF8CCDD3, 4840, "" },
+    { 0xFF8DCDDB, 4240, "" },
+    { 0xFF8DCEE4, 4230, "" },
+    { 0xFF8DCEE4, 4440, "" },
+    { 0xFF9083A3, 3251, "" },
+    { 0xFF910230, 1911, "" },
+    { 0xFF919600, 6133, "" },
+    { 0xFF91B9E2, 3820, "" },
+    { 0xFF92291B, 1324, "" },
+    { 0xFF92B1DC, 3640, "" },
+    { 0xFF947C4A,  853, "" },
+    { 0xFF94ADA1, 5552, "" },
+    { 0xFF959595, 1972, "" },
+    { 0xFF959ACA, 3420, "" },
+    { 0xFF960018, 1905, "" },
+    { 0xFF970038, 2100, "" },
+    { 0xFF970059, 2500, "" },
+    { 0xFF98996D,  453, "" },
+    { 0xFF9A0C3B, 1913, "" },
+    { 0xFF9A897B,  874, "" },
+    { 0xFF9AB8D3, 3851, "" },
+    { 0xFF9D5A21, 1134, "" },
+    { 0xFF9EA5AA,  142, "" },
+    { 0xFF9ED4E6, 4040, "" },
+    { 0xFF9F003F, 2101, "" },
+    { 0xFF9F454C, 2022, "" },
+    { 0xFF9FA086,  873, "" },
+    { 0xFFA1A9B4,  131, "" },
+    { 0xFFA2D289, 5840, "" },
+    { 0xFFA33050, 1921, "" },
+    { 0xFFA33145, 2011, "" },
+    { 0xFFA35214, 1115, "" },
+    { 0xFFA41F39, 1914, "" },
+    { 0xFFA5C278, 5822, "" },
+    { 0xFFA68A68, 1061, "" },
+    { 0xFFA6D8F6, 3962, "" },
+    { 0xFFA9023A, 1904, "" },
+    { 0xFFA93121, 1514, "" },
+    { 0xFFA95A68, 2241, "" },
+    { 0xFFA974AB, 2830, "" },
+    { 0xFFAA4381, 2504, "" },
+    { 0xFFAA8D00,  545, "" },
+    { 0xFFAC6613,  932, "" },
+    { 0xFFAC9436,  551, "" },
+    { 0xFFACACAC,  109, "" },
+    { 0xFFAD85B1, 2820, "" },
+    { 0xFFAF7D3E,  941, "" },
+    { 0xFFAFC9E5, 3761, "" },
+    { 0xFFB0AA76,  352, "" },
+    { 0xFFB18B00,  542, "" },
+    { 0xFFB28F11,  546, "" },
+    { 0xFFB2AABD, 3262, "" },
+    { 0xFFB40073, 2505, "" },
+    { 0xFFB4CEEB, 3840, "" },
+    { 0xFFB4D383, 5832, "" },
+    { 0xFFB4DCD8, 5050, "" },
+    { 0xFFB69F56,  552, "" },
+    { 0xFFB76663, 1842, "" },
+    { 0xFFB7976B, 1123, "" },
+    { 0xFFB7D1E3, 3750, "" },
+    { 0xFFB9BDD9, 3340, "" },
+    { 0xFFBB3D2E, 1334, "" },
+    { 0xFFBBDB41, 5940, "" },
+    { 0xFFBD0041, 1902, "" },
+    { 0xFFBD9565,  934, "" },
+    { 0xFFBE004F, 1906, "" },
+    { 0xFFBE2D1A, 1335, "" },
+    { 0xFFBEBEA8,  672, "" },
+    { 0xFFBED782, 6051, "" },
+    { 0xFFBF006A, 2310, "" },
+    { 0xFFBF006A, 2521, "" },
+    { 0xFFBFBA28,  232, "" },
+    { 0xFFC00343, 1903, "" },
+    { 0xFFC07314,  931, "" },
+    { 0xFFC14817, 1311, "" },
+    { 0xFFC45331, 1113, "" },
+    { 0xFFC45331, 1312, "" },
+    { 0xFFC5E1F3, 3961, "" },
+    { 0xFFC690A1, 2764, "" },
+    { 0xFFC6BDB4,  150, "" },
+    { 0xFFC790BA, 3045, "" },
+    { 0xFFC7979B, 2051, "" },
+    { 0xFFC98300,  940, "" },
+    { 0xFFC9B5D4, 3040, "" },
+    { 0xFFC9E3C5, 5650, "" },
+    { 0xFFCA832C,  922, "" },
+    { 0xFFCCAB3F,  822, "" },
+    { 0xFFCD73A6, 2620, "" },
+    { 0xFFCD944A,  842, "" },
+    { 0xFFCE427A, 1950, "" },
+    { 0xFFCED2D1, 3770, "" },
+    { 0xFFCF0040, 1725, "" },
+    { 0xFFCFCFCF,  124, "" },
+    { 0xFFCFD1D5,  145, "" },
+    { 0xFFCFDDE0, 5040, "" },
+    { 0xFFD0A44F,  832, "" },
+    { 0xFFD0DEEE, 3650, "" },
+    { 0xFFD0DEEE, 3752, "" },
+    { 0xFFD18D89, 2053, "" },
+    { 0xFFD20067, 2320, "" },
+    { 0xFFD3007E, 2300, "" },
+    { 0xFFD5815E, 1332, "" },
+    { 0xFFD5C4B3,  151, "" },
+    { 0xFFD5E3F4, 3845, "" },
+    { 0xFFD5EBF2, 4250, "" },
+    { 0xFFD63C81, 2513, "" },
+    { 0xFFD6445D, 1805, "" },
+    { 0xFFD64F42, 1421, "" },
+    { 0xFFD6BF94,  761, "" },
+    { 0xFFD7623E, 1313, "" },
+    { 0xFFD76814, 1099, "" },
+    { 0xFFD7CE8A,  532, "" },
+    { 0xFFD8D5D0, 2166, "" },
+    { 0xFFD994B9, 2640, "" },
+    { 0xFFDB686B, 1750, "" },
+    { 0xFFDBE9E5, 5460, "" },
+    { 0xFFDCDDD1, 6071, "" },
+    { 0xFFDD973A, 1041, "" },
+    { 0xFFDDBDD5, 2645, "" },
+    { 0xFFDF0032, 1703, "" },
+    { 0xFFDF8390, 2153, "" },
+    { 0xFFDFA200,  704, "" },
+    { 0xFFDFA200,  824, "" },
+    { 0xFFDFC8AB, 1172, "" },
+    { 0xFFE00046, 1800, "" },
+    { 0xFFE0DA5F,  221, "" },
+    { 0xFFE10057, 1900, "" },
+    { 0xFFE12A23, 1306, "" },
+    { 0xFFE1A23E,  821, "" },
+    { 0xFFE1E1E1, 3971, "" },
+    { 0xFFE20078, 2520, "" },
+    { 0xFFE22D2A, 1501, "" },
+    { 0xFFE36C63, 1600, "" },
+    { 0xFFE36C63, 1849, "" },
+    { 0xFFE3BC61,  851, "" },
+    { 0xFFE3EB00, 6010, "" },
+    { 0xFFE43449, 1802, "" },
+    { 0xFFE44733, 1701, "" },
+    { 0xFFE44733, 1705, "" },
+    { 0xFFE4501E, 1304, "" },
+    { 0xFFE5571D, 1300, "" },
+    { 0xFFE6778B, 2152, "" },
+    { 0xFFE6B7CF, 2650, "" },
+    { 0xFFE8418C, 2220, "" },
+    { 0xFFE8643C, 1302, "" },
+    { 0xFFE89763, 1211, "" },
+    { 0xFFE8C0B8, 1761, "" },
+    { 0xFFE9C9BD, 1760, "" },
+    { 0xFFE9D7D9,  182, "" },
+    { 0xFFEA7134, 1305, "" },
+    { 0xFFEAF0F9, 3661, "" },
+    { 0xFFEAF0F9, 4071, "" },
+    { 0xFFEBE3DD,  184, "" },
+    { 0xFFEBE7DD,  870, "" },
+    { 0xFFEC7168, 1521, "" },
+    { 0xFFEC870E, 1101, "" },
+    { 0xFFECD2DE, 2655, "" },
+    { 0xFFECE7A5,  251, "" },
+    { 0xFFECE9C1,  241, "" },
+    { 0xFFECEADB,  260, "" },
+    { 0xFFED7C56, 1320, "" },
+    { 0xFFED873F, 1100, "" },
+    { 0xFFED9206, 1102, "" },
+    { 0xFFEDEF05,  501, "" },
+    { 0xFFEE71A1, 2230, "" },
+    { 0xFFEE71A1, 2524, "" },
+    { 0xFFEE8751, 1114, "" },
+    { 0xFFEE9C00,  900, "" },
+    { 0xFFEE9C00, 1106, "" },
+    { 0xFFEEDB00,  625, "" },
+    { 0xFFF0887D, 1850, "" },
+    { 0xFFF189AF, 2550, "" },
+    { 0xFFF1A236, 1220, "" },
+    { 0xFFF1AF00,  800, "" },
+    { 0xFFF1CDCE, 1755, "" },
+    { 0xFFF1EB35,  590, "" },
+    { 0xFFF28DA6, 1940, "" },
+    { 0xFFF2B9BE, 1960, "" },
+    { 0xFFF2E0DC, 2360, "" },
+    { 0xFFF3B044,  830, "" },
+    { 0xFFF3B259,  904, "" },
+    { 0xFFF3C200,  805, "" },
+    { 0xFFF3D8A8, 1140, "" },
+    { 0xFFF49E95, 1840, "" },
+    { 0xFFF4A773, 1352, "" },
+    { 0xFFF4A782, 1430, "" },
+    { 0xFFF4EE8C,  580, "" },
+    { 0xFFF5BA5D,  811, "" },
+    { 0xFFF5CA00,  702, "" },
+    { 0xFFF5D2A6,  651, "" },
+    { 0xFFF5D300,  311, "" },
+    { 0xFFF5D300,  506, "" },
+    { 0xFFF6B08E, 1532, "" },
+    { 0xFFF7B4CA, 2555, "" },
+    { 0xFFF7B4CA, 2560, "" },
+    { 0xFFF7C35F,  700, "" },
+    { 0xFFF7CB47,  610, "" },
+    { 0xFFF7DED6, 2170, "" },
+    { 0xFFF7DEDE, 2171, "" },
+    { 0xFFF7E400,  615, "" },
+    { 0xFFF8C000, 1120, "" },
+    { 0xFFF8D73E,  600, "" },
+    { 0xFFF8D73E,  605, "" },
+    { 0xFFF9BFC0, 2155, "" },
+    { 0xFFF9C598, 1362, "" },
+    { 0xFFF9C5B9, 1551, "" },
+    { 0xFFF9C6A1, 1361, "" },
+    { 0xFFF9C7B9, 1630, "" },
+    { 0xFFF9F8E8,  270, "" },
+    { 0xFFFAC7C1, 1855, "" },
+    { 0xFFFAC8D3, 2250, "" },
+    { 0xFFFACFAE, 1141, "" },
+    { 0xFFFADC59,  713, "" },
+    { 0xFFFAF6CC,  250, "" },
+    { 0xFFFAF6CC,  505, "" },
+    { 0xFFFAF6E7,  670, "" },
+    { 0xFFFBBF95, 1351, "" },
+    { 0xFFFBD1D6, 2160, "" },
+    { 0xFFFCD9C4, 2180, "" },
+    { 0xFFFCDAD5, 1860, "" },
+    { 0xFFFCF538,  706, "" },
+    { 0xFFFDE1AF,  635, "" },
+    { 0xFFFDE2C1, 1060, "" },
+    { 0xFFFDE3D3, 1870, "" },
+    { 0xFFFDE3DB, 2165, "" },
+    { 0xFFFDE5EC, 2363, "" },
+    { 0xFFFDE896,  520, "" },
+    { 0xFFFDE896,  620, "" },
+    { 0xFFFDE896,  640, "" },
+    { 0xFFFDF76C,  310, "" },
+    { 0xFFFEECD9,  961, "" },
+    { 0xFFFEEDE2, 2168, "" },
+    { 0xFFFEF09A,  630, "" },
+    { 0xFFFEF5F0,  180, "" },
+    { 0xFFFEF9EA,  660, "" },
+    { 0xFFFEFEED,  970, "" },
+    { 0xFFFFFBD1,  510, "" },
+    { 0xFFFFFDED,  101, "" },
+    { 0xFFFFFFFF,   10, "" },
+    { 0xFFFFFFFF,   15, "" },
+    { 0xFFFFFFFF,   17, "" }
+};
+
+static const short threadColorsByNumber_Isafil_Rayon[] =
+{
+    438, 439, 440, 0, 437, 177, 130, 160, 244, 131, 138, 292, 227, 161, 222, 293, 279, 302, 175, 193, 433, 348, 352,
+    325, 271, 358, 413, 357, 359, 408, 429, 390, 173, 248, 192, 217, 163, 157, 107, 363, 414, 391, 436, 426, 311, 249,
+    241, 250, 243, 256, 386, 375, 401, 402, 396, 399, 427, 369, 432, 421, 428, 389, 434, 415, 267, 395, 388, 321, 420,
+    412, 197, 183, 144, 137, 308, 150, 373, 381, 387, 328, 286, 322, 379, 295, 288, 334, 210, 1, 353, 226, 219, 367,
+    380, 285, 273, 242, 169, 264, 179, 282, 246, 116, 430, 435, 317, 154, 422, 234, 310, 361, 355, 362, 368, 275, 366,
+    231, 400, 258, 221, 382, 411, 323, 345, 372, 105, 340, 344, 339, 349, 327, 274, 276, 309, 360, 208, 301, 261, 266,
+    140, 174, 185, 416, 384, 152, 406, 404, 110, 113, 125, 307, 385, 331, 237, 354, 392, 405, 180, 114, 332, 407, 337,
+    319, 338, 291, 314, 374, 347, 346, 324, 336, 306, 383, 257, 333, 370, 409, 419, 423, 145, 99, 326, 263, 272, 236,
+    214, 265, 205, 187, 218, 232, 229, 376, 289, 377, 212, 230, 225, 281, 298, 215, 224, 170, 111, 341, 320, 403, 417,
+    424, 312, 431, 397, 398, 418, 343, 195, 190, 364, 238, 410, 300, 269, 299, 171, 149, 100, 378, 425, 216, 194, 240,
+    252, 182, 305, 330, 270, 365, 371, 393, 394, 121, 98, 191, 159, 287, 313, 318, 342, 356, 142, 147, 143, 166, 120,
+    93, 278, 165, 245, 239, 124, 151, 184, 196, 283, 280, 167, 87, 104, 95, 79, 85, 162, 96, 132, 172, 77, 176, 204,
+    251, 97, 136, 94, 62, 101, 178, 72, 260, 59, 74, 66, 213, 155, 60, 2, 90, 80, 135, 102, 75, 84, 82, 86, 78, 108,
+    70, 73, 209, 148, 296, 350, 11, 61, 259, 297, 247, 290, 106, 207, 27, 253, 128, 303, 220, 33, 37, 21, 123, 188,
+    118, 153, 277, 235, 329, 45, 16, 189, 129, 81, 223, 351, 47, 91, 46, 36, 49, 51, 139, 8, 67, 68, 126, 202, 92, 17,
+    201, 304, 25, 30, 54, 44, 32, 29, 141, 9, 203, 18, 34, 35, 24, 4, 15, 26, 31, 48, 56, 12, 76, 200, 23, 13, 50,
+    122, 294, 255, 41, 43, 53, 119, 52, 198, 115, 69, 199, 14, 22, 10, 5, 3, 6, 38, 19, 39, 20, 42, 315, 156, 134, 63,
+    28, 40, 133, 164, 211, 57, 146, 186, 88, 64, 109, 71, 65, 284, 158, 103, 58, 55, 233, 254, 168, 228, 83, 181, 112,
+    127, 262, 7, 335, 268, 89, 316, 206, 117
+};
+
+static const ThreadColor threadColors_Pantone[] =
+{
+    { 0xFF000000,  419, "" },
+    { 0xFF000000,  426, "" },
+    { 0xFF0000B8,  274, "" },
+    { 0xFF00048C, 2765, "" },
+    { 0xFF0005B3, 2755, "" },
+    { 0xFF000887, 2766, "" },
+    { 0xFF0009EB,  273, "" },
+    { 0xFF000BB5, 2756, "" },
+    { 0xFF000BD9, 2745, "" },
+    { 0xFF000D09, 5467, "" },
+    { 0xFF000DFF, 2735, "" },
+    { 0xFF0012E6, 2746, "" },
+    { 0xFF0017FF, 2736, "" },
+    { 0xFF00193F,  532, "" },
+    { 0xFF001A75, 2767, "" },
+    { 0xFF001AD9, 2748, "" },
+    { 0xFF001ED9, 2747, "" },
+    { 0xFF001F8F, 2768, "" },
+    { 0xFF0020B3, 2757, "" },
+    { 0xFF0020FA, 2738, "" },
+    { 0xFF00223D, 5395, "" },
+    { 0xFF00227B,  533, "" },
+    { 0xFF00246B,  289, "" },
+    { 0xFF002675,  282, "" },
+    { 0xFF0026BD, 2758, "" },
+    { 0xFF00274D,  539, "" },
+    { 0xFF00294D,  296, "" },
+    { 0xFF002B24, 5463, "" },
+    { 0xFF002B7A,  655, "" },
+    { 0xFF002CAA,  534, "" },
+    { 0xFF002D75,  648, "" },
+    { 0xFF0031AD,  281, "" },
+    { 0xFF003359, 7463, "" },
+    { 0xFF003440,  547, "" },
+    { 0xFF003473,  540, "" },
+    { 0xFF00395C, 2965, "" },
+    { 0xFF00399E,  654, "" },
+    { 0xFF003B42,  303, "" },
+    { 0xFF003BD1,  280, "" },
+    { 0xFF003BD1,  662, "" },
+    { 0xFF0041C4,  288, "" },
+    { 0xFF00449E,  541, "" },
+    { 0xFF0045A1,  295, "" },
+    { 0xFF00465C,  548, "" },
+    { 0xFF00471D, 3308, "" },
+    { 0xFF004741,  309, "" },
+    { 0xFF004744, 3035, "" },
+    { 0xFF0048E0,  287, "" },
+    { 0xFF0048E8,  661, "" },
+    { 0xFF004ECC,  653, "" },
+    { 0xFF004F24, 3302, "" },
+    { 0xFF00523C,  316, "" },
+    { 0xFF0055C9,  294, "" },
+    { 0xFF0055FA,  286, "" },
+    { 0xFF0056C4,  647, "" },
+    { 0xFF005710, 3435, "" },
+    { 0xFF0058A1, 2955, "" },
+    { 0xFF005940, 3165, "" },
+    { 0xFF006080,  302, "" },
+    { 0xFF006327, 3305, "" },
+    { 0xFF006635,  330, "" },
+    { 0xFF00663A, 7476, "" },
+    { 0xFF00687D, 3025, "" },
+    { 0xFF006BFA,  293, "" },
+    { 0xFF0073D1,  301, "" },
+    { 0xFF0073E6, 7462, "" },
+    { 0xFF0077BF,   -1, "Process Blue 2X" },
+    { 0xFF0079DB, 2945, "" },
+    { 0xFF007A99, 7469, "" },
+    { 0xFF007F82,   -1, "320 2X" },
+    { 0xFF007FCC,   -1, "299 2X" },
+    { 0xFF008013, 7484, "" },
+    { 0xFF008087,  308, "" },
+    { 0xFF00872D,  336, "" },
+    { 0xFF008754,  323, "" },
+    { 0xFF008977,   -1, "327 2X" },
+    { 0xFF0089CC, 3015, "" },
+    { 0xFF008A46, 3292, "" },
+    { 0xFF008A4A,  329, "" },
+    { 0xFF008AFF, 2935, "" },
+    { 0xFF008FFF,  300, "" },
+    { 0xFF00912A,  342, "" },
+    { 0xFF009180,  315, "" },
+    { 0xFF0091C9,   -1, "Process Blue" },
+    { 0xFF00940D,  349, "" },
+    { 0xFF009421, 3425, "" },
+    { 0xFF009440, 3298, "" },
+    { 0xFF009677,   -1, "Green 2X" },
+    { 0xFF009944,   -1, "354 2X" },
+    { 0xFF00998B,  634, "" },
+    { 0xFF009CBA,  307, "" },
+    { 0xFF009E0F,   -1, "368 2X" },
+    { 0xFF009E78, 3155, "" },
+    { 0xFF00A0FA, 3005, "" },
+    { 0xFF00A3D1,   -1, "306 2X" },
+    { 0xFF00A5B8, 7468, "" },
+    { 0xFF00A66F,  322, "" },
+    { 0xFF00ABB3,  641, "" },
+    { 0xFF00AD5F,  328, "" },
+    { 0xFF00AF93,   -1, "Green" },
+    { 0xFF00B33E,  335, "" },
+    { 0xFF00B3A2,  314, "" },
+    { 0xFF00B53C,  341, "" },
+    { 0xFF00BFAC,  633, "" },
+    { 0xFF00C21D,  348, "" },
+    { 0xFF00C487,  321, "" },
+    { 0xFF00C49F, 3145, "" },
+    { 0xFF00C72E, 3415, "" },
+    { 0xFF00C7C7,  640, "" },
+    { 0xFF00C95F, 3295, "" },
+    { 0xFF00CC5E, 3288, "" },
+    { 0xFF00D477,  327, "" },
+    { 0xFF00D975, 3282, "" },
+    { 0xFF00DECC,  313, "" },
+    { 0xFF00E84F,  340, "" },
+    { 0xFF00E8C3, 3135, "" },
+    { 0xFF00ED77, 3285, "" },
+    { 0xFF00EDA4,  320, "" },
+    { 0xFF00F26D, 3278, "" },
+    { 0xFF00F2E6,  639, "" },
+    { 0xFF00F2F2, 7460, "" },
+    { 0xFF00F723,  347, "" },
+    { 0xFF00F763,  334, "" },
+    { 0xFF00FF8F, 3272, "" },
+    { 0xFF020073,  276, "" },
+    { 0xFF02272B,  546, "" },
+    { 0xFF02631C,  343, "" },
+    { 0xFF030091,  275, "" },
+    { 0xFF04290A,  627, "" },
+    { 0xFF04D45B,  569, "" },
+    { 0xFF050402,  412, "" },
+    { 0xFF050403,   -1, "Black" },
+    { 0xFF050F07, 5605, "" },
+    { 0xFF070C0F,   -1, "Black 6 2X" },
+    { 0xFF0900E6, 2685, "" },
+    { 0xFF090C0D,  433, "" },
+    { 0xFF09BA00,  356, "" },
+    { 0xFF0A0C11,   -1, "433 2X" },
+    { 0xFF0A0F0F, 7547, "" },
+    { 0xFF0A4FFF, 2728, "" },
+    { 0xFF0AFFE3,  312, "" },
+    { 0xFF0C0082, 2695, "" },
+    { 0xFF0C1C8C,   -1, "Reflex Blue" },
+    { 0xFF0D0B4D, 5255, "" },
+    { 0xFF0D4000,  350, "" },
+    { 0xFF0D4018,  560, "" },
+    { 0xFF0DFF87, 3275, "" },
+    { 0xFF0DFFBF, 7467, "" },
+    { 0xFF0E4D1C,  567, "" },
+    { 0xFF0F0F0F,   -1, "Black 4 2X" },
+    { 0xFF0FFF00,  355, "" },
+    { 0xFF102E14, 5535, "" },
+    { 0xFF105249, 7477, "" },
+    { 0xFF110C0F,   -1, "Black 5 2X" },
+    { 0xFF111111,   -1, "Black 2 2X" },
+    { 0xFF111114,   -1, "Black 3 2X" },
+    { 0xFF115422,  554, "" },
+    { 0xFF117300, 7483, "" },
+    { 0xFF127A38,  561, "" },
+    { 0xFF13F2CE,  632, "" },
+    { 0xFF143319,  553, "" },
+    { 0xFF14A346,  568, "" },
+    { 0xFF14C78F, 7474, "" },
+    { 0xFF167000,  357, "" },
+    { 0xFF167A58, 5473, "" },
+    { 0xFF175E22,  626, "" },
+    { 0xFF187031,  555, "" },
+    { 0xFF1A6EFF,  660, "" },
+    { 0xFF1AB058,  562, "" },
+    { 0xFF1AE3FF, 2995, "" },
+    { 0xFF1AFF82, 3268, "" },
+    { 0xFF1C0022, 5185, "" },
+    { 0xFF1C007A,   -1, "Reflex Blue 2X" },
+    { 0xFF1C00FF,  267, "" },
+    { 0xFF1C2630,   -1, "Black 6" },
+    { 0xFF1C778C, 7470, "" },
+    { 0xFF1C91FF,  285, "" },
+    { 0xFF1D4230, 5477, "" },
+    { 0xFF1F2E07, 5743, "" },
+    { 0xFF201E87,  669, "" },
+    { 0xFF20258A, 5265, "" },
+    { 0xFF202700,  440, "" },
+    { 0xFF21FF9E,  326, "" },
+    { 0xFF243600, 5747, "" },
+    { 0xFF2600AB,  269, "" },
+    { 0xFF2600FF, 2597, "" },
+    { 0xFF261E06, 7533, "" },
+    { 0xFF263300, 7498, "" },
+    { 0xFF26C2FF, 2925, "" },
+    { 0xFF26CFFF,  299, "" },
+    { 0xFF26FF59, 3405, "" },
+    { 0xFF270020, 7449, "" },
+    { 0xFF270085,  525, "" },
+    { 0xFF272E20,  447, "" },
+    { 0xFF2800B0, 2627, "" },
+    { 0xFF2800E0,  268, "" },
+    { 0xFF282D26,   -1, "Black 3" },
+    { 0xFF293300,  439, "" },
+    { 0xFF29FF70,  339, "" },
+    { 0xFF2B0041, 5115, "" },
+    { 0xFF2BFFC9, 3125, "" },
+    { 0xFF2BFFE6,  638, "" },
+    { 0xFF2D00ED, 2607, "" },
+    { 0xFF2D393B,  432, "" },
+    { 0xFF2D3E00,  448, "" },
+    { 0xFF2E005C,  518, "" },
+    { 0xFF2E00D9, 2617, "" },
+    { 0xFF2E522B, 5615, "" },
+    { 0xFF304547, 7546, "" },
+    { 0xFF314A0E,  574, "" },
+    { 0xFF320000,  504, "" },
+    { 0xFF324031,  446, "" },
+    { 0xFF327A3D, 5545, "" },
+    { 0xFF330E00, 4975, "" },
+    { 0xFF33302B,   -1, "Black 7 2X" },
+    { 0xFF3378FF, 7455, "" },
+    { 0xFF33FF1A,  354, "" },
+    { 0xFF33FF40, 7482, "" },
+    { 0xFF349400,  364, "" },
+    { 0xFF361500, 4625, "" },
+    { 0xFF361AFF,  266, "" },
+    { 0xFF363605, 5815, "" },
+    { 0xFF3657FF, 2726, "" },
+    { 0xFF380096,   -1, "Blue 072" },
+    { 0xFF381100,  497, "" },
+    { 0xFF381C00,  476, "" },
+    { 0xFF3848A8, 5275, "" },
+    { 0xFF38B8FF, 7461, "" },
+    { 0xFF394500,  438, "" },
+    { 0xFF3A3321,   -1, "Black 2" },
+    { 0xFF3A728A, 5405, "" },
+    { 0xFF3B00ED,  526, "" },
+    { 0xFF3B3B3B,  425, "" },
+    { 0xFF3B52FF, 2725, "" },
+    { 0xFF3C008F, 2622, "" },
+    { 0xFF3D0066,  511, "" },
+    { 0xFF3D0C4E, 5195, "" },
+    { 0xFF3D3023,   -1, "Black 4" },
+    { 0xFF3D332B,   -1, "Black" },
+    { 0xFF3D5200,  449, "" },
+    { 0xFF3E402C,  418, "" },
+    { 0xFF3E40B3,  668, "" },
+    { 0xFF3E7800,  575, "" },
+    { 0xFF3EC200,  363, "" },
+    { 0xFF3F0073,  262, "" },
+    { 0xFF3F5410, 5753, "" },
+    { 0xFF402600,  462, "" },
+    { 0xFF407000,  371, "" },
+    { 0xFF40FFED,  306, "" },
+    { 0xFF420D00, 4695, "" },
+    { 0xFF422D2D,   -1, "Black 5" },
+    { 0xFF423500, 7519, "" },
+    { 0xFF436600,  378, "" },
+    { 0xFF43B08B, 5483, "" },
+    { 0xFF44009D,  519, "" },
+    { 0xFF443D38,   -1, "Black 7" },
+    { 0xFF4500FF,  527, "" },
+    { 0xFF464700,  581, "" },
+    { 0xFF4696E3,  646, "" },
+    { 0xFF46E800,  362, "" },
+    { 0xFF46EB91, 7473, "" },
+    { 0xFF4700AD, 2623, "" },
+    { 0xFF471300,  490, "" },
+    { 0xFF472200, 1545, "" },
+    { 0xFF47342E,  411, "" },
+    { 0xFF474030,  405, "" },
+    { 0xFF474747, 7540, "" },
+    { 0xFF475947,  445, "" },
+    { 0xFF48705D, 5487, "" },
+    { 0xFF495C5E, 7545, "" },
+    { 0xFF4A1A00,  469, "" },
+    { 0xFF4A94FF, 2727, "" },
+    { 0xFF4AFFAB, 3262, "" },
+    { 0xFF4BAB60,  625, "" },
+    { 0xFF4D00FA, 2603, "" },
+    { 0xFF4DFFC4, 7466, "" },
+    { 0xFF4E4373, 7448, "" },
+    { 0xFF4F00DB, 2612, "" },
+    { 0xFF4F1800,  477, "" },
+    { 0xFF4F3A00, 4485, "" },
+    { 0xFF4F9C00,  576, "" },
+    { 0xFF4FEDFF,  298, "" },
+    { 0xFF4FFF00,  361, "" },
+    { 0xFF4FFFA1, 3265, "" },
+    { 0xFF500099,  261, "" },
+    { 0xFF5000D9, 2613, "" },
+    { 0xFF506700,  450, "" },
+    { 0xFF525B5C,  431, "" },
+    { 0xFF52A8FF,  279, "" },
+    { 0xFF52BA00,  370, "" },
+    { 0xFF52FADC,  631, "" },
+    { 0xFF5357CF, 7447, "" },
+    { 0xFF547306, 5757, "" },
+    { 0xFF5496FF, 2718, "" },
+    { 0xFF54BC00,   -1, "375 2X" },
+    { 0xFF56ADBA,  549, "" },
+    { 0xFF570900, 1817, "" },
+    { 0xFF585943,  417, "" },
+    { 0xFF59008E,   -1, "Violet 2X" },
+    { 0xFF592482, 5125, "" },
+    { 0xFF594A00,  455, "" },
+    { 0xFF594A2D, 7532, "" },
+    { 0xFF59B386, 7475, "" },
+    { 0xFF5A7D57, 5625, "" },
+    { 0xFF5A8A96, 5415, "" },
+    { 0xFF5A9E68, 5555, "" },
+    { 0xFF5B00BD,  260, "" },
+    { 0xFF5BA621, 7490, "" },
+    { 0xFF5C00E0,  520, "" },
+    { 0xFF5C00F7, 2602, "" },
+    { 0xFF5C2800,  732, "" },
+    { 0xFF5C2C00,  161, "" },
+    { 0xFF5C5900, 3995, "" },
+    { 0xFF5C6E1D, 5763, "" },
+    { 0xFF5C97E6,  652, "" },
+    { 0xFF5CA6FF,  659, "" },
+    { 0xFF5E00BF,  255, "" },
+    { 0xFF5E3C00, 1405, "" },
+    { 0xFF5EC1F7,  542, "" },
+    { 0xFF5EFFD1, 3115, "" },
+    { 0xFF5EFFE0,  311, "" },
+    { 0xFF5F00D9,  259, "" },
+    { 0xFF5F9E00, 7496, "" },
+    { 0xFF5FDED1, 7459, "" },
+    { 0xFF5FED2F, 7489, "" },
+    { 0xFF600000,  505, "" },
+    { 0xFF6100CE,  512, "" },
+    { 0xFF6166FF, 2665, "" },
+    { 0xFF61ED00,  369, "" },
+    { 0xFF630046, 7421, "" },
+    { 0xFF631CFF, 2593, "" },
+    { 0xFF636363,  424, "" },
+    { 0xFF63FF8C, 3395, "" },
+    { 0xFF64A7E8,  645, "" },
+    { 0xFF660057,  229, "" },
+    { 0xFF660700,  483, "" },
+    { 0xFF6607A5,   -1, "Violet" },
+    { 0xFF661AFF, 2592, "" },
+    { 0xFF662400,  175, "" },
+    { 0xFF662500,  498, "" },
+    { 0xFF663D2E, 7518, "" },
+    { 0xFF66BA80,  556, "" },
+    { 0xFF66FF73, 7481, "" },
+    { 0xFF66FF80, 7480, "" },
+    { 0xFF686B00,  385, "" },
+    { 0xFF689900, 7491, "" },
+    { 0xFF69005E,  222, "" },
+    { 0xFF690369,  690, "" },
+    { 0xFF692D00,  168, "" },
+    { 0xFF6957FF, 2587, "" },
+    { 0xFF69660E, 5825, "" },
+    { 0xFF6970DB,  667, "" },
+    { 0xFF69EDFF, 2915, "" },
+    { 0xFF69FFAB, 3258, "" },
+    { 0xFF69FFF0, 2985, "" },
+    { 0xFF6B1200,  478, "" },
+    { 0xFF6B3D00,  463, "" },
+    { 0xFF6B85FF,  272, "" },
+    { 0xFF6B9AED, 7456, "" },
+    { 0xFF6BC200,  377, "" },
+    { 0xFF6BFF33,  360, "" },
+    { 0xFF6D5E51,   -1, "Warm Gray 11" },
+    { 0xFF6E00B8,  249, "" },
+    { 0xFF6E8CFF, 2715, "" },
+    { 0xFF6EFF00,  368, "" },
+    { 0xFF704214,   -1, "464 2X" },
+    { 0xFF705100,  147, "" },
+    { 0xFF705A00,  133, "" },
+    { 0xFF705C59,  410, "" },
+    { 0xFF706758,  404, "" },
+    { 0xFF70FFBD,  325, "" },
+    { 0xFF720082,   -1, "2592 2X" },
+    { 0xFF7280C4, 5285, "" },
+    { 0xFF72CC85,  624, "" },
+    { 0xFF73002E,  195, "" },
+    { 0xFF73173F, 7428, "" },
+    { 0xFF735022, 7505, "" },
+    { 0xFF738639, 7497, "" },
+    { 0xFF73AEE6, 7454, "" },
+    { 0xFF73C9AD, 5493, "" },
+    { 0xFF73CFFF,  284, "" },
+    { 0xFF73FF80, 7479, "" },
+    { 0xFF73FF87,  346, "" },
+    { 0xFF73FFE8,  637, "" },
+    { 0xFF74F200,  376, "" },
+    { 0xFF750082,  242, "" },
+    { 0xFF753700,  731, "" },
+    { 0xFF755600,  140, "" },
+    { 0xFF7570FF,  265, "" },
+    { 0xFF7582FF, 2655, "" },
+    { 0xFF770000,  506, "" },
+    { 0xFF7700BD, 2425, "" },
+    { 0xFF777772,   -1, "Cool Gray 10" },
+    { 0xFF78004F,  209, "" },
+    { 0xFF787200,  620, "" },
+    { 0xFF788A00,  582, "" },
+    { 0xFF798200,  392, "" },
+    { 0xFF79A6AD, 5425, "" },
+    { 0xFF79FCAC,  563, "" },
+    { 0xFF7A1A00,  491, "" },
+    { 0xFF7A5E85, 5205, "" },
+    { 0xFF7AFFBF, 7472, "" },
+    { 0xFF7AFFCF,  319, "" },
+    { 0xFF7BC1C9,  550, "" },
+    { 0xFF7D0925,  697, "" },
+    { 0xFF7D0C00, 1815, "" },
+    { 0xFF7D5B00, 1265, "" },
+    { 0xFF7DFFE8,  305, "" },
+    { 0xFF7E947E,  444, "" },
+    { 0xFF8000FF,  254, "" },
+    { 0xFF800400,  188, "" },
+    { 0xFF804DFF, 7442, "" },
+    { 0xFF80735D, 7531, "" },
+    { 0xFF807C00,  105, "" },
+    { 0xFF80806B,  416, "" },
+    { 0xFF80ADFF, 7452, "" },
+    { 0xFF80BDFF, 7453, "" },
+    { 0xFF80FFBF, 7465, "" },
+    { 0xFF810091,  683, "" },
+    { 0xFF82074E,  216, "" },
+    { 0xFF823126, 4705, "" },
+    { 0xFF823B00,  725, "" },
+    { 0xFF8257B8, 5135, "" },
+    { 0xFF827200,  119, "" },
+    { 0xFF827263,   -1, "Warm Gray 10" },
+    { 0xFF829E90, 5497, "" },
+    { 0xFF82E3FF,  292, "" },
+    { 0xFF82FCFF,  297, "" },
+    { 0xFF82FFB8, 3255, "" },
+    { 0xFF849C32, 5767, "" },
+    { 0xFF84BD8F, 5565, "" },
+    { 0xFF853100,  499, "" },
+    { 0xFF853241, 4985, "" },
+    { 0xFF858C8C,  430, "" },
+    { 0xFF85FFB5,  570, "" },
+    { 0xFF86B324, 7495, "" },
+    { 0xFF872300,  181, "" },
+    { 0xFF87FFAD,  338, "" },
+    { 0xFF87FFC2, 3252, "" },
+    { 0xFF87FFE3,  630, "" },
+    { 0xFF89A386, 5635, "" },
+    { 0xFF8A1FFF,  513, "" },
+    { 0xFF8A47FF, 2582, "" },
+    { 0xFF8A5EFF, 2583, "" },
+    { 0xFF8A6E07, 4495, "" },
+    { 0xFF8A8C8A,  437, "" },
+    { 0xFF8A9799, 7544, "" },
+    { 0xFF8BCCF0,  644, "" },
+    { 0xFF8C7A77,  409, "" },
+    { 0xFF8C7F70,   -1, "Warm Gray 9" },
+    { 0xFF8C8984,   -1, "Cool Gray 9" },
+    { 0xFF8CB5FF, 2716, "" },
+    { 0xFF8CFFAB, 3385, "" },
+    { 0xFF8CFFE8,  636, "" },
+    { 0xFF8F2E00, 1685, "" },
+    { 0xFF8F3900, 7517, "" },
+    { 0xFF8F4A06, 4635, "" },
+    { 0xFF8F8F8F,  423, "" },
+    { 0xFF909E5A, 5773, "" },
+    { 0xFF90B000,  384, "" },
+    { 0xFF90F0E4, 7458, "" },
+    { 0xFF910039,  202, "" },
+    { 0xFF910099,  235, "" },
+    { 0xFF910DFF,  253, "" },
+    { 0xFF913DFF,  258, "" },
+    { 0xFF914000, 1615, "" },
+    { 0xFF917C00,  456, "" },
+    { 0xFF918779,  403, "" },
+    { 0xFF918C00,  619, "" },
+    { 0xFF919100,  399, "" },
+    { 0xFF919EFF, 7446, "" },
+    { 0xFF91A1FF,  271, "" },
+    { 0xFF91FF66, 7488, "" },
+    { 0xFF91FFBA,  333, "" },
+    { 0xFF91FFC2, 3248, "" },
+    { 0xFF91FFE0, 3105, "" },
+    { 0xFF91FFE6,  310, "" },
+    { 0xFF942200,  492, "" },
+    { 0xFF94B3ED,  535, "" },
+    { 0xFF955300,  464, "" },
+    { 0xFF95AB00,  391, "" },
+    { 0xFF95C5F0,  651, "" },
+    { 0xFF960090,  228, "" },
+    { 0xFF9600FA,  248, "" },
+    { 0xFF9673FF,  528, "" },
+    { 0xFF96897A,   -1, "Warm Gray 8" },
+    { 0xFF969200, 3985, "" },
+    { 0xFF969684,  415, "" },
+    { 0xFF96CCFF,  658, "" },
+    { 0xFF96E3FF,  543, "" },
+    { 0xFF96FAFF, 2905, "" },
+    { 0xFF96FF38,  375, "" },
+    { 0xFF98D9AD,  557, "" },
+    { 0xFF991846,  696, "" },
+    { 0xFF997354, 7504, "" },
+    { 0xFF998CFF, 2577, "" },
+    { 0xFF999632, 5835, "" },
+    { 0xFF99A3FF, 2645, "" },
+    { 0xFF99B3FF, 2705, "" },
+    { 0xFF99C9FF, 7451, "" },
+    { 0xFF9B9993,   -1, "Cool Gray 8" },
+    { 0xFF9CDBC5, 5503, "" },
+    { 0xFF9CDBFF,  278, "" },
+    { 0xFF9CE6AE,  623, "" },
+    { 0xFF9D00EB, 2415, "" },
+    { 0xFF9D27A8,  689, "" },
+    { 0xFF9DB39D,  443, "" },
+    { 0xFF9E4A00, 1535, "" },
+    { 0xFF9E8E00,  112, "" },
+    { 0xFF9EC400,   -1, "382 2X" },
+    { 0xFF9EFFA3,  353, "" },
+    { 0xFF9EFFAD,  345, "" },
+    { 0xFF9EFFD9,  318, "" },
+    { 0xFFA0A395, 7539, "" },
+    { 0xFFA10040, 1955, "" },
+    { 0xFFA10067,  208, "" },
+    { 0xFFA14C00,  724, "" },
+    { 0xFFA15F00, 1395, "" },
+    { 0xFFA17800,  126, "" },
+    { 0xFFA1B5A8, 5507, "" },
+    { 0xFFA1FFCC,  564, "" },
+    { 0xFFA1FFD1, 3242, "" },
+    { 0xFFA2B39B, 7538, "" },
+    { 0xFFA2D7DE,  551, "" },
+    { 0xFFA300FF,  247, "" },
+    { 0xFFA33100,  174, "" },
+    { 0xFFA34402,   -1, "471 2X" },
+    { 0xFFA380FF, 7441, "" },
+    { 0xFFA38B24, 4505, "" },
+    { 0xFFA39687,   -1, "Warm Gray 7" },
+    { 0xFFA3D400,  583, "" },
+    { 0xFFA3D982, 7494, "" },
+    { 0xFFA3FF82,  359, "" },
+    { 0xFFA4A6ED,  666, "" },
+    { 0xFFA5A39E,   -1, "Cool Gray 7" },
+    { 0xFFA5B85E, 5777, "" },
+    { 0xFFA5CF00,  383, "" },
+    { 0xFFA60095, 7435, "" },
+    { 0xFFA63A00, 7526, "" },
+    { 0xFFA65000, 7516, "" },
+    { 0xFFA6B3B3, 7543, "" },
+    { 0xFFA6E8FF,  283, "" },
+    { 0xFFA6FFBF, 3375, "" },
+    { 0xFFA800FF, 2405, "" },
+    { 0xFFA82FE0,  682, "" },
+    { 0xFFA85868, 4995, "" },
+    { 0xFFA85B00,  154, "" },
+    { 0xFFA8625D, 4715, "" },
+    { 0xFFA87B00, 1255, "" },
+    { 0xFFA89796,  408, "" },
+    { 0xFFA8ADAD,  429, "" },
+    { 0xFFA8B3E6, 5295, "" },
+    { 0xFFA8FFCF, 3245, "" },
+    { 0xFFA8FFE8,  629, "" },
+    { 0xFFA9D4B2, 5575, "" },
+    { 0xFFAA0096,   -1, "Purple 2X" },
+    { 0xFFAB003E,  194, "" },
+    { 0xFFAB4800,  470, "" },
+    { 0xFFAB5C00, 7512, "" },
+    { 0xFFAB6100,  146, "" },
+    { 0xFFABABAB,  422, "" },
+    { 0xFFABB573,  451, "" },
+    { 0xFFABB800,  398, "" },
+    { 0xFFABF7FF,  291, "" },
+    { 0xFFAD4200,  160, "" },
+    { 0xFFADA089, 7530, "" },
+    { 0xFFADA687, 7536, "" },
+    { 0xFFADC6F7, 7445, "" },
+    { 0xFFADFF69,  367, "" },
+    { 0xFFADFFCF,  571, "" },
+    { 0xFFADFFEB,  635, "" },
+    { 0xFFAEBFA6, 5645, "" },
+    { 0xFFAEE67C,  577, "" },
+    { 0xFFAFA393,   -1, "Warm Gray 6" },
+    { 0xFFAFBA86, 5783, "" },
+    { 0xFFB08573,  479, "" },
+    { 0xFFB0A597,  402, "" },
+    { 0xFFB0BAFF,  270, "" },
+    { 0xFFB0C7F2,  536, "" },
+    { 0xFFB0FFCC,  337, "" },
+    { 0xFFB100BD,  234, "" },
+    { 0xFFB30098,  221, "" },
+    { 0xFFB34F00, 1605, "" },
+    { 0xFFB36259, 7525, "" },
+    { 0xFFB38100,  132, "" },
+    { 0xFFB387FF, 2572, "" },
+    { 0xFFB38CE0, 5145, "" },
+    { 0xFFB391FF, 2573, "" },
+    { 0xFFB399FF, 7440, "" },
+    { 0xFFB3AB00,  613, "" },
+    { 0xFFB3AD00,  104, "" },
+    { 0xFFB3AD17,  618, "" },
+    { 0xFFB3B15F, 5845, "" },
+    { 0xFFB3B3A1,  414, "" },
+    { 0xFFB3F0FF,  544, "" },
+    { 0xFFB3FF8C, 7487, "" },
+    { 0xFFB3FFCC,  332, "" },
+    { 0xFFB3FFEB,  304, "" },
+    { 0xFFB3FFF2, 2975, "" },
+    { 0xFFB50043,  201, "" },
+    { 0xFFB50900,  484, "" },
+    { 0xFFB51AFF,  246, "" },
+    { 0xFFB56E2B,  730, "" },
+    { 0xFFB59EC2, 5215, "" },
+    { 0xFFB5A3FF, 2567, "" },
+    { 0xFFB5A899,   -1, "Warm Gray 5" },
+    { 0xFFB5B2AA,   -1, "Cool Gray 6" },
+    { 0xFFB5B500, 3975, "" },
+    { 0xFFB5E0FF, 2717, "" },
+    { 0xFFB5FF00,  382, "" },
+    { 0xFFB600FA,  241, "" },
+    { 0xFFB7EB00,  390, "" },
+    { 0xFFB80007, 1807, "" },
+    { 0xFFB80040, 7427, "" },
+    { 0xFFB83D00, 1675, "" },
+    { 0xFFB8743B, 4645, "" },
+    { 0xFFB89C00,  457, "" },
+    { 0xFFB8BAFF, 2635, "" },
+    { 0xFFB8CDD4, 5435, "" },
+    { 0xFFB8E4F5,  643, "" },
+    { 0xFFB8FFDB, 7471, "" },
+    { 0xFFB8FFE0,  324, "" },
+    { 0xFFBA0025,  704, "" },
+    { 0xFFBA0079,  215, "" },
+    { 0xFFBA0DFF, 2395, "" },
+    { 0xFFBA544A, 7524, "" },
+    { 0xFFBA87FF,  521, "" },
+    { 0xFFBA9900,  118, "" },
+    { 0xFFBAA600,  111, "" },
+    { 0xFFBAB7AF,   -1, "Cool Gray 5" },
+    { 0xFFBAE8CA,  558, "" },
+    { 0xFFBAEDFF,  277, "" },
+    { 0xFFBAF5C6,  622, "" },
+    { 0xFFBAFF9E,  358, "" },
+    { 0xFFBAFFBF,  352, "" },
+    { 0xFFBAFFC4,  344, "" },
+    { 0xFFBB00C7,  676, "" },
+    { 0xFFBD8C00,  125, "" },
+    { 0xFFBD99FF,  529, "" },
+    { 0xFFBDAEAC,  407, "" },
+    { 0xFFBDB8FF,  264, "" },
+    { 0xFFBDBDBD,  421, "" },
+    { 0xFFBDE6FF, 2708, "" },
+    { 0xFFBECFBC,  442, "" },
+    { 0xFFBED1C5, 5517, "" },
+    { 0xFFBEE3FA,  650, "" },
+    { 0xFFBF30B5,   -1, "Purple" },
+    { 0xFFBF508A,  695, "" },
+    { 0xFFBF6900, 7511, "" },
+    { 0xFFBF827C, 4725, "" },
+    { 0xFFBFA87C, 7503, "" },
+    { 0xFFBFFAFF,  290, "" },
+    { 0xFFBFFFE6, 7464, "" },
+    { 0xFFC0F090,  578, "" },
+    { 0xFFC15FF5,  681, "" },
+    { 0xFFC1B5A5,   -1, "Warm Gray 4" },
+    { 0xFFC1D6D0, 7542, "" },
+    { 0xFFC270FF,  252, "" },
+    { 0xFFC2B061, 4515, "" },
+    { 0xFFC2BFBF,  436, "" },
+    { 0xFFC2CF9C,  452, "" },
+    { 0xFFC2EBFF,  657, "" },
+    { 0xFFC2FF6E,  374, "" },
+    { 0xFFC2FFD6,  331, "" },
+    { 0xFFC4057C,   -1, "239 2X" },
+    { 0xFFC41200, 1805, "" },
+    { 0xFFC459CF,  688, "" },
+    { 0xFFC47A8F, 5005, "" },
+    { 0xFFC47C00,  139, "" },
+    { 0xFFC4BBAF,  401, "" },
+    { 0xFFC4C1BA,   -1, "Cool Gray 4" },
+    { 0xFFC4FFDB,  572, "" },
+    { 0xFFC4FFDE,  565, "" },
+    { 0xFFC5D1BE, 5655, "" },
+    { 0xFFC5E693, 7493, "" },
+    { 0xFFC5E8E8,  552, "" },
+    { 0xFFC6003D,   -1, "Rubine Red 2X" },
+    { 0xFFC6CCB8, 7537, "" },
+    { 0xFFC7ABFF, 2563, "" },
+    { 0xFFC7CEED, 5305, "" },
+    { 0xFFC7DBF7,  537, "" },
+    { 0xFFC7F2E1, 5513, "" },
+    { 0xFFC7F7FF,  545, "" },
+    { 0xFFC8CFFA,  665, "" },
+    { 0xFFC9D1A5, 5793, "" },
+    { 0xFFCAE6CC, 5585, "" },
+    { 0xFFCC002B,  187, "" },
+    { 0xFFCC0C00,   -1, "485 2X" },
+    { 0xFFCC2976, 7420, "" },
+    { 0xFFCC29AD, 7434, "" },
+    { 0xFFCC7A85, 7523, "" },
+    { 0xFFCCA6FF, 7439, "" },
+    { 0xFFCCAD6B,  465, "" },
+    { 0xFFCCC1B2,   -1, "Warm Gray 3" },
+    { 0xFFCCC6AD, 7535, "" },
+    { 0xFFCCC800,  612, "" },
+    { 0xFFCCCCBA,  413, "" },
+    { 0xFFCCD4FF, 7444, "" },
+    { 0xFFCCDCDE, 5445, "" },
+    { 0xFFCCE300,  397, "" },
+    { 0xFFCCE6FF, 7450, "" },
+    { 0xFFCCFF17,  381, "" },
+    { 0xFFCCFF26,  389, "" },
+    { 0xFFCCFF8F,  366, "" },
+    { 0xFFCCFFB3, 7486, "" },
+    { 0xFFCD00F7,  675, "" },
+    { 0xFFCDD1D1,  428, "" },
+    { 0xFFCDF7A3,  579, "" },
+    { 0xFFCEDE99, 5787, "" },
+    { 0xFFCEF0D8,  559, "" },
+    { 0xFFCF005B, 1945, "" },
+    { 0xFFCF0076,  207, "" },
+    { 0xFFCF00C0,  227, "" },
+    { 0xFFCF36FF, 2385, "" },
+    { 0xFFCFA6FF, 2562, "" },
+    { 0xFFCFE8FF, 2706, "" },
+    { 0xFFCFFFF0,  628, "" },
+    { 0xFFD10056,   -1, "Rubine Red" },
+    { 0xFFD10073, 7426, "" },
+    { 0xFFD10572,   -1, "Rhodamine Red 2X" },
+    { 0xFFD10FFF,  240, "" },
+    { 0xFFD11600,   -1, "185 2X" },
+    { 0xFFD15473, 7419, "" },
+    { 0xFFD15600,  471, "" },
+    { 0xFFD17100,  153, "" },
+    { 0xFFD19052,  729, "" },
+    { 0xFFD19700, 1245, "" },
+    { 0xFFD19B73, 4655, "" },
+    { 0xFFD1B0FF,  530, "" },
+    { 0xFFD1CB00,  103, "" },
+    { 0xFFD1D190, 5855, "" },
+    { 0xFFD1ED77, 7492, "" },
+    { 0xFFD1FFDB, 7478, "" },
+    { 0xFFD1FFEB,  317, "" },
+    { 0xFFD2F0FA,  642, "" },
+    { 0xFFD3CEC4,   -1, "Cool Gray 3" },
+    { 0xFFD3F032,  584, "" },
+    { 0xFFD400B8,  220, "" },
+    { 0xFFD45500,  167, "" },
+    { 0xFFD4740B,  723, "" },
+    { 0xFFD4A1FF,  522, "" },
+    { 0xFFD4B3EB, 5155, "" },
+    { 0xFFD4BAD9, 5225, "" },
+    { 0xFFD4C581, 4525, "" },
+    { 0xFFD4CBBA, 7529, "" },
+    { 0xFFD4CF6E,  617, "" },
+    { 0xFFD4F0FF, 2707, "" },
+    { 0xFFD4FFD6,  351, "" },
+    { 0xFFD5E3DA, 5527, "" },
+    { 0xFFD62100,   -1, "1788 2X" },
+    { 0xFFD62463,  703, "" },
+    { 0xFFD68196, 7522, "" },
+    { 0xFFD6CBC9,  406, "" },
+    { 0xFFD6D0C9,  400, "" },
+    { 0xFFD6FF8A,  373, "" },
+    { 0xFFD936B8, 7433, "" },
+    { 0xFFD980FF,  514, "" },
+    { 0xFFD9A6FF, 7438, "" },
+    { 0xFFD9A9A7, 4735, "" },
+    { 0xFFD9B200,  117, "" },
+    { 0xFFD9B5B0,  480, "" },
+    { 0xFFD9D9D9,  420, "" },
+    { 0xFFD9EDFC,  649, "" },
+    { 0xFFD9FAE1,  621, "" },
+    { 0xFFDAE6D5, 5665, "" },
+    { 0xFFDAE8D8,  441, "" },
+    { 0xFFDAE8E8, 5455, "" },
+    { 0xFFDB78FF,  245, "" },
+    { 0xFFDBA8FF,  257, "" },
+    { 0xFFDBE3BF,  453, "" },
+    { 0xFFDBF5FF,  656, "" },
+    { 0xFFDBFF36,  388, "" },
+    { 0xFFDBFFE8,  566, "" },
+    { 0xFFDBFFE8,  573, "" },
+    { 0xFFDC7EE0,  687, "" },
+    { 0xFFDCE8B0, 5797, "" },
+    { 0xFFDCF7EB, 5523, "" },
+    { 0xFFDCFAB9,  580, "" },
+    { 0xFFDDD1C1,   -1, "Warm Gray 2" },
+    { 0xFFDDD8CE,   -1, "Cool Gray 2" },
+    { 0xFFDDEDDA, 5595, "" },
+    { 0xFFDE004B,  193, "" },
+    { 0xFFDE82C4,  507, "" },
+    { 0xFFDE9CFF,  251, "" },
+    { 0xFFDED6DB,  435, "" },
+    { 0xFFDEDEA6, 5865, "" },
+    { 0xFFDEE3C8, 5803, "" },
+    { 0xFFDEE8FA,  538, "" },
+    { 0xFFDEFA55,  585, "" },
+    { 0xFFDEFF47,  380, "" },
+    { 0xFFE00053,  200, "" },
+    { 0xFFE03A00,   -1, "Warm Red 2X" },
+    { 0xFFE09270, 7515, "" },
+    { 0xFFE0C791,  466, "" },
+    { 0xFFE0D700,  606, "" },
+    { 0xFFE0FFB5,  365, "" },
+    { 0xFFE0FFFA, 7457, "" },
+    { 0xFFE18EFA,  680, "" },
+    { 0xFFE29100,   -1, "130 2X" },
+    { 0xFFE300FF,  233, "" },
+    { 0xFFE33000,  180, "" },
+    { 0xFFE336FF,  239, "" },
+    { 0xFFE37B00, 7414, "" },
+    { 0xFFE38DB3,  500, "" },
+    { 0xFFE39F40, 7510, "" },
+    { 0xFFE3AAC1, 5015, "" },
+    { 0xFFE3B122, 7407, "" },
+    { 0xFFE3DA9F, 4535, "" },
+    { 0xFFE3E112,  611, "" },
+    { 0xFFE3E3E3,  427, "" },
+    { 0xFFE3E8FF,  664, "" },
+    { 0xFFE3FF0F,  396, "" },
+    { 0xFFE4E4F2, 5315, "" },
+    { 0xFFE5DBCC,   -1, "Warm Gray 1" },
+    { 0xFFE66000, 1525, "" },
+    { 0xFFE667DF, 7432, "" },
+    { 0xFFE66EFF, 2375, "" },
+    { 0xFFE683BA,  694, "" },
+    { 0xFFE6ACB8, 7521, "" },
+    { 0xFFE6B577,  728, "" },
+    { 0xFFE6BC9C, 4665, "" },
+    { 0xFFE6BDFF,  523, "" },
+    { 0xFFE6BEBC, 4745, "" },
+    { 0xFFE6CCFF,  531, "" },
+    { 0xFFE6D395, 7502, "" },
+    { 0xFFE6D4E6, 5235, "" },
+    { 0xFFE6DBFF,  263, "" },
+    { 0xFFE6DFCF, 7528, "" },
+    { 0xFFE6E1D3, 7534, "" },
+    { 0xFFE6E645,  458, "" },
+    { 0xFFE6FF42,  387, "" },
+    { 0xFFE6FFAB,  372, "" },
+    { 0xFFE854FF,  674, "" },
+    { 0xFFE89538,  722, "" },
+    { 0xFFE89E00,  131, "" },
+    { 0xFFE89EFF,  244, "" },
+    { 0xFFE8CFC9,  481, "" },
+    { 0xFFE8CFF2, 5165, "" },
+    { 0xFFE8D9A8,  467, "" },
+    { 0xFFE8E2D6,   -1, "Cool Gray 1" },
+    { 0xFFE8E397,  616, "" },
+    { 0xFFE8EDD6,  454, "" },
+    { 0xFFE8FF6B,  379, "" },
+    { 0xFFE8FF78,  586, "" },
+    { 0xFFE9F0CE, 5807, "" },
+    { 0xFFEA4F00,   -1, "165 2X" },
+    { 0xFFEB009B,  214, "" },
+    { 0xFFEB6300,  718, "" },
+    { 0xFFEB7C00,  145, "" },
+    { 0xFFEBEBC0, 5875, "" },
+    { 0xFFEBFF00, 3965, "" },
+    { 0xFFEBFF26,  395, "" },
+    { 0xFFED0091,   -1, "Rhodamine Red" },
+    { 0xFFED18A6, 7425, "" },
+    { 0xFFED5100,  159, "" },
+    { 0xFFED8500, 1385, "" },
+    { 0xFFED8A00, 7412, "" },
+    { 0xFFED9EFF,  515, "" },
+    { 0xFFEDC2D1, 5025, "" },
+    { 0xFFEDCCFF,  256, "" },
+    { 0xFFEDD100,  110, "" },
+    { 0xFFEDE6E8,  434, "" },
+    { 0xFFEDE800,  605, "" },
+    { 0xFFEDE8DF, 7527, "" },
+    { 0xFFEDF0FF,  663, "" },
+    { 0xFFEDF2F2, 7541, "" },
+    { 0xFFEF2B2D,   -1, "Red 032" },
+    { 0xFFEF6B00,   -1, "Orange 021" },
+    { 0xFFF05EFF,  238, "" },
+    { 0xFFF082FF,  673, "" },
+    { 0xFFF0A8D3,  693, "" },
+    { 0xFFF0AD00,  124, "" },
+    { 0xFFF0CCFF, 7437, "" },
+    { 0xFFF0D5BD, 4675, "" },
+    { 0xFFF0D8D3, 4755, "" },
+    { 0xFFF0D9FF,  524, "" },
+    { 0xFFF0E6C0, 7501, "" },
+    { 0xFFF0E6ED, 5245, "" },
+    { 0xFFF0E8C4,  468, "" },
+    { 0xFFF0E9C2, 4545, "" },
+    { 0xFFF0ED73,  459, "" },
+    { 0xFFF0EDAF,  615, "" },
+    { 0xFFF0F065,  610, "" },
+    { 0xFFF0F2FF, 7443, "" },
+    { 0xFFF0FF00, 3955, "" },
+    { 0xFFF0FF3D,  394, "" },
+    { 0xFFF0FF70,  386, "" },
+    { 0xFFF0FFE6, 7485, "" },
+    { 0xFFF20068, 1935, "" },
+    { 0xFFF24961, 7418, "" },
+    { 0xFFF24BA0,  702, "" },
+    { 0xFFF26300, 1595, "" },
+    { 0xFFF283BB,  493, "" },
+    { 0xFFF296ED, 7431, "" },
+    { 0xFFF2A3E3,  508, "" },
+    { 0xFFF2AAF2,  686, "" },
+    { 0xFFF2B5FF,  243, "" },
+    { 0xFFF2B896, 7514, "" },
+    { 0xFFF2BAFF,  679, "" },
+    { 0xFFF2C279, 7509, "" },
+    { 0xFFF2CEA0,  727, "" },
+    { 0xFFF2D1FF,  250, "" },
+    { 0xFFF2E0DE,  482, "" },
+    { 0xFFF2E0F7, 5175, "" },
+    { 0xFFF2FF99,  587, "" },
+    { 0xFFF50002, 1797, "" },
+    { 0xFFF5002F,  186, "" },
+    { 0xFFF54C00,  173, "" },
+    { 0xFFF57300, 7413, "" },
+    { 0xFFF5D093, 7508, "" },
+    { 0xFFF5E4D3, 4685, "" },
+    { 0xFFF5F28F,  460, "" },
+    { 0xFFF5F584,  609, "" },
+    { 0xFFF5F5C4,  614, "" },
+    { 0xFFF70099,  206, "" },
+    { 0xFFF754FF,  232, "" },
+    { 0xFFF782FF,  237, "" },
+    { 0xFFF7A8FF,  672, "" },
+    { 0xFFF7B50C,   -1, "116 2X" },
+    { 0xFFF7B5D7,  501, "" },
+    { 0xFFF7BAF7,  685, "" },
+    { 0xFFF7BAFF,  516, "" },
+    { 0xFFF7BC77,  721, "" },
+    { 0xFFF7C9FF,  678, "" },
+    { 0xFFF7CBB2, 7513, "" },
+    { 0xFFF7DFE1, 5035, "" },
+    { 0xFFF7E214,   -1, "Process Yellow" },
+    { 0xFFF7EBFF, 7436, "" },
+    { 0xFFF7F2D2, 7500, "" },
+    { 0xFFF7F71E,  604, "" },
+    { 0xFFF7F7A6,  461, "" },
+    { 0xFFF7FF26, 3945, "" },
+    { 0xFFF7FF73,  393, "" },
+    { 0xFFF93F26,   -1, "Warm Red" },
+    { 0xFFFA0032,  711, "" },
+    { 0xFFFA63FF,  218, "" },
+    { 0xFFFA7000,  717, "" },
+    { 0xFFFAB0FF, 7430, "" },
+    { 0xFFFABAFF, 2365, "" },
+    { 0xFFFAC0E1,  692, "" },
+    { 0xFFFACFFA,  684, "" },
+    { 0xFFFADEFF,  677, "" },
+    { 0xFFFAE6C0,  726, "" },
+    { 0xFFFAFAAA,  608, "" },
+    { 0xFFFC1FFF,  219, "" },
+    { 0xFFFC2BFF,  225, "" },
+    { 0xFFFC5EFF,  224, "" },
+    { 0xFFFC7AFF,  231, "" },
+    { 0xFFFC7C00,  152, "" },
+    { 0xFFFC9200,  138, "" },
+    { 0xFFFCB3FF,  236, "" },
+    { 0xFFFCCCFF,  671, "" },
+    { 0xFFFCCFE3,  502, "" },
+    { 0xFFFCD7A7,  720, "" },
+    { 0xFFFCD7E8,  691, "" },
+    { 0xFFFCE016,   -1, "Pantone Yellow" },
+    { 0xFFFCE216,   -1, "Yellow 2X" },
+    { 0xFFFCFC4E,  603, "" },
+    { 0xFFFCFCCF,  607, "" },
+    { 0xFFFCFF52, 3935, "" },
+    { 0xFFFF0052,  192, "" },
+    { 0xFFFF0061,  199, "" },
+    { 0xFFFF0073, 1925, "" },
+    { 0xFFFF00FF,  226, "" },
+    { 0xFFFF0D00,  485, "" },
+    { 0xFFFF0DBA,  213, "" },
+    { 0xFFFF0F00, 1795, "" },
+    { 0xFFFF173D,  185, "" },
+    { 0xFFFF291F, 1788, "" },
+    { 0xFFFF29E8,  205, "" },
+    { 0xFFFF3600,  179, "" },
+    { 0xFFFF366B,  710, "" },
+    { 0xFFFF38AB,  198, "" },
+    { 0xFFFF3D66, 1787, "" },
+    { 0xFFFF3D9E,  191, "" },
+    { 0xFFFF4040, 7417, "" },
+    { 0xFFFF40B3, 7424, "" },
+    { 0xFFFF47E3,  212, "" },
+    { 0xFFFF4ACC, 1915, "" },
+    { 0xFFFF5200, 1665, "" },
+    { 0xFFFF5296,  184, "" },
+    { 0xFFFF5480, 1785, "" },
+    { 0xFFFF571F,  172, "" },
+    { 0xFFFF579E,  709, "" },
+    { 0xFFFF5C00,  166, "" },
+    { 0xFFFF5E17, 1655, "" },
+    { 0xFFFF6308,  158, "" },
+    { 0xFFFF6666, 7416, "" },
+    { 0xFFFF690A,  165, "" },
+    { 0xFFFF6970,  178, "" },
+    { 0xFFFF6BA3, 1777, "" },
+    { 0xFFFF6BF7,  204, "" },
+    { 0xFFFF701A, 1585, "" },
+    { 0xFFFF73C7,  190, "" },
+    { 0xFFFF73C7, 7423, "" },
+    { 0xFFFF73EB,  211, "" },
+    { 0xFFFF7852,  171, "" },
+    { 0xFFFF78CC,  701, "" },
+    { 0xFFFF8257, 1645, "" },
+    { 0xFFFF8500,  144, "" },
+    { 0xFFFF850D,  151, "" },
+    { 0xFFFF8717,  716, "" },
+    { 0xFFFF8796,  486, "" },
+    { 0xFFFF87B5, 1775, "" },
+    { 0xFFFF8A45,  164, "" },
+    { 0xFFFF8AC7,  708, "" },
+    { 0xFFFF8AC9,  183, "" },
+    { 0xFFFF8AFF,  223, "" },
+    { 0xFFFF8C47, 1575, "" },
+    { 0xFFFF8C99,  177, "" },
+    { 0xFFFF8CE6,  197, "" },
+    { 0xFFFF914D,  157, "" },
+    { 0xFFFF943B, 1505, "" },
+    { 0xFFFF96E8, 1905, "" },
+    { 0xFFFF991A, 1375, "" },
+    { 0xFFFF998F,  170, "" },
+    { 0xFFFF9C85, 1635, "" },
+    { 0xFFFF9CF0,  210, "" },
+    { 0xFFFF9EC9, 1765, "" },
+    { 0xFFFFA14A,  715, "" },
+    { 0xFFFFA1E6,  189, "" },
+    { 0xFFFFA3DB,  700, "" },
+    { 0xFFFFA61A,  137, "" },
+    { 0xFFFFA626,  143, "" },
+    { 0xFFFFA64D,  150, "" },
+    { 0xFFFFA64F, 7411, "" },
+    { 0xFFFFA6B8,  487, "" },
+    { 0xFFFFA87A,  472, "" },
+    { 0xFFFFA882, 1565, "" },
+    { 0xFFFFA8F7,  203, "" },
+    { 0xFFFFA8FF,  230, "" },
+    { 0xFFFFAB54, 1495, "" },
+    { 0xFFFFABDE,  494, "" },
+    { 0xFFFFB08F,  163, "" },
+    { 0xFFFFB0A1, 1625, "" },
+    { 0xFFFFB300,  130, "" },
+    { 0xFFFFB30D, 7409, "" },
+    { 0xFFFFB373, 7410, "" },
+    { 0xFFFFB3DB,  707, "" },
+    { 0xFFFFB517, 1235, "" },
+    { 0xFFFFB547, 1365, "" },
+    { 0xFFFFB83D,  142, "" },
+    { 0xFFFFB875,  714, "" },
+    { 0xFFFFB8ED, 1895, "" },
+    { 0xFFFFB8FF,  217, "" },
+    { 0xFFFFBA3D,  136, "" },
+    { 0xFFFFBA75, 1485, "" },
+    { 0xFFFFBAE0, 1767, "" },
+    { 0xFFFFBDCF,  488, "" },
+    { 0xFFFFBDE6,  182, "" },
+    { 0xFFFFBF0D, 7408, "" },
+    { 0xFFFFBFD1,  176, "" },
+    { 0xFFFFBFF5,  196, "" },
+    { 0xFFFFC20F,  123, "" },
+    { 0xFFFFC2E3,  495, "" },
+    { 0xFFFFC2E6,  699, "" },
+    { 0xFFFFC2ED,  509, "" },
+    { 0xFFFFC487,  149, "" },
+    { 0xFFFFC4A3,  473, "" },
+    { 0xFFFFC794,  156, "" },
+    { 0xFFFFC7A8, 1555, "" },
+    { 0xFFFFCC70, 1355, "" },
+    { 0xFFFFCCCC,  169, "" },
+    { 0xFFFFCF66,  135, "" },
+    { 0xFFFFCF7D,  141, "" },
+    { 0xFFFFCF96,  713, "" },
+    { 0xFFFFD100, 7406, "" },
+    { 0xFFFFD1D9, 7415, "" },
+    { 0xFFFFD1F7, 7429, "" },
+    { 0xFFFFD1FF,  517, "" },
+    { 0xFFFFD433,  122, "" },
+    { 0xFFFFD461, 1225, "" },
+    { 0xFFFFD4E6,  706, "" },
+    { 0xFFFFD4F0,  510, "" },
+    { 0xFFFFD600,  116, "" },
+    { 0xFFFFD63B,  129, "" },
+    { 0xFFFFD6A1,  148, "" },
+    { 0xFFFFD6CF, 7520, "" },
+    { 0xFFFFD6E8,  496, "" },
+    { 0xFFFFD6EB,  698, "" },
+    { 0xFFFFD9BD,  474, "" },
+    { 0xFFFFD9C7,  162, "" },
+    { 0xFFFFD9E3,  489, "" },
+    { 0xFFFFDB87, 1345, "" },
+    { 0xFFFFDBB0,  712, "" },
+    { 0xFFFFDEFF,  670, "" },
+    { 0xFFFFE0B8,  155, "" },
+    { 0xFFFFE34F,  121, "" },
+    { 0xFFFFE359,  128, "" },
+    { 0xFFFFE38C,  134, "" },
+    { 0xFFFFE3CC,  475, "" },
+    { 0xFFFFE3EB,  503, "" },
+    { 0xFFFFE600,  109, "" },
+    { 0xFFFFE600, 7405, "" },
+    { 0xFFFFE680, 7403, "" },
+    { 0xFFFFE6B3, 7507, "" },
+    { 0xFFFFE6BF,  719, "" },
+    { 0xFFFFE833,  115, "" },
+    { 0xFFFFE833, 7404, "" },
+    { 0xFFFFE86B,  120, "" },
+    { 0xFFFFE88C, 1215, "" },
+    { 0xFFFFE8F2,  705, "" },
+    { 0xFFFFE8F2, 7422, "" },
+    { 0xFFFFEB45,  114, "" },
+    { 0xFFFFED57,  113, "" },
+    { 0xFFFFED80,  127, "" },
+    { 0xFFFFF00D,  108, "" },
+    { 0xFFFFF0B3, 7402, "" },
+    { 0xFFFFF2B0, 1205, "" },
+    { 0xFFFFF2D9, 7506, "" },
+    { 0xFFFFF536,  107, "" },
+    { 0xFFFFF5D1, 7401, "" },
+    { 0xFFFFFA4F,  106, "" },
+    { 0xFFFFFAD9, 7499, "" },
+    { 0xFFFFFC0D,  102, "" },
+    { 0xFFFFFF36,  101, "" },
+    { 0xFFFFFF7D,  100, "" },
+    { 0xFFFFFF7D,  602, "" },
+    { 0xFFFFFF99,  601, "" },
+    { 0xFFFFFFB5,  600, "" }
+};
+
+static const short threadColorsByNumber_Pantone[] =
+{
+    1116, 1115, 1114, 729, 590, 413, 1112, 1110, 1106, 1092, 860, 628, 508, 1104, 1103, 1097, 1074, 759, 627, 423,
+    1099, 1087, 1070, 1053, 871, 637, 518, 1105, 1088, 1075, 1035, 834, 584, 367, 1089, 1063, 1045, 1022, 949, 668,
+    387, 1064, 1041, 1023, 999, 848, 559, 366, 1076, 1057, 1024, 1000, 948, 724, 546, 1086, 1059, 1011, 986, 854, 564,
+    311, 1081, 1033, 1004, 988, 984, 738, 348, 1062, 1015, 996, 982, 907, 525, 338, 1051, 1009, 989, 970, 800, 436,
+    1049, 1006, 980, 967, 906, 686, 410, 1020, 993, 974, 960, 781, 556, 374, 1052, 1010, 972, 961, 790, 599, 461,
+    1029, 991, 969, 914, 711, 515, 393, 1017, 995, 977, 965, 846, 623, 419, 1044, 935, 944, 737, 581, 346, 1007, 946,
+    945, 963, 712, 482, 334, 1030, 947, 915, 799, 580, 462, 950, 916, 868, 801, 720, 610, 385, 896, 835, 767, 601,
+    524, 483, 362, 901, 783, 657, 463, 409, 316, 859, 768, 464, 321, 306, 284, 244, 826, 640, 388, 220, 173, 195, 184,
+    577, 471, 357, 6, 2, 127, 124, 631, 502, 288, 38, 31, 23, 541, 380, 176, 53, 47, 40, 22, 651, 563, 426, 63, 52,
+    42, 26, 427, 281, 189, 80, 64, 58, 37, 597, 407, 248, 90, 72, 45, 476, 320, 140, 113, 101, 82, 51, 733, 512, 402,
+    117, 105, 96, 74, 621, 370, 182, 111, 98, 78, 60, 663, 596, 473, 122, 100, 73, 579, 437, 198, 114, 102, 81, 126,
+    635, 511, 382, 121, 104, 84, 144, 747, 634, 510, 216, 150, 136, 163, 633, 532, 360, 282, 259, 243, 218, 795, 703,
+    568, 364, 328, 289, 247, 831, 754, 662, 491, 384, 359, 252, 842, 789, 701, 609, 536, 459, 344, 886, 830, 771, 702,
+    611, 480, 396, 932, 885, 851, 811, 699, 562, 469, 753, 669, 576, 467, 369, 265, 752, 639, 549, 448, 368, 264, 130,
+    696, 593, 487, 414, 297, 240, 0, 761, 641, 560, 457, 331, 232, 1, 809, 706, 550, 433, 287, 203, 135, 861, 784,
+    659, 445, 228, 197, 181, 765, 643, 506, 408, 267, 211, 193, 204, 239, 286, 561, 660, 769, 841, 300, 466, 616, 829,
+    880, 911, 930, 246, 356, 479, 692, 793, 838, 878, 270, 557, 723, 1027, 1058, 1080, 1090, 225, 278, 355, 575, 760,
+    836, 902, 335, 600, 964, 1002, 1026, 1048, 1082, 262, 399, 477, 892, 1032, 1054, 1078, 224, 339, 431, 803, 919,
+    952, 1091, 210, 325, 390, 782, 894, 1056, 1073, 235, 326, 441, 756, 857, 921, 1069, 205, 254, 308, 626, 740, 821,
+    875, 192, 231, 256, 484, 638, 728, 823, 13, 21, 29, 478, 578, 680, 787, 25, 34, 41, 318, 489, 594, 682, 125, 33,
+    43, 295, 403, 523, 675, 160, 156, 166, 341, 492, 630, 709, 145, 158, 168, 398, 520, 672, 772, 148, 161, 129, 434,
+    569, 671, 773, 209, 242, 280, 572, 653, 707, 777, 257, 395, 530, 736, 788, 843, 904, 1119, 1118, 1117, 957, 929,
+    862, 794, 958, 943, 912, 882, 808, 695, 589, 913, 881, 840, 745, 591, 468, 394, 763, 632, 503, 373, 273, 165, 128,
+    716, 553, 439, 290, 159, 103, 89, 570, 453, 383, 201, 119, 108, 97, 734, 619, 447, 333, 258, 54, 30, 762, 645,
+    481, 314, 49, 36, 28, 770, 661, 488, 315, 167, 48, 39, 864, 810, 683, 533, 351, 241, 179, 1085, 951, 917, 869,
+    832, 705, 636, 941, 923, 898, 797, 654, 544, 418, 940, 920, 895, 774, 666, 505, 347, 954, 939, 870, 817, 647, 493,
+    404, 1079, 1055, 1021, 997, 890, 750, 622, 1101, 1072, 1038, 1005, 983, 971, 934, 1084, 1065, 1042, 1019, 1001,
+    936, 847, 1096, 953, 922, 833, 739, 516, 421, 942, 900, 819, 725, 602, 386, 310, 1108, 1100, 1071, 1039, 726, 548,
+    406, 1083, 1061, 1040, 1014, 855, 517, 317, 1046, 1031, 1012, 814, 507, 263, 1060, 1028, 1008, 992, 891, 582, 465,
+    1034, 1016, 998, 985, 979, 614, 454, 1018, 1047, 1003, 990, 981, 973, 968, 966, 905, 665, 612, 405, 296, 1043,
+    1013, 978, 962, 888, 710, 514, 938, 816, 713, 624, 543, 504, 391, 714, 678, 604, 585, 587, 495, 442, 443, 349,
+    337, 330, 185, 309, 274, 202, 277, 285, 206, 234, 261, 194, 617, 497, 389, 327, 134, 141, 498, 715, 746, 642, 363,
+    451, 608, 293, 233, 222, 271, 139, 10, 12, 19, 8, 11, 16, 15, 4, 7, 18, 24, 3, 5, 14, 17, 490, 352, 188, 79, 67,
+    56, 35, 598, 354, 169, 93, 76, 62, 46, 475, 319, 200, 115, 106, 92, 57, 521, 552, 474, 438, 428, 353, 272, 283,
+    170, 123, 146, 118, 112, 116, 110, 77, 109, 86, 50, 59, 44, 542, 452, 332, 190, 107, 85, 55, 959, 931, 884, 850,
+    607, 486, 312, 279, 444, 528, 658, 743, 807, 879, 219, 456, 615, 727, 820, 873, 910, 249, 420, 547, 649, 758, 822,
+    874, 213, 432, 545, 667, 805, 858, 925, 199, 299, 422, 586, 741, 837, 903, 171, 236, 400, 603, 742, 825, 877, 143,
+    180, 226, 372, 551, 679, 812, 20, 230, 304, 397, 618, 698, 766, 27, 9, 164, 177, 253, 268, 379, 425, 501, 519,
+    681, 644, 776, 748, 151, 212, 305, 430, 554, 685, 780, 132, 207, 303, 440, 571, 673, 764, 178, 183, 245, 292, 313,
+    429, 458, 535, 574, 708, 684, 775, 786, 844, 221, 350, 496, 592, 730, 785, 849, 1111, 1107, 1094, 1098, 1093,
+    1066, 806, 1050, 1036, 1037, 1025, 856, 908, 802, 1067, 987, 975, 889, 722, 688, 329, 1102, 994, 976, 853, 718,
+    613, 375, 1068, 937, 893, 815, 755, 689, 537, 927, 872, 757, 691, 588, 527, 411, 883, 697, 567, 470, 291, 276,
+    191, 700, 499, 415, 416, 378, 215, 358, 796, 460, 323, 120, 227, 65, 32, 652, 417, 275, 147, 95, 68, 175, 620,
+    401, 260, 162, 302, 61, 152, 732, 381, 343, 342, 217, 157, 71, 887, 704, 595, 472, 324, 307, 345, 731, 674, 531,
+    435, 322, 377, 187, 1113, 928, 876, 824, 650, 494, 376, 1109, 1095, 909, 899, 804, 648, 558, 924, 897, 792, 539,
+    455, 340, 251, 1077, 818, 751, 690, 625, 583, 538, 863, 827, 744, 565, 412, 301, 186, 828, 694, 566, 677, 522,
+    513, 266, 865, 656, 540, 446, 269, 208, 138
+};
+
+static const ThreadColor threadColors_RobisonAnton_Rayon[] =
+{
+    { 0xFF002649, 2647, "Pro College Blue" },
+    { 0xFF002654, 2613, "Pro Midnight" },
+    { 0xFF002654, 2609, "TH Navy" },
+    { 0xFF002B7F, 2438, "Blue Suede" },
+    { 0xFF002D47, 2620, "Pro Dark Blue" },
+    { 0xFF00337F, 2627, "Pro Royal" },
+    { 0xFF003893, 2436, "Fire Blue" },
+    { 0xFF003D6B, 2534, "Salem Blue" },
+    { 0xFF003F54, 2589, "Deep Windsor" },
+    { 0xFF003F54, 2444, "Dark Teal" },
+    { 0xFF004438, 2734, "Pro Dark Green" },
+    { 0xFF00494F, 2549, "Blue Spruce" },
+    { 0xFF0051BA, 2619, "Pro Brilliance" },
+    { 0xFF0054A0, 2442, "Solar Blue" },
+    { 0xFF006056, 2451, "Green Forest" },
+    { 0xFF006056, 2743, "Pro Forest" },
+    { 0xFF006663, 2447, "Garden Green" },
+    { 0xFF006663, 2449, "Fern Green" },
+    { 0xFF006854, 2607, "TH Green" },
+    { 0xFF006B3F, 2454, "Fleece Green" },
+    { 0xFF006B3F, 2284, "Deep Green" },
+    { 0xFF006B54, 2455, "Green Bay" },
+    { 0xFF006B77, 2621, "Pro Teal" },
+    { 0xFF006D66, 2735, "Pro Green" },
+    { 0xFF006D66, 2615, "Pro Hunter" },
+    { 0xFF006D75, 2521, "Mallard Blue" },
+    { 0xFF006D75, 2446, "Oceanic Green" },
+    { 0xFF00709E, 2737, "Pro Band Blue" },
+    { 0xFF007272, 2445, "M.D. Green" },
+    { 0xFF007A3D, 2453, "Dark Emerald" },
+    { 0xFF007A3D, 2410, "Light Kelly" },
+    { 0xFF007A3D, 2240, "Kelly" },
+    { 0xFF007AA5, 2740, "Pro Peacock" },
+    { 0xFF007C66, 2597, "Jungle Green" },
+    { 0xFF008272, 2448, "Greenstone" },
+    { 0xFF008751, 2208, "Dark Green" },
+    { 0xFF008789, 2492, "J. Turquoise" },
+    { 0xFF008C82, 2514, "Brite Jade" },
+    { 0xFF008C82, 2391, "Pine Green" },
+    { 0xFF008ED6, 2441, "Baltic Blue" },
+    { 0xFF008ED6, 2388, "Pacific Blue" },
+    { 0xFF009E49, 2579, "Vibrant Green" },
+    { 0xFF009E49, 2580, "Green Grass" },
+    { 0xFF00A0C4, 2389, "California Blue" },
+    { 0xFF00A3DD, 2520, "Mid Windsor" },
+    { 0xFF00A3DD, 2730, "Boo Boo Blue" },
+    { 0xFF00A5DB, 2519, "Surf Blue" },
+    { 0xFF00ADC6, 2307, "Aquamarine" },
+    { 0xFF00B2A0, 2515, "Bluestone" },
+    { 0xFF024930, 2315, "Evergreen" },
+    { 0xFF024930, 2458, "Green Petal" },
+    { 0xFF0C3026, 2552, "Ivy" },
+    { 0xFF0F2B5B, 2439, "Blue Ribbon" },
+    { 0xFF112151, 2303, "Light Navy" },
+    { 0xFF14213D, 2603, "Flag Blue" },
+    { 0xFF14213D, 2215, "Navy" },
+    { 0xFF14213D, 2387, "Midnight Navy" },
+    { 0xFF192168, 2625, "Pro Navy" },
+    { 0xFF193833, 2459, "Green Sail" },
+    { 0xFF1C2630, 2296, "Black" },
+    { 0xFF1C2630, 2632, "Jet Black" },
+    { 0xFF1E1C77, 2210, "Royal" },
+    { 0xFF1E1C77, 2429, "Purple Twist" },
+    { 0xFF1EB53A, 2578, "Harvest Green" },
+    { 0xFF213D30, 2728, "Army Green" },
+    { 0xFF215B33, 2323, "Holly" },
+    { 0xFF233A2D, 2553, "Dark Army Green" },
+    { 0xFF265142, 2460, "Field Green" },
+    { 0xFF26547C, 2612, "Pro Imperial" },
+    { 0xFF282D26, 2411, "D.H. Green" },
+    { 0xFF28C4D8, 2306, "Periwinkle" },
+    { 0xFF2B1166, 2736, "Pro Brite Star" },
+    { 0xFF2B265B, 2440, "Blue Ink" },
+    { 0xFF2B4C3F, 2631, "Lizzy Lime" },
+    { 0xFF2D338E, 2220, "Blue" },
+    { 0xFF2D338E, 2280, "Sapphire" },
+    { 0xFF2D338E, 2385, "Jamie Blue" },
+    { 0xFF2DC6D6, 2518, "Indian Ocean Blue" },
+    { 0xFF332875, 2427, "Violet Blue" },
+    { 0xFF335687, 2302, "Imperial Blue" },
+    { 0xFF335687, 2523, "China Blue" },
+    { 0xFF339E35, 2214, "Emerald" },
+    { 0xFF35006D, 2428, "Purple Maze" },
+    { 0xFF35006D, 2628, "Pro Purple" },
+    { 0xFF35264F, 2450, "Fleet Blue" },
+    { 0xFF353842, 2487, "Smokey" },
+    { 0xFF353F5B, 2386, "Light Midnight" },
+    { 0xFF35C4AF, 2390, "Peppermint" },
+    { 0xFF38197A, 2742, "Pro Violet" },
+    { 0xFF3A4972, 2341, "Ash" },
+    { 0xFF3A564F, 2535, "Enchanted Sea" },
+    { 0xFF3A75C4, 2529, "Dolphin Blue" },
+    { 0xFF3A7728, 2209, "Green" },
+    { 0xFF3D3028, 2566, "Best Brown" },
+    { 0xFF3F2893, 2437, "Empire Blue" },
+    { 0xFF3F302B, 2337, "Espresso" },
+    { 0xFF3F302B, 2564, "Mahogany" },
+    { 0xFF3F4926, 2601, "Hedge" },
+    { 0xFF3F4926, 2584, "Dress Green" },
+    { 0xFF44235E, 2431, "Purple Accent" },
+    { 0xFF443D38, 2541, "Black Chrome" },
+    { 0xFF443D38, 2565, "Aged Charcoal" },
+    { 0xFF47D6C1, 2516, "Aqua Pearl" },
+    { 0xFF493533, 2576, "Egyptian Brown" },
+    { 0xFF4C145E, 2381, "Dark Purple" },
+    { 0xFF4F213A, 2376, "Dark Maroon" },
+    { 0xFF4F6D5E, 2392, "Harbor Green" },
+    { 0xFF4F6D5E, 2550, "Newport" },
+    { 0xFF512654, 2600, "Port Wine" },
+    { 0xFF512D44, 2616, "Pro Maroon" },
+    { 0xFF546856, 2554, "Water Lilly" },
+    { 0xFF547730, 2595, "Sage" },
+    { 0xFF566314, 2229, "Palmetto" },
+    { 0xFF568E14, 2226, "Meadow" },
+    { 0xFF56AA1C, 2738, "Pro Erin" },
+    { 0xFF593344, 2587, "Intense Maroon" },
+    { 0xFF593D2B, 2251, "Brown" },
+    { 0xFF593D2B, 2372, "Dark Brown" },
+    { 0xFF593D2B, 2563, "Dogwood" },
+    { 0xFF5960A8, 2527, "Soldier Blue" },
+    { 0xFF5B027A, 2430, "Purple Shadow" },
+    { 0xFF5B2D28, 2339, "Coffee Bean" },
+    { 0xFF5B77CC, 2614, "Pro Lusty Blue" },
+    { 0xFF5B77CC, 2384, "Jay Blue" },
+    { 0xFF5E663A, 2317, "Olive Drab" },
+    { 0xFF5E99AA, 2577, "Wonder Blue" },
+    { 0xFF5E99AA, 2308, "Misty" },
+    { 0xFF609191, 2443, "Mystic Teal" },
+    { 0xFF609191, 2309, "Teal" },
+    { 0xFF60AFDD, 2533, "Ozone" },
+    { 0xFF63305E, 2490, "Plum Wine" },
+    { 0xFF633A11, 2567, "Mushroom" },
+    { 0xFF66116D, 2380, "Mulberry" },
+    { 0xFF661E2B, 2496, "Warm Wine" },
+    { 0xFF66594C, 2575, "Dark Taupe" },
+    { 0xFF666D70, 2407, "Metal" },
+    { 0xFF6689CC, 2526, "Bright Blue" },
+    { 0xFF6689CC, 2528, "Atlantis Blue" },
+    { 0xFF6689CC, 2435, "Blue Horizon" },
+    { 0xFF686663, 2729, "Mineral" },
+    { 0xFF686663, 2217, "Twilight" },
+    { 0xFF6B4714, 2477, "Sand Dune" },
+    { 0xFF6C463D, 2610, "Pro Brown" },
+    { 0xFF6D213F, 2498, "Brushed Burgundy" },
+    { 0xFF6D87A8, 2275, "Slate Blue" },
+    { 0xFF6D87A8, 2245, "Copen" },
+    { 0xFF707014, 2545, "Cypress" },
+    { 0xFF70CE9B, 2311, "Seafoam" },
+    { 0xFF70CE9B, 2312, "Isle Green" },
+    { 0xFF75263D, 2622, "Pro Firebrand" },
+    { 0xFF75263D, 2421, "Red Jubilee" },
+    { 0xFF755426, 2629, "Pro Walnut" },
+    { 0xFF755426, 2478, "Light Cocoa" },
+    { 0xFF755426, 2402, "Sienna" },
+    { 0xFF75AADB, 2530, "Caribbean Blue" },
+    { 0xFF75AADB, 2434, "Tropic Blue" },
+    { 0xFF75B2DD, 2433, "Ultra Blue" },
+    { 0xFF772D35, 2225, "Wine" },
+    { 0xFF777772, 2265, "Charcoal" },
+    { 0xFF779182, 2202, "Olive" },
+    { 0xFF779182, 2551, "Spring Garden" },
+    { 0xFF7796B2, 2524, "Country Blue" },
+    { 0xFF7796B2, 2624, "Pro Saxon" },
+    { 0xFF7A2638, 2252, "Russet" },
+    { 0xFF7A5B11, 2569, "Earthen Tan" },
+    { 0xFF7AA891, 2278, "Moss" },
+    { 0xFF7AA891, 2594, "Wintergreen" },
+    { 0xFF7C2128, 2608, "TH Burgundy" },
+    { 0xFF7F8CBF, 2301, "Oriental Blue" },
+    { 0xFF7FBA00, 2321, "Pastoral Green" },
+    { 0xFF7FBA00, 2457, "Green Dust" },
+    { 0xFF7FBA00, 2322, "Ming" },
+    { 0xFF7FD6DB, 2204, "Turquoise" },
+    { 0xFF848205, 2546, "Crescent Moon" },
+    { 0xFF8499A5, 2617, "Pro Twinkle" },
+    { 0xFF876028, 2227, "Chocolate" },
+    { 0xFF87DDD1, 2517, "Seafrost" },
+    { 0xFF897719, 2544, "Desert Cactus" },
+    { 0xFF8977BA, 2287, "Mauve" },
+    { 0xFF8C2633, 2249, "Burgundy" },
+    { 0xFF8C2633, 2268, "Carolina Red" },
+    { 0xFF8C8984, 2731, "Gull" },
+    { 0xFF8C8984, 2484, "Silvery Gray" },
+    { 0xFF8CD600, 2320, "Erin Green" },
+    { 0xFF8E2344, 2497, "Perfect Ruby" },
+    { 0xFF8E2344, 2499, "Passion Rose" },
+    { 0xFF8E47AD, 2425, "Laurie Lilac" },
+    { 0xFF8E47AD, 2254, "Purple" },
+    { 0xFF8E6877, 2422, "Ducky Mauve" },
+    { 0xFF919693, 2585, "Banner Gray" },
+    { 0xFF931638, 2494, "Carbernet" },
+    { 0xFF939905, 2230, "Tamarack" },
+    { 0xFF93DDDB, 2310, "Mint Julep" },
+    { 0xFF93DDDB, 2452, "Green Pearl" },
+    { 0xFF93DDDB, 2393, "Sea Mist" },
+    { 0xFF992135, 2270, "Cranberry" },
+    { 0xFF99840A, 2542, "Foliage Green" },
+    { 0xFF99897C, 2739, "Pro Gray" },
+    { 0xFF998E07, 2548, "Sun Shadow" },
+    { 0xFF99BADD, 2206, "Baby Blue" },
+    { 0xFF99D6DD, 2305, "Blue Frost" },
+    { 0xFF9B4F19, 2290, "Date" },
+    { 0xFF9B4F19, 2481, "Hazel" },
+    { 0xFF9B4F96, 2426, "Raspberry" },
+    { 0xFF9BAABF, 2536, "Rockport Blue" },
+    { 0xFF9BC4E2, 2239, "Sky Blue" },
+    { 0xFF9E2387, 2292, "Plum" },
+    { 0xFF9EAA99, 2221, "Willow" },
+    { 0xFFA03033, 2334, "Terra Cotta" },
+    { 0xFFA0DB8E, 2211, "Nile" },
+    { 0xFFA2464E, 2611, "Pro Cinnamon" },
+    { 0xFFA32638, 2267, "Wildfire" },
+    { 0xFFA32638, 2505, "Antique Red" },
+    { 0xFFA37F14, 2562, "Bullion" },
+    { 0xFFA37F14, 2333, "Ginger" },
+    { 0xFFA38205, 2543, "Autumn Green" },
+    { 0xFFA3AF07, 2456, "Peapod" },
+    { 0xFFA53F0F, 2581, "Old Dark Tex Orange" },
+    { 0xFFA5BAE0, 2383, "Cristy Blue" },
+    { 0xFFA893AD, 2406, "Sterling" },
+    { 0xFFAA004F, 2504, "Cherrystone" },
+    { 0xFFAA004F, 2417, "Cherry Punch" },
+    { 0xFFAA004F, 2432, "Strawberry" },
+    { 0xFFAA0066, 2590, "Hot Peony" },
+    { 0xFFAA753F, 2489, "Wicker" },
+    { 0xFFAA753F, 2224, "Beige" },
+    { 0xFFAADD6D, 2279, "Spruce" },
+    { 0xFFAD0075, 2500, "New Berry" },
+    { 0xFFADA07A, 2572, "Grayrod" },
+    { 0xFFADA07A, 2573, "Pewter" },
+    { 0xFFADAFAA, 2540, "Traditional Gray" },
+    { 0xFFADAFAA, 2618, "Pro Night Sky" },
+    { 0xFFADAFAA, 2592, "Silver Steel" },
+    { 0xFFAF003D, 2507, "Candy Apple Red" },
+    { 0xFFAF1E2D, 2418, "Red Berry" },
+    { 0xFFAF1E2D, 2623, "Pro Red" },
+    { 0xFFAF1E2D, 2472, "Auburn" },
+    { 0xFFAF72C1, 2288, "Iris" },
+    { 0xFFAF7505, 2295, "Copper" },
+    { 0xFFAF7505, 2479, "Almond" },
+    { 0xFFAFAAA3, 2483, "Cloud" },
+    { 0xFFAFBCDB, 2304, "Lake Blue" },
+    { 0xFFAFBCDB, 2522, "Bridgeport Blue" },
+    { 0xFFAFBCDB, 2269, "Sun Blue" },
+    { 0xFFB26B70, 2480, "K.A. Bronze" },
+    { 0xFFB28260, 2488, "Cocoa Mulch" },
+    { 0xFFB2A8B5, 2486, "Storm Gray" },
+    { 0xFFB2D8D8, 2313, "Sprite" },
+    { 0xFFB58CB2, 2424, "Cachet" },
+    { 0xFFB5939B, 2314, "Satin Wine" },
+    { 0xFFB5CC8E, 2319, "Green Oak" },
+    { 0xFFB5D1E8, 2300, "Ice Blue" },
+    { 0xFFB5E8BF, 2238, "Mint" },
+    { 0xFFBA7530, 2231, "Toast" },
+    { 0xFFBAB7AF, 2741, "Pro Pearl" },
+    { 0xFFBC4F07, 2289, "Rust" },
+    { 0xFFBCC1B2, 2241, "Palm Leaf" },
+    { 0xFFBF0A30, 2281, "Jockey Red" },
+    { 0xFFBF0A30, 2419, "Very Red" },
+    { 0xFFBF0A30, 2378, "Red Berry" },
+    { 0xFFBF0A30, 2233, "Lipstick" },
+    { 0xFFBF910C, 2201, "Old Gold" },
+    { 0xFFBF910C, 2400, "Topaz" },
+    { 0xFFBFBAAF, 2537, "Steel" },
+    { 0xFFC13828, 2205, "Dark Rust" },
+    { 0xFFC18E60, 2493, "Light Bronze" },
+    { 0xFFC18E60, 2338, "Bamboo" },
+    { 0xFFC1A875, 2474, "Rattan" },
+    { 0xFFC1A875, 2568, "Perfect Tan" },
+    { 0xFFC1A875, 2570, "Golden Tan" },
+    { 0xFFC1B5A5, 2571, "Platinum" },
+    { 0xFFC1C9DD, 2525, "Heron Blue" },
+    { 0xFFC1C9DD, 2598, "Blue Hint" },
+    { 0xFFC41E3A, 2219, "Scarlet" },
+    { 0xFFC41E3A, 2266, "Radiant Red" },
+    { 0xFFC41E3A, 2506, "Devil Red" },
+    { 0xFFC4C1BA, 2733, "Pro Cool Gray" },
+    { 0xFFC4D8E2, 2531, "Dana Blue" },
+    { 0xFFC4D8E2, 2532, "Cadet Blue" },
+    { 0xFFC6A00C, 2561, "Black Eyed Susie" },
+    { 0xFFC6A00C, 2596, "Marine Gold" },
+    { 0xFFC6A00C, 2471, "Shimmering Gold" },
+    { 0xFFC6D1D6, 2382, "Pastel Blue" },
+    { 0xFFC6D6A0, 2282, "Flite Green" },
+    { 0xFFC9ADD8, 2286, "Tulip" },
+    { 0xFFC9D6A3, 2555, "Pastel Green" },
+    { 0xFFC9E8DD, 2222, "Light Blue" },
+    { 0xFFC9E8DD, 2318, "Pale Green" },
+    { 0xFFCCC1B2, 2538, "Stainless Steel" },
+    { 0xFFCCC1C6, 2482, "Skylight" },
+    { 0xFFCCC1C6, 2404, "Cinder" },
+    { 0xFFCCC1C6, 2405, "Dover Gray" },
+    { 0xFFCCC693, 2250, "Pistachio" },
+    { 0xFFCE007C, 2259, "Wild Pink" },
+    { 0xFFCE007C, 2291, "Passion" },
+    { 0xFFCE1126, 2263, "Foxy Red" },
+    { 0xFFD18E54, 2401, "Ashley Gold" },
+    { 0xFFD1BF91, 2298, "Taupe" },
+    { 0xFFD1CCBF, 2539, "Chrome" },
+    { 0xFFD1CEDD, 2283, "Paris Blue" },
+    { 0xFFD36B9E, 2260, "Hot Pink" },
+    { 0xFFD3A87C, 2273, "Tan" },
+    { 0xFFD3A87C, 2475, "Mocha Cream" },
+    { 0xFFD3B7A3, 2272, "Grape" },
+    { 0xFFD60270, 2416, "Crimson" },
+    { 0xFFD62828, 2420, "Tuxedo Red" },
+    { 0xFFD6CCAF, 2476, "Seashell" },
+    { 0xFFD81C3F, 2508, "Rosewood" },
+    { 0xFFD8899B, 2591, "Rose Tint" },
+    { 0xFFD88C02, 2602, "24 Kt. Gold" },
+    { 0xFFD8B596, 2336, "Amber Beige" },
+    { 0xFFD8CCD1, 2274, "Steel Gray" },
+    { 0xFFDBD3D3, 2340, "Pearl Gray" },
+    { 0xFFDBD3D3, 2485, "Saturn Gray" },
+    { 0xFFDDC6C4, 2271, "Heather" },
+    { 0xFFDDC6C4, 2207, "Gray" },
+    { 0xFFE0AA0F, 2556, "Pollen Gold" },
+    { 0xFFE0AA0F, 2331, "Mustard" },
+    { 0xFFE0AA0F, 2212, "Sun Gold" },
+    { 0xFFE0AA0F, 2470, "Karat" },
+    { 0xFFE22882, 2261, "Ruby Glint" },
+    { 0xFFE23D28, 2513, "Honeysuckle" },
+    { 0xFFE29ED6, 2588, "Mid Lilac" },
+    { 0xFFE2BF9B, 2203, "Gold" },
+    { 0xFFE2D6B5, 2630, "Pro Beige" },
+    { 0xFFE2E584, 2547, "Pebblestone" },
+    { 0xFFE5566D, 2246, "Shrimp" },
+    { 0xFFE5566D, 2228, "Begonia" },
+    { 0xFFE5566D, 2491, "Primrose" },
+    { 0xFFE5BFC6, 2379, "Orchid" },
+    { 0xFFEA0F6B, 2262, "Cherry Blossom" },
+    { 0xFFEAB2B2, 2299, "Salmon" },
+    { 0xFFEADD96, 2461, "Wheat" },
+    { 0xFFED72AA, 2415, "Floral Pink" },
+    { 0xFFEDC4DD, 2285, "Violet" },
+    { 0xFFEDD3B5, 2593, "Cottage Beige" },
+    { 0xFFEDD3BC, 2232, "Ecru" },
+    { 0xFFEFC6D3, 2599, "Pink Bazaar" },
+    { 0xFFEFC6D3, 2276, "Lavender" },
+    { 0xFFEFCCCE, 2243, "Light Pink" },
+    { 0xFFF0E8D6, 2343, "Eggshell" },
+    { 0xFFF26877, 2375, "Dusty Rose" },
+    { 0xFFF2AFC1, 2237, "Carnation" },
+    { 0xFFF2BF49, 2332, "Penny" },
+    { 0xFFF2BF49, 2586, "14 Kt. Gold" },
+    { 0xFFF2C4AF, 2377, "Bisque" },
+    { 0xFFF2CE68, 2606, "TH Gold" },
+    { 0xFFF2E3C4, 2604, "Light Maize" },
+    { 0xFFF2EABC, 2316, "Celery" },
+    { 0xFFF43F4F, 2277, "Persimmon" },
+    { 0xFFF4476B, 2248, "Bashful Pink" },
+    { 0xFFF4BFD1, 2502, "Memphis Belle" },
+    { 0xFFF4CCAA, 2413, "Flesh" },
+    { 0xFFF4E287, 2557, "Pale Yellow" },
+    { 0xFFF4ED47, 2325, "Lemon" },
+    { 0xFFF5E3CC, 2574, "Aspen White" },
+    { 0xFFF5EBE0, 2403, "Oyster" },
+    { 0xFFF5EBE0, 2297, "Snow White" },
+    { 0xFFF5EDDE, 2342, "Natural White" },
+    { 0xFFF74902, 2467, "Orangeade" },
+    { 0xFFF74902, 2397, "Sun Orange" },
+    { 0xFFF77F00, 2328, "Pumpkin" },
+    { 0xFFF7BFBF, 2503, "Desert Bloom" },
+    { 0xFFF7BFBF, 2255, "Opal Mist" },
+    { 0xFFF7D3B5, 2473, "Opaline" },
+    { 0xFFF7E8AA, 2559, "Tusk" },
+    { 0xFFF7E8AA, 2324, "Chinese Yellow" },
+    { 0xFFF7E8AA, 2264, "Maize" },
+    { 0xFFF93F26, 2329, "Saffron" },
+    { 0xFFF95602, 2236, "Paprika" },
+    { 0xFFF95602, 2468, "Tex Orange" },
+    { 0xFFF96302, 2469, "Dark Tex Orange" },
+    { 0xFFF96B07, 2218, "Orange" },
+    { 0xFFF9848E, 2412, "Azalea" },
+    { 0xFFF98972, 2414, "Coral" },
+    { 0xFFF98972, 2512, "Melonade" },
+    { 0xFFF98E6D, 2294, "Melon" },
+    { 0xFFF99B0C, 2327, "Honeydew" },
+    { 0xFFF9A58C, 2258, "Flamingo" },
+    { 0xFFF9AFAD, 2374, "Emily Pink" },
+    { 0xFFF9B2B7, 2373, "Pink Mist" },
+    { 0xFFF9B2B7, 2495, "Mountain Rose" },
+    { 0xFFF9BAAA, 2253, "Flesh Pink" },
+    { 0xFFF9BAAA, 2511, "Illusion" },
+    { 0xFFF9BF9E, 2256, "Tawny" },
+    { 0xFFF9C6AA, 2257, "Peach" },
+    { 0xFFF9C6AA, 2510, "Peach Blossom" },
+    { 0xFFF9DD16, 2560, "Moonbeam" },
+    { 0xFFF9DD16, 2462, "Sunflower" },
+    { 0xFFF9E08C, 2732, "Pro Maize" },
+    { 0xFFF9E814, 2326, "Daffodil" },
+    { 0xFFFAE6CC, 2582, "Bone" },
+    { 0xFFFAE6CF, 2335, "Ivory" },
+    { 0xFFFC5E72, 2509, "Bitteroot" },
+    { 0xFFFC8744, 2330, "Golden Poppy" },
+    { 0xFFFC8C99, 2244, "Rose Cerise" },
+    { 0xFFFC9BB2, 2293, "Rose" },
+    { 0xFFFCA311, 2394, "Mango" },
+    { 0xFFFCA311, 2409, "Yellow Mist" },
+    { 0xFFFCA311, 2213, "Yellow" },
+    { 0xFFFCB514, 2463, "Merit Gold" },
+    { 0xFFFCBA5E, 2247, "Honey" },
+    { 0xFFFCBF49, 2465, "Scholastic" },
+    { 0xFFFCBFC9, 2223, "Pink" },
+    { 0xFFFCBFC9, 2423, "Pale Orchid" },
+    { 0xFFFCC9C6, 2501, "Petal Pink" },
+    { 0xFFFCCE87, 2398, "Visor Gold" },
+    { 0xFFFCCE87, 2399, "New Gold" },
+    { 0xFFFCD116, 2466, "Manila" },
+    { 0xFFFCD116, 2242, "Goldenrod" },
+    { 0xFFFCD856, 2408, "Star Gold" },
+    { 0xFFFCE016, 2235, "Canary Yellow" },
+    { 0xFFFFC61E, 2558, "Buttercup" },
+    { 0xFFFFC61E, 2464, "Nectar" },
+    { 0xFFFFC61E, 2626, "Pro Gold" },
+    { 0xFFFFCC49, 2395, "Cornsilk" },
+    { 0xFFFFCC49, 2396, "Brite Yellow" },
+    { 0xFFFFCC49, 2605, "Goldenlite" },
+    { 0xFFFFCC49, 2216, "Marigold" },
+    { 0xFFFFD87F, 2234, "Glow" }
+};
+
+static const short threadColorsByNumber_RobisonAnton_Rayon[] =
+{
+    261, 159, 323, 172, 264, 199, 315, 35, 92, 61, 209, 318, 399, 81, 55, 418, 140, 372, 273, 74, 207, 286, 403, 225,
+    157, 113, 175, 327, 112, 191, 253, 336, 260, 419, 411, 369, 342, 252, 205, 31, 256, 409, 339, 395, 145, 326, 401,
+    350, 179, 292, 116, 163, 382, 187, 363, 384, 385, 378, 293, 300, 320, 330, 295, 367, 158, 274, 211, 180, 243, 195,
+    314, 303, 301, 311, 144, 338, 349, 165, 226, 75, 257, 283, 299, 20, 334, 284, 178, 237, 255, 201, 294, 206, 396,
+    376, 238, 59, 357, 297, 331, 251, 168, 79, 53, 241, 200, 70, 47, 126, 128, 192, 147, 148, 247, 249, 49, 348, 124,
+    287, 250, 183, 169, 171, 65, 366, 354, 390, 377, 361, 368, 394, 317, 343, 214, 208, 392, 310, 95, 266, 121, 312,
+    89, 358, 340, 117, 380, 379, 341, 105, 345, 259, 329, 132, 104, 282, 218, 123, 76, 86, 56, 40, 43, 87, 38, 106,
+    194, 397, 415, 416, 360, 406, 407, 262, 296, 153, 356, 290, 291, 219, 135, 410, 398, 30, 69, 373, 352, 374, 333,
+    304, 221, 234, 258, 305, 150, 188, 404, 248, 186, 203, 78, 82, 62, 120, 99, 222, 156, 155, 138, 6, 94, 3, 52, 72,
+    39, 13, 127, 9, 28, 26, 16, 34, 17, 84, 14, 193, 29, 19, 21, 216, 170, 50, 58, 67, 332, 388, 400, 413, 402, 408,
+    359, 370, 371, 319, 281, 236, 364, 267, 302, 306, 141, 152, 239, 244, 202, 289, 240, 182, 313, 246, 85, 245, 224,
+    130, 328, 36, 265, 190, 381, 133, 184, 143, 185, 227, 405, 351, 362, 220, 212, 275, 233, 307, 393, 386, 383, 375,
+    321, 37, 48, 102, 176, 77, 46, 44, 25, 242, 80, 161, 271, 136, 119, 137, 91, 154, 277, 278, 129, 7, 90, 204, 263,
+    288, 298, 230, 100, 196, 215, 177, 146, 173, 325, 198, 11, 107, 160, 51, 66, 110, 285, 316, 353, 412, 365, 387,
+    279, 213, 118, 96, 101, 93, 131, 268, 164, 269, 270, 228, 229, 355, 134, 103, 125, 63, 41, 42, 217, 391, 98, 189,
+    344, 115, 322, 8, 223, 308, 232, 335, 166, 111, 280, 33, 272, 337, 108, 97, 309, 54, 347, 417, 346, 18, 167, 2,
+    142, 210, 68, 1, 122, 24, 109, 174, 231, 12, 4, 22, 149, 235, 162, 57, 414, 5, 83, 151, 324, 73, 60, 0, 64, 139,
+    45, 181, 389, 276, 10, 23, 71, 27, 114, 197, 32, 254, 88, 15
+};
+
+static const ThreadColor threadColors_Sigma_Polyester[] =
+{
+    { 0xFF000000,   20, "Black" },
+    { 0xFF002D1F, 4735, "Millard Green" },
+    { 0xFF00405D,  913, "Deep Sea" },
+    { 0xFF00474D,  449, "Dark Teal" },
+    { 0xFF004D3D,  695, "Forrest Green" },
+    { 0xFF005B63,  448, "Deep Teal" },
+    { 0xFF006CA5, 2093, "Turquoise Blue" },
+    { 0xFF007B8D,  688, "Blue-Green" },
+    { 0xFF007EBA,  697, "Midnight Blue" },
+    { 0xFF008340,  317, "Green" },
+    { 0xFF0091A5,  443, "Teal" },
+    { 0xFF00A3A0,  906, "Sea Blue" },
+    { 0xFF00A4D9, 4419, "Sky Blue" },
+    { 0xFF0B7F85, 4627, "Wild Peacock" },
+    { 0xFF0E1F38,  423, "Dark Navy" },
+    { 0xFF0E1F38,  432, "Bright Sunshine" },
+    { 0xFF11263C, 5552, "Dark Blue" },
+    { 0xFF113263,  415, "Med Navy" },
+    { 0xFF143D7A,  414, "Ocean Blue" },
+    { 0xFF1A0C06,  891, "Dark Chocolate" },
+    { 0xFF243A7D, 1163, "Egyptian Blue" },
+    { 0xFF28438C,  809, "Med Blue" },
+    { 0xFF2A377E, 2031, "Bright Blue" },
+    { 0xFF2D4491,  413, "Med Royal Blue" },
+    { 0xFF2E9F76, 1615, "Light Spruce" },
+    { 0xFF2EA59C,  138, "Turquoise" },
+    { 0xFF356936,  992, "Med Forrest Green" },
+    { 0xFF396276,  142, "Dark Wedgewood" },
+    { 0xFF3D6AA1,  409, "Blue Raspberry" },
+    { 0xFF416C9B,  385, "Denim" },
+    { 0xFF429648, 5557, "Froggy Green" },
+    { 0xFF449284,  825, "Jade" },
+    { 0xFF466E64,  448, "Deep Teal" },
+    { 0xFF4B4884, 1031, "Deep Violet" },
+    { 0xFF515250,  117, "Charcoal" },
+    { 0xFF55AF78,  949, "True Green" },
+    { 0xFF565E5A,  116, "Dark Platinum" },
+    { 0xFF614125,  859, "Med Russett" },
+    { 0xFF61601C,  955, "Olive" },
+    { 0xFF634831,  878, "Birch" },
+    { 0xFF648DC7,  406, "Med Pastel Blue" },
+    { 0xFF664090,  390, "Grape" },
+    { 0xFF694169,  348, "Dark Grape" },
+    { 0xFF697698,  541, "Heron Blue" },
+    { 0xFF6C3E47,  216, "Maroon" },
+    { 0xFF6E4337,  513, "Dark Brown" },
+    { 0xFF709188,  961, "Light Jade" },
+    { 0xFF737F7F,  115, "Medium Grey" },
+    { 0xFF76C850,  988, "Grass Green" },
+    { 0xFF787668,  118, "Badger Grey" },
+    { 0xFF7B9CB0,  404, "Med Baby Blue" },
+    { 0xFF7D77AF,  386, "Light Violet" },
+    { 0xFF806A61,  873, "Dark Driftwood" },
+    { 0xFF820052,  325, "Ruby" },
+    { 0xFF834455, 2250, "Dark Wine" },
+    { 0xFF858325,  951, "Med Olive" },
+    { 0xFF86462E,  857, "Med Brown" },
+    { 0xFF86BE4E, 1183, "Gecko" },
+    { 0xFF878C8C, 8010, "Stone Grey" },
+    { 0xFF889186,  112, "Lava Stone" },
+    { 0xFF893480, 1323, "Med Orchid" },
+    { 0xFF8C6DAA, 1324, "Med Purple" },
+    { 0xFF8E4044, 1241, "Burgandy" },
+    { 0xFF8FAFC6,  382, "Cornflower" },
+    { 0xFF90A6C6,  381, "Very Light Lavender" },
+    { 0xFF915F46, 3142, "Saddle Brown" },
+    { 0xFF91B9E2, 5554, "Powder Blue" },
+    { 0xFF96D5C8,  903, "Sky Blue 2" },
+    { 0xFF96E845,   32, "Neon Green" },
+    { 0xFF98996D,  653, "Light Olive" },
+    { 0xFF98C173, 1619, "Paris Green" },
+    { 0xFF9B3B40,  213, "Cardinal Red" },
+    { 0xFF9B5C4B,  833, "Light Pecan" },
+    { 0xFFA0BFD7,  380, "Crystal Blue" },
+    { 0xFFA68A68, 4371, "Deep Taupe" },
+    { 0xFFA6D8F6,  403, "Baby Blue" },
+    { 0xFFA86E91,  347, "Medium Purple" },
+    { 0xFFA8BED7,  379, "Light Baby Blue" },
+    { 0xFFA93121,  838, "Burnt Rust" },
+    { 0xFFAD953E,  619, "Old Gold" },
+    { 0xFFAF7D3E,  905, "Golden Brown" },
+    { 0xFFB1415F,  333, "Garnet" },
+    { 0xFFB18B00,  842, "Vegas Gold" },
+    { 0xFFB1B8D3,  383, "Lavender" },
+    { 0xFFB25C31,  864, "Med Copper" },
+    { 0xFFB3E851,  506, "Pink Salmon" },
+    { 0xFFB43C3C, 3015, "Fire Red" },
+    { 0xFFB4705D,  832, "Cooper" },
+    { 0xFFB4DCD8,  904, "Aquamarine" },
+    { 0xFFB6A36C, 1552, "Very Old Gold" },
+    { 0xFFB8B8B8,  102, "Silver Diamond" },
+    { 0xFFBA6E4D,  253, "Rust" },
+    { 0xFFBB3D2E,  255, "Medium Rust" },
+    { 0xFFBD9565,  628, "Tan" },
+    { 0xFFBEDC8C,  984, "Smith Apple" },
+    { 0xFFBEE678,  985, "Light Lime" },
+    { 0xFFC07A46, 3014, "Dark Salmon" },
+    { 0xFFC394AE,  345, "Light Purple" },
+    { 0xFFC69632,  652, "Golden Rod" },
+    { 0xFFC70C57,   47, "Neon Orange Pink" },
+    { 0xFFC8BE96, 1148, "Desert Sand" },
+    { 0xFFC98300,  654, "Bright Gold" },
+    { 0xFFC9E3C5,  947, "Pastel Mint" },
+    { 0xFFCDCDCD, 1707, "Timberwolf" },
+    { 0xFFCEB24C,  616, "Treasure Gold" },
+    { 0xFFCF0040,  700, "Med Red" },
+    { 0xFFCFCFCF,  829, "Light Silver" },
+    { 0xFFD0A44F, 2518, "Beige" },
+    { 0xFFD0B478,  812, "Sweet Apricot" },
+    { 0xFFD5BF9B,  501, "Cream" },
+    { 0xFFD8493E,  527, "Pale Red" },
+    { 0xFFDC875E,  831, "Papaya Whip" },
+    { 0xFFDF99B6,  321, "Shocking Pink" },
+    { 0xFFDFA200,  609, "Golden Puppy" },
+    { 0xFFE22D2A,  101, "Silver" },
+    { 0xFFE5B15C,  466, "Old Gold" },
+    { 0xFFE5BE6C,  818, "Skin" },
+    { 0xFFE66535,  650, "Orange" },
+    { 0xFFE6CFD5,  376, "Pastel Light Pink" },
+    { 0xFFE77817,  649, "Mandarina" },
+    { 0xFFE77F9D,  309, "Pink" },
+    { 0xFFE8418C,  307, "Blushing Pink" },
+    { 0xFFEAF0F9,  402, "Lt. Weathered Blue" },
+    { 0xFFED572F,  135, "Pumpkin Orange" },
+    { 0xFFED9206, 2519, "Gold" },
+    { 0xFFEDE55D,  602, "Pastel Yellow" },
+    { 0xFFEDEDD2, 1140, "Light Natural" },
+    { 0xFFEDEF05,  633, "Lemon" },
+    { 0xFFEDEF05, 3001, "Med Orange" },
+    { 0xFFEDFF50,   21, "Light Neon Green" },
+    { 0xFFF06F8C,  313, "Rose Pink" },
+    { 0xFFF1A236,  508, "Dark Peach" },
+    { 0xFFF28DA6,   46, "Neon Pink" },
+    { 0xFFF2AFB4,  305, "Sweet Pink" },
+    { 0xFFF3D8A8, 1145, "Wheat" },
+    { 0xFFF6B08E,  505, "Med Peach" },
+    { 0xFFF7CDD5,  304, "Piggy Pink" },
+    { 0xFFF8C300,  646, "Amber" },
+    { 0xFFF9DFCF,  301, "Natural Pink" },
+    { 0xFFFADAF4,  387, "Misty Rose" },
+    { 0xFFFBDED6,  303, "Baby Pink" },
+    { 0xFFFDE896,  601, "Pale Yellow" },
+    { 0xFFFDE896,  612, "Buttercup" },
+    { 0xFFFDF76C,  632, "Mellow Yellow" },
+    { 0xFFFEF9EA,  627, "Pale Apricot" },
+    { 0xFFFF7824,   43, "Med Neon Orange" },
+    { 0xFFFFC500, 4117, "Yellow Sun" },
+    { 0xFFFFD085,  503, "Pale Salmon" },
+    { 0xFFFFE756,   33, "Light Neon Orange" },
+    { 0xFFFFFFFF,   10, "White" }
+};
+
+static const short threadColorsByNumber_Sigma_Polyester[] =
+{
+    149, 0, 129, 68, 148, 145, 132, 99, 114, 90, 59, 47, 36, 34, 49, 123, 25, 27, 71, 44, 91, 92, 138, 140, 136, 133,
+    121, 120, 130, 9, 112, 53, 81, 97, 76, 42, 118, 77, 73, 64, 63, 83, 29, 51, 139, 41, 122, 75, 50, 40, 28, 23, 18,
+    17, 14, 15, 10, 5, 32, 3, 115, 109, 147, 135, 85, 131, 45, 110, 43, 141, 125, 113, 142, 104, 79, 144, 93, 143,
+    127, 137, 119, 117, 98, 69, 101, 7, 4, 8, 105, 21, 108, 116, 31, 106, 111, 87, 72, 78, 82, 56, 37, 84, 52, 39, 19,
+    67, 88, 80, 11, 2, 102, 35, 55, 38, 46, 94, 95, 48, 26, 33, 126, 134, 100, 20, 57, 62, 60, 61, 89, 24, 70, 103,
+    22, 6, 54, 107, 124, 128, 96, 86, 65, 146, 74, 12, 13, 1, 16, 66, 30, 58
+};
+
+static const ThreadColor threadColors_Sulky_Rayon[] =
+{
+    { 0xFF000000, 1005, "Black" },
+    { 0xFF007A67, 1513, "Wild Peacock" },
+    { 0xFF00AF38, 1278, "Bright Green" },
+    { 0xFF014F3A, 1517, "Coachman Green" },
+    { 0xFF020114, 1182, "Blue Black" },
+    { 0xFF02140F, 1103, "Dk Khaki" },
+    { 0xFF027602, 1277, "Ivy Green" },
+    { 0xFF081705, 1536, "Midnight Teal" },
+    { 0xFF08180E, 1171, "Weathered Blue" },
+    { 0xFF088E6C,  571, "Deep Aqua" },
+    { 0xFF098531, 1101, "True Green" },
+    { 0xFF09A1A8, 1252, "Bright Peacock" },
+    { 0xFF0B4133, 1230, "Dk Teal" },
+    { 0xFF0C082D,  505, "Deep Arctic Sky" },
+    { 0xFF0C3D03, 1208, "Mallard Green" },
+    { 0xFF0D2210, 1233, "Ocean Teal" },
+    { 0xFF0D2904, 1174, "Dk Pine Green" },
+    { 0xFF0F6978, 1096, "Dk Turquoise" },
+    { 0xFF0FA56F, 1288, "Aqua" },
+    { 0xFF100A7C,  572, "Blue Ribbon" },
+    { 0xFF10394A, 1162, "Deep Teal" },
+    { 0xFF10D1BD, 1095, "Turquoise" },
+    { 0xFF111408,  538, "Forest Green" },
+    { 0xFF113675,  526, "Cobalt Blue" },
+    { 0xFF134F45, 1285, "Dk Sage Green" },
+    { 0xFF140B2D, 1200, "Med Dk Navy" },
+    { 0xFF152D04, 1175, "Dk Avocado" },
+    { 0xFF165F28,  569, "Garden Green" },
+    { 0xFF16625F, 1090, "Deep Peacock" },
+    { 0xFF175523, 1079, "Emerald Green" },
+    { 0xFF182B56, 1202, "Deep Turquoise" },
+    { 0xFF190525, 1043, "Dk. Navy" },
+    { 0xFF193207, 1232, "Classic Green" },
+    { 0xFF1B4CA4, 1253, "Dk Sapphire" },
+    { 0xFF1C6F51,  640, "Med. Aqua" },
+    { 0xFF1D062F, 1044, "Midnight Blue" },
+    { 0xFF1E6419, 1051, "Xmas Green" },
+    { 0xFF1E6E6F, 1206, "Dark Jade" },
+    { 0xFF220F34, 1197, "Med Navy" },
+    { 0xFF23238B, 1535, "Team Blue" },
+    { 0xFF262345,  643, "Arctic Sky" },
+    { 0xFF26BFCA, 1094, "Med Turquoise" },
+    { 0xFF273B00, 1210, "Dk Army Green" },
+    { 0xFF275C70, 1250, "Duck Wing Blue" },
+    { 0xFF28505A, 1805, "Ocean View" },
+    { 0xFF2A143F, 1199, "Admiral Navy Blue" },
+    { 0xFF2E8359, 1046, "Teal" },
+    { 0xFF306F75, 1251, "Bright Turquoise" },
+    { 0xFF320046, 1301, "Deep Eggplant" },
+    { 0xFF320614, 1183, "Black Cherry" },
+    { 0xFF321E50, 1042, "Bright Navy Blue" },
+    { 0xFF343213, 1286, "Dk French Green" },
+    { 0xFF34481E,  525, "English Green" },
+    { 0xFF347DCB, 1534, "Sapphire" },
+    { 0xFF349669, 1503, "Green Peacock" },
+    { 0xFF35693D,  580, "Mint Julep" },
+    { 0xFF36361F, 1273, "Dark Forest" },
+    { 0xFF370150, 1195, "Dk Purple" },
+    { 0xFF375A73, 1804, "Bayou Blue" },
+    { 0xFF3C1B1F, 1234, "Almost Black" },
+    { 0xFF3C2837, 1811, "Wineberry" },
+    { 0xFF3C4B05, 1836, "Loden Green" },
+    { 0xFF3C4F31, 1271, "Evergreen" },
+    { 0xFF3C5075, 1198, "Dusty Navy" },
+    { 0xFF411446, 1299, "Purple Shadow" },
+    { 0xFF412044, 1294, "Deep Slate Gray" },
+    { 0xFF415545, 1287, "French Green" },
+    { 0xFF42A021, 1049, "Grass Green" },
+    { 0xFF44235D, 1293, "Deep Nassau Blue" },
+    { 0xFF46016E, 1112, "Royal Purple" },
+    { 0xFF466E78, 1284, "Dk Winter Sky" },
+    { 0xFF46B774, 1280, "Dk Willow Green" },
+    { 0xFF483D59, 1283, "Slate Gray" },
+    { 0xFF490002, 1131, "Cloister Brown" },
+    { 0xFF4A4A19, 1272, "Hedge Green" },
+    { 0xFF4A5870, 1143, "True Blue" },
+    { 0xFF4B122D, 1189, "Dk Chestnut" },
+    { 0xFF500A1E, 1215, "Blackberry" },
+    { 0xFF507DAA, 1134, "Peacock Blue" },
+    { 0xFF515308, 1176, "Med Dk Avocado" },
+    { 0xFF530601, 1059, "Dk Tawny Brown" },
+    { 0xFF543A8D, 1242, "Nassau Blue" },
+    { 0xFF551602, 1130, "Dark Brown" },
+    { 0xFF57369E, 1226, "Dkl Periwinkle" },
+    { 0xFF59591D, 1173, "Med Army Green" },
+    { 0xFF5A5A8B, 1076, "Royal Blue" },
+    { 0xFF5B0000, 1186, "Sable Brown" },
+    { 0xFF5C9A1A, 1274, "Nile Green" },
+    { 0xFF5D3446, 1241, "Dark Ash" },
+    { 0xFF5F9619, 1825, "Barnyard Grass" },
+    { 0xFF62AADC, 1249, "Cornflower Blue" },
+    { 0xFF636327, 1156, "Lt Army Green" },
+    { 0xFF63632D, 1212, "Khaki" },
+    { 0xFF642702, 1057, "Dk Tawny Tan" },
+    { 0xFF642828, 1214, "Med Chestnut" },
+    { 0xFF644664, 1298, "Dk Plum" },
+    { 0xFF645055, 1810, "Wild Mulberry" },
+    { 0xFF648BBE, 1201, "Med Powder Blue" },
+    { 0xFF660000, 1247, "Mahogany" },
+    { 0xFF663500, 1058, "Tawny Brown" },
+    { 0xFF68E0F8, 1560, "Marine Aqua" },
+    { 0xFF6A0000, 1264, "Cognac" },
+    { 0xFF6A1F06, 1129, "Brown" },
+    { 0xFF6C7C71, 1552, "Dk Desert Cactus" },
+    { 0xFF6C8E87, 1550, "Desert Cactus" },
+    { 0xFF6E0A96, 1302, "Eggplant" },
+    { 0xFF6E2D41, 1813, "Plum Wine" },
+    { 0xFF6E2D5A, 1812, "Wildflower" },
+    { 0xFF6E788C, 1172, "Med Weathered Blue" },
+    { 0xFF6E8205, 1835, "Peapod Green" },
+    { 0xFF6E90A5, 1205, "Med Jade" },
+    { 0xFF70770F, 1276, "Pistachio" },
+    { 0xFF727483, 1291, "Winter Sky" },
+    { 0xFF735A64, 1297, "Lt Plum" },
+    { 0xFF74586C, 1240, "Smokey Grey" },
+    { 0xFF765960, 1220, "Charcoal Gray" },
+    { 0xFF777113,  630, "Moss Green" },
+    { 0xFF782346, 1309, "Magenta" },
+    { 0xFF783298, 1235, "Deep Purple" },
+    { 0xFF790000, 1035, "Dk. Burgundy" },
+    { 0xFF7AB31D, 1510, "Lime Green" },
+    { 0xFF7E1E46, 1300, "Plum" },
+    { 0xFF7E6C7C, 1306, "Gun Metal Gray" },
+    { 0xFF80A388, 1207, "Sea Foam Green" },
+    { 0xFF80B0AE, 1551, "Ocean Aqua" },
+    { 0xFF818901, 1322, "Chartreuse" },
+    { 0xFF82288E, 1122, "Purple" },
+    { 0xFF82878C, 1295, "Sterling" },
+    { 0xFF840000, 1312, "Wine" },
+    { 0xFF864C31, 1267, "Mink Brown" },
+    { 0xFF868105, 1332, "Deep Chartreuse" },
+    { 0xFF877375, 1040, "Med. Dk. Khaki" },
+    { 0xFF87C887, 1839, "Cameo" },
+    { 0xFF899812, 1177, "Avocado" },
+    { 0xFF8C748C, 1554, "Purple Passion" },
+    { 0xFF8C7F83, 1041, "Med. Dk. Gray" },
+    { 0xFF8E7E7E, 1166, "Med Steel Gray" },
+    { 0xFF8F623D, 1179, "Dk Taupe" },
+    { 0xFF91B432, 1815, "Japanese Fern" },
+    { 0xFF91E12D, 1831, "Liimeade" },
+    { 0xFF93D16C, 1279, "Willow Green" },
+    { 0xFF95A490, 1211, "Lt Khaki" },
+    { 0xFF961A32, 1311, "Mulberry" },
+    { 0xFF965A28, 1823, "Cocoa" },
+    { 0xFF965A37, 1822, "Toffee" },
+    { 0xFF96AA8B, 1228, "Drab Green" },
+    { 0xFF96C3E1, 1196, "Blue" },
+    { 0xFF971F01, 1217, "Chestnut" },
+    { 0xFF975F2F, 1170, "Lt Brown" },
+    { 0xFF98888C, 1219, "Gray" },
+    { 0xFF9B6B2C, 1265, "Burnt Toast" },
+    { 0xFF9B735A, 1837, "Lt. Cocoa" },
+    { 0xFF9C0000, 1169, "Bayberry Red" },
+    { 0xFF9C6484, 1545, "Purple Accent" },
+    { 0xFF9C6D45, 1266, "Toast" },
+    { 0xFFA04656, 1190, "Med Burgundy" },
+    { 0xFFA07D82, 1809, "Iced Mauve" },
+    { 0xFFA0B9C3, 1806, "Madras Blue" },
+    { 0xFFA0C3EB, 1029, "Med. Blue" },
+    { 0xFFA3C2D7, 1644, "Caribbean Mist" },
+    { 0xFFA58973, 1180, "Med Taupe" },
+    { 0xFFA5AF68, 1104, "Pastel Yellow-Grn" },
+    { 0xFFA6A2C6, 1030, "Periwinkle" },
+    { 0xFFA6C284, 1047, "Mint Green" },
+    { 0xFFA8C8BC, 1204, "Pastel Jade" },
+    { 0xFFA98803, 1262, "Dk. Autumn Gold" },
+    { 0xFFAA820A, 1826, "Galley Gold" },
+    { 0xFFAAAF14, 1817, "Lemon Grass" },
+    { 0xFFABA0A8, 1329, "Dk Nickel Gray" },
+    { 0xFFAC1C01, 1216, "Med Maple" },
+    { 0xFFAC8783, 1269, "Mushroom" },
+    { 0xFFAEB8C3, 1203, "Lt Weathered Blue" },
+    { 0xFFAEC6BB, 1305, "Sage Green" },
+    { 0xFFAF4B69, 1814, "Orchid Kiss" },
+    { 0xFFAF5B00, 1056, "Med Tawny Tan" },
+    { 0xFFAF8901, 1227, "Gold Green" },
+    { 0xFFAFAA05, 1834, "Pea Soup" },
+    { 0xFFB26C29,  521, "Nutmeg" },
+    { 0xFFB30000, 1263, "Red Jubilee" },
+    { 0xFFB46E75, 1119, "Dk Mauve" },
+    { 0xFFB47364, 1304, "Dewberry" },
+    { 0xFFB47396, 1830, "Lilac" },
+    { 0xFFB49682, 1807, "Soft Heather" },
+    { 0xFFB4E1EB, 1145, "Powder Blue" },
+    { 0xFFB58CC7, 1561, "Deep Hyacinth" },
+    { 0xFFB7A9AC, 1011, "Steel Gray" },
+    { 0xFFB7B7AF, 1270, "Dk Gray Khaki" },
+    { 0xFFB9A096, 1213, "Taupe" },
+    { 0xFFBA4500, 1158, "Dk Maple" },
+    { 0xFFBC3D2C, 1237, "Deep Mauve" },
+    { 0xFFBD1E60, 1191, "Dk Rose" },
+    { 0xFFBDD163, 1209, "Lt Avocado" },
+    { 0xFFBE1982, 1255, "Deep Orchid" },
+    { 0xFFBEC3E1, 1028, "Baby Blue" },
+    { 0xFFBECDC8, 1077, "Jade Tint" },
+    { 0xFFC0B2B7, 1328, "Nickel Gray" },
+    { 0xFFC1CBB9, 1508, "Putty" },
+    { 0xFFC2D37D, 1100, "Lt Grass Green" },
+    { 0xFFC38C73, 1820, "Fruit Shake" },
+    { 0xFFC3913C, 1819, "Outback" },
+    { 0xFFC39471, 1128, "Dk Ecru" },
+    { 0xFFC3EFBF, 1045, "Lt. Teal" },
+    { 0xFFC6323C, 1034, "Burgundy" },
+    { 0xFFC8F58C, 1818, "Fairway Mist" },
+    { 0xFFCB0000, 1181, "Rust" },
+    { 0xFFCBCBBD, 1321, "Gray Khaki" },
+    { 0xFFCD054D, 1533, "Lt Rose" },
+    { 0xFFCD3900,  621, "Sunset" },
+    { 0xFFCDAA7D, 1838, "Cocoa Cream" },
+    { 0xFFD1DBFF, 1222, "Lt Baby Blue" },
+    { 0xFFD1DCFA, 1292, "Heron Blue" },
+    { 0xFFD21E82, 1192, "Fuchsia" },
+    { 0xFFD25F00, 1833, "Pumpkin Pie" },
+    { 0xFFD274D7, 1194, "Lt Purple" },
+    { 0xFFD2AAF0, 1296, "Hyacinth" },
+    { 0xFFD2AF9B, 1808, "Velvet Slipper" },
+    { 0xFFD2C3AF, 1824, "Gentle Rain" },
+    { 0xFFD2E6F0, 1248, "Med Pastel Blue" },
+    { 0xFFD39D00, 1159, "Temple Gold" },
+    { 0xFFD5C7C3, 1327, "Dk Whisper Gray" },
+    { 0xFFD6D5E8, 1074, "Pale Powder Blue" },
+    { 0xFFD78000, 1025, "Mine Gold" },
+    { 0xFFD7F58C, 1816, "Honeydew" },
+    { 0xFFD86496, 1033, "Dk. Orchid" },
+    { 0xFFDB6478, 1307, "Petal Pink" },
+    { 0xFFDC6496, 1109, "Hot Pink" },
+    { 0xFFDC82A0, 1080, "Orchid" },
+    { 0xFFDC8C17, 1126, "Tan" },
+    { 0xFFDCE0F1, 1223, "Baby Blue Tint" },
+    { 0xFFDCEBF0, 1289, "Ice Blue" },
+    { 0xFFDDAB00, 1260, "Summer Gold" },
+    { 0xFFDFBEC8, 1031, "Med. Orchid" },
+    { 0xFFDFDFCB, 1218, "Silver Gray" },
+    { 0xFFDFE5EB, 1165, "Lt Sky Blue" },
+    { 0xFFE0C63B, 1243, "Spring Moss" },
+    { 0xFFE0DBDB, 1229, "Lt Putty" },
+    { 0xFFE0E6C8, 1275, "Sea Mist" },
+    { 0xFFE10000,  561, "Lipstick" },
+    { 0xFFE19119, 1832, "Desert Glow" },
+    { 0xFFE1AF9A, 1015, "Med. Peach" },
+    { 0xFFE28264, 1259, "Salmon Peach" },
+    { 0xFFE2CFC7, 1085, "Silver" },
+    { 0xFFE2E2EB, 1151, "Powder Blue Tint" },
+    { 0xFFE5326A, 1231, "Med Rose" },
+    { 0xFFE60041, 1257, "Deep Coral" },
+    { 0xFFE66D00,  568, "Cinnamon" },
+    { 0xFFE68CEB, 1032, "Med. Purple" },
+    { 0xFFE6AE6F, 1549, "Flax" },
+    { 0xFFE6AFD2, 1193, "Lavender" },
+    { 0xFFE6B4AA, 1064, "Pale Peach" },
+    { 0xFFE6B9F5, 1254, "Dusty Lavender" },
+    { 0xFFE79002,  523, "Autumn Gold" },
+    { 0xFFE8C89C, 1149, "Deep Ecru" },
+    { 0xFFE9BD96,  619, "Dusty Peach" },
+    { 0xFFEAE4E4, 1236, "Lt Silver" },
+    { 0xFFEB0000, 1039, "True Red" },
+    { 0xFFEB0000, 1147, "Xmas Red" },
+    { 0xFFEB6602, 1021, "Maple" },
+    { 0xFFEB7183, 1558, "Tea Rose" },
+    { 0xFFEB8296, 1256, "Sweet Pink" },
+    { 0xFFEBBC80, 1055, "Tawny Tan" },
+    { 0xFFEC968C, 1016, "Pastel Coral" },
+    { 0xFFECA082, 1019, "Peach" },
+    { 0xFFEDF6D4, 1331, "Pale Green" },
+    { 0xFFEE5078, 1511, "Deep Rose" },
+    { 0xFFEEBEAE, 1054, "Med. Dk. Ecru" },
+    { 0xFFEFC810,  502, "Cornsilk" },
+    { 0xFFEFDFBD, 1017, "Pastel Peach" },
+    { 0xFFEFEFE5, 1268, "Light Gray Khaki" },
+    { 0xFFF06E78, 1081, "Brick" },
+    { 0xFFF08278, 1020, "Dark Peach" },
+    { 0xFFF0A0B9, 1224, "Bright Pink" },
+    { 0xFFF0B9B9, 1115, "Lt Pink" },
+    { 0xFFF0C4A0, 1258, "Coral Reed" },
+    { 0xFFF0C8B4, 1113, "Pastel Mauve" },
+    { 0xFFF0D6D2, 1120, "Pale Pink" },
+    { 0xFFF0EBA5, 1829, "Crème Brulee" },
+    { 0xFFF0F8EC, 1063, "Pale Yellow-Green" },
+    { 0xFFF3A001,  567, "Butterfly Gold" },
+    { 0xFFF3B600, 1333, "Sunflower Gold" },
+    { 0xFFF3DBD9, 1068, "Pink Tint" },
+    { 0xFFF5740A, 1168, "True Orange" },
+    { 0xFFF5A9A0, 1117, "Mauve" },
+    { 0xFFF6CE69, 1070, "Gold" },
+    { 0xFFF7E3BB, 1082, "Ecru" },
+    { 0xFFF8F5F1, 1325, "Whisper Gray" },
+    { 0xFFF90000, 1037, "Lt.Red" },
+    { 0xFFF9E6CA,  508, "Sand" },
+    { 0xFFF9F9E0, 1086, "Pale Sea Foam" },
+    { 0xFFF9F9EA, 1071, "Off White" },
+    { 0xFFF9F9F4, 1002, "Soft White" },
+    { 0xFFF9F9FF, 1001, "Bright White" },
+    { 0xFFFA5F7F, 1303, "Watermelon" },
+    { 0xFFFA9999, 1154, "Coral" },
+    { 0xFFFAA4A4, 1108, "Lt Mauve" },
+    { 0xFFFAB9CB, 1121, "Pink" },
+    { 0xFFFAC896, 1821, "Creamy Peach" },
+    { 0xFFFACBCB, 1225, "Pastel Pink" },
+    { 0xFFFAD2AA, 1800, "Shrimp" },
+    { 0xFFFADC96, 1801, "Flesh" },
+    { 0xFFFAECC6, 1127, "Med Ecru" },
+    { 0xFFFC8F0C, 1313, "Bittersweet" },
+    { 0xFFFCBE05, 1185, "Golden Yellow" },
+    { 0xFFFCCBDF, 1111, "Pastel Orchid" },
+    { 0xFFFDF3DA,  520, "Bone" },
+    { 0xFFFF0000, 1246, "Orange Flame" },
+    { 0xFFFF0000, 1317, "Poppy" },
+    { 0xFFFF004B, 1188, "Red Geranium" },
+    { 0xFFFF643C, 1827, "Coral Sunset" },
+    { 0xFFFF6600, 1078, "Tangerine" },
+    { 0xFFFF6600, 1184, "Orange Red" },
+    { 0xFFFF8300, 1238, "Orange Sunrise" },
+    { 0xFFFF8CCB, 1515, "Rosebud" },
+    { 0xFFFF9100, 1065, "Orange Yellow" },
+    { 0xFFFF9B6E, 1803, "Island Peach" },
+    { 0xFFFFAB57, 1239, "Apricot" },
+    { 0xFFFFB435,  562, "Spice" },
+    { 0xFFFFB800, 1024, "Goldenrod" },
+    { 0xFFFFBDBD, 1148, "Lt Coral" },
+    { 0xFFFFBE00, 1137, "Yellow Orange" },
+    { 0xFFFFC100, 1083, "Spark Gold" },
+    { 0xFFFFC896, 1802, "Soft Blush" },
+    { 0xFFFFD226, 1167, "Maize Yellow" },
+    { 0xFFFFD6C7, 1543, "Peach Fluff" },
+    { 0xFFFFE500, 1187, "Mimosa Yellow" },
+    { 0xFFFFE669, 1023, "Yellow" },
+    { 0xFFFFE6AA, 1828, "Seashell" },
+    { 0xFFFFEC00, 1124, "Sun Yellow" },
+    { 0xFFFFF072, 1135, "Pastel Yellow" },
+    { 0xFFFFF180, 1066, "Primrose" },
+    { 0xFFFFF7B9, 1061, "Pale Yellow" },
+    { 0xFFFFF7D5, 1022, "Cream" },
+    { 0xFFFFFF85, 1067, "Lemon Yellow" }
+};
+
+static const short threadColorsByNumber_Sulky_Rayon[] =
+{
+    266, 13, 287, 304, 177, 251, 52, 23, 22, 237, 316, 278, 245, 27, 9, 19, 55, 253, 207, 116, 34, 40, 291, 290, 0,
+    185, 239, 261, 267, 262, 270, 257, 331, 325, 317, 221, 193, 158, 162, 231, 246, 223, 202, 119, 286, 255, 131, 135,
+    50, 31, 35, 201, 46, 163, 67, 36, 265, 260, 174, 93, 99, 80, 330, 277, 249, 313, 329, 332, 280, 283, 289, 220, 85,
+    194, 309, 29, 226, 269, 284, 320, 241, 288, 28, 41, 21, 17, 197, 10, 5, 161, 294, 225, 303, 69, 274, 272, 282,
+    179, 275, 295, 126, 327, 227, 300, 200, 102, 82, 73, 78, 328, 319, 75, 183, 256, 318, 252, 242, 293, 91, 188, 218,
+    20, 233, 136, 322, 281, 152, 148, 8, 108, 84, 16, 26, 79, 133, 137, 160, 204, 4, 49, 310, 302, 86, 324, 307, 76,
+    155, 190, 211, 248, 213, 57, 146, 38, 63, 45, 25, 97, 30, 171, 164, 110, 37, 123, 14, 191, 42, 141, 92, 187, 94,
+    77, 169, 147, 232, 149, 115, 209, 228, 271, 297, 83, 175, 145, 235, 12, 243, 32, 15, 59, 118, 254, 189, 311, 315,
+    114, 88, 81, 234, 305, 98, 217, 90, 43, 47, 11, 33, 250, 192, 259, 244, 273, 240, 230, 165, 178, 101, 150, 154,
+    129, 268, 170, 186, 62, 74, 56, 87, 236, 111, 6, 2, 140, 71, 72, 70, 24, 51, 66, 18, 229, 112, 210, 68, 65, 127,
+    214, 113, 95, 64, 121, 48, 105, 292, 180, 172, 122, 224, 117, 142, 128, 301, 306, 205, 125, 285, 219, 195, 168,
+    263, 130, 279, 54, 196, 120, 264, 1, 312, 3, 206, 53, 39, 7, 323, 153, 247, 104, 124, 103, 134, 258, 100, 184,
+    159, 298, 299, 321, 314, 58, 44, 157, 182, 215, 156, 96, 60, 107, 106, 173, 138, 222, 167, 203, 199, 198, 296,
+    144, 143, 216, 89, 166, 308, 326, 276, 181, 139, 238, 212, 176, 109, 61, 151, 208, 132
+};
+
+static const ThreadColor threadColors_Z102_Isacord_Polyester[] =
+{
+    { 0xFF000000,   20, "" },
+    { 0xFF000021, 3355, "" },
+    { 0xFF000136, 3110, "" },
+    { 0xFF001748, 3644, "" },
+    { 0xFF001F71, 3544, "" },
+    { 0xFF002A29, 4515, "" },
+    { 0xFF002E5E, 3622, "" },
+    { 0xFF004B23, 5374, "" },
+    { 0xFF005C79, 4116, "" },
+    { 0xFF00669F, 3901, "" },
+    { 0xFF006835, 5415, "" },
+    { 0xFF006E74, 4410, "" },
+    { 0xFF007CA6, 4103, "" },
+    { 0xFF015D7E, 4032, "" },
+    { 0xFF054ABD, 3522, "" },
+    { 0xFF082E4D, 3743, "" },
+    { 0xFF0E9543, 5613, "" },
+    { 0xFF149B7B, 5210, "" },
+    { 0xFF187166, 5233, "" },
+    { 0xFF1C005D, 3541, "" },
+    { 0xFF225926, 5944, "" },
+    { 0xFF23679C, 3810, "" },
+    { 0xFF240047, 2900, "" },
+    { 0xFF33001D, 2715, "" },
+    { 0xFF373732, 1375, "" },
+    { 0xFF38A4AE, 4620, "" },
+    { 0xFF3D1C11, 1346, "" },
+    { 0xFF3D657E, 3842, "" },
+    { 0xFF3EBBC8, 4111, "" },
+    { 0xFF434331, 1874, "" },
+    { 0xFF454B58,  138, "" },
+    { 0xFF47AEDD, 3910, "" },
+    { 0xFF4D0308, 2115, "" },
+    { 0xFF4E3500,  747, "" },
+    { 0xFF5B4032, 1565, "" },
+    { 0xFF5C9C51, 5531, "" },
+    { 0xFF5E1942, 2711, "" },
+    { 0xFF5E7A17, 5833, "" },
+    { 0xFF605840,  776, "" },
+    { 0xFF624F00,  345, "" },
+    { 0xFF626C7E, 2674, "" },
+    { 0xFF634D86, 2920, "" },
+    { 0xFF702A69, 2810, "" },
+    { 0xFF71AAD8, 3630, "" },
+    { 0xFF724593, 2910, "" },
+    { 0xFF73787A,  108, "" },
+    { 0xFF7AC8AF, 5220, "" },
+    { 0xFF80CCD8, 4240, "" },
+    { 0xFF82421B, 1154, "" },
+    { 0xFF843D07, 1134, "" },
+    { 0xFF871C45, 2500, "" },
+    { 0xFF888D8E, 4073, "" },
+    { 0xFF8D8F5B,  453, "" },
+    { 0xFF8F8C93, 1972, "" },
+    { 0xFF96836D,  722, "" },
+    { 0xFF978B3C, 6133, "" },
+    { 0xFF98B0BC, 3750, "" },
+    { 0xFF9E947F,  873, "" },
+    { 0xFF9EA9A6,  142, "" },
+    { 0xFF9FC7DF, 3730, "" },
+    { 0xFFA31A1C, 2011, "" },
+    { 0xFFA57B8D, 2764, "" },
+    { 0xFFACCEC7, 4250, "" },
+    { 0xFFAFD8CD, 5050, "" },
+    { 0xFFB1500A, 1115, "" },
+    { 0xFFB19072, 1061, "" },
+    { 0xFFB385BC, 2830, "" },
+    { 0xFFB7BABA,  105, "" },
+    { 0xFFB8B25A,  352, "" },
+    { 0xFFB98E03,  542, "" },
+    { 0xFFBA4005, 1311, "" },
+    { 0xFFBABEB7, 3971, "" },
+    { 0xFFBB5704,  931, "" },
+    { 0xFFBBCD91, 6051, "" },
+    { 0xFFBBDFEB, 3962, "" },
+    { 0xFFBCD633, 6011, "" },
+    { 0xFFBF0A21, 1906, "" },
+    { 0xFFC09C72, 1123, "" },
+    { 0xFFC11914, 1902, "" },
+    { 0xFFC5BFA6,  672, "" },
+    { 0xFFC73C13, 1312, "" },
+    { 0xFFC8100D, 1903, "" },
+    { 0xFFC8700B,  922, "" },
+    { 0xFFC89334,  822, "" },
+    { 0xFFC89340,  832, "" },
+    { 0xFFC8C6BD,  150, "" },
+    { 0xFFC8DBE4, 3650, "" },
+    { 0xFFC91243, 2521, "" },
+    { 0xFFD23C3E, 1921, "" },
+    { 0xFFD5DDDB, 4071, "" },
+    { 0xFFD8A67D, 1141, "" },
+    { 0xFFDB4083, 2508, "" },
+    { 0xFFDDCBA5,  761, "" },
+    { 0xFFE4C180,  651, "" },
+    { 0xFFE59300,  824, "" },
+    { 0xFFE5CB4F,  221, "" },
+    { 0xFFE66B21, 1332, "" },
+    { 0xFFEB2D2B, 1805, "" },
+    { 0xFFEBBAAE, 1755, "" },
+    { 0xFFF6AE32,  811, "" },
+    { 0xFFF8FFFF,   17, "" },
+    { 0xFFFAEE5C,  220, "" },
+    { 0xFFFEA5B9, 2550, "" },
+    { 0xFFFEF9D9,  270, "" },
+    { 0xFFFF3D1E, 1305, "" },
+    { 0xFFFF6046, 1600, "" },
+    { 0xFFFF668A, 2520, "" },
+    { 0xFFFF6D71, 1753, "" },
+    { 0xFFFF7319, 1300, "" },
+    { 0xFFFF8101, 1102, "" },
+    { 0xFFFF988F, 1840, "" },
+    { 0xFFFFA0B6, 2530, "" },
+    { 0xFFFFAF02,  800, "" },
+    { 0xFFFFAF94, 1532, "" },
+    { 0xFFFFBC95, 1351, "" },
+    { 0xFFFFCC93, 1362, "" },
+    { 0xFFFFCDCC, 2155, "" },
+    { 0xFFFFDC00,  311, "" },
+    { 0xFFFFF46A,  230, "" },
+    { 0xFFFFF4A5,  520, "" }
+};
+
+static const short threadColorsByNumber_Z102_Isacord_Polyester[] =
+{
+    100, 0, 67, 45, 30, 58, 85, 101, 95, 118, 103, 117, 39, 68, 52, 119, 69, 93, 79, 54, 33, 92, 38, 112, 99, 83, 94,
+    84, 57, 82, 72, 65, 109, 64, 77, 49, 90, 48, 108, 104, 70, 80, 96, 26, 114, 115, 24, 113, 34, 105, 107, 98, 97,
+    110, 29, 78, 81, 76, 88, 53, 60, 32, 116, 50, 91, 106, 87, 111, 102, 40, 36, 23, 61, 42, 66, 22, 44, 41, 2, 1, 14,
+    19, 4, 6, 43, 3, 86, 59, 15, 56, 21, 27, 9, 31, 74, 71, 13, 89, 51, 12, 28, 8, 47, 62, 11, 5, 25, 63, 17, 46, 18,
+    7, 10, 35, 16, 37, 20, 75, 73, 55
+};
 
-const char* getName_Isacord_Polyester(unsigned int color) { return ""; } /*TODO: finish */
+#endif /* ARDUINO TODO: remove this line when thread-color.c is arduino compatible. This is a temporary arduino build fix. */
 
-int getNum_Isafil_Rayon(unsigned int color)
+typedef struct ThreadChart_
 {
-    switch(color)
-    {
-        case 0xFFFFFFFF: return   10;
-     /* case 0xFFFFFFFF: return   15;    TODO: duplicate case value */
-     /* case 0xFFFFFFFF: return   17;    TODO: duplicate case value */
-        case 0xFF000000: return   20;
-        case 0xFFFFFDED: return  101;
-        case 0xFF7D7D7D: return  104;
-        case 0xFF515B61: return  107;
-        case 0xFF6D757B: return  108;
-        case 0xFFACACAC: return  109;
-     /* case 0xFF515B61: return  111;    TODO: duplicate case value */
-        case 0xFF5D5D5D: return  112;
-        case 0xFFCFCFCF: return  124;
-        case 0xFFA1A9B4: return  131;
-     /* case 0xFF192024: break;          NOTE: N/A COLOR */
-     /* case 0xFF6D757B: return  141;    TODO: duplicate case value */
-        case 0xFF9EA5AA: return  142;
-        case 0xFFCFD1D5: return  145;
-        case 0xFFC6BDB4: return  150;
-        case 0xFFD5C4B3: return  151;
-        case 0xFF7C8283: return  152;
-        case 0xFF898F94: return  156;
-        case 0xFFFEF5F0: return  180;
-        case 0xFFE9D7D9: return  182;
-        case 0xFFEBE3DD: return  184;
-        case 0xFFE0DA5F: return  221;
-        case 0xFFBFBA28: return  232;
-        case 0xFFECE9C1: return  241;
-        case 0xFFFAF6CC: return  250;
-        case 0xFFECE7A5: return  251;
-        case 0xFFECEADB: return  260;
-        case 0xFFF9F8E8: return  270;
-        case 0xFFFDF76C: return  310;
-        case 0xFFF5D300: return  311;
-        case 0xFF797E24: return  345;
-        case 0xFFB0AA76: return  352;
-        case 0xFF898F2B: return  442;
-        case 0xFF98996D: return  453;
-        case 0xFF6E772E: return  454;
-        case 0xFF6B7E6F: return  463;
-        case 0xFF3E4F34: return  465;
-        case 0xFFEDEF05: return  501;
-     /* case 0xFFFAF6CC: return  505;    TODO: duplicate case value */
-     /* case 0xFFF5D300: return  506;    TODO: duplicate case value */
-        case 0xFFFFFBD1: return  510;
-        case 0xFFFDE896: return  520;
-        case 0xFFD7CE8A: return  532;
-        case 0xFFB18B00: return  542;
-        case 0xFFAA8D00: return  545;
-        case 0xFFB28F11: return  546;
-        case 0xFFAC9436: return  551;
-        case 0xFFB69F56: return  552;
-        case 0xFFF4EE8C: return  580;
-        case 0xFFF1EB35: return  590;
-        case 0xFFF8D73E: return  600;
-     /* case 0xFFF8D73E: return  605;    TODO: duplicate case value */
-     /* case 0xFFF7DC00: break;          NOTE: N/A COLOR */
-        case 0xFFF7CB47: return  610;
-        case 0xFFF7E400: return  615;
-     /* case 0xFFFDE896: return  620;    TODO: duplicate case value */
-        case 0xFFEEDB00: return  625;
-        case 0xFFFEF09A: return  630;
-        case 0xFFFDE1AF: return  635;
-     /* case 0xFFFDE896: return  640;    TODO: duplicate case value */
-        case 0xFFF5D2A6: return  651;
-        case 0xFFFEF9EA: return  660;
-        case 0xFFFAF6E7: return  670;
-        case 0xFFBEBEA8: return  672;
-        case 0xFFF7C35F: return  700;
-        case 0xFFF5CA00: return  702;
-        case 0xFFDFA200: return  704;
-        case 0xFFFCF538: return  706;
-        case 0xFFFADC59: return  713;
-        case 0xFF8C7E6A: return  722;
-        case 0xFF827000: return  726;
-        case 0xFF636254: return  732;
-        case 0xFF594900: return  747;
-        case 0xFFD6BF94: return  761;
-        case 0xFF656452: return  776;
-        case 0xFFF1AF00: return  800;
-        case 0xFFF3C200: return  805;
-        case 0xFFF5BA5D: return  811;
-        case 0xFFE1A23E: return  821;
-        case 0xFFCCAB3F: return  822;
-     /* case 0xFFDFA200: return  824;    TODO: duplicate case value */
-        case 0xFFF3B044: return  830;
-        case 0xFFD0A44F: return  832;
-        case 0xFFCD944A: return  842;
-        case 0xFFE3BC61: return  851;
-        case 0xFF947C4A: return  853;
-     /* case 0xFFCBBFA2: break;          NOTE: N/A COLOR */
-     /* case 0xFFA5866A: break;          NOTE: N/A COLOR */
-        case 0xFF001F48: return  866;
-        case 0xFFEBE7DD: return  870;
-        case 0xFF9FA086: return  873;
-        case 0xFF9A897B: return  874;
-        case 0xFFEE9C00: return  900;
-        case 0xFFF3B259: return  904;
-        case 0xFFCA832C: return  922;
-        case 0xFFC07314: return  931;
-        case 0xFFAC6613: return  932;
-        case 0xFF744808: return  933;
-        case 0xFFBD9565: return  934;
-        case 0xFF806800: return  936;
-        case 0xFFC98300: return  940;
-        case 0xFFAF7D3E: return  941;
-        case 0xFF483928: return  945;
-        case 0xFFFEECD9: return  961;
-        case 0xFFFEFEED: return  970;
-        case 0xFFDD973A: return 1041;
-        case 0xFF6A4129: return 1055;
-        case 0xFFFDE2C1: return 1060;
-        case 0xFFA68A68: return 1061;
-        case 0xFFD76814: return 1099;
-        case 0xFFED873F: return 1100;
-        case 0xFFEC870E: return 1101;
-        case 0xFFED9206: return 1102;
-     /* case 0xFFEE9C00: return 1106;    TODO: duplicate case value */
-        case 0xFFC45331: return 1113;
-        case 0xFFEE8751: return 1114;
-        case 0xFFA35214: return 1115;
-        case 0xFFF8C000: return 1120;
-        case 0xFFB7976B: return 1123;
-        case 0xFF9D5A21: return 1134;
-        case 0xFFF3D8A8: return 1140;
-        case 0xFFFACFAE: return 1141;
-     /* case 0xFF7A4427: break;          NOTE: N/A COLOR */
-        case 0xFFDFC8AB: return 1172;
-        case 0xFFE89763: return 1211;
-        case 0xFFF1A236: return 1220;
-        case 0xFF3D2723: return 1276;
-        case 0xFFE5571D: return 1300;
-     /* case 0xFFD9674C: break;          NOTE: N/A COLOR */
-        case 0xFFE8643C: return 1302;
-        case 0xFFE4501E: return 1304;
-        case 0xFFEA7134: return 1305;
-        case 0xFFE12A23: return 1306;
-        case 0xFFC14817: return 1311;
-     /* case 0xFFC45331: return 1312;    TODO: duplicate case value */
-        case 0xFFD7623E: return 1313;
-        case 0xFFED7C56: return 1320;
-        case 0xFF92291B: return 1324;
-        case 0xFFD5815E: return 1332;
-        case 0xFFBB3D2E: return 1334;
-        case 0xFFBE2D1A: return 1335;
-        case 0xFF5F1B23: return 1342;
-        case 0xFF7A3441: return 1346;
-        case 0xFF84291D: return 1348;
-        case 0xFFFBBF95: return 1351;
-        case 0xFFF4A773: return 1352;
-        case 0xFF693920: return 1355;
-        case 0xFFF9C6A1: return 1361;
-        case 0xFFF9C598: return 1362;
-        case 0xFF432731: return 1366;
-        case 0xFF464537: return 1375;
-        case 0xFF4D2E18: return 1376;
-        case 0xFFD64F42: return 1421;
-        case 0xFFF4A782: return 1430;
-        case 0xFFE22D2A: return 1501;
-        case 0xFFA93121: return 1514;
-        case 0xFFEC7168: return 1521;
-        case 0xFFF6B08E: return 1532;
-        case 0xFFF9C5B9: return 1551;
-        case 0xFF806A61: return 1565;
-     /* case 0xFF464537: return 1573;    TODO: duplicate case value */
-        case 0xFFE36C63: return 1600;
-        case 0xFFF9C7B9: return 1630;
-        case 0xFFE44733: return 1701;
-        case 0xFFDF0032: return 1703;
-     /* case 0xFFE0003D: break;          NOTE: N/A COLOR */
-     /* case 0xFFE44733: return 1705;    TODO: duplicate case value */
-        case 0xFFCF0040: return 1725;
-        case 0xFFDB686B: return 1750;
-        case 0xFFF1CDCE: return 1755;
-        case 0xFFE9C9BD: return 1760;
-        case 0xFFE8C0B8: return 1761;
-        case 0xFFE00046: return 1800;
-        case 0xFFE43449: return 1802;
-        case 0xFFD6445D: return 1805;
-        case 0xFFF49E95: return 1840;
-        case 0xFFB76663: return 1842;
-     /* case 0xFFE36C63: return 1849;    TODO: duplicate case value */
-        case 0xFFF0887D: return 1850;
-        case 0xFFFAC7C1: return 1855;
-        case 0xFFFCDAD5: return 1860;
-        case 0xFFFDE3D3: return 1870;
-     /* case 0xFF636254: return 1874;    TODO: duplicate case value */
-        case 0xFF394535: return 1876;
-        case 0xFFE10057: return 1900;
-        case 0xFFBD0041: return 1902;
-        case 0xFFC00343: return 1903;
-        case 0xFFA9023A: return 1904;
-        case 0xFF960018: return 1905;
-        case 0xFFBE004F: return 1906;
-        case 0xFF910230: return 1911;
-        case 0xFF86023E: return 1912;
-        case 0xFF9A0C3B: return 1913;
-        case 0xFFA41F39: return 1914;
-        case 0xFFA33050: return 1921;
-        case 0xFFF28DA6: return 1940;
-        case 0xFFCE427A: return 1950;
-        case 0xFFF2B9BE: return 1960;
-        case 0xFF959595: return 1972;
-        case 0xFFA33145: return 2011;
-        case 0xFF9F454C: return 2022;
-        case 0xFFC7979B: return 2051;
-        case 0xFFD18D89: return 2053;
-        case 0xFF970038: return 2100;
-        case 0xFF9F003F: return 2101;
-        case 0xFF78093F: return 2113;
-     /* case 0xFF6D0627: break;          NOTE: N/A COLOR */
-        case 0xFF432732: return 2123;
-        case 0xFFE6778B: return 2152;
-        case 0xFFDF8390: return 2153;
-        case 0xFFF9BFC0: return 2155;
-        case 0xFFFBD1D6: return 2160;
-        case 0xFFFDE3DB: return 2165;
-        case 0xFFD8D5D0: return 2166;
-        case 0xFFFEEDE2: return 2168;
-        case 0xFFF7DED6: return 2170;
-        case 0xFFF7DEDE: return 2171;
-        case 0xFFFCD9C4: return 2180;
-        case 0xFFE8418C: return 2220;
-        case 0xFF8C0C4A: return 2222;
-        case 0xFF883A40: return 2224;
-        case 0xFFEE71A1: return 2230;
-        case 0xFFA95A68: return 2241;
-        case 0xFFFAC8D3: return 2250;
-        case 0xFFD3007E: return 2300;
-        case 0xFFBF006A: return 2310;
-        case 0xFFD20067: return 2320;
-        case 0xFF780C38: return 2332;
-        case 0xFF651533: return 2333;
-        case 0xFF3A212B: return 2336;
-        case 0xFFF2E0DC: return 2360;
-        case 0xFFFDE5EC: return 2363;
-        case 0xFF970059: return 2500;
-        case 0xFF8B1771: return 2502;
-        case 0xFFAA4381: return 2504;
-        case 0xFFB40073: return 2505;
-        case 0xFF820052: return 2506;
-        case 0xFFD63C81: return 2513;
-        case 0xFFE20078: return 2520;
-     /* case 0xFFBF006A: return 2521;    TODO: duplicate case value */
-     /* case 0xFFEE71A1: return 2524;    TODO: duplicate case value */
-        case 0xFFF189AF: return 2550;
-        case 0xFFF7B4CA: return 2555;
-     /* case 0xFFF7B4CA: return 2560;    TODO: duplicate case value */
-        case 0xFF494949: return 2576;
-        case 0xFF394248: return 2578;
-        case 0xFF893480: return 2600;
-        case 0xFF6C0051: return 2611;
-        case 0xFFCD73A6: return 2620;
-        case 0xFFD994B9: return 2640;
-        case 0xFFDDBDD5: return 2645;
-        case 0xFFE6B7CF: return 2650;
-        case 0xFFECD2DE: return 2655;
-        case 0xFF606D8C: return 2674;
-        case 0xFF646A6E: return 2675;
-        case 0xFF610051: return 2711;
-        case 0xFF704191: return 2712;
-        case 0xFF490251: return 2715;
-     /* case 0xFF89347F: break;          NOTE: N/A COLOR */
-        case 0xFF2F206F: return 2743;
-        case 0xFFC690A1: return 2764;
-        case 0xFF6F067B: return 2810;
-        case 0xFFAD85B1: return 2820;
-        case 0xFFA974AB: return 2830;
-        case 0xFF4C0F7B: return 2900;
-        case 0xFF664090: return 2905;
-        case 0xFF83589D: return 2910;
-        case 0xFF8C6DAA: return 2920;
-        case 0xFFC9B5D4: return 3040;
-        case 0xFFC790BA: return 3045;
-        case 0xFF707070: return 3062;
-        case 0xFF2A377E: return 3102;
-        case 0xFF3C1F81: return 3103;
-        case 0xFF35247A: return 3110;
-        case 0xFF260751: return 3114;
-        case 0xFF28135B: return 3133;
-        case 0xFF6E5DA3: return 3200;
-        case 0xFF353A90: return 3210;
-        case 0xFF524A90: return 3211;
-        case 0xFF785FA3: return 3213;
-        case 0xFF241757: return 3222;
-        case 0xFF7D77AF: return 3241;
-        case 0xFF9083A3: return 3251;
-        case 0xFFB2AABD: return 3262;
-        case 0xFF392D88: return 3301;
-        case 0xFF5661A8: return 3321;
-        case 0xFF323887: return 3322;
-        case 0xFF14214E: return 3323;
-        case 0xFF3A2885: return 3330;
-        case 0xFF7F8BC2: return 3331;
-        case 0xFF1B3C78: return 3333;
-     /* case 0xFF2E4B9B: break;          NOTE: N/A COLOR */
-        case 0xFFB9BDD9: return 3340;
-        case 0xFF11263C: return 3344;
-        case 0xFF202A65: return 3353;
-        case 0xFF171B4A: return 3355;
-        case 0xFF959ACA: return 3420;
-        case 0xFF6A76B5: return 3430;
-     /* case 0xFF11263C: return 3443;    TODO: duplicate case value */
-        case 0xFF002232: return 3444;
-        case 0xFF2D4491: return 3522;
-        case 0xFF261257: return 3536;
-        case 0xFF53428A: return 3540;
-     /* case 0xFF3A2885: return 3541;    TODO: duplicate case value */
-        case 0xFF233B7D: return 3543;
-        case 0xFF273C82: return 3544;
-        case 0xFF272651: return 3554;
-        case 0xFF28438C: return 3600;
-        case 0xFF243A7D: return 3611;
-        case 0xFF4055A1: return 3612;
-        case 0xFF1A4C8D: return 3622;
-        case 0xFF1E569F: return 3631;
-        case 0xFF92B1DC: return 3640;
-        case 0xFF648DC7: return 3641;
-        case 0xFFD0DEEE: return 3650;
-     /* case 0xFFC8D6ED: break;          NOTE: N/A COLOR */
-        case 0xFFEAF0F9: return 3661;
-        case 0xFF00507F: return 3732;
-        case 0xFF12253C: return 3743;
-        case 0xFFB7D1E3: return 3750;
-     /* case 0xFFD0DEEE: return 3752;    TODO: duplicate case value */
-        case 0xFFAFC9E5: return 3761;
-        case 0xFFCED2D1: return 3770;
-        case 0xFF3D6AA1: return 3810;
-     /* case 0xFF7BA2D3: break;          NOTE: N/A COLOR */
-        case 0xFF91B9E2: return 3820;
-        case 0xFF00779E: return 3822;
-        case 0xFFB4CEEB: return 3840;
-        case 0xFF507193: return 3842;
-        case 0xFFD5E3F4: return 3845;
-        case 0xFF9AB8D3: return 3851;
-        case 0xFF007EBA: return 3900;
-        case 0xFF0082C4: return 3901;
-        case 0xFF006CA5: return 3902;
-        case 0xFF4ABDF0: return 3910;
-        case 0xFF86AACA: return 3951;
-        case 0xFF485E8A: return 3952;
-        case 0xFF697698: return 3953;
-        case 0xFFC5E1F3: return 3961;
-        case 0xFFA6D8F6: return 3962;
-        case 0xFFE1E1E1: return 3971;
-        case 0xFF0093B9: return 4010;
-        case 0xFF006587: return 4022;
-        case 0xFF87C7EA: return 4030;
-        case 0xFF507793: return 4032;
-        case 0xFF265674: return 4033;
-        case 0xFF9ED4E6: return 4040;
-     /* case 0xFFEAF0F9: return 4071;    TODO: duplicate case value */
-     /* case 0xFF838689: break;          NOTE: N/A COLOR */
-        case 0xFF0096C1: return 4100;
-        case 0xFF2DB0CF: return 4101;
-        case 0xFF0095C6: return 4103;
-        case 0xFF0081AA: return 4105;
-        case 0xFF00A4D9: return 4111;
-        case 0xFF00A9C9: return 4113;
-     /* case 0xFF0082AD: break;          NOTE: N/A COLOR */
-        case 0xFF5DBFD2: return 4121;
-        case 0xFF00405D: return 4133;
-     /* case 0xFF192024: return 4174;    TODO: duplicate case value */
-     /* case 0xFF192024: return 4175;    TODO: duplicate case value */
-        case 0xFF4FB4CB: return 4220;
-        case 0xFF8DCEE4: return 4230;
-     /* case 0xFF2DB0CF: return 4231;    TODO: duplicate case value */
-     /* case 0xFF006587: return 4232;    TODO: duplicate case value */
-        case 0xFF8DCDDB: return 4240;
-        case 0xFFD5EBF2: return 4250;
-        case 0xFF007389: return 4400;
-        case 0xFF007B8D: return 4410;
-        case 0xFF00B2CA: return 4420;
-        case 0xFF0091A5: return 4421;
-        case 0xFF007D8C: return 4423;
-        case 0xFF007986: return 4425;
-        case 0xFF5FBFD1: return 4430;
-        case 0xFF004250: return 4432;
-     /* case 0xFF8DCEE4: return 4440;    TODO: duplicate case value */
-        case 0xFF006981: return 4442;
-        case 0xFF007F92: return 4452;
-        case 0xFF008192: return 4500;
-        case 0xFF007079: return 4513;
-        case 0xFF002F38: return 4515;
-        case 0xFF00646A: return 4516;
-     /* case 0xFF007389: return 4531;    TODO: duplicate case value */
-     /* case 0xFF007B8D: return 4610;    TODO: duplicate case value */
-        case 0xFF00A3A0: return 4620;
-        case 0xFF0B7F85: return 4625;
-        case 0xFF005B63: return 4643;
-        case 0xFF234544: return 4644;
-        case 0xFF8CCDD3: return 4840;
-        case 0xFF006F73: return 5000;
-     /* case 0xFF005B63: return 5005;    TODO: duplicate case value */
-        case 0xFF00A6AD: return 5010;
-        case 0xFF49BAC0: return 5020;
-        case 0xFFCFDDE0: return 5040;
-        case 0xFFB4DCD8: return 5050;
-        case 0xFF00876E: return 5100;
-        case 0xFF009084: return 5101;
-        case 0xFF00B1AE: return 5111;
-        case 0xFF48BAB7: return 5115;
-        case 0xFF00AF8C: return 5210;
-        case 0xFF8CCCC2: return 5220;
-        case 0xFF47B9AE: return 5230;
-        case 0xFF197E6D: return 5233;
-     /* case 0xFF8CCCC2: return 5240;    TODO: duplicate case value */
-     /* case 0xFF005B63: return 5255;    TODO: duplicate case value */
-        case 0xFF006E42: return 5324;
-        case 0xFF004D3D: return 5326;
-     /* case 0xFF002F38: return 5335;    TODO: duplicate case value */
-        case 0xFF002D1F: return 5374;
-     /* case 0xFF002F38: return 5375;    TODO: duplicate case value */
-        case 0xFF008663: return 5411;
-        case 0xFF006B4E: return 5415;
-     /* case 0xFF008663: return 5422;    TODO: duplicate case value */
-        case 0xFF006B56: return 5425;
-        case 0xFF008879: return 5431;
-        case 0xFFDBE9E5: return 5460;
-        case 0xFF6AC093: return 5470;
-        case 0xFF52BA84: return 5500;
-        case 0xFF14A363: return 5510;
-        case 0xFF007848: return 5513;
-     /* case 0xFF008663: return 5515;    TODO: duplicate case value */
-        case 0xFF52A04F: return 5531;
-        case 0xFF6EA293: return 5542;
-        case 0xFF94ADA1: return 5552;
-        case 0xFF103828: return 5555;
-        case 0xFF63BE5F: return 5600;
-        case 0xFF85C875: return 5610;
-        case 0xFF2CB431: return 5611;
-        case 0xFF14B26D: return 5613;
-        case 0xFF40B780: return 5620;
-        case 0xFF1A781E: return 5633;
-        case 0xFF157436: return 5643;
-        case 0xFFC9E3C5: return 5650;
-        case 0xFF6B9181: return 5664;
-        case 0xFF3A6D57: return 5765;
-     /* case 0xFF103828: return 5766;    TODO: duplicate case value */
-        case 0xFF02140C: return 5776;
-        case 0xFFA5C278: return 5822;
-        case 0xFFB4D383: return 5832;
-        case 0xFF70953F: return 5833;
-        case 0xFFA2D289: return 5840;
-        case 0xFF273014: return 5866;
-        case 0xFF81C750: return 5912;
-        case 0xFF457021: return 5933;
-        case 0xFF506702: return 5934;
-        case 0xFFBBDB41: return 5940;
-        case 0xFF003518: return 5944;
-        case 0xFFE3EB00: return 6010;
-        case 0xFFBED782: return 6051;
-        case 0xFF2D3B01: return 6065;
-        case 0xFFDCDDD1: return 6071;
-        case 0xFF919600: return 6133;
-        case 0xFF484601: return 6156;
-    }
-
-    return -1;
+    const ThreadColor* colors;
+    int count;
+    const short* byNumber;
+    int numberCount;
+} ThreadChart;
+
+#define THREAD_CHART(brand) { threadColors_##brand, (int)(sizeof(threadColors_##brand) / sizeof(threadColors_##brand[0])), \
+                              threadColorsByNumber_##brand, (int)(sizeof(threadColorsByNumber_##brand) / sizeof(threadColorsByNumber_##brand[0])) }
+#define THREAD_CHART_EMPTY { 0, 0, 0, 0 } /* TODO: add the charts of the remaining brands */
+
+/* Indexed by ThreadBrand */
+static const ThreadChart threadCharts[] =
+{
+#ifdef ARDUINO
+    THREAD_CHART_EMPTY, /* Arc_Polyester */
+    THREAD_CHART_EMPTY, /* Arc_Rayon */
+    THREAD_CHART_EMPTY, /* CoatsAndClark_Rayon */
+    THREAD_CHART_EMPTY, /* Exquisite_Polyester */
+    THREAD_CHART_EMPTY, /* Fufu_Polyester */
+    THREAD_CHART_EMPTY, /* Fufu_Rayon */
+    THREAD_CHART_EMPTY, /* Hemingworth_Polyester */
+    THREAD_CHART_EMPTY, /* Isacord_Polyester */
+    THREAD_CHART_EMPTY, /* Isafil_Rayon */
+    THREAD_CHART_EMPTY, /* Marathon_Polyester */
+    THREAD_CHART_EMPTY, /* Marathon_Rayon */
+    THREAD_CHART_EMPTY, /* Madeira_Polyester */
+    THREAD_CHART_EMPTY, /* Madeira_Rayon */
+    THREAD_CHART_EMPTY, /* Metro_Polyester */
+    THREAD_CHART_EMPTY, /* Pantone */
+    THREAD_CHART_EMPTY, /* RobisonAnton_Polyester */
+    THREAD_CHART_EMPTY, /* RobisonAnton_Rayon */
+    THREAD_CHART_EMPTY, /* Sigma_Polyester */
+    THREAD_CHART_EMPTY, /* Sulky_Rayon */
+    THREAD_CHART_EMPTY, /* ThreadArt_Rayon */
+    THREAD_CHART_EMPTY, /* ThreadArt_Polyester */
+    THREAD_CHART_EMPTY, /* ThreaDelight_Polyester */
+    THREAD_CHART_EMPTY, /* Z102_Isacord_Polyester */
+#else
+    THREAD_CHART_EMPTY, /* Arc_Polyester */
+    THREAD_CHART_EMPTY, /* Arc_Rayon */
+    THREAD_CHART_EMPTY, /* CoatsAndClark_Rayon */
+    THREAD_CHART_EMPTY, /* Exquisite_Polyester */
+    THREAD_CHART_EMPTY, /* Fufu_Polyester */
+    THREAD_CHART_EMPTY, /* Fufu_Rayon */
+    THREAD_CHART(Hemingworth_Polyester), /* Hemingworth_Polyester */
+    THREAD_CHART(Isacord_Polyester), /* Isacord_Polyester */
+    THREAD_CHART(Isafil_Rayon), /* Isafil_Rayon */
+    THREAD_CHART_EMPTY, /* Marathon_Polyester */
+    THREAD_CHART_EMPTY, /* Marathon_Rayon */
+    THREAD_CHART_EMPTY, /* Madeira_Polyester */
+    THREAD_CHART_EMPTY, /* Madeira_Rayon */
+    THREAD_CHART_EMPTY, /* Metro_Polyester */
+    THREAD_CHART(Pantone), /* Pantone */
+    THREAD_CHART_EMPTY, /* RobisonAnton_Polyester */
+    THREAD_CHART(RobisonAnton_Rayon), /* RobisonAnton_Rayon */
+    THREAD_CHART(Sigma_Polyester), /* Sigma_Polyester */
+    THREAD_CHART(Sulky_Rayon), /* Sulky_Rayon */
+    THREAD_CHART_EMPTY, /* ThreadArt_Rayon */
+    THREAD_CHART_EMPTY, /* ThreadArt_Polyester */
+    THREAD_CHART_EMPTY, /* ThreaDelight_Polyester */
+    THREAD_CHART(Z102_Isacord_Polyester), /* Z102_Isacord_Polyester */
+#endif /* ARDUINO */
+};
+
+static const ThreadChart* threadColor_chart(ThreadBrand brand)
+{
+    if((int)brand < 0 || (int)brand >= (int)(sizeof(threadCharts) / sizeof(threadCharts[0])))
+        return 0;
+    return &threadCharts[brand];
 }
 
-const char* getName_Isafil_Rayon(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Marathon_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Marathon_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Marathon_Rayon(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Marathon_Rayon(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Madeira_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Madeira_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Madeira_Rayon(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Madeira_Rayon(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Metro_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_Metro_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Pantone(unsigned int color)
+/*! Returns the number of colors in the chart of \a brand. */
+int threadColor_count(ThreadBrand brand)
 {
-    switch(color)
-    {
-     /* case 0xFFF7E214: return "Process Yellow";    NOTE: N/A COLOR */
-        case 0xFFFFFF7D: return 100;
-        case 0xFFFFFF36: return 101;
-        case 0xFFFFFC0D: return 102;
-     /* case 0xFFFCE016: return "Pantone Yellow";    NOTE: N/A COLOR */
-        case 0xFFD1CB00: return 103;
-        case 0xFFB3AD00: return 104;
-        case 0xFF807C00: return 105;
-        case 0xFFFFFA4F: return 106;
-        case 0xFFFFF536: return 107;
-        case 0xFFFFF00D: return 108;
-        case 0xFFFFE600: return 109;
-        case 0xFFEDD100: return 110;
-        case 0xFFBAA600: return 111;
-        case 0xFF9E8E00: return 112;
-        case 0xFFFFED57: return 113;
-        case 0xFFFFEB45: return 114;
-        case 0xFFFFE833: return 115;
-        case 0xFFFFD600: return 116;
-        case 0xFFD9B200: return 117;
-        case 0xFFBA9900: return 118;
-        case 0xFF827200: return 119;
-        case 0xFFFFE86B: return 120;
-        case 0xFFFFF2B0: return 1205;
-        case 0xFFFFE34F: return 121;
-        case 0xFFFFE88C: return 1215;
-        case 0xFFFFD433: return 122;
-        case 0xFFFFD461: return 1225;
-        case 0xFFFFC20F: return 123;
-        case 0xFFFFB517: return 1235;
-        case 0xFFF0AD00: return 124;
-        case 0xFFD19700: return 1245;
-        case 0xFFBD8C00: return 125;
-        case 0xFFA87B00: return 1255;
-        case 0xFFA17800: return 126;
-        case 0xFF7D5B00: return 1265;
-        case 0xFFFFED80: return 127;
-        case 0xFFFFE359: return 128;
-        case 0xFFFFD63B: return 129;
-        case 0xFFFFB300: return 130;
-        case 0xFFE89E00: return 131;
-        case 0xFFB38100: return 132;
-        case 0xFF705A00: return 133;
-        case 0xFFFFE38C: return 134;
-        case 0xFFFFDB87: return 1345;
-        case 0xFFFFCF66: return 135;
-        case 0xFFFFCC70: return 1355;
-        case 0xFFFFBA3D: return 136;
-        case 0xFFFFB547: return 1365;
-        case 0xFFFFA61A: return 137;
-        case 0xFFFF991A: return 1375;
-        case 0xFFFC9200: return 138;
-        case 0xFFED8500: return 1385;
-        case 0xFFC47C00: return 139;
-        case 0xFFA15F00: return 1395;
-        case 0xFF755600: return 140;
-        case 0xFF5E3C00: return 1405;
-        case 0xFFFFCF7D: return 141;
-        case 0xFFFFB83D: return 142;
-        case 0xFFFFA626: return 143;
-        case 0xFFFF8500: return 144;
-        case 0xFFEB7C00: return 145;
-        case 0xFFAB6100: return 146;
-        case 0xFF705100: return 147;
-        case 0xFFFFD6A1: return 148;
-        case 0xFFFFBA75: return 1485;
-        case 0xFFFFC487: return 149;
-        case 0xFFFFAB54: return 1495;
-        case 0xFFFFA64D: return 150;
-        case 0xFFFF943B: return 1505;
-     /* case 0xFFEF6B00: return "Orange 021";    NOTE: N/A COLOR */
-        case 0xFFFF850D: return 151;
-        case 0xFFFC7C00: return 152;
-        case 0xFFE66000: return 1525;
-        case 0xFFD17100: return 153;
-        case 0xFF9E4A00: return 1535;
-        case 0xFFA85B00: return 154;
-        case 0xFF472200: return 1545;
-        case 0xFFFFE0B8: return 155;
-        case 0xFFFFC7A8: return 1555;
-        case 0xFFFFC794: return 156;
-        case 0xFFFFA882: return 1565;
-        case 0xFFFF914D: return 157;
-        case 0xFFFF8C47: return 1575;
-        case 0xFFFF6308: return 158;
-        case 0xFFFF701A: return 1585;
-        case 0xFFED5100: return 159;
-        case 0xFFF26300: return 1595;
-        case 0xFFAD4200: return 160;
-        case 0xFFB34F00: return 1605;
-        case 0xFF5C2C00: return 161;
-        case 0xFF914000: return 1615;
-        case 0xFFFFD9C7: return 162;
-        case 0xFFFFB0A1: return 1625;
-        case 0xFFFFB08F: return 163;
-        case 0xFFFF9C85: return 1635;
-        case 0xFFFF8A45: return 164;
-        case 0xFFFF8257: return 1645;
-        case 0xFFFF690A: return 165;
-        case 0xFFFF5E17: return 1655;
-        case 0xFFFF5C00: return 166;
-        case 0xFFFF5200: return 1665;
-        case 0xFFD45500: return 167;
-        case 0xFFB83D00: return 1675;
-        case 0xFF692D00: return 168;
-        case 0xFF8F2E00: return 1685;
-        case 0xFFFFCCCC: return 169;
-        case 0xFFFF998F: return 170;
-        case 0xFFFF7852: return 171;
-        case 0xFFFF571F: return 172;
-        case 0xFFF54C00: return 173;
-        case 0xFFA33100: return 174;
-        case 0xFF662400: return 175;
-        case 0xFFFFBFD1: return 176;
-        case 0xFFFF9EC9: return 1765;
-        case 0xFFFFBAE0: return 1767;
-        case 0xFFFF8C99: return 177;
-        case 0xFFFF87B5: return 1775;
-        case 0xFFFF6BA3: return 1777;
-        case 0xFFFF6970: return 178;
-     /* case 0xFFF93F26: return "Warm Red";    NOTE: N/A COLOR */
-        case 0xFFFF5480: return 1785;
-        case 0xFFFF3D66: return 1787;
-     /* case 0xFFEF2B2D: return "Red 032";    NOTE: N/A COLOR */
-        case 0xFFFF291F: return 1788;
-        case 0xFFFF3600: return 179;
-        case 0xFFFF0F00: return 1795;
-        case 0xFFF50002: return 1797;
-        case 0xFFE33000: return 180;
-        case 0xFFC41200: return 1805;
-        case 0xFFB80007: return 1807;
-        case 0xFF872300: return 181;
-        case 0xFF7D0C00: return 1815;
-        case 0xFF570900: return 1817;
-        case 0xFFFFBDE6: return 182;
-        case 0xFFFF8AC9: return 183;
-        case 0xFFFF5296: return 184;
-        case 0xFFFF173D: return 185;
-        case 0xFFF5002F: return 186;
-        case 0xFFCC002B: return 187;
-        case 0xFF800400: return 188;
-        case 0xFFFFA1E6: return 189;
-        case 0xFFFFB8ED: return 1895;
-        case 0xFFFF73C7: return 190;
-        case 0xFFFF96E8: return 1905;
-        case 0xFFFF3D9E: return 191;
-        case 0xFFFF4ACC: return 1915;
-        case 0xFFFF0052: return 192;
-        case 0xFFFF0073: return 1925;
-        case 0xFFDE004B: return 193;
-        case 0xFFF20068: return 1935;
-        case 0xFFAB003E: return 194;
-        case 0xFFCF005B: return 1945;
-        case 0xFF73002E: return 195;
-        case 0xFFA10040: return 1955;
-        case 0xFFFFBFF5: return 196;
-        case 0xFFFF8CE6: return 197;
-        case 0xFFFF38AB: return 198;
-        case 0xFFFF0061: return 199;
-        case 0xFFE00053: return 200;
-        case 0xFFB50043: return 201;
-        case 0xFF910039: return 202;
-        case 0xFFFFA8F7: return 203;
-        case 0xFFFF6BF7: return 204;
-        case 0xFFFF29E8: return 205;
-        case 0xFFF70099: return 206;
-        case 0xFFCF0076: return 207;
-        case 0xFFA10067: return 208;
-        case 0xFF78004F: return 209;
-        case 0xFFFF9CF0: return 210;
-        case 0xFFFF73EB: return 211;
-        case 0xFFFF47E3: return 212;
-        case 0xFFFF0DBA: return 213;
-        case 0xFFEB009B: return 214;
-        case 0xFFBA0079: return 215;
-        case 0xFF82074E: return 216;
-        case 0xFFFFB8FF: return 217;
-        case 0xFFFA63FF: return 218;
-        case 0xFFFC1FFF: return 219;
-     /* case 0xFFD10056: return "Rubine Red";    NOTE: N/A COLOR */
-        case 0xFFD400B8: return 220;
-        case 0xFFB30098: return 221;
-        case 0xFF69005E: return 222;
-        case 0xFFFF8AFF: return 223;
-        case 0xFFFC5EFF: return 224;
-        case 0xFFFC2BFF: return 225;
-        case 0xFFFF00FF: return 226;
-        case 0xFFCF00C0: return 227;
-        case 0xFF960090: return 228;
-        case 0xFF660057: return 229;
-        case 0xFFFFA8FF: return 230;
-        case 0xFFFC7AFF: return 231;
-        case 0xFFF754FF: return 232;
-     /* case 0xFFED0091: return "Rhodamine Red";    NOTE: N/A COLOR */
-        case 0xFFE300FF: return 233;
-        case 0xFFB100BD: return 234;
-        case 0xFF910099: return 235;
-        case 0xFFFCB3FF: return 236;
-        case 0xFFFABAFF: return 2365;
-        case 0xFFF782FF: return 237;
-        case 0xFFE66EFF: return 2375;
-        case 0xFFF05EFF: return 238;
-        case 0xFFCF36FF: return 2385;
-        case 0xFFE336FF: return 239;
-        case 0xFFBA0DFF: return 2395;
-        case 0xFFD10FFF: return 240;
-        case 0xFFA800FF: return 2405;
-        case 0xFFB600FA: return 241;
-        case 0xFF9D00EB: return 2415;
-        case 0xFF750082: return 242;
-        case 0xFF7700BD: return 2425;
-        case 0xFFF2B5FF: return 243;
-        case 0xFFE89EFF: return 244;
-        case 0xFFDB78FF: return 245;
-        case 0xFFB51AFF: return 246;
-        case 0xFFA300FF: return 247;
-        case 0xFF9600FA: return 248;
-        case 0xFF6E00B8: return 249;
-        case 0xFFF2D1FF: return 250;
-        case 0xFFDE9CFF: return 251;
-        case 0xFFC270FF: return 252;
-     /* case 0xFFBF30B5: return "Purple";    NOTE: N/A COLOR */
-        case 0xFF910DFF: return 253;
-        case 0xFF8000FF: return 254;
-        case 0xFF5E00BF: return 255;
-        case 0xFFEDCCFF: return 256;
-        case 0xFFCFA6FF: return 2562;
-        case 0xFFC7ABFF: return 2563;
-        case 0xFFB5A3FF: return 2567;
-        case 0xFFDBA8FF: return 257;
-        case 0xFFB387FF: return 2572;
-        case 0xFFB391FF: return 2573;
-        case 0xFF998CFF: return 2577;
-        case 0xFF913DFF: return 258;
-        case 0xFF8A47FF: return 2582;
-        case 0xFF8A5EFF: return 2583;
-        case 0xFF6957FF: return 2587;
-        case 0xFF5F00D9: return 259;
-        case 0xFF661AFF: return 2592;
-        case 0xFF631CFF: return 2593;
-        case 0xFF2600FF: return 2597;
-        case 0xFF5B00BD: return 260;
-        case 0xFF5C00F7: return 2602;
-        case 0xFF4D00FA: return 2603;
-        case 0xFF2D00ED: return 2607;
-        case 0xFF500099: return 261;
-        case 0xFF4F00DB: return 2612;
-        case 0xFF5000D9: return 2613;
-        case 0xFF2E00D9: return 2617;
-        case 0xFF3F0073: return 262;
-        case 0xFF3C008F: return 2622;
-        case 0xFF4700AD: return 2623;
-        case 0xFF2800B0: return 2627;
-        case 0xFFE6DBFF: return 263;
-        case 0xFFB8BAFF: return 2635;
-        case 0xFFBDB8FF: return 264;
-        case 0xFF99A3FF: return 2645;
-        case 0xFF7570FF: return 265;
-        case 0xFF7582FF: return 2655;
-        case 0xFF361AFF: return 266;
-        case 0xFF6166FF: return 2665;
-     /* case 0xFF6607A5: return "Violet";    NOTE: N/A COLOR */
-        case 0xFF1C00FF: return 267;
-        case 0xFF2800E0: return 268;
-        case 0xFF0900E6: return 2685;
-        case 0xFF2600AB: return 269;
-        case 0xFF0C0082: return 2695;
-        case 0xFFB0BAFF: return 270;
-        case 0xFF99B3FF: return 2705;
-        case 0xFFCFE8FF: return 2706;
-        case 0xFFD4F0FF: return 2707;
-        case 0xFFBDE6FF: return 2708;
-        case 0xFF91A1FF: return 271;
-        case 0xFF6E8CFF: return 2715;
-        case 0xFF8CB5FF: return 2716;
-        case 0xFFB5E0FF: return 2717;
-        case 0xFF5496FF: return 2718;
-        case 0xFF6B85FF: return 272;
-        case 0xFF3B52FF: return 2725;
-        case 0xFF3657FF: return 2726;
-        case 0xFF4A94FF: return 2727;
-     /* case 0xFF380096: return "Blue 072";    NOTE: N/A COLOR */
-        case 0xFF0A4FFF: return 2728;
-        case 0xFF0009EB: return 273;
-        case 0xFF000DFF: return 2735;
-        case 0xFF0017FF: return 2736;
-        case 0xFF0020FA: return 2738;
-        case 0xFF0000B8: return 274;
-        case 0xFF000BD9: return 2745;
-        case 0xFF0012E6: return 2746;
-        case 0xFF001ED9: return 2747;
-        case 0xFF001AD9: return 2748;
-        case 0xFF030091: return 275;
-        case 0xFF0005B3: return 2755;
-        case 0xFF000BB5: return 2756;
-        case 0xFF0020B3: return 2757;
-        case 0xFF0026BD: return 2758;
-        case 0xFF020073: return 276;
-        case 0xFF00048C: return 2765;
-        case 0xFF000887: return 2766;
-        case 0xFF001A75: return 2767;
-        case 0xFF001F8F: return 2768;
-        case 0xFFBAEDFF: return 277;
-        case 0xFF9CDBFF: return 278;
-        case 0xFF52A8FF: return 279;
-     /* case 0xFF0C1C8C: return "Reflex Blue";    NOTE: N/A COLOR */
-        case 0xFF003BD1: return 280;
-        case 0xFF0031AD: return 281;
-        case 0xFF002675: return 282;
-        case 0xFFA6E8FF: return 283;
-        case 0xFF73CFFF: return 284;
-        case 0xFF1C91FF: return 285;
-        case 0xFF0055FA: return 286;
-        case 0xFF0048E0: return 287;
-        case 0xFF0041C4: return 288;
-        case 0xFF00246B: return 289;
-        case 0xFFBFFAFF: return 290;
-        case 0xFF96FAFF: return 2905;
-        case 0xFFABF7FF: return 291;
-        case 0xFF69EDFF: return 2915;
-        case 0xFF82E3FF: return 292;
-        case 0xFF26C2FF: return 2925;
-        case 0xFF006BFA: return 293;
-        case 0xFF008AFF: return 2935;
-        case 0xFF0055C9: return 294;
-        case 0xFF0079DB: return 2945;
-        case 0xFF0045A1: return 295;
-        case 0xFF0058A1: return 2955;
-        case 0xFF00294D: return 296;
-        case 0xFF00395C: return 2965;
-        case 0xFF82FCFF: return 297;
-        case 0xFFB3FFF2: return 2975;
-        case 0xFF4FEDFF: return 298;
-        case 0xFF69FFF0: return 2985;
-        case 0xFF26CFFF: return 299;
-        case 0xFF1AE3FF: return 2995;
-        case 0xFF008FFF: return 300;
-        case 0xFF00A0FA: return 3005;
-        case 0xFF0073D1: return 301;
-        case 0xFF0089CC: return 3015;
-        case 0xFF006080: return 302;
-        case 0xFF00687D: return 3025;
-        case 0xFF003B42: return 303;
-        case 0xFF004744: return 3035;
-        case 0xFFB3FFEB: return 304;
-        case 0xFF7DFFE8: return 305;
-        case 0xFF40FFED: return 306;
-     /* case 0xFF0091C9: return "Process Blue";    NOTE: N/A COLOR */
-        case 0xFF009CBA: return 307;
-        case 0xFF008087: return 308;
-        case 0xFF004741: return 309;
-        case 0xFF91FFE6: return 310;
-        case 0xFF91FFE0: return 3105;
-        case 0xFF5EFFE0: return 311;
-        case 0xFF5EFFD1: return 3115;
-        case 0xFF0AFFE3: return 312;
-        case 0xFF2BFFC9: return 3125;
-        case 0xFF00DECC: return 313;
-        case 0xFF00E8C3: return 3135;
-        case 0xFF00B3A2: return 314;
-        case 0xFF00C49F: return 3145;
-        case 0xFF009180: return 315;
-        case 0xFF009E78: return 3155;
-        case 0xFF00523C: return 316;
-        case 0xFF005940: return 3165;
-        case 0xFFD1FFEB: return 317;
-        case 0xFF9EFFD9: return 318;
-        case 0xFF7AFFCF: return 319;
-        case 0xFF00EDA4: return 320;
-        case 0xFF00C487: return 321;
-        case 0xFF00A66F: return 322;
-        case 0xFF008754: return 323;
-        case 0xFFB8FFE0: return 324;
-        case 0xFFA1FFD1: return 3242;
-        case 0xFFA8FFCF: return 3245;
-        case 0xFF91FFC2: return 3248;
-        case 0xFF70FFBD: return 325;
-        case 0xFF87FFC2: return 3252;
-        case 0xFF82FFB8: return 3255;
-        case 0xFF69FFAB: return 3258;
-        case 0xFF21FF9E: return 326;
-        case 0xFF4AFFAB: return 3262;
-        case 0xFF4FFFA1: return 3265;
-        case 0xFF1AFF82: return 3268;
-        case 0xFF00D477: return 327;
-        case 0xFF00FF8F: return 3272;
-        case 0xFF0DFF87: return 3275;
-        case 0xFF00F26D: return 3278;
-        case 0xFF00AD5F: return 328;
-        case 0xFF00D975: return 3282;
-        case 0xFF00ED77: return 3285;
-        case 0xFF00CC5E: return 3288;
-        case 0xFF008A4A: return 329;
-        case 0xFF008A46: return 3292;
-        case 0xFF00C95F: return 3295;
-        case 0xFF009440: return 3298;
-        case 0xFF006635: return 330;
-        case 0xFF004F24: return 3302;
-        case 0xFF006327: return 3305;
-        case 0xFF00471D: return 3308;
-        case 0xFFC2FFD6: return 331;
-        case 0xFFB3FFCC: return 332;
-        case 0xFF91FFBA: return 333;
-     /* case 0xFF00AF93: return "Green";    NOTE: N/A COLOR */
-        case 0xFF00F763: return 334;
-        case 0xFF00B33E: return 335;
-        case 0xFF00872D: return 336;
-        case 0xFFB0FFCC: return 337;
-        case 0xFFA6FFBF: return 3375;
-        case 0xFF87FFAD: return 338;
-        case 0xFF8CFFAB: return 3385;
-        case 0xFF29FF70: return 339;
-        case 0xFF63FF8C: return 3395;
-        case 0xFF00E84F: return 340;
-        case 0xFF26FF59: return 3405;
-        case 0xFF00B53C: return 341;
-        case 0xFF00C72E: return 3415;
-        case 0xFF00912A: return 342;
-        case 0xFF009421: return 3425;
-        case 0xFF02631C: return 343;
-        case 0xFF005710: return 3435;
-        case 0xFFBAFFC4: return 344;
-        case 0xFF9EFFAD: return 345;
-        case 0xFF73FF87: return 346;
-        case 0xFF00F723: return 347;
-        case 0xFF00C21D: return 348;
-        case 0xFF00940D: return 349;
-        case 0xFF0D4000: return 350;
-        case 0xFFD4FFD6: return 351;
-        case 0xFFBAFFBF: return 352;
-        case 0xFF9EFFA3: return 353;
-        case 0xFF33FF1A: return 354;
-        case 0xFF0FFF00: return 355;
-        case 0xFF09BA00: return 356;
-        case 0xFF167000: return 357;
-        case 0xFFBAFF9E: return 358;
-        case 0xFFA3FF82: return 359;
-        case 0xFF6BFF33: return 360;
-        case 0xFF4FFF00: return 361;
-        case 0xFF46E800: return 362;
-        case 0xFF3EC200: return 363;
-        case 0xFF349400: return 364;
-        case 0xFFE0FFB5: return 365;
-        case 0xFFCCFF8F: return 366;
-        case 0xFFADFF69: return 367;
-        case 0xFF6EFF00: return 368;
-        case 0xFF61ED00: return 369;
-        case 0xFF52BA00: return 370;
-        case 0xFF407000: return 371;
-        case 0xFFE6FFAB: return 372;
-        case 0xFFD6FF8A: return 373;
-        case 0xFFC2FF6E: return 374;
-        case 0xFF96FF38: return 375;
-        case 0xFF74F200: return 376;
-        case 0xFF6BC200: return 377;
-        case 0xFF436600: return 378;
-        case 0xFFE8FF6B: return 379;
-        case 0xFFDEFF47: return 380;
-        case 0xFFCCFF17: return 381;
-        case 0xFFB5FF00: return 382;
-        case 0xFFA5CF00: return 383;
-        case 0xFF90B000: return 384;
-        case 0xFF686B00: return 385;
-        case 0xFFF0FF70: return 386;
-        case 0xFFE6FF42: return 387;
-        case 0xFFDBFF36: return 388;
-        case 0xFFCCFF26: return 389;
-        case 0xFFB7EB00: return 390;
-        case 0xFF95AB00: return 391;
-        case 0xFF798200: return 392;
-        case 0xFFF7FF73: return 393;
-        case 0xFFFCFF52: return 3935;
-        case 0xFFF0FF3D: return 394;
-        case 0xFFF7FF26: return 3945;
-        case 0xFFEBFF26: return 395;
-        case 0xFFF0FF00: return 3955;
-        case 0xFFE3FF0F: return 396;
-        case 0xFFEBFF00: return 3965;
-        case 0xFFCCE300: return 397;
-        case 0xFFB5B500: return 3975;
-        case 0xFFABB800: return 398;
-        case 0xFF969200: return 3985;
-        case 0xFF919100: return 399;
-        case 0xFF5C5900: return 3995;
-        case 0xFFD6D0C9: return 400;
-        case 0xFFC4BBAF: return 401;
-        case 0xFFB0A597: return 402;
-        case 0xFF918779: return 403;
-        case 0xFF706758: return 404;
-        case 0xFF474030: return 405;
-     /* case 0xFF3D332B: return "Black";    NOTE: N/A COLOR */
-        case 0xFFD6CBC9: return 406;
-        case 0xFFBDAEAC: return 407;
-        case 0xFFA89796: return 408;
-        case 0xFF8C7A77: return 409;
-        case 0xFF705C59: return 410;
-        case 0xFF47342E: return 411;
-        case 0xFF050402: return 412;
-        case 0xFFCCCCBA: return 413;
-        case 0xFFB3B3A1: return 414;
-        case 0xFF969684: return 415;
-        case 0xFF80806B: return 416;
-        case 0xFF585943: return 417;
-        case 0xFF3E402C: return 418;
-        case 0xFF000000: return 419;
-        case 0xFFD9D9D9: return 420;
-        case 0xFFBDBDBD: return 421;
-        case 0xFFABABAB: return 422;
-        case 0xFF8F8F8F: return 423;
-        case 0xFF636363: return 424;
-        case 0xFF3B3B3B: return 425;
-     /* case 0xFF000000: return 426;    TODO: duplicate case value */
-        case 0xFFE3E3E3: return 427;
-        case 0xFFCDD1D1: return 428;
-        case 0xFFA8ADAD: return 429;
-        case 0xFF858C8C: return 430;
-        case 0xFF525B5C: return 431;
-        case 0xFF2D393B: return 432;
-        case 0xFF090C0D: return 433;
-        case 0xFFEDE6E8: return 434;
-        case 0xFFDED6DB: return 435;
-        case 0xFFC2BFBF: return 436;
-        case 0xFF8A8C8A: return 437;
-        case 0xFF394500: return 438;
-        case 0xFF293300: return 439;
-        case 0xFF202700: return 440;
-        case 0xFFDAE8D8: return 441;
-        case 0xFFBECFBC: return 442;
-        case 0xFF9DB39D: return 443;
-        case 0xFF7E947E: return 444;
-        case 0xFF475947: return 445;
-        case 0xFF324031: return 446;
-        case 0xFF272E20: return 447;
-        /* BEGIN N/A COLORS */
-        /*
-        case 0xFFE5DBCC: return "Warm Gray 1";
-        case 0xFFDDD1C1: return "Warm Gray 2";
-        case 0xFFCCC1B2: return "Warm Gray 3";
-        case 0xFFC1B5A5: return "Warm Gray 4";
-        case 0xFFB5A899: return "Warm Gray 5";
-        case 0xFFAFA393: return "Warm Gray 6";
-        case 0xFFA39687: return "Warm Gray 7";
-        case 0xFF96897A: return "Warm Gray 8";
-        case 0xFF8C7F70: return "Warm Gray 9";
-        case 0xFF827263: return "Warm Gray 10";
-        case 0xFF6D5E51: return "Warm Gray 11";
-        case 0xFFE8E2D6: return "Cool Gray 1";
-        case 0xFFDDD8CE: return "Cool Gray 2";
-        case 0xFFD3CEC4: return "Cool Gray 3";
-        case 0xFFC4C1BA: return "Cool Gray 4";
-        case 0xFFBAB7AF: return "Cool Gray 5";
-        case 0xFFB5B2AA: return "Cool Gray 6";
-        case 0xFFA5A39E: return "Cool Gray 7";
-        case 0xFF9B9993: return "Cool Gray 8";
-        case 0xFF8C8984: return "Cool Gray 9";
-        case 0xFF777772: return "Cool Gray 10";
-        */
-        /* END N/A COLORS */
-        case 0xFF2D3E00: return 448;
-        case 0xFF4F3A00: return 4485;
-        case 0xFF3D5200: return 449;
-        case 0xFF8A6E07: return 4495;
-        case 0xFF506700: return 450;
-        case 0xFFA38B24: return 4505;
-        case 0xFFABB573: return 451;
-        case 0xFFC2B061: return 4515;
-        case 0xFFC2CF9C: return 452;
-        case 0xFFD4C581: return 4525;
-        case 0xFFDBE3BF: return 453;
-        case 0xFFE3DA9F: return 4535;
-        case 0xFFE8EDD6: return 454;
-        case 0xFFF0E9C2: return 4545;
-        case 0xFF594A00: return 455;
-        case 0xFF917C00: return 456;
-        case 0xFFB89C00: return 457;
-        case 0xFFE6E645: return 458;
-        case 0xFFF0ED73: return 459;
-        case 0xFFF5F28F: return 460;
-        case 0xFFF7F7A6: return 461;
-        case 0xFF402600: return 462;
-        case 0xFF361500: return 4625;
-        case 0xFF6B3D00: return 463;
-        case 0xFF8F4A06: return 4635;
-        case 0xFF955300: return 464;
-        case 0xFFB8743B: return 4645;
-        case 0xFFCCAD6B: return 465;
-        case 0xFFD19B73: return 4655;
-        case 0xFFE0C791: return 466;
-        case 0xFFE6BC9C: return 4665;
-        case 0xFFE8D9A8: return 467;
-        case 0xFFF0D5BD: return 4675;
-        case 0xFFF0E8C4: return 468;
-        case 0xFFF5E4D3: return 4685;
-        case 0xFF4A1A00: return 469;
-        case 0xFF420D00: return 4695;
-        case 0xFFAB4800: return 470;
-        case 0xFF823126: return 4705;
-        case 0xFFD15600: return 471;
-        case 0xFFA8625D: return 4715;
-        case 0xFFFFA87A: return 472;
-        case 0xFFBF827C: return 4725;
-        case 0xFFFFC4A3: return 473;
-        case 0xFFD9A9A7: return 4735;
-        case 0xFFFFD9BD: return 474;
-        case 0xFFE6BEBC: return 4745;
-        case 0xFFFFE3CC: return 475;
-        case 0xFFF0D8D3: return 4755;
-        case 0xFF381C00: return 476;
-        case 0xFF4F1800: return 477;
-        case 0xFF6B1200: return 478;
-        case 0xFFB08573: return 479;
-        case 0xFFD9B5B0: return 480;
-        case 0xFFE8CFC9: return 481;
-        case 0xFFF2E0DE: return 482;
-        case 0xFF660700: return 483;
-        case 0xFFB50900: return 484;
-        case 0xFFFF0D00: return 485;
-        case 0xFFFF8796: return 486;
-        case 0xFFFFA6B8: return 487;
-        case 0xFFFFBDCF: return 488;
-        case 0xFFFFD9E3: return 489;
-        case 0xFF471300: return 490;
-        case 0xFF7A1A00: return 491;
-        case 0xFF942200: return 492;
-        case 0xFFF283BB: return 493;
-        case 0xFFFFABDE: return 494;
-        case 0xFFFFC2E3: return 495;
-        case 0xFFFFD6E8: return 496;
-        case 0xFF381100: return 497;
-        case 0xFF330E00: return 4975;
-        case 0xFF662500: return 498;
-        case 0xFF853241: return 4985;
-        case 0xFF853100: return 499;
-        case 0xFFA85868: return 4995;
-        case 0xFFE38DB3: return 500;
-        case 0xFFC47A8F: return 5005;
-        case 0xFFF7B5D7: return 501;
-        case 0xFFE3AAC1: return 5015;
-        case 0xFFFCCFE3: return 502;
-        case 0xFFEDC2D1: return 5025;
-        case 0xFFFFE3EB: return 503;
-        case 0xFFF7DFE1: return 5035;
-        case 0xFF320000: return 504;
-        case 0xFF600000: return 505;
-        case 0xFF770000: return 506;
-        case 0xFFDE82C4: return 507;
-        case 0xFFF2A3E3: return 508;
-        case 0xFFFFC2ED: return 509;
-        case 0xFFFFD4F0: return 510;
-        case 0xFF3D0066: return 511;
-        case 0xFF2B0041: return 5115;
-        case 0xFF6100CE: return 512;
-        case 0xFF592482: return 5125;
-        case 0xFF8A1FFF: return 513;
-        case 0xFF8257B8: return 5135;
-        case 0xFFD980FF: return 514;
-        case 0xFFB38CE0: return 5145;
-        case 0xFFED9EFF: return 515;
-        case 0xFFD4B3EB: return 5155;
-        case 0xFFF7BAFF: return 516;
-        case 0xFFE8CFF2: return 5165;
-        case 0xFFFFD1FF: return 517;
-        case 0xFFF2E0F7: return 5175;
-        case 0xFF2E005C: return 518;
-        case 0xFF1C0022: return 5185;
-        case 0xFF44009D: return 519;
-        case 0xFF3D0C4E: return 5195;
-        case 0xFF5C00E0: return 520;
-        case 0xFF7A5E85: return 5205;
-        case 0xFFBA87FF: return 521;
-        case 0xFFB59EC2: return 5215;
-        case 0xFFD4A1FF: return 522;
-        case 0xFFD4BAD9: return 5225;
-        case 0xFFE6BDFF: return 523;
-        case 0xFFE6D4E6: return 5235;
-        case 0xFFF0D9FF: return 524;
-        case 0xFFF0E6ED: return 5245;
-        case 0xFF270085: return 525;
-        case 0xFF0D0B4D: return 5255;
-        case 0xFF3B00ED: return 526;
-        case 0xFF20258A: return 5265;
-        case 0xFF4500FF: return 527;
-        case 0xFF3848A8: return 5275;
-        case 0xFF9673FF: return 528;
-        case 0xFF7280C4: return 5285;
-        case 0xFFBD99FF: return 529;
-        case 0xFFA8B3E6: return 5295;
-        case 0xFFD1B0FF: return 530;
-        case 0xFFC7CEED: return 5305;
-        case 0xFFE6CCFF: return 531;
-        case 0xFFE4E4F2: return 5315;
-        case 0xFF00193F: return 532;
-        case 0xFF00227B: return 533;
-        case 0xFF002CAA: return 534;
-        case 0xFF94B3ED: return 535;
-        case 0xFFB0C7F2: return 536;
-        case 0xFFC7DBF7: return 537;
-        case 0xFFDEE8FA: return 538;
-        case 0xFF00274D: return 539;
-        case 0xFF00223D: return 5395;
-        case 0xFF003473: return 540;
-        case 0xFF3A728A: return 5405;
-        case 0xFF00449E: return 541;
-        case 0xFF5A8A96: return 5415;
-        case 0xFF5EC1F7: return 542;
-        case 0xFF79A6AD: return 5425;
-        case 0xFF96E3FF: return 543;
-        case 0xFFB8CDD4: return 5435;
-        case 0xFFB3F0FF: return 544;
-        case 0xFFCCDCDE: return 5445;
-        case 0xFFC7F7FF: return 545;
-        case 0xFFDAE8E8: return 5455;
-        case 0xFF02272B: return 546;
-        case 0xFF002B24: return 5463;
-        case 0xFF000D09: return 5467;
-        case 0xFF003440: return 547;
-        case 0xFF167A58: return 5473;
-        case 0xFF1D4230: return 5477;
-        case 0xFF00465C: return 548;
-        case 0xFF43B08B: return 5483;
-        case 0xFF48705D: return 5487;
-        case 0xFF56ADBA: return 549;
-        case 0xFF73C9AD: return 5493;
-        case 0xFF829E90: return 5497;
-        case 0xFF7BC1C9: return 550;
-        case 0xFF9CDBC5: return 5503;
-        case 0xFFA1B5A8: return 5507;
-        case 0xFFA2D7DE: return 551;
-        case 0xFFC7F2E1: return 5513;
-        case 0xFFBED1C5: return 5517;
-        case 0xFFC5E8E8: return 552;
-        case 0xFFDCF7EB: return 5523;
-        case 0xFFD5E3DA: return 5527;
-        case 0xFF143319: return 553;
-        case 0xFF102E14: return 5535;
-        case 0xFF115422: return 554;
-        case 0xFF327A3D: return 5545;
-        case 0xFF187031: return 555;
-        case 0xFF5A9E68: return 5555;
-        case 0xFF66BA80: return 556;
-        case 0xFF84BD8F: return 5565;
-        case 0xFF98D9AD: return 557;
-        case 0xFFA9D4B2: return 5575;
-        case 0xFFBAE8CA: return 558;
-        case 0xFFCAE6CC: return 5585;
-        case 0xFFCEF0D8: return 559;
-        case 0xFFDDEDDA: return 5595;
-        case 0xFF0D4018: return 560;
-        case 0xFF050F07: return 5605;
-        case 0xFF127A38: return 561;
-        case 0xFF2E522B: return 5615;
-        case 0xFF1AB058: return 562;
-        case 0xFF5A7D57: return 5625;
-        case 0xFF79FCAC: return 563;
-        case 0xFF89A386: return 5635;
-        case 0xFFA1FFCC: return 564;
-        case 0xFFAEBFA6: return 5645;
-        case 0xFFC4FFDE: return 565;
-        case 0xFFC5D1BE: return 5655;
-        case 0xFFDBFFE8: return 566;
-        case 0xFFDAE6D5: return 5665;
-        case 0xFF0E4D1C: return 567;
-        case 0xFF14A346: return 568;
-        case 0xFF04D45B: return 569;
-        case 0xFF85FFB5: return 570;
-        case 0xFFADFFCF: return 571;
-        case 0xFFC4FFDB: return 572;
-     /* case 0xFFDBFFE8: return 573;    TODO: duplicate case value */
-        case 0xFF314A0E: return 574;
-        case 0xFF1F2E07: return 5743;
-        case 0xFF243600: return 5747;
-        case 0xFF3E7800: return 575;
-        case 0xFF3F5410: return 5753;
-        case 0xFF547306: return 5757;
-        case 0xFF4F9C00: return 576;
-        case 0xFF5C6E1D: return 5763;
-        case 0xFF849C32: return 5767;
-        case 0xFFAEE67C: return 577;
-        case 0xFF909E5A: return 5773;
-        case 0xFFA5B85E: return 5777;
-        case 0xFFC0F090: return 578;
-        case 0xFFAFBA86: return 5783;
-        case 0xFFCEDE99: return 5787;
-        case 0xFFCDF7A3: return 579;
-        case 0xFFC9D1A5: return 5793;
-        case 0xFFDCE8B0: return 5797;
-        case 0xFFDCFAB9: return 580;
-        case 0xFFDEE3C8: return 5803;
-        case 0xFFE9F0CE: return 5807;
-        case 0xFF464700: return 581;
-        case 0xFF363605: return 5815;
-        case 0xFF788A00: return 582;
-        case 0xFF69660E: return 5825;
-        case 0xFFA3D400: return 583;
-        case 0xFF999632: return 5835;
-        case 0xFFD3F032: return 584;
-        case 0xFFB3B15F: return 5845;
-        case 0xFFDEFA55: return 585;
-        case 0xFFD1D190: return 5855;
-        case 0xFFE8FF78: return 586;
-        case 0xFFDEDEA6: return 5865;
-        case 0xFFF2FF99: return 587;
-        case 0xFFEBEBC0: return 5875;
-        case 0xFFFFFFB5: return 600;
-        case 0xFFFFFF99: return 601;
-     /* case 0xFFFFFF7D: return 602;    TODO: duplicate case value */
-        case 0xFFFCFC4E: return 603;
-        case 0xFFF7F71E: return 604;
-        case 0xFFEDE800: return 605;
-        case 0xFFE0D700: return 606;
-        case 0xFFFCFCCF: return 607;
-        case 0xFFFAFAAA: return 608;
-        case 0xFFF5F584: return 609;
-        case 0xFFF0F065: return 610;
-        case 0xFFE3E112: return 611;
-        case 0xFFCCC800: return 612;
-        case 0xFFB3AB00: return 613;
-        case 0xFFF5F5C4: return 614;
-        case 0xFFF0EDAF: return 615;
-        case 0xFFE8E397: return 616;
-        case 0xFFD4CF6E: return 617;
-        case 0xFFB3AD17: return 618;
-        case 0xFF918C00: return 619;
-        case 0xFF787200: return 620;
-        case 0xFFD9FAE1: return 621;
-        case 0xFFBAF5C6: return 622;
-        case 0xFF9CE6AE: return 623;
-        case 0xFF72CC85: return 624;
-        case 0xFF4BAB60: return 625;
-        case 0xFF175E22: return 626;
-        case 0xFF04290A: return 627;
-        case 0xFFCFFFF0: return 628;
-        case 0xFFA8FFE8: return 629;
-        case 0xFF87FFE3: return 630;
-        case 0xFF52FADC: return 631;
-        case 0xFF13F2CE: return 632;
-        case 0xFF00BFAC: return 633;
-        case 0xFF00998B: return 634;
-        case 0xFFADFFEB: return 635;
-        case 0xFF8CFFE8: return 636;
-        case 0xFF73FFE8: return 637;
-        case 0xFF2BFFE6: return 638;
-        case 0xFF00F2E6: return 639;
-        case 0xFF00C7C7: return 640;
-        case 0xFF00ABB3: return 641;
-        case 0xFFD2F0FA: return 642;
-        case 0xFFB8E4F5: return 643;
-        case 0xFF8BCCF0: return 644;
-        case 0xFF64A7E8: return 645;
-        case 0xFF4696E3: return 646;
-        case 0xFF0056C4: return 647;
-        case 0xFF002D75: return 648;
-        case 0xFFD9EDFC: return 649;
-        case 0xFFBEE3FA: return 650;
-        case 0xFF95C5F0: return 651;
-        case 0xFF5C97E6: return 652;
-        case 0xFF004ECC: return 653;
-        case 0xFF00399E: return 654;
-        case 0xFF002B7A: return 655;
-        case 0xFFDBF5FF: return 656;
-        case 0xFFC2EBFF: return 657;
-        case 0xFF96CCFF: return 658;
-        case 0xFF5CA6FF: return 659;
-        case 0xFF1A6EFF: return 660;
-        case 0xFF0048E8: return 661;
-     /* case 0xFF003BD1: return 662;    TODO: duplicate case value */
-        case 0xFFEDF0FF: return 663;
-        case 0xFFE3E8FF: return 664;
-        case 0xFFC8CFFA: return 665;
-        case 0xFFA4A6ED: return 666;
-        case 0xFF6970DB: return 667;
-        case 0xFF3E40B3: return 668;
-        case 0xFF201E87: return 669;
-        case 0xFFFFDEFF: return 670;
-        case 0xFFFCCCFF: return 671;
-        case 0xFFF7A8FF: return 672;
-        case 0xFFF082FF: return 673;
-        case 0xFFE854FF: return 674;
-        case 0xFFCD00F7: return 675;
-        case 0xFFBB00C7: return 676;
-        case 0xFFFADEFF: return 677;
-        case 0xFFF7C9FF: return 678;
-        case 0xFFF2BAFF: return 679;
-        case 0xFFE18EFA: return 680;
-        case 0xFFC15FF5: return 681;
-        case 0xFFA82FE0: return 682;
-        case 0xFF810091: return 683;
-        case 0xFFFACFFA: return 684;
-        case 0xFFF7BAF7: return 685;
-        case 0xFFF2AAF2: return 686;
-        case 0xFFDC7EE0: return 687;
-        case 0xFFC459CF: return 688;
-        case 0xFF9D27A8: return 689;
-        case 0xFF690369: return 690;
-        case 0xFFFCD7E8: return 691;
-        case 0xFFFAC0E1: return 692;
-        case 0xFFF0A8D3: return 693;
-        case 0xFFE683BA: return 694;
-        case 0xFFBF508A: return 695;
-        case 0xFF991846: return 696;
-        case 0xFF7D0925: return 697;
-        case 0xFFFFD6EB: return 698;
-        case 0xFFFFC2E6: return 699;
-        case 0xFFFFA3DB: return 700;
-        case 0xFFFF78CC: return 701;
-        case 0xFFF24BA0: return 702;
-        case 0xFFD62463: return 703;
-        case 0xFFBA0025: return 704;
-        case 0xFFFFE8F2: return 705;
-        case 0xFFFFD4E6: return 706;
-        case 0xFFFFB3DB: return 707;
-        case 0xFFFF8AC7: return 708;
-        case 0xFFFF579E: return 709;
-        case 0xFFFF366B: return 710;
-        case 0xFFFA0032: return 711;
-        case 0xFFFFDBB0: return 712;
-        case 0xFFFFCF96: return 713;
-        case 0xFFFFB875: return 714;
-        case 0xFFFFA14A: return 715;
-        case 0xFFFF8717: return 716;
-        case 0xFFFA7000: return 717;
-        case 0xFFEB6300: return 718;
-        case 0xFFFFE6BF: return 719;
-        case 0xFFFCD7A7: return 720;
-        case 0xFFF7BC77: return 721;
-        case 0xFFE89538: return 722;
-        case 0xFFD4740B: return 723;
-        case 0xFFA14C00: return 724;
-        case 0xFF823B00: return 725;
-        case 0xFFFAE6C0: return 726;
-        case 0xFFF2CEA0: return 727;
-        case 0xFFE6B577: return 728;
-        case 0xFFD19052: return 729;
-        case 0xFFB56E2B: return 730;
-        case 0xFF753700: return 731;
-        case 0xFF5C2800: return 732;
-        case 0xFFFFF5D1: return 7401;
-        case 0xFFFFF0B3: return 7402;
-        case 0xFFFFE680: return 7403;
-     /* case 0xFFFFE833: return 7404;    TODO: duplicate case value */
-     /* case 0xFFFFE600: return 7405;    TODO: duplicate case value */
-        case 0xFFFFD100: return 7406;
-        case 0xFFE3B122: return 7407;
-        case 0xFFFFBF0D: return 7408;
-        case 0xFFFFB30D: return 7409;
-        case 0xFFFFB373: return 7410;
-        case 0xFFFFA64F: return 7411;
-        case 0xFFED8A00: return 7412;
-        case 0xFFF57300: return 7413;
-        case 0xFFE37B00: return 7414;
-        case 0xFFFFD1D9: return 7415;
-        case 0xFFFF6666: return 7416;
-        case 0xFFFF4040: return 7417;
-        case 0xFFF24961: return 7418;
-        case 0xFFD15473: return 7419;
-        case 0xFFCC2976: return 7420;
-        case 0xFF630046: return 7421;
-     /* case 0xFFFFE8F2: return 7422;    TODO: duplicate case value */
-     /* case 0xFFFF73C7: return 7423;    TODO: duplicate case value */
-        case 0xFFFF40B3: return 7424;
-        case 0xFFED18A6: return 7425;
-        case 0xFFD10073: return 7426;
-        case 0xFFB80040: return 7427;
-        case 0xFF73173F: return 7428;
-        case 0xFFFFD1F7: return 7429;
-        case 0xFFFAB0FF: return 7430;
-        case 0xFFF296ED: return 7431;
-        case 0xFFE667DF: return 7432;
-        case 0xFFD936B8: return 7433;
-        case 0xFFCC29AD: return 7434;
-        case 0xFFA60095: return 7435;
-        case 0xFFF7EBFF: return 7436;
-        case 0xFFF0CCFF: return 7437;
-        case 0xFFD9A6FF: return 7438;
-        case 0xFFCCA6FF: return 7439;
-        case 0xFFB399FF: return 7440;
-        case 0xFFA380FF: return 7441;
-        case 0xFF804DFF: return 7442;
-        case 0xFFF0F2FF: return 7443;
-        case 0xFFCCD4FF: return 7444;
-        case 0xFFADC6F7: return 7445;
-        case 0xFF919EFF: return 7446;
-        case 0xFF5357CF: return 7447;
-        case 0xFF4E4373: return 7448;
-        case 0xFF270020: return 7449;
-        case 0xFFCCE6FF: return 7450;
-        case 0xFF99C9FF: return 7451;
-        case 0xFF80ADFF: return 7452;
-        case 0xFF80BDFF: return 7453;
-        case 0xFF73AEE6: return 7454;
-        case 0xFF3378FF: return 7455;
-        case 0xFF6B9AED: return 7456;
-        case 0xFFE0FFFA: return 7457;
-        case 0xFF90F0E4: return 7458;
-        case 0xFF5FDED1: return 7459;
-        case 0xFF00F2F2: return 7460;
-        case 0xFF38B8FF: return 7461;
-        case 0xFF0073E6: return 7462;
-        case 0xFF003359: return 7463;
-        case 0xFFBFFFE6: return 7464;
-        case 0xFF80FFBF: return 7465;
-        case 0xFF4DFFC4: return 7466;
-        case 0xFF0DFFBF: return 7467;
-        case 0xFF00A5B8: return 7468;
-        case 0xFF007A99: return 7469;
-        case 0xFF1C778C: return 7470;
-        case 0xFFB8FFDB: return 7471;
-        case 0xFF7AFFBF: return 7472;
-        case 0xFF46EB91: return 7473;
-        case 0xFF14C78F: return 7474;
-        case 0xFF59B386: return 7475;
-        case 0xFF00663A: return 7476;
-        case 0xFF105249: return 7477;
-        case 0xFFD1FFDB: return 7478;
-        case 0xFF73FF80: return 7479;
-        case 0xFF66FF80: return 7480;
-        case 0xFF66FF73: return 7481;
-        case 0xFF33FF40: return 7482;
-        case 0xFF117300: return 7483;
-        case 0xFF008013: return 7484;
-        case 0xFFF0FFE6: return 7485;
-        case 0xFFCCFFB3: return 7486;
-        case 0xFFB3FF8C: return 7487;
-        case 0xFF91FF66: return 7488;
-        case 0xFF5FED2F: return 7489;
-        case 0xFF5BA621: return 7490;
-        case 0xFF689900: return 7491;
-        case 0xFFD1ED77: return 7492;
-        case 0xFFC5E693: return 7493;
-        case 0xFFA3D982: return 7494;
-        case 0xFF86B324: return 7495;
-        case 0xFF5F9E00: return 7496;
-        case 0xFF738639: return 7497;
-        case 0xFF263300: return 7498;
-        case 0xFFFFFAD9: return 7499;
-        case 0xFFF7F2D2: return 7500;
-        case 0xFFF0E6C0: return 7501;
-        case 0xFFE6D395: return 7502;
-        case 0xFFBFA87C: return 7503;
-        case 0xFF997354: return 7504;
-        case 0xFF735022: return 7505;
-        case 0xFFFFF2D9: return 7506;
-        case 0xFFFFE6B3: return 7507;
-        case 0xFFF5D093: return 7508;
-        case 0xFFF2C279: return 7509;
-        case 0xFFE39F40: return 7510;
-        case 0xFFBF6900: return 7511;
-        case 0xFFAB5C00: return 7512;
-        case 0xFFF7CBB2: return 7513;
-        case 0xFFF2B896: return 7514;
-        case 0xFFE09270: return 7515;
-        case 0xFFA65000: return 7516;
-        case 0xFF8F3900: return 7517;
-        case 0xFF663D2E: return 7518;
-        case 0xFF423500: return 7519;
-        case 0xFFFFD6CF: return 7520;
-        case 0xFFE6ACB8: return 7521;
-        case 0xFFD68196: return 7522;
-        case 0xFFCC7A85: return 7523;
-        case 0xFFBA544A: return 7524;
-        case 0xFFB36259: return 7525;
-        case 0xFFA63A00: return 7526;
-        case 0xFFEDE8DF: return 7527;
-        case 0xFFE6DFCF: return 7528;
-        case 0xFFD4CBBA: return 7529;
-        case 0xFFADA089: return 7530;
-        case 0xFF80735D: return 7531;
-        case 0xFF594A2D: return 7532;
-        case 0xFF261E06: return 7533;
-        case 0xFFE6E1D3: return 7534;
-        case 0xFFCCC6AD: return 7535;
-        case 0xFFADA687: return 7536;
-        case 0xFFC6CCB8: return 7537;
-        case 0xFFA2B39B: return 7538;
-        case 0xFFA0A395: return 7539;
-        case 0xFF474747: return 7540;
-        case 0xFFEDF2F2: return 7541;
-        case 0xFFC1D6D0: return 7542;
-        case 0xFFA6B3B3: return 7543;
-        case 0xFF8A9799: return 7544;
-        case 0xFF495C5E: return 7545;
-        case 0xFF304547: return 7546;
-        case 0xFF0A0F0F: return 7547;
-        /* BEGIN N/A COLORS */
-        /*
-        case 0xFF050403: return "Black";
-        case 0xFFFCE216: return "Yellow 2X";
-        case 0xFFF7B50C: return "116 2X";
-        case 0xFFE29100: return "130 2X";
-        case 0xFFEA4F00: return "165 2X";
-        case 0xFFE03A00: return "Warm Red 2X";
-        case 0xFFD62100: return "1788 2X";
-        case 0xFFD11600: return "185 2X";
-        case 0xFFCC0C00: return "485 2X";
-        case 0xFFC6003D: return "Rubine Red 2X";
-        case 0xFFD10572: return "Rhodamine Red 2X";
-        case 0xFFC4057C: return "239 2X";
-        case 0xFFAA0096: return "Purple 2X";
-        case 0xFF720082: return "2592 2X";
-        case 0xFF59008E: return "Violet 2X";
-        case 0xFF1C007A: return "Reflex Blue 2X";
-        case 0xFF0077BF: return "Process Blue 2X";
-        case 0xFF007FCC: return "299 2X";
-        case 0xFF00A3D1: return "306 2X";
-        case 0xFF007F82: return "320 2X";
-        case 0xFF008977: return "327 2X";
-        case 0xFF009677: return "Green 2X";
-        case 0xFF009944: return "354 2X";
-        case 0xFF009E0F: return "368 2X";
-        case 0xFF54BC00: return "375 2X";
-        case 0xFF9EC400: return "382 2X";
-        case 0xFFA34402: return "471 2X";
-        case 0xFF704214: return "464 2X";
-        case 0xFF0A0C11: return "433 2X";
-        case 0xFF3A3321: return "Black 2";
-        case 0xFF282D26: return "Black 3";
-        case 0xFF3D3023: return "Black 4";
-        case 0xFF422D2D: return "Black 5";
-        case 0xFF1C2630: return "Black 6";
-        case 0xFF443D38: return "Black 7";
-        case 0xFF111111: return "Black 2 2X";
-        case 0xFF111114: return "Black 3 2X";
-        case 0xFF0F0F0F: return "Black 4 2X";
-        case 0xFF110C0F: return "Black 5 2X";
-        case 0xFF070C0F: return "Black 6 2X";
-        case 0xFF33302B: return "Black 7 2X";
-        */
-        /* END N/A COLORS */
-    }
-
-    return -1;
+    const ThreadChart* chart = threadColor_chart(brand);
+    return chart ? chart->count : 0;
 }
 
-const char* getName_Pantone(unsigned int color)
+/*! Returns the color at \a index in the chart of \a brand, which is sorted by color, or null if \a index is out of range. */
+const ThreadColor* threadColor_getAt(ThreadBrand brand, int index)
 {
-    switch(color)
-    {
-        case 0xFFF7E214: return "Process Yellow";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFFFCE016: return "Pantone Yellow";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFFEF6B00: return "Orange 021";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFFF93F26: return "Warm Red";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFFEF2B2D: return "Red 032";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFFD10056: return "Rubine Red";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFFED0091: return "Rhodamine Red";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFFBF30B5: return "Purple";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFF6607A5: return "Violet";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFF380096: return "Blue 072";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFF0C1C8C: return "Reflex Blue";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFF0091C9: return "Process Blue";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFF00AF93: return "Green";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFF3D332B: return "Black";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFFE5DBCC: return "Warm Gray 1";
-        case 0xFFDDD1C1: return "Warm Gray 2";
-        case 0xFFCCC1B2: return "Warm Gray 3";
-        case 0xFFC1B5A5: return "Warm Gray 4";
-        case 0xFFB5A899: return "Warm Gray 5";
-        case 0xFFAFA393: return "Warm Gray 6";
-        case 0xFFA39687: return "Warm Gray 7";
-        case 0xFF96897A: return "Warm Gray 8";
-        case 0xFF8C7F70: return "Warm Gray 9";
-        case 0xFF827263: return "Warm Gray 10";
-        case 0xFF6D5E51: return "Warm Gray 11";
-        case 0xFFE8E2D6: return "Cool Gray 1";
-        case 0xFFDDD8CE: return "Cool Gray 2";
-        case 0xFFD3CEC4: return "Cool Gray 3";
-        case 0xFFC4C1BA: return "Cool Gray 4";
-        case 0xFFBAB7AF: return "Cool Gray 5";
-        case 0xFFB5B2AA: return "Cool Gray 6";
-        case 0xFFA5A39E: return "Cool Gray 7";
-        case 0xFF9B9993: return "Cool Gray 8";
-        case 0xFF8C8984: return "Cool Gray 9";
-        case 0xFF777772: return "Cool Gray 10";
-
-        /* SNIP 8<-------------------- */
-
-        case 0xFF050403: return "Black";
-        case 0xFFFCE216: return "Yellow 2X";
-        case 0xFFF7B50C: return "116 2X";
-        case 0xFFE29100: return "130 2X";
-        case 0xFFEA4F00: return "165 2X";
-        case 0xFFE03A00: return "Warm Red 2X";
-        case 0xFFD62100: return "1788 2X";
-        case 0xFFD11600: return "185 2X";
-        case 0xFFCC0C00: return "485 2X";
-        case 0xFFC6003D: return "Rubine Red 2X";
-        case 0xFFD10572: return "Rhodamine Red 2X";
-        case 0xFFC4057C: return "239 2X";
-        case 0xFFAA0096: return "Purple 2X";
-        case 0xFF720082: return "2592 2X";
-        case 0xFF59008E: return "Violet 2X";
-        case 0xFF1C007A: return "Reflex Blue 2X";
-        case 0xFF0077BF: return "Process Blue 2X";
-        case 0xFF007FCC: return "299 2X";
-        case 0xFF00A3D1: return "306 2X";
-        case 0xFF007F82: return "320 2X";
-        case 0xFF008977: return "327 2X";
-        case 0xFF009677: return "Green 2X";
-        case 0xFF009944: return "354 2X";
-        case 0xFF009E0F: return "368 2X";
-        case 0xFF54BC00: return "375 2X";
-        case 0xFF9EC400: return "382 2X";
-        case 0xFFA34402: return "471 2X";
-        case 0xFF704214: return "464 2X";
-        case 0xFF0A0C11: return "433 2X";
-        case 0xFF3A3321: return "Black 2";
-        case 0xFF282D26: return "Black 3";
-        case 0xFF3D3023: return "Black 4";
-        case 0xFF422D2D: return "Black 5";
-        case 0xFF1C2630: return "Black 6";
-        case 0xFF443D38: return "Black 7";
-        case 0xFF111111: return "Black 2 2X";
-        case 0xFF111114: return "Black 3 2X";
-        case 0xFF0F0F0F: return "Black 4 2X";
-        case 0xFF110C0F: return "Black 5 2X";
-        case 0xFF070C0F: return "Black 6 2X";
-        case 0xFF33302B: return "Black 7 2X";
-    }
-
-    return "";
+    const ThreadChart* chart = threadColor_chart(brand);
+    if(!chart || index < 0 || index >= chart->count)
+        return 0;
+    return &chart->colors[index];
 }
 
-int getNum_RobisonAnton_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_RobisonAnton_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_RobisonAnton_Rayon(unsigned int color)
+/*! Returns the entry of \a brand for exactly \a color, or null if the chart does not have it. */
+const ThreadColor* threadColor_find(unsigned int color, ThreadBrand brand)
 {
-    switch(color)
-    {
-        case 0xFFEFCCCE: return 2243;
-        case 0xFFFCBFC9: return 2223;
-        case 0xFFEFC6D3: return 2599;
-        case 0xFFF9B2B7: return 2373;
-        case 0xFFF9AFAD: return 2374;
-        case 0xFFFC9BB2: return 2293;
-        case 0xFFFC8C99: return 2244;
-        case 0xFFF2AFC1: return 2237;
-        case 0xFFE5566D: return 2246;
-        case 0xFFF4476B: return 2248;
-     /* case 0xFFE5566D: return 2228;    TODO: duplicate case value */
-        case 0xFFF9848E: return 2412;
-        case 0xFFF26877: return 2375;
-        case 0xFFD8899B: return 2591;
-        case 0xFF8C2633: return 2249;
-        case 0xFF7C2128: return 2608;
-        case 0xFF7A2638: return 2252;
-        case 0xFF75263D: return 2622;
-        case 0xFF772D35: return 2225;
-        case 0xFF593344: return 2587;
-        case 0xFF4F213A: return 2376;
-        case 0xFF931638: return 2494;
-     /* case 0xFFF9B2B7: return 2495;    TODO: duplicate case value */
-        case 0xFF661E2B: return 2496;
-     /* case 0xFFE5566D: return 2491;    TODO: duplicate case value */
-        case 0xFF8E2344: return 2497;
-        case 0xFF6D213F: return 2498;
-     /* case 0xFF8E2344: return 2499;    TODO: duplicate case value */
-        case 0xFFAD0075: return 2500;
-        case 0xFFFCC9C6: return 2501;
-        case 0xFFF4BFD1: return 2502;
-        case 0xFFF7BFBF: return 2503;
-        case 0xFFCE007C: return 2259;
-        case 0xFFED72AA: return 2415;
-        case 0xFFD36B9E: return 2260;
-        case 0xFFD60270: return 2416;
-        case 0xFFE22882: return 2261;
-        case 0xFFAA004F: return 2504;
-     /* case 0xFFAA004F: return 2417;    TODO: duplicate case value */
-        case 0xFFEA0F6B: return 2262;
-        case 0xFFAF1E2D: return 2418;
-        case 0xFFBF0A30: return 2281;
-     /* case 0xFFBF0A30: return 2419;    TODO: duplicate case value */
-     /* case 0xFFBF0A30: return 2378;    TODO: duplicate case value */
-        case 0xFFCE1126: return 2263;
-        case 0xFFD62828: return 2420;
-     /* case 0xFFBF0A30: return 2233;    TODO: duplicate case value */
-        case 0xFFC41E3A: return 2219;
-     /* case 0xFFC41E3A: return 2266;    TODO: duplicate case value */
-        case 0xFFA32638: return 2267;
-     /* case 0xFF8C2633: return 2268;    TODO: duplicate case value */
-     /* case 0xFF75263D: return 2421;    TODO: duplicate case value */
-        case 0xFF992135: return 2270;
-     /* case 0xFFA32638: return 2505;    TODO: duplicate case value */
-     /* case 0xFFC41E3A: return 2506;    TODO: duplicate case value */
-        case 0xFFAF003D: return 2507;
-        case 0xFFD81C3F: return 2508;
-        case 0xFFFC5E72: return 2509;
-        case 0xFFF2C4AF: return 2377;
-        case 0xFFF4CCAA: return 2413;
-        case 0xFFF9BAAA: return 2253;
-     /* case 0xFFF7BFBF: return 2255;    TODO: duplicate case value */
-        case 0xFFF9BF9E: return 2256;
-        case 0xFFF9C6AA: return 2257;
-        case 0xFFF98E6D: return 2294;
-        case 0xFFF9A58C: return 2258;
-        case 0xFFF98972: return 2414;
-        case 0xFFF43F4F: return 2277;
-     /* case 0xFFF9C6AA: return 2510;    TODO: duplicate case value */
-     /* case 0xFFF9BAAA: return 2511;    TODO: duplicate case value */
-     /* case 0xFFF98972: return 2512;    TODO: duplicate case value */
-        case 0xFFE23D28: return 2513;
-        case 0xFF008C82: return 2514;
-        case 0xFF00B2A0: return 2515;
-        case 0xFF47D6C1: return 2516;
-        case 0xFF87DDD1: return 2517;
-        case 0xFF008789: return 2492;
-        case 0xFF2DC6D6: return 2518;
-        case 0xFF00A5DB: return 2519;
-        case 0xFF00A3DD: return 2520;
-        case 0xFF003F54: return 2589;
-        case 0xFF002D47: return 2620;
-        case 0xFF006D75: return 2521;
-        case 0xFF9BC4E2: return 2239;
-        case 0xFFAFBCDB: return 2304;
-        case 0xFF5B77CC: return 2614;
-        case 0xFF6D87A8: return 2275;
-        case 0xFF99D6DD: return 2305;
-        case 0xFF28C4D8: return 2306;
-        case 0xFF00ADC6: return 2307;
-        case 0xFF00A0C4: return 2389;
-        case 0xFF008ED6: return 2441;
-        case 0xFF0054A0: return 2442;
-     /* case 0xFF008ED6: return 2388;    TODO: duplicate case value */
-     /* case 0xFF00A3DD: return 2730;    TODO: duplicate case value */
-        case 0xFF00709E: return 2737;
-        case 0xFF007AA5: return 2740;
-        case 0xFFC9E8DD: return 2222;
-        case 0xFF1E1C77: return 2210;
-        case 0xFF002B7F: return 2438;
-        case 0xFF335687: return 2302;
-     /* case 0xFFAFBCDB: return 2522;    TODO: duplicate case value */
-     /* case 0xFF335687: return 2523;    TODO: duplicate case value */
-        case 0xFF26547C: return 2612;
-        case 0xFF7796B2: return 2524;
-        case 0xFFC1C9DD: return 2525;
-     /* case 0xFF7796B2: return 2624;    TODO: duplicate case value */
-        case 0xFF6689CC: return 2526;
-        case 0xFF5960A8: return 2527;
-        case 0xFF0051BA: return 2619;
-     /* case 0xFF6689CC: return 2528;    TODO: duplicate case value */
-        case 0xFF3A75C4: return 2529;
-        case 0xFF75AADB: return 2530;
-        case 0xFFC4D8E2: return 2531;
-     /* case 0xFFC4D8E2: return 2532;    TODO: duplicate case value */
-        case 0xFF60AFDD: return 2533;
-        case 0xFF003D6B: return 2534;
-        case 0xFF0F2B5B: return 2439;
-        case 0xFF192168: return 2625;
-        case 0xFF2B265B: return 2440;
-        case 0xFF002654: return 2613;
-        case 0xFF002649: return 2647;
-        case 0xFF353F5B: return 2386;
-        case 0xFF35264F: return 2450;
-        case 0xFF112151: return 2303;
-        case 0xFF14213D: return 2603;
-     /* case 0xFF002654: return 2609;    TODO: duplicate case value */
-     /* case 0xFF14213D: return 2215;    TODO: duplicate case value */
-     /* case 0xFF14213D: return 2387;    TODO: duplicate case value */
-        case 0xFFC6D1D6: return 2382;
-     /* case 0xFFC1C9DD: return 2598;    TODO: duplicate case value */
-        case 0xFFB5D1E8: return 2300;
-        case 0xFFD1CEDD: return 2283;
-        case 0xFF99BADD: return 2206;
-     /* case 0xFFAFBCDB: return 2269;    TODO: duplicate case value */
-        case 0xFFA5BAE0: return 2383;
-        case 0xFF75B2DD: return 2433;
-     /* case 0xFF75AADB: return 2434;    TODO: duplicate case value */
-     /* case 0xFF6689CC: return 2435;    TODO: duplicate case value */
-        case 0xFF7F8CBF: return 2301;
-     /* case 0xFF6D87A8: return 2245;    TODO: duplicate case value */
-     /* case 0xFF5B77CC: return 2384;    TODO: duplicate case value */
-        case 0xFF2D338E: return 2220;
-     /* case 0xFF2D338E: return 2280;    TODO: duplicate case value */
-        case 0xFF00337F: return 2627;
-        case 0xFF003893: return 2436;
-     /* case 0xFF2D338E: return 2385;    TODO: duplicate case value */
-        case 0xFF3F2893: return 2437;
-        case 0xFF3A564F: return 2535;
-        case 0xFF8499A5: return 2617;
-        case 0xFF9BAABF: return 2536;
-        case 0xFF5E99AA: return 2577;
-        case 0xFFADAFAA: return 2540;
-        case 0xFFBFBAAF: return 2537;
-        case 0xFFBAB7AF: return 2741;
-        case 0xFFC4C1BA: return 2733;
-        case 0xFFCCC1B2: return 2538;
-        case 0xFFD1CCBF: return 2539;
-     /* case 0xFFADAFAA: return 2618;    TODO: duplicate case value */
-        case 0xFF8C8984: return 2731;
-        case 0xFF686663: return 2729;
-        case 0xFF443D38: return 2541;
-        case 0xFFDDC6C4: return 2271;
-        case 0xFFD3B7A3: return 2272;
-        case 0xFFB5939B: return 2314;
-        case 0xFF8E6877: return 2422;
-     /* case 0xFFFCBFC9: return 2423;    TODO: duplicate case value */
-        case 0xFFE5BFC6: return 2379;
-     /* case 0xFFEFC6D3: return 2276;    TODO: duplicate case value */
-        case 0xFFEDC4DD: return 2285;
-        case 0xFFB58CB2: return 2424;
-        case 0xFFC9ADD8: return 2286;
-        case 0xFFE29ED6: return 2588;
-        case 0xFF512654: return 2600;
-        case 0xFF512D44: return 2616;
-        case 0xFF8E47AD: return 2425;
-        case 0xFFAF72C1: return 2288;
-        case 0xFF9B4F96: return 2426;
-        case 0xFF66116D: return 2380;
-        case 0xFF63305E: return 2490;
-     /* case 0xFF1E1C77: return 2429;    TODO: duplicate case value */
-        case 0xFF332875: return 2427;
-        case 0xFF35006D: return 2428;
-        case 0xFF2B1166: return 2736;
-        case 0xFF38197A: return 2742;
-     /* case 0xFF35006D: return 2628;    TODO: duplicate case value */
-     /* case 0xFF8E47AD: return 2254;    TODO: duplicate case value */
-        case 0xFF5B027A: return 2430;
-        case 0xFF4C145E: return 2381;
-        case 0xFF8977BA: return 2287;
-        case 0xFF44235E: return 2431;
-        case 0xFFAA0066: return 2590;
-     /* case 0xFFCE007C: return 2291;    TODO: duplicate case value */
-     /* case 0xFFAA004F: return 2432;    TODO: duplicate case value */
-        case 0xFF9E2387: return 2292;
-     /* case 0xFF5E99AA: return 2308;    TODO: duplicate case value */
-        case 0xFF609191: return 2443;
-     /* case 0xFF609191: return 2309;    TODO: duplicate case value */
-     /* case 0xFF003F54: return 2444;    TODO: duplicate case value */
-        case 0xFF93DDDB: return 2310;
-        case 0xFF7FD6DB: return 2204;
-        case 0xFF007272: return 2445;
-        case 0xFF70CE9B: return 2311;
-     /* case 0xFF70CE9B: return 2312;    TODO: duplicate case value */
-        case 0xFF35C4AF: return 2390;
-     /* case 0xFF006D75: return 2446;    TODO: duplicate case value */
-        case 0xFF006B77: return 2621;
-        case 0xFF006663: return 2447;
-        case 0xFF006D66: return 2735;
-     /* case 0xFF008C82: return 2391;    TODO: duplicate case value */
-        case 0xFF008272: return 2448;
-     /* case 0xFF006663: return 2449;    TODO: duplicate case value */
-     /* case 0xFF006D66: return 2615;    TODO: duplicate case value */
-        case 0xFFBCC1B2: return 2241;
-        case 0xFFC6D6A0: return 2282;
-        case 0xFF9EAA99: return 2221;
-        case 0xFFB2D8D8: return 2313;
-        case 0xFF7AA891: return 2278;
-     /* case 0xFF7AA891: return 2594;    TODO: duplicate case value */
-        case 0xFF006056: return 2451;
-     /* case 0xFF006056: return 2743;    TODO: duplicate case value */
-        case 0xFF4F6D5E: return 2392;
-        case 0xFF024930: return 2315;
-        case 0xFF004438: return 2734;
-        case 0xFF2B4C3F: return 2631;
-        case 0xFF282D26: return 2411;
-        case 0xFFF2EABC: return 2316;
-        case 0xFFCCC693: return 2250;
-        case 0xFF5E663A: return 2317;
-        case 0xFF779182: return 2202;
-     /* case 0xFFC9E8DD: return 2318;    TODO: duplicate case value */
-     /* case 0xFF93DDDB: return 2452;    TODO: duplicate case value */
-     /* case 0xFF93DDDB: return 2393;    TODO: duplicate case value */
-        case 0xFFB5E8BF: return 2238;
-        case 0xFFAADD6D: return 2279;
-        case 0xFFA0DB8E: return 2211;
-        case 0xFFB5CC8E: return 2319;
-        case 0xFF8CD600: return 2320;
-        case 0xFF56AA1C: return 2738;
-        case 0xFF339E35: return 2214;
-        case 0xFF007A3D: return 2453;
-     /* case 0xFF007A3D: return 2410;    TODO: duplicate case value */
-     /* case 0xFF007A3D: return 2240;    TODO: duplicate case value */
-        case 0xFF008751: return 2208;
-        case 0xFF006B3F: return 2454;
-        case 0xFF006854: return 2607;
-        case 0xFF1EB53A: return 2578;
-        case 0xFF009E49: return 2579;
-     /* case 0xFF009E49: return 2580;    TODO: duplicate case value */
-     /* case 0xFF006B3F: return 2284;    TODO: duplicate case value */
-        case 0xFF006B54: return 2455;
-        case 0xFF007C66: return 2597;
-        case 0xFFA3AF07: return 2456;
-        case 0xFF7FBA00: return 2321;
-     /* case 0xFF7FBA00: return 2457;    TODO: duplicate case value */
-     /* case 0xFF7FBA00: return 2322;    TODO: duplicate case value */
-        case 0xFF568E14: return 2226;
-        case 0xFF939905: return 2230;
-        case 0xFF566314: return 2229;
-     /* case 0xFF024930: return 2458;    TODO: duplicate case value */
-        case 0xFF547730: return 2595;
-        case 0xFF3F4926: return 2601;
-        case 0xFF3A7728: return 2209;
-        case 0xFF193833: return 2459;
-        case 0xFF215B33: return 2323;
-        case 0xFF265142: return 2460;
-     /* case 0xFF3F4926: return 2584;    TODO: duplicate case value */
-        case 0xFF99840A: return 2542;
-        case 0xFFA38205: return 2543;
-        case 0xFF897719: return 2544;
-        case 0xFF707014: return 2545;
-        case 0xFF848205: return 2546;
-        case 0xFFE2E584: return 2547;
-        case 0xFF998E07: return 2548;
-        case 0xFF00494F: return 2549;
-     /* case 0xFF4F6D5E: return 2550;    TODO: duplicate case value */
-     /* case 0xFF779182: return 2551;    TODO: duplicate case value */
-        case 0xFF546856: return 2554;
-        case 0xFF0C3026: return 2552;
-        case 0xFF233A2D: return 2553;
-        case 0xFF213D30: return 2728;
-        case 0xFFC9D6A3: return 2555;
-        case 0xFFE0AA0F: return 2556;
-        case 0xFFF4E287: return 2557;
-        case 0xFFFFC61E: return 2558;
-        case 0xFFF7E8AA: return 2559;
-        case 0xFFF9DD16: return 2560;
-        case 0xFFC6A00C: return 2561;
-        case 0xFFA37F14: return 2562;
-     /* case 0xFFF7E8AA: return 2324;    TODO: duplicate case value */
-     /* case 0xFFF7E8AA: return 2264;    TODO: duplicate case value */
-        case 0xFFEADD96: return 2461;
-        case 0xFFF9E08C: return 2732;
-        case 0xFFFFD87F: return 2234;
-        case 0xFFFCD856: return 2408;
-        case 0xFFFCA311: return 2394;
-     /* case 0xFFFCA311: return 2409;    TODO: duplicate case value */
-     /* case 0xFFFCA311: return 2213;    TODO: duplicate case value */
-     /* case 0xFFF9DD16: return 2462;    TODO: duplicate case value */
-        case 0xFFF4ED47: return 2325;
-        case 0xFFF9E814: return 2326;
-        case 0xFFFCB514: return 2463;
-        case 0xFFFFCC49: return 2395;
-     /* case 0xFFFFC61E: return 2464;    TODO: duplicate case value */
-        case 0xFFFCBF49: return 2465;
-        case 0xFFFCE016: return 2235;
-     /* case 0xFFFFC61E: return 2626;    TODO: duplicate case value */
-        case 0xFFFCD116: return 2466;
-     /* case 0xFFFCD116: return 2242;    TODO: duplicate case value */
-     /* case 0xFFFFCC49: return 2396;    TODO: duplicate case value */
-        case 0xFFF99B0C: return 2327;
-        case 0xFFF77F00: return 2328;
-        case 0xFFF74902: return 2467;
-     /* case 0xFFF74902: return 2397;    TODO: duplicate case value */
-        case 0xFFF95602: return 2236;
-        case 0xFFF93F26: return 2329;
-     /* case 0xFFF95602: return 2468;    TODO: duplicate case value */
-        case 0xFFF96B07: return 2218;
-        case 0xFFF96302: return 2469;
-        case 0xFFA53F0F: return 2581;
-        case 0xFFFC8744: return 2330;
-        case 0xFFBC4F07: return 2289;
-        case 0xFFAF7505: return 2295;
-        case 0xFFC18E60: return 2493;
-        case 0xFFFCCE87: return 2398;
-     /* case 0xFFFFCC49: return 2605;    TODO: duplicate case value */
-        case 0xFFFCBA5E: return 2247;
-     /* case 0xFFFFCC49: return 2216;    TODO: duplicate case value */
-     /* case 0xFFE0AA0F: return 2331;    TODO: duplicate case value */
-     /* case 0xFFE0AA0F: return 2212;    TODO: duplicate case value */
-     /* case 0xFFE0AA0F: return 2470;    TODO: duplicate case value */
-        case 0xFFF2BF49: return 2332;
-     /* case 0xFFFCCE87: return 2399;    TODO: duplicate case value */
-        case 0xFFE2D6B5: return 2630;
-     /* case 0xFFC6A00C: return 2596;    TODO: duplicate case value */
-     /* case 0xFFA37F14: return 2333;    TODO: duplicate case value */
-     /* case 0xFFC6A00C: return 2471;    TODO: duplicate case value */
-        case 0xFFBF910C: return 2201;
-        case 0xFFEAB2B2: return 2299;
-        case 0xFFC13828: return 2205;
-        case 0xFFA03033: return 2334;
-     /* case 0xFFAF1E2D: return 2623;    TODO: duplicate case value */
-     /* case 0xFFAF1E2D: return 2472;    TODO: duplicate case value */
-        case 0xFFFAE6CC: return 2582;
-        case 0xFFFAE6CF: return 2335;
-        case 0xFFF7D3B5: return 2473;
-        case 0xFFEDD3BC: return 2232;
-        case 0xFFAA753F: return 2489;
-        case 0xFFD3A87C: return 2273;
-        case 0xFFEDD3B5: return 2593;
-        case 0xFFC1A875: return 2474;
-        case 0xFFE2BF9B: return 2203;
-     /* case 0xFFD3A87C: return 2475;    TODO: duplicate case value */
-     /* case 0xFFBF910C: return 2400;    TODO: duplicate case value */
-        case 0xFFD18E54: return 2401;
-        case 0xFFD8B596: return 2336;
-        case 0xFFD6CCAF: return 2476;
-        case 0xFFF2E3C4: return 2604;
-     /* case 0xFFAA753F: return 2224;    TODO: duplicate case value */
-        case 0xFF6B4714: return 2477;
-        case 0xFFD1BF91: return 2298;
-        case 0xFF6C463D: return 2610;
-        case 0xFF876028: return 2227;
-        case 0xFF755426: return 2629;
-     /* case 0xFF755426: return 2478;    TODO: duplicate case value */
-        case 0xFFB28260: return 2488;
-        case 0xFF593D2B: return 2251;
-     /* case 0xFF593D2B: return 2372;    TODO: duplicate case value */
-        case 0xFF3F302B: return 2337;
-     /* case 0xFFC18E60: return 2338;    TODO: duplicate case value */
-     /* case 0xFFAF7505: return 2479;    TODO: duplicate case value */
-        case 0xFFBA7530: return 2231;
-     /* case 0xFF755426: return 2402;    TODO: duplicate case value */
-        case 0xFFB26B70: return 2480;
-        case 0xFFA2464E: return 2611;
-        case 0xFF9B4F19: return 2290;
-     /* case 0xFF9B4F19: return 2481;    TODO: duplicate case value */
-        case 0xFF5B2D28: return 2339;
-     /* case 0xFF593D2B: return 2563;    TODO: duplicate case value */
-     /* case 0xFF3F302B: return 2564;    TODO: duplicate case value */
-        case 0xFF3D3028: return 2566;
-        case 0xFF633A11: return 2567;
-     /* case 0xFFC1A875: return 2568;    TODO: duplicate case value */
-        case 0xFF7A5B11: return 2569;
-     /* case 0xFFC1A875: return 2570;    TODO: duplicate case value */
-     /* case 0xFFF2BF49: return 2586;    TODO: duplicate case value */
-        case 0xFFF2CE68: return 2606;
-        case 0xFFD88C02: return 2602;
-        case 0xFFC1B5A5: return 2571;
-        case 0xFF99897C: return 2739;
-        case 0xFFADA07A: return 2572;
-     /* case 0xFFADA07A: return 2573;    TODO: duplicate case value */
-        case 0xFFF5E3CC: return 2574;
-        case 0xFF66594C: return 2575;
-        case 0xFF493533: return 2576;
-        case 0xFFF5EBE0: return 2403;
-     /* case 0xFFDDC6C4: return 2207;    TODO: duplicate case value */
-        case 0xFFDBD3D3: return 2340;
-        case 0xFFD8CCD1: return 2274;
-        case 0xFFCCC1C6: return 2482;
-        case 0xFFAFAAA3: return 2483;
-     /* case 0xFFADAFAA: return 2592;    TODO: duplicate case value */
-        case 0xFF919693: return 2585;
-     /* case 0xFF8C8984: return 2484;    TODO: duplicate case value */
-     /* case 0xFFCCC1C6: return 2404;    TODO: duplicate case value */
-     /* case 0xFFDBD3D3: return 2485;    TODO: duplicate case value */
-     /* case 0xFFCCC1C6: return 2405;    TODO: duplicate case value */
-        case 0xFFB2A8B5: return 2486;
-        case 0xFFA893AD: return 2406;
-        case 0xFF666D70: return 2407;
-     /* case 0xFF686663: return 2217;    TODO: duplicate case value */
-     /* case 0xFF443D38: return 2565;    TODO: duplicate case value */
-        case 0xFF777772: return 2265;
-        case 0xFF353842: return 2487;
-        case 0xFF3A4972: return 2341;
-        case 0xFF1C2630: return 2296;
-     /* case 0xFFF5EBE0: return 2297;    TODO: duplicate case value */
-        case 0xFFF5EDDE: return 2342;
-        case 0xFFF0E8D6: return 2343;
-     /* case 0xFF1C2630: return 2632;    TODO: duplicate case value */
-
-        /* BEGIN N/A COLORS */
-        /*
-                         return 2344;
-                         return 2345;
-                         return 2346;
-                         return 2347;
-                         return 2348;
-                         return 2349;
-                         return 2350;
-                         return 2351;
-                         return 2352;
-                         return 2353;
-                         return 2354;
-                         return 2355;
-                         return 2583;
-                         return 2356;
-                         return 2357;
-                         return 2358;
-                         return 2359;
-                         return 2360;
-                         return 2361;
-                         return 2362;
-                         return 2363;
-                         return 2364;
-                         return 2365;
-                         return 2366;
-                         return 2367;
-                         return 2368;
-                         return 2369;
-                         return 2370;
-                         return 2371;
-        */
-        /* END N/A COLORS */
-    }
+    const ThreadChart* chart = threadColor_chart(brand);
+    int low = 0, high = 0;
 
-    return -1;
-}
+    if(!chart) return 0;
 
-const char* getName_RobisonAnton_Rayon(unsigned int color)
-{
-    switch(color)
+    /* Find the first entry not below color, which is the first of its catalog numbers */
+    high = chart->count;
+    while(low < high)
     {
-        case 0xFFEFCCCE: return "Light Pink";
-        case 0xFFFCBFC9: return "Pink";
-        case 0xFFEFC6D3: return "Pink Bazaar";
-        case 0xFFF9B2B7: return "Pink Mist";
-        case 0xFFF9AFAD: return "Emily Pink";
-        case 0xFFFC9BB2: return "Rose";
-        case 0xFFFC8C99: return "Rose Cerise";
-        case 0xFFF2AFC1: return "Carnation";
-        case 0xFFE5566D: return "Shrimp";
-        case 0xFFF4476B: return "Bashful Pink";
-     /* case 0xFFE5566D: return "Begonia";    TODO: duplicate case value */
-        case 0xFFF9848E: return "Azalea";
-        case 0xFFF26877: return "Dusty Rose";
-        case 0xFFD8899B: return "Rose Tint";
-        case 0xFF8C2633: return "Burgundy";
-        case 0xFF7C2128: return "TH Burgundy";
-        case 0xFF7A2638: return "Russet";
-        case 0xFF75263D: return "Pro Firebrand";
-        case 0xFF772D35: return "Wine";
-        case 0xFF593344: return "Intense Maroon";
-        case 0xFF4F213A: return "Dark Maroon";
-        case 0xFF931638: return "Carbernet";
-     /* case 0xFFF9B2B7: return "Mountain Rose";    TODO: duplicate case value */
-        case 0xFF661E2B: return "Warm Wine";
-     /* case 0xFFE5566D: return "Primrose";    TODO: duplicate case value */
-        case 0xFF8E2344: return "Perfect Ruby";
-        case 0xFF6D213F: return "Brushed Burgundy";
-     /* case 0xFF8E2344: return "Passion Rose";    TODO: duplicate case value */
-        case 0xFFAD0075: return "New Berry";
-        case 0xFFFCC9C6: return "Petal Pink";
-        case 0xFFF4BFD1: return "Memphis Belle";
-        case 0xFFF7BFBF: return "Desert Bloom";
-        case 0xFFCE007C: return "Wild Pink";
-        case 0xFFED72AA: return "Floral Pink";
-        case 0xFFD36B9E: return "Hot Pink";
-        case 0xFFD60270: return "Crimson";
-        case 0xFFE22882: return "Ruby Glint";
-        case 0xFFAA004F: return "Cherrystone";
-     /* case 0xFFAA004F: return "Cherry Punch";    TODO: duplicate case value */
-        case 0xFFEA0F6B: return "Cherry Blossom";
-        case 0xFFAF1E2D: return "Red Berry";
-        case 0xFFBF0A30: return "Jockey Red";
-     /* case 0xFFBF0A30: return "Very Red";    TODO: duplicate case value */
-     /* case 0xFFBF0A30: return "Red Berry";    TODO: duplicate case value */
-        case 0xFFCE1126: return "Foxy Red";
-        case 0xFFD62828: return "Tuxedo Red";
-     /* case 0xFFBF0A30: return "Lipstick";    TODO: duplicate case value */
-        case 0xFFC41E3A: return "Scarlet";
-     /* case 0xFFC41E3A: return "Radiant Red";    TODO: duplicate case value */
-        case 0xFFA32638: return "Wildfire";
-     /* case 0xFF8C2633: return "Carolina Red";    TODO: duplicate case value */
-     /* case 0xFF75263D: return "Red Jubilee";    TODO: duplicate case value */
-        case 0xFF992135: return "Cranberry";
-     /* case 0xFFA32638: return "Antique Red";    TODO: duplicate case value */
-     /* case 0xFFC41E3A: return "Devil Red";    TODO: duplicate case value */
-        case 0xFFAF003D: return "Candy Apple Red";
-        case 0xFFD81C3F: return "Rosewood";
-        case 0xFFFC5E72: return "Bitteroot";
-        case 0xFFF2C4AF: return "Bisque";
-        case 0xFFF4CCAA: return "Flesh";
-        case 0xFFF9BAAA: return "Flesh Pink";
-     /* case 0xFFF7BFBF: return "Opal Mist";    TODO: duplicate case value */
-        case 0xFFF9BF9E: return "Tawny";
-        case 0xFFF9C6AA: return "Peach";
-        case 0xFFF98E6D: return "Melon";
-        case 0xFFF9A58C: return "Flamingo";
-        case 0xFFF98972: return "Coral";
-        case 0xFFF43F4F: return "Persimmon";
-     /* case 0xFFF9C6AA: return "Peach Blossom";    TODO: duplicate case value */
-     /* case 0xFFF9BAAA: return "Illusion";    TODO: duplicate case value */
-     /* case 0xFFF98972: return "Melonade";    TODO: duplicate case value */
-        case 0xFFE23D28: return "Honeysuckle";
-        case 0xFF008C82: return "Brite Jade";
-        case 0xFF00B2A0: return "Bluestone";
-        case 0xFF47D6C1: return "Aqua Pearl";
-        case 0xFF87DDD1: return "Seafrost";
-        case 0xFF008789: return "J. Turquoise";
-        case 0xFF2DC6D6: return "Indian Ocean Blue";
-        case 0xFF00A5DB: return "Surf Blue";
-        case 0xFF00A3DD: return "Mid Windsor";
-        case 0xFF003F54: return "Deep Windsor";
-        case 0xFF002D47: return "Pro Dark Blue";
-        case 0xFF006D75: return "Mallard Blue";
-        case 0xFF9BC4E2: return "Sky Blue";
-        case 0xFFAFBCDB: return "Lake Blue";
-        case 0xFF5B77CC: return "Pro Lusty Blue";
-        case 0xFF6D87A8: return "Slate Blue";
-        case 0xFF99D6DD: return "Blue Frost";
-        case 0xFF28C4D8: return "Periwinkle";
-        case 0xFF00ADC6: return "Aquamarine";
-        case 0xFF00A0C4: return "California Blue";
-        case 0xFF008ED6: return "Baltic Blue";
-        case 0xFF0054A0: return "Solar Blue";
-     /* case 0xFF008ED6: return "Pacific Blue";    TODO: duplicate case value */
-     /* case 0xFF00A3DD: return "Boo Boo Blue";    TODO: duplicate case value */
-        case 0xFF00709E: return "Pro Band Blue";
-        case 0xFF007AA5: return "Pro Peacock";
-        case 0xFFC9E8DD: return "Light Blue";
-        case 0xFF1E1C77: return "Royal";
-        case 0xFF002B7F: return "Blue Suede";
-        case 0xFF335687: return "Imperial Blue";
-     /* case 0xFFAFBCDB: return "Bridgeport Blue";    TODO: duplicate case value */
-     /* case 0xFF335687: return "China Blue";    TODO: duplicate case value */
-        case 0xFF26547C: return "Pro Imperial";
-        case 0xFF7796B2: return "Country Blue";
-        case 0xFFC1C9DD: return "Heron Blue";
-     /* case 0xFF7796B2: return "Pro Saxon";    TODO: duplicate case value */
-        case 0xFF6689CC: return "Bright Blue";
-        case 0xFF5960A8: return "Soldier Blue";
-        case 0xFF0051BA: return "Pro Brilliance";
-     /* case 0xFF6689CC: return "Atlantis Blue";    TODO: duplicate case value */
-        case 0xFF3A75C4: return "Dolphin Blue";
-        case 0xFF75AADB: return "Caribbean Blue";
-        case 0xFFC4D8E2: return "Dana Blue";
-     /* case 0xFFC4D8E2: return "Cadet Blue";    TODO: duplicate case value */
-        case 0xFF60AFDD: return "Ozone";
-        case 0xFF003D6B: return "Salem Blue";
-        case 0xFF0F2B5B: return "Blue Ribbon";
-        case 0xFF192168: return "Pro Navy";
-        case 0xFF2B265B: return "Blue Ink";
-        case 0xFF002654: return "Pro Midnight";
-        case 0xFF002649: return "Pro College Blue";
-        case 0xFF353F5B: return "Light Midnight";
-        case 0xFF35264F: return "Fleet Blue";
-        case 0xFF112151: return "Light Navy";
-        case 0xFF14213D: return "Flag Blue";
-     /* case 0xFF002654: return "TH Navy";    TODO: duplicate case value */
-     /* case 0xFF14213D: return "Navy";    TODO: duplicate case value */
-     /* case 0xFF14213D: return "Midnight Navy";    TODO: duplicate case value */
-        case 0xFFC6D1D6: return "Pastel Blue";
-     /* case 0xFFC1C9DD: return "Blue Hint";    TODO: duplicate case value */
-        case 0xFFB5D1E8: return "Ice Blue";
-        case 0xFFD1CEDD: return "Paris Blue";
-        case 0xFF99BADD: return "Baby Blue";
-     /* case 0xFFAFBCDB: return "Sun Blue";    TODO: duplicate case value */
-        case 0xFFA5BAE0: return "Cristy Blue";
-        case 0xFF75B2DD: return "Ultra Blue";
-     /* case 0xFF75AADB: return "Tropic Blue";    TODO: duplicate case value */
-     /* case 0xFF6689CC: return "Blue Horizon";    TODO: duplicate case value */
-        case 0xFF7F8CBF: return "Oriental Blue";
-     /* case 0xFF6D87A8: return "Copen";    TODO: duplicate case value */
-     /* case 0xFF5B77CC: return "Jay Blue";    TODO: duplicate case value */
-        case 0xFF2D338E: return "Blue";
-     /* case 0xFF2D338E: return "Sapphire";    TODO: duplicate case value */
-        case 0xFF00337F: return "Pro Royal";
-        case 0xFF003893: return "Fire Blue";
-     /* case 0xFF2D338E: return "Jamie Blue";    TODO: duplicate case value */
-        case 0xFF3F2893: return "Empire Blue";
-        case 0xFF3A564F: return "Enchanted Sea";
-        case 0xFF8499A5: return "Pro Twinkle";
-        case 0xFF9BAABF: return "Rockport Blue";
-        case 0xFF5E99AA: return "Wonder Blue";
-        case 0xFFADAFAA: return "Traditional Gray";
-        case 0xFFBFBAAF: return "Steel";
-        case 0xFFBAB7AF: return "Pro Pearl";
-        case 0xFFC4C1BA: return "Pro Cool Gray";
-        case 0xFFCCC1B2: return "Stainless Steel";
-        case 0xFFD1CCBF: return "Chrome";
-     /* case 0xFFADAFAA: return "Pro Night Sky";    TODO: duplicate case value */
-        case 0xFF8C8984: return "Gull";
-        case 0xFF686663: return "Mineral";
-        case 0xFF443D38: return "Black Chrome";
-        case 0xFFDDC6C4: return "Heather";
-        case 0xFFD3B7A3: return "Grape";
-        case 0xFFB5939B: return "Satin Wine";
-        case 0xFF8E6877: return "Ducky Mauve";
-     /* case 0xFFFCBFC9: return "Pale Orchid";    TODO: duplicate case value */
-        case 0xFFE5BFC6: return "Orchid";
-     /* case 0xFFEFC6D3: return "Lavender";    TODO: duplicate case value */
-        case 0xFFEDC4DD: return "Violet";
-        case 0xFFB58CB2: return "Cachet";
-        case 0xFFC9ADD8: return "Tulip";
-        case 0xFFE29ED6: return "Mid Lilac";
-        case 0xFF512654: return "Port Wine";
-        case 0xFF512D44: return "Pro Maroon";
-        case 0xFF8E47AD: return "Laurie Lilac";
-        case 0xFFAF72C1: return "Iris";
-        case 0xFF9B4F96: return "Raspberry";
-        case 0xFF66116D: return "Mulberry";
-        case 0xFF63305E: return "Plum Wine";
-     /* case 0xFF1E1C77: return "Purple Twist";    TODO: duplicate case value */
-        case 0xFF332875: return "Violet Blue";
-        case 0xFF35006D: return "Purple Maze";
-        case 0xFF2B1166: return "Pro Brite Star";
-        case 0xFF38197A: return "Pro Violet";
-     /* case 0xFF35006D: return "Pro Purple";    TODO: duplicate case value */
-     /* case 0xFF8E47AD: return "Purple";    TODO: duplicate case value */
-        case 0xFF5B027A: return "Purple Shadow";
-        case 0xFF4C145E: return "Dark Purple";
-        case 0xFF8977BA: return "Mauve";
-        case 0xFF44235E: return "Purple Accent";
-        case 0xFFAA0066: return "Hot Peony";
-     /* case 0xFFCE007C: return "Passion";    TODO: duplicate case value */
-     /* case 0xFFAA004F: return "Strawberry";    TODO: duplicate case value */
-        case 0xFF9E2387: return "Plum";
-     /* case 0xFF5E99AA: return "Misty";    TODO: duplicate case value */
-        case 0xFF609191: return "Mystic Teal";
-     /* case 0xFF609191: return "Teal";    TODO: duplicate case value */
-     /* case 0xFF003F54: return "Dark Teal";    TODO: duplicate case value */
-        case 0xFF93DDDB: return "Mint Julep";
-        case 0xFF7FD6DB: return "Turquoise";
-        case 0xFF007272: return "M.D. Green";
-        case 0xFF70CE9B: return "Seafoam";
-     /* case 0xFF70CE9B: return "Isle Green";    TODO: duplicate case value */
-        case 0xFF35C4AF: return "Peppermint";
-     /* case 0xFF006D75: return "Oceanic Green";    TODO: duplicate case value */
-        case 0xFF006B77: return "Pro Teal";
-        case 0xFF006663: return "Garden Green";
-        case 0xFF006D66: return "Pro Green";
-     /* case 0xFF008C82: return "Pine Green";    TODO: duplicate case value */
-        case 0xFF008272: return "Greenstone";
-     /* case 0xFF006663: return "Fern Green";    TODO: duplicate case value */
-     /* case 0xFF006D66: return "Pro Hunter";    TODO: duplicate case value */
-        case 0xFFBCC1B2: return "Palm Leaf";
-        case 0xFFC6D6A0: return "Flite Green";
-        case 0xFF9EAA99: return "Willow";
-        case 0xFFB2D8D8: return "Sprite";
-        case 0xFF7AA891: return "Moss";
-     /* case 0xFF7AA891: return "Wintergreen";    TODO: duplicate case value */
-        case 0xFF006056: return "Green Forest";
-     /* case 0xFF006056: return "Pro Forest";    TODO: duplicate case value */
-        case 0xFF4F6D5E: return "Harbor Green";
-        case 0xFF024930: return "Evergreen";
-        case 0xFF004438: return "Pro Dark Green";
-        case 0xFF2B4C3F: return "Lizzy Lime";
-        case 0xFF282D26: return "D.H. Green";
-        case 0xFFF2EABC: return "Celery";
-        case 0xFFCCC693: return "Pistachio";
-        case 0xFF5E663A: return "Olive Drab";
-        case 0xFF779182: return "Olive";
-     /* case 0xFFC9E8DD: return "Pale Green";    TODO: duplicate case value */
-     /* case 0xFF93DDDB: return "Green Pearl";    TODO: duplicate case value */
-     /* case 0xFF93DDDB: return "Sea Mist";    TODO: duplicate case value */
-        case 0xFFB5E8BF: return "Mint";
-        case 0xFFAADD6D: return "Spruce";
-        case 0xFFA0DB8E: return "Nile";
-        case 0xFFB5CC8E: return "Green Oak";
-        case 0xFF8CD600: return "Erin Green";
-        case 0xFF56AA1C: return "Pro Erin";
-        case 0xFF339E35: return "Emerald";
-        case 0xFF007A3D: return "Dark Emerald";
-     /* case 0xFF007A3D: return "Light Kelly";    TODO: duplicate case value */
-     /* case 0xFF007A3D: return "Kelly";    TODO: duplicate case value */
-        case 0xFF008751: return "Dark Green";
-        case 0xFF006B3F: return "Fleece Green";
-        case 0xFF006854: return "TH Green";
-        case 0xFF1EB53A: return "Harvest Green";
-        case 0xFF009E49: return "Vibrant Green";
-     /* case 0xFF009E49: return "Green Grass";    TODO: duplicate case value */
-     /* case 0xFF006B3F: return "Deep Green";    TODO: duplicate case value */
-        case 0xFF006B54: return "Green Bay";
-        case 0xFF007C66: return "Jungle Green";
-        case 0xFFA3AF07: return "Peapod";
-        case 0xFF7FBA00: return "Pastoral Green";
-     /* case 0xFF7FBA00: return "Green Dust";    TODO: duplicate case value */
-     /* case 0xFF7FBA00: return "Ming";    TODO: duplicate case value */
-        case 0xFF568E14: return "Meadow";
-        case 0xFF939905: return "Tamarack";
-        case 0xFF566314: return "Palmetto";
-     /* case 0xFF024930: return "Green Petal";    TODO: duplicate case value */
-        case 0xFF547730: return "Sage";
-        case 0xFF3F4926: return "Hedge";
-        case 0xFF3A7728: return "Green";
-        case 0xFF193833: return "Green Sail";
-        case 0xFF215B33: return "Holly";
-        case 0xFF265142: return "Field Green";
-     /* case 0xFF3F4926: return "Dress Green";    TODO: duplicate case value */
-        case 0xFF99840A: return "Foliage Green";
-        case 0xFFA38205: return "Autumn Green";
-        case 0xFF897719: return "Desert Cactus";
-        case 0xFF707014: return "Cypress";
-        case 0xFF848205: return "Crescent Moon";
-        case 0xFFE2E584: return "Pebblestone";
-        case 0xFF998E07: return "Sun Shadow";
-        case 0xFF00494F: return "Blue Spruce";
-     /* case 0xFF4F6D5E: return "Newport";    TODO: duplicate case value */
-     /* case 0xFF779182: return "Spring Garden";    TODO: duplicate case value */
-        case 0xFF546856: return "Water Lilly";
-        case 0xFF0C3026: return "Ivy";
-        case 0xFF233A2D: return "Dark Army Green";
-        case 0xFF213D30: return "Army Green";
-        case 0xFFC9D6A3: return "Pastel Green";
-        case 0xFFE0AA0F: return "Pollen Gold";
-        case 0xFFF4E287: return "Pale Yellow";
-        case 0xFFFFC61E: return "Buttercup";
-        case 0xFFF7E8AA: return "Tusk";
-        case 0xFFF9DD16: return "Moonbeam";
-        case 0xFFC6A00C: return "Black Eyed Susie";
-        case 0xFFA37F14: return "Bullion";
-     /* case 0xFFF7E8AA: return "Chinese Yellow";    TODO: duplicate case value */
-     /* case 0xFFF7E8AA: return "Maize";    TODO: duplicate case value */
-        case 0xFFEADD96: return "Wheat";
-        case 0xFFF9E08C: return "Pro Maize";
-        case 0xFFFFD87F: return "Glow";
-        case 0xFFFCD856: return "Star Gold";
-        case 0xFFFCA311: return "Mango";
-     /* case 0xFFFCA311: return "Yellow Mist";    TODO: duplicate case value */
-     /* case 0xFFFCA311: return "Yellow";    TODO: duplicate case value */
-     /* case 0xFFF9DD16: return "Sunflower";    TODO: duplicate case value */
-        case 0xFFF4ED47: return "Lemon";
-        case 0xFFF9E814: return "Daffodil";
-        case 0xFFFCB514: return "Merit Gold";
-        case 0xFFFFCC49: return "Cornsilk";
-     /* case 0xFFFFC61E: return "Nectar";    TODO: duplicate case value */
-        case 0xFFFCBF49: return "Scholastic";
-        case 0xFFFCE016: return "Canary Yellow";
-     /* case 0xFFFFC61E: return "Pro Gold";    TODO: duplicate case value */
-        case 0xFFFCD116: return "Manila";
-     /* case 0xFFFCD116: return "Goldenrod";    TODO: duplicate case value */
-     /* case 0xFFFFCC49: return "Brite Yellow";    TODO: duplicate case value */
-        case 0xFFF99B0C: return "Honeydew";
-        case 0xFFF77F00: return "Pumpkin";
-        case 0xFFF74902: return "Orangeade";
-     /* case 0xFFF74902: return "Sun Orange";    TODO: duplicate case value */
-        case 0xFFF95602: return "Paprika";
-        case 0xFFF93F26: return "Saffron";
-     /* case 0xFFF95602: return "Tex Orange";    TODO: duplicate case value */
-        case 0xFFF96B07: return "Orange";
-        case 0xFFF96302: return "Dark Tex Orange";
-        case 0xFFA53F0F: return "Old Dark Tex Orange";
-        case 0xFFFC8744: return "Golden Poppy";
-        case 0xFFBC4F07: return "Rust";
-        case 0xFFAF7505: return "Copper";
-        case 0xFFC18E60: return "Light Bronze";
-        case 0xFFFCCE87: return "Visor Gold";
-     /* case 0xFFFFCC49: return "Goldenlite";    TODO: duplicate case value */
-        case 0xFFFCBA5E: return "Honey";
-     /* case 0xFFFFCC49: return "Marigold";    TODO: duplicate case value */
-     /* case 0xFFE0AA0F: return "Mustard";    TODO: duplicate case value */
-     /* case 0xFFE0AA0F: return "Sun Gold";    TODO: duplicate case value */
-     /* case 0xFFE0AA0F: return "Karat";    TODO: duplicate case value */
-        case 0xFFF2BF49: return "Penny";
-     /* case 0xFFFCCE87: return "New Gold";    TODO: duplicate case value */
-        case 0xFFE2D6B5: return "Pro Beige";
-     /* case 0xFFC6A00C: return "Marine Gold";    TODO: duplicate case value */
-     /* case 0xFFA37F14: return "Ginger";    TODO: duplicate case value */
-     /* case 0xFFC6A00C: return "Shimmering Gold";    TODO: duplicate case value */
-        case 0xFFBF910C: return "Old Gold";
-        case 0xFFEAB2B2: return "Salmon";
-        case 0xFFC13828: return "Dark Rust";
-        case 0xFFA03033: return "Terra Cotta";
-     /* case 0xFFAF1E2D: return "Pro Red";    TODO: duplicate case value */
-     /* case 0xFFAF1E2D: return "Auburn";    TODO: duplicate case value */
-        case 0xFFFAE6CC: return "Bone";
-        case 0xFFFAE6CF: return "Ivory";
-        case 0xFFF7D3B5: return "Opaline";
-        case 0xFFEDD3BC: return "Ecru";
-        case 0xFFAA753F: return "Wicker";
-        case 0xFFD3A87C: return "Tan";
-        case 0xFFEDD3B5: return "Cottage Beige";
-        case 0xFFC1A875: return "Rattan";
-        case 0xFFE2BF9B: return "Gold";
-     /* case 0xFFD3A87C: return "Mocha Cream";    TODO: duplicate case value */
-     /* case 0xFFBF910C: return "Topaz";    TODO: duplicate case value */
-        case 0xFFD18E54: return "Ashley Gold";
-        case 0xFFD8B596: return "Amber Beige";
-        case 0xFFD6CCAF: return "Seashell";
-        case 0xFFF2E3C4: return "Light Maize";
-     /* case 0xFFAA753F: return "Beige";    TODO: duplicate case value */
-        case 0xFF6B4714: return "Sand Dune";
-        case 0xFFD1BF91: return "Taupe";
-        case 0xFF6C463D: return "Pro Brown";
-        case 0xFF876028: return "Chocolate";
-        case 0xFF755426: return "Pro Walnut";
-     /* case 0xFF755426: return "Light Cocoa";    TODO: duplicate case value */
-        case 0xFFB28260: return "Cocoa Mulch";
-        case 0xFF593D2B: return "Brown";
-     /* case 0xFF593D2B: return "Dark Brown";    TODO: duplicate case value */
-        case 0xFF3F302B: return "Espresso";
-     /* case 0xFFC18E60: return "Bamboo";    TODO: duplicate case value */
-     /* case 0xFFAF7505: return "Almond";    TODO: duplicate case value */
-        case 0xFFBA7530: return "Toast";
-     /* case 0xFF755426: return "Sienna";    TODO: duplicate case value */
-        case 0xFFB26B70: return "K.A. Bronze";
-        case 0xFFA2464E: return "Pro Cinnamon";
-        case 0xFF9B4F19: return "Date";
-     /* case 0xFF9B4F19: return "Hazel";    TODO: duplicate case value */
-        case 0xFF5B2D28: return "Coffee Bean";
-     /* case 0xFF593D2B: return "Dogwood";    TODO: duplicate case value */
-     /* case 0xFF3F302B: return "Mahogany";    TODO: duplicate case value */
-        case 0xFF3D3028: return "Best Brown";
-        case 0xFF633A11: return "Mushroom";
-     /* case 0xFFC1A875: return "Perfect Tan";    TODO: duplicate case value */
-        case 0xFF7A5B11: return "Earthen Tan";
-     /* case 0xFFC1A875: return "Golden Tan";    TODO: duplicate case value */
-     /* case 0xFFF2BF49: return "14 Kt. Gold";    TODO: duplicate case value */
-        case 0xFFF2CE68: return "TH Gold";
-        case 0xFFD88C02: return "24 Kt. Gold";
-        case 0xFFC1B5A5: return "Platinum";
-        case 0xFF99897C: return "Pro Gray";
-        case 0xFFADA07A: return "Grayrod";
-     /* case 0xFFADA07A: return "Pewter";    TODO: duplicate case value */
-        case 0xFFF5E3CC: return "Aspen White";
-        case 0xFF66594C: return "Dark Taupe";
-        case 0xFF493533: return "Egyptian Brown";
-        case 0xFFF5EBE0: return "Oyster";
-     /* case 0xFFDDC6C4: return "Gray";    TODO: duplicate case value */
-        case 0xFFDBD3D3: return "Pearl Gray";
-        case 0xFFD8CCD1: return "Steel Gray";
-        case 0xFFCCC1C6: return "Skylight";
-        case 0xFFAFAAA3: return "Cloud";
-     /* case 0xFFADAFAA: return "Silver Steel";    TODO: duplicate case value */
-        case 0xFF919693: return "Banner Gray";
-     /* case 0xFF8C8984: return "Silvery Gray";    TODO: duplicate case value */
-     /* case 0xFFCCC1C6: return "Cinder";    TODO: duplicate case value */
-     /* case 0xFFDBD3D3: return "Saturn Gray";    TODO: duplicate case value */
-     /* case 0xFFCCC1C6: return "Dover Gray";    TODO: duplicate case value */
-        case 0xFFB2A8B5: return "Storm Gray";
-        case 0xFFA893AD: return "Sterling";
-        case 0xFF666D70: return "Metal";
-     /* case 0xFF686663: return "Twilight";    TODO: duplicate case value */
-     /* case 0xFF443D38: return "Aged Charcoal";    TODO: duplicate case value */
-        case 0xFF777772: return "Charcoal";
-        case 0xFF353842: return "Smokey";
-        case 0xFF3A4972: return "Ash";
-        case 0xFF1C2630: return "Black";
-     /* case 0xFFF5EBE0: return "Snow White";    TODO: duplicate case value */
-        case 0xFFF5EDDE: return "Natural White";
-        case 0xFFF0E8D6: return "Eggshell";
-     /* case 0xFF1C2630: return "Jet Black";    TODO: duplicate case value */
-
-        /* BEGIN N/A COLORS */
-        /*
-                         return "3CC Red";
-                         return "3CC Rose";
-                         return "3CC Apricot";
-                         return "3CC Pink";
-                         return "3CC Purple";
-                         return "3CC Lilac";
-                         return "3CC Blue";
-                         return "3CC Light Blue";
-                         return "3CC Turquoise";
-                         return "3CC Green";
-                         return "3CC Kelly";
-                         return "3CC Light Green";
-                         return "3CC Olive";
-                         return "3CC Yellow";
-                         return "3CC Maize";
-                         return "3CC Tangerine";
-                         return "3CC Orange";
-                         return "3CC Brown";
-                         return "3CC Nugget";
-                         return "3CC Gold";
-                         return "3CC Gray";
-                         return "3CC Flag";
-                         return "3CC Horizon";
-                         return "3CC Autumn";
-                         return "4CC Fiesta";
-                         return "4CC Mexicana";
-                         return "4CC Pastel";
-                         return "4CC Melody";
-                         return "4CC Rainbow";
-        */
-        /* END N/A COLORS */
+        int middle = low + (high - low) / 2;
+        if(chart->colors[middle].color < color)
+            low = middle + 1;
+        else
+            high = middle;
     }
-
-    return "";
+    if(low < chart->count && chart->colors[low].color == color)
+        return &chart->colors[low];
+    return 0;
 }
 
-int getNum_Sigma_Polyester(unsigned int color)
+/*! Returns the entry of \a brand with the catalog \a number, or null if the chart does not have it. */
+const ThreadColor* threadColor_findNumber(int number, ThreadBrand brand)
 {
-    switch(color)
-    {
-        case 0xFFFFFFFF: return   10;
-        case 0xFF000000: return   20;
-        case 0xFFEDFF50: return   21;
-        case 0xFF96E845: return   32;
-        case 0xFFFFE756: return   33;
-        case 0xFFFF7824: return   43;
-        case 0xFFF28DA6: return   46;
-        case 0xFFC70C57: return   47;
-        case 0xFFE22D2A: return  101;
-        case 0xFFB8B8B8: return  102;
-        case 0xFF889186: return  112;
-        case 0xFF737F7F: return  115;
-        case 0xFF565E5A: return  116;
-        case 0xFF515250: return  117;
-        case 0xFF787668: return  118;
-        case 0xFFED572F: return  135;
-        case 0xFF2EA59C: return  138;
-        case 0xFF396276: return  142;
-        case 0xFF9B3B40: return  213;
-        case 0xFF6C3E47: return  216;
-        case 0xFFBA6E4D: return  253;
-        case 0xFFBB3D2E: return  255;
-        case 0xFFF9DFCF: return  301;
-        case 0xFFFBDED6: return  303;
-        case 0xFFF7CDD5: return  304;
-        case 0xFFF2AFB4: return  305;
-        case 0xFFE8418C: return  307;
-        case 0xFFE77F9D: return  309;
-        case 0xFFF06F8C: return  313;
-        case 0xFF008340: return  317;
-        case 0xFFDF99B6: return  321;
-        case 0xFF820052: return  325;
-        case 0xFFB1415F: return  333;
-        case 0xFFC394AE: return  345;
-        case 0xFFA86E91: return  347;
-        case 0xFF694169: return  348;
-        case 0xFFE6CFD5: return  376;
-        case 0xFFA8BED7: return  379;
-        case 0xFFA0BFD7: return  380;
-        case 0xFF90A6C6: return  381;
-        case 0xFF8FAFC6: return  382;
-        case 0xFFB1B8D3: return  383;
-        case 0xFF416C9B: return  385;
-        case 0xFF7D77AF: return  386;
-        case 0xFFFADAF4: return  387;
-        case 0xFF664090: return  390;
-        case 0xFFEAF0F9: return  402;
-        case 0xFFA6D8F6: return  403;
-        case 0xFF7B9CB0: return  404;
-        case 0xFF648DC7: return  406;
-        case 0xFF3D6AA1: return  409;
-        case 0xFF2D4491: return  413;
-        case 0xFF143D7A: return  414;
-        case 0xFF113263: return  415;
-        case 0xFF0E1F38: return  423;
-     /* case 0xFF0E1F38: return  432;    TODO: duplicate case value */
-        case 0xFF0091A5: return  443;
-        case 0xFF005B63: return  448;
-        case 0xFF00474D: return  449;
-        case 0xFFE5B15C: return  466;
-        case 0xFFD5BF9B: return  501;
-        case 0xFFFFD085: return  503;
-        case 0xFFF6B08E: return  505;
-        case 0xFFB3E851: return  506;
-        case 0xFFF1A236: return  508;
-        case 0xFF6E4337: return  513;
-        case 0xFFD8493E: return  527;
-        case 0xFF697698: return  541;
-        case 0xFFFDE896: return  601;
-        case 0xFFEDE55D: return  602;
-        case 0xFFDFA200: return  609;
-     /* case 0xFFFDE896: return  612;    TODO: duplicate case value */
-        case 0xFFCEB24C: return  616;
-        case 0xFFAD953E: return  619;
-        case 0xFFFEF9EA: return  627;
-        case 0xFFBD9565: return  628;
-        case 0xFFFDF76C: return  632;
-        case 0xFFEDEF05: return  633;
-        case 0xFFF8C300: return  646;
-        case 0xFFE77817: return  649;
-        case 0xFFE66535: return  650;
-        case 0xFFC69632: return  652;
-        case 0xFF98996D: return  653;
-        case 0xFFC98300: return  654;
-        case 0xFF007B8D: return  688;
-        case 0xFF004D3D: return  695;
-        case 0xFF007EBA: return  697;
-        case 0xFFCF0040: return  700;
-        case 0xFF28438C: return  809;
-        case 0xFFD0B478: return  812;
-        case 0xFFE5BE6C: return  818;
-        case 0xFF449284: return  825;
-        case 0xFFCFCFCF: return  829;
-        case 0xFFDC875E: return  831;
-        case 0xFFB4705D: return  832;
-        case 0xFF9B5C4B: return  833;
-        case 0xFFA93121: return  838;
-        case 0xFFB18B00: return  842;
-        case 0xFF86462E: return  857;
-        case 0xFF614125: return  859;
-        case 0xFFB25C31: return  864;
-        case 0xFF806A61: return  873;
-        case 0xFF634831: return  878;
-        case 0xFF1A0C06: return  891;
-        case 0xFF96D5C8: return  903;
-        case 0xFFB4DCD8: return  904;
-        case 0xFFAF7D3E: return  905;
-        case 0xFF00A3A0: return  906;
-        case 0xFF00405D: return  913;
-        case 0xFFC9E3C5: return  947;
-        case 0xFF55AF78: return  949;
-        case 0xFF858325: return  951;
-        case 0xFF61601C: return  955;
-        case 0xFF709188: return  961;
-        case 0xFFBEDC8C: return  984;
-        case 0xFFBEE678: return  985;
-        case 0xFF76C850: return  988;
-        case 0xFF466E64: return  448;
-        case 0xFF356936: return  992;
-        case 0xFF4B4884: return 1031;
-        case 0xFFEDEDD2: return 1140;
-        case 0xFFF3D8A8: return 1145;
-        case 0xFFC8BE96: return 1148;
-        case 0xFF243A7D: return 1163;
-        case 0xFF86BE4E: return 1183;
-        case 0xFF8E4044: return 1241;
-        case 0xFF893480: return 1323;
-        case 0xFF8C6DAA: return 1324;
-        case 0xFFB6A36C: return 1552;
-        case 0xFF2E9F76: return 1615;
-        case 0xFF98C173: return 1619;
-        case 0xFFCDCDCD: return 1707;
-        case 0xFF2A377E: return 2031;
-        case 0xFF006CA5: return 2093;
-        case 0xFF834455: return 2250;
-        case 0xFFD0A44F: return 2518;
-        case 0xFFED9206: return 2519;
-     /* case 0xFFEDEF05: return 3001;    TODO: duplicate case value */
-        case 0xFFC07A46: return 3014;
-        case 0xFFB43C3C: return 3015;
-        case 0xFF915F46: return 3142;
-        case 0xFFFFC500: return 4117;
-        case 0xFFA68A68: return 4371;
-        case 0xFF00A4D9: return 4419;
-        case 0xFF0B7F85: return 4627;
-        case 0xFF002D1F: return 4735;
-        case 0xFF11263C: return 5552;
-        case 0xFF91B9E2: return 5554;
-        case 0xFF429648: return 5557;
-        case 0xFF878C8C: return 8010;
-    }
+    const ThreadChart* chart = threadColor_chart(brand);
+    int low = 0, high = 0;
 
-    return -1;
-}
-const char* getName_Sigma_Polyester(unsigned int color)
-{
-    switch(color)
+    if(!chart) return 0;
+
+    high = chart->numberCount;
+    while(low < high)
     {
-        case 0xFFFFFFFF: return "White";
-        case 0xFF000000: return "Black";
-        case 0xFFEDFF50: return "Light Neon Green";
-        case 0xFF96E845: return "Neon Green";
-        case 0xFFFFE756: return "Light Neon Orange";
-        case 0xFFFF7824: return "Med Neon Orange";
-        case 0xFFF28DA6: return "Neon Pink";
-        case 0xFFC70C57: return "Neon Orange Pink";
-        case 0xFFE22D2A: return "Silver";
-        case 0xFFB8B8B8: return "Silver Diamond";
-        case 0xFF889186: return "Lava Stone";
-        case 0xFF737F7F: return "Medium Grey";
-        case 0xFF565E5A: return "Dark Platinum";
-        case 0xFF515250: return "Charcoal";
-        case 0xFF787668: return "Badger Grey";
-        case 0xFFED572F: return "Pumpkin Orange";
-        case 0xFF2EA59C: return "Turquoise";
-        case 0xFF396276: return "Dark Wedgewood";
-        case 0xFF9B3B40: return "Cardinal Red";
-        case 0xFF6C3E47: return "Maroon";
-        case 0xFFBA6E4D: return "Rust";
-        case 0xFFBB3D2E: return "Medium Rust";
-        case 0xFFF9DFCF: return "Natural Pink";
-        case 0xFFFBDED6: return "Baby Pink";
-        case 0xFFF7CDD5: return "Piggy Pink";
-        case 0xFFF2AFB4: return "Sweet Pink";
-        case 0xFFE8418C: return "Blushing Pink";
-        case 0xFFE77F9D: return "Pink";
-        case 0xFFF06F8C: return "Rose Pink";
-        case 0xFF008340: return "Green";
-        case 0xFFDF99B6: return "Shocking Pink";
-        case 0xFF820052: return "Ruby";
-        case 0xFFB1415F: return "Garnet";
-        case 0xFFC394AE: return "Light Purple";
-        case 0xFFA86E91: return "Medium Purple";
-        case 0xFF694169: return "Dark Grape";
-        case 0xFFE6CFD5: return "Pastel Light Pink";
-        case 0xFFA8BED7: return "Light Baby Blue";
-        case 0xFFA0BFD7: return "Crystal Blue";
-        case 0xFF90A6C6: return "Very Light Lavender";
-        case 0xFF8FAFC6: return "Cornflower";
-        case 0xFFB1B8D3: return "Lavender";
-        case 0xFF416C9B: return "Denim";
-        case 0xFF7D77AF: return "Light Violet";
-        case 0xFFFADAF4: return "Misty Rose";
-        case 0xFF664090: return "Grape";
-        case 0xFFEAF0F9: return "Lt. Weathered Blue";
-        case 0xFFA6D8F6: return "Baby Blue";
-        case 0xFF7B9CB0: return "Med Baby Blue";
-        case 0xFF648DC7: return "Med Pastel Blue";
-        case 0xFF3D6AA1: return "Blue Raspberry";
-        case 0xFF2D4491: return "Med Royal Blue";
-        case 0xFF143D7A: return "Ocean Blue";
-        case 0xFF113263: return "Med Navy";
-        case 0xFF0E1F38: return "Dark Navy";
-     /* case 0xFF0E1F38: return "Bright Sunshine";    TODO: duplicate case value */
-        case 0xFF0091A5: return "Teal";
-        case 0xFF005B63: return "Deep Teal";
-        case 0xFF00474D: return "Dark Teal";
-        case 0xFFE5B15C: return "Old Gold";
-        case 0xFFD5BF9B: return "Cream";
-        case 0xFFFFD085: return "Pale Salmon";
-        case 0xFFF6B08E: return "Med Peach";
-        case 0xFFB3E851: return "Pink Salmon";
-        case 0xFFF1A236: return "Dark Peach";
-        case 0xFF6E4337: return "Dark Brown";
-        case 0xFFD8493E: return "Pale Red";
-        case 0xFF697698: return "Heron Blue";
-        case 0xFFFDE896: return "Pale Yellow";
-        case 0xFFEDE55D: return "Pastel Yellow";
-        case 0xFFDFA200: return "Golden Puppy";
-     /* case 0xFFFDE896: return "Buttercup";    TODO: duplicate case value */
-        case 0xFFCEB24C: return "Treasure Gold";
-        case 0xFFAD953E: return "Old Gold";
-        case 0xFFFEF9EA: return "Pale Apricot";
-        case 0xFFBD9565: return "Tan";
-        case 0xFFFDF76C: return "Mellow Yellow";
-        case 0xFFEDEF05: return "Lemon";
-        case 0xFFF8C300: return "Amber";
-        case 0xFFE77817: return "Mandarina";
-        case 0xFFE66535: return "Orange";
-        case 0xFFC69632: return "Golden Rod";
-        case 0xFF98996D: return "Light Olive";
-        case 0xFFC98300: return "Bright Gold";
-        case 0xFF007B8D: return "Blue-Green";
-        case 0xFF004D3D: return "Forrest Green";
-        case 0xFF007EBA: return "Midnight Blue";
-        case 0xFFCF0040: return "Med Red";
-        case 0xFF28438C: return "Med Blue";
-        case 0xFFD0B478: return "Sweet Apricot";
-        case 0xFFE5BE6C: return "Skin";
-        case 0xFF449284: return "Jade";
-        case 0xFFCFCFCF: return "Light Silver";
-        case 0xFFDC875E: return "Papaya Whip";
-        case 0xFFB4705D: return "Cooper";
-        case 0xFF9B5C4B: return "Light Pecan";
-        case 0xFFA93121: return "Burnt Rust";
-        case 0xFFB18B00: return "Vegas Gold";
-        case 0xFF86462E: return "Med Brown";
-        case 0xFF614125: return "Med Russett";
-        case 0xFFB25C31: return "Med Copper";
-        case 0xFF806A61: return "Dark Driftwood";
-        case 0xFF634831: return "Birch";
-        case 0xFF1A0C06: return "Dark Chocolate";
-        case 0xFF96D5C8: return "Sky Blue 2";
-        case 0xFFB4DCD8: return "Aquamarine";
-        case 0xFFAF7D3E: return "Golden Brown";
-        case 0xFF00A3A0: return "Sea Blue";
-        case 0xFF00405D: return "Deep Sea";
-        case 0xFFC9E3C5: return "Pastel Mint";
-        case 0xFF55AF78: return "True Green";
-        case 0xFF858325: return "Med Olive";
-        case 0xFF61601C: return "Olive";
-        case 0xFF709188: return "Light Jade";
-        case 0xFFBEDC8C: return "Smith Apple";
-        case 0xFFBEE678: return "Light Lime";
-        case 0xFF76C850: return "Grass Green";
-        case 0xFF466E64: return "Deep Teal";
-        case 0xFF356936: return "Med Forrest Green";
-        case 0xFF4B4884: return "Deep Violet";
-        case 0xFFEDEDD2: return "Light Natural";
-        case 0xFFF3D8A8: return "Wheat";
-        case 0xFFC8BE96: return "Desert Sand";
-        case 0xFF243A7D: return "Egyptian Blue";
-        case 0xFF86BE4E: return "Gecko";
-        case 0xFF8E4044: return "Burgandy";
-        case 0xFF893480: return "Med Orchid";
-        case 0xFF8C6DAA: return "Med Purple";
-        case 0xFFB6A36C: return "Very Old Gold";
-        case 0xFF2E9F76: return "Light Spruce";
-        case 0xFF98C173: return "Paris Green";
-        case 0xFFCDCDCD: return "Timberwolf";
-        case 0xFF2A377E: return "Bright Blue";
-        case 0xFF006CA5: return "Turquoise Blue";
-        case 0xFF834455: return "Dark Wine";
-        case 0xFFD0A44F: return "Beige";
-        case 0xFFED9206: return "Gold";
-     /* case 0xFFEDEF05: return "Med Orange";    TODO: duplicate case value */
-        case 0xFFC07A46: return "Dark Salmon";
-        case 0xFFB43C3C: return "Fire Red";
-        case 0xFF915F46: return "Saddle Brown";
-        case 0xFFFFC500: return "Yellow Sun";
-        case 0xFFA68A68: return "Deep Taupe";
-        case 0xFF00A4D9: return "Sky Blue";
-        case 0xFF0B7F85: return "Wild Peacock";
-        case 0xFF002D1F: return "Millard Green";
-        case 0xFF11263C: return "Dark Blue";
-        case 0xFF91B9E2: return "Powder Blue";
-        case 0xFF429648: return "Froggy Green";
-        case 0xFF878C8C: return "Stone Grey";
+        int middle = low + (high - low) / 2;
+        if(chart->colors[chart->byNumber[middle]].number < number)
+            low = middle + 1;
+        else
+            high = middle;
     }
-
-    return "";
+    if(low < chart->numberCount && chart->colors[chart->byNumber[low]].number == number)
+        return &chart->colors[chart->byNumber[low]];
+    return 0;
 }
 
-int getNum_Sulky_Rayon(unsigned int color)
+/*! Returns the entry closest to \a color among the charts of the \a brandCount brands in \a brands, comparing
+ *  the red, green and blue components. If \a brand is not null, the brand of the entry is stored there.
+ *  Exact matches are found without searching. Returns null if none of the charts has any colors. */
+const ThreadColor* threadColor_nearest(unsigned int color, const ThreadBrand* brands, int brandCount, ThreadBrand* brand)
 {
-    switch(color)
-    {
-        case 0xFFEFC810: return  502;
-        case 0xFF0C082D: return  505;
-        case 0xFFB26C29: return  521;
-        case 0xFFE79002: return  523;
-        case 0xFF34481E: return  525;
-        case 0xFF113675: return  526;
-        case 0xFF111408: return  538;
-        case 0xFFE10000: return  561;
-        case 0xFFFFB435: return  562;
-        case 0xFFF3A001: return  567;
-        case 0xFFE66D00: return  568;
-        case 0xFF165F28: return  569;
-        case 0xFF088E6C: return  571;
-        case 0xFF100A7C: return  572;
-        case 0xFF35693D: return  580;
-        case 0xFFE9BD96: return  619;
-        case 0xFFCD3900: return  621;
-        case 0xFF777113: return  630;
-        case 0xFF1C6F51: return  640;
-        case 0xFF262345: return  643;
-        case 0xFFF9F9FF: return 1001;
-        case 0xFFF9F9F4: return 1002;
-        case 0xFF000000: return 1005;
-        case 0xFFB7A9AC: return 1011;
-        case 0xFFE1AF9A: return 1015;
-        case 0xFFEC968C: return 1016;
-        case 0xFFEFDFBD: return 1017;
-        case 0xFFECA082: return 1019;
-        case 0xFFF08278: return 1020;
-        case 0xFFEB6602: return 1021;
-        case 0xFFFFF7D5: return 1022;
-        case 0xFFFFE669: return 1023;
-        case 0xFFFFB800: return 1024;
-        case 0xFFD78000: return 1025;
-        case 0xFFBEC3E1: return 1028;
-        case 0xFFA0C3EB: return 1029;
-        case 0xFFA6A2C6: return 1030;
-        case 0xFFDFBEC8: return 1031;
-        case 0xFFE68CEB: return 1032;
-        case 0xFFD86496: return 1033;
-        case 0xFFC6323C: return 1034;
-        case 0xFF790000: return 1035;
-        case 0xFFF90000: return 1037;
-        case 0xFFEB0000: return 1039;
-        case 0xFF877375: return 1040;
-        case 0xFF8C7F83: return 1041;
-        case 0xFF321E50: return 1042;
-        case 0xFF190525: return 1043;
-        case 0xFF1D062F: return 1044;
-        case 0xFFC3EFBF: return 1045;
-        case 0xFF2E8359: return 1046;
-        case 0xFFA6C284: return 1047;
-        case 0xFF42A021: return 1049;
-        case 0xFF1E6419: return 1051;
-        case 0xFFEEBEAE: return 1054;
-        case 0xFFEBBC80: return 1055;
-        case 0xFFAF5B00: return 1056;
-        case 0xFF642702: return 1057;
-        case 0xFF663500: return 1058;
-        case 0xFF530601: return 1059;
-        case 0xFFFFF7B9: return 1061;
-        case 0xFFF0F8EC: return 1063;
-        case 0xFFE6B4AA: return 1064;
-        case 0xFFFF9100: return 1065;
-        case 0xFFFFF180: return 1066;
-        case 0xFFFFFF85: return 1067;
-        case 0xFFF3DBD9: return 1068;
-        case 0xFFF6CE69: return 1070;
-        case 0xFFF9F9EA: return 1071;
-        case 0xFFD6D5E8: return 1074;
-        case 0xFF5A5A8B: return 1076;
-        case 0xFFBECDC8: return 1077;
-        case 0xFFFF6600: return 1078;
-        case 0xFF175523: return 1079;
-        case 0xFFDC82A0: return 1080;
-        case 0xFFF06E78: return 1081;
-        case 0xFFF7E3BB: return 1082;
-        case 0xFFFFC100: return 1083;
-        case 0xFFE2CFC7: return 1085;
-        case 0xFFF9F9E0: return 1086;
-        case 0xFF16625F: return 1090;
-        case 0xFF26BFCA: return 1094;
-        case 0xFF10D1BD: return 1095;
-        case 0xFF0F6978: return 1096;
-        case 0xFFC2D37D: return 1100;
-        case 0xFF098531: return 1101;
-        case 0xFF02140F: return 1103;
-        case 0xFFA5AF68: return 1104;
-        case 0xFFFAA4A4: return 1108;
-        case 0xFFDC6496: return 1109;
-        case 0xFFFCCBDF: return 1111;
-        case 0xFF46016E: return 1112;
-        case 0xFFF0C8B4: return 1113;
-        case 0xFFF0B9B9: return 1115;
-        case 0xFFF5A9A0: return 1117;
-        case 0xFFB46E75: return 1119;
-        case 0xFFF0D6D2: return 1120;
-        case 0xFFFAB9CB: return 1121;
-        case 0xFF82288E: return 1122;
-        case 0xFFFFEC00: return 1124;
-        case 0xFFDC8C17: return 1126;
-        case 0xFFFAECC6: return 1127;
-        case 0xFFC39471: return 1128;
-        case 0xFF6A1F06: return 1129;
-        case 0xFF551602: return 1130;
-        case 0xFF490002: return 1131;
-        case 0xFF507DAA: return 1134;
-        case 0xFFFFF072: return 1135;
-        case 0xFFFFBE00: return 1137;
-        case 0xFF4A5870: return 1143;
-        case 0xFFB4E1EB: return 1145;
-     /* case 0xFFEB0000: return 1147;    TODO: duplicate case value */
-        case 0xFFFFBDBD: return 1148;
-        case 0xFFE8C89C: return 1149;
-        case 0xFFE2E2EB: return 1151;
-        case 0xFFFA9999: return 1154;
-        case 0xFF636327: return 1156;
-        case 0xFFBA4500: return 1158;
-        case 0xFFD39D00: return 1159;
-        case 0xFF10394A: return 1162;
-        case 0xFFDFE5EB: return 1165;
-        case 0xFF8E7E7E: return 1166;
-        case 0xFFFFD226: return 1167;
-        case 0xFFF5740A: return 1168;
-        case 0xFF9C0000: return 1169;
-        case 0xFF975F2F: return 1170;
-        case 0xFF08180E: return 1171;
-        case 0xFF6E788C: return 1172;
-        case 0xFF59591D: return 1173;
-        case 0xFF0D2904: return 1174;
-        case 0xFF152D04: return 1175;
-        case 0xFF515308: return 1176;
-        case 0xFF899812: return 1177;
-        case 0xFF8F623D: return 1179;
-        case 0xFFA58973: return 1180;
-        case 0xFFCB0000: return 1181;
-        case 0xFF020114: return 1182;
-        case 0xFF320614: return 1183;
-     /* case 0xFFFF6600: return 1184;    TODO: duplicate case value */
-        case 0xFFFCBE05: return 1185;
-        case 0xFF5B0000: return 1186;
-        case 0xFFFFE500: return 1187;
-        case 0xFFFF004B: return 1188;
-        case 0xFF4B122D: return 1189;
-        case 0xFFA04656: return 1190;
-        case 0xFFBD1E60: return 1191;
-        case 0xFFD21E82: return 1192;
-        case 0xFFE6AFD2: return 1193;
-        case 0xFFD274D7: return 1194;
-        case 0xFF370150: return 1195;
-        case 0xFF96C3E1: return 1196;
-        case 0xFF220F34: return 1197;
-        case 0xFF3C5075: return 1198;
-        case 0xFF2A143F: return 1199;
-        case 0xFF140B2D: return 1200;
-        case 0xFF648BBE: return 1201;
-        case 0xFF182B56: return 1202;
-        case 0xFFAEB8C3: return 1203;
-        case 0xFFA8C8BC: return 1204;
-        case 0xFF6E90A5: return 1205;
-        case 0xFF1E6E6F: return 1206;
-        case 0xFF80A388: return 1207;
-        case 0xFF0C3D03: return 1208;
-        case 0xFFBDD163: return 1209;
-        case 0xFF273B00: return 1210;
-        case 0xFF95A490: return 1211;
-        case 0xFF63632D: return 1212;
-        case 0xFFB9A096: return 1213;
-        case 0xFF642828: return 1214;
-        case 0xFF500A1E: return 1215;
-        case 0xFFAC1C01: return 1216;
-        case 0xFF971F01: return 1217;
-        case 0xFFDFDFCB: return 1218;
-        case 0xFF98888C: return 1219;
-        case 0xFF765960: return 1220;
-        case 0xFFD1DBFF: return 1222;
-        case 0xFFDCE0F1: return 1223;
-        case 0xFFF0A0B9: return 1224;
-        case 0xFFFACBCB: return 1225;
-        case 0xFF57369E: return 1226;
-        case 0xFFAF8901: return 1227;
-        case 0xFF96AA8B: return 1228;
-        case 0xFFE0DBDB: return 1229;
-        case 0xFF0B4133: return 1230;
-        case 0xFFE5326A: return 1231;
-        case 0xFF193207: return 1232;
-        case 0xFF0D2210: return 1233;
-        case 0xFF3C1B1F: return 1234;
-        case 0xFF783298: return 1235;
-        case 0xFFEAE4E4: return 1236;
-        case 0xFFBC3D2C: return 1237;
-        case 0xFFFF8300: return 1238;
-        case 0xFFFFAB57: return 1239;
-        case 0xFF74586C: return 1240;
-        case 0xFF543A8D: return 1242;
-        case 0xFFFF0000: return 1246;
-        case 0xFF660000: return 1247;
-        case 0xFFD2E6F0: return 1248;
-        case 0xFF62AADC: return 1249;
-        case 0xFF275C70: return 1250;
-        case 0xFF306F75: return 1251;
-        case 0xFF09A1A8: return 1252;
-        case 0xFF1B4CA4: return 1253;
-        case 0xFFE6B9F5: return 1254;
-        case 0xFFBE1982: return 1255;
-        case 0xFFEB8296: return 1256;
-        case 0xFFE60041: return 1257;
-        case 0xFFF0C4A0: return 1258;
-        case 0xFFE28264: return 1259;
-        case 0xFFB30000: return 1263;
-        case 0xFF6A0000: return 1264;
-        case 0xFF9B6B2C: return 1265;
-        case 0xFF9C6D45: return 1266;
-        case 0xFF864C31: return 1267;
-        case 0xFFEFEFE5: return 1268;
-        case 0xFFB7B7AF: return 1270;
-        case 0xFF3C4F31: return 1271;
-        case 0xFF4A4A19: return 1272;
-        case 0xFF5C9A1A: return 1274;
-        case 0xFFE0E6C8: return 1275;
-        case 0xFF70770F: return 1276;
-        case 0xFF027602: return 1277;
-        case 0xFF00AF38: return 1278;
-        case 0xFF93D16C: return 1279;
-        case 0xFF46B774: return 1280;
-        case 0xFF483D59: return 1283;
-        case 0xFF466E78: return 1284;
-        case 0xFF134F45: return 1285;
-        case 0xFF343213: return 1286;
-        case 0xFF415545: return 1287;
-        case 0xFF0FA56F: return 1288;
-        case 0xFFDCEBF0: return 1289;
-        case 0xFF727483: return 1291;
-        case 0xFFD1DCFA: return 1292;
-        case 0xFF44235D: return 1293;
-        case 0xFF412044: return 1294;
-        case 0xFF82878C: return 1295;
-        case 0xFFD2AAF0: return 1296;
-        case 0xFF735A64: return 1297;
-        case 0xFF644664: return 1298;
-        case 0xFF411446: return 1299;
-        case 0xFF7E1E46: return 1300;
-        case 0xFF320046: return 1301;
-        case 0xFF6E0A96: return 1302;
-        case 0xFFB47364: return 1304;
-        case 0xFFAEC6BB: return 1305;
-        case 0xFF7E6C7C: return 1306;
-        case 0xFFDB6478: return 1307;
-        case 0xFF782346: return 1309;
-        case 0xFF961A32: return 1311;
-        case 0xFF840000: return 1312;
-        case 0xFFFC8F0C: return 1313;
-     /* case 0xFFFF0000: return 1317;    TODO: duplicate case value */
-        case 0xFFCBCBBD: return 1321;
-        case 0xFF818901: return 1322;
-        case 0xFFF8F5F1: return 1325;
-        case 0xFFD5C7C3: return 1327;
-        case 0xFFC0B2B7: return 1328;
-        case 0xFFABA0A8: return 1329;
-        case 0xFFEDF6D4: return 1331;
-        case 0xFF868105: return 1332;
-        case 0xFFF3B600: return 1333;
-        case 0xFF349669: return 1503;
-        case 0xFFC1CBB9: return 1508;
-        case 0xFF7AB31D: return 1510;
-        case 0xFFEE5078: return 1511;
-        case 0xFF007A67: return 1513;
-        case 0xFFFF8CCB: return 1515;
-        case 0xFF014F3A: return 1517;
-        case 0xFFCD054D: return 1533;
-        case 0xFF347DCB: return 1534;
-        case 0xFF23238B: return 1535;
-        case 0xFF081705: return 1536;
-        case 0xFFFFD6C7: return 1543;
-        case 0xFF9C6484: return 1545;
-        case 0xFFE6AE6F: return 1549;
-        case 0xFF6C8E87: return 1550;
-        case 0xFF80B0AE: return 1551;
-        case 0xFF6C7C71: return 1552;
-        case 0xFF8C748C: return 1554;
-        case 0xFFEB7183: return 1558;
-        case 0xFF68E0F8: return 1560;
-        case 0xFFB58CC7: return 1561;
-        /* BEGIN N/A COLORS */
-        /*
-                         return 2100;
-                         return 2101;
-                         return 2102;
-                         return 2103;
-                         return 2104;
-                         return 2105;
-                         return 2106;
-                         return 2107;
-                         return 2108;
-                         return 2109;
-                         return 2110;
-                         return 2111;
-                         return 2112;
-                         return 2113;
-                         return 2114;
-                         return 2115;
-                         return 2116;
-                         return 2117;
-                         return 2118;
-                         return 2119;
-                         return 2120;
-                         return 2121;
-                         return 2122;
-                         return 2123;
-                         return 2124;
-                         return 2125;
-                         return 2126;
-                         return 2127;
-                         return 2128;
-                         return 2129;
-                         return 2130;
-                         return 2131;
-                         return 2132;
-                         return 2133;
-                         return 2134;
-                         return 2135;
-                         return 2201;
-                         return 2202;
-                         return 2203;
-                         return 2204;
-                         return 2205;
-                         return 2206;
-                         return 2207;
-                         return 2208;
-                         return 2209;
-                         return 2210;
-                         return 2240;
-                         return 2241;
-                         return 2242;
-                         return 2243;
-                         return 2244;
-                         return 2245;
-                         return 2246;
-                         return 2247;
-        */
-        /* END N/A COLORS */
-        case 0xFFFAD2AA: return 1800;
-        case 0xFFFADC96: return 1801;
-        case 0xFFFFC896: return 1802;
-        case 0xFFFF9B6E: return 1803;
-        case 0xFF375A73: return 1804;
-        case 0xFF28505A: return 1805;
-        case 0xFFA0B9C3: return 1806;
-        case 0xFFB49682: return 1807;
-        case 0xFFD2AF9B: return 1808;
-        case 0xFFA07D82: return 1809;
-        case 0xFF645055: return 1810;
-        case 0xFF3C2837: return 1811;
-        case 0xFF6E2D5A: return 1812;
-        case 0xFF6E2D41: return 1813;
-        case 0xFFAF4B69: return 1814;
-        case 0xFF91B432: return 1815;
-        case 0xFFD7F58C: return 1816;
-        case 0xFFAAAF14: return 1817;
-        case 0xFFC8F58C: return 1818;
-        case 0xFFC3913C: return 1819;
-        case 0xFFC38C73: return 1820;
-        case 0xFFFAC896: return 1821;
-        case 0xFF965A37: return 1822;
-        case 0xFF965A28: return 1823;
-        case 0xFFD2C3AF: return 1824;
-        case 0xFF5F9619: return 1825;
-        case 0xFFAA820A: return 1826;
-        case 0xFFFF643C: return 1827;
-        case 0xFFFFE6AA: return 1828;
-        case 0xFFF0EBA5: return 1829;
-        case 0xFFB47396: return 1830;
-        case 0xFF91E12D: return 1831;
-        case 0xFFE19119: return 1832;
-        case 0xFFD25F00: return 1833;
-        case 0xFFAFAA05: return 1834;
-        case 0xFF6E8205: return 1835;
-        case 0xFF3C4B05: return 1836;
-        case 0xFF9B735A: return 1837;
-        case 0xFFCDAA7D: return 1838;
-        case 0xFF87C887: return 1839;
-        case 0xFFF9E6CA: return  508;
-        case 0xFFFDF3DA: return  520;
-        case 0xFF5D3446: return 1241;
-        case 0xFFE0C63B: return 1243;
-        case 0xFFDDAB00: return 1260;
-        case 0xFFA98803: return 1262;
-        case 0xFFAC8783: return 1269;
-        case 0xFF36361F: return 1273;
-        case 0xFFFA5F7F: return 1303;
-        case 0xFFA3C2D7: return 1644;
-    }
+    const ThreadColor* closest = 0;
+    long closestDistance = 0;
+    int red = (int)((color >> 16) & 0xFF);
+    int green = (int)((color >> 8) & 0xFF);
+    int blue = (int)(color & 0xFF);
+    int i, j;
 
-    return -1;
-}
+    if(!brands) return 0;
 
-const char* getName_Sulky_Rayon(unsigned int color)
-{
-    switch(color)
+    for(i = 0; i < brandCount; i++)
     {
-        case 0xFFEFC810: return "Cornsilk";
-        case 0xFF0C082D: return "Deep Arctic Sky";
-        case 0xFFB26C29: return "Nutmeg";
-        case 0xFFE79002: return "Autumn Gold";
-        case 0xFF34481E: return "English Green";
-        case 0xFF113675: return "Cobalt Blue";
-        case 0xFF111408: return "Forest Green";
-        case 0xFFE10000: return "Lipstick";
-        case 0xFFFFB435: return "Spice";
-        case 0xFFF3A001: return "Butterfly Gold";
-        case 0xFFE66D00: return "Cinnamon";
-        case 0xFF165F28: return "Garden Green";
-        case 0xFF088E6C: return "Deep Aqua";
-        case 0xFF100A7C: return "Blue Ribbon";
-        case 0xFF35693D: return "Mint Julep";
-        case 0xFFE9BD96: return "Dusty Peach";
-        case 0xFFCD3900: return "Sunset";
-        case 0xFF777113: return "Moss Green";
-        case 0xFF1C6F51: return "Med. Aqua";
-        case 0xFF262345: return "Arctic Sky";
-        case 0xFFF9F9FF: return "Bright White";
-        case 0xFFF9F9F4: return "Soft White";
-        case 0xFF000000: return "Black";
-        case 0xFFB7A9AC: return "Steel Gray";
-        case 0xFFE1AF9A: return "Med. Peach";
-        case 0xFFEC968C: return "Pastel Coral";
-        case 0xFFEFDFBD: return "Pastel Peach";
-        case 0xFFECA082: return "Peach";
-        case 0xFFF08278: return "Dark Peach";
-        case 0xFFEB6602: return "Maple";
-        case 0xFFFFF7D5: return "Cream";
-        case 0xFFFFE669: return "Yellow";
-        case 0xFFFFB800: return "Goldenrod";
-        case 0xFFD78000: return "Mine Gold";
-        case 0xFFBEC3E1: return "Baby Blue";
-        case 0xFFA0C3EB: return "Med. Blue";
-        case 0xFFA6A2C6: return "Periwinkle";
-        case 0xFFDFBEC8: return "Med. Orchid";
-        case 0xFFE68CEB: return "Med. Purple";
-        case 0xFFD86496: return "Dk. Orchid";
-        case 0xFFC6323C: return "Burgundy";
-        case 0xFF790000: return "Dk. Burgundy";
-        case 0xFFF90000: return "Lt.Red";
-        case 0xFFEB0000: return "True Red";
-        case 0xFF877375: return "Med. Dk. Khaki";
-        case 0xFF8C7F83: return "Med. Dk. Gray";
-        case 0xFF321E50: return "Bright Navy Blue";
-        case 0xFF190525: return "Dk. Navy";
-        case 0xFF1D062F: return "Midnight Blue";
-        case 0xFFC3EFBF: return "Lt. Teal";
-        case 0xFF2E8359: return "Teal";
-        case 0xFFA6C284: return "Mint Green";
-        case 0xFF42A021: return "Grass Green";
-        case 0xFF1E6419: return "Xmas Green";
-        case 0xFFEEBEAE: return "Med. Dk. Ecru";
-        case 0xFFEBBC80: return "Tawny Tan";
-        case 0xFFAF5B00: return "Med Tawny Tan";
-        case 0xFF642702: return "Dk Tawny Tan";
-        case 0xFF663500: return "Tawny Brown";
-        case 0xFF530601: return "Dk Tawny Brown";
-        case 0xFFFFF7B9: return "Pale Yellow";
-        case 0xFFF0F8EC: return "Pale Yellow-Green";
-        case 0xFFE6B4AA: return "Pale Peach";
-        case 0xFFFF9100: return "Orange Yellow";
-        case 0xFFFFF180: return "Primrose";
-        case 0xFFFFFF85: return "Lemon Yellow";
-        case 0xFFF3DBD9: return "Pink Tint";
-        case 0xFFF6CE69: return "Gold";
-        case 0xFFF9F9EA: return "Off White";
-        case 0xFFD6D5E8: return "Pale Powder Blue";
-        case 0xFF5A5A8B: return "Royal Blue";
-        case 0xFFBECDC8: return "Jade Tint";
-        case 0xFFFF6600: return "Tangerine";
-        case 0xFF175523: return "Emerald Green";
-        case 0xFFDC82A0: return "Orchid";
-        case 0xFFF06E78: return "Brick";
-        case 0xFFF7E3BB: return "Ecru";
-        case 0xFFFFC100: return "Spark Gold";
-        case 0xFFE2CFC7: return "Silver";
-        case 0xFFF9F9E0: return "Pale Sea Foam";
-        case 0xFF16625F: return "Deep Peacock";
-        case 0xFF26BFCA: return "Med Turquoise";
-        case 0xFF10D1BD: return "Turquoise";
-        case 0xFF0F6978: return "Dk Turquoise";
-        case 0xFFC2D37D: return "Lt Grass Green";
-        case 0xFF098531: return "True Green";
-        case 0xFF02140F: return "Dk Khaki";
-        case 0xFFA5AF68: return "Pastel Yellow-Grn";
-        case 0xFFFAA4A4: return "Lt Mauve";
-        case 0xFFDC6496: return "Hot Pink";
-        case 0xFFFCCBDF: return "Pastel Orchid";
-        case 0xFF46016E: return "Royal Purple";
-        case 0xFFF0C8B4: return "Pastel Mauve";
-        case 0xFFF0B9B9: return "Lt Pink";
-        case 0xFFF5A9A0: return "Mauve";
-        case 0xFFB46E75: return "Dk Mauve";
-        case 0xFFF0D6D2: return "Pale Pink";
-        case 0xFFFAB9CB: return "Pink";
-        case 0xFF82288E: return "Purple";
-        case 0xFFFFEC00: return "Sun Yellow";
-        case 0xFFDC8C17: return "Tan";
-        case 0xFFFAECC6: return "Med Ecru";
-        case 0xFFC39471: return "Dk Ecru";
-        case 0xFF6A1F06: return "Brown";
-        case 0xFF551602: return "Dark Brown";
-        case 0xFF490002: return "Cloister Brown";
-        case 0xFF507DAA: return "Peacock Blue";
-        case 0xFFFFF072: return "Pastel Yellow";
-        case 0xFFFFBE00: return "Yellow Orange";
-        case 0xFF4A5870: return "True Blue";
-        case 0xFFB4E1EB: return "Powder Blue";
-     /* case 0xFFEB0000: return "Xmas Red";    TODO: duplicate case value */
-        case 0xFFFFBDBD: return "Lt Coral";
-        case 0xFFE8C89C: return "Deep Ecru";
-        case 0xFFE2E2EB: return "Powder Blue Tint";
-        case 0xFFFA9999: return "Coral";
-        case 0xFF636327: return "Lt Army Green";
-        case 0xFFBA4500: return "Dk Maple";
-        case 0xFFD39D00: return "Temple Gold";
-        case 0xFF10394A: return "Deep Teal";
-        case 0xFFDFE5EB: return "Lt Sky Blue";
-        case 0xFF8E7E7E: return "Med Steel Gray";
-        case 0xFFFFD226: return "Maize Yellow";
-        case 0xFFF5740A: return "True Orange";
-        case 0xFF9C0000: return "Bayberry Red";
-        case 0xFF975F2F: return "Lt Brown";
-        case 0xFF08180E: return "Weathered Blue";
-        case 0xFF6E788C: return "Med Weathered Blue";
-        case 0xFF59591D: return "Med Army Green";
-        case 0xFF0D2904: return "Dk Pine Green";
-        case 0xFF152D04: return "Dk Avocado";
-        case 0xFF515308: return "Med Dk Avocado";
-        case 0xFF899812: return "Avocado";
-        case 0xFF8F623D: return "Dk Taupe";
-        case 0xFFA58973: return "Med Taupe";
-        case 0xFFCB0000: return "Rust";
-        case 0xFF020114: return "Blue Black";
-        case 0xFF320614: return "Black Cherry";
-     /* case 0xFFFF6600: return "Orange Red";    TODO: duplicate case value */
-        case 0xFFFCBE05: return "Golden Yellow";
-        case 0xFF5B0000: return "Sable Brown";
-        case 0xFFFFE500: return "Mimosa Yellow";
-        case 0xFFFF004B: return "Red Geranium";
-        case 0xFF4B122D: return "Dk Chestnut";
-        case 0xFFA04656: return "Med Burgundy";
-        case 0xFFBD1E60: return "Dk Rose";
-        case 0xFFD21E82: return "Fuchsia";
-        case 0xFFE6AFD2: return "Lavender";
-        case 0xFFD274D7: return "Lt Purple";
-        case 0xFF370150: return "Dk Purple";
-        case 0xFF96C3E1: return "Blue";
-        case 0xFF220F34: return "Med Navy";
-        case 0xFF3C5075: return "Dusty Navy";
-        case 0xFF2A143F: return "Admiral Navy Blue";
-        case 0xFF140B2D: return "Med Dk Navy";
-        case 0xFF648BBE: return "Med Powder Blue";
-        case 0xFF182B56: return "Deep Turquoise";
-        case 0xFFAEB8C3: return "Lt Weathered Blue";
-        case 0xFFA8C8BC: return "Pastel Jade";
-        case 0xFF6E90A5: return "Med Jade";
-        case 0xFF1E6E6F: return "Dark Jade";
-        case 0xFF80A388: return "Sea Foam Green";
-        case 0xFF0C3D03: return "Mallard Green";
-        case 0xFFBDD163: return "Lt Avocado";
-        case 0xFF273B00: return "Dk Army Green";
-        case 0xFF95A490: return "Lt Khaki";
-        case 0xFF63632D: return "Khaki";
-        case 0xFFB9A096: return "Taupe";
-        case 0xFF642828: return "Med Chestnut";
-        case 0xFF500A1E: return "Blackberry";
-        case 0xFFAC1C01: return "Med Maple";
-        case 0xFF971F01: return "Chestnut";
-        case 0xFFDFDFCB: return "Silver Gray";
-        case 0xFF98888C: return "Gray";
-        case 0xFF765960: return "Charcoal Gray";
-        case 0xFFD1DBFF: return "Lt Baby Blue";
-        case 0xFFDCE0F1: return "Baby Blue Tint";
-        case 0xFFF0A0B9: return "Bright Pink";
-        case 0xFFFACBCB: return "Pastel Pink";
-        case 0xFF57369E: return "Dkl Periwinkle";
-        case 0xFFAF8901: return "Gold Green";
-        case 0xFF96AA8B: return "Drab Green";
-        case 0xFFE0DBDB: return "Lt Putty";
-        case 0xFF0B4133: return "Dk Teal";
-        case 0xFFE5326A: return "Med Rose";
-        case 0xFF193207: return "Classic Green";
-        case 0xFF0D2210: return "Ocean Teal";
-        case 0xFF3C1B1F: return "Almost Black";
-        case 0xFF783298: return "Deep Purple";
-        case 0xFFEAE4E4: return "Lt Silver";
-        case 0xFFBC3D2C: return "Deep Mauve";
-        case 0xFFFF8300: return "Orange Sunrise";
-        case 0xFFFFAB57: return "Apricot";
-        case 0xFF74586C: return "Smokey Grey";
-        case 0xFF543A8D: return "Nassau Blue";
-        case 0xFFFF0000: return "Orange Flame";
-        case 0xFF660000: return "Mahogany";
-        case 0xFFD2E6F0: return "Med Pastel Blue";
-        case 0xFF62AADC: return "Cornflower Blue";
-        case 0xFF275C70: return "Duck Wing Blue";
-        case 0xFF306F75: return "Bright Turquoise";
-        case 0xFF09A1A8: return "Bright Peacock";
-        case 0xFF1B4CA4: return "Dk Sapphire";
-        case 0xFFE6B9F5: return "Dusty Lavender";
-        case 0xFFBE1982: return "Deep Orchid";
-        case 0xFFEB8296: return "Sweet Pink";
-        case 0xFFE60041: return "Deep Coral";
-        case 0xFFF0C4A0: return "Coral Reed";
-        case 0xFFE28264: return "Salmon Peach";
-        case 0xFFB30000: return "Red Jubilee";
-        case 0xFF6A0000: return "Cognac";
-        case 0xFF9B6B2C: return "Burnt Toast";
-        case 0xFF9C6D45: return "Toast";
-        case 0xFF864C31: return "Mink Brown";
-        case 0xFFEFEFE5: return "Light Gray Khaki";
-        case 0xFFB7B7AF: return "Dk Gray Khaki";
-        case 0xFF3C4F31: return "Evergreen";
-        case 0xFF4A4A19: return "Hedge Green";
-        case 0xFF5C9A1A: return "Nile Green";
-        case 0xFFE0E6C8: return "Sea Mist";
-        case 0xFF70770F: return "Pistachio";
-        case 0xFF027602: return "Ivy Green";
-        case 0xFF00AF38: return "Bright Green";
-        case 0xFF93D16C: return "Willow Green";
-        case 0xFF46B774: return "Dk Willow Green";
-        case 0xFF483D59: return "Slate Gray";
-        case 0xFF466E78: return "Dk Winter Sky";
-        case 0xFF134F45: return "Dk Sage Green";
-        case 0xFF343213: return "Dk French Green";
-        case 0xFF415545: return "French Green";
-        case 0xFF0FA56F: return "Aqua";
-        case 0xFFDCEBF0: return "Ice Blue";
-        case 0xFF727483: return "Winter Sky";
-        case 0xFFD1DCFA: return "Heron Blue";
-        case 0xFF44235D: return "Deep Nassau Blue";
-        case 0xFF412044: return "Deep Slate Gray";
-        case 0xFF82878C: return "Sterling";
-        case 0xFFD2AAF0: return "Hyacinth";
-        case 0xFF735A64: return "Lt Plum";
-        case 0xFF644664: return "Dk Plum";
-        case 0xFF411446: return "Purple Shadow";
-        case 0xFF7E1E46: return "Plum";
-        case 0xFF320046: return "Deep Eggplant";
-        case 0xFF6E0A96: return "Eggplant";
-        case 0xFFB47364: return "Dewberry";
-        case 0xFFAEC6BB: return "Sage Green";
-        case 0xFF7E6C7C: return "Gun Metal Gray";
-        case 0xFFDB6478: return "Petal Pink";
-        case 0xFF782346: return "Magenta";
-        case 0xFF961A32: return "Mulberry";
-        case 0xFF840000: return "Wine";
-        case 0xFFFC8F0C: return "Bittersweet";
-     /* case 0xFFFF0000: return "Poppy";    TODO: duplicate case value */
-        case 0xFFCBCBBD: return "Gray Khaki";
-        case 0xFF818901: return "Chartreuse";
-        case 0xFFF8F5F1: return "Whisper Gray";
-        case 0xFFD5C7C3: return "Dk Whisper Gray";
-        case 0xFFC0B2B7: return "Nickel Gray";
-        case 0xFFABA0A8: return "Dk Nickel Gray";
-        case 0xFFEDF6D4: return "Pale Green";
-        case 0xFF868105: return "Deep Chartreuse";
-        case 0xFFF3B600: return "Sunflower Gold";
-        case 0xFF349669: return "Green Peacock";
-        case 0xFFC1CBB9: return "Putty";
-        case 0xFF7AB31D: return "Lime Green";
-        case 0xFFEE5078: return "Deep Rose";
-        case 0xFF007A67: return "Wild Peacock";
-        case 0xFFFF8CCB: return "Rosebud";
-        case 0xFF014F3A: return "Coachman Green";
-        case 0xFFCD054D: return "Lt Rose";
-        case 0xFF347DCB: return "Sapphire";
-        case 0xFF23238B: return "Team Blue";
-        case 0xFF081705: return "Midnight Teal";
-        case 0xFFFFD6C7: return "Peach Fluff";
-        case 0xFF9C6484: return "Purple Accent";
-        case 0xFFE6AE6F: return "Flax";
-        case 0xFF6C8E87: return "Desert Cactus";
-        case 0xFF80B0AE: return "Ocean Aqua";
-        case 0xFF6C7C71: return "Dk Desert Cactus";
-        case 0xFF8C748C: return "Purple Passion";
-        case 0xFFEB7183: return "Tea Rose";
-        case 0xFF68E0F8: return "Marine Aqua";
-        case 0xFFB58CC7: return "Deep Hyacinth";
-        /* BEGIN N/A COLORS */
-        /*
-                         return "Vari-Pastel Pinks";
-                         return "Vari-Pinks";
-                         return "Vari-Roses";
-                         return "Vari-Oranges";
-                         return "Vari-Pastel Blues";
-                         return "Teal Blues";
-                         return "Vari-Blues";
-                         return "Vari-Navy Blues";
-                         return "Vari-Grays/Silvers";
-                         return "Vari-Grays/Blacks";
-                         return "Vari-True Greens";
-                         return "Vari-Grass Greens";
-                         return "Vari-Mint Greens";
-                         return "Vari-Bright Greens";
-                         return "Vari-Avocado Grns";
-                         return "Vari-Pine Greens";
-                         return "Vari-Taupes";
-                         return "Vari-Yellows";
-                         return "Vari-Med Brown";
-                         return "Vari-Lt Browns";
-                         return "Vari-Dk Browns";
-                         return "Vari-Orchids";
-                         return "Vari-Baby Pinks";
-                         return "Vari-Reds";
-                         return "Vari-Purples";
-                         return "Vari-Royal Purples";
-                         return "Vari-Rust Peaches";
-                         return "Vari-Dk Taupes";
-                         return "Vari-Willow Greens";
-                         return "Vari-French Greens";
-                         return "Vari-Fuchsias";
-                         return "Vari-Khakis";
-                         return "Vari-Aqua Teals";
-                         return "Vari-Coffee Browns";
-                         return "Vari-Golden Ylws";
-                         return "Vari-Peaches";
-                         return "Baby Blue/Pink/Mint";
-                         return "Mint Greens/Pinks";
-                         return "Baby Pink/Mint/Blue";
-                         return "Teal/Purple/Fuchsia";
-                         return "Blue/Fuchsia/Purple";
-                         return "Turq/Coral/Silver";
-                         return "Green/Burgundy/Tan";
-                         return "Burg/Green/Blue/Tan";
-                         return "Seafoam/Coralrf/Ecru";
-                         return "Dk Gr/Brn Burg/Lt Br";
-                         return "Grn/Coral/Blue/Ylw";
-                         return "Peach/Blue/Rust/Grn";
-                         return "Red/Gold/Blue";
-                         return "Med Grn/Purple/Gold";
-                         return "Coral/Brown/Teal";
-                         return "Old Gold/Black/Red";
-                         return "Med Blue/Green/Tan";
-                         return "Blue/Lav/Red/Ylw/Grn";
-        */
-        /* END N/A COLORS */
-        case 0xFFFAD2AA: return "Shrimp";
-        case 0xFFFADC96: return "Flesh";
-        case 0xFFFFC896: return "Soft Blush";
-        case 0xFFFF9B6E: return "Island Peach";
-        case 0xFF375A73: return "Bayou Blue";
-        case 0xFF28505A: return "Ocean View";
-        case 0xFFA0B9C3: return "Madras Blue";
-        case 0xFFB49682: return "Soft Heather";
-        case 0xFFD2AF9B: return "Velvet Slipper";
-        case 0xFFA07D82: return "Iced Mauve";
-        case 0xFF645055: return "Wild Mulberry";
-        case 0xFF3C2837: return "Wineberry";
-        case 0xFF6E2D5A: return "Wildflower";
-        case 0xFF6E2D41: return "Plum Wine";
-        case 0xFFAF4B69: return "Orchid Kiss";
-        case 0xFF91B432: return "Japanese Fern";
-        case 0xFFD7F58C: return "Honeydew";
-        case 0xFFAAAF14: return "Lemon Grass";
-        case 0xFFC8F58C: return "Fairway Mist";
-        case 0xFFC3913C: return "Outback";
-        case 0xFFC38C73: return "Fruit Shake";
-        case 0xFFFAC896: return "Creamy Peach";
-        case 0xFF965A37: return "Toffee";
-        case 0xFF965A28: return "Cocoa";
-        case 0xFFD2C3AF: return "Gentle Rain";
-        case 0xFF5F9619: return "Barnyard Grass";
-        case 0xFFAA820A: return "Galley Gold";
-        case 0xFFFF643C: return "Coral Sunset";
-        case 0xFFFFE6AA: return "Seashell";
-        case 0xFFF0EBA5: return "Crème Brulee";
-        case 0xFFB47396: return "Lilac";
-        case 0xFF91E12D: return "Liimeade";
-        case 0xFFE19119: return "Desert Glow";
-        case 0xFFD25F00: return "Pumpkin Pie";
-        case 0xFFAFAA05: return "Pea Soup";
-        case 0xFF6E8205: return "Peapod Green";
-        case 0xFF3C4B05: return "Loden Green";
-        case 0xFF9B735A: return "Lt. Cocoa";
-        case 0xFFCDAA7D: return "Cocoa Cream";
-        case 0xFF87C887: return "Cameo";
-        case 0xFFF9E6CA: return "Sand";
-        case 0xFFFDF3DA: return "Bone";
-        case 0xFF5D3446: return "Dark Ash";
-        case 0xFFE0C63B: return "Spring Moss";
-        case 0xFFDDAB00: return "Summer Gold";
-        case 0xFFA98803: return "Dk. Autumn Gold";
-        case 0xFFAC8783: return "Mushroom";
-        case 0xFF36361F: return "Dark Forest";
-        case 0xFFFA5F7F: return "Watermelon";
-        case 0xFFA3C2D7: return "Caribbean Mist";
+        const ThreadColor* exact = threadColor_find(color, brands[i]);
+        if(exact)
+        {
+            if(brand) *brand = brands[i];
+            return exact;
+        }
     }
 
-    return "";
-}
-
-int getNum_ThreadArt_Rayon(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_ThreadArt_Rayon(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_ThreadArt_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_ThreadArt_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_ThreaDelight_Polyester(unsigned int color) { return -1; } /*TODO: finish */
-const char* getName_ThreaDelight_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-int getNum_Z102_Isacord_Polyester(unsigned int color)
-{
-    switch(color)
+    for(i = 0; i < brandCount; i++)
     {
-        case 0xFFF8FFFF: return 17;
-        case 0xFF000000: return 20;
-        case 0xFFB7BABA: return 105;
-        case 0xFF73787A: return 108;
-        case 0xFF454B58: return 138;
-        case 0xFF9EA9A6: return 142;
-        case 0xFFC8C6BD: return 150;
-        case 0xFFFAEE5C: return 220;
-        case 0xFFE5CB4F: return 221;
-        case 0xFFFFF46A: return 230;
-        case 0xFFFEF9D9: return 270;
-        case 0xFFFFDC00: return 311;
-        case 0xFF624F00: return 345;
-        case 0xFFB8B25A: return 352;
-        case 0xFF8D8F5B: return 453;
-        case 0xFFFFF4A5: return 520;
-        case 0xFFB98E03: return 542;
-        case 0xFFE4C180: return 651;
-        case 0xFFC5BFA6: return 672;
-        case 0xFF96836D: return 722;
-        case 0xFF4E3500: return 747;
-        case 0xFFDDCBA5: return 761;
-        case 0xFF605840: return 776;
-        case 0xFFFFAF02: return 800;
-        case 0xFFF6AE32: return 811;
-        case 0xFFC89334: return 822;
-        case 0xFFE59300: return 824;
-        case 0xFFC89340: return 832;
-        case 0xFF9E947F: return 873;
-        case 0xFFC8700B: return 922;
-        case 0xFFBB5704: return 931;
-        case 0xFFB19072: return 1061;
-        case 0xFFFF8101: return 1102;
-        case 0xFFB1500A: return 1115;
-        case 0xFFC09C72: return 1123;
-        case 0xFF843D07: return 1134;
-        case 0xFFD8A67D: return 1141;
-        case 0xFF82421B: return 1154;
-        case 0xFFFF7319: return 1300;
-        case 0xFFFF3D1E: return 1305;
-        case 0xFFBA4005: return 1311;
-        case 0xFFC73C13: return 1312;
-        case 0xFFE66B21: return 1332;
-        case 0xFF3D1C11: return 1346;
-        case 0xFFFFBC95: return 1351;
-        case 0xFFFFCC93: return 1362;
-        case 0xFF373732: return 1375;
-        case 0xFFFFAF94: return 1532;
-        case 0xFF5B4032: return 1565;
-        case 0xFFFF6046: return 1600;
-        case 0xFFFF6D71: return 1753;
-        case 0xFFEBBAAE: return 1755;
-        case 0xFFEB2D2B: return 1805;
-        case 0xFFFF988F: return 1840;
-        case 0xFF434331: return 1874;
-        case 0xFFC11914: return 1902;
-        case 0xFFC8100D: return 1903;
-        case 0xFFBF0A21: return 1906;
-        case 0xFFD23C3E: return 1921;
-        case 0xFF8F8C93: return 1972;
-        case 0xFFA31A1C: return 2011;
-        case 0xFF4D0308: return 2115;
-        case 0xFFFFCDCC: return 2155;
-        case 0xFF871C45: return 2500;
-        case 0xFFDB4083: return 2508;
-        case 0xFFFF668A: return 2520;
-        case 0xFFC91243: return 2521;
-        case 0xFFFFA0B6: return 2530;
-        case 0xFFFEA5B9: return 2550;
-        case 0xFF626C7E: return 2674;
-        case 0xFF5E1942: return 2711;
-        case 0xFF33001D: return 2715;
-        case 0xFFA57B8D: return 2764;
-        case 0xFF702A69: return 2810;
-        case 0xFFB385BC: return 2830;
-        case 0xFF240047: return 2900;
-        case 0xFF724593: return 2910;
-        case 0xFF634D86: return 2920;
-        case 0xFF000136: return 3110;
-        case 0xFF000021: return 3355;
-        case 0xFF054ABD: return 3522;
-        case 0xFF1C005D: return 3541;
-        case 0xFF001F71: return 3544;
-        case 0xFF002E5E: return 3622;
-        case 0xFF71AAD8: return 3630;
-        case 0xFF001748: return 3644;
-        case 0xFFC8DBE4: return 3650;
-        case 0xFF9FC7DF: return 3730;
-        case 0xFF082E4D: return 3743;
-        case 0xFF98B0BC: return 3750;
-        case 0xFF23679C: return 3810;
-        case 0xFF3D657E: return 3842;
-        case 0xFF00669F: return 3901;
-        case 0xFF47AEDD: return 3910;
-        case 0xFFBBDFEB: return 3962;
-        case 0xFFBABEB7: return 3971;
-        case 0xFF015D7E: return 4032;
-        case 0xFFD5DDDB: return 4071;
-        case 0xFF888D8E: return 4073;
-        case 0xFF007CA6: return 4103;
-        case 0xFF3EBBC8: return 4111;
-        case 0xFF005C79: return 4116;
-        case 0xFF80CCD8: return 4240;
-        case 0xFFACCEC7: return 4250;
-        case 0xFF006E74: return 4410;
-        case 0xFF002A29: return 4515;
-        case 0xFF38A4AE: return 4620;
-        case 0xFFAFD8CD: return 5050;
-        case 0xFF149B7B: return 5210;
-        case 0xFF7AC8AF: return 5220;
-        case 0xFF187166: return 5233;
-        case 0xFF004B23: return 5374;
-        case 0xFF006835: return 5415;
-        case 0xFF5C9C51: return 5531;
-        case 0xFF0E9543: return 5613;
-        case 0xFF5E7A17: return 5833;
-        case 0xFF225926: return 5944;
-        case 0xFFBCD633: return 6011;
-        case 0xFFBBCD91: return 6051;
-        case 0xFF978B3C: return 6133;
+        const ThreadChart* chart = threadColor_chart(brands[i]);
+        if(!chart) continue;
+        for(j = 0; j < chart->count; j++)
+        {
+            unsigned int c = chart->colors[j].color;
+            long dr = red - (int)((c >> 16) & 0xFF);
+            long dg = green - (int)((c >> 8) & 0xFF);
+            long db = blue - (int)(c & 0xFF);
+            long distance = dr * dr + dg * dg + db * db;
+            if(!closest || distance < closestDistance)
+            {
+                closest = &chart->colors[j];
+                closestDistance = distance;
+                if(brand) *brand = brands[i];
+            }
+        }
     }
-
-    return -1;
+    return closest;
 }
 
-const char* getName_Z102_Isacord_Polyester(unsigned int color) { return ""; } /*TODO: finish */
-
-#endif /* ARDUINO TODO: remove this line when thread-color.c is arduino compatible. This is a temporary arduino build fix. */
-
 int threadColorNum(unsigned int color, ThreadBrand brand)
 {
-    switch(brand)
-    {
-        case Arc_Polyester:          return getNum_Arc_Polyester(color);
-        case Arc_Rayon:              return getNum_Arc_Rayon(color);
-        case CoatsAndClark_Rayon:    return getNum_CoatsAndClark_Rayon(color);
-        case Exquisite_Polyester:    return getNum_Exquisite_Polyester(color);
-        case Fufu_Polyester:         return getNum_Fufu_Polyester(color);
-        case Fufu_Rayon:             return getNum_Fufu_Rayon(color);
-        case Hemingworth_Polyester:  return getNum_Hemingworth_Polyester(color);
-        case Isacord_Polyester:      return getNum_Isacord_Polyester(color);
-        case Isafil_Rayon:           return getNum_Isafil_Rayon(color);
-        case Marathon_Polyester:     return getNum_Marathon_Polyester(color);
-        case Marathon_Rayon:         return getNum_Marathon_Rayon(color);
-        case Madeira_Polyester:      return getNum_Madeira_Polyester(color);
-        case Madeira_Rayon:          return getNum_Madeira_Rayon(color);
-        case Metro_Polyester:        return getNum_Metro_Polyester(color);
-        case Pantone:                return getNum_Pantone(color);
-        case RobisonAnton_Polyester: return getNum_RobisonAnton_Polyester(color);
-        case RobisonAnton_Rayon:     return getNum_RobisonAnton_Rayon(color);
-        case Sigma_Polyester:        return getNum_Sigma_Polyester(color);
-        case Sulky_Rayon:            return getNum_Sulky_Rayon(color);
-        case ThreadArt_Rayon:        return getNum_ThreadArt_Rayon(color);
-        case ThreadArt_Polyester:    return getNum_ThreadArt_Polyester(color);
-        case ThreaDelight_Polyester: return getNum_ThreaDelight_Polyester(color);
-        case Z102_Isacord_Polyester: return getNum_Z102_Isacord_Polyester(color);
-    }
-
-    return -1;
+    const ThreadColor* entry = threadColor_find(color, brand);
+    return entry ? entry->number : -1;
 }
 
 const char* threadColorName(unsigned int color, ThreadBrand brand)
 {
-    switch(brand)
-    {
-        case Arc_Polyester:          return getName_Arc_Polyester(color);
-        case Arc_Rayon:              return getName_Arc_Rayon(color);
-        case CoatsAndClark_Rayon:    return getName_CoatsAndClark_Rayon(color);
-        case Exquisite_Polyester:    return getName_Exquisite_Polyester(color);
-        case Fufu_Polyester:         return getName_Fufu_Polyester(color);
-        case Fufu_Rayon:             return getName_Fufu_Rayon(color);
-        case Hemingworth_Polyester:  return getName_Hemingworth_Polyester(color);
-        case Isacord_Polyester:      return getName_Isacord_Polyester(color);
-        case Isafil_Rayon:           return getName_Isafil_Rayon(color);
-        case Marathon_Polyester:     return getName_Marathon_Polyester(color);
-        case Marathon_Rayon:         return getName_Marathon_Rayon(color);
-        case Madeira_Polyester:      return getName_Madeira_Polyester(color);
-        case Madeira_Rayon:          return getName_Madeira_Rayon(color);
-        case Metro_Polyester:        return getName_Metro_Polyester(color);
-        case Pantone:                return getName_Pantone(color);
-        case RobisonAnton_Polyester: return getName_RobisonAnton_Polyester(color);
-        case RobisonAnton_Rayon:     return getName_RobisonAnton_Rayon(color);
-        case Sigma_Polyester:        return getName_Sigma_Polyester(color);
-        case Sulky_Rayon:            return getName_Sulky_Rayon(color);
-        case ThreadArt_Rayon:        return getName_ThreadArt_Rayon(color);
-        case ThreadArt_Polyester:    return getName_ThreadArt_Polyester(color);
-        case ThreaDelight_Polyester: return getName_ThreaDelight_Polyester(color);
-        case Z102_Isacord_Polyester: return getName_Z102_Isacord_Polyester(color);
-    }
-
-    return "";
+    const ThreadColor* entry = threadColor_find(color, brand);
+    return entry ? entry->name : "";
 }
 
 /* gcc -DTEST_THREAD_COLOR -o thread-color thread-color.c */
@@ -37,9 +37,23 @@ typedef enum
  * the alpha value always being FF, i.e. opaque
 */
 
+/* An entry of a manufacturer's thread chart */
+typedef struct ThreadColor_
+{
+    unsigned int color; /* #AARRGGBB */
+    int number;         /* catalog number, -1 if the chart has none */
+    const char* name;   /* "" if the chart has none */
+} ThreadColor;
+
 int threadColorNum(unsigned int color, ThreadBrand brand);
 const char* threadColorName(unsigned int color, ThreadBrand brand);
 
+int threadColor_count(ThreadBrand brand);
+const ThreadColor* threadColor_getAt(ThreadBrand brand, int index);
+const ThreadColor* threadColor_find(unsigned int color, ThreadBrand brand);
+const ThreadColor* threadColor_findNumber(int number, ThreadBrand brand);
+const ThreadColor* threadColor_nearest(unsigned int color, const ThreadBrand* brands, int brandCount, ThreadBrand* brand);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
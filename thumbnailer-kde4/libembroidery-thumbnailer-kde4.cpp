@@ -5,7 +5,7 @@
 #include <QImage>
 #include <QFile>
 
-#include "emb-reader-writer.h"
+#include "emb-format.h"
 
 extern "C"
 {
@@ -37,16 +37,15 @@ const QImage loadThumb(const QString& fileName)
     if(!p) { return QImage(); }
     int readSuccessful = 0;
     QString readError;
-    EmbReaderWriter* reader = embReaderWriter_getByFileName(qPrintable(fileName));
-    if(!reader)
+    const EmbFormat* format = embFormat_fromFile(qPrintable(fileName));
+    if(!format || !format->readerWriter.reader)
     {
         readSuccessful = 0;
     }
     else
     {
-        readSuccessful = reader->reader(p, qPrintable(fileName));
+        readSuccessful = format->readerWriter.reader(p, qPrintable(fileName));
     }
-    free(reader);
 
     if(readSuccessful)
     {